@@ -0,0 +1,18 @@
+// Automatically generated; do not edit.
+
+ else if (ndims == 1 && do_wrap == false)
+  gp = make_shared<YkElemGrid<Layout_1, false>>(_dims, name, dims, &_opts, &_ostr);
+ else if (ndims == 1 && do_wrap == true)
+  gp = make_shared<YkElemGrid<Layout_1, true>>(_dims, name, dims, &_opts, &_ostr);
+ else if (ndims == 2 && do_wrap == false)
+  gp = make_shared<YkElemGrid<Layout_12, false>>(_dims, name, dims, &_opts, &_ostr);
+ else if (ndims == 2 && do_wrap == true)
+  gp = make_shared<YkElemGrid<Layout_12, true>>(_dims, name, dims, &_opts, &_ostr);
+ else if (ndims == 3 && do_wrap == false)
+  gp = make_shared<YkElemGrid<Layout_123, false>>(_dims, name, dims, &_opts, &_ostr);
+ else if (ndims == 3 && do_wrap == true)
+  gp = make_shared<YkElemGrid<Layout_123, true>>(_dims, name, dims, &_opts, &_ostr);
+ else if (ndims == 4 && do_wrap == false)
+  gp = make_shared<YkElemGrid<Layout_1234, false>>(_dims, name, dims, &_opts, &_ostr);
+ else if (ndims == 4 && do_wrap == true)
+  gp = make_shared<YkElemGrid<Layout_1234, true>>(_dims, name, dims, &_opts, &_ostr);
@@ -0,0 +1,1831 @@
+// Automatically-generated code; do not edit.
+
+////// YASK implementation of the '3axis' stencil //////
+
+#ifdef DEFINE_MACROS
+// Stencil solution:
+#define YASK_STENCIL_NAME "3axis"
+#define YASK_STENCIL_CONTEXT StencilContext_3axis
+
+// FP precision:
+#define REAL_BYTES (4)
+
+// Number of domain dimensions:
+#define NUM_DOMAIN_DIMS 3
+#define DOMAIN_DIM_IDX_x (0)
+#define DOMAIN_DIM_IDX_y (1)
+#define DOMAIN_DIM_IDX_z (2)
+
+// Number of stencil dimensions (step and domain):
+#define NUM_STENCIL_DIMS 4
+#define STENCIL_DIM_IDX_t (0)
+#define STENCIL_DIM_IDX_x (1)
+#define STENCIL_DIM_IDX_y (2)
+#define STENCIL_DIM_IDX_z (3)
+
+// Max number of grid dimensions:
+#define NUM_GRID_DIMS 4
+
+// Number of stencil equations:
+#define NUM_STENCIL_EQS 1
+
+// One vector fold: x=8 * y=1 * z=1
+#define VLEN_X (8)
+#define VLEN_Y (1)
+#define VLEN_Z (1)
+#define VLEN (8)
+#define FIRST_FOLD_INDEX_IS_UNIT_STRIDE (1)
+#define NUM_VEC_FOLD_DIMS (1)
+#define VEC_FOLD_LAYOUT_CLASS Layout_1
+#define VEC_FOLD_LAYOUT(idxs) LAYOUT_1(idxs[0], 8)
+#define USING_UNALIGNED_LOADS (0)
+
+// Cluster multipliers of vector folds: x=1 * y=1 * z=1
+#define CMULT_X (1)
+#define CMULT_Y (1)
+#define CMULT_Z (1)
+#define CMULT (1)
+
+#endif // DEFINE_MACROS
+
+#ifdef DEFINE_CONTEXT
+namespace yask {
+
+ ////// Stencil-specific data //////
+class StencilContext_3axis_data : public StencilContext {
+public:
+
+ ///// Grid(s).
+
+ // The 4-D grid 'data', which is updated by one or more equations.
+ typedef YkVecGrid<Layout_2314, true, 1, 8, 1, 1> data_type;
+ typedef std::shared_ptr<data_type> data_ptr_type;
+ GridDimNames data_dim_names;
+ data_ptr_type data_ptr;
+ data_type* data;
+ const int data_max_exch_dist = 1; // max L1 distance of neighbor ranks that need halo data.
+ const idx_t data_alloc_t = 2; // default allocation in 't' dimension.
+ const idx_t data_left_halo_x = 6; // default halo size in 'x' dimension.
+ const idx_t data_right_halo_x = 6; // default halo size in 'x' dimension.
+ const idx_t data_left_halo_y = 6; // default halo size in 'y' dimension.
+ const idx_t data_right_halo_y = 6; // default halo size in 'y' dimension.
+ const idx_t data_left_halo_z = 6; // default halo size in 'z' dimension.
+ const idx_t data_right_halo_z = 6; // default halo size in 'z' dimension.
+
+ // Constructor.
+ StencilContext_3axis_data(KernelEnvPtr env, KernelSettingsPtr settings) : StencilContext(env, settings) {
+  name = "3axis";
+
+ // Create grids (but do not allocate data in them).
+
+ // Grid 'data'.
+ data_dim_names = {"t", "x", "y", "z"};
+ data_ptr = std::make_shared<data_type>(_dims, "data", data_dim_names, &_opts, &_ostr);
+ assert(data_ptr);
+ data_ptr->set_max_exch_dist(data_max_exch_dist);
+ data_ptr->set_alloc_size("t", data_alloc_t);
+ data_ptr->set_left_halo_size("x", data_left_halo_x);
+ data_ptr->set_right_halo_size("x", data_right_halo_x);
+ data_ptr->set_left_halo_size("y", data_left_halo_y);
+ data_ptr->set_right_halo_size("y", data_right_halo_y);
+ data_ptr->set_left_halo_size("z", data_left_halo_z);
+ data_ptr->set_right_halo_size("z", data_right_halo_z);
+ data = data_ptr.get();
+ addGrid(data_ptr, true /* is an output grid */);
+
+ // Update grids with context info.
+ update_grid_info();
+ } // ctor
+
+ // Make a new grid iff its dims match any in the stencil.
+ // Returns pointer to the new grid or nullptr if no match.
+ virtual YkGridPtr newStencilGrid(const std::string& name, const GridDimNames& dims) {
+ YkGridPtr gp;
+
+ // Grids with 't, x, y, z' dim(s).
+ if (dims == data_dim_names) gp = std::make_shared<data_type>(_dims, name, dims, &_opts, &_ostr);
+ return gp;
+ } // newStencilGrid
+
+ // Make new scratch grids.
+ virtual void makeScratchGrids(int num_threads) {
+ } // newScratchGrids
+}; // StencilContext_3axis_data
+
+ ////// Stencil equation-bundle 'stencil_bundle_0' w/o condition //////
+
+ class StencilBundle_stencil_bundle_0 : public StencilBundleBase {
+ protected:
+ typedef StencilContext_3axis_data _context_type;
+ _context_type* _context = 0;
+ public:
+
+ // 43 FP operation(s) per point:
+ // data((t + 1), x, y, z) EQUALS ((0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))) + (-0.05 * (data(t, (x - 4), y, z) + data(t, (x + 4), y, z) + data(t, x, (y - 4), z) + data(t, x, (y + 4), z) + data(t, x, y, (z - 4)) + data(t, x, y, (z + 4)))) + (0.032 * (data(t, (x - 5), y, z) + data(t, (x + 5), y, z) + data(t, x, (y - 5), z) + data(t, x, (y + 5), z) + data(t, x, y, (z - 5)) + data(t, x, y, (z + 5)))) + (-0.0222222 * (data(t, (x - 6), y, z) + data(t, (x + 6), y, z) + data(t, x, (y - 6), z) + data(t, x, (y + 6), z) + data(t, x, y, (z - 6)) + data(t, x, y, (z + 6))))).
+ StencilBundle_stencil_bundle_0(StencilContext_3axis_data* context) :
+ StencilBundleBase(context),
+ _context(context) {
+ _name = "stencil_bundle_0";
+ _scalar_fp_ops = 43;
+ _scalar_points_read = 37;
+ _scalar_points_written = 1;
+ _is_scratch = false;
+
+ // The following grids are read by StencilBundle_stencil_bundle_0
+  inputGridPtrs.push_back(_context->data_ptr);
+
+ // The following grids are written by StencilBundle_stencil_bundle_0
+  outputGridPtrs.push_back(_context->data_ptr);
+
+ // The following points are accessed by StencilBundle_stencil_bundle_0 relative to the point being calculated.
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 0, 0 }, false }); // data(t, x, y, z).
+  _accesses.push_back({ _context->data_ptr, { 0, -1, 0, 0 }, false }); // data(t, (x - 1), y, z).
+  _accesses.push_back({ _context->data_ptr, { 0, 1, 0, 0 }, false }); // data(t, (x + 1), y, z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, -1, 0 }, false }); // data(t, x, (y - 1), z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 1, 0 }, false }); // data(t, x, (y + 1), z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 0, -1 }, false }); // data(t, x, y, (z - 1)).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 0, 1 }, false }); // data(t, x, y, (z + 1)).
+  _accesses.push_back({ _context->data_ptr, { 0, -2, 0, 0 }, false }); // data(t, (x - 2), y, z).
+  _accesses.push_back({ _context->data_ptr, { 0, 2, 0, 0 }, false }); // data(t, (x + 2), y, z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, -2, 0 }, false }); // data(t, x, (y - 2), z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 2, 0 }, false }); // data(t, x, (y + 2), z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 0, -2 }, false }); // data(t, x, y, (z - 2)).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 0, 2 }, false }); // data(t, x, y, (z + 2)).
+  _accesses.push_back({ _context->data_ptr, { 0, -3, 0, 0 }, false }); // data(t, (x - 3), y, z).
+  _accesses.push_back({ _context->data_ptr, { 0, 3, 0, 0 }, false }); // data(t, (x + 3), y, z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, -3, 0 }, false }); // data(t, x, (y - 3), z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 3, 0 }, false }); // data(t, x, (y + 3), z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 0, -3 }, false }); // data(t, x, y, (z - 3)).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 0, 3 }, false }); // data(t, x, y, (z + 3)).
+  _accesses.push_back({ _context->data_ptr, { 0, -4, 0, 0 }, false }); // data(t, (x - 4), y, z).
+  _accesses.push_back({ _context->data_ptr, { 0, 4, 0, 0 }, false }); // data(t, (x + 4), y, z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, -4, 0 }, false }); // data(t, x, (y - 4), z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 4, 0 }, false }); // data(t, x, (y + 4), z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 0, -4 }, false }); // data(t, x, y, (z - 4)).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 0, 4 }, false }); // data(t, x, y, (z + 4)).
+  _accesses.push_back({ _context->data_ptr, { 0, -5, 0, 0 }, false }); // data(t, (x - 5), y, z).
+  _accesses.push_back({ _context->data_ptr, { 0, 5, 0, 0 }, false }); // data(t, (x + 5), y, z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, -5, 0 }, false }); // data(t, x, (y - 5), z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 5, 0 }, false }); // data(t, x, (y + 5), z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 0, -5 }, false }); // data(t, x, y, (z - 5)).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 0, 5 }, false }); // data(t, x, y, (z + 5)).
+  _accesses.push_back({ _context->data_ptr, { 0, -6, 0, 0 }, false }); // data(t, (x - 6), y, z).
+  _accesses.push_back({ _context->data_ptr, { 0, 6, 0, 0 }, false }); // data(t, (x + 6), y, z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, -6, 0 }, false }); // data(t, x, (y - 6), z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 6, 0 }, false }); // data(t, x, (y + 6), z).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 0, -6 }, false }); // data(t, x, y, (z - 6)).
+  _accesses.push_back({ _context->data_ptr, { 0, 0, 0, 6 }, false }); // data(t, x, y, (z + 6)).
+  _accesses.push_back({ _context->data_ptr, { 1, 0, 0, 0 }, true }); // data((t + 1), x, y, z).
+ } // Ctor.
+
+ // Determine whether StencilBundle_stencil_bundle_0 is valid at the indices t, x, y, z.
+ // Return true if indices are within the valid sub-domain or false otherwise.
+ virtual bool is_in_valid_domain(const Indices& idxs) const final {
+
+ // Extract individual indices.
+ idx_t t = idxs[0];
+ idx_t x = idxs[1];
+ idx_t y = idxs[2];
+ idx_t z = idxs[3];
+ return true; // full domain.
+ }
+
+ // Determine where StencilBundle_stencil_bundle_0 is valid in the vector whose
+ // first element is at the global indices t, x, y, z.
+ // Return a write mask with one bit set for each valid element.
+ virtual idx_t get_valid_mask(const Indices& idxs) const final {
+ return idx_t(-1); // full domain.
+ }
+
+ // Calculate one scalar result relative to indices t, x, y, z.
+ // There are approximately 43 FP operation(s) per invocation.
+ virtual void calc_scalar(int thread_idx, const Indices& idxs) {
+
+ // Extract individual indices.
+ idx_t t = idxs[0];
+ idx_t x = idxs[1];
+ idx_t y = idxs[2];
+ idx_t z = idxs[3];
+ auto temp1 = static_cast<_context_type::data_type*>(_context->data);
+ auto temp2 = temp1->_wrap_step(t);
+
+ // temp3 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))).
+ real_t temp3 = (9.000000000000000e-01 * temp1->readElem({t, x, y, z}, temp2, __LINE__)) + (8.000000000000000e-01 * (temp1->readElem({t, (x - 1), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 1), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 1), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 1), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 1)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 1)}, temp2, __LINE__)));
+
+ // temp4 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))).
+ real_t temp4 = temp3 + (-2.000000000000000e-01 * (temp1->readElem({t, (x - 2), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 2), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 2), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 2), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 2)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 2)}, temp2, __LINE__)));
+
+ // temp5 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))).
+ real_t temp5 = temp4 + (8.888888888888889e-02 * (temp1->readElem({t, (x - 3), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 3), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 3), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 3), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 3)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 3)}, temp2, __LINE__)));
+
+ // temp6 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))) + (-0.05 * (data(t, (x - 4), y, z) + data(t, (x + 4), y, z) + data(t, x, (y - 4), z) + data(t, x, (y + 4), z) + data(t, x, y, (z - 4)) + data(t, x, y, (z + 4)))).
+ real_t temp6 = temp5 + (-5.000000000000000e-02 * (temp1->readElem({t, (x - 4), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 4), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 4), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 4), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 4)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 4)}, temp2, __LINE__)));
+
+ // temp7 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))) + (-0.05 * (data(t, (x - 4), y, z) + data(t, (x + 4), y, z) + data(t, x, (y - 4), z) + data(t, x, (y + 4), z) + data(t, x, y, (z - 4)) + data(t, x, y, (z + 4)))) + (0.032 * (data(t, (x - 5), y, z) + data(t, (x + 5), y, z) + data(t, x, (y - 5), z) + data(t, x, (y + 5), z) + data(t, x, y, (z - 5)) + data(t, x, y, (z + 5)))).
+ real_t temp7 = temp6 + (3.200000000000000e-02 * (temp1->readElem({t, (x - 5), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 5), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 5), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 5), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 5)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 5)}, temp2, __LINE__)));
+
+ // temp8 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))) + (-0.05 * (data(t, (x - 4), y, z) + data(t, (x + 4), y, z) + data(t, x, (y - 4), z) + data(t, x, (y + 4), z) + data(t, x, y, (z - 4)) + data(t, x, y, (z + 4)))) + (0.032 * (data(t, (x - 5), y, z) + data(t, (x + 5), y, z) + data(t, x, (y - 5), z) + data(t, x, (y + 5), z) + data(t, x, y, (z - 5)) + data(t, x, y, (z + 5)))) + (-0.0222222 * (data(t, (x - 6), y, z) + data(t, (x + 6), y, z) + data(t, x, (y - 6), z) + data(t, x, (y + 6), z) + data(t, x, y, (z - 6)) + data(t, x, y, (z + 6)))).
+ real_t temp8 = temp7 + (-2.222222222222222e-02 * (temp1->readElem({t, (x - 6), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 6), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 6), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 6), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 6)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 6)}, temp2, __LINE__)));
+
+ // temp9 = ((0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))) + (-0.05 * (data(t, (x - 4), y, z) + data(t, (x + 4), y, z) + data(t, x, (y - 4), z) + data(t, x, (y + 4), z) + data(t, x, y, (z - 4)) + data(t, x, y, (z + 4)))) + (0.032 * (data(t, (x - 5), y, z) + data(t, (x + 5), y, z) + data(t, x, (y - 5), z) + data(t, x, (y + 5), z) + data(t, x, y, (z - 5)) + data(t, x, y, (z + 5)))) + (-0.0222222 * (data(t, (x - 6), y, z) + data(t, (x + 6), y, z) + data(t, x, (y - 6), z) + data(t, x, (y + 6), z) + data(t, x, y, (z - 6)) + data(t, x, y, (z + 6))))).
+ real_t temp9 = temp8;
+
+ // Update value at data((t + 1), x, y, z).
+  auto temp10 = temp1->_wrap_step((t + 1));
+temp1->writeElem(temp9, {(t + 1), x, y, z}, temp10, __LINE__);
+} // calc_scalar.
+
+ // Calculate a series of vectors iterating in +'z' direction from t, x, y, z indices in 'idxs' to 'stop_z'.
+ // Each vector calculates 'x=8 * y=1 * z=1' point(s).
+ // Indices must be rank-relative (not global).
+ // Indices must be normalized, i.e., already divided by VLEN_*.
+ // SIMD calculations use 37 vector block(s) created from 27 aligned vector-block(s).
+ // There are approximately 344 FP operation(s) per iteration.
+ void calc_loop_of_vectors(int thread_idx, const Indices& idxs, idx_t stop_z, idx_t write_mask) {
+
+ // Extract individual indices.
+ idx_t t = idxs[0];
+ idx_t x = idxs[1];
+ idx_t y = idxs[2];
+ idx_t z = idxs[3];
+ idx_t start_z = z;
+ idx_t step_z = 1; // number of vectors per iter.
+ idx_t step_z_elem = VLEN_Z; // number of elements per iter.
+ bool use_nt_stores = _context->use_nt_stores() && write_mask == idx_t(-1); // streaming stores need whole vectors.
+ auto& opts = _context->get_settings();
+ const int pfd_l1 = opts->_prefetch_L1_dist; // prefetch distances.
+ const int pfd_l2 = opts->_prefetch_L2_dist;
+ const int pfh_l1 = opts->_prefetch_L1_hint; // prefetch hints.
+ const int pfh_l2 = opts->_prefetch_L2_hint;
+
+ // Element indices derived from vector indices.
+ idx_t x_elem = _context->rank_domain_offsets[0] + (x * VLEN_X);
+ idx_t y_elem = _context->rank_domain_offsets[1] + (y * VLEN_Y);
+ idx_t z_elem = _context->rank_domain_offsets[2] + (z * VLEN_Z);
+
+ // Force inlining if possible.
+#if !defined(DEBUG) && defined(__INTEL_COMPILER)
+#pragma forceinline recursive
+#endif
+ {
+
+ // Calculate pointer to  vector starting at data(t, (x - 8), y, 0).
+ auto temp17 = static_cast<_context_type::data_type*>(_context->data);
+ auto temp18 = temp17->_wrap_step(t);
+ real_vec_t* temp1 = temp17->getVecPtrNorm({t, (x-(8 / VLEN_X)), y, 0} ,temp18, false);
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp1[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp1[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Distance in vectors between 'data' vectors one apart in 'x'.
+ idx_t temp19 = temp17->getVecPtrNorm({t, x, y, 0} ,temp18, false) - temp1;
+
+ // Distance in vectors between 'data' vectors one apart in 'y'.
+ idx_t temp20 = temp17->getVecPtrNorm({t, (x-(8 / VLEN_X)), (y+(1 / VLEN_Y)), 0} ,temp18, false) - temp1;
+
+ // Calculate pointer to  vector starting at data(t, x, (y - 6), 0).
+ real_vec_t* temp2 = temp1 +(8 / VLEN_X) * temp19 -(6 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp2[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp2[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y - 5), 0).
+ real_vec_t* temp3 = temp1 +(8 / VLEN_X) * temp19 -(5 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp3[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp3[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y - 4), 0).
+ real_vec_t* temp4 = temp1 +(8 / VLEN_X) * temp19 -(4 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp4[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp4[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y - 3), 0).
+ real_vec_t* temp5 = temp1 +(8 / VLEN_X) * temp19 -(3 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp5[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp5[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y - 2), 0).
+ real_vec_t* temp6 = temp1 +(8 / VLEN_X) * temp19 -(2 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp6[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp6[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y - 1), 0).
+ real_vec_t* temp7 = temp1 +(8 / VLEN_X) * temp19 -(1 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp7[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp7[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, y, 0).
+ real_vec_t* temp8 = temp1 +(8 / VLEN_X) * temp19;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = -(6 / VLEN_Z); ofs < (pfd_l1*CMULT_Z)+(6 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp8[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = -(6 / VLEN_Z); ofs < (pfd_l2*CMULT_Z)+(6 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp8[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y + 1), 0).
+ real_vec_t* temp9 = temp1 +(8 / VLEN_X) * temp19 +(1 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp9[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp9[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y + 2), 0).
+ real_vec_t* temp10 = temp1 +(8 / VLEN_X) * temp19 +(2 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp10[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp10[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y + 3), 0).
+ real_vec_t* temp11 = temp1 +(8 / VLEN_X) * temp19 +(3 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp11[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp11[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y + 4), 0).
+ real_vec_t* temp12 = temp1 +(8 / VLEN_X) * temp19 +(4 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp12[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp12[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y + 5), 0).
+ real_vec_t* temp13 = temp1 +(8 / VLEN_X) * temp19 +(5 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp13[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp13[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y + 6), 0).
+ real_vec_t* temp14 = temp1 +(8 / VLEN_X) * temp19 +(6 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp14[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp14[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, (x + 8), y, 0).
+ real_vec_t* temp15 = temp1 +(16 / VLEN_X) * temp19;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp15[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp15[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data((t + 1), x, y, 0).
+ auto temp21 = temp17->_wrap_step((t + 1));
+ real_vec_t* temp16 = temp17->getVecPtrNorm({(t + 1), x, y, 0} ,temp21, false);
+
+ // 12 aligned vector-block(s) carried in registers across 'z' iterations.
+ real_vec_t temp22;
+ real_vec_t temp23;
+ real_vec_t temp24;
+ real_vec_t temp25;
+ real_vec_t temp26;
+ real_vec_t temp27;
+ real_vec_t temp28;
+ real_vec_t temp29;
+ real_vec_t temp30;
+ real_vec_t temp31;
+ real_vec_t temp32;
+ real_vec_t temp33;
+ if (z < stop_z) {
+
+ // Read carried vector starting at data(t, x, y, (z - 6)).
+ temp22 = temp8[(z-(6 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z - 5)).
+ temp23 = temp8[(z-(5 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z - 4)).
+ temp24 = temp8[(z-(4 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z - 3)).
+ temp25 = temp8[(z-(3 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z - 2)).
+ temp26 = temp8[(z-(2 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z - 1)).
+ temp27 = temp8[(z-(1 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, z).
+ temp28 = temp8[z];
+
+ // Read carried vector starting at data(t, x, y, (z + 1)).
+ temp29 = temp8[(z+(1 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z + 2)).
+ temp30 = temp8[(z+(2 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z + 3)).
+ temp31 = temp8[(z+(3 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z + 4)).
+ temp32 = temp8[(z+(4 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z + 5)).
+ temp33 = temp8[(z+(5 / VLEN_Z))];
+ }
+
+ // Inner loop.
+ for (idx_t z = start_z; z < stop_z; z += step_z, z_elem += step_z_elem) {
+
+ // Read aligned vector starting at data(t, (x - 8), y, z).
+ real_vec_t temp34 = temp1[z];
+
+ // Construct unaligned vector starting at data(t, (x - 1), y, z).
+ real_vec_t temp35;
+ // temp35[0] = temp34[7];  // for data(t, x-1, y, z);
+ // temp35[1] = temp28[0];  // for data(t, x, y, z);
+ // temp35[2] = temp28[1];  // for data(t, x+1, y, z);
+ // temp35[3] = temp28[2];  // for data(t, x+2, y, z);
+ // temp35[4] = temp28[3];  // for data(t, x+3, y, z);
+ // temp35[5] = temp28[4];  // for data(t, x+4, y, z);
+ // temp35[6] = temp28[5];  // for data(t, x+5, y, z);
+ // temp35[7] = temp28[6];  // for data(t, x+6, y, z);
+ // Get 7 element(s) from temp28 and 1 from temp34.
+ real_vec_align<7>(temp35, temp28, temp34);
+
+ // Read aligned vector starting at data(t, (x + 8), y, z).
+ real_vec_t temp36 = temp15[z];
+
+ // Construct unaligned vector starting at data(t, (x + 1), y, z).
+ real_vec_t temp37;
+ // temp37[0] = temp28[1];  // for data(t, x+1, y, z);
+ // temp37[1] = temp28[2];  // for data(t, x+2, y, z);
+ // temp37[2] = temp28[3];  // for data(t, x+3, y, z);
+ // temp37[3] = temp28[4];  // for data(t, x+4, y, z);
+ // temp37[4] = temp28[5];  // for data(t, x+5, y, z);
+ // temp37[5] = temp28[6];  // for data(t, x+6, y, z);
+ // temp37[6] = temp28[7];  // for data(t, x+7, y, z);
+ // temp37[7] = temp36[0];  // for data(t, x+8, y, z);
+ // Get 1 element(s) from temp36 and 7 from temp28.
+ real_vec_align<1>(temp37, temp36, temp28);
+
+ // Read aligned vector starting at data(t, x, (y - 1), z).
+ real_vec_t temp38 = temp7[z];
+
+ // Read aligned vector starting at data(t, x, (y + 1), z).
+ real_vec_t temp39 = temp9[z];
+
+ // temp40 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))).
+ real_vec_t temp40 = (9.000000000000000e-01 * temp28) + (8.000000000000000e-01 * (temp35 + temp37 + temp38 + temp39 + temp27 + temp29));
+
+ // Construct unaligned vector starting at data(t, (x - 2), y, z).
+ real_vec_t temp41;
+ // temp41[0] = temp34[6];  // for data(t, x-2, y, z);
+ // temp41[1] = temp34[7];  // for data(t, x-1, y, z);
+ // temp41[2] = temp28[0];  // for data(t, x, y, z);
+ // temp41[3] = temp28[1];  // for data(t, x+1, y, z);
+ // temp41[4] = temp28[2];  // for data(t, x+2, y, z);
+ // temp41[5] = temp28[3];  // for data(t, x+3, y, z);
+ // temp41[6] = temp28[4];  // for data(t, x+4, y, z);
+ // temp41[7] = temp28[5];  // for data(t, x+5, y, z);
+ // Get 6 element(s) from temp28 and 2 from temp34.
+ real_vec_align<6>(temp41, temp28, temp34);
+
+ // Construct unaligned vector starting at data(t, (x + 2), y, z).
+ real_vec_t temp42;
+ // temp42[0] = temp28[2];  // for data(t, x+2, y, z);
+ // temp42[1] = temp28[3];  // for data(t, x+3, y, z);
+ // temp42[2] = temp28[4];  // for data(t, x+4, y, z);
+ // temp42[3] = temp28[5];  // for data(t, x+5, y, z);
+ // temp42[4] = temp28[6];  // for data(t, x+6, y, z);
+ // temp42[5] = temp28[7];  // for data(t, x+7, y, z);
+ // temp42[6] = temp36[0];  // for data(t, x+8, y, z);
+ // temp42[7] = temp36[1];  // for data(t, x+9, y, z);
+ // Get 2 element(s) from temp36 and 6 from temp28.
+ real_vec_align<2>(temp42, temp36, temp28);
+
+ // Read aligned vector starting at data(t, x, (y - 2), z).
+ real_vec_t temp43 = temp6[z];
+
+ // Read aligned vector starting at data(t, x, (y + 2), z).
+ real_vec_t temp44 = temp10[z];
+
+ // temp45 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))).
+ real_vec_t temp45 = temp40 + (-2.000000000000000e-01 * (temp41 + temp42 + temp43 + temp44 + temp26 + temp30));
+
+ // Construct unaligned vector starting at data(t, (x - 3), y, z).
+ real_vec_t temp46;
+ // temp46[0] = temp34[5];  // for data(t, x-3, y, z);
+ // temp46[1] = temp34[6];  // for data(t, x-2, y, z);
+ // temp46[2] = temp34[7];  // for data(t, x-1, y, z);
+ // temp46[3] = temp28[0];  // for data(t, x, y, z);
+ // temp46[4] = temp28[1];  // for data(t, x+1, y, z);
+ // temp46[5] = temp28[2];  // for data(t, x+2, y, z);
+ // temp46[6] = temp28[3];  // for data(t, x+3, y, z);
+ // temp46[7] = temp28[4];  // for data(t, x+4, y, z);
+ // Get 5 element(s) from temp28 and 3 from temp34.
+ real_vec_align<5>(temp46, temp28, temp34);
+
+ // Construct unaligned vector starting at data(t, (x + 3), y, z).
+ real_vec_t temp47;
+ // temp47[0] = temp28[3];  // for data(t, x+3, y, z);
+ // temp47[1] = temp28[4];  // for data(t, x+4, y, z);
+ // temp47[2] = temp28[5];  // for data(t, x+5, y, z);
+ // temp47[3] = temp28[6];  // for data(t, x+6, y, z);
+ // temp47[4] = temp28[7];  // for data(t, x+7, y, z);
+ // temp47[5] = temp36[0];  // for data(t, x+8, y, z);
+ // temp47[6] = temp36[1];  // for data(t, x+9, y, z);
+ // temp47[7] = temp36[2];  // for data(t, x+10, y, z);
+ // Get 3 element(s) from temp36 and 5 from temp28.
+ real_vec_align<3>(temp47, temp36, temp28);
+
+ // Read aligned vector starting at data(t, x, (y - 3), z).
+ real_vec_t temp48 = temp5[z];
+
+ // Read aligned vector starting at data(t, x, (y + 3), z).
+ real_vec_t temp49 = temp11[z];
+
+ // temp50 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))).
+ real_vec_t temp50 = temp45 + (8.888888888888889e-02 * (temp46 + temp47 + temp48 + temp49 + temp25 + temp31));
+
+ // Construct unaligned vector starting at data(t, (x - 4), y, z).
+ real_vec_t temp51;
+ // temp51[0] = temp34[4];  // for data(t, x-4, y, z);
+ // temp51[1] = temp34[5];  // for data(t, x-3, y, z);
+ // temp51[2] = temp34[6];  // for data(t, x-2, y, z);
+ // temp51[3] = temp34[7];  // for data(t, x-1, y, z);
+ // temp51[4] = temp28[0];  // for data(t, x, y, z);
+ // temp51[5] = temp28[1];  // for data(t, x+1, y, z);
+ // temp51[6] = temp28[2];  // for data(t, x+2, y, z);
+ // temp51[7] = temp28[3];  // for data(t, x+3, y, z);
+ // Get 4 element(s) from temp28 and 4 from temp34.
+ real_vec_align<4>(temp51, temp28, temp34);
+
+ // Construct unaligned vector starting at data(t, (x + 4), y, z).
+ real_vec_t temp52;
+ // temp52[0] = temp28[4];  // for data(t, x+4, y, z);
+ // temp52[1] = temp28[5];  // for data(t, x+5, y, z);
+ // temp52[2] = temp28[6];  // for data(t, x+6, y, z);
+ // temp52[3] = temp28[7];  // for data(t, x+7, y, z);
+ // temp52[4] = temp36[0];  // for data(t, x+8, y, z);
+ // temp52[5] = temp36[1];  // for data(t, x+9, y, z);
+ // temp52[6] = temp36[2];  // for data(t, x+10, y, z);
+ // temp52[7] = temp36[3];  // for data(t, x+11, y, z);
+ // Get 4 element(s) from temp36 and 4 from temp28.
+ real_vec_align<4>(temp52, temp36, temp28);
+
+ // Read aligned vector starting at data(t, x, (y - 4), z).
+ real_vec_t temp53 = temp4[z];
+
+ // Read aligned vector starting at data(t, x, (y + 4), z).
+ real_vec_t temp54 = temp12[z];
+
+ // temp55 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))) + (-0.05 * (data(t, (x - 4), y, z) + data(t, (x + 4), y, z) + data(t, x, (y - 4), z) + data(t, x, (y + 4), z) + data(t, x, y, (z - 4)) + data(t, x, y, (z + 4)))).
+ real_vec_t temp55 = temp50 + (-5.000000000000000e-02 * (temp51 + temp52 + temp53 + temp54 + temp24 + temp32));
+
+ // Construct unaligned vector starting at data(t, (x - 5), y, z).
+ real_vec_t temp56;
+ // temp56[0] = temp34[3];  // for data(t, x-5, y, z);
+ // temp56[1] = temp34[4];  // for data(t, x-4, y, z);
+ // temp56[2] = temp34[5];  // for data(t, x-3, y, z);
+ // temp56[3] = temp34[6];  // for data(t, x-2, y, z);
+ // temp56[4] = temp34[7];  // for data(t, x-1, y, z);
+ // temp56[5] = temp28[0];  // for data(t, x, y, z);
+ // temp56[6] = temp28[1];  // for data(t, x+1, y, z);
+ // temp56[7] = temp28[2];  // for data(t, x+2, y, z);
+ // Get 3 element(s) from temp28 and 5 from temp34.
+ real_vec_align<3>(temp56, temp28, temp34);
+
+ // Construct unaligned vector starting at data(t, (x + 5), y, z).
+ real_vec_t temp57;
+ // temp57[0] = temp28[5];  // for data(t, x+5, y, z);
+ // temp57[1] = temp28[6];  // for data(t, x+6, y, z);
+ // temp57[2] = temp28[7];  // for data(t, x+7, y, z);
+ // temp57[3] = temp36[0];  // for data(t, x+8, y, z);
+ // temp57[4] = temp36[1];  // for data(t, x+9, y, z);
+ // temp57[5] = temp36[2];  // for data(t, x+10, y, z);
+ // temp57[6] = temp36[3];  // for data(t, x+11, y, z);
+ // temp57[7] = temp36[4];  // for data(t, x+12, y, z);
+ // Get 5 element(s) from temp36 and 3 from temp28.
+ real_vec_align<5>(temp57, temp36, temp28);
+
+ // Read aligned vector starting at data(t, x, (y - 5), z).
+ real_vec_t temp58 = temp3[z];
+
+ // Read aligned vector starting at data(t, x, (y + 5), z).
+ real_vec_t temp59 = temp13[z];
+
+ // temp60 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))) + (-0.05 * (data(t, (x - 4), y, z) + data(t, (x + 4), y, z) + data(t, x, (y - 4), z) + data(t, x, (y + 4), z) + data(t, x, y, (z - 4)) + data(t, x, y, (z + 4)))) + (0.032 * (data(t, (x - 5), y, z) + data(t, (x + 5), y, z) + data(t, x, (y - 5), z) + data(t, x, (y + 5), z) + data(t, x, y, (z - 5)) + data(t, x, y, (z + 5)))).
+ real_vec_t temp60 = temp55 + (3.200000000000000e-02 * (temp56 + temp57 + temp58 + temp59 + temp23 + temp33));
+
+ // Construct unaligned vector starting at data(t, (x - 6), y, z).
+ real_vec_t temp61;
+ // temp61[0] = temp34[2];  // for data(t, x-6, y, z);
+ // temp61[1] = temp34[3];  // for data(t, x-5, y, z);
+ // temp61[2] = temp34[4];  // for data(t, x-4, y, z);
+ // temp61[3] = temp34[5];  // for data(t, x-3, y, z);
+ // temp61[4] = temp34[6];  // for data(t, x-2, y, z);
+ // temp61[5] = temp34[7];  // for data(t, x-1, y, z);
+ // temp61[6] = temp28[0];  // for data(t, x, y, z);
+ // temp61[7] = temp28[1];  // for data(t, x+1, y, z);
+ // Get 2 element(s) from temp28 and 6 from temp34.
+ real_vec_align<2>(temp61, temp28, temp34);
+
+ // Construct unaligned vector starting at data(t, (x + 6), y, z).
+ real_vec_t temp62;
+ // temp62[0] = temp28[6];  // for data(t, x+6, y, z);
+ // temp62[1] = temp28[7];  // for data(t, x+7, y, z);
+ // temp62[2] = temp36[0];  // for data(t, x+8, y, z);
+ // temp62[3] = temp36[1];  // for data(t, x+9, y, z);
+ // temp62[4] = temp36[2];  // for data(t, x+10, y, z);
+ // temp62[5] = temp36[3];  // for data(t, x+11, y, z);
+ // temp62[6] = temp36[4];  // for data(t, x+12, y, z);
+ // temp62[7] = temp36[5];  // for data(t, x+13, y, z);
+ // Get 6 element(s) from temp36 and 2 from temp28.
+ real_vec_align<6>(temp62, temp36, temp28);
+
+ // Read aligned vector starting at data(t, x, (y - 6), z).
+ real_vec_t temp63 = temp2[z];
+
+ // Read aligned vector starting at data(t, x, (y + 6), z).
+ real_vec_t temp64 = temp14[z];
+
+ // Read aligned vector starting at data(t, x, y, (z + 6)).
+ real_vec_t temp65 = temp8[(z+(6 / VLEN_Z))];
+
+ // temp66 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))) + (-0.05 * (data(t, (x - 4), y, z) + data(t, (x + 4), y, z) + data(t, x, (y - 4), z) + data(t, x, (y + 4), z) + data(t, x, y, (z - 4)) + data(t, x, y, (z + 4)))) + (0.032 * (data(t, (x - 5), y, z) + data(t, (x + 5), y, z) + data(t, x, (y - 5), z) + data(t, x, (y + 5), z) + data(t, x, y, (z - 5)) + data(t, x, y, (z + 5)))) + (-0.0222222 * (data(t, (x - 6), y, z) + data(t, (x + 6), y, z) + data(t, x, (y - 6), z) + data(t, x, (y + 6), z) + data(t, x, y, (z - 6)) + data(t, x, y, (z + 6)))).
+ real_vec_t temp66 = temp60 + (-2.222222222222222e-02 * (temp61 + temp62 + temp63 + temp64 + temp22 + temp65));
+
+ // temp67 = ((0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))) + (-0.05 * (data(t, (x - 4), y, z) + data(t, (x + 4), y, z) + data(t, x, (y - 4), z) + data(t, x, (y + 4), z) + data(t, x, y, (z - 4)) + data(t, x, y, (z + 4)))) + (0.032 * (data(t, (x - 5), y, z) + data(t, (x + 5), y, z) + data(t, x, (y - 5), z) + data(t, x, (y + 5), z) + data(t, x, y, (z - 5)) + data(t, x, y, (z + 5)))) + (-0.0222222 * (data(t, (x - 6), y, z) + data(t, (x + 6), y, z) + data(t, x, (y - 6), z) + data(t, x, (y + 6), z) + data(t, x, y, (z - 6)) + data(t, x, y, (z + 6))))).
+ real_vec_t temp67 = temp66;
+
+ // Update value at data((t + 1), x, y, z).
+ 
+ // Write aligned vector starting at data((t + 1), x, y, z).
+ if (use_nt_stores) temp67.storeTo_nt(temp16+z); else temp67.storeTo_masked(temp16+z, write_mask);
+;
+
+ // Carry vector-blocks to next iteration.
+ temp22 = temp23;
+ temp23 = temp24;
+ temp24 = temp25;
+ temp25 = temp26;
+ temp26 = temp27;
+ temp27 = temp28;
+ temp28 = temp29;
+ temp29 = temp30;
+ temp30 = temp31;
+ temp31 = temp32;
+ temp32 = temp33;
+ temp33 = temp65;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp1[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp2[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp3[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp4[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp5[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp6[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp7[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(6 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(6 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp8[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp9[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp10[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp11[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp12[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp13[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp14[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp15[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp16[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp1[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp2[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp3[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp4[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp5[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp6[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp7[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(6 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(6 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp8[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp9[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp10[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp11[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp12[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp13[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp14[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp15[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp16[z + ofs]);
+ }
+#endif // L2 prefetch.
+ } // 'z' loop.
+ } // Forced-inline block.
+} // calc_loop_of_vectors.
+
+ // Calculate a series of clusters iterating in +'z' direction from t, x, y, z indices in 'idxs' to 'stop_z'.
+ // Each cluster calculates 'x=8 * y=1 * z=1' point(s) containing 1 'x=8 * y=1 * z=1' vector(s).
+ // Indices must be rank-relative (not global).
+ // Indices must be normalized, i.e., already divided by VLEN_*.
+ // SIMD calculations use 37 vector block(s) created from 27 aligned vector-block(s).
+ // There are approximately 344 FP operation(s) per iteration.
+ void calc_loop_of_clusters(int thread_idx, const Indices& idxs, idx_t stop_z) {
+
+ // Extract individual indices.
+ idx_t t = idxs[0];
+ idx_t x = idxs[1];
+ idx_t y = idxs[2];
+ idx_t z = idxs[3];
+ idx_t start_z = z;
+ idx_t step_z = CMULT_Z; // number of vectors per iter.
+ idx_t step_z_elem = CMULT_Z * VLEN_Z; // number of elements per iter.
+ idx_t write_mask = idx_t(-1); // no masking for clusters.
+ bool use_nt_stores = _context->use_nt_stores(); // streaming stores need whole vectors.
+ auto& opts = _context->get_settings();
+ const int pfd_l1 = opts->_prefetch_L1_dist; // prefetch distances.
+ const int pfd_l2 = opts->_prefetch_L2_dist;
+ const int pfh_l1 = opts->_prefetch_L1_hint; // prefetch hints.
+ const int pfh_l2 = opts->_prefetch_L2_hint;
+
+ // Element indices derived from vector indices.
+ idx_t x_elem = _context->rank_domain_offsets[0] + (x * VLEN_X);
+ idx_t y_elem = _context->rank_domain_offsets[1] + (y * VLEN_Y);
+ idx_t z_elem = _context->rank_domain_offsets[2] + (z * VLEN_Z);
+
+ // Force inlining if possible.
+#if !defined(DEBUG) && defined(__INTEL_COMPILER)
+#pragma forceinline recursive
+#endif
+ {
+
+ // Calculate pointer to  vector starting at data(t, (x - 8), y, 0).
+ auto temp17 = static_cast<_context_type::data_type*>(_context->data);
+ auto temp18 = temp17->_wrap_step(t);
+ real_vec_t* temp1 = temp17->getVecPtrNorm({t, (x-(8 / VLEN_X)), y, 0} ,temp18, false);
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp1[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp1[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Distance in vectors between 'data' vectors one apart in 'x'.
+ idx_t temp19 = temp17->getVecPtrNorm({t, x, y, 0} ,temp18, false) - temp1;
+
+ // Distance in vectors between 'data' vectors one apart in 'y'.
+ idx_t temp20 = temp17->getVecPtrNorm({t, (x-(8 / VLEN_X)), (y+(1 / VLEN_Y)), 0} ,temp18, false) - temp1;
+
+ // Calculate pointer to  vector starting at data(t, x, (y - 6), 0).
+ real_vec_t* temp2 = temp1 +(8 / VLEN_X) * temp19 -(6 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp2[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp2[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y - 5), 0).
+ real_vec_t* temp3 = temp1 +(8 / VLEN_X) * temp19 -(5 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp3[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp3[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y - 4), 0).
+ real_vec_t* temp4 = temp1 +(8 / VLEN_X) * temp19 -(4 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp4[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp4[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y - 3), 0).
+ real_vec_t* temp5 = temp1 +(8 / VLEN_X) * temp19 -(3 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp5[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp5[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y - 2), 0).
+ real_vec_t* temp6 = temp1 +(8 / VLEN_X) * temp19 -(2 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp6[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp6[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y - 1), 0).
+ real_vec_t* temp7 = temp1 +(8 / VLEN_X) * temp19 -(1 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp7[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp7[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, y, 0).
+ real_vec_t* temp8 = temp1 +(8 / VLEN_X) * temp19;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = -(6 / VLEN_Z); ofs < (pfd_l1*CMULT_Z)+(6 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp8[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = -(6 / VLEN_Z); ofs < (pfd_l2*CMULT_Z)+(6 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp8[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y + 1), 0).
+ real_vec_t* temp9 = temp1 +(8 / VLEN_X) * temp19 +(1 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp9[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp9[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y + 2), 0).
+ real_vec_t* temp10 = temp1 +(8 / VLEN_X) * temp19 +(2 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp10[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp10[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y + 3), 0).
+ real_vec_t* temp11 = temp1 +(8 / VLEN_X) * temp19 +(3 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp11[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp11[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y + 4), 0).
+ real_vec_t* temp12 = temp1 +(8 / VLEN_X) * temp19 +(4 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp12[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp12[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y + 5), 0).
+ real_vec_t* temp13 = temp1 +(8 / VLEN_X) * temp19 +(5 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp13[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp13[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, x, (y + 6), 0).
+ real_vec_t* temp14 = temp1 +(8 / VLEN_X) * temp19 +(6 / VLEN_Y) * temp20;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp14[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp14[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data(t, (x + 8), y, 0).
+ real_vec_t* temp15 = temp1 +(16 / VLEN_X) * temp19;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp15[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp15[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at data((t + 1), x, y, 0).
+ auto temp21 = temp17->_wrap_step((t + 1));
+ real_vec_t* temp16 = temp17->getVecPtrNorm({(t + 1), x, y, 0} ,temp21, false);
+
+ // 12 aligned vector-block(s) carried in registers across 'z' iterations.
+ real_vec_t temp22;
+ real_vec_t temp23;
+ real_vec_t temp24;
+ real_vec_t temp25;
+ real_vec_t temp26;
+ real_vec_t temp27;
+ real_vec_t temp28;
+ real_vec_t temp29;
+ real_vec_t temp30;
+ real_vec_t temp31;
+ real_vec_t temp32;
+ real_vec_t temp33;
+ if (z < stop_z) {
+
+ // Read carried vector starting at data(t, x, y, (z - 6)).
+ temp22 = temp8[(z-(6 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z - 5)).
+ temp23 = temp8[(z-(5 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z - 4)).
+ temp24 = temp8[(z-(4 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z - 3)).
+ temp25 = temp8[(z-(3 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z - 2)).
+ temp26 = temp8[(z-(2 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z - 1)).
+ temp27 = temp8[(z-(1 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, z).
+ temp28 = temp8[z];
+
+ // Read carried vector starting at data(t, x, y, (z + 1)).
+ temp29 = temp8[(z+(1 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z + 2)).
+ temp30 = temp8[(z+(2 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z + 3)).
+ temp31 = temp8[(z+(3 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z + 4)).
+ temp32 = temp8[(z+(4 / VLEN_Z))];
+
+ // Read carried vector starting at data(t, x, y, (z + 5)).
+ temp33 = temp8[(z+(5 / VLEN_Z))];
+ }
+
+ // Inner loop.
+ for (idx_t z = start_z; z < stop_z; z += step_z, z_elem += step_z_elem) {
+
+ // Read aligned vector starting at data(t, (x - 8), y, z).
+ real_vec_t temp34 = temp1[z];
+
+ // Construct unaligned vector starting at data(t, (x - 1), y, z).
+ real_vec_t temp35;
+ // temp35[0] = temp34[7];  // for data(t, x-1, y, z);
+ // temp35[1] = temp28[0];  // for data(t, x, y, z);
+ // temp35[2] = temp28[1];  // for data(t, x+1, y, z);
+ // temp35[3] = temp28[2];  // for data(t, x+2, y, z);
+ // temp35[4] = temp28[3];  // for data(t, x+3, y, z);
+ // temp35[5] = temp28[4];  // for data(t, x+4, y, z);
+ // temp35[6] = temp28[5];  // for data(t, x+5, y, z);
+ // temp35[7] = temp28[6];  // for data(t, x+6, y, z);
+ // Get 7 element(s) from temp28 and 1 from temp34.
+ real_vec_align<7>(temp35, temp28, temp34);
+
+ // Read aligned vector starting at data(t, (x + 8), y, z).
+ real_vec_t temp36 = temp15[z];
+
+ // Construct unaligned vector starting at data(t, (x + 1), y, z).
+ real_vec_t temp37;
+ // temp37[0] = temp28[1];  // for data(t, x+1, y, z);
+ // temp37[1] = temp28[2];  // for data(t, x+2, y, z);
+ // temp37[2] = temp28[3];  // for data(t, x+3, y, z);
+ // temp37[3] = temp28[4];  // for data(t, x+4, y, z);
+ // temp37[4] = temp28[5];  // for data(t, x+5, y, z);
+ // temp37[5] = temp28[6];  // for data(t, x+6, y, z);
+ // temp37[6] = temp28[7];  // for data(t, x+7, y, z);
+ // temp37[7] = temp36[0];  // for data(t, x+8, y, z);
+ // Get 1 element(s) from temp36 and 7 from temp28.
+ real_vec_align<1>(temp37, temp36, temp28);
+
+ // Read aligned vector starting at data(t, x, (y - 1), z).
+ real_vec_t temp38 = temp7[z];
+
+ // Read aligned vector starting at data(t, x, (y + 1), z).
+ real_vec_t temp39 = temp9[z];
+
+ // temp40 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))).
+ real_vec_t temp40 = (9.000000000000000e-01 * temp28) + (8.000000000000000e-01 * (temp35 + temp37 + temp38 + temp39 + temp27 + temp29));
+
+ // Construct unaligned vector starting at data(t, (x - 2), y, z).
+ real_vec_t temp41;
+ // temp41[0] = temp34[6];  // for data(t, x-2, y, z);
+ // temp41[1] = temp34[7];  // for data(t, x-1, y, z);
+ // temp41[2] = temp28[0];  // for data(t, x, y, z);
+ // temp41[3] = temp28[1];  // for data(t, x+1, y, z);
+ // temp41[4] = temp28[2];  // for data(t, x+2, y, z);
+ // temp41[5] = temp28[3];  // for data(t, x+3, y, z);
+ // temp41[6] = temp28[4];  // for data(t, x+4, y, z);
+ // temp41[7] = temp28[5];  // for data(t, x+5, y, z);
+ // Get 6 element(s) from temp28 and 2 from temp34.
+ real_vec_align<6>(temp41, temp28, temp34);
+
+ // Construct unaligned vector starting at data(t, (x + 2), y, z).
+ real_vec_t temp42;
+ // temp42[0] = temp28[2];  // for data(t, x+2, y, z);
+ // temp42[1] = temp28[3];  // for data(t, x+3, y, z);
+ // temp42[2] = temp28[4];  // for data(t, x+4, y, z);
+ // temp42[3] = temp28[5];  // for data(t, x+5, y, z);
+ // temp42[4] = temp28[6];  // for data(t, x+6, y, z);
+ // temp42[5] = temp28[7];  // for data(t, x+7, y, z);
+ // temp42[6] = temp36[0];  // for data(t, x+8, y, z);
+ // temp42[7] = temp36[1];  // for data(t, x+9, y, z);
+ // Get 2 element(s) from temp36 and 6 from temp28.
+ real_vec_align<2>(temp42, temp36, temp28);
+
+ // Read aligned vector starting at data(t, x, (y - 2), z).
+ real_vec_t temp43 = temp6[z];
+
+ // Read aligned vector starting at data(t, x, (y + 2), z).
+ real_vec_t temp44 = temp10[z];
+
+ // temp45 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))).
+ real_vec_t temp45 = temp40 + (-2.000000000000000e-01 * (temp41 + temp42 + temp43 + temp44 + temp26 + temp30));
+
+ // Construct unaligned vector starting at data(t, (x - 3), y, z).
+ real_vec_t temp46;
+ // temp46[0] = temp34[5];  // for data(t, x-3, y, z);
+ // temp46[1] = temp34[6];  // for data(t, x-2, y, z);
+ // temp46[2] = temp34[7];  // for data(t, x-1, y, z);
+ // temp46[3] = temp28[0];  // for data(t, x, y, z);
+ // temp46[4] = temp28[1];  // for data(t, x+1, y, z);
+ // temp46[5] = temp28[2];  // for data(t, x+2, y, z);
+ // temp46[6] = temp28[3];  // for data(t, x+3, y, z);
+ // temp46[7] = temp28[4];  // for data(t, x+4, y, z);
+ // Get 5 element(s) from temp28 and 3 from temp34.
+ real_vec_align<5>(temp46, temp28, temp34);
+
+ // Construct unaligned vector starting at data(t, (x + 3), y, z).
+ real_vec_t temp47;
+ // temp47[0] = temp28[3];  // for data(t, x+3, y, z);
+ // temp47[1] = temp28[4];  // for data(t, x+4, y, z);
+ // temp47[2] = temp28[5];  // for data(t, x+5, y, z);
+ // temp47[3] = temp28[6];  // for data(t, x+6, y, z);
+ // temp47[4] = temp28[7];  // for data(t, x+7, y, z);
+ // temp47[5] = temp36[0];  // for data(t, x+8, y, z);
+ // temp47[6] = temp36[1];  // for data(t, x+9, y, z);
+ // temp47[7] = temp36[2];  // for data(t, x+10, y, z);
+ // Get 3 element(s) from temp36 and 5 from temp28.
+ real_vec_align<3>(temp47, temp36, temp28);
+
+ // Read aligned vector starting at data(t, x, (y - 3), z).
+ real_vec_t temp48 = temp5[z];
+
+ // Read aligned vector starting at data(t, x, (y + 3), z).
+ real_vec_t temp49 = temp11[z];
+
+ // temp50 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))).
+ real_vec_t temp50 = temp45 + (8.888888888888889e-02 * (temp46 + temp47 + temp48 + temp49 + temp25 + temp31));
+
+ // Construct unaligned vector starting at data(t, (x - 4), y, z).
+ real_vec_t temp51;
+ // temp51[0] = temp34[4];  // for data(t, x-4, y, z);
+ // temp51[1] = temp34[5];  // for data(t, x-3, y, z);
+ // temp51[2] = temp34[6];  // for data(t, x-2, y, z);
+ // temp51[3] = temp34[7];  // for data(t, x-1, y, z);
+ // temp51[4] = temp28[0];  // for data(t, x, y, z);
+ // temp51[5] = temp28[1];  // for data(t, x+1, y, z);
+ // temp51[6] = temp28[2];  // for data(t, x+2, y, z);
+ // temp51[7] = temp28[3];  // for data(t, x+3, y, z);
+ // Get 4 element(s) from temp28 and 4 from temp34.
+ real_vec_align<4>(temp51, temp28, temp34);
+
+ // Construct unaligned vector starting at data(t, (x + 4), y, z).
+ real_vec_t temp52;
+ // temp52[0] = temp28[4];  // for data(t, x+4, y, z);
+ // temp52[1] = temp28[5];  // for data(t, x+5, y, z);
+ // temp52[2] = temp28[6];  // for data(t, x+6, y, z);
+ // temp52[3] = temp28[7];  // for data(t, x+7, y, z);
+ // temp52[4] = temp36[0];  // for data(t, x+8, y, z);
+ // temp52[5] = temp36[1];  // for data(t, x+9, y, z);
+ // temp52[6] = temp36[2];  // for data(t, x+10, y, z);
+ // temp52[7] = temp36[3];  // for data(t, x+11, y, z);
+ // Get 4 element(s) from temp36 and 4 from temp28.
+ real_vec_align<4>(temp52, temp36, temp28);
+
+ // Read aligned vector starting at data(t, x, (y - 4), z).
+ real_vec_t temp53 = temp4[z];
+
+ // Read aligned vector starting at data(t, x, (y + 4), z).
+ real_vec_t temp54 = temp12[z];
+
+ // temp55 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))) + (-0.05 * (data(t, (x - 4), y, z) + data(t, (x + 4), y, z) + data(t, x, (y - 4), z) + data(t, x, (y + 4), z) + data(t, x, y, (z - 4)) + data(t, x, y, (z + 4)))).
+ real_vec_t temp55 = temp50 + (-5.000000000000000e-02 * (temp51 + temp52 + temp53 + temp54 + temp24 + temp32));
+
+ // Construct unaligned vector starting at data(t, (x - 5), y, z).
+ real_vec_t temp56;
+ // temp56[0] = temp34[3];  // for data(t, x-5, y, z);
+ // temp56[1] = temp34[4];  // for data(t, x-4, y, z);
+ // temp56[2] = temp34[5];  // for data(t, x-3, y, z);
+ // temp56[3] = temp34[6];  // for data(t, x-2, y, z);
+ // temp56[4] = temp34[7];  // for data(t, x-1, y, z);
+ // temp56[5] = temp28[0];  // for data(t, x, y, z);
+ // temp56[6] = temp28[1];  // for data(t, x+1, y, z);
+ // temp56[7] = temp28[2];  // for data(t, x+2, y, z);
+ // Get 3 element(s) from temp28 and 5 from temp34.
+ real_vec_align<3>(temp56, temp28, temp34);
+
+ // Construct unaligned vector starting at data(t, (x + 5), y, z).
+ real_vec_t temp57;
+ // temp57[0] = temp28[5];  // for data(t, x+5, y, z);
+ // temp57[1] = temp28[6];  // for data(t, x+6, y, z);
+ // temp57[2] = temp28[7];  // for data(t, x+7, y, z);
+ // temp57[3] = temp36[0];  // for data(t, x+8, y, z);
+ // temp57[4] = temp36[1];  // for data(t, x+9, y, z);
+ // temp57[5] = temp36[2];  // for data(t, x+10, y, z);
+ // temp57[6] = temp36[3];  // for data(t, x+11, y, z);
+ // temp57[7] = temp36[4];  // for data(t, x+12, y, z);
+ // Get 5 element(s) from temp36 and 3 from temp28.
+ real_vec_align<5>(temp57, temp36, temp28);
+
+ // Read aligned vector starting at data(t, x, (y - 5), z).
+ real_vec_t temp58 = temp3[z];
+
+ // Read aligned vector starting at data(t, x, (y + 5), z).
+ real_vec_t temp59 = temp13[z];
+
+ // temp60 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))) + (-0.05 * (data(t, (x - 4), y, z) + data(t, (x + 4), y, z) + data(t, x, (y - 4), z) + data(t, x, (y + 4), z) + data(t, x, y, (z - 4)) + data(t, x, y, (z + 4)))) + (0.032 * (data(t, (x - 5), y, z) + data(t, (x + 5), y, z) + data(t, x, (y - 5), z) + data(t, x, (y + 5), z) + data(t, x, y, (z - 5)) + data(t, x, y, (z + 5)))).
+ real_vec_t temp60 = temp55 + (3.200000000000000e-02 * (temp56 + temp57 + temp58 + temp59 + temp23 + temp33));
+
+ // Construct unaligned vector starting at data(t, (x - 6), y, z).
+ real_vec_t temp61;
+ // temp61[0] = temp34[2];  // for data(t, x-6, y, z);
+ // temp61[1] = temp34[3];  // for data(t, x-5, y, z);
+ // temp61[2] = temp34[4];  // for data(t, x-4, y, z);
+ // temp61[3] = temp34[5];  // for data(t, x-3, y, z);
+ // temp61[4] = temp34[6];  // for data(t, x-2, y, z);
+ // temp61[5] = temp34[7];  // for data(t, x-1, y, z);
+ // temp61[6] = temp28[0];  // for data(t, x, y, z);
+ // temp61[7] = temp28[1];  // for data(t, x+1, y, z);
+ // Get 2 element(s) from temp28 and 6 from temp34.
+ real_vec_align<2>(temp61, temp28, temp34);
+
+ // Construct unaligned vector starting at data(t, (x + 6), y, z).
+ real_vec_t temp62;
+ // temp62[0] = temp28[6];  // for data(t, x+6, y, z);
+ // temp62[1] = temp28[7];  // for data(t, x+7, y, z);
+ // temp62[2] = temp36[0];  // for data(t, x+8, y, z);
+ // temp62[3] = temp36[1];  // for data(t, x+9, y, z);
+ // temp62[4] = temp36[2];  // for data(t, x+10, y, z);
+ // temp62[5] = temp36[3];  // for data(t, x+11, y, z);
+ // temp62[6] = temp36[4];  // for data(t, x+12, y, z);
+ // temp62[7] = temp36[5];  // for data(t, x+13, y, z);
+ // Get 6 element(s) from temp36 and 2 from temp28.
+ real_vec_align<6>(temp62, temp36, temp28);
+
+ // Read aligned vector starting at data(t, x, (y - 6), z).
+ real_vec_t temp63 = temp2[z];
+
+ // Read aligned vector starting at data(t, x, (y + 6), z).
+ real_vec_t temp64 = temp14[z];
+
+ // Read aligned vector starting at data(t, x, y, (z + 6)).
+ real_vec_t temp65 = temp8[(z+(6 / VLEN_Z))];
+
+ // temp66 = (0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))) + (-0.05 * (data(t, (x - 4), y, z) + data(t, (x + 4), y, z) + data(t, x, (y - 4), z) + data(t, x, (y + 4), z) + data(t, x, y, (z - 4)) + data(t, x, y, (z + 4)))) + (0.032 * (data(t, (x - 5), y, z) + data(t, (x + 5), y, z) + data(t, x, (y - 5), z) + data(t, x, (y + 5), z) + data(t, x, y, (z - 5)) + data(t, x, y, (z + 5)))) + (-0.0222222 * (data(t, (x - 6), y, z) + data(t, (x + 6), y, z) + data(t, x, (y - 6), z) + data(t, x, (y + 6), z) + data(t, x, y, (z - 6)) + data(t, x, y, (z + 6)))).
+ real_vec_t temp66 = temp60 + (-2.222222222222222e-02 * (temp61 + temp62 + temp63 + temp64 + temp22 + temp65));
+
+ // temp67 = ((0.9 * data(t, x, y, z)) + (0.8 * (data(t, (x - 1), y, z) + data(t, (x + 1), y, z) + data(t, x, (y - 1), z) + data(t, x, (y + 1), z) + data(t, x, y, (z - 1)) + data(t, x, y, (z + 1)))) + (-0.2 * (data(t, (x - 2), y, z) + data(t, (x + 2), y, z) + data(t, x, (y - 2), z) + data(t, x, (y + 2), z) + data(t, x, y, (z - 2)) + data(t, x, y, (z + 2)))) + (0.0888889 * (data(t, (x - 3), y, z) + data(t, (x + 3), y, z) + data(t, x, (y - 3), z) + data(t, x, (y + 3), z) + data(t, x, y, (z - 3)) + data(t, x, y, (z + 3)))) + (-0.05 * (data(t, (x - 4), y, z) + data(t, (x + 4), y, z) + data(t, x, (y - 4), z) + data(t, x, (y + 4), z) + data(t, x, y, (z - 4)) + data(t, x, y, (z + 4)))) + (0.032 * (data(t, (x - 5), y, z) + data(t, (x + 5), y, z) + data(t, x, (y - 5), z) + data(t, x, (y + 5), z) + data(t, x, y, (z - 5)) + data(t, x, y, (z + 5)))) + (-0.0222222 * (data(t, (x - 6), y, z) + data(t, (x + 6), y, z) + data(t, x, (y - 6), z) + data(t, x, (y + 6), z) + data(t, x, y, (z - 6)) + data(t, x, y, (z + 6))))).
+ real_vec_t temp67 = temp66;
+
+ // Update value at data((t + 1), x, y, z).
+ 
+ // Write aligned vector starting at data((t + 1), x, y, z).
+ if (use_nt_stores) temp67.storeTo_nt(temp16+z); else temp67.storeTo_masked(temp16+z, write_mask);
+;
+
+ // Carry vector-blocks to next iteration.
+ temp22 = temp23;
+ temp23 = temp24;
+ temp24 = temp25;
+ temp25 = temp26;
+ temp26 = temp27;
+ temp27 = temp28;
+ temp28 = temp29;
+ temp29 = temp30;
+ temp30 = temp31;
+ temp31 = temp32;
+ temp32 = temp33;
+ temp33 = temp65;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp1[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp2[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp3[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp4[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp5[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp6[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp7[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(6 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(6 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp8[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp9[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp10[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp11[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp12[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp13[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp14[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp15[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp16[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp1[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp2[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp3[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp4[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp5[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp6[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp7[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(6 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(6 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp8[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp9[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp10[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp11[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp12[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp13[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp14[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp15[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp16[z + ofs]);
+ }
+#endif // L2 prefetch.
+ } // 'z' loop.
+ } // Forced-inline block.
+} // calc_loop_of_clusters.
+}; // StencilBundle_stencil_bundle_0.
+
+ ////// Overall stencil-specific context //////
+struct StencilContext_3axis : public StencilContext_3axis_data {
+
+ // Stencil equation-bundles.
+ StencilBundle_stencil_bundle_0 stencil_bundle_0;
+
+ // Constructor.
+ StencilContext_3axis(KernelEnvPtr env, KernelSettingsPtr settings) : StencilContext_3axis_data(env, settings),
+  stencil_bundle_0(this) {
+
+ // Stencil bundles.
+  stBundles.push_back(&stencil_bundle_0);
+
+ // Stencil bundle inter-dependencies.
+
+ // Stencil bundle packs.
+  auto stencil_pack_0 = std::make_shared<BundlePack>("stencil_pack_0");
+  stencil_pack_0->push_back(&stencil_bundle_0);
+  stPacks.push_back(stencil_pack_0);
+ } // Ctor.
+
+  // Create Dims object.
+  static DimsPtr new_dims() {
+    auto p = std::make_shared<Dims>();
+    p->_vec_fold_layout.set_size(0, 8); // 'x'
+    p->_step_dim = "t";
+    p->_inner_dim = "z";
+    p->_domain_dims.addDimBack("x", 0);
+    p->_domain_dims.addDimBack("y", 0);
+    p->_domain_dims.addDimBack("z", 0);
+    p->_stencil_dims.addDimBack("t", 0);
+    p->_stencil_dims.addDimBack("x", 0);
+    p->_stencil_dims.addDimBack("y", 0);
+    p->_stencil_dims.addDimBack("z", 0);
+    p->_fold_pts.addDimBack("x", 8);
+    p->_fold_pts.addDimBack("y", 1);
+    p->_fold_pts.addDimBack("z", 1);
+    p->_vec_fold_pts.addDimBack("x", 8);
+    p->_fold_pts.setFirstInner(true);
+    p->_vec_fold_pts.setFirstInner(true);
+    p->_cluster_pts.addDimBack("x", 8);
+    p->_cluster_pts.addDimBack("y", 1);
+    p->_cluster_pts.addDimBack("z", 1);
+    p->_cluster_mults.addDimBack("x", 1);
+    p->_cluster_mults.addDimBack("y", 1);
+    p->_cluster_mults.addDimBack("z", 1);
+    p->_step_dir = 1;
+    return p;
+  }
+}; // StencilContext_3axis
+} // namespace yask.
+#endif // DEFINE_CONTEXT
+
+//End of automatically-generated code.
@@ -0,0 +1,917 @@
+/*
+ * 4-D grid-scanning code.
+ * Generated automatically from the following pseudo-code:
+ *
+ * N = 3;
+ * grouped omp loop(1 .. N-1) {  call(calc_sub_block(thread_idx)); }
+ *
+ */ #ifndef OMP_PRAGMA_PREFIX
+ #define OMP_PRAGMA_PREFIX omp parallel for schedule(static,1) proc_bind(close)
+ #endif
+ #ifndef OMP_PRAGMA_SUFFIX
+ #define OMP_PRAGMA_SUFFIX
+ #endif
+
+ // 'ScanIndices block_idxs' must be set before the following code.
+
+ // Select the loop order at run-time.
+ switch (opts->block_loop_order) {
+ default:
+ {
+
+  // Indices for function calls.
+  ScanIndices local_indices(block_idxs);
+
+  // ** Begin scan over dimensions 1, 2, 3. **
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_1 = std::min(block_idxs.align[1], block_idxs.step[1]);
+
+  // Aligned beginning point such that (block_idxs.begin[1] - block_idxs.step[1]) < aligned_begin_1 <= block_idxs.begin[1].
+  const idx_t aligned_begin_1 = yask::round_down_flr(block_idxs.begin[1] - block_idxs.align_ofs[1], adj_align_1) + block_idxs.align_ofs[1];
+
+  // Number of iterations to get from aligned_begin_1 to (but not including) block_idxs.end[1], stepping by block_idxs.step[1]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[1] steps.
+  const idx_t num_iters_1 = yask::ceil_idiv_flr(block_idxs.end[1] - aligned_begin_1, block_idxs.step[1]);
+
+  // Number of iterations in one full group in dimension 1. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[1]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_1 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[1], block_idxs.step[1]), num_iters_1);
+
+  // Number of full groups in dimension 1.
+  const idx_t num_full_groups_1 = num_iters_1 / num_iters_in_full_group_1;
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_2 = std::min(block_idxs.align[2], block_idxs.step[2]);
+
+  // Aligned beginning point such that (block_idxs.begin[2] - block_idxs.step[2]) < aligned_begin_2 <= block_idxs.begin[2].
+  const idx_t aligned_begin_2 = yask::round_down_flr(block_idxs.begin[2] - block_idxs.align_ofs[2], adj_align_2) + block_idxs.align_ofs[2];
+
+  // Number of iterations to get from aligned_begin_2 to (but not including) block_idxs.end[2], stepping by block_idxs.step[2]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[2] steps.
+  const idx_t num_iters_2 = yask::ceil_idiv_flr(block_idxs.end[2] - aligned_begin_2, block_idxs.step[2]);
+
+  // Number of iterations in one full group in dimension 2. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[2]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_2 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[2], block_idxs.step[2]), num_iters_2);
+
+  // Number of full groups in dimension 2.
+  const idx_t num_full_groups_2 = num_iters_2 / num_iters_in_full_group_2;
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_3 = std::min(block_idxs.align[3], block_idxs.step[3]);
+
+  // Aligned beginning point such that (block_idxs.begin[3] - block_idxs.step[3]) < aligned_begin_3 <= block_idxs.begin[3].
+  const idx_t aligned_begin_3 = yask::round_down_flr(block_idxs.begin[3] - block_idxs.align_ofs[3], adj_align_3) + block_idxs.align_ofs[3];
+
+  // Number of iterations to get from aligned_begin_3 to (but not including) block_idxs.end[3], stepping by block_idxs.step[3]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[3] steps.
+  const idx_t num_iters_3 = yask::ceil_idiv_flr(block_idxs.end[3] - aligned_begin_3, block_idxs.step[3]);
+
+  // Number of iterations in one full group in dimension 3. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[3]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_3 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[3], block_idxs.step[3]), num_iters_3);
+
+  // Number of full groups in dimension 3.
+  const idx_t num_full_groups_3 = num_iters_3 / num_iters_in_full_group_3;
+
+  // Number of iterations in dimensions 1, 2, 3
+  const idx_t num_iters_1_2_3 = num_iters_1 * num_iters_2 * num_iters_3;
+
+  // Number of iterations in dimensions 2, 3
+  const idx_t num_iters_2_3 = num_iters_2 * num_iters_3;
+
+  // Inner loop.
+ 
+
+  // Distribute iterations among OpenMP threads.
+ #pragma OMP_PRAGMA_PREFIX firstprivate(local_indices) OMP_PRAGMA_SUFFIX
+  for (idx_t loop_index_1_2_3 = 0; loop_index_1_2_3 < num_iters_1_2_3; loop_index_1_2_3++) {
+
+  // Working vars for iterations in groups. These are initialized to full-group counts and then reduced if we are in a partial group.
+  idx_t num_iters_in_group_1 = num_iters_in_full_group_1;
+  idx_t num_iters_in_group_2 = num_iters_in_full_group_2;
+  idx_t num_iters_in_group_3 = num_iters_in_full_group_3;
+
+  // Number of iterations in the set of groups across dimensions 2, 3.
+  idx_t num_iters_in_group_set_2_3 = num_iters_in_group_1 * num_iters_2 * num_iters_3;
+
+  // Index of this group in dimension 1.
+  idx_t index_of_group_1 = loop_index_1_2_3 / num_iters_in_group_set_2_3;
+
+  // Linear offset within the set of groups across dimensions 2, 3.
+  idx_t index_offset_within_group_set_2_3 = loop_index_1_2_3 % num_iters_in_group_set_2_3;
+
+  // Adjust number of iterations in this group in dimension 1.
+  if (index_of_group_1 >= num_full_groups_1)  num_iters_in_group_1 = num_iters_1 - (num_full_groups_1 * num_iters_in_full_group_1);
+
+  // Number of iterations in the set of groups across dimension 3.
+  idx_t num_iters_in_group_set_3 = num_iters_in_group_1 * num_iters_in_group_2 * num_iters_3;
+
+  // Index of this group in dimension 2.
+  idx_t index_of_group_2 = index_offset_within_group_set_2_3 / num_iters_in_group_set_3;
+
+  // Linear offset within the set of groups across dimension 3.
+  idx_t index_offset_within_group_set_3 = index_offset_within_group_set_2_3 % num_iters_in_group_set_3;
+
+  // Adjust number of iterations in this group in dimension 2.
+  if (index_of_group_2 >= num_full_groups_2)  num_iters_in_group_2 = num_iters_2 - (num_full_groups_2 * num_iters_in_full_group_2);
+
+  // Number of iterations in this group.
+  idx_t num_iters_in_full_group = num_iters_in_group_1 * num_iters_in_group_2 * num_iters_in_group_3;
+
+  // Index of this group in dimension 3.
+  idx_t index_of_group_3 = index_offset_within_group_set_3 / num_iters_in_full_group;
+
+  // Linear offset within this group.
+  idx_t index_offset_within_this_group = index_offset_within_group_set_3 % num_iters_in_full_group;
+
+  // Adjust number of iterations in this group in dimension 3.
+  if (index_of_group_3 >= num_full_groups_3)  num_iters_in_group_3 = num_iters_3 - (num_full_groups_3 * num_iters_in_full_group_3);
+
+  // Offset within this group in dimension 1.
+  idx_t index_offset_within_this_group_1 = index_offset_within_this_group / (num_iters_in_group_2 * num_iters_in_group_3);
+
+  // Zero-based, unit-stride index for dimension 1.
+  idx_t index_1 = num_iters_in_full_group_1 * index_of_group_1 + index_offset_within_this_group_1;
+
+  // Offset within this group in dimension 2.
+  idx_t index_offset_within_this_group_2 = (index_offset_within_this_group / (num_iters_in_group_3)) % num_iters_in_group_2;
+
+  // Zero-based, unit-stride index for dimension 2.
+  idx_t index_2 = num_iters_in_full_group_2 * index_of_group_2 + index_offset_within_this_group_2;
+
+  // Offset within this group in dimension 3.
+  idx_t index_offset_within_this_group_3 = (index_offset_within_this_group) % num_iters_in_group_3;
+
+  // Zero-based, unit-stride index for dimension 3.
+  idx_t index_3 = num_iters_in_full_group_3 * index_of_group_3 + index_offset_within_this_group_3;
+
+  // This value of index_1 covers dimension 1 from start_1 to (but not including) stop_1.
+  idx_t start_1 = std::max(aligned_begin_1 + (index_1 * block_idxs.step[1]), block_idxs.begin[1]);
+  idx_t stop_1 = std::min(aligned_begin_1 + ((index_1+1) * block_idxs.step[1]), block_idxs.end[1]);
+
+  // This value of index_2 covers dimension 2 from start_2 to (but not including) stop_2.
+  idx_t start_2 = std::max(aligned_begin_2 + (index_2 * block_idxs.step[2]), block_idxs.begin[2]);
+  idx_t stop_2 = std::min(aligned_begin_2 + ((index_2+1) * block_idxs.step[2]), block_idxs.end[2]);
+
+  // This value of index_3 covers dimension 3 from start_3 to (but not including) stop_3.
+  idx_t start_3 = std::max(aligned_begin_3 + (index_3 * block_idxs.step[3]), block_idxs.begin[3]);
+  idx_t stop_3 = std::min(aligned_begin_3 + ((index_3+1) * block_idxs.step[3]), block_idxs.end[3]);
+  local_indices.start[1] = start_1;
+  local_indices.stop[1] = stop_1;
+  local_indices.index[1] = index_1;
+  local_indices.start[2] = start_2;
+  local_indices.stop[2] = stop_2;
+  local_indices.index[2] = index_2;
+  local_indices.start[3] = start_3;
+  local_indices.stop[3] = stop_3;
+  local_indices.index[3] = index_3;
+   sg->calc_sub_block(thread_idx, local_indices);
+  }
+ }
+ break;
+ case 1:
+ {
+
+  // Indices for function calls.
+  ScanIndices local_indices(block_idxs);
+
+  // ** Begin scan over dimensions 1, 3, 2. **
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_1 = std::min(block_idxs.align[1], block_idxs.step[1]);
+
+  // Aligned beginning point such that (block_idxs.begin[1] - block_idxs.step[1]) < aligned_begin_1 <= block_idxs.begin[1].
+  const idx_t aligned_begin_1 = yask::round_down_flr(block_idxs.begin[1] - block_idxs.align_ofs[1], adj_align_1) + block_idxs.align_ofs[1];
+
+  // Number of iterations to get from aligned_begin_1 to (but not including) block_idxs.end[1], stepping by block_idxs.step[1]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[1] steps.
+  const idx_t num_iters_1 = yask::ceil_idiv_flr(block_idxs.end[1] - aligned_begin_1, block_idxs.step[1]);
+
+  // Number of iterations in one full group in dimension 1. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[1]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_1 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[1], block_idxs.step[1]), num_iters_1);
+
+  // Number of full groups in dimension 1.
+  const idx_t num_full_groups_1 = num_iters_1 / num_iters_in_full_group_1;
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_3 = std::min(block_idxs.align[3], block_idxs.step[3]);
+
+  // Aligned beginning point such that (block_idxs.begin[3] - block_idxs.step[3]) < aligned_begin_3 <= block_idxs.begin[3].
+  const idx_t aligned_begin_3 = yask::round_down_flr(block_idxs.begin[3] - block_idxs.align_ofs[3], adj_align_3) + block_idxs.align_ofs[3];
+
+  // Number of iterations to get from aligned_begin_3 to (but not including) block_idxs.end[3], stepping by block_idxs.step[3]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[3] steps.
+  const idx_t num_iters_3 = yask::ceil_idiv_flr(block_idxs.end[3] - aligned_begin_3, block_idxs.step[3]);
+
+  // Number of iterations in one full group in dimension 3. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[3]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_3 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[3], block_idxs.step[3]), num_iters_3);
+
+  // Number of full groups in dimension 3.
+  const idx_t num_full_groups_3 = num_iters_3 / num_iters_in_full_group_3;
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_2 = std::min(block_idxs.align[2], block_idxs.step[2]);
+
+  // Aligned beginning point such that (block_idxs.begin[2] - block_idxs.step[2]) < aligned_begin_2 <= block_idxs.begin[2].
+  const idx_t aligned_begin_2 = yask::round_down_flr(block_idxs.begin[2] - block_idxs.align_ofs[2], adj_align_2) + block_idxs.align_ofs[2];
+
+  // Number of iterations to get from aligned_begin_2 to (but not including) block_idxs.end[2], stepping by block_idxs.step[2]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[2] steps.
+  const idx_t num_iters_2 = yask::ceil_idiv_flr(block_idxs.end[2] - aligned_begin_2, block_idxs.step[2]);
+
+  // Number of iterations in one full group in dimension 2. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[2]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_2 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[2], block_idxs.step[2]), num_iters_2);
+
+  // Number of full groups in dimension 2.
+  const idx_t num_full_groups_2 = num_iters_2 / num_iters_in_full_group_2;
+
+  // Number of iterations in dimensions 1, 3, 2
+  const idx_t num_iters_1_3_2 = num_iters_1 * num_iters_3 * num_iters_2;
+
+  // Number of iterations in dimensions 3, 2
+  const idx_t num_iters_3_2 = num_iters_3 * num_iters_2;
+
+  // Inner loop.
+ 
+
+  // Distribute iterations among OpenMP threads.
+ #pragma OMP_PRAGMA_PREFIX firstprivate(local_indices) OMP_PRAGMA_SUFFIX
+  for (idx_t loop_index_1_3_2 = 0; loop_index_1_3_2 < num_iters_1_3_2; loop_index_1_3_2++) {
+
+  // Working vars for iterations in groups. These are initialized to full-group counts and then reduced if we are in a partial group.
+  idx_t num_iters_in_group_1 = num_iters_in_full_group_1;
+  idx_t num_iters_in_group_3 = num_iters_in_full_group_3;
+  idx_t num_iters_in_group_2 = num_iters_in_full_group_2;
+
+  // Number of iterations in the set of groups across dimensions 3, 2.
+  idx_t num_iters_in_group_set_3_2 = num_iters_in_group_1 * num_iters_3 * num_iters_2;
+
+  // Index of this group in dimension 1.
+  idx_t index_of_group_1 = loop_index_1_3_2 / num_iters_in_group_set_3_2;
+
+  // Linear offset within the set of groups across dimensions 3, 2.
+  idx_t index_offset_within_group_set_3_2 = loop_index_1_3_2 % num_iters_in_group_set_3_2;
+
+  // Adjust number of iterations in this group in dimension 1.
+  if (index_of_group_1 >= num_full_groups_1)  num_iters_in_group_1 = num_iters_1 - (num_full_groups_1 * num_iters_in_full_group_1);
+
+  // Number of iterations in the set of groups across dimension 2.
+  idx_t num_iters_in_group_set_2 = num_iters_in_group_1 * num_iters_in_group_3 * num_iters_2;
+
+  // Index of this group in dimension 3.
+  idx_t index_of_group_3 = index_offset_within_group_set_3_2 / num_iters_in_group_set_2;
+
+  // Linear offset within the set of groups across dimension 2.
+  idx_t index_offset_within_group_set_2 = index_offset_within_group_set_3_2 % num_iters_in_group_set_2;
+
+  // Adjust number of iterations in this group in dimension 3.
+  if (index_of_group_3 >= num_full_groups_3)  num_iters_in_group_3 = num_iters_3 - (num_full_groups_3 * num_iters_in_full_group_3);
+
+  // Number of iterations in this group.
+  idx_t num_iters_in_full_group = num_iters_in_group_1 * num_iters_in_group_3 * num_iters_in_group_2;
+
+  // Index of this group in dimension 2.
+  idx_t index_of_group_2 = index_offset_within_group_set_2 / num_iters_in_full_group;
+
+  // Linear offset within this group.
+  idx_t index_offset_within_this_group = index_offset_within_group_set_2 % num_iters_in_full_group;
+
+  // Adjust number of iterations in this group in dimension 2.
+  if (index_of_group_2 >= num_full_groups_2)  num_iters_in_group_2 = num_iters_2 - (num_full_groups_2 * num_iters_in_full_group_2);
+
+  // Offset within this group in dimension 1.
+  idx_t index_offset_within_this_group_1 = index_offset_within_this_group / (num_iters_in_group_3 * num_iters_in_group_2);
+
+  // Zero-based, unit-stride index for dimension 1.
+  idx_t index_1 = num_iters_in_full_group_1 * index_of_group_1 + index_offset_within_this_group_1;
+
+  // Offset within this group in dimension 3.
+  idx_t index_offset_within_this_group_3 = (index_offset_within_this_group / (num_iters_in_group_2)) % num_iters_in_group_3;
+
+  // Zero-based, unit-stride index for dimension 3.
+  idx_t index_3 = num_iters_in_full_group_3 * index_of_group_3 + index_offset_within_this_group_3;
+
+  // Offset within this group in dimension 2.
+  idx_t index_offset_within_this_group_2 = (index_offset_within_this_group) % num_iters_in_group_2;
+
+  // Zero-based, unit-stride index for dimension 2.
+  idx_t index_2 = num_iters_in_full_group_2 * index_of_group_2 + index_offset_within_this_group_2;
+
+  // This value of index_1 covers dimension 1 from start_1 to (but not including) stop_1.
+  idx_t start_1 = std::max(aligned_begin_1 + (index_1 * block_idxs.step[1]), block_idxs.begin[1]);
+  idx_t stop_1 = std::min(aligned_begin_1 + ((index_1+1) * block_idxs.step[1]), block_idxs.end[1]);
+
+  // This value of index_3 covers dimension 3 from start_3 to (but not including) stop_3.
+  idx_t start_3 = std::max(aligned_begin_3 + (index_3 * block_idxs.step[3]), block_idxs.begin[3]);
+  idx_t stop_3 = std::min(aligned_begin_3 + ((index_3+1) * block_idxs.step[3]), block_idxs.end[3]);
+
+  // This value of index_2 covers dimension 2 from start_2 to (but not including) stop_2.
+  idx_t start_2 = std::max(aligned_begin_2 + (index_2 * block_idxs.step[2]), block_idxs.begin[2]);
+  idx_t stop_2 = std::min(aligned_begin_2 + ((index_2+1) * block_idxs.step[2]), block_idxs.end[2]);
+  local_indices.start[1] = start_1;
+  local_indices.stop[1] = stop_1;
+  local_indices.index[1] = index_1;
+  local_indices.start[3] = start_3;
+  local_indices.stop[3] = stop_3;
+  local_indices.index[3] = index_3;
+  local_indices.start[2] = start_2;
+  local_indices.stop[2] = stop_2;
+  local_indices.index[2] = index_2;
+   sg->calc_sub_block(thread_idx, local_indices);
+  }
+ }
+ break;
+ case 2:
+ {
+
+  // Indices for function calls.
+  ScanIndices local_indices(block_idxs);
+
+  // ** Begin scan over dimensions 2, 1, 3. **
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_2 = std::min(block_idxs.align[2], block_idxs.step[2]);
+
+  // Aligned beginning point such that (block_idxs.begin[2] - block_idxs.step[2]) < aligned_begin_2 <= block_idxs.begin[2].
+  const idx_t aligned_begin_2 = yask::round_down_flr(block_idxs.begin[2] - block_idxs.align_ofs[2], adj_align_2) + block_idxs.align_ofs[2];
+
+  // Number of iterations to get from aligned_begin_2 to (but not including) block_idxs.end[2], stepping by block_idxs.step[2]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[2] steps.
+  const idx_t num_iters_2 = yask::ceil_idiv_flr(block_idxs.end[2] - aligned_begin_2, block_idxs.step[2]);
+
+  // Number of iterations in one full group in dimension 2. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[2]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_2 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[2], block_idxs.step[2]), num_iters_2);
+
+  // Number of full groups in dimension 2.
+  const idx_t num_full_groups_2 = num_iters_2 / num_iters_in_full_group_2;
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_1 = std::min(block_idxs.align[1], block_idxs.step[1]);
+
+  // Aligned beginning point such that (block_idxs.begin[1] - block_idxs.step[1]) < aligned_begin_1 <= block_idxs.begin[1].
+  const idx_t aligned_begin_1 = yask::round_down_flr(block_idxs.begin[1] - block_idxs.align_ofs[1], adj_align_1) + block_idxs.align_ofs[1];
+
+  // Number of iterations to get from aligned_begin_1 to (but not including) block_idxs.end[1], stepping by block_idxs.step[1]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[1] steps.
+  const idx_t num_iters_1 = yask::ceil_idiv_flr(block_idxs.end[1] - aligned_begin_1, block_idxs.step[1]);
+
+  // Number of iterations in one full group in dimension 1. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[1]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_1 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[1], block_idxs.step[1]), num_iters_1);
+
+  // Number of full groups in dimension 1.
+  const idx_t num_full_groups_1 = num_iters_1 / num_iters_in_full_group_1;
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_3 = std::min(block_idxs.align[3], block_idxs.step[3]);
+
+  // Aligned beginning point such that (block_idxs.begin[3] - block_idxs.step[3]) < aligned_begin_3 <= block_idxs.begin[3].
+  const idx_t aligned_begin_3 = yask::round_down_flr(block_idxs.begin[3] - block_idxs.align_ofs[3], adj_align_3) + block_idxs.align_ofs[3];
+
+  // Number of iterations to get from aligned_begin_3 to (but not including) block_idxs.end[3], stepping by block_idxs.step[3]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[3] steps.
+  const idx_t num_iters_3 = yask::ceil_idiv_flr(block_idxs.end[3] - aligned_begin_3, block_idxs.step[3]);
+
+  // Number of iterations in one full group in dimension 3. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[3]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_3 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[3], block_idxs.step[3]), num_iters_3);
+
+  // Number of full groups in dimension 3.
+  const idx_t num_full_groups_3 = num_iters_3 / num_iters_in_full_group_3;
+
+  // Number of iterations in dimensions 2, 1, 3
+  const idx_t num_iters_2_1_3 = num_iters_2 * num_iters_1 * num_iters_3;
+
+  // Number of iterations in dimensions 1, 3
+  const idx_t num_iters_1_3 = num_iters_1 * num_iters_3;
+
+  // Inner loop.
+ 
+
+  // Distribute iterations among OpenMP threads.
+ #pragma OMP_PRAGMA_PREFIX firstprivate(local_indices) OMP_PRAGMA_SUFFIX
+  for (idx_t loop_index_2_1_3 = 0; loop_index_2_1_3 < num_iters_2_1_3; loop_index_2_1_3++) {
+
+  // Working vars for iterations in groups. These are initialized to full-group counts and then reduced if we are in a partial group.
+  idx_t num_iters_in_group_2 = num_iters_in_full_group_2;
+  idx_t num_iters_in_group_1 = num_iters_in_full_group_1;
+  idx_t num_iters_in_group_3 = num_iters_in_full_group_3;
+
+  // Number of iterations in the set of groups across dimensions 1, 3.
+  idx_t num_iters_in_group_set_1_3 = num_iters_in_group_2 * num_iters_1 * num_iters_3;
+
+  // Index of this group in dimension 2.
+  idx_t index_of_group_2 = loop_index_2_1_3 / num_iters_in_group_set_1_3;
+
+  // Linear offset within the set of groups across dimensions 1, 3.
+  idx_t index_offset_within_group_set_1_3 = loop_index_2_1_3 % num_iters_in_group_set_1_3;
+
+  // Adjust number of iterations in this group in dimension 2.
+  if (index_of_group_2 >= num_full_groups_2)  num_iters_in_group_2 = num_iters_2 - (num_full_groups_2 * num_iters_in_full_group_2);
+
+  // Number of iterations in the set of groups across dimension 3.
+  idx_t num_iters_in_group_set_3 = num_iters_in_group_2 * num_iters_in_group_1 * num_iters_3;
+
+  // Index of this group in dimension 1.
+  idx_t index_of_group_1 = index_offset_within_group_set_1_3 / num_iters_in_group_set_3;
+
+  // Linear offset within the set of groups across dimension 3.
+  idx_t index_offset_within_group_set_3 = index_offset_within_group_set_1_3 % num_iters_in_group_set_3;
+
+  // Adjust number of iterations in this group in dimension 1.
+  if (index_of_group_1 >= num_full_groups_1)  num_iters_in_group_1 = num_iters_1 - (num_full_groups_1 * num_iters_in_full_group_1);
+
+  // Number of iterations in this group.
+  idx_t num_iters_in_full_group = num_iters_in_group_2 * num_iters_in_group_1 * num_iters_in_group_3;
+
+  // Index of this group in dimension 3.
+  idx_t index_of_group_3 = index_offset_within_group_set_3 / num_iters_in_full_group;
+
+  // Linear offset within this group.
+  idx_t index_offset_within_this_group = index_offset_within_group_set_3 % num_iters_in_full_group;
+
+  // Adjust number of iterations in this group in dimension 3.
+  if (index_of_group_3 >= num_full_groups_3)  num_iters_in_group_3 = num_iters_3 - (num_full_groups_3 * num_iters_in_full_group_3);
+
+  // Offset within this group in dimension 2.
+  idx_t index_offset_within_this_group_2 = index_offset_within_this_group / (num_iters_in_group_1 * num_iters_in_group_3);
+
+  // Zero-based, unit-stride index for dimension 2.
+  idx_t index_2 = num_iters_in_full_group_2 * index_of_group_2 + index_offset_within_this_group_2;
+
+  // Offset within this group in dimension 1.
+  idx_t index_offset_within_this_group_1 = (index_offset_within_this_group / (num_iters_in_group_3)) % num_iters_in_group_1;
+
+  // Zero-based, unit-stride index for dimension 1.
+  idx_t index_1 = num_iters_in_full_group_1 * index_of_group_1 + index_offset_within_this_group_1;
+
+  // Offset within this group in dimension 3.
+  idx_t index_offset_within_this_group_3 = (index_offset_within_this_group) % num_iters_in_group_3;
+
+  // Zero-based, unit-stride index for dimension 3.
+  idx_t index_3 = num_iters_in_full_group_3 * index_of_group_3 + index_offset_within_this_group_3;
+
+  // This value of index_2 covers dimension 2 from start_2 to (but not including) stop_2.
+  idx_t start_2 = std::max(aligned_begin_2 + (index_2 * block_idxs.step[2]), block_idxs.begin[2]);
+  idx_t stop_2 = std::min(aligned_begin_2 + ((index_2+1) * block_idxs.step[2]), block_idxs.end[2]);
+
+  // This value of index_1 covers dimension 1 from start_1 to (but not including) stop_1.
+  idx_t start_1 = std::max(aligned_begin_1 + (index_1 * block_idxs.step[1]), block_idxs.begin[1]);
+  idx_t stop_1 = std::min(aligned_begin_1 + ((index_1+1) * block_idxs.step[1]), block_idxs.end[1]);
+
+  // This value of index_3 covers dimension 3 from start_3 to (but not including) stop_3.
+  idx_t start_3 = std::max(aligned_begin_3 + (index_3 * block_idxs.step[3]), block_idxs.begin[3]);
+  idx_t stop_3 = std::min(aligned_begin_3 + ((index_3+1) * block_idxs.step[3]), block_idxs.end[3]);
+  local_indices.start[2] = start_2;
+  local_indices.stop[2] = stop_2;
+  local_indices.index[2] = index_2;
+  local_indices.start[1] = start_1;
+  local_indices.stop[1] = stop_1;
+  local_indices.index[1] = index_1;
+  local_indices.start[3] = start_3;
+  local_indices.stop[3] = stop_3;
+  local_indices.index[3] = index_3;
+   sg->calc_sub_block(thread_idx, local_indices);
+  }
+ }
+ break;
+ case 3:
+ {
+
+  // Indices for function calls.
+  ScanIndices local_indices(block_idxs);
+
+  // ** Begin scan over dimensions 2, 3, 1. **
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_2 = std::min(block_idxs.align[2], block_idxs.step[2]);
+
+  // Aligned beginning point such that (block_idxs.begin[2] - block_idxs.step[2]) < aligned_begin_2 <= block_idxs.begin[2].
+  const idx_t aligned_begin_2 = yask::round_down_flr(block_idxs.begin[2] - block_idxs.align_ofs[2], adj_align_2) + block_idxs.align_ofs[2];
+
+  // Number of iterations to get from aligned_begin_2 to (but not including) block_idxs.end[2], stepping by block_idxs.step[2]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[2] steps.
+  const idx_t num_iters_2 = yask::ceil_idiv_flr(block_idxs.end[2] - aligned_begin_2, block_idxs.step[2]);
+
+  // Number of iterations in one full group in dimension 2. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[2]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_2 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[2], block_idxs.step[2]), num_iters_2);
+
+  // Number of full groups in dimension 2.
+  const idx_t num_full_groups_2 = num_iters_2 / num_iters_in_full_group_2;
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_3 = std::min(block_idxs.align[3], block_idxs.step[3]);
+
+  // Aligned beginning point such that (block_idxs.begin[3] - block_idxs.step[3]) < aligned_begin_3 <= block_idxs.begin[3].
+  const idx_t aligned_begin_3 = yask::round_down_flr(block_idxs.begin[3] - block_idxs.align_ofs[3], adj_align_3) + block_idxs.align_ofs[3];
+
+  // Number of iterations to get from aligned_begin_3 to (but not including) block_idxs.end[3], stepping by block_idxs.step[3]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[3] steps.
+  const idx_t num_iters_3 = yask::ceil_idiv_flr(block_idxs.end[3] - aligned_begin_3, block_idxs.step[3]);
+
+  // Number of iterations in one full group in dimension 3. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[3]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_3 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[3], block_idxs.step[3]), num_iters_3);
+
+  // Number of full groups in dimension 3.
+  const idx_t num_full_groups_3 = num_iters_3 / num_iters_in_full_group_3;
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_1 = std::min(block_idxs.align[1], block_idxs.step[1]);
+
+  // Aligned beginning point such that (block_idxs.begin[1] - block_idxs.step[1]) < aligned_begin_1 <= block_idxs.begin[1].
+  const idx_t aligned_begin_1 = yask::round_down_flr(block_idxs.begin[1] - block_idxs.align_ofs[1], adj_align_1) + block_idxs.align_ofs[1];
+
+  // Number of iterations to get from aligned_begin_1 to (but not including) block_idxs.end[1], stepping by block_idxs.step[1]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[1] steps.
+  const idx_t num_iters_1 = yask::ceil_idiv_flr(block_idxs.end[1] - aligned_begin_1, block_idxs.step[1]);
+
+  // Number of iterations in one full group in dimension 1. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[1]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_1 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[1], block_idxs.step[1]), num_iters_1);
+
+  // Number of full groups in dimension 1.
+  const idx_t num_full_groups_1 = num_iters_1 / num_iters_in_full_group_1;
+
+  // Number of iterations in dimensions 2, 3, 1
+  const idx_t num_iters_2_3_1 = num_iters_2 * num_iters_3 * num_iters_1;
+
+  // Number of iterations in dimensions 3, 1
+  const idx_t num_iters_3_1 = num_iters_3 * num_iters_1;
+
+  // Inner loop.
+ 
+
+  // Distribute iterations among OpenMP threads.
+ #pragma OMP_PRAGMA_PREFIX firstprivate(local_indices) OMP_PRAGMA_SUFFIX
+  for (idx_t loop_index_2_3_1 = 0; loop_index_2_3_1 < num_iters_2_3_1; loop_index_2_3_1++) {
+
+  // Working vars for iterations in groups. These are initialized to full-group counts and then reduced if we are in a partial group.
+  idx_t num_iters_in_group_2 = num_iters_in_full_group_2;
+  idx_t num_iters_in_group_3 = num_iters_in_full_group_3;
+  idx_t num_iters_in_group_1 = num_iters_in_full_group_1;
+
+  // Number of iterations in the set of groups across dimensions 3, 1.
+  idx_t num_iters_in_group_set_3_1 = num_iters_in_group_2 * num_iters_3 * num_iters_1;
+
+  // Index of this group in dimension 2.
+  idx_t index_of_group_2 = loop_index_2_3_1 / num_iters_in_group_set_3_1;
+
+  // Linear offset within the set of groups across dimensions 3, 1.
+  idx_t index_offset_within_group_set_3_1 = loop_index_2_3_1 % num_iters_in_group_set_3_1;
+
+  // Adjust number of iterations in this group in dimension 2.
+  if (index_of_group_2 >= num_full_groups_2)  num_iters_in_group_2 = num_iters_2 - (num_full_groups_2 * num_iters_in_full_group_2);
+
+  // Number of iterations in the set of groups across dimension 1.
+  idx_t num_iters_in_group_set_1 = num_iters_in_group_2 * num_iters_in_group_3 * num_iters_1;
+
+  // Index of this group in dimension 3.
+  idx_t index_of_group_3 = index_offset_within_group_set_3_1 / num_iters_in_group_set_1;
+
+  // Linear offset within the set of groups across dimension 1.
+  idx_t index_offset_within_group_set_1 = index_offset_within_group_set_3_1 % num_iters_in_group_set_1;
+
+  // Adjust number of iterations in this group in dimension 3.
+  if (index_of_group_3 >= num_full_groups_3)  num_iters_in_group_3 = num_iters_3 - (num_full_groups_3 * num_iters_in_full_group_3);
+
+  // Number of iterations in this group.
+  idx_t num_iters_in_full_group = num_iters_in_group_2 * num_iters_in_group_3 * num_iters_in_group_1;
+
+  // Index of this group in dimension 1.
+  idx_t index_of_group_1 = index_offset_within_group_set_1 / num_iters_in_full_group;
+
+  // Linear offset within this group.
+  idx_t index_offset_within_this_group = index_offset_within_group_set_1 % num_iters_in_full_group;
+
+  // Adjust number of iterations in this group in dimension 1.
+  if (index_of_group_1 >= num_full_groups_1)  num_iters_in_group_1 = num_iters_1 - (num_full_groups_1 * num_iters_in_full_group_1);
+
+  // Offset within this group in dimension 2.
+  idx_t index_offset_within_this_group_2 = index_offset_within_this_group / (num_iters_in_group_3 * num_iters_in_group_1);
+
+  // Zero-based, unit-stride index for dimension 2.
+  idx_t index_2 = num_iters_in_full_group_2 * index_of_group_2 + index_offset_within_this_group_2;
+
+  // Offset within this group in dimension 3.
+  idx_t index_offset_within_this_group_3 = (index_offset_within_this_group / (num_iters_in_group_1)) % num_iters_in_group_3;
+
+  // Zero-based, unit-stride index for dimension 3.
+  idx_t index_3 = num_iters_in_full_group_3 * index_of_group_3 + index_offset_within_this_group_3;
+
+  // Offset within this group in dimension 1.
+  idx_t index_offset_within_this_group_1 = (index_offset_within_this_group) % num_iters_in_group_1;
+
+  // Zero-based, unit-stride index for dimension 1.
+  idx_t index_1 = num_iters_in_full_group_1 * index_of_group_1 + index_offset_within_this_group_1;
+
+  // This value of index_2 covers dimension 2 from start_2 to (but not including) stop_2.
+  idx_t start_2 = std::max(aligned_begin_2 + (index_2 * block_idxs.step[2]), block_idxs.begin[2]);
+  idx_t stop_2 = std::min(aligned_begin_2 + ((index_2+1) * block_idxs.step[2]), block_idxs.end[2]);
+
+  // This value of index_3 covers dimension 3 from start_3 to (but not including) stop_3.
+  idx_t start_3 = std::max(aligned_begin_3 + (index_3 * block_idxs.step[3]), block_idxs.begin[3]);
+  idx_t stop_3 = std::min(aligned_begin_3 + ((index_3+1) * block_idxs.step[3]), block_idxs.end[3]);
+
+  // This value of index_1 covers dimension 1 from start_1 to (but not including) stop_1.
+  idx_t start_1 = std::max(aligned_begin_1 + (index_1 * block_idxs.step[1]), block_idxs.begin[1]);
+  idx_t stop_1 = std::min(aligned_begin_1 + ((index_1+1) * block_idxs.step[1]), block_idxs.end[1]);
+  local_indices.start[2] = start_2;
+  local_indices.stop[2] = stop_2;
+  local_indices.index[2] = index_2;
+  local_indices.start[3] = start_3;
+  local_indices.stop[3] = stop_3;
+  local_indices.index[3] = index_3;
+  local_indices.start[1] = start_1;
+  local_indices.stop[1] = stop_1;
+  local_indices.index[1] = index_1;
+   sg->calc_sub_block(thread_idx, local_indices);
+  }
+ }
+ break;
+ case 4:
+ {
+
+  // Indices for function calls.
+  ScanIndices local_indices(block_idxs);
+
+  // ** Begin scan over dimensions 3, 1, 2. **
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_3 = std::min(block_idxs.align[3], block_idxs.step[3]);
+
+  // Aligned beginning point such that (block_idxs.begin[3] - block_idxs.step[3]) < aligned_begin_3 <= block_idxs.begin[3].
+  const idx_t aligned_begin_3 = yask::round_down_flr(block_idxs.begin[3] - block_idxs.align_ofs[3], adj_align_3) + block_idxs.align_ofs[3];
+
+  // Number of iterations to get from aligned_begin_3 to (but not including) block_idxs.end[3], stepping by block_idxs.step[3]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[3] steps.
+  const idx_t num_iters_3 = yask::ceil_idiv_flr(block_idxs.end[3] - aligned_begin_3, block_idxs.step[3]);
+
+  // Number of iterations in one full group in dimension 3. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[3]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_3 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[3], block_idxs.step[3]), num_iters_3);
+
+  // Number of full groups in dimension 3.
+  const idx_t num_full_groups_3 = num_iters_3 / num_iters_in_full_group_3;
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_1 = std::min(block_idxs.align[1], block_idxs.step[1]);
+
+  // Aligned beginning point such that (block_idxs.begin[1] - block_idxs.step[1]) < aligned_begin_1 <= block_idxs.begin[1].
+  const idx_t aligned_begin_1 = yask::round_down_flr(block_idxs.begin[1] - block_idxs.align_ofs[1], adj_align_1) + block_idxs.align_ofs[1];
+
+  // Number of iterations to get from aligned_begin_1 to (but not including) block_idxs.end[1], stepping by block_idxs.step[1]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[1] steps.
+  const idx_t num_iters_1 = yask::ceil_idiv_flr(block_idxs.end[1] - aligned_begin_1, block_idxs.step[1]);
+
+  // Number of iterations in one full group in dimension 1. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[1]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_1 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[1], block_idxs.step[1]), num_iters_1);
+
+  // Number of full groups in dimension 1.
+  const idx_t num_full_groups_1 = num_iters_1 / num_iters_in_full_group_1;
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_2 = std::min(block_idxs.align[2], block_idxs.step[2]);
+
+  // Aligned beginning point such that (block_idxs.begin[2] - block_idxs.step[2]) < aligned_begin_2 <= block_idxs.begin[2].
+  const idx_t aligned_begin_2 = yask::round_down_flr(block_idxs.begin[2] - block_idxs.align_ofs[2], adj_align_2) + block_idxs.align_ofs[2];
+
+  // Number of iterations to get from aligned_begin_2 to (but not including) block_idxs.end[2], stepping by block_idxs.step[2]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[2] steps.
+  const idx_t num_iters_2 = yask::ceil_idiv_flr(block_idxs.end[2] - aligned_begin_2, block_idxs.step[2]);
+
+  // Number of iterations in one full group in dimension 2. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[2]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_2 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[2], block_idxs.step[2]), num_iters_2);
+
+  // Number of full groups in dimension 2.
+  const idx_t num_full_groups_2 = num_iters_2 / num_iters_in_full_group_2;
+
+  // Number of iterations in dimensions 3, 1, 2
+  const idx_t num_iters_3_1_2 = num_iters_3 * num_iters_1 * num_iters_2;
+
+  // Number of iterations in dimensions 1, 2
+  const idx_t num_iters_1_2 = num_iters_1 * num_iters_2;
+
+  // Inner loop.
+ 
+
+  // Distribute iterations among OpenMP threads.
+ #pragma OMP_PRAGMA_PREFIX firstprivate(local_indices) OMP_PRAGMA_SUFFIX
+  for (idx_t loop_index_3_1_2 = 0; loop_index_3_1_2 < num_iters_3_1_2; loop_index_3_1_2++) {
+
+  // Working vars for iterations in groups. These are initialized to full-group counts and then reduced if we are in a partial group.
+  idx_t num_iters_in_group_3 = num_iters_in_full_group_3;
+  idx_t num_iters_in_group_1 = num_iters_in_full_group_1;
+  idx_t num_iters_in_group_2 = num_iters_in_full_group_2;
+
+  // Number of iterations in the set of groups across dimensions 1, 2.
+  idx_t num_iters_in_group_set_1_2 = num_iters_in_group_3 * num_iters_1 * num_iters_2;
+
+  // Index of this group in dimension 3.
+  idx_t index_of_group_3 = loop_index_3_1_2 / num_iters_in_group_set_1_2;
+
+  // Linear offset within the set of groups across dimensions 1, 2.
+  idx_t index_offset_within_group_set_1_2 = loop_index_3_1_2 % num_iters_in_group_set_1_2;
+
+  // Adjust number of iterations in this group in dimension 3.
+  if (index_of_group_3 >= num_full_groups_3)  num_iters_in_group_3 = num_iters_3 - (num_full_groups_3 * num_iters_in_full_group_3);
+
+  // Number of iterations in the set of groups across dimension 2.
+  idx_t num_iters_in_group_set_2 = num_iters_in_group_3 * num_iters_in_group_1 * num_iters_2;
+
+  // Index of this group in dimension 1.
+  idx_t index_of_group_1 = index_offset_within_group_set_1_2 / num_iters_in_group_set_2;
+
+  // Linear offset within the set of groups across dimension 2.
+  idx_t index_offset_within_group_set_2 = index_offset_within_group_set_1_2 % num_iters_in_group_set_2;
+
+  // Adjust number of iterations in this group in dimension 1.
+  if (index_of_group_1 >= num_full_groups_1)  num_iters_in_group_1 = num_iters_1 - (num_full_groups_1 * num_iters_in_full_group_1);
+
+  // Number of iterations in this group.
+  idx_t num_iters_in_full_group = num_iters_in_group_3 * num_iters_in_group_1 * num_iters_in_group_2;
+
+  // Index of this group in dimension 2.
+  idx_t index_of_group_2 = index_offset_within_group_set_2 / num_iters_in_full_group;
+
+  // Linear offset within this group.
+  idx_t index_offset_within_this_group = index_offset_within_group_set_2 % num_iters_in_full_group;
+
+  // Adjust number of iterations in this group in dimension 2.
+  if (index_of_group_2 >= num_full_groups_2)  num_iters_in_group_2 = num_iters_2 - (num_full_groups_2 * num_iters_in_full_group_2);
+
+  // Offset within this group in dimension 3.
+  idx_t index_offset_within_this_group_3 = index_offset_within_this_group / (num_iters_in_group_1 * num_iters_in_group_2);
+
+  // Zero-based, unit-stride index for dimension 3.
+  idx_t index_3 = num_iters_in_full_group_3 * index_of_group_3 + index_offset_within_this_group_3;
+
+  // Offset within this group in dimension 1.
+  idx_t index_offset_within_this_group_1 = (index_offset_within_this_group / (num_iters_in_group_2)) % num_iters_in_group_1;
+
+  // Zero-based, unit-stride index for dimension 1.
+  idx_t index_1 = num_iters_in_full_group_1 * index_of_group_1 + index_offset_within_this_group_1;
+
+  // Offset within this group in dimension 2.
+  idx_t index_offset_within_this_group_2 = (index_offset_within_this_group) % num_iters_in_group_2;
+
+  // Zero-based, unit-stride index for dimension 2.
+  idx_t index_2 = num_iters_in_full_group_2 * index_of_group_2 + index_offset_within_this_group_2;
+
+  // This value of index_3 covers dimension 3 from start_3 to (but not including) stop_3.
+  idx_t start_3 = std::max(aligned_begin_3 + (index_3 * block_idxs.step[3]), block_idxs.begin[3]);
+  idx_t stop_3 = std::min(aligned_begin_3 + ((index_3+1) * block_idxs.step[3]), block_idxs.end[3]);
+
+  // This value of index_1 covers dimension 1 from start_1 to (but not including) stop_1.
+  idx_t start_1 = std::max(aligned_begin_1 + (index_1 * block_idxs.step[1]), block_idxs.begin[1]);
+  idx_t stop_1 = std::min(aligned_begin_1 + ((index_1+1) * block_idxs.step[1]), block_idxs.end[1]);
+
+  // This value of index_2 covers dimension 2 from start_2 to (but not including) stop_2.
+  idx_t start_2 = std::max(aligned_begin_2 + (index_2 * block_idxs.step[2]), block_idxs.begin[2]);
+  idx_t stop_2 = std::min(aligned_begin_2 + ((index_2+1) * block_idxs.step[2]), block_idxs.end[2]);
+  local_indices.start[3] = start_3;
+  local_indices.stop[3] = stop_3;
+  local_indices.index[3] = index_3;
+  local_indices.start[1] = start_1;
+  local_indices.stop[1] = stop_1;
+  local_indices.index[1] = index_1;
+  local_indices.start[2] = start_2;
+  local_indices.stop[2] = stop_2;
+  local_indices.index[2] = index_2;
+   sg->calc_sub_block(thread_idx, local_indices);
+  }
+ }
+ break;
+ case 5:
+ {
+
+  // Indices for function calls.
+  ScanIndices local_indices(block_idxs);
+
+  // ** Begin scan over dimensions 3, 2, 1. **
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_3 = std::min(block_idxs.align[3], block_idxs.step[3]);
+
+  // Aligned beginning point such that (block_idxs.begin[3] - block_idxs.step[3]) < aligned_begin_3 <= block_idxs.begin[3].
+  const idx_t aligned_begin_3 = yask::round_down_flr(block_idxs.begin[3] - block_idxs.align_ofs[3], adj_align_3) + block_idxs.align_ofs[3];
+
+  // Number of iterations to get from aligned_begin_3 to (but not including) block_idxs.end[3], stepping by block_idxs.step[3]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[3] steps.
+  const idx_t num_iters_3 = yask::ceil_idiv_flr(block_idxs.end[3] - aligned_begin_3, block_idxs.step[3]);
+
+  // Number of iterations in one full group in dimension 3. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[3]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_3 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[3], block_idxs.step[3]), num_iters_3);
+
+  // Number of full groups in dimension 3.
+  const idx_t num_full_groups_3 = num_iters_3 / num_iters_in_full_group_3;
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_2 = std::min(block_idxs.align[2], block_idxs.step[2]);
+
+  // Aligned beginning point such that (block_idxs.begin[2] - block_idxs.step[2]) < aligned_begin_2 <= block_idxs.begin[2].
+  const idx_t aligned_begin_2 = yask::round_down_flr(block_idxs.begin[2] - block_idxs.align_ofs[2], adj_align_2) + block_idxs.align_ofs[2];
+
+  // Number of iterations to get from aligned_begin_2 to (but not including) block_idxs.end[2], stepping by block_idxs.step[2]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[2] steps.
+  const idx_t num_iters_2 = yask::ceil_idiv_flr(block_idxs.end[2] - aligned_begin_2, block_idxs.step[2]);
+
+  // Number of iterations in one full group in dimension 2. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[2]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_2 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[2], block_idxs.step[2]), num_iters_2);
+
+  // Number of full groups in dimension 2.
+  const idx_t num_full_groups_2 = num_iters_2 / num_iters_in_full_group_2;
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_1 = std::min(block_idxs.align[1], block_idxs.step[1]);
+
+  // Aligned beginning point such that (block_idxs.begin[1] - block_idxs.step[1]) < aligned_begin_1 <= block_idxs.begin[1].
+  const idx_t aligned_begin_1 = yask::round_down_flr(block_idxs.begin[1] - block_idxs.align_ofs[1], adj_align_1) + block_idxs.align_ofs[1];
+
+  // Number of iterations to get from aligned_begin_1 to (but not including) block_idxs.end[1], stepping by block_idxs.step[1]. This value is rounded up because the last iteration may cover fewer than block_idxs.step[1] steps.
+  const idx_t num_iters_1 = yask::ceil_idiv_flr(block_idxs.end[1] - aligned_begin_1, block_idxs.step[1]);
+
+  // Number of iterations in one full group in dimension 1. This value is rounded up, effectively increasing the group size if needed to a multiple of block_idxs.step[1]. A group is considered 'full' if it has the max number of iterations.
+  const idx_t num_iters_in_full_group_1 = std::min(yask::ceil_idiv_flr(block_idxs.group_size[1], block_idxs.step[1]), num_iters_1);
+
+  // Number of full groups in dimension 1.
+  const idx_t num_full_groups_1 = num_iters_1 / num_iters_in_full_group_1;
+
+  // Number of iterations in dimensions 3, 2, 1
+  const idx_t num_iters_3_2_1 = num_iters_3 * num_iters_2 * num_iters_1;
+
+  // Number of iterations in dimensions 2, 1
+  const idx_t num_iters_2_1 = num_iters_2 * num_iters_1;
+
+  // Inner loop.
+ 
+
+  // Distribute iterations among OpenMP threads.
+ #pragma OMP_PRAGMA_PREFIX firstprivate(local_indices) OMP_PRAGMA_SUFFIX
+  for (idx_t loop_index_3_2_1 = 0; loop_index_3_2_1 < num_iters_3_2_1; loop_index_3_2_1++) {
+
+  // Working vars for iterations in groups. These are initialized to full-group counts and then reduced if we are in a partial group.
+  idx_t num_iters_in_group_3 = num_iters_in_full_group_3;
+  idx_t num_iters_in_group_2 = num_iters_in_full_group_2;
+  idx_t num_iters_in_group_1 = num_iters_in_full_group_1;
+
+  // Number of iterations in the set of groups across dimensions 2, 1.
+  idx_t num_iters_in_group_set_2_1 = num_iters_in_group_3 * num_iters_2 * num_iters_1;
+
+  // Index of this group in dimension 3.
+  idx_t index_of_group_3 = loop_index_3_2_1 / num_iters_in_group_set_2_1;
+
+  // Linear offset within the set of groups across dimensions 2, 1.
+  idx_t index_offset_within_group_set_2_1 = loop_index_3_2_1 % num_iters_in_group_set_2_1;
+
+  // Adjust number of iterations in this group in dimension 3.
+  if (index_of_group_3 >= num_full_groups_3)  num_iters_in_group_3 = num_iters_3 - (num_full_groups_3 * num_iters_in_full_group_3);
+
+  // Number of iterations in the set of groups across dimension 1.
+  idx_t num_iters_in_group_set_1 = num_iters_in_group_3 * num_iters_in_group_2 * num_iters_1;
+
+  // Index of this group in dimension 2.
+  idx_t index_of_group_2 = index_offset_within_group_set_2_1 / num_iters_in_group_set_1;
+
+  // Linear offset within the set of groups across dimension 1.
+  idx_t index_offset_within_group_set_1 = index_offset_within_group_set_2_1 % num_iters_in_group_set_1;
+
+  // Adjust number of iterations in this group in dimension 2.
+  if (index_of_group_2 >= num_full_groups_2)  num_iters_in_group_2 = num_iters_2 - (num_full_groups_2 * num_iters_in_full_group_2);
+
+  // Number of iterations in this group.
+  idx_t num_iters_in_full_group = num_iters_in_group_3 * num_iters_in_group_2 * num_iters_in_group_1;
+
+  // Index of this group in dimension 1.
+  idx_t index_of_group_1 = index_offset_within_group_set_1 / num_iters_in_full_group;
+
+  // Linear offset within this group.
+  idx_t index_offset_within_this_group = index_offset_within_group_set_1 % num_iters_in_full_group;
+
+  // Adjust number of iterations in this group in dimension 1.
+  if (index_of_group_1 >= num_full_groups_1)  num_iters_in_group_1 = num_iters_1 - (num_full_groups_1 * num_iters_in_full_group_1);
+
+  // Offset within this group in dimension 3.
+  idx_t index_offset_within_this_group_3 = index_offset_within_this_group / (num_iters_in_group_2 * num_iters_in_group_1);
+
+  // Zero-based, unit-stride index for dimension 3.
+  idx_t index_3 = num_iters_in_full_group_3 * index_of_group_3 + index_offset_within_this_group_3;
+
+  // Offset within this group in dimension 2.
+  idx_t index_offset_within_this_group_2 = (index_offset_within_this_group / (num_iters_in_group_1)) % num_iters_in_group_2;
+
+  // Zero-based, unit-stride index for dimension 2.
+  idx_t index_2 = num_iters_in_full_group_2 * index_of_group_2 + index_offset_within_this_group_2;
+
+  // Offset within this group in dimension 1.
+  idx_t index_offset_within_this_group_1 = (index_offset_within_this_group) % num_iters_in_group_1;
+
+  // Zero-based, unit-stride index for dimension 1.
+  idx_t index_1 = num_iters_in_full_group_1 * index_of_group_1 + index_offset_within_this_group_1;
+
+  // This value of index_3 covers dimension 3 from start_3 to (but not including) stop_3.
+  idx_t start_3 = std::max(aligned_begin_3 + (index_3 * block_idxs.step[3]), block_idxs.begin[3]);
+  idx_t stop_3 = std::min(aligned_begin_3 + ((index_3+1) * block_idxs.step[3]), block_idxs.end[3]);
+
+  // This value of index_2 covers dimension 2 from start_2 to (but not including) stop_2.
+  idx_t start_2 = std::max(aligned_begin_2 + (index_2 * block_idxs.step[2]), block_idxs.begin[2]);
+  idx_t stop_2 = std::min(aligned_begin_2 + ((index_2+1) * block_idxs.step[2]), block_idxs.end[2]);
+
+  // This value of index_1 covers dimension 1 from start_1 to (but not including) stop_1.
+  idx_t start_1 = std::max(aligned_begin_1 + (index_1 * block_idxs.step[1]), block_idxs.begin[1]);
+  idx_t stop_1 = std::min(aligned_begin_1 + ((index_1+1) * block_idxs.step[1]), block_idxs.end[1]);
+  local_indices.start[3] = start_3;
+  local_indices.stop[3] = stop_3;
+  local_indices.index[3] = index_3;
+  local_indices.start[2] = start_2;
+  local_indices.stop[2] = stop_2;
+  local_indices.index[2] = index_2;
+  local_indices.start[1] = start_1;
+  local_indices.stop[1] = stop_1;
+  local_indices.index[1] = index_1;
+   sg->calc_sub_block(thread_idx, local_indices);
+  }
+ }
+ break;
+ }
+ #undef OMP_PRAGMA_PREFIX
+ #undef OMP_PRAGMA_SUFFIX
+
+ // End of generated code.
@@ -0,0 +1,95 @@
+/*
+ * 4-D grid-scanning code.
+ * Generated automatically from the following pseudo-code:
+ *
+ * N = 3;
+ *  loop(1 .. N-1) {  call(calc_region(bp)); }
+ *
+ */ #ifndef OMP_PRAGMA_PREFIX
+ #define OMP_PRAGMA_PREFIX omp parallel for
+ #endif
+ #ifndef OMP_PRAGMA_SUFFIX
+ #define OMP_PRAGMA_SUFFIX
+ #endif
+
+ // 'ScanIndices rank_idxs' must be set before the following code.
+ {
+
+  // Indices for function calls.
+  ScanIndices local_indices(rank_idxs);
+
+  // ** Begin scan over dimensions 1, 2, 3. **
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_1 = std::min(rank_idxs.align[1], rank_idxs.step[1]);
+
+  // Aligned beginning point such that (rank_idxs.begin[1] - rank_idxs.step[1]) < aligned_begin_1 <= rank_idxs.begin[1].
+  const idx_t aligned_begin_1 = yask::round_down_flr(rank_idxs.begin[1] - rank_idxs.align_ofs[1], adj_align_1) + rank_idxs.align_ofs[1];
+
+  // Number of iterations to get from aligned_begin_1 to (but not including) rank_idxs.end[1], stepping by rank_idxs.step[1]. This value is rounded up because the last iteration may cover fewer than rank_idxs.step[1] steps.
+  const idx_t num_iters_1 = yask::ceil_idiv_flr(rank_idxs.end[1] - aligned_begin_1, rank_idxs.step[1]);
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_2 = std::min(rank_idxs.align[2], rank_idxs.step[2]);
+
+  // Aligned beginning point such that (rank_idxs.begin[2] - rank_idxs.step[2]) < aligned_begin_2 <= rank_idxs.begin[2].
+  const idx_t aligned_begin_2 = yask::round_down_flr(rank_idxs.begin[2] - rank_idxs.align_ofs[2], adj_align_2) + rank_idxs.align_ofs[2];
+
+  // Number of iterations to get from aligned_begin_2 to (but not including) rank_idxs.end[2], stepping by rank_idxs.step[2]. This value is rounded up because the last iteration may cover fewer than rank_idxs.step[2] steps.
+  const idx_t num_iters_2 = yask::ceil_idiv_flr(rank_idxs.end[2] - aligned_begin_2, rank_idxs.step[2]);
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_3 = std::min(rank_idxs.align[3], rank_idxs.step[3]);
+
+  // Aligned beginning point such that (rank_idxs.begin[3] - rank_idxs.step[3]) < aligned_begin_3 <= rank_idxs.begin[3].
+  const idx_t aligned_begin_3 = yask::round_down_flr(rank_idxs.begin[3] - rank_idxs.align_ofs[3], adj_align_3) + rank_idxs.align_ofs[3];
+
+  // Number of iterations to get from aligned_begin_3 to (but not including) rank_idxs.end[3], stepping by rank_idxs.step[3]. This value is rounded up because the last iteration may cover fewer than rank_idxs.step[3] steps.
+  const idx_t num_iters_3 = yask::ceil_idiv_flr(rank_idxs.end[3] - aligned_begin_3, rank_idxs.step[3]);
+
+  // Number of iterations in dimensions 1, 2, 3
+  const idx_t num_iters_1_2_3 = num_iters_1 * num_iters_2 * num_iters_3;
+
+  // Number of iterations in dimensions 2, 3
+  const idx_t num_iters_2_3 = num_iters_2 * num_iters_3;
+
+  // Inner loop.
+ 
+  for (idx_t loop_index_1_2_3 = 0; loop_index_1_2_3 < num_iters_1_2_3; loop_index_1_2_3++) {
+
+  // Zero-based, unit-stride index for dimension 1.
+  idx_t index_1 = loop_index_1_2_3 / num_iters_2_3;
+
+  // Zero-based, unit-stride index for dimension 2.
+  idx_t index_2 = (loop_index_1_2_3 / num_iters_3) % num_iters_2;
+
+  // Zero-based, unit-stride index for dimension 3.
+  idx_t index_3 = (loop_index_1_2_3) % num_iters_3;
+
+  // This value of index_1 covers dimension 1 from start_1 to (but not including) stop_1.
+  idx_t start_1 = std::max(aligned_begin_1 + (index_1 * rank_idxs.step[1]), rank_idxs.begin[1]);
+  idx_t stop_1 = std::min(aligned_begin_1 + ((index_1+1) * rank_idxs.step[1]), rank_idxs.end[1]);
+
+  // This value of index_2 covers dimension 2 from start_2 to (but not including) stop_2.
+  idx_t start_2 = std::max(aligned_begin_2 + (index_2 * rank_idxs.step[2]), rank_idxs.begin[2]);
+  idx_t stop_2 = std::min(aligned_begin_2 + ((index_2+1) * rank_idxs.step[2]), rank_idxs.end[2]);
+
+  // This value of index_3 covers dimension 3 from start_3 to (but not including) stop_3.
+  idx_t start_3 = std::max(aligned_begin_3 + (index_3 * rank_idxs.step[3]), rank_idxs.begin[3]);
+  idx_t stop_3 = std::min(aligned_begin_3 + ((index_3+1) * rank_idxs.step[3]), rank_idxs.end[3]);
+  local_indices.start[1] = start_1;
+  local_indices.stop[1] = stop_1;
+  local_indices.index[1] = index_1;
+  local_indices.start[2] = start_2;
+  local_indices.stop[2] = stop_2;
+  local_indices.index[2] = index_2;
+  local_indices.start[3] = start_3;
+  local_indices.stop[3] = stop_3;
+  local_indices.index[3] = index_3;
+   calc_region(bp, local_indices);
+  }
+ }
+ #undef OMP_PRAGMA_PREFIX
+ #undef OMP_PRAGMA_SUFFIX
+
+ // End of generated code.
@@ -0,0 +1,3069 @@
+// Automatically-generated code; do not edit.
+
+////// YASK implementation of the 'iso3dfd' stencil //////
+
+#ifdef DEFINE_MACROS
+// Stencil solution:
+#define YASK_STENCIL_NAME "iso3dfd"
+#define YASK_STENCIL_CONTEXT StencilContext_iso3dfd
+
+// FP precision:
+#define REAL_BYTES (4)
+
+// Number of domain dimensions:
+#define NUM_DOMAIN_DIMS 3
+#define DOMAIN_DIM_IDX_x (0)
+#define DOMAIN_DIM_IDX_y (1)
+#define DOMAIN_DIM_IDX_z (2)
+
+// Number of stencil dimensions (step and domain):
+#define NUM_STENCIL_DIMS 4
+#define STENCIL_DIM_IDX_t (0)
+#define STENCIL_DIM_IDX_x (1)
+#define STENCIL_DIM_IDX_y (2)
+#define STENCIL_DIM_IDX_z (3)
+
+// Max number of grid dimensions:
+#define NUM_GRID_DIMS 4
+
+// Number of stencil equations:
+#define NUM_STENCIL_EQS 1
+
+// One vector fold: x=8 * y=1 * z=1
+#define VLEN_X (8)
+#define VLEN_Y (1)
+#define VLEN_Z (1)
+#define VLEN (8)
+#define FIRST_FOLD_INDEX_IS_UNIT_STRIDE (1)
+#define NUM_VEC_FOLD_DIMS (1)
+#define VEC_FOLD_LAYOUT_CLASS Layout_1
+#define VEC_FOLD_LAYOUT(idxs) LAYOUT_1(idxs[0], 8)
+#define USING_UNALIGNED_LOADS (0)
+
+// Cluster multipliers of vector folds: x=1 * y=1 * z=2
+#define CMULT_X (1)
+#define CMULT_Y (1)
+#define CMULT_Z (2)
+#define CMULT (2)
+
+#endif // DEFINE_MACROS
+
+#ifdef DEFINE_CONTEXT
+namespace yask {
+
+ ////// Stencil-specific data //////
+class StencilContext_iso3dfd_data : public StencilContext {
+public:
+
+ ///// Grid(s).
+
+ // The 4-D grid 'pressure', which is updated by one or more equations.
+ typedef YkVecGrid<Layout_2314, true, 1, 8, 1, 1> pressure_type;
+ typedef std::shared_ptr<pressure_type> pressure_ptr_type;
+ GridDimNames pressure_dim_names;
+ pressure_ptr_type pressure_ptr;
+ pressure_type* pressure;
+ const int pressure_max_exch_dist = 1; // max L1 distance of neighbor ranks that need halo data.
+ const idx_t pressure_alloc_t = 2; // default allocation in 't' dimension.
+ const idx_t pressure_left_halo_x = 8; // default halo size in 'x' dimension.
+ const idx_t pressure_right_halo_x = 8; // default halo size in 'x' dimension.
+ const idx_t pressure_left_halo_y = 8; // default halo size in 'y' dimension.
+ const idx_t pressure_right_halo_y = 8; // default halo size in 'y' dimension.
+ const idx_t pressure_left_halo_z = 8; // default halo size in 'z' dimension.
+ const idx_t pressure_right_halo_z = 8; // default halo size in 'z' dimension.
+
+ // The 3-D grid 'vel', which is not updated by any equation (read-only).
+ typedef YkVecGrid<Layout_123, false, 8, 1, 1> vel_type;
+ typedef std::shared_ptr<vel_type> vel_ptr_type;
+ GridDimNames vel_dim_names;
+ vel_ptr_type vel_ptr;
+ vel_type* vel;
+ const int vel_max_exch_dist = 0; // max L1 distance of neighbor ranks that need halo data.
+ const idx_t vel_left_halo_x = 0; // default halo size in 'x' dimension.
+ const idx_t vel_right_halo_x = 0; // default halo size in 'x' dimension.
+ const idx_t vel_left_halo_y = 0; // default halo size in 'y' dimension.
+ const idx_t vel_right_halo_y = 0; // default halo size in 'y' dimension.
+ const idx_t vel_left_halo_z = 0; // default halo size in 'z' dimension.
+ const idx_t vel_right_halo_z = 0; // default halo size in 'z' dimension.
+
+ // The 1-D grid 'coeff', which is not updated by any equation (read-only).
+ typedef YkElemGrid<Layout_1, false> coeff_type;
+ typedef std::shared_ptr<coeff_type> coeff_ptr_type;
+ GridDimNames coeff_dim_names;
+ coeff_ptr_type coeff_ptr;
+ coeff_type* coeff;
+ const idx_t coeff_alloc_r = 9; // default allocation in 'r' dimension.
+
+ // Constructor.
+ StencilContext_iso3dfd_data(KernelEnvPtr env, KernelSettingsPtr settings) : StencilContext(env, settings) {
+  name = "iso3dfd";
+
+ // Create grids (but do not allocate data in them).
+
+ // Grid 'pressure'.
+ pressure_dim_names = {"t", "x", "y", "z"};
+ pressure_ptr = std::make_shared<pressure_type>(_dims, "pressure", pressure_dim_names, &_opts, &_ostr);
+ assert(pressure_ptr);
+ pressure_ptr->set_max_exch_dist(pressure_max_exch_dist);
+ pressure_ptr->set_alloc_size("t", pressure_alloc_t);
+ pressure_ptr->set_left_halo_size("x", pressure_left_halo_x);
+ pressure_ptr->set_right_halo_size("x", pressure_right_halo_x);
+ pressure_ptr->set_left_halo_size("y", pressure_left_halo_y);
+ pressure_ptr->set_right_halo_size("y", pressure_right_halo_y);
+ pressure_ptr->set_left_halo_size("z", pressure_left_halo_z);
+ pressure_ptr->set_right_halo_size("z", pressure_right_halo_z);
+ pressure = pressure_ptr.get();
+ addGrid(pressure_ptr, true /* is an output grid */);
+
+ // Grid 'vel'.
+ vel_dim_names = {"x", "y", "z"};
+ vel_ptr = std::make_shared<vel_type>(_dims, "vel", vel_dim_names, &_opts, &_ostr);
+ assert(vel_ptr);
+ vel_ptr->set_max_exch_dist(vel_max_exch_dist);
+ vel_ptr->set_left_halo_size("x", vel_left_halo_x);
+ vel_ptr->set_right_halo_size("x", vel_right_halo_x);
+ vel_ptr->set_left_halo_size("y", vel_left_halo_y);
+ vel_ptr->set_right_halo_size("y", vel_right_halo_y);
+ vel_ptr->set_left_halo_size("z", vel_left_halo_z);
+ vel_ptr->set_right_halo_size("z", vel_right_halo_z);
+ vel = vel_ptr.get();
+ addGrid(vel_ptr, false /* is not an output grid */);
+
+ // Grid 'coeff'.
+ coeff_dim_names = {"r"};
+ coeff_ptr = std::make_shared<coeff_type>(_dims, "coeff", coeff_dim_names, &_opts, &_ostr);
+ assert(coeff_ptr);
+ coeff_ptr->set_alloc_size("r", coeff_alloc_r);
+ coeff = coeff_ptr.get();
+ addGrid(coeff_ptr, false /* is not an output grid */);
+
+ // Update grids with context info.
+ update_grid_info();
+ } // ctor
+
+ // Make a new grid iff its dims match any in the stencil.
+ // Returns pointer to the new grid or nullptr if no match.
+ virtual YkGridPtr newStencilGrid(const std::string& name, const GridDimNames& dims) {
+ YkGridPtr gp;
+
+ // Grids with 't, x, y, z' dim(s).
+ if (dims == pressure_dim_names) gp = std::make_shared<pressure_type>(_dims, name, dims, &_opts, &_ostr);
+
+ // Grids with 'x, y, z' dim(s).
+ else if (dims == vel_dim_names) gp = std::make_shared<vel_type>(_dims, name, dims, &_opts, &_ostr);
+
+ // Grids with 'r' dim(s).
+ else if (dims == coeff_dim_names) gp = std::make_shared<coeff_type>(_dims, name, dims, &_opts, &_ostr);
+ return gp;
+ } // newStencilGrid
+
+ // Make new scratch grids.
+ virtual void makeScratchGrids(int num_threads) {
+ } // newScratchGrids
+}; // StencilContext_iso3dfd_data
+
+ ////// Stencil equation-bundle 'stencil_bundle_0' w/o condition //////
+
+ class StencilBundle_stencil_bundle_0 : public StencilBundleBase {
+ protected:
+ typedef StencilContext_iso3dfd_data _context_type;
+ _context_type* _context = 0;
+ public:
+
+ // 61 FP operation(s) per point:
+ // pressure((t + 1), x, y, z) EQUALS (((2 * pressure(t, x, y, z)) - pressure((t - 1), x, y, z)) + (((pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)) + ((pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8))) * vel(x, y, z))).
+ StencilBundle_stencil_bundle_0(StencilContext_iso3dfd_data* context) :
+ StencilBundleBase(context),
+ _context(context) {
+ _name = "stencil_bundle_0";
+ _scalar_fp_ops = 61;
+ _scalar_points_read = 60;
+ _scalar_points_written = 1;
+ _is_scratch = false;
+
+ // The following grids are read by StencilBundle_stencil_bundle_0
+  inputGridPtrs.push_back(_context->vel_ptr);
+  inputGridPtrs.push_back(_context->coeff_ptr);
+  inputGridPtrs.push_back(_context->pressure_ptr);
+
+ // The following grids are written by StencilBundle_stencil_bundle_0
+  outputGridPtrs.push_back(_context->pressure_ptr);
+
+ // The following points are accessed by StencilBundle_stencil_bundle_0 relative to the point being calculated.
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, 0 }, false }); // pressure(t, x, y, z).
+  _accesses.push_back({ _context->pressure_ptr, { -1, 0, 0, 0 }, false }); // pressure((t - 1), x, y, z).
+  _accesses.push_back({ _context->coeff_ptr, { 0 }, false }); // coeff(0).
+  _accesses.push_back({ _context->pressure_ptr, { 0, -1, 0, 0 }, false }); // pressure(t, (x - 1), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 1, 0, 0 }, false }); // pressure(t, (x + 1), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, -1, 0 }, false }); // pressure(t, x, (y - 1), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 1, 0 }, false }); // pressure(t, x, (y + 1), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, -1 }, false }); // pressure(t, x, y, (z - 1)).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, 1 }, false }); // pressure(t, x, y, (z + 1)).
+  _accesses.push_back({ _context->coeff_ptr, { 1 }, false }); // coeff(1).
+  _accesses.push_back({ _context->pressure_ptr, { 0, -2, 0, 0 }, false }); // pressure(t, (x - 2), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 2, 0, 0 }, false }); // pressure(t, (x + 2), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, -2, 0 }, false }); // pressure(t, x, (y - 2), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 2, 0 }, false }); // pressure(t, x, (y + 2), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, -2 }, false }); // pressure(t, x, y, (z - 2)).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, 2 }, false }); // pressure(t, x, y, (z + 2)).
+  _accesses.push_back({ _context->coeff_ptr, { 2 }, false }); // coeff(2).
+  _accesses.push_back({ _context->pressure_ptr, { 0, -3, 0, 0 }, false }); // pressure(t, (x - 3), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 3, 0, 0 }, false }); // pressure(t, (x + 3), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, -3, 0 }, false }); // pressure(t, x, (y - 3), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 3, 0 }, false }); // pressure(t, x, (y + 3), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, -3 }, false }); // pressure(t, x, y, (z - 3)).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, 3 }, false }); // pressure(t, x, y, (z + 3)).
+  _accesses.push_back({ _context->coeff_ptr, { 3 }, false }); // coeff(3).
+  _accesses.push_back({ _context->pressure_ptr, { 0, -4, 0, 0 }, false }); // pressure(t, (x - 4), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 4, 0, 0 }, false }); // pressure(t, (x + 4), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, -4, 0 }, false }); // pressure(t, x, (y - 4), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 4, 0 }, false }); // pressure(t, x, (y + 4), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, -4 }, false }); // pressure(t, x, y, (z - 4)).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, 4 }, false }); // pressure(t, x, y, (z + 4)).
+  _accesses.push_back({ _context->coeff_ptr, { 4 }, false }); // coeff(4).
+  _accesses.push_back({ _context->pressure_ptr, { 0, -5, 0, 0 }, false }); // pressure(t, (x - 5), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 5, 0, 0 }, false }); // pressure(t, (x + 5), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, -5, 0 }, false }); // pressure(t, x, (y - 5), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 5, 0 }, false }); // pressure(t, x, (y + 5), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, -5 }, false }); // pressure(t, x, y, (z - 5)).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, 5 }, false }); // pressure(t, x, y, (z + 5)).
+  _accesses.push_back({ _context->coeff_ptr, { 5 }, false }); // coeff(5).
+  _accesses.push_back({ _context->pressure_ptr, { 0, -6, 0, 0 }, false }); // pressure(t, (x - 6), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 6, 0, 0 }, false }); // pressure(t, (x + 6), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, -6, 0 }, false }); // pressure(t, x, (y - 6), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 6, 0 }, false }); // pressure(t, x, (y + 6), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, -6 }, false }); // pressure(t, x, y, (z - 6)).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, 6 }, false }); // pressure(t, x, y, (z + 6)).
+  _accesses.push_back({ _context->coeff_ptr, { 6 }, false }); // coeff(6).
+  _accesses.push_back({ _context->pressure_ptr, { 0, -7, 0, 0 }, false }); // pressure(t, (x - 7), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 7, 0, 0 }, false }); // pressure(t, (x + 7), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, -7, 0 }, false }); // pressure(t, x, (y - 7), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 7, 0 }, false }); // pressure(t, x, (y + 7), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, -7 }, false }); // pressure(t, x, y, (z - 7)).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, 7 }, false }); // pressure(t, x, y, (z + 7)).
+  _accesses.push_back({ _context->coeff_ptr, { 7 }, false }); // coeff(7).
+  _accesses.push_back({ _context->pressure_ptr, { 0, -8, 0, 0 }, false }); // pressure(t, (x - 8), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 8, 0, 0 }, false }); // pressure(t, (x + 8), y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, -8, 0 }, false }); // pressure(t, x, (y - 8), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 8, 0 }, false }); // pressure(t, x, (y + 8), z).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, -8 }, false }); // pressure(t, x, y, (z - 8)).
+  _accesses.push_back({ _context->pressure_ptr, { 0, 0, 0, 8 }, false }); // pressure(t, x, y, (z + 8)).
+  _accesses.push_back({ _context->coeff_ptr, { 8 }, false }); // coeff(8).
+  _accesses.push_back({ _context->vel_ptr, { 0, 0, 0 }, false }); // vel(x, y, z).
+  _accesses.push_back({ _context->pressure_ptr, { 1, 0, 0, 0 }, true }); // pressure((t + 1), x, y, z).
+ } // Ctor.
+
+ // Determine whether StencilBundle_stencil_bundle_0 is valid at the indices t, x, y, z.
+ // Return true if indices are within the valid sub-domain or false otherwise.
+ virtual bool is_in_valid_domain(const Indices& idxs) const final {
+
+ // Extract individual indices.
+ idx_t t = idxs[0];
+ idx_t x = idxs[1];
+ idx_t y = idxs[2];
+ idx_t z = idxs[3];
+ return true; // full domain.
+ }
+
+ // Determine where StencilBundle_stencil_bundle_0 is valid in the vector whose
+ // first element is at the global indices t, x, y, z.
+ // Return a write mask with one bit set for each valid element.
+ virtual idx_t get_valid_mask(const Indices& idxs) const final {
+ return idx_t(-1); // full domain.
+ }
+
+ // Calculate one scalar result relative to indices t, x, y, z.
+ // There are approximately 61 FP operation(s) per invocation.
+ virtual void calc_scalar(int thread_idx, const Indices& idxs) {
+
+ // Extract individual indices.
+ idx_t t = idxs[0];
+ idx_t x = idxs[1];
+ idx_t y = idxs[2];
+ idx_t z = idxs[3];
+ auto temp1 = static_cast<_context_type::pressure_type*>(_context->pressure);
+ auto temp2 = temp1->_wrap_step(t);
+ auto temp3 = temp1->_wrap_step((t - 1));
+
+ // temp4 = 2 * pressure(t, x, y, z).
+ real_t temp4 = 2.000000000000000e+00 * temp1->readElem({t, x, y, z}, temp2, __LINE__);
+
+ // temp5 = ((2 * pressure(t, x, y, z)) - pressure((t - 1), x, y, z)).
+ real_t temp5 = temp4 - temp1->readElem({(t - 1), x, y, z}, temp3, __LINE__);
+ auto temp6 = static_cast<_context_type::coeff_type*>(_context->coeff);
+ auto temp7 = 0;
+
+ // temp8 = pressure(t, x, y, z) * coeff(0).
+ real_t temp8 = temp1->readElem({t, x, y, z}, temp2, __LINE__) * temp6->readElem({0}, temp7, __LINE__);
+
+ // temp9 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)).
+ real_t temp9 = temp8 + ((temp1->readElem({t, (x - 1), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 1), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 1), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 1), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 1)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 1)}, temp2, __LINE__)) * temp6->readElem({1}, temp7, __LINE__));
+
+ // temp10 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)).
+ real_t temp10 = temp9 + ((temp1->readElem({t, (x - 2), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 2), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 2), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 2), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 2)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 2)}, temp2, __LINE__)) * temp6->readElem({2}, temp7, __LINE__));
+
+ // temp11 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)).
+ real_t temp11 = temp10 + ((temp1->readElem({t, (x - 3), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 3), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 3), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 3), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 3)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 3)}, temp2, __LINE__)) * temp6->readElem({3}, temp7, __LINE__));
+
+ // temp12 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)).
+ real_t temp12 = temp11 + ((temp1->readElem({t, (x - 4), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 4), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 4), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 4), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 4)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 4)}, temp2, __LINE__)) * temp6->readElem({4}, temp7, __LINE__));
+
+ // temp13 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)).
+ real_t temp13 = temp12 + ((temp1->readElem({t, (x - 5), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 5), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 5), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 5), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 5)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 5)}, temp2, __LINE__)) * temp6->readElem({5}, temp7, __LINE__));
+
+ // temp14 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)).
+ real_t temp14 = temp13 + ((temp1->readElem({t, (x - 6), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 6), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 6), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 6), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 6)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 6)}, temp2, __LINE__)) * temp6->readElem({6}, temp7, __LINE__));
+
+ // temp15 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)).
+ real_t temp15 = temp14 + ((temp1->readElem({t, (x - 7), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 7), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 7), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 7), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 7)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 7)}, temp2, __LINE__)) * temp6->readElem({7}, temp7, __LINE__));
+
+ // temp16 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)) + ((pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8)).
+ real_t temp16 = temp15 + ((temp1->readElem({t, (x - 8), y, z}, temp2, __LINE__) + temp1->readElem({t, (x + 8), y, z}, temp2, __LINE__) + temp1->readElem({t, x, (y - 8), z}, temp2, __LINE__) + temp1->readElem({t, x, (y + 8), z}, temp2, __LINE__) + temp1->readElem({t, x, y, (z - 8)}, temp2, __LINE__) + temp1->readElem({t, x, y, (z + 8)}, temp2, __LINE__)) * temp6->readElem({8}, temp7, __LINE__));
+ auto temp17 = static_cast<_context_type::vel_type*>(_context->vel);
+
+ // temp18 = ((pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)) + ((pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8))) * vel(x, y, z).
+ real_t temp18 = temp16 * temp17->readElem({x, y, z}, temp7, __LINE__);
+
+ // temp19 = ((2 * pressure(t, x, y, z)) - pressure((t - 1), x, y, z)) + (((pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)) + ((pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8))) * vel(x, y, z)).
+ real_t temp19 = temp5 + temp18;
+
+ // temp20 = (((2 * pressure(t, x, y, z)) - pressure((t - 1), x, y, z)) + (((pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)) + ((pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8))) * vel(x, y, z))).
+ real_t temp20 = temp19;
+
+ // Update value at pressure((t + 1), x, y, z).
+  auto temp21 = temp1->_wrap_step((t + 1));
+temp1->writeElem(temp20, {(t + 1), x, y, z}, temp21, __LINE__);
+} // calc_scalar.
+
+ // Calculate a series of vectors iterating in +'z' direction from t, x, y, z indices in 'idxs' to 'stop_z'.
+ // Each vector calculates 'x=8 * y=1 * z=1' point(s).
+ // Indices must be rank-relative (not global).
+ // Indices must be normalized, i.e., already divided by VLEN_*.
+ // SIMD calculations use 51 vector block(s) created from 37 aligned vector-block(s).
+ // There are approximately 488 FP operation(s) per iteration.
+ void calc_loop_of_vectors(int thread_idx, const Indices& idxs, idx_t stop_z, idx_t write_mask) {
+
+ // Extract individual indices.
+ idx_t t = idxs[0];
+ idx_t x = idxs[1];
+ idx_t y = idxs[2];
+ idx_t z = idxs[3];
+ idx_t start_z = z;
+ idx_t step_z = 1; // number of vectors per iter.
+ idx_t step_z_elem = VLEN_Z; // number of elements per iter.
+ bool use_nt_stores = _context->use_nt_stores() && write_mask == idx_t(-1); // streaming stores need whole vectors.
+ auto& opts = _context->get_settings();
+ const int pfd_l1 = opts->_prefetch_L1_dist; // prefetch distances.
+ const int pfd_l2 = opts->_prefetch_L2_dist;
+ const int pfh_l1 = opts->_prefetch_L1_hint; // prefetch hints.
+ const int pfh_l2 = opts->_prefetch_L2_hint;
+
+ // Element indices derived from vector indices.
+ idx_t x_elem = _context->rank_domain_offsets[0] + (x * VLEN_X);
+ idx_t y_elem = _context->rank_domain_offsets[1] + (y * VLEN_Y);
+ idx_t z_elem = _context->rank_domain_offsets[2] + (z * VLEN_Z);
+
+ // Force inlining if possible.
+#if !defined(DEBUG) && defined(__INTEL_COMPILER)
+#pragma forceinline recursive
+#endif
+ {
+ auto temp1 = static_cast<_context_type::coeff_type*>(_context->coeff);
+ auto temp2 = 0;
+
+ // temp3 = coeff(0).
+ real_vec_t temp3 = temp1->YkElemGrid::readElem({0}, temp2,__LINE__);
+
+ // temp4 = coeff(1).
+ real_vec_t temp4 = temp1->YkElemGrid::readElem({1}, temp2,__LINE__);
+
+ // temp5 = coeff(2).
+ real_vec_t temp5 = temp1->YkElemGrid::readElem({2}, temp2,__LINE__);
+
+ // temp6 = coeff(3).
+ real_vec_t temp6 = temp1->YkElemGrid::readElem({3}, temp2,__LINE__);
+
+ // temp7 = coeff(4).
+ real_vec_t temp7 = temp1->YkElemGrid::readElem({4}, temp2,__LINE__);
+
+ // temp8 = coeff(5).
+ real_vec_t temp8 = temp1->YkElemGrid::readElem({5}, temp2,__LINE__);
+
+ // temp9 = coeff(6).
+ real_vec_t temp9 = temp1->YkElemGrid::readElem({6}, temp2,__LINE__);
+
+ // temp10 = coeff(7).
+ real_vec_t temp10 = temp1->YkElemGrid::readElem({7}, temp2,__LINE__);
+
+ // temp11 = coeff(8).
+ real_vec_t temp11 = temp1->YkElemGrid::readElem({8}, temp2,__LINE__);
+
+ // Calculate pointer to  vector starting at pressure((t - 1), x, y, 0).
+ auto temp34 = static_cast<_context_type::pressure_type*>(_context->pressure);
+ auto temp35 = temp34->_wrap_step((t - 1));
+ real_vec_t* temp12 = temp34->getVecPtrNorm({(t - 1), x, y, 0} ,temp35, false);
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp12[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp12[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, (x - 8), y, 0).
+ auto temp36 = temp34->_wrap_step(t);
+ real_vec_t* temp13 = temp34->getVecPtrNorm({t, (x-(8 / VLEN_X)), y, 0} ,temp36, false);
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp13[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp13[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Distance in vectors between 'pressure' vectors one apart in 'x'.
+ idx_t temp37 = temp34->getVecPtrNorm({t, x, y, 0} ,temp36, false) - temp13;
+
+ // Distance in vectors between 'pressure' vectors one apart in 'y'.
+ idx_t temp38 = temp34->getVecPtrNorm({t, (x-(8 / VLEN_X)), (y+(1 / VLEN_Y)), 0} ,temp36, false) - temp13;
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 8), 0).
+ real_vec_t* temp14 = temp13 +(8 / VLEN_X) * temp37 -(8 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp14[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp14[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 7), 0).
+ real_vec_t* temp15 = temp13 +(8 / VLEN_X) * temp37 -(7 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp15[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp15[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 6), 0).
+ real_vec_t* temp16 = temp13 +(8 / VLEN_X) * temp37 -(6 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp16[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp16[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 5), 0).
+ real_vec_t* temp17 = temp13 +(8 / VLEN_X) * temp37 -(5 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp17[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp17[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 4), 0).
+ real_vec_t* temp18 = temp13 +(8 / VLEN_X) * temp37 -(4 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp18[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp18[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 3), 0).
+ real_vec_t* temp19 = temp13 +(8 / VLEN_X) * temp37 -(3 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp19[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp19[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 2), 0).
+ real_vec_t* temp20 = temp13 +(8 / VLEN_X) * temp37 -(2 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp20[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp20[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 1), 0).
+ real_vec_t* temp21 = temp13 +(8 / VLEN_X) * temp37 -(1 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp21[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp21[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, y, 0).
+ real_vec_t* temp22 = temp13 +(8 / VLEN_X) * temp37;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = -(8 / VLEN_Z); ofs < (pfd_l1*CMULT_Z)+(8 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp22[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = -(8 / VLEN_Z); ofs < (pfd_l2*CMULT_Z)+(8 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp22[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 1), 0).
+ real_vec_t* temp23 = temp13 +(8 / VLEN_X) * temp37 +(1 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp23[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp23[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 2), 0).
+ real_vec_t* temp24 = temp13 +(8 / VLEN_X) * temp37 +(2 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp24[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp24[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 3), 0).
+ real_vec_t* temp25 = temp13 +(8 / VLEN_X) * temp37 +(3 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp25[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp25[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 4), 0).
+ real_vec_t* temp26 = temp13 +(8 / VLEN_X) * temp37 +(4 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp26[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp26[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 5), 0).
+ real_vec_t* temp27 = temp13 +(8 / VLEN_X) * temp37 +(5 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp27[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp27[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 6), 0).
+ real_vec_t* temp28 = temp13 +(8 / VLEN_X) * temp37 +(6 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp28[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp28[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 7), 0).
+ real_vec_t* temp29 = temp13 +(8 / VLEN_X) * temp37 +(7 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp29[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp29[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 8), 0).
+ real_vec_t* temp30 = temp13 +(8 / VLEN_X) * temp37 +(8 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp30[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp30[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, (x + 8), y, 0).
+ real_vec_t* temp31 = temp13 +(16 / VLEN_X) * temp37;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp31[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp31[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure((t + 1), x, y, 0).
+ auto temp39 = temp34->_wrap_step((t + 1));
+ real_vec_t* temp32 = temp34->getVecPtrNorm({(t + 1), x, y, 0} ,temp39, false);
+
+ // Calculate pointer to  vector starting at vel(x, y, 0).
+ auto temp40 = static_cast<_context_type::vel_type*>(_context->vel);
+ real_vec_t* temp33 = temp40->getVecPtrNorm({x, y, 0} ,temp2, false);
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp33[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp33[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // 16 aligned vector-block(s) carried in registers across 'z' iterations.
+ real_vec_t temp41;
+ real_vec_t temp42;
+ real_vec_t temp43;
+ real_vec_t temp44;
+ real_vec_t temp45;
+ real_vec_t temp46;
+ real_vec_t temp47;
+ real_vec_t temp48;
+ real_vec_t temp49;
+ real_vec_t temp50;
+ real_vec_t temp51;
+ real_vec_t temp52;
+ real_vec_t temp53;
+ real_vec_t temp54;
+ real_vec_t temp55;
+ real_vec_t temp56;
+ if (z < stop_z) {
+
+ // Read carried vector starting at pressure(t, x, y, (z - 8)).
+ temp41 = temp22[(z-(8 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 7)).
+ temp42 = temp22[(z-(7 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 6)).
+ temp43 = temp22[(z-(6 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 5)).
+ temp44 = temp22[(z-(5 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 4)).
+ temp45 = temp22[(z-(4 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 3)).
+ temp46 = temp22[(z-(3 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 2)).
+ temp47 = temp22[(z-(2 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 1)).
+ temp48 = temp22[(z-(1 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, z).
+ temp49 = temp22[z];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 1)).
+ temp50 = temp22[(z+(1 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 2)).
+ temp51 = temp22[(z+(2 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 3)).
+ temp52 = temp22[(z+(3 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 4)).
+ temp53 = temp22[(z+(4 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 5)).
+ temp54 = temp22[(z+(5 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 6)).
+ temp55 = temp22[(z+(6 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 7)).
+ temp56 = temp22[(z+(7 / VLEN_Z))];
+ }
+
+ // Inner loop.
+ for (idx_t z = start_z; z < stop_z; z += step_z, z_elem += step_z_elem) {
+
+ // Read aligned vector starting at pressure((t - 1), x, y, z).
+ real_vec_t temp57 = temp12[z];
+
+ // temp58 = 2 * pressure(t, x, y, z).
+ real_vec_t temp58 = 2.000000000000000e+00 * temp49;
+
+ // temp59 = ((2 * pressure(t, x, y, z)) - pressure((t - 1), x, y, z)).
+ real_vec_t temp59 = temp58 - temp57;
+
+ // temp60 = pressure(t, x, y, z) * coeff(0).
+ real_vec_t temp60 = temp49 * temp3;
+
+ // Read aligned vector starting at pressure(t, (x - 8), y, z).
+ real_vec_t temp61 = temp13[z];
+
+ // Construct unaligned vector starting at pressure(t, (x - 1), y, z).
+ real_vec_t temp62;
+ // temp62[0] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp62[1] = temp49[0];  // for pressure(t, x, y, z);
+ // temp62[2] = temp49[1];  // for pressure(t, x+1, y, z);
+ // temp62[3] = temp49[2];  // for pressure(t, x+2, y, z);
+ // temp62[4] = temp49[3];  // for pressure(t, x+3, y, z);
+ // temp62[5] = temp49[4];  // for pressure(t, x+4, y, z);
+ // temp62[6] = temp49[5];  // for pressure(t, x+5, y, z);
+ // temp62[7] = temp49[6];  // for pressure(t, x+6, y, z);
+ // Get 7 element(s) from temp49 and 1 from temp61.
+ real_vec_align<7>(temp62, temp49, temp61);
+
+ // Read aligned vector starting at pressure(t, (x + 8), y, z).
+ real_vec_t temp63 = temp31[z];
+
+ // Construct unaligned vector starting at pressure(t, (x + 1), y, z).
+ real_vec_t temp64;
+ // temp64[0] = temp49[1];  // for pressure(t, x+1, y, z);
+ // temp64[1] = temp49[2];  // for pressure(t, x+2, y, z);
+ // temp64[2] = temp49[3];  // for pressure(t, x+3, y, z);
+ // temp64[3] = temp49[4];  // for pressure(t, x+4, y, z);
+ // temp64[4] = temp49[5];  // for pressure(t, x+5, y, z);
+ // temp64[5] = temp49[6];  // for pressure(t, x+6, y, z);
+ // temp64[6] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp64[7] = temp63[0];  // for pressure(t, x+8, y, z);
+ // Get 1 element(s) from temp63 and 7 from temp49.
+ real_vec_align<1>(temp64, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 1), z).
+ real_vec_t temp65 = temp21[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 1), z).
+ real_vec_t temp66 = temp23[z];
+
+ // temp67 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)).
+ real_vec_t temp67 = temp60 + ((temp62 + temp64 + temp65 + temp66 + temp48 + temp50) * temp4);
+
+ // Construct unaligned vector starting at pressure(t, (x - 2), y, z).
+ real_vec_t temp68;
+ // temp68[0] = temp61[6];  // for pressure(t, x-2, y, z);
+ // temp68[1] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp68[2] = temp49[0];  // for pressure(t, x, y, z);
+ // temp68[3] = temp49[1];  // for pressure(t, x+1, y, z);
+ // temp68[4] = temp49[2];  // for pressure(t, x+2, y, z);
+ // temp68[5] = temp49[3];  // for pressure(t, x+3, y, z);
+ // temp68[6] = temp49[4];  // for pressure(t, x+4, y, z);
+ // temp68[7] = temp49[5];  // for pressure(t, x+5, y, z);
+ // Get 6 element(s) from temp49 and 2 from temp61.
+ real_vec_align<6>(temp68, temp49, temp61);
+
+ // Construct unaligned vector starting at pressure(t, (x + 2), y, z).
+ real_vec_t temp69;
+ // temp69[0] = temp49[2];  // for pressure(t, x+2, y, z);
+ // temp69[1] = temp49[3];  // for pressure(t, x+3, y, z);
+ // temp69[2] = temp49[4];  // for pressure(t, x+4, y, z);
+ // temp69[3] = temp49[5];  // for pressure(t, x+5, y, z);
+ // temp69[4] = temp49[6];  // for pressure(t, x+6, y, z);
+ // temp69[5] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp69[6] = temp63[0];  // for pressure(t, x+8, y, z);
+ // temp69[7] = temp63[1];  // for pressure(t, x+9, y, z);
+ // Get 2 element(s) from temp63 and 6 from temp49.
+ real_vec_align<2>(temp69, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 2), z).
+ real_vec_t temp70 = temp20[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 2), z).
+ real_vec_t temp71 = temp24[z];
+
+ // temp72 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)).
+ real_vec_t temp72 = temp67 + ((temp68 + temp69 + temp70 + temp71 + temp47 + temp51) * temp5);
+
+ // Construct unaligned vector starting at pressure(t, (x - 3), y, z).
+ real_vec_t temp73;
+ // temp73[0] = temp61[5];  // for pressure(t, x-3, y, z);
+ // temp73[1] = temp61[6];  // for pressure(t, x-2, y, z);
+ // temp73[2] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp73[3] = temp49[0];  // for pressure(t, x, y, z);
+ // temp73[4] = temp49[1];  // for pressure(t, x+1, y, z);
+ // temp73[5] = temp49[2];  // for pressure(t, x+2, y, z);
+ // temp73[6] = temp49[3];  // for pressure(t, x+3, y, z);
+ // temp73[7] = temp49[4];  // for pressure(t, x+4, y, z);
+ // Get 5 element(s) from temp49 and 3 from temp61.
+ real_vec_align<5>(temp73, temp49, temp61);
+
+ // Construct unaligned vector starting at pressure(t, (x + 3), y, z).
+ real_vec_t temp74;
+ // temp74[0] = temp49[3];  // for pressure(t, x+3, y, z);
+ // temp74[1] = temp49[4];  // for pressure(t, x+4, y, z);
+ // temp74[2] = temp49[5];  // for pressure(t, x+5, y, z);
+ // temp74[3] = temp49[6];  // for pressure(t, x+6, y, z);
+ // temp74[4] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp74[5] = temp63[0];  // for pressure(t, x+8, y, z);
+ // temp74[6] = temp63[1];  // for pressure(t, x+9, y, z);
+ // temp74[7] = temp63[2];  // for pressure(t, x+10, y, z);
+ // Get 3 element(s) from temp63 and 5 from temp49.
+ real_vec_align<3>(temp74, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 3), z).
+ real_vec_t temp75 = temp19[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 3), z).
+ real_vec_t temp76 = temp25[z];
+
+ // temp77 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)).
+ real_vec_t temp77 = temp72 + ((temp73 + temp74 + temp75 + temp76 + temp46 + temp52) * temp6);
+
+ // Construct unaligned vector starting at pressure(t, (x - 4), y, z).
+ real_vec_t temp78;
+ // temp78[0] = temp61[4];  // for pressure(t, x-4, y, z);
+ // temp78[1] = temp61[5];  // for pressure(t, x-3, y, z);
+ // temp78[2] = temp61[6];  // for pressure(t, x-2, y, z);
+ // temp78[3] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp78[4] = temp49[0];  // for pressure(t, x, y, z);
+ // temp78[5] = temp49[1];  // for pressure(t, x+1, y, z);
+ // temp78[6] = temp49[2];  // for pressure(t, x+2, y, z);
+ // temp78[7] = temp49[3];  // for pressure(t, x+3, y, z);
+ // Get 4 element(s) from temp49 and 4 from temp61.
+ real_vec_align<4>(temp78, temp49, temp61);
+
+ // Construct unaligned vector starting at pressure(t, (x + 4), y, z).
+ real_vec_t temp79;
+ // temp79[0] = temp49[4];  // for pressure(t, x+4, y, z);
+ // temp79[1] = temp49[5];  // for pressure(t, x+5, y, z);
+ // temp79[2] = temp49[6];  // for pressure(t, x+6, y, z);
+ // temp79[3] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp79[4] = temp63[0];  // for pressure(t, x+8, y, z);
+ // temp79[5] = temp63[1];  // for pressure(t, x+9, y, z);
+ // temp79[6] = temp63[2];  // for pressure(t, x+10, y, z);
+ // temp79[7] = temp63[3];  // for pressure(t, x+11, y, z);
+ // Get 4 element(s) from temp63 and 4 from temp49.
+ real_vec_align<4>(temp79, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 4), z).
+ real_vec_t temp80 = temp18[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 4), z).
+ real_vec_t temp81 = temp26[z];
+
+ // temp82 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)).
+ real_vec_t temp82 = temp77 + ((temp78 + temp79 + temp80 + temp81 + temp45 + temp53) * temp7);
+
+ // Construct unaligned vector starting at pressure(t, (x - 5), y, z).
+ real_vec_t temp83;
+ // temp83[0] = temp61[3];  // for pressure(t, x-5, y, z);
+ // temp83[1] = temp61[4];  // for pressure(t, x-4, y, z);
+ // temp83[2] = temp61[5];  // for pressure(t, x-3, y, z);
+ // temp83[3] = temp61[6];  // for pressure(t, x-2, y, z);
+ // temp83[4] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp83[5] = temp49[0];  // for pressure(t, x, y, z);
+ // temp83[6] = temp49[1];  // for pressure(t, x+1, y, z);
+ // temp83[7] = temp49[2];  // for pressure(t, x+2, y, z);
+ // Get 3 element(s) from temp49 and 5 from temp61.
+ real_vec_align<3>(temp83, temp49, temp61);
+
+ // Construct unaligned vector starting at pressure(t, (x + 5), y, z).
+ real_vec_t temp84;
+ // temp84[0] = temp49[5];  // for pressure(t, x+5, y, z);
+ // temp84[1] = temp49[6];  // for pressure(t, x+6, y, z);
+ // temp84[2] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp84[3] = temp63[0];  // for pressure(t, x+8, y, z);
+ // temp84[4] = temp63[1];  // for pressure(t, x+9, y, z);
+ // temp84[5] = temp63[2];  // for pressure(t, x+10, y, z);
+ // temp84[6] = temp63[3];  // for pressure(t, x+11, y, z);
+ // temp84[7] = temp63[4];  // for pressure(t, x+12, y, z);
+ // Get 5 element(s) from temp63 and 3 from temp49.
+ real_vec_align<5>(temp84, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 5), z).
+ real_vec_t temp85 = temp17[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 5), z).
+ real_vec_t temp86 = temp27[z];
+
+ // temp87 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)).
+ real_vec_t temp87 = temp82 + ((temp83 + temp84 + temp85 + temp86 + temp44 + temp54) * temp8);
+
+ // Construct unaligned vector starting at pressure(t, (x - 6), y, z).
+ real_vec_t temp88;
+ // temp88[0] = temp61[2];  // for pressure(t, x-6, y, z);
+ // temp88[1] = temp61[3];  // for pressure(t, x-5, y, z);
+ // temp88[2] = temp61[4];  // for pressure(t, x-4, y, z);
+ // temp88[3] = temp61[5];  // for pressure(t, x-3, y, z);
+ // temp88[4] = temp61[6];  // for pressure(t, x-2, y, z);
+ // temp88[5] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp88[6] = temp49[0];  // for pressure(t, x, y, z);
+ // temp88[7] = temp49[1];  // for pressure(t, x+1, y, z);
+ // Get 2 element(s) from temp49 and 6 from temp61.
+ real_vec_align<2>(temp88, temp49, temp61);
+
+ // Construct unaligned vector starting at pressure(t, (x + 6), y, z).
+ real_vec_t temp89;
+ // temp89[0] = temp49[6];  // for pressure(t, x+6, y, z);
+ // temp89[1] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp89[2] = temp63[0];  // for pressure(t, x+8, y, z);
+ // temp89[3] = temp63[1];  // for pressure(t, x+9, y, z);
+ // temp89[4] = temp63[2];  // for pressure(t, x+10, y, z);
+ // temp89[5] = temp63[3];  // for pressure(t, x+11, y, z);
+ // temp89[6] = temp63[4];  // for pressure(t, x+12, y, z);
+ // temp89[7] = temp63[5];  // for pressure(t, x+13, y, z);
+ // Get 6 element(s) from temp63 and 2 from temp49.
+ real_vec_align<6>(temp89, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 6), z).
+ real_vec_t temp90 = temp16[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 6), z).
+ real_vec_t temp91 = temp28[z];
+
+ // temp92 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)).
+ real_vec_t temp92 = temp87 + ((temp88 + temp89 + temp90 + temp91 + temp43 + temp55) * temp9);
+
+ // Construct unaligned vector starting at pressure(t, (x - 7), y, z).
+ real_vec_t temp93;
+ // temp93[0] = temp61[1];  // for pressure(t, x-7, y, z);
+ // temp93[1] = temp61[2];  // for pressure(t, x-6, y, z);
+ // temp93[2] = temp61[3];  // for pressure(t, x-5, y, z);
+ // temp93[3] = temp61[4];  // for pressure(t, x-4, y, z);
+ // temp93[4] = temp61[5];  // for pressure(t, x-3, y, z);
+ // temp93[5] = temp61[6];  // for pressure(t, x-2, y, z);
+ // temp93[6] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp93[7] = temp49[0];  // for pressure(t, x, y, z);
+ // Get 1 element(s) from temp49 and 7 from temp61.
+ real_vec_align<1>(temp93, temp49, temp61);
+
+ // Construct unaligned vector starting at pressure(t, (x + 7), y, z).
+ real_vec_t temp94;
+ // temp94[0] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp94[1] = temp63[0];  // for pressure(t, x+8, y, z);
+ // temp94[2] = temp63[1];  // for pressure(t, x+9, y, z);
+ // temp94[3] = temp63[2];  // for pressure(t, x+10, y, z);
+ // temp94[4] = temp63[3];  // for pressure(t, x+11, y, z);
+ // temp94[5] = temp63[4];  // for pressure(t, x+12, y, z);
+ // temp94[6] = temp63[5];  // for pressure(t, x+13, y, z);
+ // temp94[7] = temp63[6];  // for pressure(t, x+14, y, z);
+ // Get 7 element(s) from temp63 and 1 from temp49.
+ real_vec_align<7>(temp94, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 7), z).
+ real_vec_t temp95 = temp15[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 7), z).
+ real_vec_t temp96 = temp29[z];
+
+ // temp97 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)).
+ real_vec_t temp97 = temp92 + ((temp93 + temp94 + temp95 + temp96 + temp42 + temp56) * temp10);
+
+ // Read aligned vector starting at pressure(t, x, (y - 8), z).
+ real_vec_t temp98 = temp14[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 8), z).
+ real_vec_t temp99 = temp30[z];
+
+ // Read aligned vector starting at pressure(t, x, y, (z + 8)).
+ real_vec_t temp100 = temp22[(z+(8 / VLEN_Z))];
+
+ // temp101 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)) + ((pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8)).
+ real_vec_t temp101 = temp97 + ((temp61 + temp63 + temp98 + temp99 + temp41 + temp100) * temp11);
+
+ // Read aligned vector starting at vel(x, y, z).
+ real_vec_t temp102 = temp33[z];
+
+ // temp103 = ((pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)) + ((pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8))) * vel(x, y, z).
+ real_vec_t temp103 = temp101 * temp102;
+
+ // temp104 = ((2 * pressure(t, x, y, z)) - pressure((t - 1), x, y, z)) + (((pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)) + ((pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8))) * vel(x, y, z)).
+ real_vec_t temp104 = temp59 + temp103;
+
+ // temp105 = (((2 * pressure(t, x, y, z)) - pressure((t - 1), x, y, z)) + (((pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)) + ((pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8))) * vel(x, y, z))).
+ real_vec_t temp105 = temp104;
+
+ // Update value at pressure((t + 1), x, y, z).
+ 
+ // Write aligned vector starting at pressure((t + 1), x, y, z).
+ if (use_nt_stores) temp105.storeTo_nt(temp32+z); else temp105.storeTo_masked(temp32+z, write_mask);
+;
+
+ // Carry vector-blocks to next iteration.
+ temp41 = temp42;
+ temp42 = temp43;
+ temp43 = temp44;
+ temp44 = temp45;
+ temp45 = temp46;
+ temp46 = temp47;
+ temp47 = temp48;
+ temp48 = temp49;
+ temp49 = temp50;
+ temp50 = temp51;
+ temp51 = temp52;
+ temp52 = temp53;
+ temp53 = temp54;
+ temp54 = temp55;
+ temp55 = temp56;
+ temp56 = temp100;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp12[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp13[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp14[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp15[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp16[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp17[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp18[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp19[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp20[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp21[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(8 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(8 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp22[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp23[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp24[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp25[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp26[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp27[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp28[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp29[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp30[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp31[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp32[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp33[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp12[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp13[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp14[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp15[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp16[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp17[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp18[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp19[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp20[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp21[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(8 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(8 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp22[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp23[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp24[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp25[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp26[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp27[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp28[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp29[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp30[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp31[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp32[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp33[z + ofs]);
+ }
+#endif // L2 prefetch.
+ } // 'z' loop.
+ } // Forced-inline block.
+} // calc_loop_of_vectors.
+
+ // Calculate a series of clusters iterating in +'z' direction from t, x, y, z indices in 'idxs' to 'stop_z'.
+ // Each cluster calculates 'x=8 * y=1 * z=2' point(s) containing 2 'x=8 * y=1 * z=1' vector(s).
+ // Indices must be rank-relative (not global).
+ // Indices must be normalized, i.e., already divided by VLEN_*.
+ // SIMD calculations use 86 vector block(s) created from 58 aligned vector-block(s).
+ // There are approximately 976 FP operation(s) per iteration.
+ void calc_loop_of_clusters(int thread_idx, const Indices& idxs, idx_t stop_z) {
+
+ // Extract individual indices.
+ idx_t t = idxs[0];
+ idx_t x = idxs[1];
+ idx_t y = idxs[2];
+ idx_t z = idxs[3];
+ idx_t start_z = z;
+ idx_t step_z = CMULT_Z; // number of vectors per iter.
+ idx_t step_z_elem = CMULT_Z * VLEN_Z; // number of elements per iter.
+ idx_t write_mask = idx_t(-1); // no masking for clusters.
+ bool use_nt_stores = _context->use_nt_stores(); // streaming stores need whole vectors.
+ auto& opts = _context->get_settings();
+ const int pfd_l1 = opts->_prefetch_L1_dist; // prefetch distances.
+ const int pfd_l2 = opts->_prefetch_L2_dist;
+ const int pfh_l1 = opts->_prefetch_L1_hint; // prefetch hints.
+ const int pfh_l2 = opts->_prefetch_L2_hint;
+
+ // Element indices derived from vector indices.
+ idx_t x_elem = _context->rank_domain_offsets[0] + (x * VLEN_X);
+ idx_t y_elem = _context->rank_domain_offsets[1] + (y * VLEN_Y);
+ idx_t z_elem = _context->rank_domain_offsets[2] + (z * VLEN_Z);
+
+ // Force inlining if possible.
+#if !defined(DEBUG) && defined(__INTEL_COMPILER)
+#pragma forceinline recursive
+#endif
+ {
+ auto temp1 = static_cast<_context_type::coeff_type*>(_context->coeff);
+ auto temp2 = 0;
+
+ // temp3 = coeff(0).
+ real_vec_t temp3 = temp1->YkElemGrid::readElem({0}, temp2,__LINE__);
+
+ // temp4 = coeff(1).
+ real_vec_t temp4 = temp1->YkElemGrid::readElem({1}, temp2,__LINE__);
+
+ // temp5 = coeff(2).
+ real_vec_t temp5 = temp1->YkElemGrid::readElem({2}, temp2,__LINE__);
+
+ // temp6 = coeff(3).
+ real_vec_t temp6 = temp1->YkElemGrid::readElem({3}, temp2,__LINE__);
+
+ // temp7 = coeff(4).
+ real_vec_t temp7 = temp1->YkElemGrid::readElem({4}, temp2,__LINE__);
+
+ // temp8 = coeff(5).
+ real_vec_t temp8 = temp1->YkElemGrid::readElem({5}, temp2,__LINE__);
+
+ // temp9 = coeff(6).
+ real_vec_t temp9 = temp1->YkElemGrid::readElem({6}, temp2,__LINE__);
+
+ // temp10 = coeff(7).
+ real_vec_t temp10 = temp1->YkElemGrid::readElem({7}, temp2,__LINE__);
+
+ // temp11 = coeff(8).
+ real_vec_t temp11 = temp1->YkElemGrid::readElem({8}, temp2,__LINE__);
+
+ // Calculate pointer to  vector starting at pressure((t - 1), x, y, 0).
+ auto temp34 = static_cast<_context_type::pressure_type*>(_context->pressure);
+ auto temp35 = temp34->_wrap_step((t - 1));
+ real_vec_t* temp12 = temp34->getVecPtrNorm({(t - 1), x, y, 0} ,temp35, false);
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp12[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp12[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, (x - 8), y, 0).
+ auto temp36 = temp34->_wrap_step(t);
+ real_vec_t* temp13 = temp34->getVecPtrNorm({t, (x-(8 / VLEN_X)), y, 0} ,temp36, false);
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp13[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp13[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Distance in vectors between 'pressure' vectors one apart in 'x'.
+ idx_t temp37 = temp34->getVecPtrNorm({t, x, y, 0} ,temp36, false) - temp13;
+
+ // Distance in vectors between 'pressure' vectors one apart in 'y'.
+ idx_t temp38 = temp34->getVecPtrNorm({t, (x-(8 / VLEN_X)), (y+(1 / VLEN_Y)), 0} ,temp36, false) - temp13;
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 8), 0).
+ real_vec_t* temp14 = temp13 +(8 / VLEN_X) * temp37 -(8 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp14[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp14[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 7), 0).
+ real_vec_t* temp15 = temp13 +(8 / VLEN_X) * temp37 -(7 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp15[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp15[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 6), 0).
+ real_vec_t* temp16 = temp13 +(8 / VLEN_X) * temp37 -(6 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp16[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp16[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 5), 0).
+ real_vec_t* temp17 = temp13 +(8 / VLEN_X) * temp37 -(5 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp17[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp17[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 4), 0).
+ real_vec_t* temp18 = temp13 +(8 / VLEN_X) * temp37 -(4 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp18[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp18[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 3), 0).
+ real_vec_t* temp19 = temp13 +(8 / VLEN_X) * temp37 -(3 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp19[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp19[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 2), 0).
+ real_vec_t* temp20 = temp13 +(8 / VLEN_X) * temp37 -(2 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp20[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp20[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y - 1), 0).
+ real_vec_t* temp21 = temp13 +(8 / VLEN_X) * temp37 -(1 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp21[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp21[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, y, 0).
+ real_vec_t* temp22 = temp13 +(8 / VLEN_X) * temp37;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = -(8 / VLEN_Z); ofs < (pfd_l1*CMULT_Z)+(9 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp22[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = -(8 / VLEN_Z); ofs < (pfd_l2*CMULT_Z)+(9 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp22[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 1), 0).
+ real_vec_t* temp23 = temp13 +(8 / VLEN_X) * temp37 +(1 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp23[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp23[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 2), 0).
+ real_vec_t* temp24 = temp13 +(8 / VLEN_X) * temp37 +(2 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp24[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp24[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 3), 0).
+ real_vec_t* temp25 = temp13 +(8 / VLEN_X) * temp37 +(3 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp25[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp25[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 4), 0).
+ real_vec_t* temp26 = temp13 +(8 / VLEN_X) * temp37 +(4 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp26[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp26[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 5), 0).
+ real_vec_t* temp27 = temp13 +(8 / VLEN_X) * temp37 +(5 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp27[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp27[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 6), 0).
+ real_vec_t* temp28 = temp13 +(8 / VLEN_X) * temp37 +(6 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp28[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp28[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 7), 0).
+ real_vec_t* temp29 = temp13 +(8 / VLEN_X) * temp37 +(7 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp29[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp29[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, x, (y + 8), 0).
+ real_vec_t* temp30 = temp13 +(8 / VLEN_X) * temp37 +(8 / VLEN_Y) * temp38;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp30[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp30[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure(t, (x + 8), y, 0).
+ real_vec_t* temp31 = temp13 +(16 / VLEN_X) * temp37;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp31[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp31[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // Calculate pointer to  vector starting at pressure((t + 1), x, y, 0).
+ auto temp39 = temp34->_wrap_step((t + 1));
+ real_vec_t* temp32 = temp34->getVecPtrNorm({(t + 1), x, y, 0} ,temp39, false);
+
+ // Calculate pointer to  vector starting at vel(x, y, 0).
+ auto temp40 = static_cast<_context_type::vel_type*>(_context->vel);
+ real_vec_t* temp33 = temp40->getVecPtrNorm({x, y, 0} ,temp2, false);
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp33[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = 0; ofs < (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp33[z + ofs]);
+ }
+#endif // L2 prefetch.
+
+ // 16 aligned vector-block(s) carried in registers across 'z' iterations.
+ real_vec_t temp41;
+ real_vec_t temp42;
+ real_vec_t temp43;
+ real_vec_t temp44;
+ real_vec_t temp45;
+ real_vec_t temp46;
+ real_vec_t temp47;
+ real_vec_t temp48;
+ real_vec_t temp49;
+ real_vec_t temp50;
+ real_vec_t temp51;
+ real_vec_t temp52;
+ real_vec_t temp53;
+ real_vec_t temp54;
+ real_vec_t temp55;
+ real_vec_t temp56;
+ if (z < stop_z) {
+
+ // Read carried vector starting at pressure(t, x, y, (z - 8)).
+ temp41 = temp22[(z-(8 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 7)).
+ temp42 = temp22[(z-(7 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 6)).
+ temp43 = temp22[(z-(6 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 5)).
+ temp44 = temp22[(z-(5 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 4)).
+ temp45 = temp22[(z-(4 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 3)).
+ temp46 = temp22[(z-(3 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 2)).
+ temp47 = temp22[(z-(2 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z - 1)).
+ temp48 = temp22[(z-(1 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, z).
+ temp49 = temp22[z];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 1)).
+ temp50 = temp22[(z+(1 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 2)).
+ temp51 = temp22[(z+(2 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 3)).
+ temp52 = temp22[(z+(3 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 4)).
+ temp53 = temp22[(z+(4 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 5)).
+ temp54 = temp22[(z+(5 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 6)).
+ temp55 = temp22[(z+(6 / VLEN_Z))];
+
+ // Read carried vector starting at pressure(t, x, y, (z + 7)).
+ temp56 = temp22[(z+(7 / VLEN_Z))];
+ }
+
+ // Inner loop.
+ for (idx_t z = start_z; z < stop_z; z += step_z, z_elem += step_z_elem) {
+
+ // Read aligned vector starting at pressure((t - 1), x, y, z).
+ real_vec_t temp57 = temp12[z];
+
+ // temp58 = 2 * pressure(t, x, y, z).
+ real_vec_t temp58 = 2.000000000000000e+00 * temp49;
+
+ // temp59 = ((2 * pressure(t, x, y, z)) - pressure((t - 1), x, y, z)).
+ real_vec_t temp59 = temp58 - temp57;
+
+ // temp60 = pressure(t, x, y, z) * coeff(0).
+ real_vec_t temp60 = temp49 * temp3;
+
+ // Read aligned vector starting at pressure(t, (x - 8), y, z).
+ real_vec_t temp61 = temp13[z];
+
+ // Construct unaligned vector starting at pressure(t, (x - 1), y, z).
+ real_vec_t temp62;
+ // temp62[0] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp62[1] = temp49[0];  // for pressure(t, x, y, z);
+ // temp62[2] = temp49[1];  // for pressure(t, x+1, y, z);
+ // temp62[3] = temp49[2];  // for pressure(t, x+2, y, z);
+ // temp62[4] = temp49[3];  // for pressure(t, x+3, y, z);
+ // temp62[5] = temp49[4];  // for pressure(t, x+4, y, z);
+ // temp62[6] = temp49[5];  // for pressure(t, x+5, y, z);
+ // temp62[7] = temp49[6];  // for pressure(t, x+6, y, z);
+ // Get 7 element(s) from temp49 and 1 from temp61.
+ real_vec_align<7>(temp62, temp49, temp61);
+
+ // Read aligned vector starting at pressure(t, (x + 8), y, z).
+ real_vec_t temp63 = temp31[z];
+
+ // Construct unaligned vector starting at pressure(t, (x + 1), y, z).
+ real_vec_t temp64;
+ // temp64[0] = temp49[1];  // for pressure(t, x+1, y, z);
+ // temp64[1] = temp49[2];  // for pressure(t, x+2, y, z);
+ // temp64[2] = temp49[3];  // for pressure(t, x+3, y, z);
+ // temp64[3] = temp49[4];  // for pressure(t, x+4, y, z);
+ // temp64[4] = temp49[5];  // for pressure(t, x+5, y, z);
+ // temp64[5] = temp49[6];  // for pressure(t, x+6, y, z);
+ // temp64[6] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp64[7] = temp63[0];  // for pressure(t, x+8, y, z);
+ // Get 1 element(s) from temp63 and 7 from temp49.
+ real_vec_align<1>(temp64, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 1), z).
+ real_vec_t temp65 = temp21[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 1), z).
+ real_vec_t temp66 = temp23[z];
+
+ // temp67 = pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z).
+ real_vec_t temp67 = temp62 + temp64;
+
+ // temp68 = pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z).
+ real_vec_t temp68 = temp67 + temp65;
+
+ // temp69 = pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z).
+ real_vec_t temp69 = temp68 + temp66;
+
+ // temp70 = pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)).
+ real_vec_t temp70 = temp69 + temp48;
+
+ // temp71 = pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1)).
+ real_vec_t temp71 = temp70 + temp50;
+
+ // temp72 = (pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1).
+ real_vec_t temp72 = temp71 * temp4;
+
+ // temp73 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)).
+ real_vec_t temp73 = temp60 + temp72;
+
+ // Construct unaligned vector starting at pressure(t, (x - 2), y, z).
+ real_vec_t temp74;
+ // temp74[0] = temp61[6];  // for pressure(t, x-2, y, z);
+ // temp74[1] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp74[2] = temp49[0];  // for pressure(t, x, y, z);
+ // temp74[3] = temp49[1];  // for pressure(t, x+1, y, z);
+ // temp74[4] = temp49[2];  // for pressure(t, x+2, y, z);
+ // temp74[5] = temp49[3];  // for pressure(t, x+3, y, z);
+ // temp74[6] = temp49[4];  // for pressure(t, x+4, y, z);
+ // temp74[7] = temp49[5];  // for pressure(t, x+5, y, z);
+ // Get 6 element(s) from temp49 and 2 from temp61.
+ real_vec_align<6>(temp74, temp49, temp61);
+
+ // Construct unaligned vector starting at pressure(t, (x + 2), y, z).
+ real_vec_t temp75;
+ // temp75[0] = temp49[2];  // for pressure(t, x+2, y, z);
+ // temp75[1] = temp49[3];  // for pressure(t, x+3, y, z);
+ // temp75[2] = temp49[4];  // for pressure(t, x+4, y, z);
+ // temp75[3] = temp49[5];  // for pressure(t, x+5, y, z);
+ // temp75[4] = temp49[6];  // for pressure(t, x+6, y, z);
+ // temp75[5] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp75[6] = temp63[0];  // for pressure(t, x+8, y, z);
+ // temp75[7] = temp63[1];  // for pressure(t, x+9, y, z);
+ // Get 2 element(s) from temp63 and 6 from temp49.
+ real_vec_align<2>(temp75, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 2), z).
+ real_vec_t temp76 = temp20[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 2), z).
+ real_vec_t temp77 = temp24[z];
+
+ // temp78 = pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z).
+ real_vec_t temp78 = temp74 + temp75;
+
+ // temp79 = pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z).
+ real_vec_t temp79 = temp78 + temp76;
+
+ // temp80 = pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z).
+ real_vec_t temp80 = temp79 + temp77;
+
+ // temp81 = pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)).
+ real_vec_t temp81 = temp80 + temp47;
+
+ // temp82 = pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2)).
+ real_vec_t temp82 = temp81 + temp51;
+
+ // temp83 = (pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2).
+ real_vec_t temp83 = temp82 * temp5;
+
+ // temp84 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)).
+ real_vec_t temp84 = temp73 + temp83;
+
+ // Construct unaligned vector starting at pressure(t, (x - 3), y, z).
+ real_vec_t temp85;
+ // temp85[0] = temp61[5];  // for pressure(t, x-3, y, z);
+ // temp85[1] = temp61[6];  // for pressure(t, x-2, y, z);
+ // temp85[2] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp85[3] = temp49[0];  // for pressure(t, x, y, z);
+ // temp85[4] = temp49[1];  // for pressure(t, x+1, y, z);
+ // temp85[5] = temp49[2];  // for pressure(t, x+2, y, z);
+ // temp85[6] = temp49[3];  // for pressure(t, x+3, y, z);
+ // temp85[7] = temp49[4];  // for pressure(t, x+4, y, z);
+ // Get 5 element(s) from temp49 and 3 from temp61.
+ real_vec_align<5>(temp85, temp49, temp61);
+
+ // Construct unaligned vector starting at pressure(t, (x + 3), y, z).
+ real_vec_t temp86;
+ // temp86[0] = temp49[3];  // for pressure(t, x+3, y, z);
+ // temp86[1] = temp49[4];  // for pressure(t, x+4, y, z);
+ // temp86[2] = temp49[5];  // for pressure(t, x+5, y, z);
+ // temp86[3] = temp49[6];  // for pressure(t, x+6, y, z);
+ // temp86[4] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp86[5] = temp63[0];  // for pressure(t, x+8, y, z);
+ // temp86[6] = temp63[1];  // for pressure(t, x+9, y, z);
+ // temp86[7] = temp63[2];  // for pressure(t, x+10, y, z);
+ // Get 3 element(s) from temp63 and 5 from temp49.
+ real_vec_align<3>(temp86, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 3), z).
+ real_vec_t temp87 = temp19[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 3), z).
+ real_vec_t temp88 = temp25[z];
+
+ // temp89 = pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z).
+ real_vec_t temp89 = temp85 + temp86;
+
+ // temp90 = pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z).
+ real_vec_t temp90 = temp89 + temp87;
+
+ // temp91 = pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z).
+ real_vec_t temp91 = temp90 + temp88;
+
+ // temp92 = pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)).
+ real_vec_t temp92 = temp91 + temp46;
+
+ // temp93 = pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3)).
+ real_vec_t temp93 = temp92 + temp52;
+
+ // temp94 = (pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3).
+ real_vec_t temp94 = temp93 * temp6;
+
+ // temp95 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)).
+ real_vec_t temp95 = temp84 + temp94;
+
+ // Construct unaligned vector starting at pressure(t, (x - 4), y, z).
+ real_vec_t temp96;
+ // temp96[0] = temp61[4];  // for pressure(t, x-4, y, z);
+ // temp96[1] = temp61[5];  // for pressure(t, x-3, y, z);
+ // temp96[2] = temp61[6];  // for pressure(t, x-2, y, z);
+ // temp96[3] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp96[4] = temp49[0];  // for pressure(t, x, y, z);
+ // temp96[5] = temp49[1];  // for pressure(t, x+1, y, z);
+ // temp96[6] = temp49[2];  // for pressure(t, x+2, y, z);
+ // temp96[7] = temp49[3];  // for pressure(t, x+3, y, z);
+ // Get 4 element(s) from temp49 and 4 from temp61.
+ real_vec_align<4>(temp96, temp49, temp61);
+
+ // Construct unaligned vector starting at pressure(t, (x + 4), y, z).
+ real_vec_t temp97;
+ // temp97[0] = temp49[4];  // for pressure(t, x+4, y, z);
+ // temp97[1] = temp49[5];  // for pressure(t, x+5, y, z);
+ // temp97[2] = temp49[6];  // for pressure(t, x+6, y, z);
+ // temp97[3] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp97[4] = temp63[0];  // for pressure(t, x+8, y, z);
+ // temp97[5] = temp63[1];  // for pressure(t, x+9, y, z);
+ // temp97[6] = temp63[2];  // for pressure(t, x+10, y, z);
+ // temp97[7] = temp63[3];  // for pressure(t, x+11, y, z);
+ // Get 4 element(s) from temp63 and 4 from temp49.
+ real_vec_align<4>(temp97, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 4), z).
+ real_vec_t temp98 = temp18[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 4), z).
+ real_vec_t temp99 = temp26[z];
+
+ // temp100 = pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z).
+ real_vec_t temp100 = temp96 + temp97;
+
+ // temp101 = pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z).
+ real_vec_t temp101 = temp100 + temp98;
+
+ // temp102 = pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z).
+ real_vec_t temp102 = temp101 + temp99;
+
+ // temp103 = pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)).
+ real_vec_t temp103 = temp102 + temp45;
+
+ // temp104 = pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4)).
+ real_vec_t temp104 = temp103 + temp53;
+
+ // temp105 = (pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4).
+ real_vec_t temp105 = temp104 * temp7;
+
+ // temp106 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)).
+ real_vec_t temp106 = temp95 + temp105;
+
+ // Construct unaligned vector starting at pressure(t, (x - 5), y, z).
+ real_vec_t temp107;
+ // temp107[0] = temp61[3];  // for pressure(t, x-5, y, z);
+ // temp107[1] = temp61[4];  // for pressure(t, x-4, y, z);
+ // temp107[2] = temp61[5];  // for pressure(t, x-3, y, z);
+ // temp107[3] = temp61[6];  // for pressure(t, x-2, y, z);
+ // temp107[4] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp107[5] = temp49[0];  // for pressure(t, x, y, z);
+ // temp107[6] = temp49[1];  // for pressure(t, x+1, y, z);
+ // temp107[7] = temp49[2];  // for pressure(t, x+2, y, z);
+ // Get 3 element(s) from temp49 and 5 from temp61.
+ real_vec_align<3>(temp107, temp49, temp61);
+
+ // Construct unaligned vector starting at pressure(t, (x + 5), y, z).
+ real_vec_t temp108;
+ // temp108[0] = temp49[5];  // for pressure(t, x+5, y, z);
+ // temp108[1] = temp49[6];  // for pressure(t, x+6, y, z);
+ // temp108[2] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp108[3] = temp63[0];  // for pressure(t, x+8, y, z);
+ // temp108[4] = temp63[1];  // for pressure(t, x+9, y, z);
+ // temp108[5] = temp63[2];  // for pressure(t, x+10, y, z);
+ // temp108[6] = temp63[3];  // for pressure(t, x+11, y, z);
+ // temp108[7] = temp63[4];  // for pressure(t, x+12, y, z);
+ // Get 5 element(s) from temp63 and 3 from temp49.
+ real_vec_align<5>(temp108, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 5), z).
+ real_vec_t temp109 = temp17[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 5), z).
+ real_vec_t temp110 = temp27[z];
+
+ // temp111 = pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z).
+ real_vec_t temp111 = temp107 + temp108;
+
+ // temp112 = pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z).
+ real_vec_t temp112 = temp111 + temp109;
+
+ // temp113 = pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z).
+ real_vec_t temp113 = temp112 + temp110;
+
+ // temp114 = pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)).
+ real_vec_t temp114 = temp113 + temp44;
+
+ // temp115 = pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5)).
+ real_vec_t temp115 = temp114 + temp54;
+
+ // temp116 = (pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5).
+ real_vec_t temp116 = temp115 * temp8;
+
+ // temp117 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)).
+ real_vec_t temp117 = temp106 + temp116;
+
+ // Construct unaligned vector starting at pressure(t, (x - 6), y, z).
+ real_vec_t temp118;
+ // temp118[0] = temp61[2];  // for pressure(t, x-6, y, z);
+ // temp118[1] = temp61[3];  // for pressure(t, x-5, y, z);
+ // temp118[2] = temp61[4];  // for pressure(t, x-4, y, z);
+ // temp118[3] = temp61[5];  // for pressure(t, x-3, y, z);
+ // temp118[4] = temp61[6];  // for pressure(t, x-2, y, z);
+ // temp118[5] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp118[6] = temp49[0];  // for pressure(t, x, y, z);
+ // temp118[7] = temp49[1];  // for pressure(t, x+1, y, z);
+ // Get 2 element(s) from temp49 and 6 from temp61.
+ real_vec_align<2>(temp118, temp49, temp61);
+
+ // Construct unaligned vector starting at pressure(t, (x + 6), y, z).
+ real_vec_t temp119;
+ // temp119[0] = temp49[6];  // for pressure(t, x+6, y, z);
+ // temp119[1] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp119[2] = temp63[0];  // for pressure(t, x+8, y, z);
+ // temp119[3] = temp63[1];  // for pressure(t, x+9, y, z);
+ // temp119[4] = temp63[2];  // for pressure(t, x+10, y, z);
+ // temp119[5] = temp63[3];  // for pressure(t, x+11, y, z);
+ // temp119[6] = temp63[4];  // for pressure(t, x+12, y, z);
+ // temp119[7] = temp63[5];  // for pressure(t, x+13, y, z);
+ // Get 6 element(s) from temp63 and 2 from temp49.
+ real_vec_align<6>(temp119, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 6), z).
+ real_vec_t temp120 = temp16[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 6), z).
+ real_vec_t temp121 = temp28[z];
+
+ // temp122 = pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z).
+ real_vec_t temp122 = temp118 + temp119;
+
+ // temp123 = pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z).
+ real_vec_t temp123 = temp122 + temp120;
+
+ // temp124 = pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z).
+ real_vec_t temp124 = temp123 + temp121;
+
+ // temp125 = pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)).
+ real_vec_t temp125 = temp124 + temp43;
+
+ // temp126 = pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6)).
+ real_vec_t temp126 = temp125 + temp55;
+
+ // temp127 = (pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6).
+ real_vec_t temp127 = temp126 * temp9;
+
+ // temp128 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)).
+ real_vec_t temp128 = temp117 + temp127;
+
+ // Construct unaligned vector starting at pressure(t, (x - 7), y, z).
+ real_vec_t temp129;
+ // temp129[0] = temp61[1];  // for pressure(t, x-7, y, z);
+ // temp129[1] = temp61[2];  // for pressure(t, x-6, y, z);
+ // temp129[2] = temp61[3];  // for pressure(t, x-5, y, z);
+ // temp129[3] = temp61[4];  // for pressure(t, x-4, y, z);
+ // temp129[4] = temp61[5];  // for pressure(t, x-3, y, z);
+ // temp129[5] = temp61[6];  // for pressure(t, x-2, y, z);
+ // temp129[6] = temp61[7];  // for pressure(t, x-1, y, z);
+ // temp129[7] = temp49[0];  // for pressure(t, x, y, z);
+ // Get 1 element(s) from temp49 and 7 from temp61.
+ real_vec_align<1>(temp129, temp49, temp61);
+
+ // Construct unaligned vector starting at pressure(t, (x + 7), y, z).
+ real_vec_t temp130;
+ // temp130[0] = temp49[7];  // for pressure(t, x+7, y, z);
+ // temp130[1] = temp63[0];  // for pressure(t, x+8, y, z);
+ // temp130[2] = temp63[1];  // for pressure(t, x+9, y, z);
+ // temp130[3] = temp63[2];  // for pressure(t, x+10, y, z);
+ // temp130[4] = temp63[3];  // for pressure(t, x+11, y, z);
+ // temp130[5] = temp63[4];  // for pressure(t, x+12, y, z);
+ // temp130[6] = temp63[5];  // for pressure(t, x+13, y, z);
+ // temp130[7] = temp63[6];  // for pressure(t, x+14, y, z);
+ // Get 7 element(s) from temp63 and 1 from temp49.
+ real_vec_align<7>(temp130, temp63, temp49);
+
+ // Read aligned vector starting at pressure(t, x, (y - 7), z).
+ real_vec_t temp131 = temp15[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 7), z).
+ real_vec_t temp132 = temp29[z];
+
+ // temp133 = pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z).
+ real_vec_t temp133 = temp129 + temp130;
+
+ // temp134 = pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z).
+ real_vec_t temp134 = temp133 + temp131;
+
+ // temp135 = pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z).
+ real_vec_t temp135 = temp134 + temp132;
+
+ // temp136 = pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)).
+ real_vec_t temp136 = temp135 + temp42;
+
+ // temp137 = pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7)).
+ real_vec_t temp137 = temp136 + temp56;
+
+ // temp138 = (pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7).
+ real_vec_t temp138 = temp137 * temp10;
+
+ // temp139 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)).
+ real_vec_t temp139 = temp128 + temp138;
+
+ // Read aligned vector starting at pressure(t, x, (y - 8), z).
+ real_vec_t temp140 = temp14[z];
+
+ // Read aligned vector starting at pressure(t, x, (y + 8), z).
+ real_vec_t temp141 = temp30[z];
+
+ // Read aligned vector starting at pressure(t, x, y, (z + 8)).
+ real_vec_t temp142 = temp22[(z+(8 / VLEN_Z))];
+
+ // temp143 = pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z).
+ real_vec_t temp143 = temp61 + temp63;
+
+ // temp144 = pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z).
+ real_vec_t temp144 = temp143 + temp140;
+
+ // temp145 = pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z).
+ real_vec_t temp145 = temp144 + temp141;
+
+ // temp146 = pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)).
+ real_vec_t temp146 = temp145 + temp41;
+
+ // temp147 = pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8)).
+ real_vec_t temp147 = temp146 + temp142;
+
+ // temp148 = (pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8).
+ real_vec_t temp148 = temp147 * temp11;
+
+ // temp149 = (pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)) + ((pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8)).
+ real_vec_t temp149 = temp139 + temp148;
+
+ // Read aligned vector starting at vel(x, y, z).
+ real_vec_t temp150 = temp33[z];
+
+ // temp151 = ((pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)) + ((pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8))) * vel(x, y, z).
+ real_vec_t temp151 = temp149 * temp150;
+
+ // temp152 = ((2 * pressure(t, x, y, z)) - pressure((t - 1), x, y, z)) + (((pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)) + ((pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8))) * vel(x, y, z)).
+ real_vec_t temp152 = temp59 + temp151;
+
+ // temp153 = (((2 * pressure(t, x, y, z)) - pressure((t - 1), x, y, z)) + (((pressure(t, x, y, z) * coeff(0)) + ((pressure(t, (x - 1), y, z) + pressure(t, (x + 1), y, z) + pressure(t, x, (y - 1), z) + pressure(t, x, (y + 1), z) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 1))) * coeff(1)) + ((pressure(t, (x - 2), y, z) + pressure(t, (x + 2), y, z) + pressure(t, x, (y - 2), z) + pressure(t, x, (y + 2), z) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 2))) * coeff(2)) + ((pressure(t, (x - 3), y, z) + pressure(t, (x + 3), y, z) + pressure(t, x, (y - 3), z) + pressure(t, x, (y + 3), z) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 3))) * coeff(3)) + ((pressure(t, (x - 4), y, z) + pressure(t, (x + 4), y, z) + pressure(t, x, (y - 4), z) + pressure(t, x, (y + 4), z) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 4))) * coeff(4)) + ((pressure(t, (x - 5), y, z) + pressure(t, (x + 5), y, z) + pressure(t, x, (y - 5), z) + pressure(t, x, (y + 5), z) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 5))) * coeff(5)) + ((pressure(t, (x - 6), y, z) + pressure(t, (x + 6), y, z) + pressure(t, x, (y - 6), z) + pressure(t, x, (y + 6), z) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 6))) * coeff(6)) + ((pressure(t, (x - 7), y, z) + pressure(t, (x + 7), y, z) + pressure(t, x, (y - 7), z) + pressure(t, x, (y + 7), z) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 7))) * coeff(7)) + ((pressure(t, (x - 8), y, z) + pressure(t, (x + 8), y, z) + pressure(t, x, (y - 8), z) + pressure(t, x, (y + 8), z) + pressure(t, x, y, (z - 8)) + pressure(t, x, y, (z + 8))) * coeff(8))) * vel(x, y, z))).
+ real_vec_t temp153 = temp152;
+
+ // Update value at pressure((t + 1), x, y, z).
+ 
+ // Write aligned vector starting at pressure((t + 1), x, y, z).
+ if (use_nt_stores) temp153.storeTo_nt(temp32+z); else temp153.storeTo_masked(temp32+z, write_mask);
+;
+
+ // Read aligned vector starting at pressure((t - 1), x, y, (z + 1)).
+ real_vec_t temp154 = temp12[(z+(1 / VLEN_Z))];
+
+ // temp155 = 2 * pressure(t, x, y, (z + 1)).
+ real_vec_t temp155 = 2.000000000000000e+00 * temp50;
+
+ // temp156 = ((2 * pressure(t, x, y, (z + 1))) - pressure((t - 1), x, y, (z + 1))).
+ real_vec_t temp156 = temp155 - temp154;
+
+ // temp157 = pressure(t, x, y, (z + 1)) * coeff(0).
+ real_vec_t temp157 = temp50 * temp3;
+
+ // Read aligned vector starting at pressure(t, (x - 8), y, (z + 1)).
+ real_vec_t temp158 = temp13[(z+(1 / VLEN_Z))];
+
+ // Construct unaligned vector starting at pressure(t, (x - 1), y, (z + 1)).
+ real_vec_t temp159;
+ // temp159[0] = temp158[7];  // for pressure(t, x-1, y, z+1);
+ // temp159[1] = temp50[0];  // for pressure(t, x, y, z+1);
+ // temp159[2] = temp50[1];  // for pressure(t, x+1, y, z+1);
+ // temp159[3] = temp50[2];  // for pressure(t, x+2, y, z+1);
+ // temp159[4] = temp50[3];  // for pressure(t, x+3, y, z+1);
+ // temp159[5] = temp50[4];  // for pressure(t, x+4, y, z+1);
+ // temp159[6] = temp50[5];  // for pressure(t, x+5, y, z+1);
+ // temp159[7] = temp50[6];  // for pressure(t, x+6, y, z+1);
+ // Get 7 element(s) from temp50 and 1 from temp158.
+ real_vec_align<7>(temp159, temp50, temp158);
+
+ // Read aligned vector starting at pressure(t, (x + 8), y, (z + 1)).
+ real_vec_t temp160 = temp31[(z+(1 / VLEN_Z))];
+
+ // Construct unaligned vector starting at pressure(t, (x + 1), y, (z + 1)).
+ real_vec_t temp161;
+ // temp161[0] = temp50[1];  // for pressure(t, x+1, y, z+1);
+ // temp161[1] = temp50[2];  // for pressure(t, x+2, y, z+1);
+ // temp161[2] = temp50[3];  // for pressure(t, x+3, y, z+1);
+ // temp161[3] = temp50[4];  // for pressure(t, x+4, y, z+1);
+ // temp161[4] = temp50[5];  // for pressure(t, x+5, y, z+1);
+ // temp161[5] = temp50[6];  // for pressure(t, x+6, y, z+1);
+ // temp161[6] = temp50[7];  // for pressure(t, x+7, y, z+1);
+ // temp161[7] = temp160[0];  // for pressure(t, x+8, y, z+1);
+ // Get 1 element(s) from temp160 and 7 from temp50.
+ real_vec_align<1>(temp161, temp160, temp50);
+
+ // Read aligned vector starting at pressure(t, x, (y - 1), (z + 1)).
+ real_vec_t temp162 = temp21[(z+(1 / VLEN_Z))];
+
+ // Read aligned vector starting at pressure(t, x, (y + 1), (z + 1)).
+ real_vec_t temp163 = temp23[(z+(1 / VLEN_Z))];
+
+ // temp164 = pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)).
+ real_vec_t temp164 = temp159 + temp161;
+
+ // temp165 = pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)).
+ real_vec_t temp165 = temp164 + temp162;
+
+ // temp166 = pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)).
+ real_vec_t temp166 = temp165 + temp163;
+
+ // temp167 = pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z).
+ real_vec_t temp167 = temp166 + temp49;
+
+ // temp168 = pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z) + pressure(t, x, y, (z + 2)).
+ real_vec_t temp168 = temp167 + temp51;
+
+ // temp169 = (pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z) + pressure(t, x, y, (z + 2))) * coeff(1).
+ real_vec_t temp169 = temp168 * temp4;
+
+ // temp170 = (pressure(t, x, y, (z + 1)) * coeff(0)) + ((pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z) + pressure(t, x, y, (z + 2))) * coeff(1)).
+ real_vec_t temp170 = temp157 + temp169;
+
+ // Construct unaligned vector starting at pressure(t, (x - 2), y, (z + 1)).
+ real_vec_t temp171;
+ // temp171[0] = temp158[6];  // for pressure(t, x-2, y, z+1);
+ // temp171[1] = temp158[7];  // for pressure(t, x-1, y, z+1);
+ // temp171[2] = temp50[0];  // for pressure(t, x, y, z+1);
+ // temp171[3] = temp50[1];  // for pressure(t, x+1, y, z+1);
+ // temp171[4] = temp50[2];  // for pressure(t, x+2, y, z+1);
+ // temp171[5] = temp50[3];  // for pressure(t, x+3, y, z+1);
+ // temp171[6] = temp50[4];  // for pressure(t, x+4, y, z+1);
+ // temp171[7] = temp50[5];  // for pressure(t, x+5, y, z+1);
+ // Get 6 element(s) from temp50 and 2 from temp158.
+ real_vec_align<6>(temp171, temp50, temp158);
+
+ // Construct unaligned vector starting at pressure(t, (x + 2), y, (z + 1)).
+ real_vec_t temp172;
+ // temp172[0] = temp50[2];  // for pressure(t, x+2, y, z+1);
+ // temp172[1] = temp50[3];  // for pressure(t, x+3, y, z+1);
+ // temp172[2] = temp50[4];  // for pressure(t, x+4, y, z+1);
+ // temp172[3] = temp50[5];  // for pressure(t, x+5, y, z+1);
+ // temp172[4] = temp50[6];  // for pressure(t, x+6, y, z+1);
+ // temp172[5] = temp50[7];  // for pressure(t, x+7, y, z+1);
+ // temp172[6] = temp160[0];  // for pressure(t, x+8, y, z+1);
+ // temp172[7] = temp160[1];  // for pressure(t, x+9, y, z+1);
+ // Get 2 element(s) from temp160 and 6 from temp50.
+ real_vec_align<2>(temp172, temp160, temp50);
+
+ // Read aligned vector starting at pressure(t, x, (y - 2), (z + 1)).
+ real_vec_t temp173 = temp20[(z+(1 / VLEN_Z))];
+
+ // Read aligned vector starting at pressure(t, x, (y + 2), (z + 1)).
+ real_vec_t temp174 = temp24[(z+(1 / VLEN_Z))];
+
+ // temp175 = pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)).
+ real_vec_t temp175 = temp171 + temp172;
+
+ // temp176 = pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)).
+ real_vec_t temp176 = temp175 + temp173;
+
+ // temp177 = pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)).
+ real_vec_t temp177 = temp176 + temp174;
+
+ // temp178 = pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)) + pressure(t, x, y, (z - 1)).
+ real_vec_t temp178 = temp177 + temp48;
+
+ // temp179 = pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 3)).
+ real_vec_t temp179 = temp178 + temp52;
+
+ // temp180 = (pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 3))) * coeff(2).
+ real_vec_t temp180 = temp179 * temp5;
+
+ // temp181 = (pressure(t, x, y, (z + 1)) * coeff(0)) + ((pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z) + pressure(t, x, y, (z + 2))) * coeff(1)) + ((pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 3))) * coeff(2)).
+ real_vec_t temp181 = temp170 + temp180;
+
+ // Construct unaligned vector starting at pressure(t, (x - 3), y, (z + 1)).
+ real_vec_t temp182;
+ // temp182[0] = temp158[5];  // for pressure(t, x-3, y, z+1);
+ // temp182[1] = temp158[6];  // for pressure(t, x-2, y, z+1);
+ // temp182[2] = temp158[7];  // for pressure(t, x-1, y, z+1);
+ // temp182[3] = temp50[0];  // for pressure(t, x, y, z+1);
+ // temp182[4] = temp50[1];  // for pressure(t, x+1, y, z+1);
+ // temp182[5] = temp50[2];  // for pressure(t, x+2, y, z+1);
+ // temp182[6] = temp50[3];  // for pressure(t, x+3, y, z+1);
+ // temp182[7] = temp50[4];  // for pressure(t, x+4, y, z+1);
+ // Get 5 element(s) from temp50 and 3 from temp158.
+ real_vec_align<5>(temp182, temp50, temp158);
+
+ // Construct unaligned vector starting at pressure(t, (x + 3), y, (z + 1)).
+ real_vec_t temp183;
+ // temp183[0] = temp50[3];  // for pressure(t, x+3, y, z+1);
+ // temp183[1] = temp50[4];  // for pressure(t, x+4, y, z+1);
+ // temp183[2] = temp50[5];  // for pressure(t, x+5, y, z+1);
+ // temp183[3] = temp50[6];  // for pressure(t, x+6, y, z+1);
+ // temp183[4] = temp50[7];  // for pressure(t, x+7, y, z+1);
+ // temp183[5] = temp160[0];  // for pressure(t, x+8, y, z+1);
+ // temp183[6] = temp160[1];  // for pressure(t, x+9, y, z+1);
+ // temp183[7] = temp160[2];  // for pressure(t, x+10, y, z+1);
+ // Get 3 element(s) from temp160 and 5 from temp50.
+ real_vec_align<3>(temp183, temp160, temp50);
+
+ // Read aligned vector starting at pressure(t, x, (y - 3), (z + 1)).
+ real_vec_t temp184 = temp19[(z+(1 / VLEN_Z))];
+
+ // Read aligned vector starting at pressure(t, x, (y + 3), (z + 1)).
+ real_vec_t temp185 = temp25[(z+(1 / VLEN_Z))];
+
+ // temp186 = pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)).
+ real_vec_t temp186 = temp182 + temp183;
+
+ // temp187 = pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)).
+ real_vec_t temp187 = temp186 + temp184;
+
+ // temp188 = pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)) + pressure(t, x, (y + 3), (z + 1)).
+ real_vec_t temp188 = temp187 + temp185;
+
+ // temp189 = pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)) + pressure(t, x, (y + 3), (z + 1)) + pressure(t, x, y, (z - 2)).
+ real_vec_t temp189 = temp188 + temp47;
+
+ // temp190 = pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)) + pressure(t, x, (y + 3), (z + 1)) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 4)).
+ real_vec_t temp190 = temp189 + temp53;
+
+ // temp191 = (pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)) + pressure(t, x, (y + 3), (z + 1)) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 4))) * coeff(3).
+ real_vec_t temp191 = temp190 * temp6;
+
+ // temp192 = (pressure(t, x, y, (z + 1)) * coeff(0)) + ((pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z) + pressure(t, x, y, (z + 2))) * coeff(1)) + ((pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 3))) * coeff(2)) + ((pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)) + pressure(t, x, (y + 3), (z + 1)) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 4))) * coeff(3)).
+ real_vec_t temp192 = temp181 + temp191;
+
+ // Construct unaligned vector starting at pressure(t, (x - 4), y, (z + 1)).
+ real_vec_t temp193;
+ // temp193[0] = temp158[4];  // for pressure(t, x-4, y, z+1);
+ // temp193[1] = temp158[5];  // for pressure(t, x-3, y, z+1);
+ // temp193[2] = temp158[6];  // for pressure(t, x-2, y, z+1);
+ // temp193[3] = temp158[7];  // for pressure(t, x-1, y, z+1);
+ // temp193[4] = temp50[0];  // for pressure(t, x, y, z+1);
+ // temp193[5] = temp50[1];  // for pressure(t, x+1, y, z+1);
+ // temp193[6] = temp50[2];  // for pressure(t, x+2, y, z+1);
+ // temp193[7] = temp50[3];  // for pressure(t, x+3, y, z+1);
+ // Get 4 element(s) from temp50 and 4 from temp158.
+ real_vec_align<4>(temp193, temp50, temp158);
+
+ // Construct unaligned vector starting at pressure(t, (x + 4), y, (z + 1)).
+ real_vec_t temp194;
+ // temp194[0] = temp50[4];  // for pressure(t, x+4, y, z+1);
+ // temp194[1] = temp50[5];  // for pressure(t, x+5, y, z+1);
+ // temp194[2] = temp50[6];  // for pressure(t, x+6, y, z+1);
+ // temp194[3] = temp50[7];  // for pressure(t, x+7, y, z+1);
+ // temp194[4] = temp160[0];  // for pressure(t, x+8, y, z+1);
+ // temp194[5] = temp160[1];  // for pressure(t, x+9, y, z+1);
+ // temp194[6] = temp160[2];  // for pressure(t, x+10, y, z+1);
+ // temp194[7] = temp160[3];  // for pressure(t, x+11, y, z+1);
+ // Get 4 element(s) from temp160 and 4 from temp50.
+ real_vec_align<4>(temp194, temp160, temp50);
+
+ // Read aligned vector starting at pressure(t, x, (y - 4), (z + 1)).
+ real_vec_t temp195 = temp18[(z+(1 / VLEN_Z))];
+
+ // Read aligned vector starting at pressure(t, x, (y + 4), (z + 1)).
+ real_vec_t temp196 = temp26[(z+(1 / VLEN_Z))];
+
+ // temp197 = pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)).
+ real_vec_t temp197 = temp193 + temp194;
+
+ // temp198 = pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)) + pressure(t, x, (y - 4), (z + 1)).
+ real_vec_t temp198 = temp197 + temp195;
+
+ // temp199 = pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)) + pressure(t, x, (y - 4), (z + 1)) + pressure(t, x, (y + 4), (z + 1)).
+ real_vec_t temp199 = temp198 + temp196;
+
+ // temp200 = pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)) + pressure(t, x, (y - 4), (z + 1)) + pressure(t, x, (y + 4), (z + 1)) + pressure(t, x, y, (z - 3)).
+ real_vec_t temp200 = temp199 + temp46;
+
+ // temp201 = pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)) + pressure(t, x, (y - 4), (z + 1)) + pressure(t, x, (y + 4), (z + 1)) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 5)).
+ real_vec_t temp201 = temp200 + temp54;
+
+ // temp202 = (pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)) + pressure(t, x, (y - 4), (z + 1)) + pressure(t, x, (y + 4), (z + 1)) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 5))) * coeff(4).
+ real_vec_t temp202 = temp201 * temp7;
+
+ // temp203 = (pressure(t, x, y, (z + 1)) * coeff(0)) + ((pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z) + pressure(t, x, y, (z + 2))) * coeff(1)) + ((pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 3))) * coeff(2)) + ((pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)) + pressure(t, x, (y + 3), (z + 1)) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 4))) * coeff(3)) + ((pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)) + pressure(t, x, (y - 4), (z + 1)) + pressure(t, x, (y + 4), (z + 1)) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 5))) * coeff(4)).
+ real_vec_t temp203 = temp192 + temp202;
+
+ // Construct unaligned vector starting at pressure(t, (x - 5), y, (z + 1)).
+ real_vec_t temp204;
+ // temp204[0] = temp158[3];  // for pressure(t, x-5, y, z+1);
+ // temp204[1] = temp158[4];  // for pressure(t, x-4, y, z+1);
+ // temp204[2] = temp158[5];  // for pressure(t, x-3, y, z+1);
+ // temp204[3] = temp158[6];  // for pressure(t, x-2, y, z+1);
+ // temp204[4] = temp158[7];  // for pressure(t, x-1, y, z+1);
+ // temp204[5] = temp50[0];  // for pressure(t, x, y, z+1);
+ // temp204[6] = temp50[1];  // for pressure(t, x+1, y, z+1);
+ // temp204[7] = temp50[2];  // for pressure(t, x+2, y, z+1);
+ // Get 3 element(s) from temp50 and 5 from temp158.
+ real_vec_align<3>(temp204, temp50, temp158);
+
+ // Construct unaligned vector starting at pressure(t, (x + 5), y, (z + 1)).
+ real_vec_t temp205;
+ // temp205[0] = temp50[5];  // for pressure(t, x+5, y, z+1);
+ // temp205[1] = temp50[6];  // for pressure(t, x+6, y, z+1);
+ // temp205[2] = temp50[7];  // for pressure(t, x+7, y, z+1);
+ // temp205[3] = temp160[0];  // for pressure(t, x+8, y, z+1);
+ // temp205[4] = temp160[1];  // for pressure(t, x+9, y, z+1);
+ // temp205[5] = temp160[2];  // for pressure(t, x+10, y, z+1);
+ // temp205[6] = temp160[3];  // for pressure(t, x+11, y, z+1);
+ // temp205[7] = temp160[4];  // for pressure(t, x+12, y, z+1);
+ // Get 5 element(s) from temp160 and 3 from temp50.
+ real_vec_align<5>(temp205, temp160, temp50);
+
+ // Read aligned vector starting at pressure(t, x, (y - 5), (z + 1)).
+ real_vec_t temp206 = temp17[(z+(1 / VLEN_Z))];
+
+ // Read aligned vector starting at pressure(t, x, (y + 5), (z + 1)).
+ real_vec_t temp207 = temp27[(z+(1 / VLEN_Z))];
+
+ // temp208 = pressure(t, (x - 5), y, (z + 1)) + pressure(t, (x + 5), y, (z + 1)).
+ real_vec_t temp208 = temp204 + temp205;
+
+ // temp209 = pressure(t, (x - 5), y, (z + 1)) + pressure(t, (x + 5), y, (z + 1)) + pressure(t, x, (y - 5), (z + 1)).
+ real_vec_t temp209 = temp208 + temp206;
+
+ // temp210 = pressure(t, (x - 5), y, (z + 1)) + pressure(t, (x + 5), y, (z + 1)) + pressure(t, x, (y - 5), (z + 1)) + pressure(t, x, (y + 5), (z + 1)).
+ real_vec_t temp210 = temp209 + temp207;
+
+ // temp211 = pressure(t, (x - 5), y, (z + 1)) + pressure(t, (x + 5), y, (z + 1)) + pressure(t, x, (y - 5), (z + 1)) + pressure(t, x, (y + 5), (z + 1)) + pressure(t, x, y, (z - 4)).
+ real_vec_t temp211 = temp210 + temp45;
+
+ // temp212 = pressure(t, (x - 5), y, (z + 1)) + pressure(t, (x + 5), y, (z + 1)) + pressure(t, x, (y - 5), (z + 1)) + pressure(t, x, (y + 5), (z + 1)) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 6)).
+ real_vec_t temp212 = temp211 + temp55;
+
+ // temp213 = (pressure(t, (x - 5), y, (z + 1)) + pressure(t, (x + 5), y, (z + 1)) + pressure(t, x, (y - 5), (z + 1)) + pressure(t, x, (y + 5), (z + 1)) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 6))) * coeff(5).
+ real_vec_t temp213 = temp212 * temp8;
+
+ // temp214 = (pressure(t, x, y, (z + 1)) * coeff(0)) + ((pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z) + pressure(t, x, y, (z + 2))) * coeff(1)) + ((pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 3))) * coeff(2)) + ((pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)) + pressure(t, x, (y + 3), (z + 1)) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 4))) * coeff(3)) + ((pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)) + pressure(t, x, (y - 4), (z + 1)) + pressure(t, x, (y + 4), (z + 1)) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 5))) * coeff(4)) + ((pressure(t, (x - 5), y, (z + 1)) + pressure(t, (x + 5), y, (z + 1)) + pressure(t, x, (y - 5), (z + 1)) + pressure(t, x, (y + 5), (z + 1)) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 6))) * coeff(5)).
+ real_vec_t temp214 = temp203 + temp213;
+
+ // Construct unaligned vector starting at pressure(t, (x - 6), y, (z + 1)).
+ real_vec_t temp215;
+ // temp215[0] = temp158[2];  // for pressure(t, x-6, y, z+1);
+ // temp215[1] = temp158[3];  // for pressure(t, x-5, y, z+1);
+ // temp215[2] = temp158[4];  // for pressure(t, x-4, y, z+1);
+ // temp215[3] = temp158[5];  // for pressure(t, x-3, y, z+1);
+ // temp215[4] = temp158[6];  // for pressure(t, x-2, y, z+1);
+ // temp215[5] = temp158[7];  // for pressure(t, x-1, y, z+1);
+ // temp215[6] = temp50[0];  // for pressure(t, x, y, z+1);
+ // temp215[7] = temp50[1];  // for pressure(t, x+1, y, z+1);
+ // Get 2 element(s) from temp50 and 6 from temp158.
+ real_vec_align<2>(temp215, temp50, temp158);
+
+ // Construct unaligned vector starting at pressure(t, (x + 6), y, (z + 1)).
+ real_vec_t temp216;
+ // temp216[0] = temp50[6];  // for pressure(t, x+6, y, z+1);
+ // temp216[1] = temp50[7];  // for pressure(t, x+7, y, z+1);
+ // temp216[2] = temp160[0];  // for pressure(t, x+8, y, z+1);
+ // temp216[3] = temp160[1];  // for pressure(t, x+9, y, z+1);
+ // temp216[4] = temp160[2];  // for pressure(t, x+10, y, z+1);
+ // temp216[5] = temp160[3];  // for pressure(t, x+11, y, z+1);
+ // temp216[6] = temp160[4];  // for pressure(t, x+12, y, z+1);
+ // temp216[7] = temp160[5];  // for pressure(t, x+13, y, z+1);
+ // Get 6 element(s) from temp160 and 2 from temp50.
+ real_vec_align<6>(temp216, temp160, temp50);
+
+ // Read aligned vector starting at pressure(t, x, (y - 6), (z + 1)).
+ real_vec_t temp217 = temp16[(z+(1 / VLEN_Z))];
+
+ // Read aligned vector starting at pressure(t, x, (y + 6), (z + 1)).
+ real_vec_t temp218 = temp28[(z+(1 / VLEN_Z))];
+
+ // temp219 = pressure(t, (x - 6), y, (z + 1)) + pressure(t, (x + 6), y, (z + 1)).
+ real_vec_t temp219 = temp215 + temp216;
+
+ // temp220 = pressure(t, (x - 6), y, (z + 1)) + pressure(t, (x + 6), y, (z + 1)) + pressure(t, x, (y - 6), (z + 1)).
+ real_vec_t temp220 = temp219 + temp217;
+
+ // temp221 = pressure(t, (x - 6), y, (z + 1)) + pressure(t, (x + 6), y, (z + 1)) + pressure(t, x, (y - 6), (z + 1)) + pressure(t, x, (y + 6), (z + 1)).
+ real_vec_t temp221 = temp220 + temp218;
+
+ // temp222 = pressure(t, (x - 6), y, (z + 1)) + pressure(t, (x + 6), y, (z + 1)) + pressure(t, x, (y - 6), (z + 1)) + pressure(t, x, (y + 6), (z + 1)) + pressure(t, x, y, (z - 5)).
+ real_vec_t temp222 = temp221 + temp44;
+
+ // temp223 = pressure(t, (x - 6), y, (z + 1)) + pressure(t, (x + 6), y, (z + 1)) + pressure(t, x, (y - 6), (z + 1)) + pressure(t, x, (y + 6), (z + 1)) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 7)).
+ real_vec_t temp223 = temp222 + temp56;
+
+ // temp224 = (pressure(t, (x - 6), y, (z + 1)) + pressure(t, (x + 6), y, (z + 1)) + pressure(t, x, (y - 6), (z + 1)) + pressure(t, x, (y + 6), (z + 1)) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 7))) * coeff(6).
+ real_vec_t temp224 = temp223 * temp9;
+
+ // temp225 = (pressure(t, x, y, (z + 1)) * coeff(0)) + ((pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z) + pressure(t, x, y, (z + 2))) * coeff(1)) + ((pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 3))) * coeff(2)) + ((pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)) + pressure(t, x, (y + 3), (z + 1)) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 4))) * coeff(3)) + ((pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)) + pressure(t, x, (y - 4), (z + 1)) + pressure(t, x, (y + 4), (z + 1)) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 5))) * coeff(4)) + ((pressure(t, (x - 5), y, (z + 1)) + pressure(t, (x + 5), y, (z + 1)) + pressure(t, x, (y - 5), (z + 1)) + pressure(t, x, (y + 5), (z + 1)) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 6))) * coeff(5)) + ((pressure(t, (x - 6), y, (z + 1)) + pressure(t, (x + 6), y, (z + 1)) + pressure(t, x, (y - 6), (z + 1)) + pressure(t, x, (y + 6), (z + 1)) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 7))) * coeff(6)).
+ real_vec_t temp225 = temp214 + temp224;
+
+ // Construct unaligned vector starting at pressure(t, (x - 7), y, (z + 1)).
+ real_vec_t temp226;
+ // temp226[0] = temp158[1];  // for pressure(t, x-7, y, z+1);
+ // temp226[1] = temp158[2];  // for pressure(t, x-6, y, z+1);
+ // temp226[2] = temp158[3];  // for pressure(t, x-5, y, z+1);
+ // temp226[3] = temp158[4];  // for pressure(t, x-4, y, z+1);
+ // temp226[4] = temp158[5];  // for pressure(t, x-3, y, z+1);
+ // temp226[5] = temp158[6];  // for pressure(t, x-2, y, z+1);
+ // temp226[6] = temp158[7];  // for pressure(t, x-1, y, z+1);
+ // temp226[7] = temp50[0];  // for pressure(t, x, y, z+1);
+ // Get 1 element(s) from temp50 and 7 from temp158.
+ real_vec_align<1>(temp226, temp50, temp158);
+
+ // Construct unaligned vector starting at pressure(t, (x + 7), y, (z + 1)).
+ real_vec_t temp227;
+ // temp227[0] = temp50[7];  // for pressure(t, x+7, y, z+1);
+ // temp227[1] = temp160[0];  // for pressure(t, x+8, y, z+1);
+ // temp227[2] = temp160[1];  // for pressure(t, x+9, y, z+1);
+ // temp227[3] = temp160[2];  // for pressure(t, x+10, y, z+1);
+ // temp227[4] = temp160[3];  // for pressure(t, x+11, y, z+1);
+ // temp227[5] = temp160[4];  // for pressure(t, x+12, y, z+1);
+ // temp227[6] = temp160[5];  // for pressure(t, x+13, y, z+1);
+ // temp227[7] = temp160[6];  // for pressure(t, x+14, y, z+1);
+ // Get 7 element(s) from temp160 and 1 from temp50.
+ real_vec_align<7>(temp227, temp160, temp50);
+
+ // Read aligned vector starting at pressure(t, x, (y - 7), (z + 1)).
+ real_vec_t temp228 = temp15[(z+(1 / VLEN_Z))];
+
+ // Read aligned vector starting at pressure(t, x, (y + 7), (z + 1)).
+ real_vec_t temp229 = temp29[(z+(1 / VLEN_Z))];
+
+ // temp230 = pressure(t, (x - 7), y, (z + 1)) + pressure(t, (x + 7), y, (z + 1)).
+ real_vec_t temp230 = temp226 + temp227;
+
+ // temp231 = pressure(t, (x - 7), y, (z + 1)) + pressure(t, (x + 7), y, (z + 1)) + pressure(t, x, (y - 7), (z + 1)).
+ real_vec_t temp231 = temp230 + temp228;
+
+ // temp232 = pressure(t, (x - 7), y, (z + 1)) + pressure(t, (x + 7), y, (z + 1)) + pressure(t, x, (y - 7), (z + 1)) + pressure(t, x, (y + 7), (z + 1)).
+ real_vec_t temp232 = temp231 + temp229;
+
+ // temp233 = pressure(t, (x - 7), y, (z + 1)) + pressure(t, (x + 7), y, (z + 1)) + pressure(t, x, (y - 7), (z + 1)) + pressure(t, x, (y + 7), (z + 1)) + pressure(t, x, y, (z - 6)).
+ real_vec_t temp233 = temp232 + temp43;
+
+ // temp234 = pressure(t, (x - 7), y, (z + 1)) + pressure(t, (x + 7), y, (z + 1)) + pressure(t, x, (y - 7), (z + 1)) + pressure(t, x, (y + 7), (z + 1)) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 8)).
+ real_vec_t temp234 = temp233 + temp142;
+
+ // temp235 = (pressure(t, (x - 7), y, (z + 1)) + pressure(t, (x + 7), y, (z + 1)) + pressure(t, x, (y - 7), (z + 1)) + pressure(t, x, (y + 7), (z + 1)) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 8))) * coeff(7).
+ real_vec_t temp235 = temp234 * temp10;
+
+ // temp236 = (pressure(t, x, y, (z + 1)) * coeff(0)) + ((pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z) + pressure(t, x, y, (z + 2))) * coeff(1)) + ((pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 3))) * coeff(2)) + ((pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)) + pressure(t, x, (y + 3), (z + 1)) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 4))) * coeff(3)) + ((pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)) + pressure(t, x, (y - 4), (z + 1)) + pressure(t, x, (y + 4), (z + 1)) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 5))) * coeff(4)) + ((pressure(t, (x - 5), y, (z + 1)) + pressure(t, (x + 5), y, (z + 1)) + pressure(t, x, (y - 5), (z + 1)) + pressure(t, x, (y + 5), (z + 1)) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 6))) * coeff(5)) + ((pressure(t, (x - 6), y, (z + 1)) + pressure(t, (x + 6), y, (z + 1)) + pressure(t, x, (y - 6), (z + 1)) + pressure(t, x, (y + 6), (z + 1)) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 7))) * coeff(6)) + ((pressure(t, (x - 7), y, (z + 1)) + pressure(t, (x + 7), y, (z + 1)) + pressure(t, x, (y - 7), (z + 1)) + pressure(t, x, (y + 7), (z + 1)) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 8))) * coeff(7)).
+ real_vec_t temp236 = temp225 + temp235;
+
+ // Read aligned vector starting at pressure(t, x, (y - 8), (z + 1)).
+ real_vec_t temp237 = temp14[(z+(1 / VLEN_Z))];
+
+ // Read aligned vector starting at pressure(t, x, (y + 8), (z + 1)).
+ real_vec_t temp238 = temp30[(z+(1 / VLEN_Z))];
+
+ // Read aligned vector starting at pressure(t, x, y, (z + 9)).
+ real_vec_t temp239 = temp22[(z+(9 / VLEN_Z))];
+
+ // temp240 = pressure(t, (x - 8), y, (z + 1)) + pressure(t, (x + 8), y, (z + 1)).
+ real_vec_t temp240 = temp158 + temp160;
+
+ // temp241 = pressure(t, (x - 8), y, (z + 1)) + pressure(t, (x + 8), y, (z + 1)) + pressure(t, x, (y - 8), (z + 1)).
+ real_vec_t temp241 = temp240 + temp237;
+
+ // temp242 = pressure(t, (x - 8), y, (z + 1)) + pressure(t, (x + 8), y, (z + 1)) + pressure(t, x, (y - 8), (z + 1)) + pressure(t, x, (y + 8), (z + 1)).
+ real_vec_t temp242 = temp241 + temp238;
+
+ // temp243 = pressure(t, (x - 8), y, (z + 1)) + pressure(t, (x + 8), y, (z + 1)) + pressure(t, x, (y - 8), (z + 1)) + pressure(t, x, (y + 8), (z + 1)) + pressure(t, x, y, (z - 7)).
+ real_vec_t temp243 = temp242 + temp42;
+
+ // temp244 = pressure(t, (x - 8), y, (z + 1)) + pressure(t, (x + 8), y, (z + 1)) + pressure(t, x, (y - 8), (z + 1)) + pressure(t, x, (y + 8), (z + 1)) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 9)).
+ real_vec_t temp244 = temp243 + temp239;
+
+ // temp245 = (pressure(t, (x - 8), y, (z + 1)) + pressure(t, (x + 8), y, (z + 1)) + pressure(t, x, (y - 8), (z + 1)) + pressure(t, x, (y + 8), (z + 1)) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 9))) * coeff(8).
+ real_vec_t temp245 = temp244 * temp11;
+
+ // temp246 = (pressure(t, x, y, (z + 1)) * coeff(0)) + ((pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z) + pressure(t, x, y, (z + 2))) * coeff(1)) + ((pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 3))) * coeff(2)) + ((pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)) + pressure(t, x, (y + 3), (z + 1)) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 4))) * coeff(3)) + ((pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)) + pressure(t, x, (y - 4), (z + 1)) + pressure(t, x, (y + 4), (z + 1)) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 5))) * coeff(4)) + ((pressure(t, (x - 5), y, (z + 1)) + pressure(t, (x + 5), y, (z + 1)) + pressure(t, x, (y - 5), (z + 1)) + pressure(t, x, (y + 5), (z + 1)) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 6))) * coeff(5)) + ((pressure(t, (x - 6), y, (z + 1)) + pressure(t, (x + 6), y, (z + 1)) + pressure(t, x, (y - 6), (z + 1)) + pressure(t, x, (y + 6), (z + 1)) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 7))) * coeff(6)) + ((pressure(t, (x - 7), y, (z + 1)) + pressure(t, (x + 7), y, (z + 1)) + pressure(t, x, (y - 7), (z + 1)) + pressure(t, x, (y + 7), (z + 1)) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 8))) * coeff(7)) + ((pressure(t, (x - 8), y, (z + 1)) + pressure(t, (x + 8), y, (z + 1)) + pressure(t, x, (y - 8), (z + 1)) + pressure(t, x, (y + 8), (z + 1)) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 9))) * coeff(8)).
+ real_vec_t temp246 = temp236 + temp245;
+
+ // Read aligned vector starting at vel(x, y, (z + 1)).
+ real_vec_t temp247 = temp33[(z+(1 / VLEN_Z))];
+
+ // temp248 = ((pressure(t, x, y, (z + 1)) * coeff(0)) + ((pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z) + pressure(t, x, y, (z + 2))) * coeff(1)) + ((pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 3))) * coeff(2)) + ((pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)) + pressure(t, x, (y + 3), (z + 1)) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 4))) * coeff(3)) + ((pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)) + pressure(t, x, (y - 4), (z + 1)) + pressure(t, x, (y + 4), (z + 1)) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 5))) * coeff(4)) + ((pressure(t, (x - 5), y, (z + 1)) + pressure(t, (x + 5), y, (z + 1)) + pressure(t, x, (y - 5), (z + 1)) + pressure(t, x, (y + 5), (z + 1)) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 6))) * coeff(5)) + ((pressure(t, (x - 6), y, (z + 1)) + pressure(t, (x + 6), y, (z + 1)) + pressure(t, x, (y - 6), (z + 1)) + pressure(t, x, (y + 6), (z + 1)) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 7))) * coeff(6)) + ((pressure(t, (x - 7), y, (z + 1)) + pressure(t, (x + 7), y, (z + 1)) + pressure(t, x, (y - 7), (z + 1)) + pressure(t, x, (y + 7), (z + 1)) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 8))) * coeff(7)) + ((pressure(t, (x - 8), y, (z + 1)) + pressure(t, (x + 8), y, (z + 1)) + pressure(t, x, (y - 8), (z + 1)) + pressure(t, x, (y + 8), (z + 1)) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 9))) * coeff(8))) * vel(x, y, (z + 1)).
+ real_vec_t temp248 = temp246 * temp247;
+
+ // temp249 = ((2 * pressure(t, x, y, (z + 1))) - pressure((t - 1), x, y, (z + 1))) + (((pressure(t, x, y, (z + 1)) * coeff(0)) + ((pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z) + pressure(t, x, y, (z + 2))) * coeff(1)) + ((pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 3))) * coeff(2)) + ((pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)) + pressure(t, x, (y + 3), (z + 1)) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 4))) * coeff(3)) + ((pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)) + pressure(t, x, (y - 4), (z + 1)) + pressure(t, x, (y + 4), (z + 1)) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 5))) * coeff(4)) + ((pressure(t, (x - 5), y, (z + 1)) + pressure(t, (x + 5), y, (z + 1)) + pressure(t, x, (y - 5), (z + 1)) + pressure(t, x, (y + 5), (z + 1)) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 6))) * coeff(5)) + ((pressure(t, (x - 6), y, (z + 1)) + pressure(t, (x + 6), y, (z + 1)) + pressure(t, x, (y - 6), (z + 1)) + pressure(t, x, (y + 6), (z + 1)) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 7))) * coeff(6)) + ((pressure(t, (x - 7), y, (z + 1)) + pressure(t, (x + 7), y, (z + 1)) + pressure(t, x, (y - 7), (z + 1)) + pressure(t, x, (y + 7), (z + 1)) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 8))) * coeff(7)) + ((pressure(t, (x - 8), y, (z + 1)) + pressure(t, (x + 8), y, (z + 1)) + pressure(t, x, (y - 8), (z + 1)) + pressure(t, x, (y + 8), (z + 1)) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 9))) * coeff(8))) * vel(x, y, (z + 1))).
+ real_vec_t temp249 = temp156 + temp248;
+
+ // temp250 = (((2 * pressure(t, x, y, (z + 1))) - pressure((t - 1), x, y, (z + 1))) + (((pressure(t, x, y, (z + 1)) * coeff(0)) + ((pressure(t, (x - 1), y, (z + 1)) + pressure(t, (x + 1), y, (z + 1)) + pressure(t, x, (y - 1), (z + 1)) + pressure(t, x, (y + 1), (z + 1)) + pressure(t, x, y, z) + pressure(t, x, y, (z + 2))) * coeff(1)) + ((pressure(t, (x - 2), y, (z + 1)) + pressure(t, (x + 2), y, (z + 1)) + pressure(t, x, (y - 2), (z + 1)) + pressure(t, x, (y + 2), (z + 1)) + pressure(t, x, y, (z - 1)) + pressure(t, x, y, (z + 3))) * coeff(2)) + ((pressure(t, (x - 3), y, (z + 1)) + pressure(t, (x + 3), y, (z + 1)) + pressure(t, x, (y - 3), (z + 1)) + pressure(t, x, (y + 3), (z + 1)) + pressure(t, x, y, (z - 2)) + pressure(t, x, y, (z + 4))) * coeff(3)) + ((pressure(t, (x - 4), y, (z + 1)) + pressure(t, (x + 4), y, (z + 1)) + pressure(t, x, (y - 4), (z + 1)) + pressure(t, x, (y + 4), (z + 1)) + pressure(t, x, y, (z - 3)) + pressure(t, x, y, (z + 5))) * coeff(4)) + ((pressure(t, (x - 5), y, (z + 1)) + pressure(t, (x + 5), y, (z + 1)) + pressure(t, x, (y - 5), (z + 1)) + pressure(t, x, (y + 5), (z + 1)) + pressure(t, x, y, (z - 4)) + pressure(t, x, y, (z + 6))) * coeff(5)) + ((pressure(t, (x - 6), y, (z + 1)) + pressure(t, (x + 6), y, (z + 1)) + pressure(t, x, (y - 6), (z + 1)) + pressure(t, x, (y + 6), (z + 1)) + pressure(t, x, y, (z - 5)) + pressure(t, x, y, (z + 7))) * coeff(6)) + ((pressure(t, (x - 7), y, (z + 1)) + pressure(t, (x + 7), y, (z + 1)) + pressure(t, x, (y - 7), (z + 1)) + pressure(t, x, (y + 7), (z + 1)) + pressure(t, x, y, (z - 6)) + pressure(t, x, y, (z + 8))) * coeff(7)) + ((pressure(t, (x - 8), y, (z + 1)) + pressure(t, (x + 8), y, (z + 1)) + pressure(t, x, (y - 8), (z + 1)) + pressure(t, x, (y + 8), (z + 1)) + pressure(t, x, y, (z - 7)) + pressure(t, x, y, (z + 9))) * coeff(8))) * vel(x, y, (z + 1)))).
+ real_vec_t temp250 = temp249;
+
+ // Update value at pressure((t + 1), x, y, (z + 1)).
+ 
+ // Write aligned vector starting at pressure((t + 1), x, y, (z + 1)).
+ if (use_nt_stores) temp250.storeTo_nt(temp32+(z+(1 / VLEN_Z))); else temp250.storeTo_masked(temp32+(z+(1 / VLEN_Z)), write_mask);
+;
+
+ // Carry vector-blocks to next iteration.
+ temp41 = temp43;
+ temp42 = temp44;
+ temp43 = temp45;
+ temp44 = temp46;
+ temp45 = temp47;
+ temp46 = temp48;
+ temp47 = temp49;
+ temp48 = temp50;
+ temp49 = temp51;
+ temp50 = temp52;
+ temp51 = temp53;
+ temp52 = temp54;
+ temp53 = temp55;
+ temp54 = temp56;
+ temp55 = temp142;
+ temp56 = temp239;
+
+ // Prefetch to L1 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l1 > 0) {
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp12[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp13[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp14[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp15[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp16[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp17[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp18[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp19[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp20[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp21[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(9 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(9 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp22[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp23[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp24[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp25[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp26[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp27[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp28[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp29[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp30[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp31[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z); ofs < ((pfd_l1+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp32[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l1*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l1+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l1, &temp33[z + ofs]);
+ }
+#endif // L1 prefetch.
+
+ // Prefetch to L2 cache if enabled.
+#ifndef NO_PREFETCH
+ if (pfd_l2 > 0) {
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp12[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp13[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp14[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp15[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp16[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp17[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp18[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp19[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp20[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp21[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(9 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(9 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp22[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp23[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp24[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp25[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp26[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp27[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp28[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp29[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp30[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp31[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z); ofs < ((pfd_l2+1)*CMULT_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp32[z + ofs]);
+#pragma unroll
+  for (int ofs = (pfd_l2*CMULT_Z)+(1 / VLEN_Z); ofs < ((pfd_l2+1)*CMULT_Z)+(1 / VLEN_Z); ofs++)
+   prefetch_rt(pfh_l2, &temp33[z + ofs]);
+ }
+#endif // L2 prefetch.
+ } // 'z' loop.
+ } // Forced-inline block.
+} // calc_loop_of_clusters.
+}; // StencilBundle_stencil_bundle_0.
+
+ ////// Overall stencil-specific context //////
+struct StencilContext_iso3dfd : public StencilContext_iso3dfd_data {
+
+ // Stencil equation-bundles.
+ StencilBundle_stencil_bundle_0 stencil_bundle_0;
+
+ // Constructor.
+ StencilContext_iso3dfd(KernelEnvPtr env, KernelSettingsPtr settings) : StencilContext_iso3dfd_data(env, settings),
+  stencil_bundle_0(this) {
+
+ // Stencil bundles.
+  stBundles.push_back(&stencil_bundle_0);
+
+ // Stencil bundle inter-dependencies.
+
+ // Stencil bundle packs.
+  auto stencil_pack_0 = std::make_shared<BundlePack>("stencil_pack_0");
+  stencil_pack_0->push_back(&stencil_bundle_0);
+  stPacks.push_back(stencil_pack_0);
+ } // Ctor.
+
+  // Create Dims object.
+  static DimsPtr new_dims() {
+    auto p = std::make_shared<Dims>();
+    p->_vec_fold_layout.set_size(0, 8); // 'x'
+    p->_step_dim = "t";
+    p->_inner_dim = "z";
+    p->_domain_dims.addDimBack("x", 0);
+    p->_domain_dims.addDimBack("y", 0);
+    p->_domain_dims.addDimBack("z", 0);
+    p->_stencil_dims.addDimBack("t", 0);
+    p->_stencil_dims.addDimBack("x", 0);
+    p->_stencil_dims.addDimBack("y", 0);
+    p->_stencil_dims.addDimBack("z", 0);
+    p->_misc_dims.addDimBack("r", 0);
+    p->_fold_pts.addDimBack("x", 8);
+    p->_fold_pts.addDimBack("y", 1);
+    p->_fold_pts.addDimBack("z", 1);
+    p->_vec_fold_pts.addDimBack("x", 8);
+    p->_fold_pts.setFirstInner(true);
+    p->_vec_fold_pts.setFirstInner(true);
+    p->_cluster_pts.addDimBack("x", 8);
+    p->_cluster_pts.addDimBack("y", 1);
+    p->_cluster_pts.addDimBack("z", 2);
+    p->_cluster_mults.addDimBack("x", 1);
+    p->_cluster_mults.addDimBack("y", 1);
+    p->_cluster_mults.addDimBack("z", 2);
+    p->_step_dir = 1;
+    return p;
+  }
+}; // StencilContext_iso3dfd
+} // namespace yask.
+#endif // DEFINE_CONTEXT
+
+//End of automatically-generated code.
@@ -0,0 +1,954 @@
+// Automatically generated; do not edit.
+
+#pragma once
+
+ // Layout base class.
+ class Layout {
+
+ protected:
+  Indices _sizes;   // Size of each dimension.
+  Layout(int n, const Indices& sizes) :
+   _sizes(sizes) { _sizes.setNumDims(n); }
+
+ public:
+  Layout(int nsizes) :
+   _sizes(idx_t(0), nsizes) { }
+  virtual ~Layout() { }
+
+  // Access sizes.
+  const Indices& get_sizes() const { return _sizes; }
+  virtual void set_sizes(const Indices& sizes) { _sizes = sizes; }
+  idx_t get_size(int i) const {
+    assert(i >= 0);
+    assert(i < _sizes.getNumDims());
+    return _sizes[i]; 
+  }
+  virtual void set_size(int i, idx_t size) {
+    assert(i >= 0);
+    assert(i < _sizes.getNumDims());
+    _sizes[i] = size; 
+  }
+  virtual int get_num_sizes() const {
+    return _sizes.getNumDims(); 
+  }
+
+  // Product of valid sizes.
+  virtual idx_t get_num_elements() const {
+    idx_t nelems = 1;
+    for (int i = 0; i < _sizes.getNumDims(); i++)
+      nelems *= _sizes[i];
+    return nelems;
+  }
+
+  // Bricks: only used by bricked layouts.
+  virtual bool is_bricked() const { return false; }
+  virtual void set_brick_sizes(const Indices& bsizes) { }
+
+  // Return 1-D offset from n-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const =0;
+
+  // Return n indices based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const =0;
+ };
+
+ // 0-D <-> 1-D layout class.
+ // (Trivial layout.)
+ class Layout_0d : public Layout {
+ public:
+  Layout_0d() : Layout(0) { }
+  Layout_0d(const Indices& sizes) : Layout(0, sizes) { }
+  virtual int get_num_sizes() const final {
+    return 0;
+  }
+
+  // Return 1-D offset from 0-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return 0; 
+  }
+
+  // Return 0 indices based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(idx_t(0), 0);
+    return j;
+  }
+ };
+
+ // n-D <-> 1-D bricked layout class.
+ // The indices are split into bricks of '_elems' sizes. Each brick is
+ // stored contiguously in 'LayoutFn' order, and the bricks themselves
+ // are also stored in 'LayoutFn' order. Brick sizes must be powers of
+ // two; the default of one in every dim gives the same offsets as
+ // 'LayoutFn'.
+ template <typename LayoutFn>
+ class LayoutBrick : public Layout {
+ protected:
+  LayoutFn _tiles;  // Number of bricks in each dimension.
+  LayoutFn _elems;  // Size of each brick.
+  Indices _shifts;  // log2 of brick sizes.
+  Indices _masks;   // Brick sizes - 1.
+  idx_t _bsize = 1; // Elements in one brick.
+
+  // Set number of bricks from sizes, rounding up.
+  void _update_tiles() {
+    Indices nt(_sizes);
+    for (int i = 0; i < _sizes.getNumDims(); i++)
+      nt[i] = (_sizes[i] + _masks[i]) >> _shifts[i];
+    _tiles.set_sizes(nt);
+  }
+
+ public:
+  LayoutBrick() : Layout(LayoutFn().get_num_sizes()),
+   _shifts(idx_t(0), _sizes.getNumDims()),
+   _masks(idx_t(0), _sizes.getNumDims()) {
+   _elems.set_sizes(Indices(idx_t(1), _sizes.getNumDims()));
+   _update_tiles();
+  }
+  LayoutBrick(const Indices& sizes) : LayoutBrick() {
+   set_sizes(sizes);
+  }
+  virtual int get_num_sizes() const final {
+    return _tiles.get_num_sizes();
+  }
+  virtual void set_sizes(const Indices& sizes) {
+    _sizes = sizes;
+    _update_tiles();
+  }
+  virtual void set_size(int i, idx_t size) {
+    Layout::set_size(i, size);
+    _update_tiles();
+  }
+
+  // Access brick sizes.
+  virtual bool is_bricked() const { return true; }
+  const Indices& get_brick_sizes() const { return _elems.get_sizes(); }
+  virtual void set_brick_sizes(const Indices& bsizes) {
+    _bsize = 1;
+    for (int i = 0; i < _sizes.getNumDims(); i++) {
+      idx_t s = 0;
+      while ((idx_t(1) << s) < bsizes[i])
+        s++;
+      assert((idx_t(1) << s) == bsizes[i]);
+      _shifts[i] = s;
+      _masks[i] = bsizes[i] - 1;
+      _bsize *= bsizes[i];
+    }
+    Indices es(bsizes);
+    es.setNumDims(_sizes.getNumDims());
+    _elems.set_sizes(es);
+    _update_tiles();
+  }
+
+  // Number of elements, including unused ones in partial bricks.
+  virtual idx_t get_num_elements() const {
+    return _tiles.get_num_elements() * _bsize;
+  }
+
+  // Return 1-D offset from n-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    const int n = _tiles.get_num_sizes();
+    Indices tj(n), ej(n);
+    for (int i = 0; i < n; i++) {
+      tj[i] = j[i] >> _shifts[i];
+      ej[i] = j[i] & _masks[i];
+    }
+    return _tiles.layout(tj) * _bsize + _elems.layout(ej);
+  }
+
+  // Return n indices based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices tj = _tiles.unlayout(ai / _bsize);
+    Indices ej = _elems.unlayout(ai % _bsize);
+    Indices j(_sizes);
+    for (int i = 0; i < _sizes.getNumDims(); i++)
+      j[i] = (tj[i] << _shifts[i]) + ej[i];
+    return j;
+  }
+ };
+
+
+ // 1-D <-> 1-D layout base class.
+ class Layout_1d : public Layout {
+ public:
+  Layout_1d() : Layout(1) { }
+  Layout_1d(const Indices& sizes) : Layout(1, sizes) { }
+ };
+
+ // 1-D <-> 1-D layout class with dimensions in d1 order,
+ // meaning d1 is stored with unit stride.
+ class Layout_1 : public Layout_1d {
+ public:
+  Layout_1() { }
+  Layout_1(const Indices& sizes) : Layout_1d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 1;
+  }
+
+  // Return 1-D offset from 1-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[0];
+  }
+
+  // Return 1 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[0] = (ai);
+    return j;
+  }
+ };
+
+ // 2-D <-> 1-D layout base class.
+ class Layout_2d : public Layout {
+ public:
+  Layout_2d() : Layout(2) { }
+  Layout_2d(const Indices& sizes) : Layout(2, sizes) { }
+ };
+
+ // 2-D <-> 1-D layout class with dimensions in d1, d2 order,
+ // meaning d2 is stored with unit stride.
+ class Layout_12 : public Layout_2d {
+ public:
+  Layout_12() { }
+  Layout_12(const Indices& sizes) : Layout_2d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 2;
+  }
+
+  // Return 1-D offset from 2-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[0] * _sizes[1] + j[1];
+  }
+
+  // Return 2 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[0] = (ai)/(_sizes[1]); j[1] = (ai) % _sizes[1];
+    return j;
+  }
+ };
+
+ // 2-D <-> 1-D layout class with dimensions in d2, d1 order,
+ // meaning d1 is stored with unit stride.
+ class Layout_21 : public Layout_2d {
+ public:
+  Layout_21() { }
+  Layout_21(const Indices& sizes) : Layout_2d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 2;
+  }
+
+  // Return 1-D offset from 2-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[1] * _sizes[0] + j[0];
+  }
+
+  // Return 2 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[1] = (ai)/(_sizes[0]); j[0] = (ai) % _sizes[0];
+    return j;
+  }
+ };
+
+ // 3-D <-> 1-D layout base class.
+ class Layout_3d : public Layout {
+ public:
+  Layout_3d() : Layout(3) { }
+  Layout_3d(const Indices& sizes) : Layout(3, sizes) { }
+ };
+
+ // 3-D <-> 1-D layout class with dimensions in d1, d2, d3 order,
+ // meaning d3 is stored with unit stride.
+ class Layout_123 : public Layout_3d {
+ public:
+  Layout_123() { }
+  Layout_123(const Indices& sizes) : Layout_3d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 3;
+  }
+
+  // Return 1-D offset from 3-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[0] * _sizes[1] * _sizes[2] + j[1] * _sizes[2] + j[2];
+  }
+
+  // Return 3 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[0] = (ai)/(_sizes[1] * _sizes[2]); j[1] = (ai)/(_sizes[2]) % _sizes[1]; j[2] = (ai) % _sizes[2];
+    return j;
+  }
+ };
+
+ // 3-D <-> 1-D layout class with dimensions in d1, d3, d2 order,
+ // meaning d2 is stored with unit stride.
+ class Layout_132 : public Layout_3d {
+ public:
+  Layout_132() { }
+  Layout_132(const Indices& sizes) : Layout_3d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 3;
+  }
+
+  // Return 1-D offset from 3-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[0] * _sizes[2] * _sizes[1] + j[2] * _sizes[1] + j[1];
+  }
+
+  // Return 3 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[0] = (ai)/(_sizes[2] * _sizes[1]); j[2] = (ai)/(_sizes[1]) % _sizes[2]; j[1] = (ai) % _sizes[1];
+    return j;
+  }
+ };
+
+ // 3-D <-> 1-D layout class with dimensions in d2, d1, d3 order,
+ // meaning d3 is stored with unit stride.
+ class Layout_213 : public Layout_3d {
+ public:
+  Layout_213() { }
+  Layout_213(const Indices& sizes) : Layout_3d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 3;
+  }
+
+  // Return 1-D offset from 3-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[1] * _sizes[0] * _sizes[2] + j[0] * _sizes[2] + j[2];
+  }
+
+  // Return 3 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[1] = (ai)/(_sizes[0] * _sizes[2]); j[0] = (ai)/(_sizes[2]) % _sizes[0]; j[2] = (ai) % _sizes[2];
+    return j;
+  }
+ };
+
+ // 3-D <-> 1-D layout class with dimensions in d2, d3, d1 order,
+ // meaning d1 is stored with unit stride.
+ class Layout_231 : public Layout_3d {
+ public:
+  Layout_231() { }
+  Layout_231(const Indices& sizes) : Layout_3d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 3;
+  }
+
+  // Return 1-D offset from 3-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[1] * _sizes[2] * _sizes[0] + j[2] * _sizes[0] + j[0];
+  }
+
+  // Return 3 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[1] = (ai)/(_sizes[2] * _sizes[0]); j[2] = (ai)/(_sizes[0]) % _sizes[2]; j[0] = (ai) % _sizes[0];
+    return j;
+  }
+ };
+
+ // 3-D <-> 1-D layout class with dimensions in d3, d1, d2 order,
+ // meaning d2 is stored with unit stride.
+ class Layout_312 : public Layout_3d {
+ public:
+  Layout_312() { }
+  Layout_312(const Indices& sizes) : Layout_3d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 3;
+  }
+
+  // Return 1-D offset from 3-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[2] * _sizes[0] * _sizes[1] + j[0] * _sizes[1] + j[1];
+  }
+
+  // Return 3 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[2] = (ai)/(_sizes[0] * _sizes[1]); j[0] = (ai)/(_sizes[1]) % _sizes[0]; j[1] = (ai) % _sizes[1];
+    return j;
+  }
+ };
+
+ // 3-D <-> 1-D layout class with dimensions in d3, d2, d1 order,
+ // meaning d1 is stored with unit stride.
+ class Layout_321 : public Layout_3d {
+ public:
+  Layout_321() { }
+  Layout_321(const Indices& sizes) : Layout_3d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 3;
+  }
+
+  // Return 1-D offset from 3-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[2] * _sizes[1] * _sizes[0] + j[1] * _sizes[0] + j[0];
+  }
+
+  // Return 3 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[2] = (ai)/(_sizes[1] * _sizes[0]); j[1] = (ai)/(_sizes[0]) % _sizes[1]; j[0] = (ai) % _sizes[0];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout base class.
+ class Layout_4d : public Layout {
+ public:
+  Layout_4d() : Layout(4) { }
+  Layout_4d(const Indices& sizes) : Layout(4, sizes) { }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d1, d2, d3, d4 order,
+ // meaning d4 is stored with unit stride.
+ class Layout_1234 : public Layout_4d {
+ public:
+  Layout_1234() { }
+  Layout_1234(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[0] * _sizes[1] * _sizes[2] * _sizes[3] + j[1] * _sizes[2] * _sizes[3] + j[2] * _sizes[3] + j[3];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[0] = (ai)/(_sizes[1] * _sizes[2] * _sizes[3]); j[1] = (ai)/(_sizes[2] * _sizes[3]) % _sizes[1]; j[2] = (ai)/(_sizes[3]) % _sizes[2]; j[3] = (ai) % _sizes[3];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d1, d2, d4, d3 order,
+ // meaning d3 is stored with unit stride.
+ class Layout_1243 : public Layout_4d {
+ public:
+  Layout_1243() { }
+  Layout_1243(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[0] * _sizes[1] * _sizes[3] * _sizes[2] + j[1] * _sizes[3] * _sizes[2] + j[3] * _sizes[2] + j[2];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[0] = (ai)/(_sizes[1] * _sizes[3] * _sizes[2]); j[1] = (ai)/(_sizes[3] * _sizes[2]) % _sizes[1]; j[3] = (ai)/(_sizes[2]) % _sizes[3]; j[2] = (ai) % _sizes[2];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d1, d3, d2, d4 order,
+ // meaning d4 is stored with unit stride.
+ class Layout_1324 : public Layout_4d {
+ public:
+  Layout_1324() { }
+  Layout_1324(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[0] * _sizes[2] * _sizes[1] * _sizes[3] + j[2] * _sizes[1] * _sizes[3] + j[1] * _sizes[3] + j[3];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[0] = (ai)/(_sizes[2] * _sizes[1] * _sizes[3]); j[2] = (ai)/(_sizes[1] * _sizes[3]) % _sizes[2]; j[1] = (ai)/(_sizes[3]) % _sizes[1]; j[3] = (ai) % _sizes[3];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d1, d3, d4, d2 order,
+ // meaning d2 is stored with unit stride.
+ class Layout_1342 : public Layout_4d {
+ public:
+  Layout_1342() { }
+  Layout_1342(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[0] * _sizes[2] * _sizes[3] * _sizes[1] + j[2] * _sizes[3] * _sizes[1] + j[3] * _sizes[1] + j[1];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[0] = (ai)/(_sizes[2] * _sizes[3] * _sizes[1]); j[2] = (ai)/(_sizes[3] * _sizes[1]) % _sizes[2]; j[3] = (ai)/(_sizes[1]) % _sizes[3]; j[1] = (ai) % _sizes[1];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d1, d4, d2, d3 order,
+ // meaning d3 is stored with unit stride.
+ class Layout_1423 : public Layout_4d {
+ public:
+  Layout_1423() { }
+  Layout_1423(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[0] * _sizes[3] * _sizes[1] * _sizes[2] + j[3] * _sizes[1] * _sizes[2] + j[1] * _sizes[2] + j[2];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[0] = (ai)/(_sizes[3] * _sizes[1] * _sizes[2]); j[3] = (ai)/(_sizes[1] * _sizes[2]) % _sizes[3]; j[1] = (ai)/(_sizes[2]) % _sizes[1]; j[2] = (ai) % _sizes[2];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d1, d4, d3, d2 order,
+ // meaning d2 is stored with unit stride.
+ class Layout_1432 : public Layout_4d {
+ public:
+  Layout_1432() { }
+  Layout_1432(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[0] * _sizes[3] * _sizes[2] * _sizes[1] + j[3] * _sizes[2] * _sizes[1] + j[2] * _sizes[1] + j[1];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[0] = (ai)/(_sizes[3] * _sizes[2] * _sizes[1]); j[3] = (ai)/(_sizes[2] * _sizes[1]) % _sizes[3]; j[2] = (ai)/(_sizes[1]) % _sizes[2]; j[1] = (ai) % _sizes[1];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d2, d1, d3, d4 order,
+ // meaning d4 is stored with unit stride.
+ class Layout_2134 : public Layout_4d {
+ public:
+  Layout_2134() { }
+  Layout_2134(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[1] * _sizes[0] * _sizes[2] * _sizes[3] + j[0] * _sizes[2] * _sizes[3] + j[2] * _sizes[3] + j[3];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[1] = (ai)/(_sizes[0] * _sizes[2] * _sizes[3]); j[0] = (ai)/(_sizes[2] * _sizes[3]) % _sizes[0]; j[2] = (ai)/(_sizes[3]) % _sizes[2]; j[3] = (ai) % _sizes[3];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d2, d1, d4, d3 order,
+ // meaning d3 is stored with unit stride.
+ class Layout_2143 : public Layout_4d {
+ public:
+  Layout_2143() { }
+  Layout_2143(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[1] * _sizes[0] * _sizes[3] * _sizes[2] + j[0] * _sizes[3] * _sizes[2] + j[3] * _sizes[2] + j[2];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[1] = (ai)/(_sizes[0] * _sizes[3] * _sizes[2]); j[0] = (ai)/(_sizes[3] * _sizes[2]) % _sizes[0]; j[3] = (ai)/(_sizes[2]) % _sizes[3]; j[2] = (ai) % _sizes[2];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d2, d3, d1, d4 order,
+ // meaning d4 is stored with unit stride.
+ class Layout_2314 : public Layout_4d {
+ public:
+  Layout_2314() { }
+  Layout_2314(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[1] * _sizes[2] * _sizes[0] * _sizes[3] + j[2] * _sizes[0] * _sizes[3] + j[0] * _sizes[3] + j[3];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[1] = (ai)/(_sizes[2] * _sizes[0] * _sizes[3]); j[2] = (ai)/(_sizes[0] * _sizes[3]) % _sizes[2]; j[0] = (ai)/(_sizes[3]) % _sizes[0]; j[3] = (ai) % _sizes[3];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d2, d3, d4, d1 order,
+ // meaning d1 is stored with unit stride.
+ class Layout_2341 : public Layout_4d {
+ public:
+  Layout_2341() { }
+  Layout_2341(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[1] * _sizes[2] * _sizes[3] * _sizes[0] + j[2] * _sizes[3] * _sizes[0] + j[3] * _sizes[0] + j[0];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[1] = (ai)/(_sizes[2] * _sizes[3] * _sizes[0]); j[2] = (ai)/(_sizes[3] * _sizes[0]) % _sizes[2]; j[3] = (ai)/(_sizes[0]) % _sizes[3]; j[0] = (ai) % _sizes[0];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d2, d4, d1, d3 order,
+ // meaning d3 is stored with unit stride.
+ class Layout_2413 : public Layout_4d {
+ public:
+  Layout_2413() { }
+  Layout_2413(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[1] * _sizes[3] * _sizes[0] * _sizes[2] + j[3] * _sizes[0] * _sizes[2] + j[0] * _sizes[2] + j[2];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[1] = (ai)/(_sizes[3] * _sizes[0] * _sizes[2]); j[3] = (ai)/(_sizes[0] * _sizes[2]) % _sizes[3]; j[0] = (ai)/(_sizes[2]) % _sizes[0]; j[2] = (ai) % _sizes[2];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d2, d4, d3, d1 order,
+ // meaning d1 is stored with unit stride.
+ class Layout_2431 : public Layout_4d {
+ public:
+  Layout_2431() { }
+  Layout_2431(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[1] * _sizes[3] * _sizes[2] * _sizes[0] + j[3] * _sizes[2] * _sizes[0] + j[2] * _sizes[0] + j[0];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[1] = (ai)/(_sizes[3] * _sizes[2] * _sizes[0]); j[3] = (ai)/(_sizes[2] * _sizes[0]) % _sizes[3]; j[2] = (ai)/(_sizes[0]) % _sizes[2]; j[0] = (ai) % _sizes[0];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d3, d1, d2, d4 order,
+ // meaning d4 is stored with unit stride.
+ class Layout_3124 : public Layout_4d {
+ public:
+  Layout_3124() { }
+  Layout_3124(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[2] * _sizes[0] * _sizes[1] * _sizes[3] + j[0] * _sizes[1] * _sizes[3] + j[1] * _sizes[3] + j[3];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[2] = (ai)/(_sizes[0] * _sizes[1] * _sizes[3]); j[0] = (ai)/(_sizes[1] * _sizes[3]) % _sizes[0]; j[1] = (ai)/(_sizes[3]) % _sizes[1]; j[3] = (ai) % _sizes[3];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d3, d1, d4, d2 order,
+ // meaning d2 is stored with unit stride.
+ class Layout_3142 : public Layout_4d {
+ public:
+  Layout_3142() { }
+  Layout_3142(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[2] * _sizes[0] * _sizes[3] * _sizes[1] + j[0] * _sizes[3] * _sizes[1] + j[3] * _sizes[1] + j[1];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[2] = (ai)/(_sizes[0] * _sizes[3] * _sizes[1]); j[0] = (ai)/(_sizes[3] * _sizes[1]) % _sizes[0]; j[3] = (ai)/(_sizes[1]) % _sizes[3]; j[1] = (ai) % _sizes[1];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d3, d2, d1, d4 order,
+ // meaning d4 is stored with unit stride.
+ class Layout_3214 : public Layout_4d {
+ public:
+  Layout_3214() { }
+  Layout_3214(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[2] * _sizes[1] * _sizes[0] * _sizes[3] + j[1] * _sizes[0] * _sizes[3] + j[0] * _sizes[3] + j[3];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[2] = (ai)/(_sizes[1] * _sizes[0] * _sizes[3]); j[1] = (ai)/(_sizes[0] * _sizes[3]) % _sizes[1]; j[0] = (ai)/(_sizes[3]) % _sizes[0]; j[3] = (ai) % _sizes[3];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d3, d2, d4, d1 order,
+ // meaning d1 is stored with unit stride.
+ class Layout_3241 : public Layout_4d {
+ public:
+  Layout_3241() { }
+  Layout_3241(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[2] * _sizes[1] * _sizes[3] * _sizes[0] + j[1] * _sizes[3] * _sizes[0] + j[3] * _sizes[0] + j[0];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[2] = (ai)/(_sizes[1] * _sizes[3] * _sizes[0]); j[1] = (ai)/(_sizes[3] * _sizes[0]) % _sizes[1]; j[3] = (ai)/(_sizes[0]) % _sizes[3]; j[0] = (ai) % _sizes[0];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d3, d4, d1, d2 order,
+ // meaning d2 is stored with unit stride.
+ class Layout_3412 : public Layout_4d {
+ public:
+  Layout_3412() { }
+  Layout_3412(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[2] * _sizes[3] * _sizes[0] * _sizes[1] + j[3] * _sizes[0] * _sizes[1] + j[0] * _sizes[1] + j[1];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[2] = (ai)/(_sizes[3] * _sizes[0] * _sizes[1]); j[3] = (ai)/(_sizes[0] * _sizes[1]) % _sizes[3]; j[0] = (ai)/(_sizes[1]) % _sizes[0]; j[1] = (ai) % _sizes[1];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d3, d4, d2, d1 order,
+ // meaning d1 is stored with unit stride.
+ class Layout_3421 : public Layout_4d {
+ public:
+  Layout_3421() { }
+  Layout_3421(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[2] * _sizes[3] * _sizes[1] * _sizes[0] + j[3] * _sizes[1] * _sizes[0] + j[1] * _sizes[0] + j[0];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[2] = (ai)/(_sizes[3] * _sizes[1] * _sizes[0]); j[3] = (ai)/(_sizes[1] * _sizes[0]) % _sizes[3]; j[1] = (ai)/(_sizes[0]) % _sizes[1]; j[0] = (ai) % _sizes[0];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d4, d1, d2, d3 order,
+ // meaning d3 is stored with unit stride.
+ class Layout_4123 : public Layout_4d {
+ public:
+  Layout_4123() { }
+  Layout_4123(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[3] * _sizes[0] * _sizes[1] * _sizes[2] + j[0] * _sizes[1] * _sizes[2] + j[1] * _sizes[2] + j[2];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[3] = (ai)/(_sizes[0] * _sizes[1] * _sizes[2]); j[0] = (ai)/(_sizes[1] * _sizes[2]) % _sizes[0]; j[1] = (ai)/(_sizes[2]) % _sizes[1]; j[2] = (ai) % _sizes[2];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d4, d1, d3, d2 order,
+ // meaning d2 is stored with unit stride.
+ class Layout_4132 : public Layout_4d {
+ public:
+  Layout_4132() { }
+  Layout_4132(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[3] * _sizes[0] * _sizes[2] * _sizes[1] + j[0] * _sizes[2] * _sizes[1] + j[2] * _sizes[1] + j[1];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[3] = (ai)/(_sizes[0] * _sizes[2] * _sizes[1]); j[0] = (ai)/(_sizes[2] * _sizes[1]) % _sizes[0]; j[2] = (ai)/(_sizes[1]) % _sizes[2]; j[1] = (ai) % _sizes[1];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d4, d2, d1, d3 order,
+ // meaning d3 is stored with unit stride.
+ class Layout_4213 : public Layout_4d {
+ public:
+  Layout_4213() { }
+  Layout_4213(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[3] * _sizes[1] * _sizes[0] * _sizes[2] + j[1] * _sizes[0] * _sizes[2] + j[0] * _sizes[2] + j[2];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[3] = (ai)/(_sizes[1] * _sizes[0] * _sizes[2]); j[1] = (ai)/(_sizes[0] * _sizes[2]) % _sizes[1]; j[0] = (ai)/(_sizes[2]) % _sizes[0]; j[2] = (ai) % _sizes[2];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d4, d2, d3, d1 order,
+ // meaning d1 is stored with unit stride.
+ class Layout_4231 : public Layout_4d {
+ public:
+  Layout_4231() { }
+  Layout_4231(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[3] * _sizes[1] * _sizes[2] * _sizes[0] + j[1] * _sizes[2] * _sizes[0] + j[2] * _sizes[0] + j[0];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[3] = (ai)/(_sizes[1] * _sizes[2] * _sizes[0]); j[1] = (ai)/(_sizes[2] * _sizes[0]) % _sizes[1]; j[2] = (ai)/(_sizes[0]) % _sizes[2]; j[0] = (ai) % _sizes[0];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d4, d3, d1, d2 order,
+ // meaning d2 is stored with unit stride.
+ class Layout_4312 : public Layout_4d {
+ public:
+  Layout_4312() { }
+  Layout_4312(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[3] * _sizes[2] * _sizes[0] * _sizes[1] + j[2] * _sizes[0] * _sizes[1] + j[0] * _sizes[1] + j[1];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[3] = (ai)/(_sizes[2] * _sizes[0] * _sizes[1]); j[2] = (ai)/(_sizes[0] * _sizes[1]) % _sizes[2]; j[0] = (ai)/(_sizes[1]) % _sizes[0]; j[1] = (ai) % _sizes[1];
+    return j;
+  }
+ };
+
+ // 4-D <-> 1-D layout class with dimensions in d4, d3, d2, d1 order,
+ // meaning d1 is stored with unit stride.
+ class Layout_4321 : public Layout_4d {
+ public:
+  Layout_4321() { }
+  Layout_4321(const Indices& sizes) : Layout_4d(sizes) { }
+  virtual int get_num_sizes() const final {
+    return 4;
+  }
+
+  // Return 1-D offset from 4-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    return j[3] * _sizes[2] * _sizes[1] * _sizes[0] + j[2] * _sizes[1] * _sizes[0] + j[1] * _sizes[0] + j[0];
+  }
+
+  // Return 4 index(indices) based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices j(_sizes);
+    j[3] = (ai)/(_sizes[2] * _sizes[1] * _sizes[0]); j[2] = (ai)/(_sizes[1] * _sizes[0]) % _sizes[2]; j[1] = (ai)/(_sizes[0]) % _sizes[1]; j[0] = (ai) % _sizes[0];
+    return j;
+  }
+ };
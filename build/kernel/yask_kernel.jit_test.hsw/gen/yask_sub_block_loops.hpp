@@ -0,0 +1,135 @@
+/*
+ * 4-D grid-scanning code.
+ * Generated automatically from the following pseudo-code:
+ *
+ * N = 3;
+ *  loop(1 .. N-2) {  call(calc_inner_loop(thread_idx)); }
+ *
+ */ #ifndef OMP_PRAGMA_PREFIX
+ #define OMP_PRAGMA_PREFIX omp parallel for
+ #endif
+ #ifndef OMP_PRAGMA_SUFFIX
+ #define OMP_PRAGMA_SUFFIX
+ #endif
+
+ // 'ScanIndices norm_sub_block_idxs' must be set before the following code.
+
+ // Select the loop order at run-time.
+ switch (opts->sub_block_loop_order) {
+ default:
+ {
+
+  // Indices for function calls.
+  ScanIndices local_indices(norm_sub_block_idxs);
+
+  // ** Begin scan over dimensions 1, 2. **
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_1 = std::min(norm_sub_block_idxs.align[1], norm_sub_block_idxs.step[1]);
+
+  // Aligned beginning point such that (norm_sub_block_idxs.begin[1] - norm_sub_block_idxs.step[1]) < aligned_begin_1 <= norm_sub_block_idxs.begin[1].
+  const idx_t aligned_begin_1 = yask::round_down_flr(norm_sub_block_idxs.begin[1] - norm_sub_block_idxs.align_ofs[1], adj_align_1) + norm_sub_block_idxs.align_ofs[1];
+
+  // Number of iterations to get from aligned_begin_1 to (but not including) norm_sub_block_idxs.end[1], stepping by norm_sub_block_idxs.step[1]. This value is rounded up because the last iteration may cover fewer than norm_sub_block_idxs.step[1] steps.
+  const idx_t num_iters_1 = yask::ceil_idiv_flr(norm_sub_block_idxs.end[1] - aligned_begin_1, norm_sub_block_idxs.step[1]);
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_2 = std::min(norm_sub_block_idxs.align[2], norm_sub_block_idxs.step[2]);
+
+  // Aligned beginning point such that (norm_sub_block_idxs.begin[2] - norm_sub_block_idxs.step[2]) < aligned_begin_2 <= norm_sub_block_idxs.begin[2].
+  const idx_t aligned_begin_2 = yask::round_down_flr(norm_sub_block_idxs.begin[2] - norm_sub_block_idxs.align_ofs[2], adj_align_2) + norm_sub_block_idxs.align_ofs[2];
+
+  // Number of iterations to get from aligned_begin_2 to (but not including) norm_sub_block_idxs.end[2], stepping by norm_sub_block_idxs.step[2]. This value is rounded up because the last iteration may cover fewer than norm_sub_block_idxs.step[2] steps.
+  const idx_t num_iters_2 = yask::ceil_idiv_flr(norm_sub_block_idxs.end[2] - aligned_begin_2, norm_sub_block_idxs.step[2]);
+
+  // Number of iterations in dimensions 1, 2
+  const idx_t num_iters_1_2 = num_iters_1 * num_iters_2;
+
+  // Inner loop.
+ 
+  for (idx_t loop_index_1_2 = 0; loop_index_1_2 < num_iters_1_2; loop_index_1_2++) {
+
+  // Zero-based, unit-stride index for dimension 1.
+  idx_t index_1 = loop_index_1_2 / num_iters_2;
+
+  // Zero-based, unit-stride index for dimension 2.
+  idx_t index_2 = (loop_index_1_2) % num_iters_2;
+
+  // This value of index_1 covers dimension 1 from start_1 to (but not including) stop_1.
+  idx_t start_1 = std::max(aligned_begin_1 + (index_1 * norm_sub_block_idxs.step[1]), norm_sub_block_idxs.begin[1]);
+  idx_t stop_1 = std::min(aligned_begin_1 + ((index_1+1) * norm_sub_block_idxs.step[1]), norm_sub_block_idxs.end[1]);
+
+  // This value of index_2 covers dimension 2 from start_2 to (but not including) stop_2.
+  idx_t start_2 = std::max(aligned_begin_2 + (index_2 * norm_sub_block_idxs.step[2]), norm_sub_block_idxs.begin[2]);
+  idx_t stop_2 = std::min(aligned_begin_2 + ((index_2+1) * norm_sub_block_idxs.step[2]), norm_sub_block_idxs.end[2]);
+  local_indices.start[1] = start_1;
+  local_indices.stop[1] = stop_1;
+  local_indices.index[1] = index_1;
+  local_indices.start[2] = start_2;
+  local_indices.stop[2] = stop_2;
+  local_indices.index[2] = index_2;
+   calc_inner_loop(thread_idx, local_indices);
+  }
+ }
+ break;
+ case 1:
+ {
+
+  // Indices for function calls.
+  ScanIndices local_indices(norm_sub_block_idxs);
+
+  // ** Begin scan over dimensions 2, 1. **
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_2 = std::min(norm_sub_block_idxs.align[2], norm_sub_block_idxs.step[2]);
+
+  // Aligned beginning point such that (norm_sub_block_idxs.begin[2] - norm_sub_block_idxs.step[2]) < aligned_begin_2 <= norm_sub_block_idxs.begin[2].
+  const idx_t aligned_begin_2 = yask::round_down_flr(norm_sub_block_idxs.begin[2] - norm_sub_block_idxs.align_ofs[2], adj_align_2) + norm_sub_block_idxs.align_ofs[2];
+
+  // Number of iterations to get from aligned_begin_2 to (but not including) norm_sub_block_idxs.end[2], stepping by norm_sub_block_idxs.step[2]. This value is rounded up because the last iteration may cover fewer than norm_sub_block_idxs.step[2] steps.
+  const idx_t num_iters_2 = yask::ceil_idiv_flr(norm_sub_block_idxs.end[2] - aligned_begin_2, norm_sub_block_idxs.step[2]);
+
+  // Alignment must be less than or equal to step size.
+  const idx_t adj_align_1 = std::min(norm_sub_block_idxs.align[1], norm_sub_block_idxs.step[1]);
+
+  // Aligned beginning point such that (norm_sub_block_idxs.begin[1] - norm_sub_block_idxs.step[1]) < aligned_begin_1 <= norm_sub_block_idxs.begin[1].
+  const idx_t aligned_begin_1 = yask::round_down_flr(norm_sub_block_idxs.begin[1] - norm_sub_block_idxs.align_ofs[1], adj_align_1) + norm_sub_block_idxs.align_ofs[1];
+
+  // Number of iterations to get from aligned_begin_1 to (but not including) norm_sub_block_idxs.end[1], stepping by norm_sub_block_idxs.step[1]. This value is rounded up because the last iteration may cover fewer than norm_sub_block_idxs.step[1] steps.
+  const idx_t num_iters_1 = yask::ceil_idiv_flr(norm_sub_block_idxs.end[1] - aligned_begin_1, norm_sub_block_idxs.step[1]);
+
+  // Number of iterations in dimensions 2, 1
+  const idx_t num_iters_2_1 = num_iters_2 * num_iters_1;
+
+  // Inner loop.
+ 
+  for (idx_t loop_index_2_1 = 0; loop_index_2_1 < num_iters_2_1; loop_index_2_1++) {
+
+  // Zero-based, unit-stride index for dimension 2.
+  idx_t index_2 = loop_index_2_1 / num_iters_1;
+
+  // Zero-based, unit-stride index for dimension 1.
+  idx_t index_1 = (loop_index_2_1) % num_iters_1;
+
+  // This value of index_2 covers dimension 2 from start_2 to (but not including) stop_2.
+  idx_t start_2 = std::max(aligned_begin_2 + (index_2 * norm_sub_block_idxs.step[2]), norm_sub_block_idxs.begin[2]);
+  idx_t stop_2 = std::min(aligned_begin_2 + ((index_2+1) * norm_sub_block_idxs.step[2]), norm_sub_block_idxs.end[2]);
+
+  // This value of index_1 covers dimension 1 from start_1 to (but not including) stop_1.
+  idx_t start_1 = std::max(aligned_begin_1 + (index_1 * norm_sub_block_idxs.step[1]), norm_sub_block_idxs.begin[1]);
+  idx_t stop_1 = std::min(aligned_begin_1 + ((index_1+1) * norm_sub_block_idxs.step[1]), norm_sub_block_idxs.end[1]);
+  local_indices.start[2] = start_2;
+  local_indices.stop[2] = stop_2;
+  local_indices.index[2] = index_2;
+  local_indices.start[1] = start_1;
+  local_indices.stop[1] = stop_1;
+  local_indices.index[1] = index_1;
+   calc_inner_loop(thread_idx, local_indices);
+  }
+ }
+ break;
+ }
+ #undef OMP_PRAGMA_PREFIX
+ #undef OMP_PRAGMA_SUFFIX
+
+ // End of generated code.
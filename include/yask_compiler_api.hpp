@@ -114,6 +114,83 @@ namespace yask {
                                                 must be a valid C++ identifier. */ ) const;
     };
 
+    /// Factory for finite-difference coefficients.
+    /**
+       Provides the weights of central finite-difference operators
+       that can be used in stencil equations, e.g., as constants
+       or as initial values of a coefficient grid.
+       All coefficients assume unit grid spacing; divide them by
+       `h^deriv_order` for spacing `h`.
+       Each returned vector contains `2*radius+1` values, one for each
+       offset from `-radius` to `+radius`.
+
+       Wavenumbers are given as a fraction of the Nyquist wavenumber,
+       i.e., a `max_wavenumber` of 1.0 covers all wavelengths down to
+       two points per wavelength.
+       Accuracy is measured as the maximum relative error of the
+       operator's response vs. the exact derivative over the band
+       from zero up to `max_wavenumber`.
+    */
+    class yc_fd_coeff_factory {
+    public:
+        virtual ~yc_fd_coeff_factory() {}
+
+        /// Get the traditional Taylor-series (maximal-order) coefficients.
+        /**
+           Computed with Fornberg's algorithm; these give the highest
+           formal order of accuracy possible for the radius, i.e.,
+           the smallest error at very low wavenumbers.
+           @returns Vector of `2*radius+1` coefficients.
+        */
+        virtual std::vector<double>
+        get_center_coefficients(int deriv_order /**< [in] Order of the derivative: 1 or greater. */,
+                                int radius /**< [in] Number of points on each side of the center. */ ) const;
+
+        /// Get dispersion-optimized coefficients.
+        /**
+           The coefficients minimize the least-squares relative error
+           of the operator over the wavenumber band while still being
+           exact for polynomials up to degree `deriv_order`.
+           Compared to get_center_coefficients(), they trade a lower
+           formal order for a smaller error over the band, which often
+           allows the same accuracy with a smaller radius.
+           @returns Vector of `2*radius+1` coefficients.
+        */
+        virtual std::vector<double>
+        get_optimized_coefficients(int deriv_order /**< [in] Order of the derivative: 1 or greater. */,
+                                   int radius /**< [in] Number of points on each side of the center. */,
+                                   double max_wavenumber /**< [in] Upper end of the band as a
+                                                            fraction of Nyquist: (0, 1]. */ ) const;
+
+        /// Get the accuracy of a set of coefficients.
+        /**
+           @returns Maximum relative error of the operator
+           over the wavenumber band.
+        */
+        virtual double
+        get_max_error(const std::vector<double>& coeffs
+                      /**< [in] Coefficients for offsets `-radius` to `+radius`. */,
+                      int deriv_order /**< [in] Order of the derivative: 1 or greater. */,
+                      double max_wavenumber /**< [in] Upper end of the band as a
+                                               fraction of Nyquist: (0, 1]. */ ) const;
+
+        /// Get the cheapest coefficients that meet an accuracy target.
+        /**
+           Searches radii from the smallest possible one up to `max_radius`
+           and returns the first set of coefficients, either optimized or
+           Taylor, whose get_max_error() is no greater than `max_error`.
+           The radius of the result is `(size() - 1) / 2`.
+           Throws an exception if no radius up to `max_radius` is sufficient.
+           @returns Vector of `2*radius+1` coefficients.
+        */
+        virtual std::vector<double>
+        get_cheapest_coefficients(int deriv_order /**< [in] Order of the derivative: 1 or greater. */,
+                                  double max_wavenumber /**< [in] Upper end of the band as a
+                                                           fraction of Nyquist: (0, 1]. */,
+                                  double max_error /**< [in] Maximum allowed relative error. */,
+                                  int max_radius = 16 /**< [in] Largest radius to consider. */ ) const;
+    };
+
     /// Stencil solution.
     /**
        Objects of this type contain all the grids and equations
@@ -317,6 +394,8 @@ namespace yask {
             avx2    | YASK stencil classes for CORE AVX2 ISA.
             avx512  | YASK stencil classes for CORE AVX-512 & MIC AVX-512 ISAs.
             knc     | YASK stencil classes for Knights Corner ISA.
+            neon    | YASK stencil classes for ARM NEON ISA.
+            sve     | YASK stencil classes for ARM SVE ISA w/512-bit vectors.
             dot     | DOT-language description.
             dot-lite| DOT-language description of grid accesses only.
             pseudo  | Human-readable pseudo-code (for debug).
@@ -438,6 +517,44 @@ namespace yask {
          */
         virtual void
         clear_dependencies() =0;
+
+        /// **[Advanced]** Declare the interior sub-domain of the solution.
+        /**
+           Typically used with absorbing-boundary (PML or sponge) stencils whose
+           damping terms have no effect away from the edges of the domain.
+           Each equation that reads a grid given to set_interior_grid_value()
+           is split into two variants:
+           - An interior variant with condition `interior`, in which the
+           reads of those grids are replaced by their interior values and
+           the resulting constant subexpressions are folded away.
+           - A boundary variant with condition `!interior` and the
+           original expression.
+
+           Any existing condition of the equation is combined with each of these.
+           Only reads at the point being calculated, i.e., with zero offsets in all
+           domain dimensions, are replaced.
+           At run-time, each variant is applied only within its own sub-domain,
+           so the interior is calculated without condition checks or
+           damping terms.
+           Equations are not split when the dependency checker is disabled
+           or in scratch-grid equations.
+        */
+        virtual void
+        set_interior_domain(yc_bool_node_ptr interior
+                            /**< [in] Condition that is true only in the interior.
+                               Use `nullptr` to disable splitting. */) =0;
+
+        /// **[Advanced]** Declare the value of a grid in the interior sub-domain.
+        /**
+           See set_interior_domain().
+           Example: a sponge grid that multiplies the solution everywhere
+           and is 1.0 away from the boundaries.
+         */
+        virtual void
+        set_interior_grid_value(yc_grid_ptr grid
+                                /**< [in] Grid that holds `value` in the interior. */,
+                                double value
+                                /**< [in] Value of every element in the interior. */) =0;
     };
 
     /// A compile-time grid.
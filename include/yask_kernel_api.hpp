@@ -35,6 +35,7 @@ IN THE SOFTWARE.
 #include "yask_common_api.hpp"
 #include <vector>
 #include <cinttypes>
+#include <functional>
 
 namespace yask {
 
@@ -62,6 +63,14 @@ namespace yask {
     /// Shared pointer to \ref yk_stats.
     typedef std::shared_ptr<yk_stats> yk_stats_ptr;
 
+    class yk_reduction;
+    /// Shared pointer to \ref yk_reduction.
+    typedef std::shared_ptr<yk_reduction> yk_reduction_ptr;
+
+    class yk_mem_pool;
+    /// Shared pointer to \ref yk_mem_pool.
+    typedef std::shared_ptr<yk_mem_pool> yk_mem_pool_ptr;
+
     /** @}*/
 } // namespace yask.
 
@@ -98,6 +107,14 @@ namespace yask {
         virtual yk_env_ptr
         new_env() const;
 
+        /// **[Advanced]** Create a pool of memory to be reused by solutions.
+        /**
+           See \ref yk_mem_pool and yk_solution::set_mem_pool().
+           @returns Pointer to new, empty memory pool.
+        */
+        virtual yk_mem_pool_ptr
+        new_mem_pool() const;
+
         /// Create a stencil solution.
         /**
            A stencil solution contains all the grids and equations
@@ -120,6 +137,68 @@ namespace yask {
                      const yk_solution_ptr source
                      /**< [in] Pointer to existing \ref yk_solution from which
                         the settings will be copied. */ ) const;
+
+        /// **[Advanced]** Create a stencil solution by name.
+        /**
+           If `name` is the stencil this library was built for, this is
+           the same as new_solution(yk_env_ptr). Otherwise, the kernel
+           library built for stencil `name` with the same arch is loaded
+           from the directory containing this library, and a solution is
+           created from it. This allows one program to use several
+           stencils, e.g., different propagators or radii, sharing one
+           \ref yk_env.
+           The libraries are built with the usual `stencil` and `arch`
+           variables in the kernel Makefile; to build several at once, use
+           `make stencils="<name> ..." arch=<arch> libs`.
+           Each library remains loaded until the program exits.
+           @returns Pointer to new solution object.
+        */
+        virtual yk_solution_ptr
+        new_named_solution(yk_env_ptr env /**< [in] Pointer to env info. */,
+                           const std::string& name
+                           /**< [in] Value of `stencil` used to build the kernel library,
+                              as returned by get_solution_names(). */ ) const;
+
+        /// **[Advanced]** Get the names of the stencils available to new_named_solution().
+        /**
+           @returns Names of the stencils with kernel libraries for this arch
+           in the directory containing this library, including the stencil
+           this library was built for, in alphabetical order.
+        */
+        virtual std::vector<std::string>
+        get_solution_names() const;
+
+        /// **[Advanced]** Create a stencil solution by compiling stencil code at run-time.
+        /**
+           Builds a new kernel library from `code_file` using the YASK kernel
+           Makefile with the same arch, MPI, and compiler settings as this
+           library, loads it, and creates a solution from it.
+           The stencil-code file is typically created by calling
+           `yc_solution::format()` on a solution defined via the YASK
+           compiler API, using the output format for the target arch.
+           The YASK source tree used to build this library must be available;
+           set the `YASK_KERNEL_DIR` environment variable to use the kernel
+           Makefile from another location.
+           With MPI, the library is built by rank 0 only, so the library
+           directory must be visible to all ranks.
+           The library remains loaded until the program exits.
+           Its file name includes `name` and a hash of the code and
+           `make_args`, so calls with the same `name` and different
+           code get different libraries; a call with the same code
+           and `make_args` reuses the library already loaded.
+           @returns Pointer to new solution object.
+        */
+        virtual yk_solution_ptr
+        new_jit_solution(yk_env_ptr env /**< [in] Pointer to env info. */,
+                         const std::string& code_file
+                         /**< [in] Name of stencil-code file from the YASK compiler. */,
+                         const std::string& name
+                         /**< [in] Name used for the new library; may contain only
+                            letters, digits, and underscores. */,
+                         const std::string& make_args = ""
+                         /**< [in] Additional arguments for `make`, e.g.,
+                            "-j 8 YK_CXXOPT=-O2"; may contain only letters,
+                            digits, spaces, and `_-=+.,:/@%`. */ ) const;
     };
 
     /// Kernel environment.
@@ -148,6 +227,63 @@ namespace yask {
         global_barrier() const =0;
     };
 
+    /// **[Advanced]** Pool of memory reused across solutions.
+    /**
+       When a pool is given to a solution via yk_solution::set_mem_pool(),
+       the memory for its grids, scratch grids and MPI buffers is taken from
+       the pool, and it is returned to the pool instead of to the OS when
+       the solution no longer uses it, e.g., after yk_solution::end_solution()
+       or when the solution is destroyed.
+       A later solution, e.g., for the next shot of a survey, then reuses
+       blocks that are large enough and were allocated with the same NUMA
+       preference and huge-page policy, so their pages are already mapped,
+       placed and faulted in.
+       A block is only reused for a request of at least half its size.
+       Reused memory is not cleared, so all grid elements should be
+       initialized before use, as with new allocations.
+       A pool may be shared by solutions used concurrently from different
+       threads.
+       Blocks held by the pool are freed when the pool and all solutions
+       using it are destroyed or when release_cached() is called.
+       Create a pool with yk_factory::new_mem_pool().
+    */
+    class yk_mem_pool {
+    public:
+        virtual ~yk_mem_pool() {}
+
+        /// Get the size of the memory held by the pool for reuse.
+        /**
+           @returns Number of bytes in blocks not used by any solution.
+        */
+        virtual idx_t
+        get_num_cached_bytes() const =0;
+
+        /// Get the size of the memory from the pool used by solutions.
+        /**
+           @returns Number of bytes in blocks used by solutions.
+        */
+        virtual idx_t
+        get_num_used_bytes() const =0;
+
+        /// Get the number of new blocks allocated from the OS.
+        /**
+           @returns Number of allocations that could not reuse a block.
+        */
+        virtual idx_t
+        get_num_new_allocs() const =0;
+
+        /// Get the number of block reuses.
+        /**
+           @returns Number of allocations satisfied from the pool.
+        */
+        virtual idx_t
+        get_num_reuses() const =0;
+
+        /// Free all blocks that are not currently used by a solution.
+        virtual void
+        release_cached() =0;
+    };
+
     /** @}*/
 } // namespace yask.
 
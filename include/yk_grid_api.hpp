@@ -638,7 +638,8 @@ namespace yask {
 
         /// Determine size of raw storage in elements.
         /**
-           @returns get_num_storage_bytes() / yk_solution.get_element_bytes().
+           @returns get_num_storage_bytes() / yk_solution.get_element_bytes()
+           unless the grid is stored in a 16-bit format.
         */
         virtual idx_t
         get_num_storage_elements() const =0;
@@ -799,6 +800,38 @@ namespace yask {
                              idx_t idx /**< [in] New value for first index.
                                         May be negative. */ ) =0;
 
+        /// **[Advanced]** Set the size of the storage bricks in the specified dimension.
+        /**
+           A grid with a bricked layout stores small n-D bricks of
+           elements contiguously, which reduces the number of pages
+           touched when accessing a block of a grid with deep halos.
+           A bricked layout is selected for a grid via the stencil compiler's
+           '-brick-grids' option; this function sets the shape of its bricks.
+           The size must be a multiple of the vector length in this
+           dimension, and the number of vectors must be a power of two.
+           The default size is one vector, which is the same as the
+           unbricked layout.
+           The brick size cannot be changed after data storage
+           has been allocated for this grid.
+        */
+        virtual void
+        set_brick_size(const std::string& dim
+                       /**< [in] Name of dimension to set.
+                          Must be one of
+                          the names from yk_solution::get_domain_dim_names(). */,
+                       idx_t size /**< [in] Number of elements in each brick. */ ) =0;
+
+        /// **[Advanced]** Get the size of the storage bricks in the specified dimension.
+        /**
+           See set_brick_size().
+           @returns Number of elements in each brick.
+        */
+        virtual idx_t
+        get_brick_size(const std::string& dim
+                       /**< [in] Name of dimension to get.
+                          Must be one of
+                          the names from yk_solution::get_domain_dim_names(). */ ) const =0;
+
         /// **[Advanced]** Get the first accessible index in this grid in this rank in the specified dimension.
         /**
            This returns the first *overall* index allowed in this grid.
@@ -927,11 +960,111 @@ namespace yask {
            the logical indices of any element via raw buffer, e.g., matrix
            multiply.
 
+           If the grid was stored in a 16-bit format by the stencil compiler
+           (see its `-bf16-grids` and `-fp16-grids` options), each element in the
+           buffer is 2 bytes instead of yk_solution::get_element_bytes().
+           This can be detected by comparing get_num_storage_bytes() with
+           get_num_storage_elements().
+
            @returns Pointer to raw data storage if is_storage_allocated()
            returns `true` or NULL otherwise.
         */
         virtual void* get_raw_storage_buffer() =0;
 
+        /// **[Advanced]** Get the distance between consecutive elements in the raw storage buffer.
+        /**
+           Some grids are stored with a simple strided layout, i.e.,
+           moving by one index in any given dimension always moves by a
+           fixed number of elements in the buffer returned by get_raw_storage_buffer().
+           This is true when the grid is neither vector-folded nor bricked.
+           For such grids, the raw buffer may be accessed as a
+           multi-dimensional array, e.g., via a NumPy view from the Python API,
+           without copying data:
+           - The number of entries in each dimension is get_alloc_size().
+           - In the step dimension, the array index is the allocated slot,
+           i.e., the step index modulo get_alloc_size().
+           - In all other dimensions, the array index is the grid index minus
+           get_first_rank_alloc_index() for domain dimensions or
+           minus get_first_misc_index() for misc dimensions.
+
+           Grids that are vector-folded or bricked do not have such a layout.
+           Use get_elements_in_slice() and set_elements_in_slice()
+           to copy data in bulk to and from those grids.
+
+           @returns Number of elements between consecutive indices in
+           dimension `dim` if the layout is strided and storage is allocated,
+           zero otherwise.
+           If the allocation size in `dim` is one, the stride is not
+           meaningful, and one is returned.
+        */
+        virtual idx_t
+        get_raw_storage_stride(const std::string& dim
+                               /**< [in] Name of dimension to get. */ ) const =0;
+
+        /// **[Advanced]** Get the offset of an element in the raw storage buffer.
+        /**
+           Provide indices in a list in the same order returned by get_dim_names().
+           Indices are relative to the *overall* problem domain.
+           Index values must fall within the allocated space as returned by
+           get_first_rank_alloc_index() and get_last_rank_alloc_index() for
+           each dimension.
+           Unlike get_raw_storage_stride(), this works for any layout,
+           including vector-folded and bricked grids.
+           @returns Number of elements from the beginning of the buffer
+           returned by get_raw_storage_buffer() to the given element.
+        */
+        virtual idx_t
+        get_raw_storage_offset(const std::vector<idx_t>& indices
+                               /**< [in] List of indices, one for each grid dimension. */ ) const =0;
+
+        /// **[Advanced]** Get the vector-fold length in the specified dimension.
+        /**
+           Elements of vector-folded grids are stored in small
+           multi-dimensional vector blocks. The product of the fold
+           lengths across all dimensions is the number of elements in each vector
+           block; a fold length of one indicates no folding in that dimension.
+           @returns Number of elements in each vector block in dimension `dim`.
+        */
+        virtual idx_t
+        get_fold_len(const std::string& dim
+                     /**< [in] Name of dimension to get. */ ) const =0;
+
+        /// **[Advanced]** Get the allocated slot used for the given step index.
+        /**
+           Grids with the step dimension keep a ring of get_alloc_size()
+           step slots, and each step index is mapped to one of them.
+           @returns Step slot in [0, get_alloc_size(step-dim)) holding data
+           for step `step_index`, or zero if this grid does not use the step dimension.
+        */
+        virtual idx_t
+        get_alloc_step_slot(idx_t step_index
+                            /**< [in] Index in the step dimension. */ ) const =0;
+
+        /// **[Advanced]** Use externally-allocated memory for the data storage.
+        /**
+           This is an alternative to allocating data storage via
+           yk_solution::prepare_solution(), alloc_storage(), or share_storage().
+           It allows data to be shared with code outside of YASK without copying.
+           The following conditions must hold:
+           - `buffer_ptr` must be aligned to a multiple of 64 bytes.
+           - `num_bytes` must be at least get_num_storage_bytes().
+           - The memory must remain valid until this grid releases it via
+           release_storage() or is destroyed; it will not be freed by YASK.
+
+           Any pre-existing storage will be released before the buffer is
+           used as via release_storage().
+           The layout of the data in the buffer is the same as if it had been
+           allocated by YASK; use get_raw_storage_offset() or, for strided layouts,
+           get_raw_storage_stride() to locate elements.
+           The grid sizes should not be changed after calling this
+           because the required buffer size would change.
+        */
+        virtual void
+        use_external_storage(void* buffer_ptr
+                             /**< [in] Pointer to memory to use for data. */,
+                             idx_t num_bytes
+                             /**< [in] Number of bytes available at `buffer_ptr`. */ ) =0;
+
         /* Deprecated APIs for yk_grid found below should be avoided.
            Use the more explicit form found in the documentation. */
 
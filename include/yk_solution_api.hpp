@@ -65,6 +65,42 @@ namespace yask {
     */
     const int yask_numa_none = -9;
 
+    /// Do not request huge pages.
+    /**
+       This is used in yk_solution::set_huge_pages.
+       In Python, specify as `yask_kernel.cvar.yask_huge_pages_none`.
+    */
+    const int yask_huge_pages_none = 0;
+
+    /// Request transparent huge pages from the OS.
+    /**
+       This is used in yk_solution::set_huge_pages.
+       In Python, specify as `yask_kernel.cvar.yask_huge_pages_transparent`.
+    */
+    const int yask_huge_pages_transparent = 1;
+
+    /// Allocate explicit 2MiB huge pages.
+    /**
+       This is used in yk_solution::set_huge_pages.
+       In Python, specify as `yask_kernel.cvar.yask_huge_pages_2m`.
+    */
+    const int yask_huge_pages_2m = 2;
+
+    /// Allocate explicit 1GiB huge pages.
+    /**
+       This is used in yk_solution::set_huge_pages.
+       In Python, specify as `yask_kernel.cvar.yask_huge_pages_1g`.
+    */
+    const int yask_huge_pages_1g = 3;
+
+    /// Function called by yk_solution::run_solution() at selected steps.
+    /**
+       The argument is the step index of the grid data just computed.
+       See yk_solution::add_step_callback().
+       Not available in Python.
+    */
+    typedef std::function<void (idx_t step_index)> yk_step_callback;
+
     /// Stencil solution as defined by the generated code from the YASK stencil compiler.
     /**
        Objects of this type contain all the grids and equations
@@ -399,6 +435,31 @@ namespace yask {
         virtual void
         run_solution(idx_t step_index /**< [in] Index in the step dimension */ ) =0;
 
+        /// **[Advanced]** Shift rank-domain boundaries to balance the work across ranks.
+        /**
+           Uses the compute time (excluding MPI halo exchanges) measured on each
+           rank in run_solution() since the previous rebalancing.
+           For each domain dimension with more than one rank, the sizes of the
+           ranks at each rank index are moved part of the way toward sizes that
+           would equalize those times.
+           Sizes are kept as multiples of the vector length and at least as large
+           as the halos.
+           The grid data are then moved to their new owners, and the grids
+           are reallocated.
+           Nothing is changed if the slowest rank is within the tolerance set by
+           the `-rebalance_tolerance` option.
+           Grids whose storage was given via share_grid_storage() should not be used
+           with this function.
+           Since this function initiates MPI communication, it must be called
+           on all MPI ranks, and it will block until all ranks have completed.
+           It is called automatically at the end of run_solution() every
+           `-rebalance_interval` steps if that option is set.
+           This function should be called only *after* calling prepare_solution().
+           @returns `true` if any rank-domain sizes were changed.
+        */
+        virtual bool
+        rebalance_ranks() =0;
+
         /// Finish using a solution.
         /**
            Performs a final MPI halo exchange.
@@ -525,13 +586,23 @@ namespace yask {
         /**
            Under normal operation, an auto-tuner is invoked automatically during calls to
            run_solution().
-           Currently, only the block size is set by the auto-tuner, and the search begins from the
-           sizes set via set_block_size() or the default size if set_block_size() has
-           not been called.
+           The auto-tuner searches the settings in the following order, each starting
+           from the current values and keeping the best values found for the previous ones:
+           the region size (only when temporal wave-front tiling is enabled),
+           the block size, the number of threads per block (only when more than one thread is
+           available and temporal tiling in blocks is not enabled), the sub-block size,
+           the L1 and L2 prefetch distances used in the generated loops,
+           and the orders of the dims in the generated region, block and sub-block loops.
+           When the `-auto_tune_save_file` option is given via apply_command_line_options(),
+           the final settings are written to that file as command-line options
+           that may be applied in later runs to skip tuning.
            This function is used to apply the current best-known settings if the tuner has
            been running, reset the state of the auto-tuner, and either
            restart its search or disable it from running.
-           This call must be made on each rank where the change is desired.
+           With more than one rank, the tuner uses the time of the slowest
+           rank and the size limits of the smallest one, so all ranks
+           try the same settings and finish tuning together.
+           This call must be made on all ranks.
         */
         virtual void
         reset_auto_tuner(bool enable
@@ -552,6 +623,11 @@ namespace yask {
            until the auto-tuner converges on all ranks.
            It is useful for benchmarking, where performance is to be timed
            for a given number of steps after the best settings are found.
+           When the `-auto_tune_db_file` option is given via apply_command_line_options(),
+           the settings stored in that file for a matching stencil, architecture,
+           FP size, fold, cluster, thread count and rank-domain size are applied
+           without searching if they are found for every rank;
+           otherwise, the settings found are added to the file.
            This function should be called only *after* calling prepare_solution().
            This call must be made on each rank.
            @warning Modifies the contents of the grids by calling run_solution()
@@ -750,6 +826,136 @@ namespace yask {
         virtual int
         get_default_numa_preferred() const =0;
 
+        /// **[Advanced]** Enable or disable non-temporal (streaming) stores.
+        /**
+           When enabled, writes to grids that no equation reads at the
+           step index being written bypass the caches, avoiding the
+           read-for-ownership of each destination cache line.
+           The stencil compiler determines which grids qualify.
+           Streaming stores are not used while temporal tiling is
+           enabled, because the written values are then read again soon.
+           This is equivalent to the `-nt_stores` command-line option.
+        */
+        virtual void
+        set_nt_stores(bool enable
+                      /**< [in] Whether to use streaming stores. */) =0;
+
+        /// **[Advanced]** Get whether non-temporal (streaming) stores are enabled.
+        /**
+           @returns Current setting from set_nt_stores().
+        */
+        virtual bool
+        get_nt_stores() const =0;
+
+        /// **[Advanced]** Set the huge-page policy used when allocating data.
+        /**
+           This value is used when allocating grids, scratch grids and MPI
+           buffers, so it must be set before prepare_solution() or
+           yk_grid::alloc_storage() to take effect.
+           When explicit huge pages are requested but not available,
+           e.g., because none are reserved by the OS, allocation falls back
+           to transparent huge pages.
+           This is equivalent to the `-huge_pages` command-line option.
+        */
+        virtual void
+        set_huge_pages(int policy
+                       /**< [in] One of `yask_huge_pages_none`,
+                          `yask_huge_pages_transparent`,
+                          `yask_huge_pages_2m`, or `yask_huge_pages_1g`.
+                          These constants are defined in
+                          the _Variable Documentation_ section of
+                          \ref yk_solution_api.hpp. */) =0;
+
+        /// **[Advanced]** Get the huge-page policy used when allocating data.
+        /**
+           @returns Current setting from set_huge_pages().
+        */
+        virtual int
+        get_huge_pages() const =0;
+
+        /// **[Advanced]** Set the memory pool used when allocating data.
+        /**
+           Memory for grids, scratch grids and MPI buffers allocated by
+           prepare_solution() is taken from the pool and returned to it when
+           no longer used, so that a following solution can reuse it without
+           new allocation, page mapping or page faults.
+           Must be called before prepare_solution() to take effect.
+           The pool is also used by solutions created from this one with
+           yk_factory::new_solution(yk_env_ptr, const yk_solution_ptr).
+           See \ref yk_mem_pool.
+        */
+        virtual void
+        set_mem_pool(yk_mem_pool_ptr pool
+                     /**< [in] Pool created via yk_factory::new_mem_pool()
+                        or `nullptr` to allocate directly from the OS. */) =0;
+
+        /// **[Advanced]** Get the memory pool used when allocating data.
+        /**
+           @returns Pool from set_mem_pool() or `nullptr` if none.
+        */
+        virtual yk_mem_pool_ptr
+        get_mem_pool() const =0;
+
+        /// **[Advanced]** Set the logical CPUs used by this solution's threads.
+        /**
+           When CPUs are given, prepare_solution() and run_solution() use one
+           OpenMP thread per CPU, and those threads are bound to the given
+           CPUs only. The host thread calling these functions is bound to the
+           CPUs during the call and restored to its previous affinity afterward.
+
+           This allows several solutions, e.g., a forward and an adjoint
+           propagator or two shots, to call run_solution() at the same time
+           from different host threads without oversubscribing the cores:
+           OpenMP starts a separate pool of threads for each host thread, and
+           giving each solution disjoint CPUs keeps the pools apart.
+           The `-thread_divisor` and `-block_threads` settings are applied
+           to the number of CPUs as usual.
+           When MPI is used with more than one rank, MPI is initialized with
+           `MPI_THREAD_SERIALIZED`, so only one solution per process may
+           communicate at a time.
+
+           Must be called before prepare_solution() to take effect.
+           This is equivalent to the `-cpus` command-line option.
+        */
+        virtual void
+        set_cpus(const std::vector<int>& cpus
+                 /**< [in] Logical CPU numbers as used by the OS,
+                    or an empty vector to use the CPUs allowed to the calling
+                    thread and the default number of threads. */) =0;
+
+        /// **[Advanced]** Get the logical CPUs used by this solution's threads.
+        /**
+           @returns CPUs from set_cpus() in ascending order or an empty vector
+           if not restricted.
+        */
+        virtual std::vector<int>
+        get_cpus() const =0;
+
+        /// **[Advanced]** Enable or disable overlapping of MPI communication with computation.
+        /**
+           When enabled, each stencil-bundle pack first calculates the
+           "shell" of the rank domain, i.e., the points that must be sent to
+           neighboring ranks, then starts the halo exchange, then
+           calculates the interior of the rank domain while the messages
+           are in flight. The exchange is completed before the next pack
+           needs the data.
+           Overlapping is not done when temporal wave-front tiling is used.
+           This is equivalent to the `-overlap_comms` command-line option.
+           @returns `true` if the setting was applied;
+           `false` if overlapping was requested but MPI is not enabled.
+        */
+        virtual bool
+        set_overlap_comms(bool enable
+                          /**< [in] Whether to overlap communication
+                             with computation. */) =0;
+
+        /// **[Advanced]** Get whether MPI communication is overlapped with computation.
+        /**
+           @returns Current setting from set_overlap_comms().
+        */
+        virtual bool
+        get_overlap_comms() const =0;
+
         /// **[Advanced]** Set performance parameters from an option string.
         /**
            Parses the string for options as if from a command-line.
@@ -774,6 +980,476 @@ namespace yask {
         virtual void
         share_grid_storage(yk_solution_ptr source
                            /**< [in] Solution from which grid storage will be shared. */) =0;
+
+        /// **[Advanced]** Advance another solution in lock-step with this one.
+        /**
+           Typically used to run many independent instances of a stencil,
+           e.g., seismic shots, over the same read-only model data.
+           The storage of each grid in this solution that is not written by any
+           stencil equation is shared with `other` as in yk_grid::share_storage(),
+           replacing any data in `other`'s grid.
+           After this call, each call to run_solution() on this solution also
+           advances `other` over the same steps. Each block is evaluated in
+           this solution and then in each batch solution before moving to the next
+           block, so the shared grids are read from cache by all of them.
+
+           Both solutions must be from the same stencil, have been prepared with
+           prepare_solution(), and have the same domain, region, block, and
+           sub-block sizes. Auto-tuning, rank rebalancing and MPI progress threads
+           must be disabled in this solution.
+           run_solution() should not be called directly on `other` while it is
+           in a batch.
+        */
+        virtual void
+        add_batch_solution(yk_solution_ptr other
+                           /**< [in] Solution to add to the batch of this one. */) =0;
+
+        /// **[Advanced]** Add a set of sparse points to be injected into or sampled from a grid.
+        /**
+           Typically used for seismic sources and receivers at locations
+           that do not fall on grid points.
+           Each of the `num_points` sparse points is a weighted sum over one or more
+           grid elements called "taps", e.g., the eight neighbors of the
+           location with tri-linear interpolation weights.
+           For each tap `i`, `tap_points[i]` is its point number in [0, `num_points`),
+           `tap_weights[i]` is its weight, and the grid indices are
+           `tap_indices[i * n]` through `tap_indices[i * n + n - 1]`,
+           where `n` is the number of grid dimensions excluding the step dimension,
+           in the order returned by yk_grid::get_dim_names().
+           Indices are relative to the *overall* problem domain, so the same
+           taps should be given on every rank.
+
+           The operator is applied inside each subsequent call to run_solution(),
+           right after the last stencil-bundle pack that writes to the grid
+           computes each step within the range set by set_sparse_steps():
+           - If `is_source` is `true`, the value of each point at that step
+           (see set_sparse_values()) multiplied by each tap weight is added to
+           the grid element at each tap.
+           - If `is_source` is `false`, the weighted sum of the grid elements at the
+           taps of each point is saved for that step (see get_sparse_values()).
+
+           The grid must use the step dimension and be written by at least one
+           stencil equation.
+           Sparse operators are applied to this solution only, not to any batch solution
+           added via add_batch_solution().
+           Temporal wave-front tiling, i.e., a region size greater than one in the step
+           dimension, is not allowed, and overlapping of communication with computation
+           is not done while any sparse operators are defined.
+           @returns ID of the new operator, to be used with the other sparse APIs.
+        */
+        virtual int
+        add_sparse_points(const std::string& grid_name
+                          /**< [in] Name of grid to inject into or sample from. */,
+                          bool is_source
+                          /**< [in] Whether to inject (`true`) or sample (`false`). */,
+                          idx_t num_points
+                          /**< [in] Number of sparse points. */,
+                          const std::vector<idx_t>& tap_points
+                          /**< [in] Point number for each tap. */,
+                          const std::vector<idx_t>& tap_indices
+                          /**< [in] Grid indices for each tap. */,
+                          const std::vector<double>& tap_weights
+                          /**< [in] Weight for each tap. */ ) =0;
+
+        /// **[Advanced]** Set the range of steps over which a sparse operator is applied.
+        /**
+           Allocates space for the values of each point at each step
+           from `first_step_index` to `last_step_index`, inclusive,
+           and sets them to zero.
+           Steps are those of the grid data being written, i.e., the value at step
+           `t` is injected into or sampled from the grid at step-index `t`.
+           The operator is not applied at steps outside of this range.
+        */
+        virtual void
+        set_sparse_steps(int op_id
+                         /**< [in] ID from add_sparse_points(). */,
+                         idx_t first_step_index
+                         /**< [in] First step to apply the operator. */,
+                         idx_t last_step_index
+                         /**< [in] Last step to apply the operator. */ ) =0;
+
+        /// **[Advanced]** Set the values of a sparse source operator.
+        /**
+           The buffer must contain `num_points` values for each step in the
+           range given in set_sparse_steps(), stored step-by-step, in the
+           same element size as yk_solution::get_element_bytes().
+           The same values should be given on every rank.
+        */
+        virtual void
+        set_sparse_values(int op_id
+                          /**< [in] ID from add_sparse_points(). */,
+                          const void* buffer_ptr
+                          /**< [in] Pointer to buffer where values will be read. */ ) =0;
+
+        /// **[Advanced]** Get the values of a sparse receiver operator.
+        /**
+           Copies `num_points` values for each step in the range given in
+           set_sparse_steps(), stored step-by-step, in the
+           same element size as yk_solution::get_element_bytes().
+           Values from taps in different ranks are summed, so this must be
+           called on every rank, and the results are the same on every rank.
+        */
+        virtual void
+        get_sparse_values(int op_id
+                          /**< [in] ID from add_sparse_points(). */,
+                          void* buffer_ptr
+                          /**< [out] Pointer to buffer where values will be written. */ ) =0;
+
+        /// **[Advanced]** Call a function at selected steps inside run_solution().
+        /**
+           Typically used for per-step host work such as saving snapshots,
+           injecting boundary values or checking convergence without
+           splitting run_solution() into single-step calls.
+           After the grid data at step index `t` has been computed for all stencil
+           bundles, `callback(t)` is called if `t` is `first_step_index` or any
+           multiple of `step_interval` steps after it in the direction of the
+           solution's step dimension.
+           Callbacks due at the same step are called in the order they were added.
+
+           The grids listed in `read_grid_names` and `written_grid_names` declare
+           the callback's footprint.
+           If either list is not empty, any temporal wave-front is ended at each
+           step where the callback is due, any halo exchange in flight is completed,
+           and the callback may access the rank-domain elements of those grids at
+           step `t` via the yk_grid APIs or raw storage. Halo elements may be stale.
+           Grids in `written_grid_names` are marked as modified at step `t`, so
+           their halos will be exchanged before they are next read.
+           If both lists are empty, the callback must not access any grid, and it is
+           called after the wave-front containing step `t` is done, so the
+           callback does not limit temporal tiling.
+
+           Callbacks are applied to this solution only, not to any batch solution
+           added via add_batch_solution().
+           The time spent in callbacks is not counted in the run statistics
+           or by the auto-tuner.
+           Not available in Python.
+        */
+        virtual void
+        add_step_callback(yk_step_callback callback
+                          /**< [in] Function to call. */,
+                          idx_t first_step_index
+                          /**< [in] First step at which to call it. */,
+                          idx_t step_interval
+                          /**< [in] Number of steps between calls; must be positive. */,
+                          const std::vector<std::string>& read_grid_names
+                          /**< [in] Names of grids read by `callback`. */,
+                          const std::vector<std::string>& written_grid_names
+                          /**< [in] Names of grids written by `callback`. */ ) =0;
+
+        /// **[Advanced]** Remove all functions added via add_step_callback().
+        virtual void
+        clear_step_callbacks() =0;
+
+        /// **[Advanced]** Write a slice of a grid to a file at selected steps inside run_solution().
+        /**
+           Typically used to save wavefield snapshots without stalling the
+           stencil calculations while the data is written.
+           At each step at which a callback added via add_step_callback() with the
+           same `first_step_index` and `step_interval` would be called, all threads
+           copy the part of the slice in this rank's domain into a staging buffer
+           with the same element order as yk_grid::get_elements_in_slice().
+           A background thread then appends the buffer to the rank's file
+           while run_solution() continues.
+           Two staging buffers are used alternately, so run_solution() waits only
+           if both are still being written.
+
+           Each rank writes a file named `path.rank`_N_`.snap`, where _N_ is the
+           MPI rank number. It starts with a 4096-byte text header listing the
+           grid, element size, dims, and the first and last indices of the
+           rank's part of the slice, followed by one record per snapshot: the
+           step index as a 64-bit integer and then the elements.
+           `first_indices` and `last_indices` contain an index for every dim of
+           the grid; any step index in them is ignored.
+           Must be called after prepare_solution().
+           Not affected by clear_step_callbacks().
+        */
+        virtual void
+        add_snapshot(const std::string& grid_name
+                     /**< [in] Name of grid to save. */,
+                     const std::vector<idx_t>& first_indices
+                     /**< [in] First index in each dim of the slice. */,
+                     const std::vector<idx_t>& last_indices
+                     /**< [in] Last index in each dim of the slice. */,
+                     idx_t first_step_index
+                     /**< [in] First step at which to save the slice. */,
+                     idx_t step_interval
+                     /**< [in] Number of steps between saves; must be positive. */,
+                     const std::string& path
+                     /**< [in] Path and file-name prefix for the files. */ ) =0;
+
+        /// **[Advanced]** Wait for all snapshots to be written and close their files.
+        /**
+           Stops all snapshots added via add_snapshot().
+           Called automatically by end_solution().
+        */
+        virtual void
+        finish_snapshots() =0;
+
+        /// **[Advanced]** Collect a decimated slice of a grid in memory at selected steps inside run_solution().
+        /**
+           Typically used to save a subsampled wavefield for imaging without
+           copying the full-resolution grid out of the kernel.
+           At each step at which a callback added via add_step_callback() with the
+           same `first_step_index` and `step_interval` would be called, all threads
+           append every `strides`-th element of the part of the slice in this
+           rank's domain to a contiguous buffer, in the same element order as
+           yk_grid::get_elements_in_slice().
+           A single plane may be collected by making the first and last index the
+           same in one or more dims.
+           `first_indices`, `last_indices`, and `strides` contain an entry for every
+           dim of the grid; any step index or stride in them is ignored.
+           The elements kept in each rank are those at `first_indices` plus a multiple
+           of `strides`, so the output of all ranks together is the same as with
+           one rank.
+           Any stream previously added with the same `key` is replaced.
+           Must be called after prepare_solution().
+           Not affected by clear_step_callbacks().
+           @returns Number of elements in each record on this rank.
+        */
+        virtual idx_t
+        add_decimated_output(const std::string& key
+                             /**< [in] Name used to get the output. */,
+                             const std::string& grid_name
+                             /**< [in] Name of grid to read. */,
+                             const std::vector<idx_t>& first_indices
+                             /**< [in] First index in each dim of the slice. */,
+                             const std::vector<idx_t>& last_indices
+                             /**< [in] Last index in each dim of the slice. */,
+                             const std::vector<idx_t>& strides
+                             /**< [in] Distance between kept elements in each dim;
+                                must be positive. */,
+                             idx_t first_step_index
+                             /**< [in] First step at which to collect the slice. */,
+                             idx_t step_interval
+                             /**< [in] Number of steps between records; must be positive. */ ) =0;
+
+        /// **[Advanced]** Get the step indices of the records collected by add_decimated_output().
+        /** @returns Step index of each record held for `key` in the order collected. */
+        virtual std::vector<idx_t>
+        get_decimated_output_steps(const std::string& key
+                                   /**< [in] Name given to add_decimated_output(). */ ) const =0;
+
+        /// **[Advanced]** Get the first index in each dim of the decimated slice in this rank.
+        /**
+           @returns Index of the first element of each record in each dim,
+           or zero in the step dim.
+           If the slice is empty in this rank, the last index is less than
+           the first index in one or more dims.
+        */
+        virtual std::vector<idx_t>
+        get_decimated_output_first_indices(const std::string& key
+                                           /**< [in] Name given to add_decimated_output(). */ ) const =0;
+
+        /// **[Advanced]** Get the last index in each dim of the decimated slice in this rank.
+        /** @returns Index of the last element of each record in each dim,
+            or zero in the step dim. */
+        virtual std::vector<idx_t>
+        get_decimated_output_last_indices(const std::string& key
+                                          /**< [in] Name given to add_decimated_output(). */ ) const =0;
+
+        /// **[Advanced]** Copy the records collected by add_decimated_output() into a buffer.
+        /**
+           The records are copied one after the other in the order of
+           get_decimated_output_steps().
+           The buffer must hold at least the number of elements returned by
+           add_decimated_output() times the number of records,
+           each of get_element_bytes() bytes.
+           If `clear` is true, the records are removed after copying, so the
+           next call returns only the ones collected after this one.
+           @returns Number of elements copied.
+        */
+        virtual idx_t
+        get_decimated_output(const std::string& key
+                             /**< [in] Name given to add_decimated_output(). */,
+                             void* buffer_ptr
+                             /**< [out] Pointer to buffer where values will be written. */,
+                             bool clear = true
+                             /**< [in] Whether to remove the records copied. */ ) =0;
+
+        /// **[Advanced]** Stop and free an output stream added by add_decimated_output().
+        /** Does nothing if `key` is not in use. */
+        virtual void
+        remove_decimated_output(const std::string& key
+                                /**< [in] Name given to add_decimated_output(). */ ) =0;
+
+        /// **[Advanced]** Keep a compressed copy of a slice of a grid in memory.
+        /**
+           Typically used to hold many forward wavefields for the backward
+           pass of an adjoint or reverse-time-migration calculation without
+           writing them to disk or recomputing them.
+           The elements are read as by yk_grid::get_elements_in_slice() and
+           compressed in independent chunks by all threads.
+           If `max_abs_error` is zero, the compression is lossless.
+           Otherwise, each value is quantized so that it is restored within
+           `max_abs_error` of the original; parts of the slice that cannot be
+           quantized, e.g., ones containing infinities or NaNs, are stored
+           losslessly.
+           Any slice previously stored with the same `key` is replaced.
+           @returns Number of bytes used by the compressed slice.
+        */
+        virtual idx_t
+        store_compressed_slice(const std::string& key
+                               /**< [in] Name used to restore the slice. */,
+                               const std::string& grid_name
+                               /**< [in] Name of grid to read. */,
+                               const std::vector<idx_t>& first_indices
+                               /**< [in] First index in each dim of the slice. */,
+                               const std::vector<idx_t>& last_indices
+                               /**< [in] Last index in each dim of the slice. */,
+                               double max_abs_error = 0.
+                               /**< [in] Largest allowed absolute error in each element. */ ) =0;
+
+        /// **[Advanced]** Copy a slice stored by store_compressed_slice() into a grid.
+        /**
+           Decompresses the slice by all threads and writes it as by
+           yk_grid::set_elements_in_slice().
+           By default, it is written to the same grid and indices from which it
+           was read, but it may be written to a grid with the same number of
+           dims and/or at other indices, e.g., at another step index.
+           The stored copy is kept until remove_compressed_slice() is called.
+           @returns Number of elements written.
+        */
+        virtual idx_t
+        restore_compressed_slice(const std::string& key
+                                 /**< [in] Name given to store_compressed_slice(). */,
+                                 const std::string& grid_name = ""
+                                 /**< [in] Name of grid to write or empty to use the
+                                    original grid. */,
+                                 const std::vector<idx_t>& first_indices = {}
+                                 /**< [in] First index in each dim of the slice or empty
+                                    to use the original indices. */ ) =0;
+
+        /// **[Advanced]** Free a slice stored by store_compressed_slice().
+        /** Does nothing if `key` is not in use. */
+        virtual void
+        remove_compressed_slice(const std::string& key
+                                /**< [in] Name given to store_compressed_slice(). */ ) =0;
+
+        /// **[Advanced]** Get the memory used by all slices stored by store_compressed_slice().
+        /** @returns Number of bytes. */
+        virtual idx_t
+        get_compressed_slice_bytes() const =0;
+
+        /// Compute reductions over the domain of a grid on all ranks.
+        /**
+           Finds the number of elements, their sum, L2 norm, minimum,
+           maximum, and maximum absolute value, and the indices of the
+           minimum, maximum, and maximum absolute value, in one pass.
+           All elements in the overall problem domain are used in
+           each domain dim, and all elements are used in each
+           misc dim. Padding and halos are never used.
+           Each rank reduces its part of the domain by all threads, using
+           whole SIMD vectors where possible, and the results are combined
+           across ranks, so this must be called on every rank.
+           @returns Pointer to the results, which are the same on all ranks.
+        */
+        virtual yk_reduction_ptr
+        reduce_grid(const std::string& grid_name
+                    /**< [in] Name of grid to reduce. */,
+                    idx_t step_index = 0
+                    /**< [in] Index in the step dim; ignored if the grid
+                       does not use the step dim. */ ) =0;
+
+        /// Compute reductions over a slice of a grid on all ranks.
+        /**
+           Like reduce_grid(), but only elements from `first_indices` to
+           `last_indices` in each dim are used.
+           In each domain dim, the slice is limited to the overall problem
+           domain, so padding and halos are never used.
+           Indices in misc dims must be within the allocated range.
+           Must be called on every rank with the same indices.
+           @returns Pointer to the results, which are the same on all ranks.
+        */
+        virtual yk_reduction_ptr
+        reduce_grid_in_slice(const std::string& grid_name
+                             /**< [in] Name of grid to reduce. */,
+                             const std::vector<idx_t>& first_indices
+                             /**< [in] First index in each dim of the slice. */,
+                             const std::vector<idx_t>& last_indices
+                             /**< [in] Last index in each dim of the slice. */ ) =0;
+
+        /// **[Advanced]** Save the data in all grids to files.
+        /**
+           Each rank writes one file named `path.rank`_N_`.yask`, where _N_ is the
+           MPI rank number, containing a header that describes the layout of the
+           rank and its grids followed by the raw storage of each grid as it is in
+           memory, including halos and padding.
+           The files are written by all threads in large pieces without any
+           conversion, so this is much faster than copying the elements out with
+           yk_grid::get_elements_in_slice().
+           The halos are exchanged first, so this must be called on every rank.
+           Must be called after prepare_solution().
+        */
+        virtual void
+        save_checkpoint(const std::string& path
+                        /**< [in] Path and file-name prefix for the files. */ ) =0;
+
+        /// **[Advanced]** Restore the data in all grids from files written by save_checkpoint().
+        /**
+           The solution must have the same stencil, element size, vector fold,
+           rank layout, and grid sizes, including halos and padding, as the one
+           that saved the files; an exception is thrown on every rank if any
+           file does not match.
+           Continue by calling run_solution() with the step index following
+           the last one completed before the checkpoint was saved.
+           Must be called on every rank after prepare_solution().
+        */
+        virtual void
+        load_checkpoint(const std::string& path
+                        /**< [in] Path and file-name prefix used in save_checkpoint(). */ ) =0;
+    };
+
+    /// Results from yk_solution::reduce_grid() or yk_solution::reduce_grid_in_slice().
+    /**
+       Sums are accumulated in double precision.
+       If the same extreme value occurs at more than one element,
+       which one is reported is not specified.
+       If no elements were reduced, all values are zero (0) and all
+       indices are empty.
+    */
+    class yk_reduction {
+    public:
+        virtual ~yk_reduction() {}
+
+        /// Get the number of elements reduced.
+        virtual idx_t
+        get_num_elements() const =0;
+
+        /// Get the sum of the elements.
+        virtual double
+        get_sum() const =0;
+
+        /// Get the L2 norm of the elements.
+        /** @returns Square root of the sum of the squares of the elements. */
+        virtual double
+        get_l2_norm() const =0;
+
+        /// Get the smallest element.
+        virtual double
+        get_min() const =0;
+
+        /// Get the indices of the smallest element.
+        /** @returns Overall-problem indices in the order returned by yk_grid::get_dim_names(). */
+        virtual std::vector<idx_t>
+        get_min_indices() const =0;
+
+        /// Get the largest element.
+        virtual double
+        get_max() const =0;
+
+        /// Get the indices of the largest element.
+        /** @returns Overall-problem indices in the order returned by yk_grid::get_dim_names(). */
+        virtual std::vector<idx_t>
+        get_max_indices() const =0;
+
+        /// Get the largest absolute value of the elements.
+        virtual double
+        get_max_abs() const =0;
+
+        /// Get the indices of the element with the largest absolute value.
+        /** @returns Overall-problem indices in the order returned by yk_grid::get_dim_names(). */
+        virtual std::vector<idx_t>
+        get_max_abs_indices() const =0;
     };
 
     /// Statistics from calls to run_solution().
@@ -825,6 +1501,173 @@ namespace yask {
         */
         virtual double
         get_elapsed_run_secs() =0;
+
+        /// Get the energy used during calls to run_solution().
+        /**
+           Energy is measured only when the `-measure_energy` option is set
+           or the auto-tuner objective uses energy, and only if the node
+           provides a readable node-level or RAPL energy counter. With
+           multiple ranks on a node, the node's energy is shared equally
+           among them, and the result is summed over all ranks.
+           @returns Energy in joules or zero (0) if not measured.
+        */
+        virtual double
+        get_energy_joules() =0;
+
+        /// Get the average energy used per step during calls to run_solution().
+        /**
+           @returns get_energy_joules() / get_num_steps_done() or zero (0)
+           if energy was not measured.
+        */
+        virtual double
+        get_joules_per_step() =0;
+
+        /// Get the number of points calculated per joule during calls to run_solution().
+        /**
+           @returns get_num_elements() * get_num_steps_done() / get_energy_joules()
+           or zero (0) if energy was not measured.
+        */
+        virtual double
+        get_points_per_joule() =0;
+
+        /// Get the number of blocks done by the work-stealing block scheduler.
+        /**
+           @returns Zero (0) unless the `-steal_blocks` option is used.
+        */
+        virtual idx_t
+        get_num_blocks_done() =0;
+
+        /// Get the number of blocks a thread took from another thread's queue.
+        /**
+           A high fraction of stolen blocks relative to get_num_blocks_done()
+           indicates that the work in a region is not evenly distributed.
+        */
+        virtual idx_t
+        get_num_blocks_stolen() =0;
+
+        /// Get the number of hardware performance counters collected.
+        /**
+           Counts are collected only when the `-perf_counters` option
+           is set and the OS allows access to the counters
+           (see `/proc/sys/kernel/perf_event_paranoid` on Linux).
+           @returns Number of counters or zero (0) if none were collected.
+        */
+        virtual int
+        get_num_perf_counters() =0;
+
+        /// Get the name of a hardware performance counter.
+        /**
+           @returns Name, e.g., "cycles" or "LLC-misses".
+        */
+        virtual std::string
+        get_perf_counter_name(int counter_idx
+                              /**< [in] Index from zero (0) to get_num_perf_counters() - 1. */) =0;
+
+        /// Get the names of the sections for which counts were collected.
+        /**
+           @returns Name of each stencil-bundle pack followed by "halo-exchange".
+           Counts for a pack include those of any scratch-grid bundles
+           evaluated for it.
+        */
+        virtual std::vector<std::string>
+        get_perf_section_names() =0;
+
+        /// Get a hardware performance count summed over all threads.
+        /**
+           @returns Count for the given section and counter during the
+           calls to run_solution() since the last call to
+           yk_solution::get_stats().
+        */
+        virtual idx_t
+        get_perf_count(const std::string& section_name
+                       /**< [in] Name from get_perf_section_names(). */,
+                       int counter_idx
+                       /**< [in] Index from zero (0) to get_num_perf_counters() - 1. */) =0;
+
+        /// Get the names of the metrics gathered from all ranks.
+        /**
+           Metrics are gathered only when the `-rank_stats` option is set,
+           in which case yk_solution::get_stats() must be called on all ranks.
+           The metrics are
+           `compute-secs` (time in run_solution() not spent in halo exchanges),
+           `halo-exch-secs` (time spent in halo exchanges, including waiting),
+           `halo-wait-secs` (time spent waiting for halo data), and
+           `num-points-per-sec` (throughput of the rank's domain).
+           If the `-step_stats` option is also set, the metrics
+           `step-secs-p50` (median step time),
+           `step-secs-p99` (99th-percentile step time), and
+           `num-step-outliers` (see get_step_outliers()) are added.
+           @returns Names or an empty list if not gathered.
+        */
+        virtual std::vector<std::string>
+        get_rank_metric_names() =0;
+
+        /// Get the value of a metric on every rank.
+        /** @returns Values in order of rank index. */
+        virtual std::vector<double>
+        get_rank_metric_values(const std::string& metric_name
+                               /**< [in] Name from get_rank_metric_names(). */ ) =0;
+
+        /// Get the smallest value of a metric over all ranks.
+        virtual double
+        get_rank_metric_min(const std::string& metric_name
+                            /**< [in] Name from get_rank_metric_names(). */ ) =0;
+
+        /// Get the mean value of a metric over all ranks.
+        virtual double
+        get_rank_metric_mean(const std::string& metric_name
+                             /**< [in] Name from get_rank_metric_names(). */ ) =0;
+
+        /// Get the largest value of a metric over all ranks.
+        virtual double
+        get_rank_metric_max(const std::string& metric_name
+                            /**< [in] Name from get_rank_metric_names(). */ ) =0;
+
+        /// Get the standard deviation of a metric over all ranks.
+        virtual double
+        get_rank_metric_std_dev(const std::string& metric_name
+                                /**< [in] Name from get_rank_metric_names(). */ ) =0;
+
+        /// Get the rank indices in order of decreasing `compute-secs`.
+        /**
+           The first rank is the one most likely to delay the others,
+           which then show more `halo-wait-secs`.
+           @returns Rank indices or an empty list if metrics were not gathered.
+        */
+        virtual std::vector<int>
+        get_slowest_ranks() =0;
+
+        /// Get the elapsed time of each step done via run_solution().
+        /**
+           Times are recorded only when the `-step_stats` option is set.
+           When steps are done together, e.g., in temporal wave-fronts,
+           each step in the group is given the mean time of the group.
+           The time of a step includes its halo exchanges.
+           @returns Seconds for each step in the order done since the last call to
+           yk_solution::get_stats() or an empty list if not recorded.
+        */
+        virtual std::vector<double>
+        get_step_secs() =0;
+
+        /// Get a percentile of the times from get_step_secs().
+        /**
+           Interpolates linearly between the nearest recorded times.
+           @returns Seconds at the given percentile or zero (0) if no times were recorded.
+        */
+        virtual double
+        get_step_secs_percentile(double pct
+                                 /**< [in] Percentile from 0 to 100, e.g., 50 for the median. */ ) =0;
+
+        /// Get the steps whose times are outliers.
+        /**
+           A step is an outlier if its time is more than three scaled median
+           absolute deviations (MAD) above the median and more than 10% above
+           the median. Outliers often indicate interference from the OS, other
+           processes, or network jitter.
+           @returns Indices into the list from get_step_secs().
+        */
+        virtual std::vector<idx_t>
+        get_step_outliers() =0;
     };
 
     /** @}*/
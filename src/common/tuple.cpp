@@ -63,7 +63,7 @@ namespace yask {
             *p = val;
         else {
             Scalar<T> sv(dim, val);
-            _q.insert(_q.begin(), sv);
+            _q.push_front(sv);
         }
     }
 
@@ -100,10 +100,11 @@ namespace yask {
 
         // Dims must be in same order.
         if (sameOrder) {
+            // Names are pooled, so same names usually have the same addr.
             for (size_t i = 0; i < _q.size(); i++) {
-                auto& n = _q[i].getName();
-                auto& rn = rhs._q[i].getName();
-                if (n != rn)
+                auto* n = _q[i].getNamePtr();
+                auto* rn = rhs._q[i].getNamePtr();
+                if (n != rn && *n != *rn)
                     return false;
             }
         }
@@ -151,6 +152,8 @@ namespace yask {
 
         // compare dims.
         for (size_t i = 0; i < _q.size(); i++) {
+            if (_q[i].getNamePtr() == rhs._q[i].getNamePtr())
+                continue;
             auto& n = _q[i].getName();
             auto& rn = rhs._q[i].getName();
             if (n < rn)
@@ -95,6 +95,10 @@ namespace yask {
             _val = val;
         }
 
+        // Only for unused slots in TupleDims.
+        template <typename S, int N> friend class TupleDims;
+        Scalar() { }
+
     public:
         Scalar(const std::string& name, const T& val) {
             assert(name.length() > 0);
@@ -133,6 +137,62 @@ namespace yask {
         }
     };
 
+    // List of dims for a Tuple.
+    // The first 'N' dims are stored inline, so copying a Tuple with up to
+    // 'N' dims, e.g., one holding the stencil dims, never touches the heap.
+    // More dims are moved to a vector; they are only used by unusual
+    // solutions with many misc dims.
+    template <typename S, int N>
+    class TupleDims {
+        S _fixed[N];
+        std::vector<S> _more;   // all dims if more than N; else empty.
+        int _n = 0;
+
+    public:
+        typedef S* iterator;
+        typedef const S* const_iterator;
+
+        size_t size() const { return size_t(_n); }
+        bool empty() const { return _n == 0; }
+        S* data() { return _more.size() ? _more.data() : _fixed; }
+        const S* data() const { return _more.size() ? _more.data() : _fixed; }
+        S* begin() { return data(); }
+        S* end() { return data() + _n; }
+        const S* begin() const { return data(); }
+        const S* end() const { return data() + _n; }
+        S& operator[](size_t i) { return data()[i]; }
+        const S& operator[](size_t i) const { return data()[i]; }
+        S& at(size_t i) {
+            assert(int(i) < _n);
+            return data()[i];
+        }
+        const S& at(size_t i) const {
+            assert(int(i) < _n);
+            return data()[i];
+        }
+        void clear() {
+            _more.clear();
+            _n = 0;
+        }
+        void push_back(const S& s) {
+            if (_n < N && _more.empty())
+                _fixed[_n] = s;
+            else {
+                if (_more.empty())
+                    _more.assign(_fixed, _fixed + _n);
+                _more.push_back(s);
+            }
+            _n++;
+        }
+        void push_front(const S& s) {
+            push_back(s);
+            S* p = data();
+            for (int i = _n - 1; i > 0; i--)
+                p[i] = p[i - 1];
+            p[0] = s;
+        }
+    };
+
     // Collection of named items of one arithmetic type.
     // Can represent:
     // - an n-D space with given sizes.
@@ -145,10 +205,12 @@ namespace yask {
     class Tuple {
     protected:
 
+        // Max number of dims stored without heap allocation.
+        static constexpr int _max_fixed_dims = 8;
+        typedef TupleDims<Scalar<T>, _max_fixed_dims> Dims;
+
         // Dimensions and values for this Tuple.
-        // Adding to front is unusual, so using a vector instead of a deque,
-        // which is less efficient.
-        std::vector<Scalar<T>> _q;
+        Dims _q;
 
         // First-inner vars control ordering. Example: dims x, y, z.
         // If _firstInner == true, x is unit stride (col major).
@@ -176,7 +238,7 @@ namespace yask {
         const std::vector<std::string> getDimNames() const;
 
         // Get iteratable contents.
-        const std::vector<Scalar<T>>& getDims() const {
+        const Dims& getDims() const {
             return _q;
         }
 
@@ -247,6 +309,10 @@ namespace yask {
         // Return dim posn or -1 if it doesn't exist.
         // Lookup by name.
         int lookup_posn(const std::string& dim) const {
+            // Names are usually from the pool, so check addrs first.
+            for (size_t i = 0; i < _q.size(); i++)
+                if (_q[i].getNamePtr() == &dim)
+                    return int(i);
             for (size_t i = 0; i < _q.size(); i++) {
                 auto& s = _q[i];
                 
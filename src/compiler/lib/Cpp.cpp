@@ -85,7 +85,8 @@ namespace yask {
 
         // Determine type to avoid virtual call.
         bool folded = gp.isGridFoldable();
-        string gtype = folded ? "YkVecGrid" : "YkElemGrid";
+        string gtype = folded ? (gp.getGrid()->isHalf() ? "YkHalfVecGrid" : "YkVecGrid") :
+            "YkElemGrid";
 
         // Get/set local vars.
         string gridPtr = getLocalVar(os, gp.getGridPtr(), "auto");
@@ -198,7 +199,9 @@ namespace yask {
         for (auto& gp : gps) {
 
             // Can we use a pointer?
-            if (gp.getLoopType() != GridPoint::LOOP_OFFSET)
+            // Not with bricks, because the inner dim is not unit stride.
+            if (gp.getLoopType() != GridPoint::LOOP_OFFSET ||
+                gp.getGrid()->isBricked())
                 continue;
 
             // Make base point (inner-dim index = 0).
@@ -237,6 +240,9 @@ namespace yask {
 
         // Loop through all aligned read & write points.
         set<string> done;
+        map<string, GridPointPtr> anchors; // first point for each step & misc arg.
+        map<string, string> anchorPtrs; // pointer var for each anchor.
+        map<string, string> strides; // stride var for each grid & dim.
         for (auto& gp : gps) {
 
             // Make base point (inner-dim index = 0).
@@ -250,8 +256,67 @@ namespace yask {
             // Make code for pointer and prefetches.
             if (!done.count(*p)) {
 
-                // Print pointer creation.
-                printPointPtr(os, *p, *bgp);
+                // Pointers that differ only by const offsets in the outer
+                // domain dims are calculated from the first one, the
+                // "anchor," using the distance between vectors in each
+                // dim.  This replaces a layout calculation for each
+                // pointer with one per grid and dim.
+                string key = bgp->getGridName(), skey = key;
+                auto& gdims = bgp->getGrid()->getDims();
+                auto& args = bgp->getArgs();
+                auto& offsets = bgp->getArgOffsets();
+                for (size_t i = 0; i < gdims.size(); i++) {
+                    auto& dname = gdims[i]->getName();
+                    if (gdims[i]->getType() == DOMAIN_INDEX && offsets.lookup(dname))
+                        continue;
+                    key += "," + args.at(i)->makeStr();
+                    if (gdims[i]->getType() != STEP_INDEX)
+                        skey += "," + args.at(i)->makeStr();
+                }
+                if (!anchors.count(key)) {
+                    anchors[key] = bgp;
+                    anchorPtrs[key] = *p;
+                    printPointPtr(os, *p, *bgp);
+                }
+                else {
+                    auto& agp = anchors.at(key);
+                    auto& aptr = anchorPtrs.at(key);
+                    auto& aofs = agp->getArgOffsets();
+                    ostringstream oss;
+                    oss << aptr;
+                    for (auto& dim : offsets.getDims()) {
+                        auto& dname = dim.getName();
+                        if (dname == idim)
+                            continue;
+                        int delta = dim.getVal() - aofs.getVal(dname);
+                        if (!delta)
+                            continue;
+
+                        // Print distance between vectors in this dim if needed.
+                        string sname = skey + ":" + dname;
+                        if (!strides.count(sname)) {
+                            auto* fp = _dims->_fold.lookup(dname);
+                            int vlen = fp ? *fp : 1;
+                            auto ngp = agp->cloneGridPoint();
+                            IntScalar nofs(dname, aofs.getVal(dname) + vlen);
+                            ngp->setArgOffset(nofs);
+                            string svar = makeVarName();
+                            os << "\n // Distance in vectors between '" << bgp->getGridName() <<
+                                "' vectors one apart in '" << dname << "'.\n";
+                            auto vp = printVecPointCall(os, *ngp, "getVecPtrNorm", "", "false", true);
+                            os << _linePrefix << "idx_t " << svar << " = " << vp <<
+                                " - " << aptr << _lineSuffix;
+                            strides[sname] = svar;
+                        }
+                        string ostr = _dims->makeNormStr(delta, dname);
+                        if (ostr[0] != '+' && ostr[0] != '-')
+                            ostr = "+" + ostr;
+                        oss << " " << ostr << " * " << strides.at(sname);
+                    }
+                    printPointComment(os, *bgp, "Calculate pointer to ");
+                    os << _linePrefix << getPtrType(*bgp) << " " << *p << " = " <<
+                        oss.str() << _lineSuffix;
+                }
 
                 // Print prefetch(es) for this ptr if a read.
                 if (_vv._alignedVecs.count(gp))
@@ -275,7 +340,8 @@ namespace yask {
         for (int level = 1; level <= 2; level++) {
 
             os << "\n // Prefetch to L" << level << " cache if enabled.\n";
-                os << _linePrefix << "#if PFD_L" << level << " > 0\n";
+                os << "#ifndef NO_PREFETCH\n" <<
+                    _linePrefix << "if (pfd_l" << level << " > 0) {\n";
 
                 // Loop thru vec ptrs.
                 for (auto vp : _vecPtrs) {
@@ -297,23 +363,108 @@ namespace yask {
 
                     // First offset.
                     if (ahead)
-                        os << "(PFD_L" << level << "*" << imult << ")" << right;
+                        os << "(pfd_l" << level << "*" << imult << ")" << right;
                     else
                         os << left;
 
                     // End of offsets.
                     os << "; ofs < ";
                     if (ahead)
-                        os << "((PFD_L" << level << "+1)*" << imult << ")" << right;
+                        os << "((pfd_l" << level << "+1)*" << imult << ")" << right;
                     else
-                        os << "(PFD_L" << level << "*" << imult << ")" << right;
+                        os << "(pfd_l" << level << "*" << imult << ")" << right;
 
                     // Continue loop.
                     os << "; ofs++)\n" <<
-                        _linePrefix << "  prefetch<L" << level << "_HINT>(&" << ptr <<
+                        _linePrefix << "  prefetch_rt(pfh_l" << level << ", &" << ptr <<
                         "[" << idim << " + ofs])" << _lineSuffix;
                 }
-                os << _linePrefix << "#endif // L" << level << " prefetch.\n";
+                os << _linePrefix << "}\n"
+                    "#endif // L" << level << " prefetch.\n";
+        }
+    }
+
+    // Print declarations and initial reads of aligned vectors that
+    // can be carried in registers to the next inner-loop iteration.
+    // A read at inner-dim offset 'ofs' is carried if there is also a read
+    // at 'ofs' + 'stepElems' via the same pointer, because that is the
+    // same vector after the loop index is incremented.
+    void CppVecPrintHelper::printCarriedReads(ostream& os, int stepElems,
+                                              const string& istop) {
+        const string& idim = _dims->_innerDim;
+
+        // Simple unaligned loads don't use the aligned vectors.
+        if (_allowUnalignedLoads)
+            return;
+
+        // Writes in this loop are not a hazard: a value written in one
+        // iteration and read in the next would make the results depend on
+        // the loop order, which is not allowed within a bundle.
+
+        // Aligned reads for each pointer, sorted by inner-dim offset.
+        map<string, map<int, GridPoint>> ptrReads;
+        for (auto& gp : _vv._alignedVecs) {
+            if (gp.getVecType() != GridPoint::VEC_FULL ||
+                gp.getLoopType() != GridPoint::LOOP_OFFSET)
+                continue;
+            auto bgp = makeBasePoint(gp);
+            auto* p = lookupPointPtr(*bgp);
+            if (!p)
+                continue;
+            auto* ofs = gp.getArgOffsets().lookup(idim);
+            if (!ofs)
+                continue;
+            ptrReads[*p].insert({*ofs, gp});
+        }
+
+        // Find reads that are reused in the next iteration.
+        // Order is important: each var must be copied before the one
+        // that feeds it is updated.
+        for (auto& pr : ptrReads) {
+            auto& reads = pr.second;
+            for (auto& ri : reads) {
+                auto next = reads.find(ri.first + stepElems);
+                if (next == reads.end())
+                    continue;
+                string vname = makeVarName();
+                _carriedVars[ri.second] = vname;
+                _carryNext.push_back({vname, next->second});
+            }
+        }
+        if (_carriedVars.size() == 0)
+            return;
+
+        // Declare vars.
+        os << "\n // " << _carriedVars.size() <<
+            " aligned vector-block(s) carried in registers across '" << idim << "' iterations.\n";
+        for (auto& cn : _carryNext)
+            os << _linePrefix << getVarType() << " " << cn.first << _lineSuffix;
+
+        // Read values for first iteration.
+        os << _linePrefix << "if (" << idim << " < " << istop << ") {\n";
+        for (auto& cv : _carriedVars) {
+            auto& gp = cv.first;
+            auto bgp = makeBasePoint(gp);
+            auto* p = lookupPointPtr(*bgp);
+            assert(p);
+            string ofsStr = gp.makeNormArgStr(idim, *_dims);
+            printPointComment(os, gp, "Read carried");
+            os << _linePrefix << cv.second << " = " <<
+                *p << "[" << ofsStr << "]" << _lineSuffix;
+        }
+        os << _linePrefix << "}\n";
+    }
+
+    // Print copies of vectors to be carried to the next iteration.
+    void CppVecPrintHelper::printCarryRotation(ostream& os) {
+        if (_carryNext.size() == 0)
+            return;
+        os << "\n // Carry vector-blocks to next iteration.\n";
+        for (auto& cn : _carryNext) {
+
+            // Normally already read in this iteration; reads it if not.
+            string src = readFromPoint(os, cn.second);
+            os << _linePrefix << cn.first << " = " << src << _lineSuffix;
         }
     }
 
@@ -326,7 +477,17 @@ namespace yask {
         // Ignore out-of-range errors because we might get a base pointer to an
         // element before the allocated range.
         auto vp = printVecPointCall(os, gp, "getVecPtrNorm", "", "false", true);
-        os << _linePrefix << getVarType() << "* " << ptrName << " = " << vp << _lineSuffix;
+        os << _linePrefix << getPtrType(gp) << " " << ptrName << " = " << vp << _lineSuffix;
+    }
+
+    // Type of a pointer to the vectors in the grid of 'gp'.
+    // Reads via pointers to 16-bit vectors are up-converted to
+    // getVarType() by the kernel.
+    string CppVecPrintHelper::getPtrType(const GridPoint& gp) const {
+        auto* grid = gp.getGrid();
+        if (grid->isHalf())
+            return "real_vec_" + grid->getHalfFormat() + "_t*";
+        return getVarType() + "*";
     }
 
     // Print any needed memory reads and/or constructions to 'os'.
@@ -338,6 +499,10 @@ namespace yask {
         if (_reuseVars && _vecVars.count(gp))
             codeStr = _vecVars[gp]; // do nothing.
 
+        // Carried from previous iteration?
+        else if (_carriedVars.count(gp))
+            codeStr = _carriedVars.at(gp);
+
         // Can we use a vec pointer?
         // Read must be aligned, and we must have a pointer.
         else if (_vv._alignedVecs.count(gp) &&
@@ -397,6 +562,10 @@ namespace yask {
                 // Output write using base addr.
                 printPointComment(os, gp, "Write aligned");
 
+                // Streaming store if allowed at run-time.
+                if (gp.getGrid()->isStreamable())
+                    os << _linePrefix << "if (use_nt_stores) " << val << ".storeTo_nt(" <<
+                        *p << "+" << ofs << "); else";
                 os << _linePrefix << val << ".storeTo_masked(" << *p << "+" << ofs << ", write_mask)" << _lineSuffix;
                 // without mask: os << _linePrefix << *p << "[" << ofs << "] = " << val << _lineSuffix;
 
@@ -100,6 +100,10 @@ namespace yask {
         map<string, int> _ptrOfsLo; // lowest read offset from _vecPtrs in inner dim.
         map<string, int> _ptrOfsHi; // highest read offset from _vecPtrs in inner dim.
 
+        // Vars for carrying aligned reads across inner-loop iterations.
+        map<GridPoint, string> _carriedVars; // carried reads. value: var name.
+        vector<pair<string, GridPoint>> _carryNext; // var and point that feeds it for next iter.
+
         // Element indices.
         string _elemSuffix = "_elem";
         VarMap _vec2elemMap; // maps vector indices to elem indices; filled by printElemIndices.
@@ -174,6 +178,15 @@ namespace yask {
         // Print code to set pointers of aligned reads.
         virtual void printBasePtrs(ostream& os);
 
+        // Print declarations and initial reads of aligned vectors that
+        // can be carried in registers to the next inner-loop iteration.
+        // 'stepElems': elements in inner dim per iteration.
+        // 'istop': name of var holding end of inner loop.
+        virtual void printCarriedReads(ostream& os, int stepElems, const string& istop);
+
+        // Print copies of vectors to be carried to the next iteration.
+        virtual void printCarryRotation(ostream& os);
+
         // Make base point (inner-dim index = 0).
         virtual GridPointPtr makeBasePoint(const GridPoint& gp) {
             GridPointPtr bgp = gp.cloneGridPoint();
@@ -207,6 +220,9 @@ namespace yask {
         // Print code to set ptrName to gp.
         virtual void printPointPtr(ostream& os, const string& ptrName, const GridPoint& gp);
 
+        // Type of a pointer to the vectors in the grid of 'gp'.
+        virtual string getPtrType(const GridPoint& gp) const;
+
         // Access cached values.
         virtual void savePointPtr(const GridPoint& gp, string var) {
             _vecPtrs[gp] = var;
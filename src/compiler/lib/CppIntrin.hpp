@@ -23,7 +23,7 @@ IN THE SOFTWARE.
 
 *****************************************************************************/
 
-// Support for vector code generation using 512-bit instrinsics.
+// Support for vector code generation using 128, 256 and 512-bit instrinsics.
 
 #ifndef CPPINTRIN_HPP
 #define CPPINTRIN_HPP
@@ -34,7 +34,7 @@ IN THE SOFTWARE.
 
 namespace yask {
 
-    // Add specialization for 256 and 512-bit intrinsics.
+    // Add specialization for 128, 256 and 512-bit intrinsics.
     class CppIntrinPrintHelper : public CppVecPrintHelper {
 
     protected:
@@ -191,6 +191,64 @@ namespace yask {
                                  varPrefix, varType, linePrefix, lineSuffix) { }
     };
 
+    // Specialization for ARM NEON.
+    // Masked ops are done w/bit-selects, and permutes w/table lookups.
+    class CppNeonPrintHelper : public CppIntrinPrintHelper {
+    protected:
+
+        // Try all applicable strategies.
+        virtual void tryStrategies(ostream& os,
+                                   const string& pvName,
+                                   size_t nelemsTarget,
+                                   const VecElemList& elems,
+                                   set<size_t>& doneElems,
+                                   const GridPointSet& alignedVecs) {
+            tryAlign(os, pvName, nelemsTarget, elems, doneElems, alignedVecs, true);
+            tryPerm1(os, pvName, nelemsTarget, elems, doneElems, alignedVecs);
+        }
+
+    public:
+        CppNeonPrintHelper(VecInfoVisitor& vv,
+                           bool allowUnalignedLoads,
+                           const Dimensions* dims,
+                           const CounterVisitor* cv,
+                           const string& varPrefix,
+                           const string& varType,
+                           const string& linePrefix,
+                           const string& lineSuffix) :
+            CppIntrinPrintHelper(vv, allowUnalignedLoads, dims, cv,
+                                 varPrefix, varType, linePrefix, lineSuffix) { }
+    };
+
+    // Specialization for ARM SVE.
+    // Masked ops use predicates. No 2-var permute because 'tbl2' needs SVE2.
+    class CppSvePrintHelper : public CppIntrinPrintHelper {
+    protected:
+
+        // Try all applicable strategies.
+        virtual void tryStrategies(ostream& os,
+                                   const string& pvName,
+                                   size_t nelemsTarget,
+                                   const VecElemList& elems,
+                                   set<size_t>& doneElems,
+                                   const GridPointSet& alignedVecs) {
+            tryAlign(os, pvName, nelemsTarget, elems, doneElems, alignedVecs, true);
+            tryPerm1(os, pvName, nelemsTarget, elems, doneElems, alignedVecs);
+        }
+
+    public:
+        CppSvePrintHelper(VecInfoVisitor& vv,
+                          bool allowUnalignedLoads,
+                          const Dimensions* dims,
+                          const CounterVisitor* cv,
+                          const string& varPrefix,
+                          const string& varType,
+                          const string& linePrefix,
+                          const string& lineSuffix) :
+            CppIntrinPrintHelper(vv, allowUnalignedLoads, dims, cv,
+                                 varPrefix, varType, linePrefix, lineSuffix) { }
+    };
+
     // Print KNC intrinsic code.
     class YASKKncPrinter : public YASKCppPrinter {
     protected:
@@ -210,6 +268,7 @@ namespace yask {
                            dims) { }
 
         virtual int num_vec_elems() const { return 64 / _settings._elem_bytes; }
+        virtual int num_vec_regs() const { return 32; }
 
         // Whether multi-dim folding is efficient.
         virtual bool is_folding_efficient() const { return true; }
@@ -233,6 +292,7 @@ namespace yask {
             YASKCppPrinter(stencil, eqBundles, eqBundlePacks, clusterEqBundles, dims) { }
 
         virtual int num_vec_elems() const { return 32 / _settings._elem_bytes; }
+        virtual int num_vec_regs() const { return 16; }
     };
 
     // Print 512-bit AVX intrinsic code.
@@ -254,6 +314,54 @@ namespace yask {
                            dims) { }
 
         virtual int num_vec_elems() const { return 64 / _settings._elem_bytes; }
+        virtual int num_vec_regs() const { return 32; }
+
+        // Whether multi-dim folding is efficient.
+        virtual bool is_folding_efficient() const { return true; }
+    };
+
+    // Print 128-bit ARM NEON intrinsic code.
+    class YASKNeonPrinter : public YASKCppPrinter {
+    protected:
+        virtual CppVecPrintHelper* newCppVecPrintHelper(VecInfoVisitor& vv,
+                                                        CounterVisitor& cv) {
+            return new CppNeonPrintHelper(vv, _settings._allowUnalignedLoads, _dims, &cv,
+                                          "temp", "real_vec_t", " ", ";\n");
+        }
+
+    public:
+        YASKNeonPrinter(StencilSolution& stencil,
+                        EqBundles& eqBundles,
+                        EqBundlePacks& eqBundlePacks,
+                        EqBundles& clusterEqBundles,
+                        const Dimensions* dims) :
+            YASKCppPrinter(stencil, eqBundles, eqBundlePacks, clusterEqBundles, dims) { }
+
+        virtual int num_vec_elems() const { return 16 / _settings._elem_bytes; }
+        virtual int num_vec_regs() const { return 32; }
+    };
+
+    // Print 512-bit ARM SVE intrinsic code.
+    // The kernel is built w/a fixed SVE length of 512 bits, e.g., for A64FX.
+    class YASKSvePrinter : public YASKCppPrinter {
+    protected:
+        virtual CppVecPrintHelper* newCppVecPrintHelper(VecInfoVisitor& vv,
+                                                        CounterVisitor& cv) {
+            return new CppSvePrintHelper(vv, _settings._allowUnalignedLoads, _dims, &cv,
+                                         "temp", "real_vec_t", " ", ";\n");
+        }
+
+    public:
+        YASKSvePrinter(StencilSolution& stencil,
+                       EqBundles& eqBundles,
+                       EqBundlePacks& eqBundlePacks,
+                       EqBundles& clusterEqBundles,
+                       const Dimensions* dims) :
+            YASKCppPrinter(stencil, eqBundles, eqBundlePacks, clusterEqBundles,
+                           dims) { }
+
+        virtual int num_vec_elems() const { return 64 / _settings._elem_bytes; }
+        virtual int num_vec_regs() const { return 32; }
 
         // Whether multi-dim folding is efficient.
         virtual bool is_folding_efficient() const { return true; }
@@ -287,6 +287,30 @@ namespace yask {
             // TODO: check to make sure cond1 depends only on indices.
         } // for all eqs.
 
+        // Find grids whose written values are not read in the same step.
+        // Writes to them can use streaming stores.
+        for (auto eq1 : getAll()) {
+            auto* og1 = outGrids.at(eq1.get());
+            og1->setStreamable(!og1->isScratch());
+        }
+        for (auto eq1 : getAll()) {
+            auto* eq1p = eq1.get();
+            auto* op1 = outPts.at(eq1p);
+            auto* og1 = outGrids.at(eq1p);
+            if (!og1->isStreamable())
+                continue;
+            auto* lofsp = op1->getArgOffsets().lookup(stepDim);
+            for (auto eq2 : getAll()) {
+                for (auto i2 : inPts.at(eq2.get())) {
+                    if (i2->getGrid() != og1)
+                        continue;
+                    auto* rofsp = i2->getArgOffsets().lookup(stepDim);
+                    if (!lofsp || !rofsp || *rofsp == *lofsp)
+                        og1->setStreamable(false);
+                }
+            }
+        }
+
         // 2. Check each pair of eqs.
         os << "Analyzing for dependencies...\n";
         for (auto eq1 : getAll()) {
@@ -501,6 +525,283 @@ namespace yask {
         }
     };
 
+    // Split eqs into interior and boundary variants.
+    void Eqs::splitInteriorEqs(BoolExprPtr interior,
+                               const map<Grid*, double>& vals,
+                               CompilerSettings& settings,
+                               Dimensions& dims,
+                               ostream& os) {
+        if (!settings._findDeps) {
+            os << "Not splitting equations into interior and boundary variants"
+                " because the dependency checker is disabled.\n";
+            return;
+        }
+
+        // Visit a copy of each eq; keep it if any grid read was replaced.
+        int nsplit = 0;
+        TpList orig = _all;
+        for (auto eq : orig) {
+            if (eq->isScratch())
+                continue;
+            auto ieq = eq->clone();
+            InteriorVisitor iv(vals, dims._domainDims);
+            ieq->accept(&iv);
+            if (!iv.getNumChanges())
+                continue;
+
+            // Interior variant is new; original becomes boundary variant.
+            auto cond = eq->getCond();
+            BoolExprPtr icond = interior->clone();
+            BoolExprPtr bcond = make_shared<NotExpr>(interior->clone());
+            if (cond) {
+                icond = make_shared<AndExpr>(cond->clone(), icond);
+                bcond = make_shared<AndExpr>(cond, bcond);
+            }
+            ieq->setCond(icond);
+            eq->setCond(bcond);
+            addItem(ieq);
+            nsplit++;
+#ifdef DEBUG_INTERIOR
+            cout << "Split into " << ieq->makeQuotedStr() << " and " <<
+                eq->makeQuotedStr() << endl;
+#endif
+        }
+        os << "Split " << nsplit << " equation(s) into interior and boundary variants.\n";
+    }
+
+    // Visitor that will shift each grid point by an offset.
+    class OffsetVisitor: public ExprVisitor {
+        IntTuple _ofs;
+
+    public:
+        OffsetVisitor(const IntTuple& ofs) :
+            _ofs(ofs) {}
+
+        // Visit a grid point.
+        virtual void visit(GridPoint* gp) {
+
+            // Shift grid _ofs points.
+            auto ofs0 = gp->getArgOffsets();
+            IntTuple new_loc = ofs0.addElements(_ofs, false);
+            gp->setArgOffsets(new_loc);
+        }
+    };
+
+    // Visitor for finding subexprs that are evaluated at more than one
+    // offset in the domain dims, e.g., 'a(x)*b(x)' and 'a(x+1)*b(x+1)'.
+    // Only proper subexprs that depend on the domain indices solely via
+    // simple offsets in grid points are considered.
+    class ScratchCandVisitor : public ExprVisitor {
+    public:
+
+        // A subexpr and where it is used.
+        struct Cand {
+            NumExprPtr expr;    // copy w/offsets relative to its anchor.
+            int numOps = 0;     // FP ops in one evaluation.
+            set<IntTuple> anchors; // distinct offsets at which it is evaluated.
+            vector<pair<NumExprPtr*, IntTuple>> uses; // ptr to each use and its anchor.
+        };
+
+        // Candidates keyed by the string of the relative expr.
+        map<string, Cand> _cands;
+
+    protected:
+        const IntTuple& _ddims;
+
+        // Results of the last node visited.
+        bool _ok = false;       // can be evaluated at any offset.
+        int _ops = 0;           // FP ops.
+        IntTuple _anchor;       // min offset in each domain dim used.
+
+        // Combine anchors, keeping the min in each dim.
+        IntTuple mergeAnchors(const IntTuple& a, const IntTuple& b) const {
+            IntTuple res;
+            for (auto& dim : _ddims.getDims()) {
+                auto& dname = dim.getName();
+                auto* ap = a.lookup(dname);
+                auto* bp = b.lookup(dname);
+                if (ap && bp)
+                    res.addDimBack(dname, min(*ap, *bp));
+                else if (ap)
+                    res.addDimBack(dname, *ap);
+                else if (bp)
+                    res.addDimBack(dname, *bp);
+            }
+            return res;
+        }
+
+        // Visit 'ep' and add it to the candidates if eligible.
+        void visitOperand(NumExprPtr& ep) {
+            ep->accept(this);
+            if (!_ok || _ops == 0 || _anchor.getNumDims() == 0)
+                return;
+
+            // Make a copy at the origin.
+            auto rel = ep->clone();
+            OffsetVisitor ov(_anchor.multElements(-1));
+            rel->accept(&ov);
+
+            auto& cand = _cands[rel->makeStr()];
+            if (!cand.expr) {
+                cand.expr = rel;
+                cand.numOps = _ops;
+            }
+            cand.anchors.insert(_anchor);
+            cand.uses.push_back({ &ep, _anchor });
+        }
+
+        // Visit operands and combine their results w/'numOps' for this node.
+        void visitOperands(const vector<NumExprPtr*>& ops, int numOps) {
+            bool ok = true;
+            IntTuple anchor;
+            for (auto* op : ops) {
+                visitOperand(*op);
+                ok = ok && _ok;
+                numOps += _ops;
+                anchor = mergeAnchors(anchor, _anchor);
+            }
+            _ok = ok;
+            _ops = numOps;
+            _anchor = anchor;
+        }
+
+    public:
+        ScratchCandVisitor(const IntTuple& ddims) :
+            _ddims(ddims) { }
+
+        // Leaf nodes.
+        virtual void visit(ConstExpr* ce) {
+            _ok = true;
+            _ops = 0;
+            _anchor.clear();
+        }
+        virtual void visit(CodeExpr* ce) {
+            _ok = false;
+            _ops = 0;
+            _anchor.clear();
+        }
+        virtual void visit(IndexExpr* ie) {
+            _ok = ie->getType() != DOMAIN_INDEX;
+            _ops = 0;
+            _anchor.clear();
+        }
+
+        // Every domain-dim arg must be a simple offset.
+        virtual void visit(GridPoint* gp) {
+            _ok = true;
+            _ops = 0;
+            _anchor.clear();
+            auto& ofs = gp->getArgOffsets();
+            for (auto gdim : gp->getGrid()->getDims()) {
+                if (gdim->getType() != DOMAIN_INDEX)
+                    continue;
+                auto& dname = gdim->getName();
+                auto* op = ofs.lookup(dname);
+                if (!op || !_ddims.lookup(dname))
+                    _ok = false;
+                else {
+                    IntTuple pt;
+                    pt.addDimBack(dname, *op);
+                    _anchor = mergeAnchors(_anchor, pt);
+                }
+            }
+        }
+
+        // Operators.
+        virtual void visit(UnaryNumExpr* ue) {
+            visitOperands({ &ue->getRhs() }, 1);
+        }
+        virtual void visit(BinaryNumExpr* be) {
+            visitOperands({ &be->getLhs(), &be->getRhs() }, 1);
+        }
+        virtual void visit(CommutativeExpr* ce) {
+            vector<NumExprPtr*> ops;
+            for (auto& op : ce->getOps())
+                ops.push_back(&op);
+            visitOperands(ops, int(ops.size()) - 1);
+        }
+
+        // Only the RHS is checked; it is not a candidate itself.
+        virtual void visit(EqualsExpr* ee) {
+            ee->getRhs()->accept(this);
+        }
+    };
+
+    // Replace subexprs that are evaluated at several offsets w/reads of new
+    // scratch grids. Cost per point w/o a scratch grid is 'ops' * 'n', where
+    // 'n' is the number of offsets. Cost w/a scratch grid is 'ops' to set it
+    // + 1 write + 'n' reads, doubled to allow for evaluation in its halos.
+    // The candidate w/the greatest savings is promoted until none is left.
+    void Eqs::promoteScratchExprs(CompilerSettings& settings,
+                                  Dimensions& dims,
+                                  ostream& os) {
+        if (!settings._findDeps) {
+            os << "Not promoting subexpressions to scratch grids"
+                " because the dependency checker is disabled.\n";
+            return;
+        }
+        if (_all.empty())
+            return;
+        auto* soln = _all.front()->getGrid()->getSoln();
+        auto& ddims = dims._domainDims;
+
+        // Index args for a point at the origin.
+        auto makeArgs = [&]() {
+            NumExprPtrVec args;
+            for (auto& dim : ddims.getDims())
+                args.push_back(make_shared<IndexExpr>(dim.getName(), DOMAIN_INDEX));
+            return args;
+        };
+
+        os << "\nSearching for subexpressions to promote to scratch grids...\n";
+        int npromoted = 0;
+        while (true) {
+            ScratchCandVisitor scv(ddims);
+            visitEqs(&scv);
+
+            // Find the candidate w/the greatest savings.
+            ScratchCandVisitor::Cand* best = 0;
+            int bestSavings = 0;
+            for (auto& i : scv._cands) {
+                auto& cand = i.second;
+                int n = int(cand.anchors.size());
+                int savings = cand.numOps * n - 2 * (cand.numOps + 1 + n);
+                if (savings > bestSavings) {
+                    best = &cand;
+                    bestSavings = savings;
+                }
+            }
+            if (!best)
+                break;
+
+            // Make a new scratch grid w/all the domain dims.
+            string gname;
+            int gnum = npromoted;
+            do {
+                gname = "auto_scratch_" + to_string(gnum++);
+            } while (soln->get_grid(gname));
+            IndexExprPtrVec gdims;
+            for (auto& dim : ddims.getDims())
+                gdims.push_back(make_shared<IndexExpr>(dim.getName(), DOMAIN_INDEX));
+            auto* grid = new Grid(gname, true, soln, gdims);
+
+            // Set it to the subexpr at the origin.
+            addItem(make_shared<EqualsExpr>(grid->makePoint(makeArgs()), best->expr));
+
+            // Replace each use w/a read of the grid at the use's offset.
+            for (auto& use : best->uses) {
+                auto gp = grid->makePoint(makeArgs());
+                gp->setArgOffsets(use.second);
+                *use.first = gp;
+            }
+            os << " Promoted a subexpression of " << best->numOps <<
+                " FP operation(s) evaluated at " << best->anchors.size() <<
+                " offset(s) to scratch grid '" << gname << "'.\n";
+            npromoted++;
+        }
+        os << "Promoted " << npromoted << " subexpression(s) to scratch grids.\n";
+    }
+
     // Determine which grid points can be vectorized.
     void Eqs::analyzeVec(const Dimensions& dims) {
 
@@ -759,24 +1060,6 @@ namespace yask {
         cv.printStats(os, msg);
     }
 
-    // Visitor that will shift each grid point by an offset.
-    class OffsetVisitor: public ExprVisitor {
-        IntTuple _ofs;
-
-    public:
-        OffsetVisitor(const IntTuple& ofs) :
-            _ofs(ofs) {}
-
-        // Visit a grid point.
-        virtual void visit(GridPoint* gp) {
-
-            // Shift grid _ofs points.
-            auto ofs0 = gp->getArgOffsets();
-            IntTuple new_loc = ofs0.addElements(_ofs, false);
-            gp->setArgOffsets(new_loc);
-        }
-    };
-
     // Replicate each equation at the non-zero offsets for
     // each vector in a cluster.
     void EqBundle::replicateEqsInCluster(Dimensions& dims)
@@ -919,13 +1202,14 @@ namespace yask {
     }
 
     // Divide all equations into eqBundles.
-    // Only process updates to grids in 'gridRegex'.
-    // 'targets': string provided by user to specify bundleing.
+    // Only process updates to grids in 'settings._gridRegex'.
+    // 'settings._eqBundleTargets': string provided by user to specify bundleing.
     void EqBundles::makeEqBundles(Eqs& allEqs,
-                                  const string& gridRegex,
-                                  const string& targets,
+                                  const CompilerSettings& settings,
                                   ostream& os)
     {
+        auto& gridRegex = settings._gridRegex;
+        auto& targets = settings._eqBundleTargets;
         os << "\nPartitioning " << allEqs.getNum() << " equation(s) into bundles...\n";
         //auto& stepDim = _dims->_stepDim;
 
@@ -991,6 +1275,10 @@ namespace yask {
             addEqToBundle(allEqs, eq, _basename_default);
         }
 
+        // Split bundles that are too large for the cache.
+        if (settings._autoBundle)
+            splitEqBundles(settings, os);
+
         os << "Finding transitive closure...\n";
         inherit_deps_from(allEqs);
 
@@ -1020,6 +1308,206 @@ namespace yask {
 
     }
 
+    // Grids read or written by a set of eqs, for estimating the memory
+    // traffic and cache footprint of a bundle.
+    // Each stream is a logical grid at one step index.
+    class BundleStreams {
+        const Dimensions* _dims;
+
+        // Min and max offsets in the domain dims for each stream.
+        map<string, pair<IntTuple, IntTuple>> _ins;
+        set<string> _outs;
+
+        // Key for the stream containing 'gp'.
+        string getKey(const GridPoint* gp) const {
+            string key = gp->makeLogicalGridStr();
+            auto* sofs = gp->getArgOffsets().lookup(_dims->_stepDim);
+            if (sofs)
+                key += "@" + to_string(*sofs);
+            return key;
+        }
+
+    public:
+        BundleStreams(const Dimensions& dims) :
+            _dims(&dims) { }
+
+        // Add the grid points in 'eq'.
+        void addEq(EqualsExprPtr eq) {
+            PointVisitor pv;
+            eq->accept(&pv);
+            _outs.insert(getKey(pv.getOutputPts().at(eq.get())));
+            for (auto* gp : pv.getInputPts().at(eq.get())) {
+                IntTuple ofs;
+                for (auto& dim : _dims->_domainDims.getDims()) {
+                    auto* op = gp->getArgOffsets().lookup(dim.getName());
+                    if (op)
+                        ofs.addDimBack(dim.getName(), *op);
+                }
+                auto key = getKey(gp);
+                if (_ins.count(key)) {
+                    auto& mm = _ins.at(key);
+                    mm.first = mm.first.minElements(ofs, false);
+                    mm.second = mm.second.maxElements(ofs, false);
+                } else
+                    _ins[key] = { ofs, ofs };
+            }
+        }
+
+        // Add the streams from 'other'.
+        void add(const BundleStreams& other) {
+            for (auto& i : other._ins) {
+                if (_ins.count(i.first)) {
+                    auto& mm = _ins.at(i.first);
+                    mm.first = mm.first.minElements(i.second.first, false);
+                    mm.second = mm.second.maxElements(i.second.second, false);
+                } else
+                    _ins.insert(i);
+            }
+            _outs.insert(other._outs.begin(), other._outs.end());
+        }
+
+        // Bytes in the working set of a block of 'blockSize' points in
+        // each domain dim, swept through the first domain dim. Each input
+        // needs enough planes for its stencil in that dim; each output
+        // needs one plane.
+        double getFootprint(int elemBytes, int blockSize) const {
+            auto& odim = _dims->_domainDims.getDimName(0);
+            double plane = pow(double(blockSize), _dims->_domainDims.getNumDims() - 1);
+            double bytes = _outs.size() * plane * elemBytes;
+            for (auto& i : _ins) {
+                double pts = 1.;
+                for (auto& dim : i.second.first.getDims()) {
+                    auto& dname = dim.getName();
+                    int ext = i.second.second[dname] - i.second.first[dname];
+                    pts *= (dname == odim) ? ext + 1 : blockSize + ext;
+                }
+                bytes += pts * elemBytes;
+            }
+            return bytes;
+        }
+
+        // Bytes read and written per point. If the footprint doesn't fit
+        // in 'cacheBytes', each input plane is read once for each use.
+        int getTraffic(int elemBytes, int blockSize, double cacheBytes) const {
+            int n = int(_outs.size());
+            if (getFootprint(elemBytes, blockSize) <= cacheBytes)
+                n += int(_ins.size());
+            else {
+                auto& odim = _dims->_domainDims.getDimName(0);
+                for (auto& i : _ins) {
+                    auto* minp = i.second.first.lookup(odim);
+                    n += minp ? i.second.second[odim] - *minp + 1 : 1;
+                }
+            }
+            return n * elemBytes;
+        }
+    };
+
+    // Split each bundle whose cache footprint is too large.
+    // Eqs in a bundle are independent, so they may be grouped in any way.
+    // Starting w/one group per eq, the pair of groups that saves the most
+    // traffic when fused is merged as long as that does not increase the
+    // traffic. Fusing saves reads of shared inputs, but if the fused
+    // footprint doesn't fit in the cache, the inputs' planes must be
+    // re-read. The footprint is estimated for a block of the default size
+    // used by the kernel.
+    void EqBundles::splitEqBundles(const CompilerSettings& settings,
+                                   ostream& os) {
+        const int blockSize = 32;
+        const double cacheBytes = settings._bundleCacheKB * 1024.;
+        const int elemBytes = settings._elem_bytes;
+
+        os << "Choosing bundles for a " << settings._bundleCacheKB <<
+            "KiB cache and a block size of " << blockSize << "...\n";
+        TpList newAll;
+        for (auto& eg : _all) {
+
+            // Scratch bundles must keep their halos the same.
+            if (eg->isScratch() || eg->getNumEqs() < 2) {
+                newAll.insert(eg);
+                continue;
+            }
+
+            // Start w/each eq in its own group.
+            vector<EqList> groups;
+            vector<BundleStreams> streams;
+            BundleStreams all(*_dims);
+            for (auto& eq : eg->getEqs()) {
+                groups.push_back(EqList());
+                groups.back().insert(eq);
+                streams.push_back(BundleStreams(*_dims));
+                streams.back().addEq(eq);
+                all.add(streams.back());
+            }
+            double fp0 = all.getFootprint(elemBytes, blockSize);
+            int traffic0 = all.getTraffic(elemBytes, blockSize, cacheBytes);
+
+            // Fuse groups while that does not increase traffic.
+            auto getTraffic = [&](const BundleStreams& bs) {
+                return bs.getTraffic(elemBytes, blockSize, cacheBytes);
+            };
+            while (groups.size() > 1) {
+                int bi = -1, bj = -1, bestSavings = -1;
+                for (size_t i = 0; i < groups.size(); i++) {
+                    for (size_t j = i + 1; j < groups.size(); j++) {
+                        BundleStreams fused = streams[i];
+                        fused.add(streams[j]);
+                        int savings = getTraffic(streams[i]) + getTraffic(streams[j]) -
+                            getTraffic(fused);
+                        if (savings > bestSavings) {
+                            bi = i;
+                            bj = j;
+                            bestSavings = savings;
+                        }
+                    }
+                }
+                if (bi < 0)
+                    break;
+                for (auto& eq : groups[bj])
+                    groups[bi].insert(eq);
+                streams[bi].add(streams[bj]);
+                groups.erase(groups.begin() + bj);
+                streams.erase(streams.begin() + bj);
+            }
+
+            // Greedy fusion may stop short of fusing everything even
+            // when that would be better, so compare to the original.
+            int traffic = 0;
+            for (auto& bs : streams)
+                traffic += getTraffic(bs);
+
+            os << " " << eg->getDescr() << ": " << eg->getNumEqs() <<
+                " equation(s), est. footprint " << int(fp0 / 1024.) << "KiB, " <<
+                traffic0 << " byte(s) per point.\n";
+            if (groups.size() == 1 || traffic >= traffic0) {
+                os << "  Fused all equations into one bundle.\n";
+                newAll.insert(eg);
+                continue;
+            }
+
+            // Make a bundle from each group.
+            for (size_t i = 0; i < groups.size(); i++) {
+                auto ne = make_shared<EqBundle>(*_dims, false);
+                ne->baseName = eg->baseName;
+                ne->index = i ? _indices[eg->baseName]++ : eg->index;
+                ne->cond = eg->cond;
+
+                // Keep original order of eqs.
+                for (auto& eq : eg->getEqs())
+                    if (groups[i].count(eq))
+                        ne->addEq(eq);
+                newAll.insert(ne);
+                os << "  Split " << ne->getNumEqs() << " equation(s) into " <<
+                    ne->getDescr(false) << ": est. footprint " <<
+                    int(streams[i].getFootprint(elemBytes, blockSize) / 1024.) <<
+                    "KiB, " << getTraffic(streams[i]) << " byte(s) per point.\n";
+            }
+            os << "  Total traffic reduced from " << traffic0 << " to " <<
+                traffic << " byte(s) per point.\n";
+        }
+        _all = newAll;
+    }
+
     // Apply optimizations according to the 'settings'.
     void EqBundles::optimizeEqBundles(CompilerSettings& settings,
                                     const string& descr,
@@ -1041,16 +1529,25 @@ namespace yask {
         if (settings._doComb) {
             opts.push_back(new CombineVisitor);
 
+            // Factor common coefficients out of the combined sums.
+            if (settings._doFactor)
+                opts.push_back(new FactorVisitor);
+
             // Do CSE again after combination.
             // TODO: do this only if the combination did something.
             if (settings._doCse)
                 opts.push_back(new CseVisitor);
         }
 
+        // CSE of operand pairs; must follow full CSE.
+        if (settings._doCse)
+            opts.push_back(new PairCseVisitor);
+
         // Apply opts.
         for (auto optimizer : opts) {
 
             visitEqs(optimizer);
+            optimizer->finishVisits();
             int numChanges = optimizer->getNumChanges();
             string odescr = "after applying " + optimizer->getName() + " to " +
                 descr + " equation-bundle(s)";
@@ -357,6 +357,22 @@ namespace yask {
                                 Dimensions& dims,
                                 std::ostream& os);
 
+        // Split each eq that reads a grid in 'vals' into an interior
+        // variant, where those reads are replaced by their values, and a
+        // boundary variant. See yc_solution::set_interior_domain().
+        virtual void splitInteriorEqs(BoolExprPtr interior,
+                                      const map<Grid*, double>& vals,
+                                      CompilerSettings& settings,
+                                      Dimensions& dims,
+                                      std::ostream& os);
+
+        // Replace subexprs evaluated at several offsets in the domain
+        // dims w/reads of new scratch grids where that is estimated to
+        // reduce the work per point.
+        virtual void promoteScratchExprs(CompilerSettings& settings,
+                                         Dimensions& dims,
+                                         std::ostream& os);
+
         // Determine which grid points can be vectorized.
         virtual void analyzeVec(const Dimensions& dims);
 
@@ -507,6 +523,11 @@ namespace yask {
                                    EqualsExprPtr eq,
                                    const string& baseName);
 
+        // Split bundles whose estimated cache footprint is too large.
+        // See 'CompilerSettings::_autoBundle'.
+        virtual void splitEqBundles(const CompilerSettings& settings,
+                                    std::ostream& os);
+
     public:
         EqBundles() {}
         EqBundles(const string& basename_default, Dimensions& dims) :
@@ -522,15 +543,15 @@ namespace yask {
         }
 
         // Separate a set of equations into eqBundles based
-        // on the target string.
+        // on the target string in 'settings._eqBundleTargets'.
         // Target string is a comma-separated list of key-value pairs, e.g.,
         // "eqBundle1=foo,eqBundle2=bar".
         // In this example, all eqs updating grid names containing 'foo' go in eqBundle1,
         // all eqs updating grid names containing 'bar' go in eqBundle2, and
         // each remaining eq goes into a separate eqBundle.
+        // Only eqs updating grids matching 'settings._gridRegex' are used.
         void makeEqBundles(Eqs& eqs,
-                           const string& gridRegex,
-                           const string& targets,
+                           const CompilerSettings& settings,
                            std::ostream& os);
 
         virtual const Grids& getOutputGrids() const {
@@ -36,6 +36,7 @@ IN THE SOFTWARE.
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
+#include <typeinfo>
 #include <cstdarg>
 #include <assert.h>
 #include <fstream>
@@ -454,9 +455,13 @@ namespace yask {
         virtual void accept(ExprVisitor* ev);
 
         // Check for equivalency.
+        // The types must match so that a binary expr, which is
+        // derived from this class, is not matched to a unary one,
+        // e.g., '-b' to 'a - b'.
         virtual bool isSame(const Expr* other) const {
             auto p = dynamic_cast<const UnaryExpr*>(other);
-            return p && _opStr == p->_opStr &&
+            return p && typeid(*this) == typeid(*other) &&
+                _opStr == p->_opStr &&
                 _rhs && _rhs->isSame(p->_rhs.get());
         }
     };
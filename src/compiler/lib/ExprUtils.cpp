@@ -26,6 +26,7 @@ IN THE SOFTWARE.
 //////////// Expression utilities /////////////
 
 #include "ExprUtils.hpp"
+#include "Grid.hpp"
 
 using namespace std;
 
@@ -69,6 +70,196 @@ namespace yask {
     }
 
 
+    void FactorVisitor::visit(CommutativeExpr* ce) {
+        auto& ops = ce->getOps();
+
+        // Visit ops first (depth-first).
+        for (auto& ep : ops) {
+            update(ep);
+        }
+
+        // Only factor sums.
+        if (ce->getOpStr() != AddExpr::opStr())
+            return;
+
+        // Repeat until no more common factors.
+        while (true) {
+
+            // Find the factor shared by the most product terms.
+            NumExprPtr best;
+            size_t bestNum = 1;
+            for (size_t i = 0; i < ops.size(); i++) {
+                auto mi = dynamic_pointer_cast<MultExpr>(ops[i]);
+                if (!mi || mi->getOps().size() < 2)
+                    continue;
+                for (auto& fi : mi->getOps()) {
+
+                    // Count later products that also contain 'fi'.
+                    size_t num = 1;
+                    for (size_t j = i + 1; j < ops.size(); j++) {
+                        auto mj = dynamic_pointer_cast<MultExpr>(ops[j]);
+                        if (!mj || mj->getOps().size() < 2)
+                            continue;
+                        for (auto& fj : mj->getOps()) {
+                            if (fj->isSame(fi)) {
+                                num++;
+                                break;
+                            }
+                        }
+                    }
+                    if (num > bestNum) {
+                        best = fi;
+                        bestNum = num;
+                    }
+                }
+            }
+            if (!best)
+                break;
+
+            // Move the remainder of each product containing 'best' into a new sum.
+            auto sum = make_shared<AddExpr>();
+            for (size_t i = 0; i < ops.size(); ) {
+                auto mi = dynamic_pointer_cast<MultExpr>(ops[i]);
+                bool found = false;
+                if (mi && mi->getOps().size() >= 2) {
+                    auto& mops = mi->getOps();
+                    for (size_t k = 0; k < mops.size(); k++) {
+                        if (mops[k]->isSame(best)) {
+
+                            // Make a new product w/o the factor.
+                            NumExprPtrVec rem(mops);
+                            rem.erase(rem.begin() + k);
+                            if (rem.size() == 1)
+                                sum->getOps().push_back(rem[0]);
+                            else {
+                                auto prod = make_shared<MultExpr>();
+                                prod->getOps() = rem;
+                                sum->getOps().push_back(prod);
+                            }
+                            found = true;
+                            break;
+                        }
+                    }
+                }
+                if (found)
+                    ops.erase(ops.begin() + i);
+                else
+                    i++;
+            }
+            assert(sum->getOps().size() == bestNum);
+
+            // Factor remaining terms of the new sum, e.g.,
+            // c*d*a + c*d*b => c*(d*a + d*b) => c*(d*(a + b)).
+            NumExprPtr rem = sum;
+            update(rem);
+
+            // Replace the terms w/'best * sum'.
+            auto prod = make_shared<MultExpr>();
+            prod->getOps().push_back(best);
+            prod->getOps().push_back(rem);
+            ops.push_back(prod);
+            _numChanges++;
+        }
+    }
+
+    // Repeatedly find the pair of operands that occurs in the most
+    // commutative exprs and replace it w/one shared expr.
+    void PairCseVisitor::finishVisits() {
+        typedef pair<Expr*, Expr*> OpPair;
+        auto makePair = [](const NumExprPtr& a, const NumExprPtr& b) {
+            return (a.get() < b.get()) ? OpPair(a.get(), b.get()) : OpPair(b.get(), a.get());
+        };
+
+        while (true) {
+
+            // Count the exprs containing each pair, separately for
+            // each operator. Also, find any existing 2-operand expr for
+            // each pair and whether any count is from a larger expr.
+            map<string, map<OpPair, int>> counts;
+            map<string, map<OpPair, CommutativeExprPtr>> exact;
+            map<string, set<OpPair>> inLarger;
+            for (auto& cep : _nodes) {
+                auto& ops = cep->getOps();
+                auto& opStr = cep->getOpStr();
+                set<OpPair> pairs;
+                for (size_t i = 0; i < ops.size(); i++)
+                    for (size_t j = i + 1; j < ops.size(); j++)
+                        pairs.insert(makePair(ops[i], ops[j]));
+                for (auto& op : pairs) {
+                    counts[opStr][op]++;
+                    if (ops.size() == 2)
+                        exact[opStr][op] = cep;
+                    else
+                        inLarger[opStr].insert(op);
+                }
+            }
+
+            // Find first pair w/the highest count, searching in visit order
+            // so that the output doesn't depend on addresses.
+            int bestNum = 1;
+            string bestOpStr;
+            OpPair best;
+            NumExprPtr bestA, bestB;
+            for (auto& cep : _nodes) {
+                auto& ops = cep->getOps();
+                auto& opStr = cep->getOpStr();
+                if (ops.size() < 3)
+                    continue;
+                for (size_t i = 0; i < ops.size(); i++)
+                    for (size_t j = i + 1; j < ops.size(); j++) {
+                        auto op = makePair(ops[i], ops[j]);
+                        int num = counts[opStr][op];
+                        if (num > bestNum && inLarger[opStr].count(op)) {
+                            bestNum = num;
+                            bestOpStr = opStr;
+                            best = op;
+                            bestA = ops[i];
+                            bestB = ops[j];
+                        }
+                    }
+            }
+            if (!bestA)
+                break;
+
+            // Use existing expr for the pair or make a new one.
+            CommutativeExprPtr pexpr;
+            if (exact[bestOpStr].count(best))
+                pexpr = exact[bestOpStr].at(best);
+            else {
+                if (bestOpStr == AddExpr::opStr())
+                    pexpr = make_shared<AddExpr>();
+                else
+                    pexpr = make_shared<MultExpr>();
+                pexpr->getOps().push_back(bestA);
+                pexpr->getOps().push_back(bestB);
+                _nodes.push_back(pexpr);
+            }
+
+            // Replace the pair in each larger expr.
+            for (auto& cep : _nodes) {
+                auto& ops = cep->getOps();
+                if (ops.size() < 3 || cep->getOpStr() != bestOpStr)
+                    continue;
+                auto ai = ops.end(), bi = ops.end();
+                for (auto oi = ops.begin(); oi != ops.end(); oi++) {
+                    if (ai == ops.end() && oi->get() == best.first)
+                        ai = oi;
+                    else if (bi == ops.end() && oi->get() == best.second)
+                        bi = oi;
+                }
+                if (ai == ops.end() || bi == ops.end())
+                    continue;
+
+                // Put the pair expr in place of the first operand.
+                if (bi < ai)
+                    swap(ai, bi);
+                *ai = pexpr;
+                ops.erase(bi);
+                _numChanges++;
+            }
+        }
+    }
+
     // If 'ep' has already been seen, just return true.
     // Else if 'ep' has a match, change pointer to that match, return true.
     // Else, return false.
@@ -78,15 +269,16 @@ namespace yask {
 #endif
 
         // Already visited this node?
-        if (_seen.count(ep)) {
+        if (_seen.count(ep.get())) {
 #if DEBUG_CSE >= 2
             cout << "  //** already seen '" << ep->makeStr() << "'@" << ep << endl;
 #endif
             return true;
         }
 
-        // Loop through nodes already seen.
-        for (auto& oep : _seen) {
+        // Loop through nodes already seen w/the same hash.
+        auto& bucket = _buckets[_hasher.getHash(ep.get())];
+        for (auto& oep : bucket) {
 #if DEBUG_CSE >= 3
             cout << "  //** comparing '" << ep->makeStr() << "'@" << ep <<
                 " to '" << oep->makeStr() << "'@" << oep << endl;
@@ -110,7 +302,123 @@ namespace yask {
 #if DEBUG_CSE >= 2
         cout << "  //** no match to " << ep->makeStr() << endl;
 #endif
-        _seen.insert(ep);
+        _seen.insert(ep.get());
+        bucket.push_back(ep);
         return false;
     }
+
+    // Get hash of 'ep', using the cached value if available.
+    size_t HashVisitor::getHash(Expr* ep) {
+        auto i = _hashes.find(ep);
+        if (i != _hashes.end())
+            return i->second;
+        ep->accept(this);
+        _hashes[ep] = _hash;
+        return _hash;
+    }
+
+    // Leaf nodes.
+    void HashVisitor::visit(ConstExpr* ce) {
+        _hash = combine(1, hash<double>()(ce->getNumVal()));
+    }
+    void HashVisitor::visit(CodeExpr* ce) {
+        _hash = combine(2, hash<string>()(ce->getCode()));
+    }
+    void HashVisitor::visit(IndexExpr* ie) {
+        _hash = combine(3, hash<string>()(ie->makeStr()));
+    }
+    void HashVisitor::visit(GridPoint* gp) {
+        _hash = combine(4, hash<string>()(gp->makeStr()));
+    }
+
+    // Operators.
+    void HashVisitor::visit(UnaryNumExpr* ue) {
+        size_t h = combine(5, hash<string>()(ue->getOpStr()));
+        _hash = combine(h, getHash(ue->getRhs().get()));
+    }
+    void HashVisitor::visit(BinaryNumExpr* be) {
+        size_t h = combine(6, hash<string>()(be->getOpStr()));
+        h = combine(h, getHash(be->getLhs().get()));
+        _hash = combine(h, getHash(be->getRhs().get()));
+    }
+
+    // Operands may be in any order, so their hashes are summed.
+    void HashVisitor::visit(CommutativeExpr* ce) {
+        auto& ops = ce->getOps();
+        size_t sum = 0;
+        for (auto& op : ops)
+            sum += combine(0, getHash(op.get()));
+        size_t h = combine(7, hash<string>()(ce->getOpStr()));
+        h = combine(h, ops.size());
+        _hash = combine(h, sum);
+    }
+
+    // Replace 'ep' if it is a grid read at the current point with a known
+    // interior value. Otherwise, visit it and fold the result.
+    void InteriorVisitor::update(NumExprPtr& ep) {
+
+        // Grid read w/zero offsets in all its domain dims?
+        auto gpp = dynamic_pointer_cast<GridPoint>(ep);
+        if (gpp) {
+            auto vi = _vals.find(gpp->getGrid());
+            if (vi == _vals.end())
+                return;
+            auto& ofss = gpp->getArgOffsets();
+            for (auto& dim : gpp->getGrid()->getDims()) {
+                auto& dname = dim->getName();
+                if (_domainDims.lookup(dname)) {
+                    auto* ofs = ofss.lookup(dname);
+                    if (!ofs || *ofs != 0)
+                        return;
+                }
+            }
+            ep = constNum(vi->second);
+            _numChanges++;
+            return;
+        }
+
+        // Update children first (depth-first).
+        ep->accept(this);
+
+        // Fold constant subexpr.
+        if (ep->isConstVal()) {
+            if (!dynamic_pointer_cast<ConstExpr>(ep))
+                ep = constNum(ep->getNumVal());
+            return;
+        }
+
+        // Remove identity operands, e.g., 'a * 1' => 'a' and 'a + 0' => 'a'.
+        auto cep = dynamic_pointer_cast<CommutativeExpr>(ep);
+        if (cep) {
+            bool is_mult = cep->getOpStr() == MultExpr::opStr();
+            double ident = is_mult ? 1.0 : 0.0;
+            auto& ops = cep->getOps();
+            for (size_t i = 0; i < ops.size(); ) {
+                if (ops[i]->isConstVal() && ops[i]->getNumVal() == ident)
+                    ops.erase(ops.begin() + i);
+
+                // Any zero in a product makes it zero.
+                else if (is_mult && ops[i]->isConstVal() && ops[i]->getNumVal() == 0.0) {
+                    ep = constNum(0.0);
+                    return;
+                }
+                else
+                    i++;
+            }
+            if (ops.size() == 0)
+                ep = constNum(ident);
+            else if (ops.size() == 1)
+                ep = ops[0];
+            return;
+        }
+
+        // Remove 'a - 0' and 'a / 1'.
+        auto sep = dynamic_pointer_cast<SubExpr>(ep);
+        if (sep && sep->getRhs()->isConstVal() && sep->getRhs()->getNumVal() == 0.0)
+            ep = sep->getLhs();
+        auto dep = dynamic_pointer_cast<DivExpr>(ep);
+        if (dep && dep->getRhs()->isConstVal() && dep->getRhs()->getNumVal() == 1.0)
+            ep = dep->getLhs();
+    }
+
 } // namespace yask.
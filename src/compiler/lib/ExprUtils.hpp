@@ -53,6 +53,10 @@ namespace yask {
         virtual const string& getName() const {
             return _name;
         }
+
+        // Called once after all equations have been visited,
+        // for optimizations that need to see all of them first.
+        virtual void finishVisits() { }
     };
 
     // A visitor that combines commutative exprs.
@@ -72,12 +76,78 @@ namespace yask {
     };
 
 
+    // A visitor that factors common coefficients out of sums of products.
+    // Example: c*a + c*b + d*e => c*(a + b) + d*e.
+    // Typically applied after commutative recombination so that
+    // sums and products are flattened.
+    class FactorVisitor : public OptVisitor {
+    protected:
+
+        // Visit 'ep'. Then, if it became a sum w/only one
+        // term, replace it w/that term.
+        virtual void update(NumExprPtr& ep) {
+            ep->accept(this);
+            auto cep = dynamic_pointer_cast<CommutativeExpr>(ep);
+            if (cep && cep->getOps().size() == 1)
+                ep = cep->getOps()[0];
+        }
+
+    public:
+        FactorVisitor()  :
+            OptVisitor("coefficient factoring") {}
+        virtual ~FactorVisitor() {}
+
+        virtual void visit(UnaryNumExpr* ue) {
+            update(ue->getRhs());
+        }
+        virtual void visit(BinaryNumExpr* be) {
+            update(be->getLhs());
+            update(be->getRhs());
+        }
+        virtual void visit(CommutativeExpr* ce);
+        virtual void visit(EqualsExpr* ee) {
+
+            // Only process RHS.
+            update(ee->getRhs());
+        }
+    };
+
+    // A visitor that computes structural hashes of numerical exprs.
+    // Exprs for which isSame() is true get the same hash, so only exprs
+    // w/equal hashes need to be compared. Hashes are cached by node, so
+    // the exprs must not be changed while this visitor is in use, except
+    // by replacing nodes w/ones that are the same.
+    class HashVisitor : public ExprVisitor {
+    protected:
+        unordered_map<const Expr*, size_t> _hashes;
+        size_t _hash = 0;       // result of last visit.
+
+        static size_t combine(size_t seed, size_t val) {
+            return seed ^ (val + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+        }
+
+    public:
+        virtual ~HashVisitor() {}
+
+        // Get hash of 'ep', using the cached value if available.
+        virtual size_t getHash(Expr* ep);
+
+        virtual void visit(ConstExpr* ce);
+        virtual void visit(CodeExpr* ce);
+        virtual void visit(IndexExpr* ie);
+        virtual void visit(GridPoint* gp);
+        virtual void visit(UnaryNumExpr* ue);
+        virtual void visit(BinaryNumExpr* be);
+        virtual void visit(CommutativeExpr* ce);
+    };
+
     // A visitor that eliminates common numerical subexprs.
-    // TODO: find matches to subsets of commutative operations;
-    // example: a+b+c * b+d+a => c+(a+b) * d+(a+b) w/expr a+b combined.
+    // Subsets of commutative operations are handled by PairCseVisitor.
     class CseVisitor : public OptVisitor {
     protected:
-        set<NumExprPtr> _seen;
+        unordered_set<Expr*> _seen; // nodes already visited.
+        unordered_map<size_t, vector<NumExprPtr>> _buckets; // seen nodes by hash.
+        HashVisitor _hasher;
 
         // If 'ep' has already been seen, just return true.
         // Else if 'ep' has a match, change pointer to that match, return true.
@@ -124,6 +194,93 @@ namespace yask {
         }
     };
 
+    // A visitor that eliminates common pairs of operands in commutative
+    // exprs across all the eqs visited, e.g., those from cluster replicas.
+    // Example: a+b+c * b+d+a => c+(a+b) * d+(a+b) w/expr a+b combined.
+    // Pairs are matched by address, so this should follow CseVisitor.
+    class PairCseVisitor : public OptVisitor {
+    protected:
+        typedef shared_ptr<CommutativeExpr> CommutativeExprPtr;
+
+        // Commutative exprs found, in visit order.
+        vector<CommutativeExprPtr> _nodes;
+        set<Expr*> _seen;
+
+        // Record 'ep' if it is a commutative expr and visit it.
+        virtual void add(NumExprPtr& ep) {
+            if (_seen.count(ep.get()))
+                return;
+            _seen.insert(ep.get());
+            ep->accept(this);
+            auto cep = dynamic_pointer_cast<CommutativeExpr>(ep);
+            if (cep)
+                _nodes.push_back(cep);
+        }
+
+    public:
+        PairCseVisitor()  :
+            OptVisitor("partial common subexpr elimination") {}
+        virtual ~PairCseVisitor() {}
+
+        virtual void visit(UnaryNumExpr* ue) {
+            add(ue->getRhs());
+        }
+        virtual void visit(BinaryNumExpr* be) {
+            add(be->getLhs());
+            add(be->getRhs());
+        }
+        virtual void visit(CommutativeExpr* ce) {
+            for (auto& ep : ce->getOps())
+                add(ep);
+        }
+        virtual void visit(EqualsExpr* ee) {
+
+            // Only process RHS.
+            add(ee->getRhs());
+        }
+
+        // Find and combine the common pairs.
+        virtual void finishVisits();
+    };
+
+    // A visitor that replaces reads of grids at the point being calculated
+    // with their values in the interior sub-domain and then folds any
+    // constant subexprs. Example: 'a * sponge(x, y, z)' => 'a' when
+    // 'sponge' is 1.0 in the interior. See Eqs::splitInteriorEqs().
+    class InteriorVisitor : public OptVisitor {
+    protected:
+        const map<Grid*, double>& _vals;
+        const IntTuple& _domainDims;
+
+        // Replace, visit and/or simplify the expr at 'ep'.
+        virtual void update(NumExprPtr& ep);
+
+    public:
+        InteriorVisitor(const map<Grid*, double>& vals,
+                        const IntTuple& domainDims) :
+            OptVisitor("interior specialization"),
+            _vals(vals), _domainDims(domainDims) {}
+        virtual ~InteriorVisitor() {}
+
+        // Update each child, since 'update()' may redirect its pointer.
+        virtual void visit(UnaryNumExpr* ue) {
+            update(ue->getRhs());
+        }
+        virtual void visit(BinaryNumExpr* be) {
+            update(be->getLhs());
+            update(be->getRhs());
+        }
+        virtual void visit(CommutativeExpr* ce) {
+            for (auto& ep : ce->getOps())
+                update(ep);
+        }
+        virtual void visit(EqualsExpr* ee) {
+
+            // Only process RHS.
+            update(ee->getRhs());
+        }
+    };
+
     // A visitor that can keep track of what's been visted.
     class TrackingVisitor : public ExprVisitor {
     protected:
@@ -0,0 +1,339 @@
+/*****************************************************************************
+
+YASK: Yet Another Stencil Kernel
+Copyright (c) 2014-2018, Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+
+*****************************************************************************/
+
+// Finite-difference coefficient generators.
+
+#include "yask_compiler_api.hpp"
+#include "common_utils.hpp"
+#include <cmath>
+#include <complex>
+
+using namespace std;
+
+namespace yask {
+
+    // Number of samples per radius used when fitting and evaluating over a band.
+    const int fd_fit_samples = 64;
+    const int fd_eval_samples = 2048;
+
+    // Check common args.
+    static void check_fd_args(int deriv_order, double max_wavenumber) {
+        if (deriv_order < 1)
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: derivative order " << deriv_order <<
+                                            " is not positive");
+        if (!(max_wavenumber > 0.0 && max_wavenumber <= 1.0))
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: max wavenumber " << max_wavenumber <<
+                                            " is not in (0, 1]");
+    }
+
+    // Smallest radius that supports a central operator of the given order.
+    static int min_fd_radius(int deriv_order) {
+        return (deriv_order + 1) / 2;
+    }
+
+    // Solve 'a * x = b' in-place by Gaussian elimination w/partial pivoting.
+    // Returns false if 'a' is singular.
+    static bool solve_dense(vector<vector<long double>>& a,
+                            vector<long double>& b) {
+        size_t n = b.size();
+        for (size_t c = 0; c < n; c++) {
+            size_t p = c;
+            for (size_t r = c + 1; r < n; r++)
+                if (fabsl(a[r][c]) > fabsl(a[p][c]))
+                    p = r;
+            if (a[p][c] == 0.0L)
+                return false;
+            swap(a[p], a[c]);
+            swap(b[p], b[c]);
+            for (size_t r = c + 1; r < n; r++) {
+                long double f = a[r][c] / a[c][c];
+                for (size_t k = c; k < n; k++)
+                    a[r][k] -= f * a[c][k];
+                b[r] -= f * b[c];
+            }
+        }
+        for (size_t c = n; c-- > 0; ) {
+            for (size_t k = c + 1; k < n; k++)
+                b[c] -= a[c][k] * b[k];
+            b[c] /= a[c][c];
+        }
+        return true;
+    }
+
+    // Minimize '|a * x - b|' by Householder QR, overwriting 'a' and 'b'.
+    // Returns false if 'a' is rank-deficient.
+    static bool solve_least_squares(vector<vector<long double>>& a,
+                                    vector<long double>& b,
+                                    vector<long double>& x) {
+        size_t nr = b.size();
+        size_t nc = nr ? a[0].size() : 0;
+        for (size_t c = 0; c < nc; c++) {
+            long double norm = 0.0L;
+            for (size_t r = c; r < nr; r++)
+                norm += a[r][c] * a[r][c];
+            norm = sqrtl(norm);
+            if (norm == 0.0L)
+                return false;
+            long double alpha = (a[c][c] > 0.0L) ? -norm : norm;
+
+            // Householder vector 'v' stored in column 'c' below the diagonal.
+            a[c][c] -= alpha;
+            long double vnorm2 = 0.0L;
+            for (size_t r = c; r < nr; r++)
+                vnorm2 += a[r][c] * a[r][c];
+            for (size_t k = c + 1; k < nc; k++) {
+                long double dot = 0.0L;
+                for (size_t r = c; r < nr; r++)
+                    dot += a[r][c] * a[r][k];
+                long double f = 2.0L * dot / vnorm2;
+                for (size_t r = c; r < nr; r++)
+                    a[r][k] -= f * a[r][c];
+            }
+            long double dot = 0.0L;
+            for (size_t r = c; r < nr; r++)
+                dot += a[r][c] * b[r];
+            long double f = 2.0L * dot / vnorm2;
+            for (size_t r = c; r < nr; r++)
+                b[r] -= f * a[r][c];
+            a[c][c] = alpha;
+        }
+
+        // Back-substitute with 'R'.
+        x.assign(nc, 0.0L);
+        for (size_t c = nc; c-- > 0; ) {
+            long double v = b[c];
+            for (size_t k = c + 1; k < nc; k++)
+                v -= a[c][k] * x[k];
+            x[c] = v / a[c][c];
+        }
+        return true;
+    }
+
+    // Taylor coefficients via Fornberg's algorithm,
+    // B. Fornberg, "Calculation of weights in finite difference
+    // formulas", SIAM Rev. 40(3), 1998.
+    vector<double>
+    yc_fd_coeff_factory::get_center_coefficients(int deriv_order,
+                                                 int radius) const {
+        check_fd_args(deriv_order, 1.0);
+        if (radius < min_fd_radius(deriv_order))
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: radius " << radius <<
+                                            " is too small for derivative order " << deriv_order);
+        int m = deriv_order;
+        int n = 2 * radius + 1;
+
+        // c[j][k]: weight of point j for derivative k.
+        vector<vector<long double>> c(n, vector<long double>(m + 1, 0.0L));
+        auto x = [&](int i) { return (long double)(i - radius); };
+        long double c1 = 1.0L, c4 = x(0);
+        c[0][0] = 1.0L;
+        for (int i = 1; i < n; i++) {
+            int mn = min(i, m);
+            long double c2 = 1.0L, c5 = c4;
+            c4 = x(i);
+            for (int j = 0; j < i; j++) {
+                long double c3 = x(i) - x(j);
+                c2 *= c3;
+                if (j == i - 1) {
+                    for (int k = mn; k >= 1; k--)
+                        c[i][k] = c1 * (k * c[i - 1][k - 1] - c5 * c[i - 1][k]) / c2;
+                    c[i][0] = -c1 * c5 * c[i - 1][0] / c2;
+                }
+                for (int k = mn; k >= 1; k--)
+                    c[j][k] = (c4 * c[j][k] - k * c[j][k - 1]) / c3;
+                c[j][0] = c4 * c[j][0] / c3;
+            }
+            c1 = c2;
+        }
+
+        vector<double> coeffs(n);
+        for (int i = 0; i < n; i++)
+            coeffs[i] = double(c[i][m]);
+        return coeffs;
+    }
+
+    // Least-squares fit of the operator's response to the exact one over
+    // the band, subject to the Taylor constraints for orders <= deriv_order.
+    // By symmetry, an even derivative has response 'c0 + 2 sum_r c_r cos(r w)'
+    // and an odd one 'i 2 sum_r c_r sin(r w)'; both should equal '(i w)^m'.
+    vector<double>
+    yc_fd_coeff_factory::get_optimized_coefficients(int deriv_order,
+                                                    int radius,
+                                                    double max_wavenumber) const {
+        check_fd_args(deriv_order, max_wavenumber);
+        if (radius < min_fd_radius(deriv_order))
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: radius " << radius <<
+                                            " is too small for derivative order " << deriv_order);
+        int m = deriv_order;
+        bool is_odd = m % 2 == 1;
+
+        // Unknowns: offsets 0..r for even, 1..r for odd.
+        int first = is_odd ? 1 : 0;
+        int nu = radius + 1 - first;
+
+        // Constraints: terms w^(2k) or w^(2k+1) up to w^m.
+        int nc = m / 2 + 1;
+        if (nc >= nu)
+            return get_center_coefficients(deriv_order, radius);
+        long double sign = ((m / 2) % 2) ? -1.0L : 1.0L;
+
+        // Response of basis function for offset 'r' (w/o the sign and i for odd).
+        auto basis = [&](int r, long double w) {
+            if (r == 0)
+                return 1.0L;
+            return 2.0L * (is_odd ? sinl(r * w) : cosl(r * w));
+        };
+
+        // Taylor constraints 'C x = d': coefficient of w^p for p = first, first+2, ..., m.
+        vector<vector<long double>> cmat(nc, vector<long double>(nu, 0.0L));
+        vector<long double> dvec(nc, 0.0L);
+        for (int k = 0; k < nc; k++) {
+            int p = 2 * k + first;
+            long double fact = 1.0L;
+            for (int q = 2; q <= p; q++)
+                fact *= q;
+            long double ksign = (k % 2) ? -1.0L : 1.0L;
+            for (int i = 0; i < nu; i++) {
+                int r = i + first;
+                cmat[k][i] = (r == 0) ? (p == 0 ? 1.0L : 0.0L) :
+                    2.0L * ksign * powl(r, p) / fact;
+            }
+            dvec[k] = (p == m) ? sign : 0.0L;
+        }
+
+        // Eliminate the first 'nc' unknowns: 'x_b = g - G x_f', where
+        // 'G = C_b^-1 C_f' and 'g = C_b^-1 d'.
+        int nf = nu - nc;
+        vector<vector<long double>> gmat(nc, vector<long double>(nf));
+        vector<long double> gvec;
+        for (int j = 0; j <= nf; j++) {
+            vector<vector<long double>> cb(nc, vector<long double>(nc));
+            vector<long double> rhs(nc);
+            for (int k = 0; k < nc; k++) {
+                for (int i = 0; i < nc; i++)
+                    cb[k][i] = cmat[k][i];
+                rhs[k] = (j < nf) ? cmat[k][nc + j] : dvec[k];
+            }
+            if (!solve_dense(cb, rhs))
+                return get_center_coefficients(deriv_order, radius);
+            if (j < nf)
+                for (int k = 0; k < nc; k++)
+                    gmat[k][j] = rhs[k];
+            else
+                gvec = rhs;
+        }
+
+        // Reduced least-squares problem for the relative error
+        // 'basis/target - 1' sampled over (0, max_wavenumber * pi].
+        long double wmax = max_wavenumber * M_PI;
+        int ns = fd_fit_samples * (radius + 1);
+        vector<vector<long double>> lhs(ns, vector<long double>(nf));
+        vector<long double> rhs(ns);
+        for (int s = 0; s < ns; s++) {
+            long double w = wmax * (s + 1) / ns;
+            long double t = sign * powl(w, m);
+            rhs[s] = 1.0L;
+            for (int j = 0; j < nf; j++)
+                lhs[s][j] = basis(nc + j + first, w) / t;
+            for (int k = 0; k < nc; k++) {
+                long double bk = basis(k + first, w) / t;
+                rhs[s] -= bk * gvec[k];
+                for (int j = 0; j < nf; j++)
+                    lhs[s][j] -= bk * gmat[k][j];
+            }
+        }
+        vector<long double> xf;
+        if (!solve_least_squares(lhs, rhs, xf))
+            return get_center_coefficients(deriv_order, radius);
+        vector<long double> x(nu);
+        for (int j = 0; j < nf; j++)
+            x[nc + j] = xf[j];
+        for (int k = 0; k < nc; k++) {
+            x[k] = gvec[k];
+            for (int j = 0; j < nf; j++)
+                x[k] -= gmat[k][j] * xf[j];
+        }
+
+        // Expand to all offsets.
+        vector<double> coeffs(2 * radius + 1, 0.0);
+        for (int i = 0; i < nu; i++) {
+            int r = i + first;
+            coeffs[radius + r] = double(x[i]);
+            coeffs[radius - r] = double(is_odd ? -x[i] : x[i]);
+        }
+        return coeffs;
+    }
+
+    // Max of '|response - (i w)^m| / w^m' over the band.
+    double
+    yc_fd_coeff_factory::get_max_error(const vector<double>& coeffs,
+                                       int deriv_order,
+                                       double max_wavenumber) const {
+        check_fd_args(deriv_order, max_wavenumber);
+        if (coeffs.size() % 2 != 1)
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: number of coefficients (" << coeffs.size() <<
+                                            ") is not odd");
+        int radius = int(coeffs.size() / 2);
+        int m = deriv_order;
+        double wmax = max_wavenumber * M_PI;
+        complex<double> im(0.0, 1.0);
+        double max_err = 0.0;
+        for (int s = 1; s <= fd_eval_samples; s++) {
+            double w = wmax * s / fd_eval_samples;
+            complex<double> resp = 0.0;
+            for (int r = -radius; r <= radius; r++)
+                resp += coeffs[radius + r] * exp(im * (r * w));
+            double mag = pow(w, m);
+            double err = abs(resp - pow(im * w, m)) / mag;
+            max_err = max(max_err, err);
+        }
+        return max_err;
+    }
+
+    // Search radii in increasing order.
+    vector<double>
+    yc_fd_coeff_factory::get_cheapest_coefficients(int deriv_order,
+                                                   double max_wavenumber,
+                                                   double max_error,
+                                                   int max_radius) const {
+        check_fd_args(deriv_order, max_wavenumber);
+        double best_err = -1.0;
+        for (int r = min_fd_radius(deriv_order); r <= max_radius; r++) {
+            auto opt = get_optimized_coefficients(deriv_order, r, max_wavenumber);
+            auto tay = get_center_coefficients(deriv_order, r);
+            double opt_err = get_max_error(opt, deriv_order, max_wavenumber);
+            double tay_err = get_max_error(tay, deriv_order, max_wavenumber);
+            if (min(opt_err, tay_err) <= max_error)
+                return (opt_err <= tay_err) ? opt : tay;
+            if (best_err < 0.0 || min(opt_err, tay_err) < best_err)
+                best_err = min(opt_err, tay_err);
+        }
+        FORMAT_AND_THROW_YASK_EXCEPTION("Error: no finite-difference operator for derivative order " <<
+                                        deriv_order << " up to radius " << max_radius <<
+                                        " has max error " << max_error << " or less up to wavenumber " <<
+                                        max_wavenumber << " of Nyquist; best found is " << best_err);
+    }
+
+} // namespace yask.
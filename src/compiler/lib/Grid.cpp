@@ -223,6 +223,7 @@ namespace yask {
         }
 
         // Update halo vals.
+        int nzDims = 0;
         for (auto& dim : offsets.getDims()) {
             auto& dname = dim.getName();
             int val = dim.getVal();
@@ -235,6 +236,8 @@ namespace yask {
 
             // Store abs value.
             val = abs(val);
+            if (val)
+                nzDims++;
 
             // Any existing value?
             auto* p = halos.lookup(dname);
@@ -249,6 +252,9 @@ namespace yask {
 
             // Else, current value is larger than val, so don't update.
         }
+
+        // Update exchange distance.
+        _maxExchDist = max(_maxExchDist, nzDims);
     }
 
     // Update const indices based on 'indices'.
@@ -57,6 +57,9 @@ namespace yask {
         // Whether this grid can be vector-folded.
         bool _isFoldable = false;
 
+        // Whether this grid is stored in bricks of vectors.
+        bool _isBricked = false;
+
         // Values below are computed based on equations.
 
         // Min and max const indices that are used to access each dim.
@@ -69,6 +72,19 @@ namespace yask {
         // TODO: keep separate halos for each equation bundle.
         map<bool, map<int, IntTuple>> _halos;
 
+        // Max number of domain dims with non-zero offsets in any access.
+        // MPI neighbors at a greater L1 distance need no halo data,
+        // e.g., 1 => no diagonal neighbors.
+        int _maxExchDist = 0;
+
+        // Whether writes may bypass the cache, i.e., no eq reads this
+        // grid at the step index where it is written.
+        bool _isStreamable = false;
+
+        // 16-bit storage format, "bf16" or "fp16", or empty to store
+        // elements as reals.
+        string _halfFormat;
+
     public:
         // Ctors.
         Grid(string name,
@@ -104,9 +120,22 @@ namespace yask {
             return nullptr;
         }
 
+        // Number of domain dims.
+        virtual int getNumDomainDims() const {
+            int n = 0;
+            for (auto d : _dims)
+                if (d->getType() == DOMAIN_INDEX)
+                    n++;
+            return n;
+        }
+
         // Temp grid?
         virtual bool isScratch() const { return _isScratch; }
 
+        // Streaming-store eligibility.
+        virtual bool isStreamable() const { return _isStreamable; }
+        virtual void setStreamable(bool streamable) { _isStreamable = streamable; }
+
         // Access to solution.
         virtual StencilSolution* getSoln() { return _soln; }
         virtual void setSoln(StencilSolution* soln) { _soln = soln; }
@@ -121,6 +150,17 @@ namespace yask {
             return _isFoldable;
         }
 
+        // Bricked layout.
+        // The inner dim is then not unit stride in vectors.
+        virtual bool isBricked() const { return _isBricked; }
+        virtual void setBricked(bool bricked) { _isBricked = bricked; }
+
+        // 16-bit storage.
+        // Only for foldable grids that are not written by any eq.
+        virtual bool isHalf() const { return _halfFormat.length() > 0; }
+        virtual const string& getHalfFormat() const { return _halfFormat; }
+        virtual void setHalfFormat(const string& fmt) { _halfFormat = fmt; }
+
         // Get min and max observed indices.
         virtual const IntTuple& getMinIndices() const { return _minIndices; }
         virtual const IntTuple& getMaxIndices() const { return _maxIndices; }
@@ -138,6 +178,9 @@ namespace yask {
             return halo;
         }
 
+        // Get the max L1 distance of neighbors that need halo data.
+        virtual int getMaxExchDist() const { return _maxExchDist; }
+
         // Get the max size in 'dim' of halo across all steps.
         virtual int getHaloSize(const string& dim, bool left) const {
             int h = 0;
@@ -328,6 +371,41 @@ namespace yask {
                 gp->setFolding(dims);
         }
 
+        // Use bricked layouts for foldable grids whose names match 'gridRegex'.
+        virtual void setBricking(const string& gridRegex) {
+            if (!gridRegex.length())
+                return;
+            regex gridx(gridRegex);
+            for (auto gp : *this)
+                gp->setBricked(gp->isFoldable() && gp->getDims().size() &&
+                               regex_search(gp->getName(), gridx));
+        }
+
+        // Store grids whose names match 'bf16Regex' or 'fp16Regex' in
+        // that 16-bit format. Only non-scratch foldable grids that are
+        // not in 'outGrids' are changed.
+        virtual void setHalfStorage(const string& bf16Regex,
+                                    const string& fp16Regex,
+                                    const Grids& outGrids,
+                                    ostream& os) {
+            for (int i = 0; i < 2; i++) {
+                auto& gridRegex = i ? fp16Regex : bf16Regex;
+                string fmt = i ? "fp16" : "bf16";
+                if (!gridRegex.length())
+                    continue;
+                regex gridx(gridRegex);
+                for (auto gp : *this) {
+                    if (!regex_search(gp->getName(), gridx))
+                        continue;
+                    if (gp->isScratch() || !gp->isFoldable() || outGrids.count(gp))
+                        os << "Notice: not storing grid '" << gp->getName() << "' in " << fmt <<
+                            " because it is not a vector-folded grid that is only read.\n";
+                    else
+                        gp->setHalfFormat(fmt);
+                }
+            }
+        }
+
     };
 
     // Settings for the compiler.
@@ -346,9 +424,19 @@ namespace yask {
         int _minExprSize = 2;
         bool _doCse = true;      // do common-subexpr elim.
         bool _doComb = true;    // combine commutative operations.
+        bool _doFactor = true;  // factor common coefficients from sums.
         bool _doOptCluster = true; // apply optimizations also to cluster.
+        bool _autoCluster = false; // choose fold & cluster automatically.
+        bool _slideVecs = true; // carry aligned reads across inner-loop iterations.
+        bool _reassoc = false; // print commutative ops as balanced trees.
+        bool _autoScratch = false; // promote repeated subexprs to scratch grids.
         string _eqBundleTargets;  // how to bundle equations.
+        bool _autoBundle = false; // split bundles by estimated cache footprint.
+        int _bundleCacheKB = 1024; // cache size for '_autoBundle'.
         string _gridRegex;       // grids to update.
+        string _brickGridRegex;  // grids to store in bricks.
+        string _bf16GridRegex;   // grids to store in bf16.
+        string _fp16GridRegex;   // grids to store in fp16.
         bool _findDeps = true;
     };
 
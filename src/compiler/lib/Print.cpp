@@ -127,19 +127,39 @@ namespace yask {
 
     // A commutative operator.
     void PrintVisitorTopDown::visit(CommutativeExpr* ce) {
-        _exprStr += "(";
         auto& ops = ce->getOps();
-        int opNum = 0;
-        for (auto ep : ops) {
-            if (opNum > 0)
-                _exprStr += " " + ce->getOpStr() + " ";
-            ep->accept(this);   // adds operand to _exprStr;
-            opNum++;
+        if (_settings._reassoc)
+            printBalancedOps(ce, 0, ops.size());
+        else {
+            _exprStr += "(";
+            int opNum = 0;
+            for (auto ep : ops) {
+                if (opNum > 0)
+                    _exprStr += " " + ce->getOpStr() + " ";
+                ep->accept(this);   // adds operand to _exprStr;
+                opNum++;
+            }
+            _exprStr += ")";
         }
-        _exprStr += ")";
         _numCommon += _ph.getNumCommon(ce);
     }
 
+    // Print 'n' operands of 'ce' starting at 'first' as a balanced tree.
+    // Example: 'a + b + c + d' is printed as '((a + b) + (c + d))'.
+    void PrintVisitorTopDown::printBalancedOps(CommutativeExpr* ce, size_t first, size_t n) {
+        auto& ops = ce->getOps();
+        if (n == 1) {
+            ops.at(first)->accept(this);
+            return;
+        }
+        size_t nleft = n / 2;
+        _exprStr += "(";
+        printBalancedOps(ce, first, nleft);
+        _exprStr += " " + ce->getOpStr() + " ";
+        printBalancedOps(ce, first + nleft, n - nleft);
+        _exprStr += ")";
+    }
+
     // An equals operator.
     void PrintVisitorTopDown::visit(EqualsExpr* ee) {
 
@@ -314,6 +334,13 @@ namespace yask {
         if (trySimplePrint(ce, false))
             return;
 
+        // Make balanced tree of assignments if reassociation is allowed.
+        if (_settings._reassoc) {
+            string exStr;
+            printBalancedOps(ce, 0, ce->getOps().size(), exStr);
+            return;
+        }
+
         // Make separate assignment for N-1 operands.
         // Example: 'a + b + c + d' might output the following:
         // temp1 = a + b;
@@ -358,6 +385,41 @@ namespace yask {
         // note: _exprStr contains result of last operation.
     }
 
+    // Print 'n' operands of 'ce' starting at 'first' as a balanced tree.
+    // Example: 'a + b + c + d' might output the following:
+    // temp1 = a + b;
+    // temp2 = c + d;
+    // temp3 = temp1 + temp2;
+    // This shortens the chain of dependent operations from N-1 to log2(N).
+    // Returns code for the result; sets 'exStr' to its description.
+    string PrintVisitorBottomUp::printBalancedOps(CommutativeExpr* ce, size_t first, size_t n,
+                                                  string& exStr) {
+        auto& ops = ce->getOps();
+
+        // One operand: eval it.
+        if (n == 1) {
+            auto& ep = ops.at(first);
+            ep->accept(this);
+            exStr = ep->makeStr();
+            return getExprStrAndClear();
+        }
+
+        // Eval each half.
+        size_t nleft = n / 2;
+        string lexStr, rexStr;
+        string lhs = printBalancedOps(ce, first, nleft, lexStr);
+        string rhs = printBalancedOps(ce, first + nleft, n - nleft, rexStr);
+        exStr = "(" + lexStr + ' ' + ce->getOpStr() + ' ' + rexStr + ")";
+
+        // Use whole expression only for the last step.
+        Expr* ex = (n == ops.size()) ? ce : NULL;
+
+        // Output this step.
+        makeNextTempVar(ex, exStr) << lhs << ' ' << ce->getOpStr() << ' ' <<
+            rhs << _ph.getLineSuffix();
+        return getExprStr();
+    }
+
     // An equality.
     void PrintVisitorBottomUp::visit(EqualsExpr* ee) {
 
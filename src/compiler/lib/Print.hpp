@@ -236,6 +236,7 @@ namespace yask {
 
         // A commutative operator.
         virtual void visit(CommutativeExpr* ce);
+        virtual void printBalancedOps(CommutativeExpr* ce, size_t first, size_t n);
 
         // An equals operator.
         virtual void visit(EqualsExpr* ee);
@@ -287,6 +288,8 @@ namespace yask {
 
         // A commutative operator.
         virtual void visit(CommutativeExpr* ce);
+        virtual string printBalancedOps(CommutativeExpr* ce, size_t first, size_t n,
+                                        string& exStr);
 
         // An equality.
         virtual void visit(EqualsExpr* ee);
@@ -430,6 +433,10 @@ namespace yask {
         // Whether multi-dim folding is efficient.
         virtual bool is_folding_efficient() const { return false; }
 
+        // Number of SIMD registers available.
+        // 0 => unknown.
+        virtual int num_vec_regs() const { return 0; }
+
         // Output to 'os'.
         virtual void print(ostream& os) =0;
 
@@ -70,12 +70,30 @@ namespace yask {
 
     // Create the intermediate data for printing.
     void StencilSolution::analyze_solution(int vlen,
-                                           bool is_folding_efficient) {
+                                           bool is_folding_efficient,
+                                           int nregs) {
 
         // Call the stencil 'define' method to create ASTs.
         // ASTs and grids can also be created via the APIs.
         define();
 
+        // Move repeated subexprs into scratch grids if requested.
+        if (_settings._autoScratch) {
+            ostringstream nos;
+            Dimensions dims0;
+            dims0.setDims(_grids, _settings, vlen, is_folding_efficient, nos);
+            _eqs.promoteScratchExprs(_settings, dims0, *_dos);
+        }
+
+        // Pick the fold and cluster if requested.
+        if (_settings._autoCluster) {
+            if (nregs > 0)
+                choose_fold_cluster(vlen, is_folding_efficient, nregs);
+            else
+                *_dos << "Notice: not choosing fold and cluster automatically because"
+                    " the number of SIMD registers is unknown for this format.\n";
+        }
+
         // Find all the stencil dimensions from the grids.
         // Create the final folds and clusters from the cmd-line options.
         _dims.setDims(_grids, _settings, vlen, is_folding_efficient, *_dos);
@@ -83,6 +101,13 @@ namespace yask {
         // Determine which grids can be folded.
         _grids.setFolding(_dims);
 
+        // Determine which grids are stored in bricks.
+        _grids.setBricking(_settings._brickGridRegex);
+
+        // Split equations into interior and boundary variants.
+        if (_interior && _interiorVals.size())
+            _eqs.splitInteriorEqs(_interior, _interiorVals, _settings, _dims, *_dos);
+
         // Determine which grid points can be vectorized and analyze inner-loop accesses.
         _eqs.analyzeVec(_dims);
         _eqs.analyzeLoop(_dims);
@@ -96,10 +121,13 @@ namespace yask {
         // Create equation bundles based on dependencies and/or target strings.
         _eqBundles.set_basename_default(_settings._eq_bundle_basename_default);
         _eqBundles.set_dims(_dims);
-        _eqBundles.makeEqBundles(_eqs, _settings._gridRegex,
-                                 _settings._eqBundleTargets, *_dos);
+        _eqBundles.makeEqBundles(_eqs, _settings, *_dos);
         _eqBundles.optimizeEqBundles(_settings, "scalar & vector", false, *_dos);
 
+        // Determine which grids are stored in 16 bits.
+        _grids.setHalfStorage(_settings._bf16GridRegex, _settings._fp16GridRegex,
+                              _eqBundles.getOutputGrids(), *_dos);
+
         // Separate bundles into packs.
         // These are used for tracking bundle inter-dependencies.
         _eqBundlePacks.makePacks(_eqBundles, *_dos);
@@ -116,6 +144,172 @@ namespace yask {
             _clusterEqBundles.optimizeEqBundles(_settings, "cluster", true, *_dos);
     }
 
+    // Estimate the cost of each candidate fold and cluster and keep the best.
+    // For each candidate, the eqs are vectorized and replicated across the
+    // cluster as in analyze_solution(), but w/o optimizations, which don't
+    // change the relative ranking much and would be slow.
+    // Cost per point = (aligned loads + unaligned constructions +
+    // scalar reads + FP ops) / points in cluster.
+    // Registers needed = aligned vectors used by more than one vector block,
+    // which must stay live between uses, + one result per cluster vector.
+    void StencilSolution::choose_fold_cluster(int vlen,
+                                              bool is_folding_efficient,
+                                              int nregs) {
+        ostringstream nos;      // discard output from trial analyses.
+
+        // Get the domain dims.
+        Dimensions dims0;
+        dims0.setDims(_grids, _settings, vlen, is_folding_efficient, nos);
+        auto& ddims = dims0._domainDims;
+        int ndims = ddims.getNumDims();
+
+        // Candidate folds: all power-of-2 shapes covering 'vlen',
+        // only 1-D ones if multi-dim folding isn't efficient,
+        // or just the one given by the user.
+        vector<IntTuple> folds;
+        if (vlen <= 1 || _settings._foldOptions.product() > 1)
+            folds.push_back(_settings._foldOptions);
+        else {
+            int lg = 0;
+            while ((1 << lg) < vlen)
+                lg++;
+            IntTuple shape = ddims;
+            shape.setValsSame(lg + 1); // exponents 0..lg.
+            shape.visitAllPoints([&](const IntTuple& pt, size_t idx) {
+                    IntTuple fold = pt;
+                    int nfd = 0;
+                    for (int i = 0; i < ndims; i++) {
+                        fold[i] = 1 << pt[i];
+                        if (fold[i] > 1)
+                            nfd++;
+                    }
+                    if (fold.product() == vlen && (is_folding_efficient || nfd <= 1))
+                        folds.push_back(fold);
+                    return true;
+                });
+        }
+
+        // Candidate cluster multipliers: 1, 2, or 4 in each dim, up to 8 total.
+        const int maxMult = 4, maxCluster = 8;
+        vector<IntTuple> clusters;
+        IntTuple cshape = ddims;
+        cshape.setValsSame(3);  // exponents 0..2.
+        cshape.visitAllPoints([&](const IntTuple& pt, size_t idx) {
+                IntTuple mults = pt;
+                for (int i = 0; i < ndims; i++)
+                    mults[i] = 1 << pt[i];
+                if (mults.product() <= maxCluster && mults.max() <= maxMult)
+                    clusters.push_back(mults);
+                return true;
+            });
+
+        // Smaller clusters first, so they win ties.
+        stable_sort(clusters.begin(), clusters.end(),
+                    [](const IntTuple& a, const IntTuple& b) {
+                        return a.product() < b.product();
+                    });
+
+        *_dos << "\nChoosing fold and cluster from " << folds.size() << " fold(s) and " <<
+            clusters.size() << " cluster(s) for " << nregs << " SIMD registers...\n";
+        bool found = false, bestFits = false;
+        double bestCost = 0.;
+        int bestRegs = 0;
+        IntTuple bestFold, bestCluster;
+        for (auto& fold : folds) {
+
+            // Clusters that need too many registers w/this fold.
+            // Any cluster at least as large in every dim will also.
+            vector<IntTuple> tooBig;
+            for (auto& mults : clusters) {
+                bool skip = false;
+                for (auto& tb : tooBig) {
+                    bool ge = true;
+                    for (int i = 0; i < ndims; i++)
+                        if (mults[i] < tb[i])
+                            ge = false;
+                    if (ge)
+                        skip = true;
+                }
+                if (skip)
+                    continue;
+
+                CompilerSettings settings = _settings;
+                settings._foldOptions = fold;
+                settings._clusterOptions = mults;
+                Dimensions dims;
+                dims.setDims(_grids, settings, vlen, is_folding_efficient, nos);
+                _grids.setFolding(dims);
+
+                // Copy the non-scratch eqs into one bundle and replicate them.
+                Eqs eqs;
+                eqs = _eqs;
+                eqs.analyzeVec(dims);
+                EqBundle eb(dims, false);
+                for (auto& eq : eqs.getAll())
+                    if (!eq->isScratch())
+                        eb.addEq(eq);
+                if (!eb.getNumEqs())
+                    continue;
+                eb.replicateEqsInCluster(dims);
+
+                // Collect stats.
+                VecInfoVisitor vv(dims);
+                eb.visitEqs(&vv);
+                CounterVisitor cv;
+                eb.visitEqs(&cv);
+
+                // Count uses of each aligned vector.
+                map<GridPoint, int> uses;
+                int nunaligned = 0;
+                for (auto& i : vv._vblk2avblks) {
+                    if (!vv._alignedVecs.count(i.first))
+                        nunaligned++;
+                    for (auto& avb : i.second)
+                        uses[avb]++;
+                }
+                int nregsNeeded = dims._clusterMults.product();
+                for (auto& i : uses)
+                    if (i.second > 1)
+                        nregsNeeded++;
+                int npts = dims._clusterPts.product();
+                double cost = double(vv.getNumAlignedVecs() + nunaligned +
+                                     vv._scalarPoints.size() + vv._nonVecPoints.size() +
+                                     cv.getNumOps()) / npts;
+                bool fits = nregsNeeded <= nregs;
+                if (!fits)
+                    tooBig.push_back(mults);
+
+                // Keep the cheapest that fits or, if none fit yet, the
+                // one w/the fewest registers.
+                bool better = !found ||
+                    (fits && (!bestFits || cost < bestCost)) ||
+                    (!fits && !bestFits &&
+                     (nregsNeeded < bestRegs || (nregsNeeded == bestRegs && cost < bestCost)));
+                if (better) {
+                    found = true;
+                    bestFits = fits;
+                    bestCost = cost;
+                    bestRegs = nregsNeeded;
+                    bestFold = dims._fold;
+                    bestCluster = dims._clusterMults;
+                }
+            }
+        }
+        if (!found) {
+            *_dos << "Notice: no equations to estimate; keeping fold and cluster options.\n";
+            return;
+        }
+        if (!bestFits)
+            *_dos << "Warning: every fold and cluster is estimated to need more than " <<
+                nregs << " SIMD registers; using the one that needs the fewest.\n";
+        *_dos << " Chose fold " << bestFold.makeDimValStr(" * ") <<
+            " and cluster " << bestCluster.makeDimValStr(" * ") <<
+            " w/an estimated " << bestCost << " loads & FP ops per point and " <<
+            bestRegs << " live SIMD registers.\n";
+        _settings._foldOptions = bestFold;
+        _settings._clusterOptions = bestCluster;
+    }
+
     // Format in given format-type.
     void StencilSolution::format(const string& format_type,
                                  yask_output_ptr output) {
@@ -136,6 +330,12 @@ namespace yask {
         else if (format_type == "avx512" || format_type == "avx512f")
             printer = new YASKAvx512Printer(*this, _eqBundles, _eqBundlePacks,
                                             _clusterEqBundles, &_dims);
+        else if (format_type == "neon")
+            printer = new YASKNeonPrinter(*this, _eqBundles, _eqBundlePacks,
+                                          _clusterEqBundles, &_dims);
+        else if (format_type == "sve")
+            printer = new YASKSvePrinter(*this, _eqBundles, _eqBundlePacks,
+                                         _clusterEqBundles, &_dims);
         else if (format_type == "dot")
             printer = new DOTPrinter(*this, _clusterEqBundles, false);
         else if (format_type == "dot-lite")
@@ -151,9 +351,10 @@ namespace yask {
         assert(printer);
         int vlen = printer->num_vec_elems();
         bool is_folding_efficient = printer->is_folding_efficient();
+        int nregs = printer->num_vec_regs();
 
         // Set data for equation bundles, dims, etc.
-        analyze_solution(vlen, is_folding_efficient);
+        analyze_solution(vlen, is_folding_efficient, nregs);
 
         // Create the output.
         *_dos << "\nGenerating '" << format_type << "' output...\n";
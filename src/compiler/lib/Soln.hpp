@@ -75,6 +75,11 @@ namespace yask {
         // generated code for this solution.
         ExtensionsList _extensions;
 
+        // Interior sub-domain and the values of grids in it.
+        // See set_interior_domain().
+        BoolExprPtr _interior;
+        map<Grid*, double> _interiorVals;
+
     private:
 
         // Intermediate data needed to format output.
@@ -85,7 +90,14 @@ namespace yask {
 
         // Create the intermediate data.
         void analyze_solution(int vlen,
-                              bool is_folding_efficient);
+                              bool is_folding_efficient,
+                              int nregs = 0);
+
+        // Set the fold and cluster options to the combination with the
+        // lowest estimated cost per point that fits in 'nregs' registers.
+        void choose_fold_cluster(int vlen,
+                                 bool is_folding_efficient,
+                                 int nregs);
 
     public:
         StencilSolution(const string& name) :
@@ -189,6 +201,14 @@ namespace yask {
         virtual void clear_dependencies() {
             _eqs.getDeps().clear_deps();
         }
+        virtual void set_interior_domain(yc_bool_node_ptr interior) {
+            _interior = dynamic_pointer_cast<BoolExpr>(interior);
+        }
+        virtual void set_interior_grid_value(yc_grid_ptr grid, double value) {
+            auto gp = dynamic_cast<Grid*>(grid);
+            assert(gp);
+            _interiorVals[gp] = value;
+        }
 
         virtual void set_fold_len(const yc_index_node_ptr, int len);
         virtual void clear_folding() { _settings._foldOptions.clear(); }
@@ -167,7 +167,8 @@ namespace yask {
         }
 
         // Unaligned loads allowed?
-        else if (_allowUnalignedLoads) {
+        // Not from 16-bit grids, which must be converted by vector.
+        else if (_allowUnalignedLoads && !gp.getGrid()->isHalf()) {
 #ifdef DEBUG_GP
             cout << " //** reading from point " << gp.makeStr() << " as fully vectorized and unaligned.\n";
 #endif
@@ -29,6 +29,35 @@ IN THE SOFTWARE.
 
 namespace yask {
 
+    // A visitor to collect the unique grid points accessed by a bundle in
+    // order of first access. Used to describe the accesses to the kernel's
+    // cache simulator.
+    class AccessVisitor : public ExprVisitor {
+        set<string> _seen;
+
+        void _add(GridPoint* gp, bool is_write) {
+            string key = gp->makeStr() + (is_write ? " w" : " r");
+            if (_seen.count(key))
+                return;
+            _seen.insert(key);
+            _accesses.push_back(make_pair(gp, is_write));
+        }
+
+    public:
+        // Each point and whether it is written.
+        vector<pair<GridPoint*, bool>> _accesses;
+
+        virtual void visit(GridPoint* gp) {
+            _add(gp, false);
+        }
+
+        // Visit the RHS before the LHS, which is written last.
+        virtual void visit(EqualsExpr* ee) {
+            ee->getRhs()->accept(this);
+            _add(ee->getLhs().get(), true);
+        }
+    };
+
     // Print extraction of indices.
     void YASKCppPrinter::printIndices(ostream& os) const {
         os << endl << " // Extract individual indices.\n";
@@ -214,17 +243,25 @@ namespace yask {
                 os << "updated by one or more equations.\n";
             else
                 os << "not updated by any equation (read-only).\n";
+            if (gp->isHalf())
+                os << " // It is stored in " << gp->getHalfFormat() << " format.\n";
 
             // Type name for grid.
             string typeName;
 
             // Use vector-folded layout if possible.
             bool folded = gp->isFoldable();
-            string gtype = folded ? "YkVecGrid" : "YkElemGrid";
+            string gtype = folded ? (gp->isHalf() ? "YkHalfVecGrid" : "YkVecGrid") : "YkElemGrid";
+
+            // Use bricked layout if requested.
+            bool bricked = gp->isBricked();
 
             // Type-name in kernel is 'GRID_TYPE<LAYOUT, WRAP_1ST_IDX, VEC_LENGTHS...>'.
             ostringstream oss;
-            oss << gtype << "<Layout_";
+            oss << gtype << "<";
+            if (bricked)
+                oss << "LayoutBrick<";
+            oss << "Layout_";
             int step_posn = 0;
             int inner_posn = 0;
             vector<int> vlens;
@@ -287,6 +324,8 @@ namespace yask {
             // Scalar.
             else
                 oss << "0d"; // Trivial scalar layout.
+            if (bricked)
+                oss << ">";
 
             // Add wrapping flag.
             if (step_posn)
@@ -294,6 +333,10 @@ namespace yask {
             else
                 oss << ", false";
 
+            // Add 16-bit format flag.
+            if (gp->isHalf())
+                oss << (gp->getHalfFormat() == "bf16" ? ", true" : ", false");
+
             // Add vec lens.
             if (folded) {
                 for (auto i : vlens)
@@ -331,6 +374,17 @@ namespace yask {
                     " " << typeDef << "* " << grid << ";\n";
             }
 
+            // L1 distance of neighbor ranks needing halo data, or
+            // all neighbors if the halo size is forced.
+            if (gp->getNumDomainDims()) {
+                string dvar = grid + "_max_exch_dist";
+                int dval = _settings._haloSize > 0 ?
+                    gp->getNumDomainDims() : gp->getMaxExchDist();
+                os << " const int " << dvar << " = " << dval <<
+                    "; // max L1 distance of neighbor ranks that need halo data.\n";
+                initCode += " " + grid + "_ptr->set_max_exch_dist(" + dvar + ");\n";
+            }
+
             // Alloc-setting code.
             for (auto& dim : gp->getDims()) {
                 auto& dname = dim->getName();
@@ -511,6 +565,43 @@ namespace yask {
                     else
                         os << "  outputGridPtrs.push_back(_context->" << gp->getName() << "_ptr);\n";
                 }
+
+                // Accesses for the cache simulator. Offsets are given for
+                // stencil dims and constant indices for misc dims. Points in
+                // scratch grids and points with other index exprs are omitted.
+                os << "\n // The following points are accessed by " << egsName <<
+                    " relative to the point being calculated.\n";
+                AccessVisitor av;
+                eq->visitEqs(&av);
+                for (auto& ai : av._accesses) {
+                    auto* gp = ai.first;
+                    auto* grid = gp->getGrid();
+                    if (grid->isScratch())
+                        continue;
+                    auto& ofss = gp->getArgOffsets();
+                    auto& consts = gp->getArgConsts();
+                    string args;
+                    bool ok = true;
+                    for (auto& gdim : grid->getDims()) {
+                        auto& dname = gdim->getName();
+                        const int* vp = 0;
+                        if (_dims->_stencilDims.lookup(dname))
+                            vp = ofss.lookup(dname);
+                        else
+                            vp = consts.lookup(dname);
+                        if (!vp) {
+                            ok = false;
+                            break;
+                        }
+                        if (args.length())
+                            args += ", ";
+                        args += to_string(*vp);
+                    }
+                    if (ok)
+                        os << "  _accesses.push_back({ _context->" << grid->getName() <<
+                            "_ptr, { " << args << " }, " <<
+                            (ai.second ? "true" : "false") << " }); // " << gp->makeStr() << ".\n";
+                }
                 os << " } // Ctor." << endl;
             }
 
@@ -526,6 +617,46 @@ namespace yask {
                 else
                     os << " return true; // full domain." << endl;
                 os << " }" << endl;
+
+                // Mask version for one vector.
+                os << endl << " // Determine where " << egsName << " is valid in the vector whose\n"
+                    " // first element is at the global indices " <<
+                    _dims->_stencilDims.makeDimStr() << ".\n"
+                    " // Return a write mask with one bit set for each valid element.\n"
+                    " virtual idx_t get_valid_mask(const Indices& idxs) const final {\n";
+                if (eq->cond.get()) {
+                    os << " auto is_valid = [&](";
+                    int i = 0;
+                    for (auto& dim : _dims->_stencilDims.getDims()) {
+                        if (i++)
+                            os << ", ";
+                        os << "idx_t " << dim.getName();
+                    }
+                    os << ") -> bool {\n"
+                        "  return " << eq->cond->makeStr() << ";\n"
+                        " };\n"
+                        " idx_t mask = 0;\n";
+                    _dims->_fold.visitAllPoints([&](const IntTuple& vecPoint, size_t idx) {
+                            os << " if (is_valid(";
+                            int i = 0;
+                            for (auto& dim : _dims->_stencilDims.getDims()) {
+                                auto& dname = dim.getName();
+                                if (i)
+                                    os << ", ";
+                                os << "idxs[" << i << "]";
+                                auto* p = vecPoint.lookup(dname);
+                                if (p && *p)
+                                    os << " + " << *p;
+                                i++;
+                            }
+                            os << ")) mask |= idx_t(1) << " << idx << ";\n";
+                            return true;
+                        });
+                    os << " return mask;\n";
+                }
+                else
+                    os << " return idx_t(-1); // full domain." << endl;
+                os << " }" << endl;
             }
 
             // Scalar code.
@@ -622,6 +753,14 @@ namespace yask {
                 os << " idx_t " << iestep << " = " << nelems << "; // number of elements per iter.\n";
                 if (do_cluster)
                     os << " idx_t write_mask = idx_t(-1); // no masking for clusters.\n";
+                os << " bool use_nt_stores = _context->use_nt_stores()" <<
+                    (do_cluster ? "" : " && write_mask == idx_t(-1)") <<
+                    "; // streaming stores need whole vectors.\n";
+                os << " auto& opts = _context->get_settings();\n"
+                    " const int pfd_l1 = opts->_prefetch_L1_dist; // prefetch distances.\n"
+                    " const int pfd_l2 = opts->_prefetch_L2_dist;\n"
+                    " const int pfh_l1 = opts->_prefetch_L1_hint; // prefetch hints.\n"
+                    " const int pfh_l2 = opts->_prefetch_L2_hint;\n";
 
                 // C++ vector print assistant.
                 CppVecPrintHelper* vp = newCppVecPrintHelper(vv, cv);
@@ -641,6 +780,14 @@ namespace yask {
                 // Print pointers and prefetches.
                 vp->printBasePtrs(os);
 
+                // Print reads to be reused in next iteration.
+                if (_settings._slideVecs) {
+                    int stepElems = _dims->_fold[idim];
+                    if (do_cluster)
+                        stepElems *= _dims->_clusterMults[idim];
+                    vp->printCarriedReads(os, stepElems, istop);
+                }
+
                 // Actual Loop.
                 os << "\n // Inner loop.\n"
                     " for (idx_t " << idim << " = " << istart << "; " <<
@@ -653,6 +800,9 @@ namespace yask {
                 PrintVisitorBottomUp pcv(os, *vp, _settings);
                 vceq->visitEqs(&pcv);
 
+                // Update vars carried to next iteration.
+                vp->printCarryRotation(os);
+
                 // Insert prefetches using vars stored in print helper for next iteration.
                 vp->printPrefetches(os, true);
 
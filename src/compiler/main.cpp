@@ -82,6 +82,16 @@ void usage(const string& cmd) {
         " -grids <regex>\n"
         "    Only process updates to grids whose names match <regex>.\n"
         "      This can be used to generate code for a subset of the stencil equations.\n"
+        " -brick-grids <regex>\n"
+        "    Use bricked memory layouts for vector-folded grids whose names match <regex>.\n"
+        "      This allows the kernel to store small n-D bricks of vectors contiguously;\n"
+        "      see the kernel's '-brick' options and yk_grid::set_brick_size().\n"
+        " -bf16-grids <regex>\n"
+        " -fp16-grids <regex>\n"
+        "    Store vector-folded grids whose names match <regex> with 16 bits per element.\n"
+        "      Values are converted to the -elem-bytes precision when read, so this\n"
+        "      reduces memory and bandwidth for coefficients that tolerate fewer bits.\n"
+        "      Only applies to grids that are not updated by any equation.\n"
         " -eq-bundles <name>=<regex>,...\n"
         "    Put updates to grids matching <regex> in equation-bundle with base-name <name>.\n"
         "      By default, eq-bundles are created as needed based on dependencies between equations:\n"
@@ -117,10 +127,39 @@ void usage(const string& cmd) {
         "        the memory layout used by YASK must have that same dimension in unit stride.\n"
         " [-no]-opt-comb\n"
         "    Do [not] combine commutative operations (default=" << settings._doComb << ").\n"
+        " [-no]-opt-factor\n"
+        "    Do [not] factor common coefficients out of sums (default=" << settings._doFactor << ").\n"
+        "      Requires commutative combination.\n"
         " [-no]-opt-cse\n"
         "    Do [not] eliminate common subexpressions (default=" << settings._doCse << ").\n"
         " [-no]-opt-cluster\n"
         "    Do [not] apply optimizations across the cluster (default=" << settings._doOptCluster << ").\n"
+        " [-no]-auto-cluster\n"
+        "    Do [not] choose the fold and cluster sizes automatically (default=" <<
+        settings._autoCluster << ").\n"
+        "      Picks the combination w/the fewest estimated loads and FP ops per point\n"
+        "      that does not need more SIMD registers than the print format provides.\n"
+        "      Any fold given via -fold is kept; only the cluster is chosen.\n"
+        " [-no]-auto-bundle\n"
+        "    Do [not] split equation-bundles by estimated cache footprint (default=" <<
+        settings._autoBundle << ").\n"
+        "      Independent equations are grouped to minimize memory traffic while\n"
+        "        keeping the footprint of each bundle in a default-sized block within the cache.\n"
+        " -bundle-cache-kb <size>\n"
+        "    Set cache size in KiB used by -auto-bundle (default=" << settings._bundleCacheKB << ").\n"
+        " [-no]-auto-scratch\n"
+        "    Do [not] promote subexpressions evaluated at several offsets to scratch grids (default=" <<
+        settings._autoScratch << ").\n"
+        "      A subexpression is promoted when its estimated cost at all its offsets\n"
+        "        exceeds the cost of setting and reading a new scratch grid.\n"
+        " [-no]-reassoc\n"
+        "    Do [not] reassociate commutative operations into balanced trees (default=" <<
+        settings._reassoc << ").\n"
+        "      Shortens chains of dependent operations, but results may not be\n"
+        "        bitwise identical to those using the original operation order.\n"
+        " [-no]-slide\n"
+        "    Do [not] carry aligned vectors in registers across inner-loop iterations (default=" <<
+        settings._slideVecs << ").\n"
         " -max-es <num-nodes>\n"
         "    Set heuristic for max single expression-size (default=" << settings._maxExprSize << ").\n"
         " -min-es <num-nodes>\n"
@@ -136,6 +175,8 @@ void usage(const string& cmd) {
         "      avx2      YASK stencil classes for CORE AVX2 ISA (256-bit HW SIMD vectors).\n"
         "      avx512    YASK stencil classes for CORE AVX-512 & MIC AVX-512 ISAs (512-bit HW SIMD vectors).\n"
         "      knc       YASK stencil classes for KNC ISA (512-bit HW SIMD vectors).\n"
+        "      neon      YASK stencil classes for ARM NEON ISA (128-bit HW SIMD vectors).\n"
+        "      sve       YASK stencil classes for ARM SVE ISA (512-bit HW SIMD vectors).\n"
         "      pseudo    Human-readable scalar pseudo-code for one point.\n"
         "      dot       DOT-language description.\n"
         "      dot-lite  DOT-language description of grid accesses only.\n"
@@ -177,6 +218,10 @@ void parseOpts(int argc, const char* argv[])
                 settings._doComb = true;
             else if (opt == "-no-opt-comb")
                 settings._doComb = false;
+            else if (opt == "-opt-factor")
+                settings._doFactor = true;
+            else if (opt == "-no-opt-factor")
+                settings._doFactor = false;
             else if (opt == "-opt-cse")
                 settings._doCse = true;
             else if (opt == "-no-opt-cse")
@@ -185,6 +230,26 @@ void parseOpts(int argc, const char* argv[])
                 settings._doOptCluster = true;
             else if (opt == "-no-opt-cluster")
                 settings._doOptCluster = false;
+            else if (opt == "-auto-cluster")
+                settings._autoCluster = true;
+            else if (opt == "-no-auto-cluster")
+                settings._autoCluster = false;
+            else if (opt == "-auto-bundle")
+                settings._autoBundle = true;
+            else if (opt == "-no-auto-bundle")
+                settings._autoBundle = false;
+            else if (opt == "-auto-scratch")
+                settings._autoScratch = true;
+            else if (opt == "-no-auto-scratch")
+                settings._autoScratch = false;
+            else if (opt == "-reassoc")
+                settings._reassoc = true;
+            else if (opt == "-no-reassoc")
+                settings._reassoc = false;
+            else if (opt == "-slide")
+                settings._slideVecs = true;
+            else if (opt == "-no-slide")
+                settings._slideVecs = false;
             else if (opt == "-find-deps")
                 settings._findDeps = true;
             else if (opt == "-no-find-deps")
@@ -207,6 +272,12 @@ void parseOpts(int argc, const char* argv[])
                     solutionName = argop;
                 else if (opt == "-grids")
                     settings._gridRegex = argop;
+                else if (opt == "-brick-grids")
+                    settings._brickGridRegex = argop;
+                else if (opt == "-bf16-grids")
+                    settings._bf16GridRegex = argop;
+                else if (opt == "-fp16-grids")
+                    settings._fp16GridRegex = argop;
                 else if (opt == "-eq-bundles")
                     settings._eqBundleTargets = argop;
                 else if (opt == "-fold" || opt == "-cluster") {
@@ -262,6 +333,8 @@ void parseOpts(int argc, const char* argv[])
                         settings._haloSize = val;
                     else if (opt == "-step-alloc")
                         settings._stepAlloc = val;
+                    else if (opt == "-bundle-cache-kb")
+                        settings._bundleCacheKB = val;
 
                     // add any more options w/int values here.
 
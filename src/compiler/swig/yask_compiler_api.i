@@ -74,6 +74,7 @@ IN THE SOFTWARE.
 // All vector types used in API.
 %template(vector_int) std::vector<int>;
 %template(vector_str) std::vector<std::string>;
+%template(vector_dbl) std::vector<double>;
 %template(vector_index) std::vector<std::shared_ptr<yask::yc_index_node>>;
 %template(vector_num) std::vector<std::shared_ptr<yask::yc_number_node>>;
 %template(vector_eq) std::vector<std::shared_ptr<yask::yc_equation_node>>;
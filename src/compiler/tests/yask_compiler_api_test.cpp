@@ -120,6 +120,30 @@ int main() {
         soln->format("avx", yask_file);
         cout << "YASK-format written to '" << yask_file->get_filename() << "'.\n";
 
+        // Compare Taylor and optimized FD coefficients.
+        yc_fd_coeff_factory fdfac;
+        int fd_order = 2, fd_radius = 4;
+        double fd_band = 0.7;
+        auto taylor = fdfac.get_center_coefficients(fd_order, fd_radius);
+        auto opt = fdfac.get_optimized_coefficients(fd_order, fd_radius, fd_band);
+        double taylor_err = fdfac.get_max_error(taylor, fd_order, fd_band);
+        double opt_err = fdfac.get_max_error(opt, fd_order, fd_band);
+        cout << "Max error of radius-" << fd_radius << " FD coefficients up to " <<
+            fd_band << " of Nyquist: Taylor " << taylor_err <<
+            ", optimized " << opt_err << ".\n";
+        if (opt_err >= taylor_err) {
+            cerr << "Error: optimized coefficients are not more accurate.\n";
+            return 1;
+        }
+        auto cheapest = fdfac.get_cheapest_coefficients(fd_order, fd_band, taylor_err);
+        int cheapest_radius = int(cheapest.size() / 2);
+        cout << "Cheapest radius with max error " << taylor_err << ": " <<
+            cheapest_radius << ".\n";
+        if (cheapest_radius >= fd_radius) {
+            cerr << "Error: cheapest radius is not smaller.\n";
+            return 1;
+        }
+
         cout << "End of YASK compiler API test.\n";
         return 0;
 
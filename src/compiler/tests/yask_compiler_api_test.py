@@ -128,5 +128,24 @@ if __name__ == "__main__":
     for eq in soln.get_equations() :
         print("  " + eq.format_simple())
 
+    # Compare Taylor and optimized FD coefficients.
+    fdfac = yask_compiler.yc_fd_coeff_factory()
+    fd_order = 2
+    fd_radius = 4
+    fd_band = 0.7
+    taylor = fdfac.get_center_coefficients(fd_order, fd_radius)
+    opt = fdfac.get_optimized_coefficients(fd_order, fd_radius, fd_band)
+    taylor_err = fdfac.get_max_error(taylor, fd_order, fd_band)
+    opt_err = fdfac.get_max_error(opt, fd_order, fd_band)
+    print("Max error of radius-" + str(fd_radius) + " FD coefficients up to " +
+          str(fd_band) + " of Nyquist: Taylor " + str(taylor_err) +
+          ", optimized " + str(opt_err) + ".")
+    assert opt_err < taylor_err
+    cheapest = fdfac.get_cheapest_coefficients(fd_order, fd_band, taylor_err)
+    cheapest_radius = len(cheapest) // 2
+    print("Cheapest radius with max error " + str(taylor_err) + ": " +
+          str(cheapest_radius) + ".")
+    assert cheapest_radius < fd_radius
+
     print("Debug output captured:\n" + do.get_string())
     print("End of YASK compiler API test.")
@@ -24,12 +24,17 @@ IN THE SOFTWARE.
 *****************************************************************************/
 
 // Purpose: implement a simple,infinite-size cache model to check
-// prefetch and/or eviction coverage.
+// prefetch and/or eviction coverage, and set-associative cache models
+// used by the trace-driven cache simulator.
+
+#pragma once
 
 #include <map>
 
 namespace yask {
 
+#ifdef MODEL_CACHE
+
     // key is CL addr; value is line num.
     class Cache : public std::map<uintptr_t, int> {
         int myLevel;
@@ -40,12 +45,12 @@ namespace yask {
         bool enabled;
         uintptr_t prevReadLine;
         std::map<intptr_t, size_t> strideCounts;
-        static const float minStridePct = 0.1f;
+        static constexpr float minStridePct = 0.1f;
 
     public:
         Cache(int l): myLevel(l), numReads(0), numPFs(0), numEvicts(0),
-                      numReadsNotPFed(0), numExtraPFs(0), numBadEvicts(0),
-                      numSizes(0), sumSizes(0), maxSize(0), enabled(true),
+                      numLowPFs(0), numReadsNotPFed(0), numExtraPFs(0), numBadEvicts(0),
+                      numLowPFsNotPFed(0), numSizes(0), sumSizes(0), maxSize(0), enabled(true),
                       prevReadLine(0)
         {
             printf("modeling cache L%i (a max of %i warnings of each type will be printed)...\n",
@@ -207,4 +212,86 @@ namespace yask {
         }
     };
 
+#endif
+
+    // A set-associative cache level with LRU replacement.
+    // Holds only tags, so it can model any capacity cheaply.
+    class CacheLevel {
+        std::string _name;
+        idx_t _nsets = 1, _nways = 1;
+
+        // For each way of each set, the cache-line addr plus one (zero
+        // => empty) and the time of its last access.
+        std::vector<uintptr_t> _tags;
+        std::vector<idx_t> _stamps;
+        idx_t _clock = 0;
+
+        idx_t _num_accesses = 0, _num_misses = 0;
+
+    public:
+        CacheLevel(const std::string& name, idx_t nbytes, idx_t nways) :
+            _name(name) {
+            _nways = std::max(nways, idx_t(1));
+            _nsets = std::max(nbytes / (_nways * CACHELINE_BYTES), idx_t(1));
+            _tags.assign(_nsets * _nways, 0);
+            _stamps.assign(_nsets * _nways, 0);
+        }
+
+        const std::string& get_name() const { return _name; }
+        idx_t get_num_bytes() const { return _nsets * _nways * CACHELINE_BYTES; }
+        idx_t get_num_accesses() const { return _num_accesses; }
+        idx_t get_num_misses() const { return _num_misses; }
+        double get_miss_rate() const {
+            return _num_accesses ? double(_num_misses) / _num_accesses : 0.;
+        }
+
+        // Empty the cache and clear the counts.
+        void clear() {
+            std::fill(_tags.begin(), _tags.end(), 0);
+            std::fill(_stamps.begin(), _stamps.end(), 0);
+            _clock = _num_accesses = _num_misses = 0;
+        }
+
+        // Access cache-line 'cl', loading it on a miss.
+        // Return whether it was a hit.
+        bool access(uintptr_t cl) {
+            _num_accesses++;
+            _clock++;
+            uintptr_t tag = cl + 1;
+            idx_t set0 = idx_t(cl % _nsets) * _nways;
+            idx_t lru = set0;
+            for (idx_t i = set0; i < set0 + _nways; i++) {
+                if (_tags[i] == tag) {
+                    _stamps[i] = _clock;
+                    return true;
+                }
+                if (_stamps[i] < _stamps[lru])
+                    lru = i;
+            }
+            _num_misses++;
+            _tags[lru] = tag;
+            _stamps[lru] = _clock;
+            return false;
+        }
+    };
+
+    // A hierarchy of non-exclusive cache levels, closest first.
+    // A miss at one level is looked up in the next one and
+    // fills every level that missed.
+    class CacheHierarchy : public std::vector<CacheLevel> {
+    public:
+        void clear() {
+            for (auto& cl : *this)
+                cl.clear();
+        }
+
+        // Access the line holding 'p'.
+        void access(const void* p) {
+            uintptr_t cl = uintptr_t(p) / CACHELINE_BYTES;
+            for (auto& lvl : *this)
+                if (lvl.access(cl))
+                    break;
+        }
+    };
+
 }
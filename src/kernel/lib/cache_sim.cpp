@@ -0,0 +1,263 @@
+/*****************************************************************************
+
+YASK: Yet Another Stencil Kernel
+Copyright (c) 2014-2018, Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+
+*****************************************************************************/
+
+// This file contains implementations of StencilContext methods
+// for the trace-driven cache simulator.
+
+#include "yask_stencil.hpp"
+using namespace std;
+
+namespace yask {
+
+    // Max points replayed for one block. Larger blocks are cut in the
+    // outer-loop dim, which keeps the reuse across the inner dims.
+    static const idx_t max_sim_pts = idx_t(1) << 21;
+
+    // Copy domain-dim tuple 't' with the inner-loop dim last, so
+    // visitAllPoints() follows the order of the generated loops.
+    static IdxTuple make_loop_tuple(const IdxTuple& t, const string& inner_dim) {
+        IdxTuple lt = t.removeDim(inner_dim);
+        lt.addDimBack(inner_dim, t[inner_dim]);
+        lt.setFirstInner(false);
+        return lt;
+    }
+
+    // Replay the accesses of the block at the start of the rank through
+    // 'caches'. Each bundle access touches the lines holding the first
+    // and last elements of each vector it reads or writes, in the order
+    // of packs, sub-blocks, bundles, clusters and vectors used by
+    // calc_block(). Only the first step is replayed.
+    idx_t StencilContext::sim_block(CacheHierarchy& caches,
+                                    const IdxTuple& block_sizes,
+                                    const IdxTuple& sub_block_sizes) {
+        auto& step_dim = _dims->_step_dim;
+        auto& inner_dim = _dims->_inner_dim;
+        auto& ddims = _dims->_domain_dims;
+        auto& fold_pts = _dims->_fold_pts;
+        auto& cluster_pts = _dims->_cluster_pts;
+
+        // Block bounds, limited to the rank and to 'max_sim_pts'.
+        IdxTuple bbgn = rank_bb.bb_begin;
+        IdxTuple bend = rank_bb.bb_begin;
+        IdxTuple blen(ddims);
+        for (auto& dim : ddims.getDims()) {
+            auto& dname = dim.getName();
+            bend[dname] = min(bbgn[dname] + block_sizes[dname], rank_bb.bb_end[dname]);
+            blen[dname] = bend[dname] - bbgn[dname];
+        }
+        auto bloop = make_loop_tuple(blen, inner_dim);
+        auto& odname = bloop.getDimName(0);
+        idx_t oplane = blen.product() / blen[odname];
+        if (blen.product() > max_sim_pts) {
+            idx_t olen = max(max_sim_pts / oplane, cluster_pts[odname]);
+            olen = ROUND_UP(olen, cluster_pts[odname]);
+            blen[odname] = min(olen, blen[odname]);
+            bend[odname] = bbgn[odname] + blen[odname];
+        }
+
+        // Number of sub-blocks in each dim.
+        IdxTuple nsbs(ddims);
+        for (auto& dim : ddims.getDims()) {
+            auto& dname = dim.getName();
+            nsbs[dname] = CEIL_DIV(blen[dname], sub_block_sizes[dname]);
+        }
+        auto nsbs_l = make_loop_tuple(nsbs, inner_dim);
+        auto nvecs_l = make_loop_tuple(_dims->_cluster_mults, inner_dim);
+
+        for (auto& sp : stPacks) {
+            nsbs_l.visitAllPoints([&](const IdxTuple& sbi, size_t sbn) {
+                for (auto* sg : *sp) {
+                    if (sg->is_scratch())
+                        continue;
+
+                    // Sub-block bounds within the bundle BB.
+                    auto& sgbb = sg->getBB();
+                    IdxTuple sbgn(ddims), ncls(ddims);
+                    bool empty = false;
+                    for (auto& dim : ddims.getDims()) {
+                        auto& dname = dim.getName();
+                        idx_t sz = sub_block_sizes[dname];
+                        idx_t b = max(bbgn[dname] + sbi[dname] * sz, sgbb.bb_begin[dname]);
+                        idx_t e = min(min(bbgn[dname] + (sbi[dname] + 1) * sz, bend[dname]),
+                                      sgbb.bb_end[dname]);
+                        if (e <= b)
+                            empty = true;
+                        sbgn[dname] = b;
+                        ncls[dname] = CEIL_DIV(e - b, cluster_pts[dname]);
+                    }
+                    if (empty)
+                        continue;
+                    auto ncls_l = make_loop_tuple(ncls, inner_dim);
+
+                    ncls_l.visitAllPoints([&](const IdxTuple& ci, size_t cn) {
+                        for (auto& acc : sg->_accesses) {
+                            auto* gp = acc.gp.get();
+                            int ngdims = gp->get_num_dims();
+                            Indices first(ngdims), last(ngdims);
+                            nvecs_l.visitAllPoints([&](const IdxTuple& vi, size_t vn) {
+                                for (int i = 0; i < ngdims; i++) {
+                                    auto& gdname = gp->get_dim_name(i);
+                                    idx_t ofs = acc.offsets[i];
+                                    if (gdname == step_dim)
+                                        first[i] = last[i] = ofs;
+                                    else if (ddims.lookup(gdname)) {
+                                        first[i] = sbgn[gdname] + ofs +
+                                            ci[gdname] * cluster_pts[gdname] +
+                                            vi[gdname] * fold_pts[gdname];
+                                        last[i] = first[i] + fold_pts[gdname] - 1;
+                                    }
+                                    else
+                                        first[i] = last[i] = ofs;
+                                }
+                                auto asi = gp->get_alloc_step_index(first);
+                                auto* fp = gp->getElemAddr(first, asi, false);
+                                auto* lp = gp->getElemAddr(last, asi, false);
+                                caches.access(fp);
+                                if (uintptr_t(fp) / CACHELINE_BYTES != uintptr_t(lp) / CACHELINE_BYTES)
+                                    caches.access(lp);
+                                return true;
+                            });
+                        }
+                        return true;
+                    });
+                }
+                return true;
+            });
+        }
+        return blen.product();
+    }
+
+    // Predict the block and sub-block sizes with the lowest cost from the
+    // cache model and apply them.
+    void StencilContext::run_cache_sim() {
+        ostream& os = get_ostr();
+        auto& ddims = _dims->_domain_dims;
+        auto& inner_dim = _dims->_inner_dim;
+        auto& cluster_pts = _dims->_cluster_pts;
+
+        // Caches seen by one thread.
+        CacheHierarchy caches;
+        caches.push_back(CacheLevel("L1", _opts->cache_l1_kb * 1024, CACHE_L1_WAYS));
+        if (_opts->cache_l2_kb > 0)
+            caches.push_back(CacheLevel("L2", _opts->cache_l2_kb * 1024, CACHE_L2_WAYS));
+        if (_opts->cache_llc_kb > 0)
+            caches.push_back(CacheLevel("LLC", _opts->cache_llc_kb * 1024, CACHE_LLC_WAYS));
+        os << "\nCache simulation of one block per size:\n";
+        for (auto& cl : caches)
+            os << " " << cl.get_name() << ": " << makeByteStr(cl.get_num_bytes()) << endl;
+
+        // Cost of one point: the misses per point at each level, weighted
+        // by 4x for each level further out.
+        auto eval = [&](const IdxTuple& bsizes, const IdxTuple& sbsizes) {
+            caches.clear();
+            idx_t npts = sim_block(caches, bsizes, sbsizes);
+            double cost = 0., wt = 1.;
+            os << " block " << bsizes.makeDimValStr(" * ") <<
+                ", sub-block " << sbsizes.makeDimValStr(" * ") << ":";
+            for (auto& cl : caches) {
+                double mpp = double(cl.get_num_misses()) / max(npts, idx_t(1));
+                os << " " << cl.get_name() << "-misses/pt=" << mpp;
+                cost += wt * mpp;
+                wt *= 4.;
+            }
+            os << " cost=" << cost << endl;
+            return cost;
+        };
+
+        // Round a size to a cluster multiple within the auto-tuner's bounds
+        // for blocks, which start at most at half the region.
+        auto bound = [&](const string& dname, idx_t sz, idx_t maxsz) {
+            idx_t c = cluster_pts[dname];
+            maxsz = max(c, ROUND_DOWN(maxsz, c));
+            return min(ROUND_UP(max(sz, c), c), maxsz);
+        };
+
+        // Block candidates: the current size scaled by 1/4 to 4 in all
+        // dims, each also with the inner dim as long as possible.
+        IdxTuple base(ddims);
+        base.setVals(_opts->_block_sizes, false);
+        vector<IdxTuple> bcands;
+        for (int k = -2; k <= 2; k++) {
+            IdxTuple b(ddims), p(ddims);
+            for (auto& dim : ddims.getDims()) {
+                auto& dname = dim.getName();
+                idx_t sz = (k < 0) ? (base[dname] >> -k) : (base[dname] << k);
+                idx_t maxsz = max(idx_t(1), _opts->_region_sizes[dname] / 2);
+                b[dname] = bound(dname, sz, maxsz);
+                p[dname] = (dname == inner_dim) ? bound(dname, maxsz, maxsz) : b[dname];
+            }
+            for (auto& c : { b, p })
+                if (find(bcands.begin(), bcands.end(), c) == bcands.end())
+                    bcands.push_back(c);
+        }
+
+        // Find best block with one sub-block per block.
+        IdxTuple best_b = bcands[0];
+        double best_cost = -1.;
+        for (auto& b : bcands) {
+            double cost = eval(b, b);
+            if (best_cost < 0. || cost < best_cost) {
+                best_cost = cost;
+                best_b = b;
+            }
+        }
+
+        // Sub-block candidates in the best block: the outer dims
+        // shortened by up to 8x, with the inner dim kept whole.
+        IdxTuple best_sb = best_b;
+        for (int k = 1; k <= 3; k++) {
+            IdxTuple sb(best_b);
+            for (auto& dim : ddims.getDims()) {
+                auto& dname = dim.getName();
+                if (dname != inner_dim)
+                    sb[dname] = bound(dname, best_b[dname] >> k, best_b[dname]);
+            }
+            if (sb == best_b)
+                continue;
+            double cost = eval(best_b, sb);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_sb = sb;
+            }
+        }
+
+        // Apply the predicted sizes.
+        _opts->_block_sizes.setVals(best_b, false);
+        _opts->_sub_block_sizes.setVals(best_sb, false);
+        _opts->_block_group_sizes.setValsSame(0);
+        _opts->_sub_block_group_sizes.setValsSame(0);
+        yask_output_factory yof;
+        auto nullop = yof.new_null_output();
+        _opts->adjustSettings(nullop->get_ostream(), _env);
+        allocScratchData(nullop->get_ostream());
+        os << " predicted-best-block-size:     " << best_b.makeDimValStr(" * ") << endl <<
+            " predicted-best-sub-block-size: " << best_sb.makeDimValStr(" * ") << endl;
+
+        // The candidates are 2x apart, so the auto-tuner only needs to
+        // search nearby sizes.
+        _at.set_pruned_radius(4);
+    }
+
+} // namespace yask.
@@ -0,0 +1,225 @@
+/*****************************************************************************
+
+YASK: Yet Another Stencil Kernel
+Copyright (c) 2014-2018, Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+
+*****************************************************************************/
+
+// This file contains implementations of StencilContext methods
+// for saving and restoring the grid data of a solution.
+
+// Each rank writes one file containing a text header followed by the
+// raw storage of each grid, including halos, pads and unused vector
+// lanes, exactly as it is in memory. The header describes the layout of
+// the rank and of each grid; a checkpoint can only be restored into a
+// solution with an identical header, so no conversion is ever needed.
+
+#include "yask_stencil.hpp"
+#include <fcntl.h>
+using namespace std;
+
+namespace yask {
+
+    // Header size and alignment of each grid's data in the file.
+    static const size_t ckpt_align = 4096;
+
+    // Max bytes in one read or write call.
+    static const size_t ckpt_chunk = size_t(64) * 1024 * 1024;
+
+    // Name of the file for this rank.
+    string StencilContext::get_checkpoint_file_name(const string& path) const {
+        return path + ".rank" + to_string(_env->my_rank) + ".yask";
+    }
+
+    // Make the header that describes the layout of the data in this rank.
+    // Also set the offset of each grid's data in the file.
+    string StencilContext::make_checkpoint_header(vector<size_t>& offsets) const {
+        ostringstream oss;
+        oss << "YASK checkpoint 1\n"
+            "stencil: " << get_name() << "\n"
+            "element-bytes: " << get_element_bytes() << "\n"
+            "fold: " << _dims->_fold_pts.makeDimValStr() << "\n"
+            "ranks: " << _opts->_num_ranks.makeDimValStr() << "\n"
+            "rank-index: " << _opts->_rank_indices.makeDimValStr() << "\n"
+            "rank-offsets: " << rank_domain_offsets.makeDimValStr() << "\n"
+            "rank-sizes: " << _opts->_rank_sizes.makeDimValStr() << "\n"
+            "grids: " << gridPtrs.size() << "\n";
+
+        // Grid data starts after the header.
+        offsets.clear();
+        size_t ofs = ckpt_align;
+        for (auto gp : gridPtrs) {
+            size_t nbytes = gp->is_storage_allocated() ? gp->get_num_storage_bytes() : 0;
+            oss << "grid: " << gp->get_name() << " bytes=" << nbytes <<
+                " offset=" << ofs;
+            for (int i = 0; i < gp->get_num_dims(); i++) {
+                auto& dname = gp->get_dim_name(i);
+                oss << " " << dname << "=" << gp->_get_first_alloc_index(i) <<
+                    ".." << gp->_get_last_alloc_index(i);
+                if (gp->is_bricked() && _dims->_domain_dims.lookup(dname))
+                    oss << "/" << gp->get_brick_size(dname);
+            }
+            oss << "\n";
+            offsets.push_back(ofs);
+            ofs += ROUND_UP(nbytes, ckpt_align);
+        }
+        return oss.str();
+    }
+
+    // Read or write 'nbytes' at 'buf' from or to 'fd' at 'ofs' in
+    // large pieces by all threads. Return true if all OK.
+    static bool ckptIO(int fd, bool is_write, char* buf, size_t nbytes, size_t ofs) {
+        idx_t nchunks = CEIL_DIV(nbytes, ckpt_chunk);
+        bool ok = true;
+#pragma omp parallel for schedule(dynamic, 1) reduction(&&: ok)
+        for (idx_t ci = 0; ci < nchunks; ci++) {
+            size_t cofs = size_t(ci) * ckpt_chunk;
+            size_t cbytes = min(ckpt_chunk, nbytes - cofs);
+            size_t done = 0;
+            while (ok && done < cbytes) {
+                ssize_t n = is_write ?
+                    pwrite(fd, buf + cofs + done, cbytes - done, ofs + cofs + done) :
+                    pread(fd, buf + cofs + done, cbytes - done, ofs + cofs + done);
+                if (n <= 0)
+                    ok = false;
+                else
+                    done += n;
+            }
+        }
+        return ok;
+    }
+
+    // Throw an exception on all ranks if 'msg' is not empty on any rank.
+    void StencilContext::check_checkpoint_error(const string& fn, const string& msg) {
+        int err = msg.length() ? 1 : 0;
+        int any_err = err;
+#ifdef USE_MPI
+        MPI_Allreduce(&err, &any_err, 1, MPI_INT, MPI_MAX, _env->comm);
+#endif
+        if (err)
+            THROW_YASK_EXCEPTION("Error: " + fn + "(): " + msg);
+        if (any_err)
+            THROW_YASK_EXCEPTION("Error: " + fn + "() failed on another rank");
+    }
+
+    // Write all grids.
+    void StencilContext::save_checkpoint(const string& path) {
+        ostream& os = get_ostr();
+        if (!rank_bb.bb_valid)
+            THROW_YASK_EXCEPTION("Error: save_checkpoint() called without calling prepare_solution() first");
+
+        // Bring the halos up to date so that they need not be
+        // exchanged after restoring.
+        exchange_halos_all();
+
+        YaskTimer timer;
+        timer.start();
+        vector<size_t> offsets;
+        string hdr = make_checkpoint_header(offsets);
+        if (hdr.length() >= ckpt_align)
+            hdr = "";           // caught below.
+        auto fname = get_checkpoint_file_name(path);
+        string msg;
+        size_t nbytes = 0;
+        int fd = open(fname.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            msg = "cannot create '" + fname + "'";
+        else if (!hdr.length())
+            msg = "too many grids for the checkpoint header";
+        else {
+
+            // Header, padded with newlines.
+            hdr.resize(ckpt_align, '\n');
+            if (pwrite(fd, hdr.data(), hdr.length(), 0) != ssize_t(hdr.length()))
+                msg = "cannot write to '" + fname + "'";
+
+            // Grids.
+            for (size_t gi = 0; msg.empty() && gi < gridPtrs.size(); gi++) {
+                auto gp = gridPtrs[gi];
+                if (!gp->is_storage_allocated())
+                    continue;
+                size_t gbytes = gp->get_num_storage_bytes();
+                if (!ckptIO(fd, true, static_cast<char*>(gp->get_raw_storage_buffer()),
+                            gbytes, offsets[gi]))
+                    msg = "cannot write grid '" + gp->get_name() + "' to '" + fname + "'";
+                nbytes += gbytes;
+            }
+            if (close(fd) != 0 && msg.empty())
+                msg = "cannot close '" + fname + "'";
+        }
+        check_checkpoint_error("save_checkpoint", msg);
+        timer.stop();
+        os << "Saved " << makeByteStr(nbytes) << " in " << gridPtrs.size() <<
+            " grid(s) to '" << fname << "' in " << timer.get_elapsed_secs() << " secs.\n";
+    }
+
+    // Read all grids.
+    void StencilContext::load_checkpoint(const string& path) {
+        ostream& os = get_ostr();
+        if (!rank_bb.bb_valid)
+            THROW_YASK_EXCEPTION("Error: load_checkpoint() called without calling prepare_solution() first");
+
+        YaskTimer timer;
+        timer.start();
+        vector<size_t> offsets;
+        string hdr = make_checkpoint_header(offsets);
+        auto fname = get_checkpoint_file_name(path);
+        string msg;
+        size_t nbytes = 0;
+        int fd = open(fname.c_str(), O_RDONLY);
+        if (fd < 0)
+            msg = "cannot open '" + fname + "'";
+        else {
+
+            // The header must match exactly.
+            string fhdr(ckpt_align, '\0');
+            if (pread(fd, &fhdr[0], ckpt_align, 0) != ssize_t(ckpt_align))
+                msg = "cannot read header from '" + fname + "'";
+            else if (fhdr.compare(0, hdr.length(), hdr) != 0 ||
+                     (hdr.length() < ckpt_align && fhdr[hdr.length()] != '\n'))
+                msg = "layout of '" + fname + "' does not match this solution; "
+                    "checkpoints can only be restored with the same stencil, "
+                    "element size, fold, rank layout, and grid sizes";
+
+            // Grids.
+            for (size_t gi = 0; msg.empty() && gi < gridPtrs.size(); gi++) {
+                auto gp = gridPtrs[gi];
+                if (!gp->is_storage_allocated())
+                    continue;
+                size_t gbytes = gp->get_num_storage_bytes();
+                if (!ckptIO(fd, false, static_cast<char*>(gp->get_raw_storage_buffer()),
+                            gbytes, offsets[gi]))
+                    msg = "cannot read grid '" + gp->get_name() + "' from '" + fname + "'";
+                nbytes += gbytes;
+            }
+            close(fd);
+        }
+        check_checkpoint_error("load_checkpoint", msg);
+
+        // Halos were saved after an exchange, so they are valid.
+        for (auto gp : gridPtrs)
+            gp->set_dirty_all(false);
+        timer.stop();
+        os << "Loaded " << makeByteStr(nbytes) << " in " << gridPtrs.size() <<
+            " grid(s) from '" << fname << "' in " << timer.get_elapsed_secs() << " secs.\n";
+    }
+
+} // namespace yask.
@@ -0,0 +1,285 @@
+/*****************************************************************************
+
+YASK: Yet Another Stencil Kernel
+Copyright (c) 2014-2018, Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+
+*****************************************************************************/
+
+// This file contains implementations of StencilContext methods
+// for keeping compressed copies of grid slices in memory.
+
+// The elements of a slice are split into chunks that are compressed
+// independently by all threads, so any chunk can be decoded on its own.
+// Each element is turned into a 64-bit residual that is usually small:
+// - Lossless: the XOR of its bits with those of the previous element.
+// - Lossy: the zig-zag-coded difference between its value and the
+//   previous one, both quantized to a multiple of twice the error bound.
+// A residual is stored as its non-zero low-order bytes, preceded in a
+// separate area by a 4-bit count of those bytes.
+// A chunk whose values cannot be quantized within the bound is stored
+// losslessly instead.
+
+#include "yask_stencil.hpp"
+using namespace std;
+
+namespace yask {
+
+    // Elements in each independently-compressed chunk.
+    static const idx_t cz_chunk = 16 * 1024;
+
+    // Largest quantized magnitude allowed, so differences cannot overflow.
+    static const double cz_max_q = double(1LL << 52);
+
+    static inline uint64_t czBits(real_t v) {
+        uint64_t u = 0;
+        memcpy(&u, &v, sizeof(real_t));
+        return u;
+    }
+    static inline real_t czReal(uint64_t u) {
+        real_t v;
+        memcpy(&v, &u, sizeof(real_t));
+        return v;
+    }
+
+    // Make residuals from 'n' elements at 'in'. Return false if
+    // 'max_err' > 0 and the values cannot be quantized.
+    static bool czResiduals(const real_t* in, idx_t n, double max_err,
+                            uint64_t* res) {
+        if (max_err > 0.) {
+            double scale = 0.5 / max_err;
+            double step = 2. * max_err;
+            bool ok = true;
+            int64_t* q = reinterpret_cast<int64_t*>(res);
+
+            // Quantize and check the error.
+#pragma omp simd reduction(&&: ok)
+            for (idx_t i = 0; i < n; i++) {
+                double s = double(in[i]) * scale;
+                bool in_range = fabs(s) < cz_max_q; // false for NaN.
+                int64_t qi = in_range ? int64_t(nearbyint(s)) : 0;
+                double err = fabs(double(real_t(double(qi) * step)) - double(in[i]));
+                ok = ok && in_range && err <= max_err;
+                q[i] = qi;
+            }
+            if (!ok)
+                return false;
+
+            // Convert to zig-zag differences in place, from the end.
+            for (idx_t i = n - 1; i >= 0; i--) {
+                int64_t d = q[i] - (i ? q[i - 1] : 0);
+                res[i] = (uint64_t(d) << 1) ^ uint64_t(d >> 63);
+            }
+            return true;
+        }
+
+#pragma omp simd
+        for (idx_t i = 0; i < n; i++)
+            res[i] = czBits(in[i]) ^ (i ? czBits(in[i - 1]) : 0);
+        return true;
+    }
+
+    // Pack 'n' residuals into 'out'.
+    static void czPack(const uint64_t* res, idx_t n, vector<uint8_t>& out) {
+        idx_t nctrl = CEIL_DIV(n, 2);
+        out.assign(nctrl, 0);
+        out.reserve(nctrl + n * sizeof(real_t));
+        for (idx_t i = 0; i < n; i++) {
+            uint64_t r = res[i];
+            int nb = r ? (64 - __builtin_clzll(r) + 7) / 8 : 0;
+            out[i / 2] |= uint8_t(nb << ((i % 2) * 4));
+            for (int b = 0; b < nb; b++) {
+                out.push_back(uint8_t(r));
+                r >>= 8;
+            }
+        }
+    }
+
+    // Unpack 'n' residuals from 'in'.
+    static void czUnpack(const vector<uint8_t>& in, idx_t n, uint64_t* res) {
+        const uint8_t* dp = in.data() + CEIL_DIV(n, 2);
+        for (idx_t i = 0; i < n; i++) {
+            int nb = (in[i / 2] >> ((i % 2) * 4)) & 0xf;
+            uint64_t r = 0;
+            for (int b = 0; b < nb; b++)
+                r |= uint64_t(*dp++) << (b * 8);
+            res[i] = r;
+        }
+    }
+
+    // Make 'n' elements at 'out' from residuals.
+    static void czValues(uint64_t* res, idx_t n, double max_err, bool is_lossy,
+                         real_t* out) {
+        if (is_lossy) {
+            double step = 2. * max_err;
+            int64_t q = 0;
+            for (idx_t i = 0; i < n; i++) {
+                uint64_t z = res[i];
+                q += int64_t(z >> 1) ^ -int64_t(z & 1);
+                res[i] = uint64_t(q);
+            }
+            const int64_t* qp = reinterpret_cast<const int64_t*>(res);
+#pragma omp simd
+            for (idx_t i = 0; i < n; i++)
+                out[i] = real_t(double(qp[i]) * step);
+        } else {
+            uint64_t u = 0;
+            for (idx_t i = 0; i < n; i++) {
+                u ^= res[i];
+                out[i] = czReal(u);
+            }
+        }
+    }
+
+    // Compress a slice of a grid.
+    idx_t StencilContext::store_compressed_slice(const string& key,
+                                                 const string& grid_name,
+                                                 const vector<idx_t>& first_indices,
+                                                 const vector<idx_t>& last_indices,
+                                                 double max_abs_error) {
+        auto gi = gridMap.find(grid_name);
+        if (gi == gridMap.end())
+            THROW_YASK_EXCEPTION("Error: store_compressed_slice() called with unknown grid '" +
+                                 grid_name + "'");
+        auto gp = gi->second;
+        if (!gp->is_storage_allocated())
+            THROW_YASK_EXCEPTION("Error: store_compressed_slice() called on grid '" +
+                                 grid_name + "' without storage");
+        if (max_abs_error < 0.)
+            THROW_YASK_EXCEPTION("Error: store_compressed_slice() called with a negative error bound");
+        int ndims = gp->get_num_dims();
+        if (int(first_indices.size()) != ndims || int(last_indices.size()) != ndims)
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: store_compressed_slice() called with " <<
+                                            first_indices.size() << " and " <<
+                                            last_indices.size() << " indices for grid '" <<
+                                            grid_name << "', which has " << ndims << " dim(s)");
+        idx_t nelems = 1;
+        for (int i = 0; i < ndims; i++)
+            nelems *= max(last_indices[i] - first_indices[i] + 1, idx_t(0));
+
+        // Copy out the elements.
+        vector<real_t> vals(nelems);
+        if (nelems)
+            gp->get_elements_in_slice(vals.data(), first_indices, last_indices);
+
+        // Compress the chunks.
+        CompressedSlice cs;
+        cs.grid_name = grid_name;
+        cs.first = Indices(first_indices);
+        cs.last = Indices(last_indices);
+        cs.nelems = nelems;
+        cs.max_error = max_abs_error;
+        idx_t nchunks = CEIL_DIV(nelems, cz_chunk);
+        cs.chunks.resize(nchunks);
+        cs.is_lossy.resize(nchunks);
+#pragma omp parallel
+        {
+            vector<uint64_t> res(cz_chunk);
+
+#pragma omp for schedule(dynamic, 1)
+            for (idx_t ci = 0; ci < nchunks; ci++) {
+                idx_t i0 = ci * cz_chunk;
+                idx_t n = min(cz_chunk, nelems - i0);
+                bool lossy = max_abs_error > 0. &&
+                    czResiduals(vals.data() + i0, n, max_abs_error, res.data());
+                if (!lossy)
+                    czResiduals(vals.data() + i0, n, 0., res.data());
+                czPack(res.data(), n, cs.chunks[ci]);
+                cs.chunks[ci].shrink_to_fit();
+                cs.is_lossy[ci] = lossy;
+            }
+        }
+        for (auto& c : cs.chunks)
+            cs.nbytes += c.size();
+
+        // Replace any previous slice with this key.
+        _compressed_bytes -= _compressed_slices[key].nbytes;
+        _compressed_bytes += cs.nbytes;
+        _compressed_slices[key] = move(cs);
+        TRACE_MSG("store_compressed_slice('" << key << "'): " <<
+                  makeByteStr(nelems * sizeof(real_t)) << " -> " <<
+                  makeByteStr(_compressed_slices[key].nbytes));
+        return _compressed_slices[key].nbytes;
+    }
+
+    // Decompress a slice into a grid.
+    idx_t StencilContext::restore_compressed_slice(const string& key,
+                                                   const string& grid_name,
+                                                   const vector<idx_t>& first_indices) {
+        auto ci = _compressed_slices.find(key);
+        if (ci == _compressed_slices.end())
+            THROW_YASK_EXCEPTION("Error: restore_compressed_slice() called with unknown key '" +
+                                 key + "'");
+        auto& cs = ci->second;
+        string gname = grid_name.length() ? grid_name : cs.grid_name;
+        auto gi = gridMap.find(gname);
+        if (gi == gridMap.end())
+            THROW_YASK_EXCEPTION("Error: restore_compressed_slice() called with unknown grid '" +
+                                 gname + "'");
+        auto gp = gi->second;
+        int ndims = cs.first.getNumDims();
+        if (gp->get_num_dims() != ndims)
+            THROW_YASK_EXCEPTION("Error: restore_compressed_slice(): grid '" + gname +
+                                 "' does not have the same number of dims as grid '" +
+                                 cs.grid_name + "'");
+
+        // Same sizes as stored, starting at the given indices.
+        Indices first = cs.first, last = cs.last;
+        if (first_indices.size()) {
+            if (int(first_indices.size()) != ndims)
+                FORMAT_AND_THROW_YASK_EXCEPTION("Error: restore_compressed_slice() called with " <<
+                                                first_indices.size() << " indices for grid '" <<
+                                                gname << "', which has " << ndims << " dim(s)");
+            for (int i = 0; i < ndims; i++) {
+                last[i] += first_indices[i] - first[i];
+                first[i] = first_indices[i];
+            }
+        }
+
+        // Decompress the chunks.
+        idx_t nelems = cs.nelems;
+        vector<real_t> vals(nelems);
+        idx_t nchunks = cs.chunks.size();
+#pragma omp parallel
+        {
+            vector<uint64_t> res(cz_chunk);
+
+#pragma omp for schedule(dynamic, 1)
+            for (idx_t ci = 0; ci < nchunks; ci++) {
+                idx_t i0 = ci * cz_chunk;
+                idx_t n = min(cz_chunk, nelems - i0);
+                czUnpack(cs.chunks[ci], n, res.data());
+                czValues(res.data(), n, cs.max_error, cs.is_lossy[ci], vals.data() + i0);
+            }
+        }
+        if (!nelems)
+            return 0;
+        return gp->set_elements_in_slice(vals.data(), first, last);
+    }
+
+    void StencilContext::remove_compressed_slice(const string& key) {
+        auto ci = _compressed_slices.find(key);
+        if (ci != _compressed_slices.end()) {
+            _compressed_bytes -= ci->second.nbytes;
+            _compressed_slices.erase(ci);
+        }
+    }
+
+} // namespace yask.
@@ -93,6 +93,8 @@ namespace yask {
         wf_shifts = _dims->_domain_dims;
         left_wf_exts = _dims->_domain_dims;
         right_wf_exts = _dims->_domain_dims;
+        left_shell_sizes = _dims->_domain_dims;
+        right_shell_sizes = _dims->_domain_dims;
 
         // Set output to msg-rank per settings.
         set_ostr();
@@ -112,6 +114,127 @@ namespace yask {
         }
     }
 
+    void StencilContext::add_batch_solution(yk_solution_ptr other) {
+        auto bc = dynamic_pointer_cast<StencilContext>(other);
+        assert(bc);
+
+        if (bc.get() == this || bc->_batch.size())
+            THROW_YASK_EXCEPTION("Error: add_batch_solution() called with a solution"
+                                 " that is this one or that has its own batch");
+        for (auto& c : _batch)
+            if (c == bc)
+                THROW_YASK_EXCEPTION("Error: add_batch_solution() called with a solution"
+                                     " that is already in the batch");
+        if (!rank_bb.bb_valid || !bc->rank_bb.bb_valid)
+            THROW_YASK_EXCEPTION("Error: add_batch_solution() called without calling"
+                                 " prepare_solution() on both solutions first");
+
+        // Must be the same stencil with the same tiling, so that each block
+        // and halo exchange in this solution has a twin in 'bc'.
+        bool ok = stPacks.size() == bc->stPacks.size() &&
+            gridPtrs.size() == bc->gridPtrs.size();
+        for (size_t i = 0; ok && i < stPacks.size(); i++)
+            ok = stPacks[i]->get_name() == bc->stPacks[i]->get_name();
+        if (!ok)
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: add_batch_solution() called with solution '" <<
+                                            bc->name << "' that is not from the same stencil as '" <<
+                                            name << "'");
+        auto& ops = *bc->_opts;
+        if (_opts->_rank_sizes != ops._rank_sizes ||
+            _opts->_region_sizes != ops._region_sizes ||
+            _opts->_block_sizes != ops._block_sizes ||
+            _opts->_sub_block_sizes != ops._sub_block_sizes)
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: add_batch_solution() called with solution '" <<
+                                            bc->name << "' whose rank, region, block or sub-block"
+                                            " sizes differ from those in '" << name << "'");
+
+        // Share the grids that are only read by the stencils.
+        GridPtrSet outputs(outputGridPtrs.begin(), outputGridPtrs.end());
+        for (auto gp : gridPtrs) {
+            if (outputs.count(gp))
+                continue;
+            auto bi = bc->gridMap.find(gp->get_name());
+            if (bi != bc->gridMap.end())
+                bi->second->share_storage(gp);
+        }
+        _batch.push_back(bc);
+    }
+
+    void StencilContext::add_step_callback(yk_step_callback callback,
+                                           idx_t first_step_index,
+                                           idx_t step_interval,
+                                           const vector<string>& read_grid_names,
+                                           const vector<string>& written_grid_names) {
+        if (!callback)
+            THROW_YASK_EXCEPTION("Error: add_step_callback() called with an empty function");
+        if (step_interval < 1)
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: add_step_callback() called with step interval " <<
+                                            step_interval << "; it must be positive");
+        StepCallback cb;
+        cb.fn = callback;
+        cb.first_t = first_step_index;
+        cb.interval = step_interval;
+        for (int i = 0; i < 2; i++) {
+            auto& names = i ? written_grid_names : read_grid_names;
+            auto& gps = i ? cb.write_gps : cb.read_gps;
+            for (auto& gname : names) {
+                auto gi = gridMap.find(gname);
+                if (gi == gridMap.end())
+                    THROW_YASK_EXCEPTION("Error: add_step_callback() called with unknown grid '" +
+                                         gname + "'");
+                gps.push_back(gi->second);
+            }
+        }
+        TRACE_MSG("add_step_callback: every " << step_interval << " step(s) from step " <<
+                  first_step_index << " reading " << cb.read_gps.size() << " and writing " <<
+                  cb.write_gps.size() << " grid(s)");
+        _step_callbacks.push_back(cb);
+    }
+
+    idx_t StencilContext::limit_to_step_callbacks(idx_t start_t, idx_t stop_t) const {
+        idx_t dir = (stop_t > start_t) ? 1 : -1;
+
+        // Steps written are from start_t + dir to stop_t.
+        for (idx_t t = start_t + dir; t != stop_t; t += dir)
+            for (auto& cb : _step_callbacks)
+                if (cb.is_exact() && cb.is_due(t, dir))
+                    return t;
+        return stop_t;
+    }
+
+    bool StencilContext::call_step_callbacks(idx_t start_t, idx_t stop_t) {
+        idx_t dir = (stop_t > start_t) ? 1 : -1;
+        bool wrote = false;
+        for (idx_t t = start_t + dir; t != stop_t + dir; t += dir) {
+            for (auto& cb : _step_callbacks) {
+                if (!cb.is_due(t, dir))
+                    continue;
+                TRACE_MSG("call_step_callbacks: step " << t);
+
+                // Grid data must not change under the callback.
+                if (cb.is_exact())
+                    finish_halo_exchange();
+                cb.fn(t);
+                for (auto gp : cb.write_gps) {
+                    gp->set_dirty(true, t);
+                    wrote = true;
+                }
+            }
+        }
+        return wrote;
+    }
+
+    BundlePackPtr StencilContext::get_batch_pack(const StencilContext& bc,
+                                                 const BundlePackPtr& bp) const {
+        if (!bp)
+            return nullptr;
+        for (size_t i = 0; i < stPacks.size(); i++)
+            if (stPacks[i] == bp)
+                return bc.stPacks[i];
+        assert(0 && "pack not found");
+        return nullptr;
+    }
+
     string StencilContext::apply_command_line_options(const string& args) {
 
         // Create a parser and add base options to it.
@@ -124,6 +247,7 @@ namespace yask {
 
         // Parse cmd-line options, which sets values in settings.
         parser.parse_args("YASK", argsv);
+        _step_plan.valid = false;
 
         // Return any left-over strings.
         string rem;
@@ -154,6 +278,7 @@ namespace yask {
     // Eval stencil bundle(s) over grid(s) using reference scalar code.
     void StencilContext::calc_rank_ref()
     {
+        ostream& os = get_ostr();
         run_time.start();
 
         auto& step_dim = _dims->_step_dim;
@@ -184,6 +309,61 @@ namespace yask {
         TRACE_MSG("calc_rank_ref: " << begin.makeDimValStr() << " ... (end before) " <<
                   end.makeDimValStr());
 
+        // Sampled validation: choose blocks at random places in the
+        // overall domain. All ranks use the same seed, so they agree on the
+        // blocks, and each rank calculates only the parts in its domain
+        // that are needed to produce them.
+        val_bbs.clear();
+        IdxTuple margins(_dims->_domain_dims);
+        if (_opts->validate_samples > 0) {
+            std::mt19937_64 rng(_opts->validate_samples);
+            for (idx_t si = 0; si < _opts->validate_samples; si++) {
+                BoundingBox bb;
+                bb.bb_begin = _dims->_domain_dims;
+                bb.bb_end = _dims->_domain_dims;
+                for (auto& dim : _dims->_domain_dims.getDims()) {
+                    auto& dname = dim.getName();
+                    idx_t osz = overall_domain_sizes[dname];
+                    idx_t bsz = _opts->_block_sizes[dname];
+                    if (bsz <= 0 || bsz > osz)
+                        bsz = osz;
+                    std::uniform_int_distribution<idx_t> dist(0, osz - bsz);
+                    bb.bb_begin[dname] = dist(rng);
+                    bb.bb_end[dname] = bb.bb_begin[dname] + bsz;
+                }
+                val_bbs.push_back(bb);
+            }
+
+            // Find how far the calculated area must reach beyond the
+            // blocks for each remaining step. Each bundle, including the
+            // scratch ones, can read up to the max halo away from the
+            // points it writes, so allow one halo for each bundle in a
+            // step plus one for the values kept from the previous step.
+            idx_t max_halo = 0;
+            for (auto gp : gridPtrs)
+                for (auto& dim : _dims->_domain_dims.getDims()) {
+                    auto& dname = dim.getName();
+                    if (gp->is_dim_used(dname))
+                        max_halo = max(max_halo, max(gp->get_left_halo_size(dname),
+                                                     gp->get_right_halo_size(dname)));
+                }
+            for (auto* sv : scratchVecs)
+                for (auto gp : *sv)
+                    for (auto& dim : _dims->_domain_dims.getDims()) {
+                        auto& dname = dim.getName();
+                        if (gp->is_dim_used(dname))
+                            max_halo = max(max_halo, max(gp->get_left_halo_size(dname),
+                                                         gp->get_right_halo_size(dname)));
+                    }
+            idx_t nstages = 1;
+            for (auto* asg : stBundles)
+                nstages += asg->get_reqd_bundles().size();
+            margins.setValsSame(max_halo * nstages);
+            os << "Validating " << val_bbs.size() << " sampled block(s) of size " <<
+                val_bbs[0].bb_end.subElements(val_bbs[0].bb_begin).makeDimValStr(" * ") <<
+                " with " << margins.makeDimValStr() << " extra point(s) per step...\n";
+        }
+
         // Force region & block sizes to whole rank size so that scratch
         // grids will be large enough.
         _opts->_region_sizes.setValsSame(0);
@@ -228,6 +408,40 @@ namespace yask {
             rank_idxs.stop[step_posn] = stop_t;
             rank_idxs.step[step_posn] = step_t;
 
+            // Areas to calculate in this step: the whole rank or the
+            // parts of it needed for the sampled blocks.
+            vector<ScanIndices> areas;
+            if (val_bbs.empty())
+                areas.push_back(rank_idxs);
+            for (auto& bb : val_bbs) {
+                ScanIndices area(rank_idxs);
+                bool is_empty = false;
+                for (auto& dim : _dims->_domain_dims.getDims()) {
+                    auto& dname = dim.getName();
+                    int i = _dims->_stencil_dims.lookup_posn(dname);
+                    idx_t ext = margins[dname] * (num_t - index_t);
+                    area.begin[i] = max(rank_idxs.begin[i], bb.bb_begin[dname] - ext);
+                    area.end[i] = min(rank_idxs.end[i], bb.bb_end[dname] + ext);
+                    if (area.end[i] <= area.begin[i])
+                        is_empty = true;
+                }
+                if (!is_empty)
+                    areas.push_back(area);
+            }
+
+            // Is 'pt' in any of the first 'na' areas?
+            auto is_in_areas = [&](size_t na, const Indices& pt) {
+                for (size_t aj = 0; aj < na; aj++) {
+                    bool is_in = true;
+                    for (int i = step_posn + 1; is_in && i < ndims; i++)
+                        if (pt[i] < areas[aj].begin[i] || pt[i] >= areas[aj].end[i])
+                            is_in = false;
+                    if (is_in)
+                        return true;
+                }
+                return false;
+            };
+
             // Loop thru bundles. We ignore bundle packs here
             // because packing bundles is an optional optimizations.
             for (auto* asg : stBundles) {
@@ -244,30 +458,36 @@ namespace yask {
                 // groups plus this non-scratch group.
                 auto sg_list = asg->get_reqd_bundles();
 
-                // Loop through all the needed bundles.
+                // Loop through all the needed bundles and areas.
                 for (auto* sg : sg_list) {
-
-                    // Indices needed for the generated misc loops.  Will normally be a
-                    // copy of rank_idxs except when updating scratch-grids.
-                    ScanIndices misc_idxs = sg->adjust_span(scratch_grid_idx, rank_idxs);
-                    misc_idxs.step.setFromConst(1); // ensure unit step.
-
-                    // Define misc-loop function.  Since step is always 1, we
-                    // ignore misc_stop.  If point is in sub-domain for this
-                    // bundle, then evaluate the reference scalar code.
-                    // TODO: fix domain of scratch grids.
+                    for (size_t ai = 0; ai < areas.size(); ai++) {
+
+                        // Indices needed for the generated misc loops.  Will normally be a
+                        // copy of the area except when updating scratch-grids.
+                        ScanIndices misc_idxs = sg->adjust_span(scratch_grid_idx, areas[ai]);
+                        misc_idxs.step.setFromConst(1); // ensure unit step.
+
+                        // Define misc-loop function.  Since step is always 1, we
+                        // ignore misc_stop.  If point is in sub-domain for this
+                        // bundle and was not done in an earlier area, then
+                        // evaluate the reference scalar code. Points must not
+                        // be done twice because a grid may be updated in place
+                        // of an older step.
+                        // TODO: fix domain of scratch grids.
 #define misc_fn(misc_idxs)   do {                                       \
-                        if (sg->is_in_valid_domain(misc_idxs.start))    \
-                            sg->calc_scalar(scratch_grid_idx, misc_idxs.start); \
-                    } while(0)
-
-                    // Scan through n-D space.
-                    TRACE_MSG("calc_rank_ref: step " << start_t <<
-                              " in bundle '" << sg->get_name() << "': " <<
-                              misc_idxs.begin.makeValStr(ndims) <<
-                              " ... (end before) " << misc_idxs.end.makeValStr(ndims));
+                            if (sg->is_in_valid_domain(misc_idxs.start) && \
+                                !is_in_areas(ai, misc_idxs.start))      \
+                                sg->calc_scalar(scratch_grid_idx, misc_idxs.start); \
+                        } while(0)
+
+                        // Scan through n-D space.
+                        TRACE_MSG("calc_rank_ref: step " << start_t <<
+                                  " in bundle '" << sg->get_name() << "': " <<
+                                  misc_idxs.begin.makeValStr(ndims) <<
+                                  " ... (end before) " << misc_idxs.end.makeValStr(ndims));
 #include "yask_misc_loops.hpp"
 #undef misc_fn
+                    } // areas.
                 } // needed bundles.
 
                 // Mark grids that [may] have been written to,
@@ -307,56 +527,26 @@ namespace yask {
         exchange_halos_all();
     }
 
-    // Eval stencil bundle pack(s) over grid(s) using optimized code.
-    void StencilContext::run_solution(idx_t first_step_index,
-                                      idx_t last_step_index)
-    {
-        run_time.start();
-
+    // Make the settings-based values used by run_solution().
+    void StencilContext::make_step_plan() {
         auto& step_dim = _dims->_step_dim;
         auto step_posn = Indices::step_posn;
-        auto step_dir = _dims->_step_dir;
-        int ndims = _dims->_stencil_dims.size();
-
-        // Find begin, step and end in step-dim.
-        idx_t begin_t = first_step_index;
+        auto& plan = _step_plan;
 
         // Step-size in step-dim is number of region steps.
         // Then, it is multipled by +/-1 to get proper direction.
-        idx_t step_t = _opts->_region_sizes[step_dim];
-        step_t *= step_dir;
-        assert(step_t);
-        idx_t end_t = last_step_index + step_dir; // end is beyond last.
+        plan.step_t = _opts->_region_sizes[step_dim] * _dims->_step_dir;
+        assert(plan.step_t);
 
-        // Begin, end, step tuples.
+        // Begin and end tuples.
         // Based on overall bounding box, which includes
         // any needed extensions for wave-fronts.
         IdxTuple begin(_dims->_stencil_dims);
         begin.setVals(ext_bb.bb_begin, false);
-        begin[step_dim] = begin_t;
+        begin[step_dim] = 0;
         IdxTuple end(_dims->_stencil_dims);
         end.setVals(ext_bb.bb_end, false);
-        end[step_dim] = end_t;
-        IdxTuple step(_dims->_stencil_dims);
-        step.setVals(_opts->_region_sizes, false); // step by region sizes.
-        step[step_dim] = step_t;
-
-        TRACE_MSG("run_solution: " << begin.makeDimValStr() << " ... (end before) " <<
-                  end.makeDimValStr() << " by " << step.makeDimValStr());
-        if (!rank_bb.bb_valid)
-            THROW_YASK_EXCEPTION("Error: run_solution() called without calling prepare_solution() first");
-        if (ext_bb.bb_size < 1) {
-            TRACE_MSG("nothing to do in solution");
-            return;
-        }
-
-#ifdef MODEL_CACHE
-        ostream& os = get_ostr();
-        if (context.my_rank != context.msg_rank)
-            cache_model.disable();
-        if (cache_model.isEnabled())
-            os << "Modeling cache...\n";
-#endif
+        end[step_dim] = 0;
 
         // Extend end points for overlapping regions due to wavefront angle.
         // For each subsequent time step in a region, the spatial location
@@ -381,7 +571,11 @@ namespace yask {
         //                      |XXXXXX|         |XXXXX|  <- redundant calculations.
         // XXXXXX|  <- areas outside of outer ranks not calculated ->  |XXXXXXX
         //
-        if (abs(step_t) > 1) {
+        plan.oblivious = abs(plan.step_t) > 1 && _opts->cache_oblivious &&
+            !_opts->is_block_time_tiling();
+        plan.diamond = abs(plan.step_t) > 1 && _opts->diamond_tiling &&
+            !_opts->is_block_time_tiling() && !plan.oblivious;
+        if (abs(plan.step_t) > 1 && !plan.diamond && !plan.oblivious) {
             for (auto& dim : _dims->_domain_dims.getDims()) {
                 auto& dname = dim.getName();
 
@@ -395,32 +589,126 @@ namespace yask {
                       begin.makeDimValStr() << " ... (end before) " <<
                       end.makeDimValStr());
         }
+        plan.begin = begin;
+        plan.end = end;
+        assert(plan.begin[step_posn] == 0);
+
+        // Max steps stored over all grids.
+        plan.halo_begin_t = 0;
+        plan.halo_end_t = 1;
+        for (auto gp : gridPtrs) {
+            if (gp->is_dim_used(step_dim)) {
+                plan.halo_begin_t = min(plan.halo_begin_t, gp->_get_first_alloc_index(step_dim));
+                plan.halo_end_t = max(plan.halo_end_t, gp->_get_last_alloc_index(step_dim) + 1);
+            }
+        }
+        plan.valid = true;
+    }
+
+    // Eval stencil bundle pack(s) over grid(s) using optimized code.
+    void StencilContext::run_solution(idx_t first_step_index,
+                                      idx_t last_step_index)
+    {
+        double run_secs0 = run_time.get_elapsed_secs();
+        double mpi_secs0 = mpi_time.get_elapsed_secs();
+        idx_t steps0 = steps_done;
+        bool do_energy = is_energy_measured();
+        run_time.start();
+        if (do_energy)
+            run_energy.start();
+
+        auto& step_dim = _dims->_step_dim;
+        auto step_posn = Indices::step_posn;
+        auto step_dir = _dims->_step_dir;
+        int ndims = _dims->_stencil_dims.size();
+
+        // Settings-based values are made once and reused by later calls.
+        if (!rank_bb.bb_valid)
+            THROW_YASK_EXCEPTION("Error: run_solution() called without calling prepare_solution() first");
+        if (!_step_plan.valid)
+            make_step_plan();
+        auto& plan = _step_plan;
+
+        // Find begin, step and end in step-dim.
+        idx_t begin_t = first_step_index;
+        idx_t step_t = plan.step_t;
+        idx_t end_t = last_step_index + step_dir; // end is beyond last.
+
+        TRACE_MSG("run_solution: steps " << begin_t << " ... (end before) " <<
+                  end_t << " by " << step_t);
+        if (_batch.size() && (is_auto_tuner_enabled() || _opts->rebalance_interval > 0 ||
+                              _num_progress_threads))
+            THROW_YASK_EXCEPTION("Error: run_solution() called on a batch of solutions"
+                                 " with auto-tuning, rank rebalancing or progress threads enabled");
+        if (_sparse_ops.size() && abs(step_t) > 1)
+            THROW_YASK_EXCEPTION("Error: run_solution() called with sparse points"
+                                 " and temporal wave-front tiling enabled");
+        if (ext_bb.bb_size < 1) {
+            TRACE_MSG("nothing to do in solution");
+            return;
+        }
+
+#ifdef MODEL_CACHE
+        ostream& os = get_ostr();
+        if (context.my_rank != context.msg_rank)
+            cache_model.disable();
+        if (cache_model.isEnabled())
+            os << "Modeling cache...\n";
+#endif
+        bool diamond = plan.diamond;
+        bool oblivious = plan.oblivious;
 
         // Indices needed for the 'rank' loops.
+        // Other step values are set in the step loop.
         ScanIndices rank_idxs(*_dims, true, &rank_domain_offsets);
-        rank_idxs.begin = begin;
-        rank_idxs.end = end;
-        rank_idxs.step = step;
-
-        // Make sure threads are set properly for a region.
+        rank_idxs.begin = plan.begin;
+        rank_idxs.end = plan.end;
+        rank_idxs.begin[step_posn] = begin_t;
+        rank_idxs.end[step_posn] = end_t;
+
+        // Make sure threads are set properly for a region
+        // and run on the CPUs of this solution.
+        ScopedCpuBinding cpu_binding(_opts->_cpus);
         set_region_threads();
+        bind_region_threads();
+
+        // Find sparse points in this rank.
+        prep_sparse_ops();
 
         // Initial halo exchange.
         exchange_halos_all();
 
-        // Number of iterations to get from begin_t to end_t-1,
-        // stepping by step_t.
-        const idx_t num_t = CEIL_DIV(abs(end_t - begin_t), abs(step_t));
-        for (idx_t index_t = 0; index_t < num_t; index_t++)
+        // Sparse ops must see the whole pack before its halos are sent.
+        bool overlap_comms = _opts->overlap_comms && _sparse_ops.empty();
+
+        // Run all the steps in one thread team if allowed. Then, the
+        // step loop below has nothing to do.
+        bool in_team = _opts->persistent_team && abs(step_t) == 1 &&
+            !_opts->is_block_time_tiling() && !_opts->overlap_comms &&
+            deep_halo_steps == 1 && _sparse_ops.empty() && _step_callbacks.empty();
+        if (in_team)
+            run_steps_in_team(begin_t, end_t, step_t, rank_idxs);
+
+        // Steps since the last deep-halo exchange, counted in step_t units.
+        idx_t deep_idx = 0;
+
+        // Iterate from begin_t to end_t-1, stepping by step_t or less if
+        // a step callback needs the data at an earlier step.
+        idx_t start_t = in_team ? end_t : begin_t;
+        for (idx_t index_t = 0; (step_t > 0) ? start_t < end_t : start_t > end_t; index_t++)
         {
             YaskTimer rtime;   // just for these step_t steps.
+            EnergyMeter renergy;
             rtime.start();
+            if (do_energy)
+                renergy.start();
 
             // This value of index_t steps from start_t to stop_t-1.
-            const idx_t start_t = begin_t + (index_t * step_t);
-            const idx_t stop_t = (step_t > 0) ?
+            idx_t stop_t = (step_t > 0) ?
                 min(start_t + step_t, end_t) :
                 max(start_t + step_t, end_t);
+            if (_step_callbacks.size())
+                stop_t = limit_to_step_callbacks(start_t, stop_t);
             idx_t this_num_t = abs(stop_t - start_t);
 
             // Set indices that will pass through generated code.
@@ -429,13 +717,51 @@ namespace yask {
             rank_idxs.stop[step_posn] = stop_t;
             rank_idxs.step[step_posn] = step_t;
 
+            // Region sizes may have been changed by the auto-tuner.
+            for (int i = 0; i < ndims; i++) {
+                if (i != step_posn)
+                    rank_idxs.step[i] = _opts->_region_sizes[_dims->_stencil_dims.getDimName(i)];
+            }
+
             // If no wave-fronts (default), loop through packs here, and do
             // only one pack at a time in calc_region(). This is similar to
             // loop in calc_rank_ref(), but with packs instead of bundles.
             if (step_t == 1) {
 
+                // Shift number within the current group of steps
+                // between exchanges when using deep halos.
+                idx_t shift_num = (deep_idx % deep_halo_steps) * stPacks.size();
+                Indices rbegin(rank_idxs.begin), rend(rank_idxs.end);
+
                 for (auto& bp : stPacks) {
 
+                    // With deep halos, exchange only before the first pack
+                    // in each group of steps, and shrink the extended rank
+                    // by the WF angles at each shift as in trim_region().
+                    if (deep_halo_steps > 1) {
+                        if (shift_num == 0)
+                            exchange_halos_all();
+                        for (int i = 0, j = 0; i < ndims; i++) {
+                            if (i == step_posn) continue;
+                            auto angle = wf_angles[j];
+                            rank_idxs.begin[i] = rbegin[i];
+                            rank_idxs.end[i] = rend[i];
+                            if (left_wf_exts[j] > 0)
+                                rank_idxs.begin[i] += shift_num * angle;
+                            if (right_wf_exts[j] > 0)
+                                rank_idxs.end[i] -= shift_num * angle;
+                            j++;
+                        }
+                        shift_num++;
+                        TRACE_MSG("run_solution: step " << start_t <<
+                                  " in bundle-pack '" << bp->get_name() << "' over " <<
+                                  rank_idxs.begin.makeValStr(ndims) << " ... (end before) " <<
+                                  rank_idxs.end.makeValStr(ndims) << " with deep halos");
+#include "yask_rank_loops.hpp"
+                        apply_sparse_ops(bp, start_t + step_t);
+                        continue;
+                    }
+
 #if 0
                     // Exchange dirty halo(s) needed for this pack.
                     // TODO: fix this so that it knows which inputs
@@ -444,15 +770,31 @@ namespace yask {
                     exchange_halos(bp, start_t, stop_t);
 #else
                     // Exchange all dirty halos.
+                    // This also completes any exchange started by
+                    // calc_rank_overlapped() for the previous pack.
                     exchange_halos_all();
 #endif
 
+                    // Calculate the shell, start the halo exchange,
+                    // and then calculate the interior.
+                    if (overlap_comms) {
+                        TRACE_MSG("run_solution: step " << start_t <<
+                                  " in bundle-pack '" << bp->get_name() <<
+                                  "' with comm/compute overlap");
+                        calc_rank_overlapped(bp, rank_idxs);
+                    }
+
                     // Include automatically-generated loop code that calls
                     // calc_region() for each region.
-                    TRACE_MSG("run_solution: step " << start_t <<
-                              " in bundle-pack '" << bp->get_name() << "'");
+                    else {
+                        TRACE_MSG("run_solution: step " << start_t <<
+                                  " in bundle-pack '" << bp->get_name() << "'");
 #include "yask_rank_loops.hpp"
+                    }
+                    apply_sparse_ops(bp, start_t + step_t);
                 }
+                rank_idxs.begin = rbegin;
+                rank_idxs.end = rend;
             }
 
             // If doing wave-fronts, must loop through all packs in
@@ -463,24 +805,55 @@ namespace yask {
                 // Exchange all dirty halo(s).
                 exchange_halos_all();
 
-                // Null ptr => Eval all stencil bundles.
-                BundlePackPtr bp;
+                // Diamond tiles over the whole rank.
+                if (diamond)
+                    calc_rank_diamond(rank_idxs);
+
+                // Recursive space-time cuts over the whole rank.
+                else if (oblivious)
+                    calc_rank_oblivious(rank_idxs);
 
-                // Include automatically-generated loop code that calls calc_region() for each region.
-                TRACE_MSG("run_solution: steps " << start_t << " ... (end before) " << stop_t);
+                else {
+
+                    // Null ptr => Eval all stencil bundles.
+                    BundlePackPtr bp;
+
+                    // Include automatically-generated loop code that calls calc_region() for each region.
+                    TRACE_MSG("run_solution: steps " << start_t << " ... (end before) " << stop_t);
 #include "yask_rank_loops.hpp"
+                }
             }
 
             steps_done += this_num_t;
             rtime.stop();   // for these steps.
+            renergy.stop();
 
             // Call the auto-tuner to evaluate these steps.
             // TODO: remove MPI time from consideration by auto-tuner.
             auto elapsed_time = rtime.get_elapsed_secs();
-            _at.eval(this_num_t, elapsed_time);
+            _at.eval(this_num_t, elapsed_time, renergy.get_joules());
+            if (_opts->step_stats)
+                step_times.insert(step_times.end(), this_num_t, elapsed_time / this_num_t);
+            deep_idx++;
+
+            // Call any user functions due in these steps. Start a new
+            // deep-halo group if they changed any grids.
+            if (_step_callbacks.size()) {
+                run_time.stop();
+                run_energy.stop();
+                if (call_step_callbacks(start_t, stop_t))
+                    deep_idx = 0;
+                run_time.start();
+                if (do_energy)
+                    run_energy.start();
+            }
+            start_t = stop_t;
 
         } // step loop.
 
+        // Complete any halo exchange still in flight.
+        finish_halo_exchange();
+
 #ifdef MODEL_CACHE
         // Print cache stats, then disable.
         // Thus, cache is only modeled for first call.
@@ -491,6 +864,225 @@ namespace yask {
         }
 #endif
         run_time.stop();
+        run_energy.stop();
+
+        for (auto& bc : _batch)
+            bc->steps_done += steps_done - steps0;
+
+        // Rebalance ranks using the compute time in these steps.
+        rebalance_secs += (run_time.get_elapsed_secs() - run_secs0) -
+            (mpi_time.get_elapsed_secs() - mpi_secs0);
+        rebalance_steps += steps_done - steps0;
+        if (_opts->rebalance_interval > 0 &&
+            rebalance_steps >= _opts->rebalance_interval)
+            rebalance_ranks();
+    }
+
+    // Calculate results for bundle pack 'bp' over the rank span in
+    // 'rank_idxs' while overlapping the halo exchange with computation.
+    // The shell of the rank domain, i.e., the parts copied into the MPI
+    // send buffers, is calculated first. Then, the halo exchange is
+    // started, and the interior is calculated while the messages are in
+    // flight. The exchange is finished by the next call to
+    // exchange_halos() or finish_halo_exchange().
+    void StencilContext::calc_rank_overlapped(BundlePackPtr& bp,
+                                              ScanIndices& rank_idxs) {
+
+        int ndims = _dims->_stencil_dims.size();
+        auto& step_dim = _dims->_step_dim;
+        auto step_posn = Indices::step_posn;
+
+        // Save original span.
+        Indices begin(rank_idxs.begin);
+        Indices end(rank_idxs.end);
+
+        // Divide the shell into non-overlapping slabs: in each domain dim,
+        // the left and right slabs cover only the interior in the
+        // previous dims and the entire span in the following dims.
+        Indices ibegin(begin), iend(end); // interior.
+        vector<pair<Indices, Indices>> slabs;
+        for (int i = 0, j = 0; i < ndims; i++) {
+            if (i == step_posn) continue;
+
+            // Left and right shell boundaries.
+            idx_t lend = min(begin[i] + left_shell_sizes[j], end[i]);
+            idx_t rbegin = max(end[i] - right_shell_sizes[j], lend);
+
+            if (lend > begin[i]) {
+                Indices sbegin(ibegin), send(iend);
+                send[i] = lend;
+                slabs.push_back(make_pair(sbegin, send));
+            }
+            if (end[i] > rbegin) {
+                Indices sbegin(ibegin), send(iend);
+                sbegin[i] = rbegin;
+                slabs.push_back(make_pair(sbegin, send));
+            }
+            ibegin[i] = lend;
+            iend[i] = rbegin;
+            j++;
+        }
+
+        // Calculate the shell.
+        for (auto& slab : slabs) {
+            rank_idxs.begin = slab.first;
+            rank_idxs.end = slab.second;
+            TRACE_MSG("calc_rank_overlapped: shell " <<
+                      rank_idxs.begin.makeValStr(ndims) <<
+                      " ... (end before) " << rank_idxs.end.makeValStr(ndims));
+#include "yask_rank_loops.hpp"
+        }
+
+        // Start exchanging the halos written by this pack.  The step is
+        // the same as the one marked dirty in calc_region().
+        idx_t t = rank_idxs.start[step_posn] + _opts->_block_sizes[step_dim];
+        start_halo_exchange(nullptr, t);
+
+        // Calculate the interior.
+        bool ok = true;
+        for (int i = 0; i < ndims; i++)
+            if (i != step_posn && iend[i] <= ibegin[i])
+                ok = false;
+        if (ok) {
+            rank_idxs.begin = ibegin;
+            rank_idxs.end = iend;
+            TRACE_MSG("calc_rank_overlapped: interior " <<
+                      rank_idxs.begin.makeValStr(ndims) <<
+                      " ... (end before) " << rank_idxs.end.makeValStr(ndims));
+#include "yask_rank_loops.hpp"
+        }
+
+        // Restore original span.
+        rank_idxs.begin = begin;
+        rank_idxs.end = end;
+    }
+
+    // Trim the span of a region for bundle pack 'bp' at wave-front shift
+    // 'shift_num'. The shifted region boundaries are in 'start' and 'stop';
+    // the trimmed boundaries are written to 'idxs.begin' and 'idxs.end'.
+    // Return whether there is anything to do.
+    bool StencilContext::trim_region(const BundlePackPtr& bp,
+                                     const Indices& start, const Indices& stop,
+                                     idx_t shift_num,
+                                     ScanIndices& idxs) const {
+        int ndims = _dims->_stencil_dims.size();
+        auto step_posn = Indices::step_posn;
+
+        // For wavefront adjustments, see conceptual diagram in
+        // run_solution().  One of the parallelogram-shaped regions is
+        // being evaluated.  These shapes may extend beyond actual
+        // boundaries. So, at each time-step, the parallelogram may be
+        // trimmed based on the BB and WF extensions outside of the
+        // rank-BB.
+
+        // Actual region boundaries must stay within [extended] pack BB.
+        // We have to calculate the posn in the extended rank at each
+        // value of 'shift_num' because it is being shifted spatially.
+        bool ok = true;
+        auto& pbb = bp->getBB();
+        for (int i = 0, j = 0; i < ndims; i++) {
+            if (i == step_posn) continue;
+            auto angle = wf_angles[j];
+
+            // Begin point.
+            idx_t dbegin = rank_bb.bb_begin[j]; // non-extended domain.
+            idx_t rbegin = max<idx_t>(start[i], pbb.bb_begin[j]);
+            if (rbegin < dbegin) // in left WF ext?
+                rbegin = max(rbegin, dbegin - left_wf_exts[j] + shift_num * angle);
+            idxs.begin[i] = rbegin;
+
+            // End point.
+            idx_t dend = rank_bb.bb_end[j]; // non-extended domain.
+            idx_t rend = min<idx_t>(stop[i], pbb.bb_end[j]);
+            if (rend > dend) // in right WF ext?
+                rend = min(rend, dend + right_wf_exts[j] - shift_num * angle);
+            idxs.end[i] = rend;
+
+            // Anything to do?
+            if (rend <= rbegin)
+                ok = false;
+
+            j++; // next domain index.
+        }
+        return ok;
+    }
+
+    // Run steps one at a time using one OpenMP team for all of them
+    // instead of new parallel regions for every region and pack.
+    // For each pack, the master thread exchanges halos and visits the
+    // regions via calc_region() to collect their blocks, and then the
+    // whole team computes the blocks. The barriers at the start and end
+    // of each pack's block loop are the only synchronization.
+    void StencilContext::run_steps_in_team(idx_t begin_t, idx_t end_t, idx_t step_t,
+                                           ScanIndices& rank_idxs) {
+        int ndims = _dims->_stencil_dims.size();
+        auto step_posn = Indices::step_posn;
+        const idx_t num_t = CEIL_DIV(abs(end_t - begin_t), abs(step_t));
+        YaskTimer rtime;   // for one step.
+        EnergyMeter renergy;
+        bool do_energy = is_energy_measured();
+        int nthr = max(omp_get_max_threads(), 1);
+        TRACE_MSG("run_steps_in_team: " << num_t << " step(s) with " << nthr << " thread(s)");
+
+#pragma omp parallel num_threads(nthr) proc_bind(spread)
+        for (idx_t index_t = 0; index_t < num_t; index_t++) {
+            const idx_t start_t = begin_t + (index_t * step_t);
+            const idx_t stop_t = start_t + step_t;
+
+            for (auto& bp : stPacks) {
+
+#pragma omp master
+                {
+                    if (bp == stPacks.front()) {
+                        rtime.clear();
+                        rtime.start();
+                        renergy.clear();
+                        if (do_energy)
+                            renergy.start();
+
+                        // Set indices that will pass through generated code.
+                        rank_idxs.index[step_posn] = index_t;
+                        rank_idxs.start[step_posn] = start_t;
+                        rank_idxs.stop[step_posn] = stop_t;
+                        rank_idxs.step[step_posn] = step_t;
+
+                        // Region sizes may have been changed by the auto-tuner.
+                        for (int i = 0; i < ndims; i++) {
+                            if (i != step_posn)
+                                rank_idxs.step[i] = _opts->_region_sizes[_dims->_stencil_dims.getDimName(i)];
+                        }
+                    }
+
+                    // Exchange all dirty halos.
+                    exchange_halos_all();
+
+                    // Collect the blocks from the regions.
+                    TRACE_MSG("run_steps_in_team: step " << start_t <<
+                              " in bundle-pack '" << bp->get_name() << "'");
+                    _team_blocks.clear();
+                    _collect_blocks = true;
+#include "yask_rank_loops.hpp"
+                    _collect_blocks = false;
+                }
+#pragma omp barrier
+
+                // Compute the blocks.
+#pragma omp for schedule(dynamic, 1)
+                for (idx_t bn = 0; bn < idx_t(_team_blocks.size()); bn++)
+                    calc_block(bp, _team_blocks[bn]);
+            }
+
+            // Call the auto-tuner to evaluate this step.
+#pragma omp master
+            {
+                steps_done++;
+                rtime.stop();
+                renergy.stop();
+                _at.eval(1, rtime.get_elapsed_secs(), renergy.get_joules());
+                if (_opts->step_stats)
+                    step_times.push_back(rtime.get_elapsed_secs());
+            }
+        }
     }
 
     // Calculate results within a region.  Each region is typically computed
@@ -498,6 +1090,8 @@ namespace yask {
     // the time steps and bundle packs and evaluate a pack in each of
     // the blocks in the region.  If 'sel_bp' is null, eval all packs; else
     // eval only the one pointed to.
+    // If the block size in the step dim is > 1, each block is evaluted
+    // over multiple steps and all selected packs in calc_block().
     void StencilContext::calc_region(BundlePackPtr& sel_bp,
                                      const ScanIndices& rank_idxs) {
 
@@ -506,6 +1100,7 @@ namespace yask {
         auto step_posn = Indices::step_posn;
         TRACE_MSG("calc_region: " << rank_idxs.start.makeValStr(ndims) <<
                   " ... (end before) " << rank_idxs.stop.makeValStr(ndims));
+        TRACE_EVENT("compute", "region");
 
         // Init region begin & end from rank start & stop indices.
         ScanIndices region_idxs(*_dims, true, &rank_domain_offsets);
@@ -516,19 +1111,20 @@ namespace yask {
         Indices start(region_idxs.begin);
         Indices stop(region_idxs.end);
 
-        // Not yet supporting temporal tiling at block level.
-        if (_opts->_block_sizes[step_dim] != 1)
-            THROW_YASK_EXCEPTION("Error: temporal tiling in blocks not yet supported");
-
         // Steps within a region are based on block sizes.
         region_idxs.step = _opts->_block_sizes;
 
         // Groups in region loops are based on block-group sizes.
         region_idxs.group_size = _opts->_block_group_sizes;
 
+        // Number of selected packs.
+        idx_t npacks = sel_bp ? 1 : stPacks.size();
+
         // Step (usually time) loop.
         // When doing WF tiling, this loop will step through
         // several time-steps in each region.
+        // When doing temporal tiling in blocks, each iteration
+        // covers the steps in one block.
         idx_t begin_t = region_idxs.begin[step_posn];
         idx_t end_t = region_idxs.end[step_posn];
         idx_t step_t = region_idxs.step[step_posn];
@@ -547,6 +1143,57 @@ namespace yask {
             region_idxs.start[step_posn] = start_t;
             region_idxs.stop[step_posn] = stop_t;
 
+            // Temporal tiling in blocks.
+            if (abs(step_t) > 1) {
+                idx_t this_num_t = abs(stop_t - start_t);
+
+                // Save the current region boundaries for calc_block().
+                _block_wf.start = start;
+                _block_wf.stop = stop;
+                _block_wf.shift_num = shift_num;
+                for (auto& bc : _batch)
+                    bc->_block_wf = _block_wf;
+
+                // Each block is shifted left by the WF angles after each
+                // pack in each step, so the region is extended to the right
+                // by the total block shift to make sure the last blocks
+                // cover the region at every step.
+                idx_t nshifts = npacks * this_num_t - 1;
+                for (int i = 0, j = 0; i < ndims; i++) {
+                    if (i == step_posn) continue;
+                    region_idxs.begin[i] = start[i];
+                    region_idxs.end[i] = stop[i] + wf_angles[j] * nshifts;
+                    j++;
+                }
+                TRACE_MSG("calc_region: steps " << start_t << " ... (end before) " << stop_t <<
+                          " in blocks over " << region_idxs.begin.makeValStr(ndims) <<
+                          " ... (end before) " << region_idxs.end.makeValStr(ndims));
+
+                // Include automatically-generated loop code that calls
+                // calc_block() for each block in this region. The blocks
+                // must be evaluated in order, so the region threads were
+                // limited to one in set_region_threads().
+                BundlePackPtr& bp = sel_bp;
+#include "yask_region_loops.hpp"
+
+                // Mark grids that [may] have been written to by the packs
+                // at each step (see comments below).
+                idx_t dir = (step_t > 0) ? 1 : -1;
+                for (idx_t t = start_t; t != stop_t; t += dir)
+                    mark_grids_dirty(sel_bp, t + dir, t + 2 * dir);
+
+                // Shift region boundaries for next iteration.
+                for (int i = 0, j = 0; i < ndims; i++) {
+                    if (i == step_posn) continue;
+                    auto angle = wf_angles[j];
+                    start[i] -= angle * (nshifts + 1);
+                    stop[i] -= angle * (nshifts + 1);
+                    j++;
+                }
+                shift_num += nshifts + 1;
+                continue;
+            }
+
             // Stencil bundle packs to evaluate at this time step.
             for (auto& bp : stPacks) {
 
@@ -557,42 +1204,8 @@ namespace yask {
                 TRACE_MSG("calc_region: bundle-pack '" << bp->get_name() << "' in step(s) " <<
                           start_t << " ... (end before) " << stop_t);
 
-                // For wavefront adjustments, see conceptual diagram in
-                // run_solution().  In this function, one of the
-                // parallelogram-shaped regions is being evaluated.  These
-                // shapes may extend beyond actual boundaries. So, at each
-                // time-step, the parallelogram may be trimmed based on the
-                // BB and WF extensions outside of the rank-BB.
-
-                // Actual region boundaries must stay within [extended] pack BB.
-                // We have to calculate the posn in the extended rank at each
-                // value of 'shift_num' because it is being shifted spatially.
-                bool ok = true;
-                auto& pbb = bp->getBB();
-                for (int i = 0, j = 0; i < ndims; i++) {
-                    if (i == step_posn) continue;
-                    auto angle = wf_angles[j];
-
-                    // Begin point.
-                    idx_t dbegin = rank_bb.bb_begin[j]; // non-extended domain.
-                    idx_t rbegin = max<idx_t>(start[i], pbb.bb_begin[j]);
-                    if (rbegin < dbegin) // in left WF ext?
-                        rbegin = max(rbegin, dbegin - left_wf_exts[j] + shift_num * angle);
-                    region_idxs.begin[i] = rbegin;
-
-                    // End point.
-                    idx_t dend = rank_bb.bb_end[j]; // non-extended domain.
-                    idx_t rend = min<idx_t>(stop[i], pbb.bb_end[j]);
-                    if (rend > dend) // in right WF ext?
-                        rend = min(rend, dend + right_wf_exts[j] - shift_num * angle);
-                    region_idxs.end[i] = rend;
-
-                    // Anything to do?
-                    if (rend <= rbegin)
-                        ok = false;
-
-                    j++; // next domain index.
-                }
+                // Trim region to this pack at this shift.
+                bool ok = trim_region(bp, start, stop, shift_num, region_idxs);
                 TRACE_MSG("calc_region: region span after trimming: " <<
                           region_idxs.begin.makeValStr(ndims) <<
                           " ... (end before) " << region_idxs.end.makeValStr(ndims));
@@ -603,13 +1216,33 @@ namespace yask {
                 // domain as time progresses and their boundaries shift. So,
                 // we don't want to return if this condition isn't met.
                 if (ok) {
+                    TRACE_EVENT("pack", bp->get_name().c_str());
 
                     // Include automatically-generated loop code that
                     // calls calc_block() for each block in this region.
                     // Loops through x from begin_rx to end_rx-1;
                     // similar for y and z.  This code typically
                     // contains the outer OpenMP loop(s).
+                    if (_collect_blocks)
+                        find_region_blocks(region_idxs, _team_blocks);
+                    else if (_numa_part_begins.size() > 1)
+                        calc_region_numa(bp, region_idxs);
+                    else if (_opts->prefetch_helpers)
+                        calc_region_prefetching(bp, region_idxs);
+                    else if (_opts->steal_blocks)
+                        calc_region_stealing(bp, region_idxs);
+
+                    // Visit blocks along a space-filling curve.
+                    else if (get_scan_order(_opts->block_order) != scan_order_loops) {
+                        vector<ScanIndices> blocks;
+                        find_region_blocks(region_idxs, blocks);
+#pragma omp parallel for schedule(dynamic, 1) proc_bind(spread)
+                        for (idx_t bn = 0; bn < idx_t(blocks.size()); bn++)
+                            calc_block(bp, blocks[bn]);
+                    }
+                    else {
 #include "yask_region_loops.hpp"
+                    }
                 }
 
                 // Mark grids that [may] have been written to by this pack,
@@ -640,98 +1273,936 @@ namespace yask {
         } // time.
     } // calc_region.
 
-    // Calculate results within a block. This function calls
-    // 'calc_block' for each bundle in the specified pack.
-    // Typically called by a top-level OMP thread from calc_region().
-    void StencilContext::calc_block(BundlePackPtr& sel_bp,
-                                    const ScanIndices& region_idxs) {
-
+    // Calculate results over the steps in 'rank_idxs' with diamond tiling
+    // in the first domain dim instead of wave-fronts.
+    //
+    // Conceptually (showing t and the tiled dim x):
+    // ---------------------------  t = rt ----------------------------
+    //   |    /\    /\    /\    /\    /|  <- 'B' tiles grow.
+    //   | A /  \ A/  \ A/  \ A/  \ A/ |
+    //   |  / B  \/ B  \/ B  \/ B  \/  |  <- 'A' tiles shrink.
+    // ---------------------------  t = 0 -----------------------------
+    //   x = begin (ext)           x = end (ext)
+    //
+    // The 'A' tiles shrink by the WF angle at each shift, i.e., after each
+    // pack in each step, so they only depend on their own data and are
+    // all started together. The 'B' tiles between them grow by the same
+    // angle and are computed after all the 'A' tiles. The outer edges of
+    // the outer tiles shrink only if there is a WF extension in that
+    // direction; the other dims are not tiled and shrink into their WF
+    // extensions as in trim_region(). At each shift, the blocks of all
+    // the tiles in a phase are evaluated in one OpenMP loop.
+    void StencilContext::calc_rank_diamond(const ScanIndices& rank_idxs) {
 
-        int nsdims = _dims->_stencil_dims.size();
-        auto& step_dim = _dims->_step_dim;
+        int ndims = _dims->_stencil_dims.size();
         auto step_posn = Indices::step_posn;
-        auto* bp = sel_bp.get();
-        assert(bp);
-        TRACE_MSG("calc_block for pack '" << bp->get_name() << "': " <<
-                  region_idxs.start.makeValStr(nsdims) <<
-                  " ... (end before) " << region_idxs.stop.makeValStr(nsdims));
+        idx_t start_t = rank_idxs.start[step_posn];
+        idx_t stop_t = rank_idxs.stop[step_posn];
+        idx_t dir_t = (stop_t > start_t) ? 1 : -1;
+        idx_t num_t = abs(stop_t - start_t);
+        idx_t npacks = stPacks.size();
+        idx_t nshifts = npacks * num_t;
+
+        // Tiled dim.
+        int ti = (step_posn == 0) ? 1 : 0;
+        const int tj = 0;
+        auto& tname = _dims->_domain_dims.getDimName(tj);
+        idx_t angle = wf_angles[tj];
+        idx_t ebegin = rank_idxs.begin[ti];
+        idx_t eend = rank_idxs.end[ti];
+        bool left_shrink = left_wf_exts[tj] > 0;
+        bool right_shrink = right_wf_exts[tj] > 0;
+
+        // Tiles are the width of the regions, but the 'A' tiles must be
+        // wide enough to shrink from both sides at every shift.
+        idx_t width = max(_opts->_region_sizes[tname], 2 * angle * (nshifts - 1));
+        width = ROUND_UP(max(width, idx_t(1)), _dims->_cluster_pts[tname]);
+
+        // Interior tile boundaries, aligned to the rank domain. The outer
+        // 'A' tiles are at least 'width' wide.
+        vector<idx_t> bounds;
+        for (idx_t c = rank_bb.bb_begin[tj] + width; c + width <= eend; c += width)
+            bounds.push_back(c);
+        TRACE_MSG("calc_rank_diamond: steps " << start_t << " ... (end before) " << stop_t <<
+                  " with " << (bounds.size() + 1) << " tile(s) of width " << width <<
+                  " in '" << tname << "'");
+
+        // Init region begin & end from rank begin & end.
+        ScanIndices region_idxs(*_dims, true, &rank_domain_offsets);
+        region_idxs.initFromOuter(rank_idxs);
+        region_idxs.step = _opts->_block_sizes;
+        region_idxs.group_size = _opts->_block_group_sizes;
 
-        // Init block begin & end from region start & stop indices.
-        ScanIndices block_idxs(*_dims, true, 0);
-        block_idxs.initFromOuter(region_idxs);
+        vector<ScanIndices> blocks;
+        for (int phase = 0; phase < 2; phase++) {
+            idx_t shift_num = 0;
+            for (idx_t index_t = 0; index_t < num_t; index_t++) {
+                idx_t t = start_t + index_t * dir_t;
+                region_idxs.index[step_posn] = index_t;
+                region_idxs.begin[step_posn] = region_idxs.start[step_posn] = t;
+                region_idxs.end[step_posn] = region_idxs.stop[step_posn] = t + dir_t;
 
-        // Steps within a block are based on sub-block sizes.
-        block_idxs.step = _opts->_sub_block_sizes;
+                for (auto& bp : stPacks) {
 
-        // Groups in block loops are based on sub-block-group sizes.
-        block_idxs.group_size = _opts->_sub_block_group_sizes;
+                    // Span in the untiled dims: trimmed to pack BB and WF
+                    // extensions.
+                    bool ok = true;
+                    auto& pbb = bp->getBB();
+                    for (int i = 0, j = 0; i < ndims; i++) {
+                        if (i == step_posn) continue;
+                        if (i != ti) {
+                            idx_t a = wf_angles[j];
+                            idx_t b = rank_idxs.begin[i];
+                            idx_t e = rank_idxs.end[i];
+                            if (left_wf_exts[j] > 0)
+                                b += shift_num * a;
+                            if (right_wf_exts[j] > 0)
+                                e -= shift_num * a;
+                            region_idxs.begin[i] = max<idx_t>(b, pbb.bb_begin[j]);
+                            region_idxs.end[i] = min<idx_t>(e, pbb.bb_end[j]);
+                            if (region_idxs.end[i] <= region_idxs.begin[i])
+                                ok = false;
+                        }
+                        j++;
+                    }
+
+                    // Collect the blocks of each tile in this phase.
+                    blocks.clear();
+                    idx_t d = shift_num * angle;
+                    size_t ntiles = (phase == 0) ? bounds.size() + 1 : bounds.size();
+                    for (size_t n = 0; ok && n < ntiles; n++) {
+                        idx_t b, e;
+                        if (phase == 0) {
+                            b = (n == 0) ? (left_shrink ? ebegin + d : ebegin) : bounds[n - 1] + d;
+                            e = (n == bounds.size()) ? (right_shrink ? eend - d : eend) : bounds[n] - d;
+                        } else {
+                            b = bounds[n] - d;
+                            e = bounds[n] + d;
+                        }
+                        region_idxs.begin[ti] = max<idx_t>(b, pbb.bb_begin[tj]);
+                        region_idxs.end[ti] = min<idx_t>(e, pbb.bb_end[tj]);
+                        if (region_idxs.end[ti] > region_idxs.begin[ti])
+                            find_region_blocks(region_idxs, blocks);
+                    }
+                    TRACE_MSG("calc_rank_diamond: phase " << phase << " step " << t <<
+                              " in bundle-pack '" << bp->get_name() << "' in " <<
+                              blocks.size() << " block(s)");
+
+                    if (blocks.size()) {
+                        TRACE_EVENT("pack", bp->get_name().c_str());
+#pragma omp parallel for schedule(dynamic, 1) proc_bind(spread)
+                        for (idx_t bn = 0; bn < idx_t(blocks.size()); bn++)
+                            calc_block(bp, blocks[bn]);
+                    }
+
+                    // Mark grids that [may] have been written to by this
+                    // pack (see calc_region()).
+                    if (phase == 1)
+                        mark_grids_dirty(bp, t + dir_t, t + 2 * dir_t);
+                    shift_num++;
+                }
+            } // time.
+        } // phase.
+    } // calc_rank_diamond.
+
+    // Calculate results over the steps in 'rank_idxs' by recursively
+    // cutting the extended rank into space-time trapezoids, in the
+    // spirit of cache-oblivious trapezoidal decomposition.
+    //
+    // Conceptually (showing t and one domain dim x):
+    // ---------------------  t = rt  ---------------------
+    //   | L \    M    / R |          |  L     /\     R  |
+    //   |    \       /    |          |      /  \       |
+    //   |     \     /     |    or    |     / M  \      |
+    //   |      \   /      |          |    /      \     |
+    // ---------------------  t = 0  ----------------------
+    //   top wider: L and R,           bottom wider: M,
+    //   then M.                       then L and R.
+    //
+    // Each shift, i.e., each pack in each step, is one unit in the step
+    // dim, and each edge made by a cut moves by the WF angle per shift,
+    // so the pieces evaluated first only depend on their own data and
+    // the two side pieces can be evaluated in parallel. A trapezoid is cut
+    // in the first domain dim where it is wide enough; otherwise, it is cut
+    // in half in the step dim. One shift that cannot be cut further is
+    // evaluated by calc_block(). The outer edges shrink only if there is a
+    // WF extension in that direction as in calc_rank_diamond().
+    void StencilContext::calc_rank_oblivious(const ScanIndices& rank_idxs) {
 
-        // Loop through bundles in this pack.
-        for (auto* sb : *bp) {
-            sb->calc_block(block_idxs);
+        int ndims = _dims->_stencil_dims.size();
+        int nddims = _dims->_domain_dims.size();
+        auto step_posn = Indices::step_posn;
+        idx_t start_t = rank_idxs.start[step_posn];
+        idx_t stop_t = rank_idxs.stop[step_posn];
+        idx_t dir_t = (stop_t > start_t) ? 1 : -1;
+        idx_t num_t = abs(stop_t - start_t);
+        idx_t nshifts = idx_t(stPacks.size()) * num_t;
+
+        // Smallest piece widths, in points. These only keep the leaves
+        // large enough to use whole vector clusters and long inner loops;
+        // they do not need tuning for the cache sizes.
+        const idx_t min_inner_pts = 64, min_outer_pts = 4;
+
+        // Whole extended rank.
+        Trapezoid tz;
+        tz.s0 = 0;
+        tz.s1 = nshifts;
+        tz.x0 = rank_idxs.begin;
+        tz.x1 = rank_idxs.end;
+        tz.dx0 = Indices(idx_t(0), ndims);
+        tz.dx1 = Indices(idx_t(0), ndims);
+        Indices min_widths(idx_t(0), ndims);
+        for (int i = 0, j = 0; i < ndims; i++) {
+            if (i == step_posn) continue;
+            if (left_wf_exts[j] > 0)
+                tz.dx0[i] = wf_angles[j];
+            if (right_wf_exts[j] > 0)
+                tz.dx1[i] = -wf_angles[j];
+            auto cpts = _dims->_cluster_pts[j];
+            min_widths[i] = ROUND_UP((j == nddims - 1) ? min_inner_pts : min_outer_pts, cpts);
+            j++;
         }
-    }
+        TRACE_MSG("calc_rank_oblivious: steps " << start_t << " ... (end before) " << stop_t <<
+                  " over " << tz.x0.makeValStr(ndims) << " ... (end before) " <<
+                  tz.x1.makeValStr(ndims));
 
-    // Reset the auto-tuner.
-    void StencilContext::AT::clear(bool mark_done, bool verbose) {
+#pragma omp parallel proc_bind(spread)
+#pragma omp single
+        calc_trapezoid(tz, rank_idxs, min_widths);
 
-        // Output.
-        ostream& os = _context->get_ostr();
-#ifdef TRACE
-        this->verbose = true;
-#else
-        this->verbose = verbose;
+        // Mark grids that [may] have been written to by each pack
+        // (see calc_region()).
+        for (idx_t index_t = 0; index_t < num_t; index_t++) {
+            idx_t t = start_t + index_t * dir_t;
+            for (auto& bp : stPacks)
+                mark_grids_dirty(bp, t + dir_t, t + 2 * dir_t);
+        }
+    } // calc_rank_oblivious.
+
+    // Evaluate one trapezoid for calc_rank_oblivious(), cutting it
+    // recursively. Must be called by one thread in a parallel region.
+    void StencilContext::calc_trapezoid(const Trapezoid& tz,
+                                        const ScanIndices& rank_idxs,
+                                        const Indices& min_widths) {
+        int ndims = _dims->_stencil_dims.size();
+        auto step_posn = Indices::step_posn;
+        idx_t dt = tz.s1 - tz.s0;
+        if (dt <= 0)
+            return;
+
+        // Space cut in the first domain dim that is wide enough to make
+        // pieces of at least the min width after leaving room for the
+        // edges to move by the WF angle at each shift.
+        for (int i = 0, j = 0; i < ndims; i++) {
+            if (i == step_posn) continue;
+            idx_t angle = wf_angles[j];
+            idx_t bw = tz.x1[i] - tz.x0[i];
+            idx_t tw = bw + (tz.dx1[i] - tz.dx0[i]) * dt;
+            bool sides_first = tw >= bw;
+            if (max(bw, tw) < 2 * (angle * dt + min_widths[i])) {
+                j++;
+                continue;
+            }
+
+            // Cut at the middle of the wider end, aligned to the clusters
+            // in the rank domain.
+            idx_t xm = sides_first ? tz.x0[i] + tz.dx0[i] * dt + tw / 2 : tz.x0[i] + bw / 2;
+            auto cpts = _dims->_cluster_pts[j];
+            idx_t rb = rank_bb.bb_begin[j];
+            xm = rb + idiv_flr<idx_t>(xm - rb, cpts) * cpts;
+
+            Trapezoid left(tz), mid(tz), right(tz);
+            if (sides_first) {
+                left.x1[i] = xm;
+                left.dx1[i] = -angle;
+                right.x0[i] = xm;
+                right.dx0[i] = angle;
+                mid.x0[i] = mid.x1[i] = xm;
+                mid.dx0[i] = -angle;
+                mid.dx1[i] = angle;
+            } else {
+                mid.x0[i] = xm - angle * dt;
+                mid.dx0[i] = angle;
+                mid.x1[i] = xm + angle * dt;
+                mid.dx1[i] = -angle;
+                left.x1[i] = mid.x0[i];
+                left.dx1[i] = angle;
+                right.x0[i] = mid.x1[i];
+                right.dx0[i] = -angle;
+            }
+            TRACE_MSG("calc_trapezoid: shifts " << tz.s0 << " ... (end before) " << tz.s1 <<
+                      ": cut at " << xm << " in dim " << i <<
+                      (sides_first ? " with sides first" : " with middle first"));
+
+            if (!sides_first)
+                calc_trapezoid(mid, rank_idxs, min_widths);
+#pragma omp task firstprivate(left) shared(rank_idxs, min_widths)
+            calc_trapezoid(left, rank_idxs, min_widths);
+#pragma omp task firstprivate(right) shared(rank_idxs, min_widths)
+            calc_trapezoid(right, rank_idxs, min_widths);
+#pragma omp taskwait
+            if (sides_first)
+                calc_trapezoid(mid, rank_idxs, min_widths);
+            return;
+        }
+
+        // Time cut: lower half, then upper half.
+        if (dt > 1) {
+            idx_t h = dt / 2;
+            Trapezoid lower(tz), upper(tz);
+            lower.s1 = upper.s0 = tz.s0 + h;
+            for (int i = 0; i < ndims; i++) {
+                if (i == step_posn) continue;
+                upper.x0[i] += tz.dx0[i] * h;
+                upper.x1[i] += tz.dx1[i] * h;
+            }
+            calc_trapezoid(lower, rank_idxs, min_widths);
+            calc_trapezoid(upper, rank_idxs, min_widths);
+            return;
+        }
+
+        // One shift: evaluate its pack in one block trimmed to the pack BB.
+        idx_t npacks = stPacks.size();
+        idx_t start_t = rank_idxs.start[step_posn];
+        idx_t dir_t = (rank_idxs.stop[step_posn] > start_t) ? 1 : -1;
+        idx_t t = start_t + (tz.s0 / npacks) * dir_t;
+        auto& bp = stPacks[tz.s0 % npacks];
+        auto& pbb = bp->getBB();
+        ScanIndices block_idxs(*_dims, true, &rank_domain_offsets);
+        block_idxs.initFromOuter(rank_idxs);
+        block_idxs.begin[step_posn] = block_idxs.start[step_posn] = t;
+        block_idxs.end[step_posn] = block_idxs.stop[step_posn] = t + dir_t;
+        for (int i = 0, j = 0; i < ndims; i++) {
+            if (i == step_posn) continue;
+            block_idxs.begin[i] = block_idxs.start[i] = max<idx_t>(tz.x0[i], pbb.bb_begin[j]);
+            block_idxs.end[i] = block_idxs.stop[i] = min<idx_t>(tz.x1[i], pbb.bb_end[j]);
+            if (block_idxs.end[i] <= block_idxs.begin[i])
+                return;
+            j++;
+        }
+        calc_block(bp, block_idxs);
+    }
+
+    // Append the indices of each block in a region to 'blocks' in the
+    // order given by the '-block_order' option.
+    void StencilContext::find_region_blocks(const ScanIndices& region_idxs,
+                                            vector<ScanIndices>& blocks) const {
+        get_sub_ranges(region_idxs, get_scan_order(_opts->block_order), blocks);
+    }
+
+    // Calculate results in all the blocks of a region using a deque of
+    // blocks for each thread instead of the generated OpenMP loop. Each
+    // thread starts with a contiguous range of the blocks to keep
+    // neighboring blocks together. A thread that runs out of blocks
+    // takes one from the far end of another thread's deque.
+    void StencilContext::calc_region_stealing(BundlePackPtr& bp,
+                                              const ScanIndices& region_idxs) {
+        vector<ScanIndices> blocks;
+        find_region_blocks(region_idxs, blocks);
+        idx_t nblks = blocks.size();
+        if (nblks <= 0)
+            return;
+        if (nblks > idx_t(UINT32_MAX))
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: too many blocks (" << nblks <<
+                                            ") in region for work stealing");
+
+        // Each deque is a range of block numbers with the begin in the
+        // low half and the end in the high half, so both ends can be
+        // updated with one compare-and-swap.
+        int nthr = max(omp_get_max_threads(), 1);
+        unique_ptr<atomic<uint64_t>[]> deques(new atomic<uint64_t>[nthr]);
+        for (int n = 0; n < nthr; n++) {
+            uint64_t b = uint64_t(nblks * n / nthr);
+            uint64_t e = uint64_t(nblks * (n + 1) / nthr);
+            deques[n] = b | (e << 32);
+        }
+        auto take = [&](int n, bool from_end) -> idx_t {
+            auto& dq = deques[n];
+            uint64_t cur = dq.load();
+            while (true) {
+                uint64_t b = cur & 0xffffffff;
+                uint64_t e = cur >> 32;
+                if (b >= e)
+                    return -1;
+                uint64_t next = from_end ? (b | ((e - 1) << 32)) : ((b + 1) | (e << 32));
+                if (dq.compare_exchange_weak(cur, next))
+                    return idx_t(from_end ? e - 1 : b);
+            }
+        };
+
+#pragma omp parallel num_threads(nthr) proc_bind(spread)
+        {
+            int me = omp_get_thread_num();
+            idx_t ndone = 0, nstolen = 0;
+            while (true) {
+
+                // Next block from my deque or any other.
+                idx_t bn = take(me, false);
+                for (int k = 1; bn < 0 && k < nthr; k++) {
+                    bn = take((me + k) % nthr, true);
+                    if (bn >= 0)
+                        nstolen++;
+                }
+                if (bn < 0)
+                    break;
+                calc_block(bp, blocks[bn]);
+                ndone++;
+            }
+#pragma omp atomic
+            blocks_done += ndone;
+#pragma omp atomic
+            blocks_stolen += nstolen;
+        }
+    }
+
+    // The region threads are split into one team per NUMA sub-domain in
+    // order of thread number. Each block belongs to the sub-domain that
+    // contains its start in the first domain dim. The threads of a team
+    // are bound to the CPUs of its node, if known, and take its blocks
+    // dynamically; then they help the other teams in turn. Data in
+    // neighboring sub-domains is read directly from shared memory, so no
+    // halos are copied between them.
+    void StencilContext::calc_region_numa(BundlePackPtr& bp,
+                                          const ScanIndices& region_idxs) {
+        vector<ScanIndices> blocks;
+        find_region_blocks(region_idxs, blocks);
+        idx_t nblks = blocks.size();
+        if (nblks <= 0)
+            return;
+
+        // Blocks in each part.
+        int nparts = _numa_part_begins.size();
+        auto& dname = _dims->_domain_dims.getDimName(0);
+        int xp = _dims->_stencil_dims.lookup_posn(dname);
+        vector<vector<idx_t>> part_blocks(nparts);
+        for (idx_t bn = 0; bn < nblks; bn++) {
+            auto it = upper_bound(_numa_part_begins.begin(), _numa_part_begins.end(),
+                                  blocks[bn].start[xp]);
+            int p = max(int(it - _numa_part_begins.begin()) - 1, 0);
+            part_blocks[p].push_back(bn);
+        }
+        unique_ptr<atomic<idx_t>[]> next(new atomic<idx_t>[nparts]);
+        for (int p = 0; p < nparts; p++)
+            next[p] = 0;
+
+        int nthr = max(omp_get_max_threads(), 1);
+#pragma omp parallel num_threads(nthr) proc_bind(spread)
+        {
+            int me = omp_get_thread_num();
+            int mp = me * nparts / nthr;
+            int team_first = CEIL_DIV(mp * nthr, nparts);
+            auto& cpus = _numa_part_cpus[mp];
+            if (cpus.size())
+                CpuTopology::bind_thread(cpus[(me - team_first) % cpus.size()]);
+
+            for (int k = 0; k < nparts; k++) {
+                int p = (mp + k) % nparts;
+                auto& pb = part_blocks[p];
+                while (true) {
+                    idx_t i = next[p]++;
+                    if (i >= idx_t(pb.size()))
+                        break;
+                    calc_block(bp, blocks[pb[i]]);
+                }
+            }
+        }
+    }
+
+    void StencilContext::bind_region_threads() {
+        auto& cpus = _opts->_cpus;
+        int ncpus = int(cpus.size());
+        if (!ncpus)
+            return;
+        int nthr = max(omp_get_max_threads(), 1);
+#pragma omp parallel num_threads(nthr)
+        {
+            int me = omp_get_thread_num();
+            if (me > 0) {
+                int b = ncpus * me / nthr;
+                int e = max(ncpus * (me + 1) / nthr, b + 1);
+                CpuTopology::bind_thread(vector<int>(cpus.begin() + b,
+                                                     cpus.begin() + min(e, ncpus)));
+            }
+        }
+    }
+
+    // Each thread evaluates a contiguous range of the blocks in scan order
+    // and hands the next one to its helper before evaluating the current
+    // one, so the helper loads the next block's data into the L2 cache
+    // shared by the hyperthreads of the core.
+    void StencilContext::calc_region_prefetching(BundlePackPtr& bp,
+                                                 const ScanIndices& region_idxs) {
+        vector<ScanIndices> blocks;
+        find_region_blocks(region_idxs, blocks);
+        idx_t nblks = blocks.size();
+        if (nblks <= 0)
+            return;
+        int nthr = max(omp_get_max_threads(), 1);
+        if (int(_prefetch_helpers.size()) != nthr)
+            start_prefetch_helpers(nthr);
+        auto& areas = _prefetch_areas.at(bp.get());
+
+#pragma omp parallel num_threads(nthr) proc_bind(spread)
+        {
+            int me = omp_get_thread_num();
+            auto& ph = *_prefetch_helpers[me];
+            int cpu = sched_getcpu();
+            idx_t b = nblks * me / nthr;
+            idx_t e = nblks * (me + 1) / nthr;
+            for (idx_t bn = b; bn < e; bn++) {
+                if (bn + 1 < e) {
+                    auto& nb = blocks[bn + 1];
+                    {
+                        lock_guard<mutex> lk(ph.lock);
+                        ph.areas = &areas;
+                        ph.begin = nb.start;
+                        ph.end = nb.stop;
+                        ph.cpu = cpu;
+                        ph.ready = true;
+                    }
+                    ph.cv.notify_one();
+                }
+                calc_block(bp, blocks[bn]);
+            }
+        }
+    }
+
+    // Calculate results within a block in this solution and then in each
+    // solution in its batch while the read-only grids are still in cache.
+    void StencilContext::calc_block(BundlePackPtr& sel_bp,
+                                    const ScanIndices& region_idxs) {
+        calc_block_one(sel_bp, region_idxs);
+        for (auto& bc : _batch) {
+            auto bbp = get_batch_pack(*bc, sel_bp);
+            bc->calc_block_one(bbp, region_idxs);
+        }
+    }
+
+    // Calculate results within a block. This function calls
+    // 'calc_block' for each bundle in the specified pack.
+    // Typically called by a top-level OMP thread from calc_region().
+    // When doing temporal tiling in blocks, the block is evaluated
+    // over each step and pack, shifting it left by the WF angles after
+    // each pack just as the region is shifted in calc_region().
+    void StencilContext::calc_block_one(BundlePackPtr& sel_bp,
+                                        const ScanIndices& region_idxs) {
+
+        int nsdims = _dims->_stencil_dims.size();
+        auto& step_dim = _dims->_step_dim;
+        auto step_posn = Indices::step_posn;
+        TRACE_MSG("calc_block: " << name << ": " <<
+                  region_idxs.start.makeValStr(nsdims) <<
+                  " ... (end before) " << region_idxs.stop.makeValStr(nsdims));
+        TRACE_EVENT("compute", "block");
+
+        // Init block begin & end from region start & stop indices.
+        ScanIndices block_idxs(*_dims, true, 0);
+        block_idxs.initFromOuter(region_idxs);
+
+        // Steps within a block are based on sub-block sizes.
+        block_idxs.step = _opts->_sub_block_sizes;
+
+        // Groups in block loops are based on sub-block-group sizes.
+        block_idxs.group_size = _opts->_sub_block_group_sizes;
+
+        // No temporal tiling in blocks: loop through bundles in this pack.
+        if (_opts->_block_sizes[step_dim] <= 1) {
+            auto* bp = sel_bp.get();
+            assert(bp);
+            for (auto* sb : *bp)
+                sb->calc_block(block_idxs);
+            return;
+        }
+
+        // Make a copy of the original index span because
+        // we will be shifting it for temporal wavefronts.
+        Indices start(block_idxs.begin);
+        Indices stop(block_idxs.end);
+
+        // Region boundaries for trimming.
+        Indices rstart(_block_wf.start);
+        Indices rstop(_block_wf.stop);
+        idx_t shift_num = _block_wf.shift_num;
+
+        // Step loop within the block.
+        idx_t start_t = region_idxs.start[step_posn];
+        idx_t stop_t = region_idxs.stop[step_posn];
+        idx_t step_t = (start_t < stop_t) ? 1 : -1;
+        for (idx_t t = start_t; t != stop_t; t += step_t) {
+            block_idxs.begin[step_posn] = block_idxs.start[step_posn] = t;
+            block_idxs.end[step_posn] = block_idxs.stop[step_posn] = t + step_t;
+
+            // Stencil bundle packs to evaluate at this time step.
+            for (auto& bp : stPacks) {
+
+                // Not selected bundle pack?
+                if (sel_bp && sel_bp != bp)
+                    continue;
+
+                // Trim the shifted block to the region at this shift.
+                ScanIndices ridxs(block_idxs);
+                bool ok = trim_region(bp, rstart, rstop, shift_num, ridxs);
+                for (int i = 0; ok && i < nsdims; i++) {
+                    if (i == step_posn) continue;
+                    block_idxs.begin[i] = max(start[i], ridxs.begin[i]);
+                    block_idxs.end[i] = min(stop[i], ridxs.end[i]);
+                    if (block_idxs.end[i] <= block_idxs.begin[i])
+                        ok = false;
+                }
+                TRACE_MSG("calc_block: pack '" << bp->get_name() << "' in step " << t <<
+                          (ok ? "" : " (nothing to do)") << ": " <<
+                          block_idxs.begin.makeValStr(nsdims) <<
+                          " ... (end before) " << block_idxs.end.makeValStr(nsdims));
+
+                // Loop through bundles in this pack.
+                if (ok) {
+                    for (auto* sb : *bp)
+                        sb->calc_block(block_idxs);
+                }
+
+                // Shift block and region boundaries.
+                for (int i = 0, j = 0; i < nsdims; i++) {
+                    if (i == step_posn) continue;
+                    auto angle = wf_angles[j];
+                    start[i] -= angle;
+                    stop[i] -= angle;
+                    rstart[i] -= angle;
+                    rstop[i] -= angle;
+                    j++;
+                }
+                shift_num++;
+            } // packs.
+        } // steps.
+    }
+
+    // Name of an auto-tuner level for messages.
+    const char* StencilContext::AT::level_name(int lvl) {
+        switch (lvl) {
+        case at_region: return "region-size";
+        case at_block: return "block-size";
+        case at_block_threads: return "block-threads";
+        case at_sub_block: return "sub-block-size";
+        case at_prefetch: return "prefetch-distance";
+        case at_loop_order: return "loop-order";
+        default: return "unknown";
+        }
+    }
+
+    // Whether a level should be searched.
+    bool StencilContext::AT::is_level_enabled(int lvl) const {
+        auto _opts = _context->_opts;
+        int nt = _opts->max_threads / _opts->thread_divisor;
+        switch (lvl) {
+
+            // Regions only matter with temporal wave-front tiling.
+        case at_region:
+            return _opts->is_time_tiling();
+
+        case at_block:
+            return true;
+
+            // Block threads are ignored with temporal tiling in blocks.
+        case at_block_threads:
+            return nt > 1 && !_opts->is_block_time_tiling();
+
+        case at_sub_block:
+            return true;
+
+            // Prefetch code may be compiled out.
+        case at_prefetch:
+#ifdef NO_PREFETCH
+            return false;
+#else
+            return true;
 #endif
 
-        // Null stream to throw away debug info.
-        yask_output_factory yof;
-        nullop = yof.new_null_output();
+            // Loop orders are searched if there is more than one.
+        case at_loop_order:
+            return get_num_loop_orders(_context->_dims->_domain_dims.getNumDims()) > 1;
+        }
+        return false;
+    }
 
-        // Apply the best known settings from existing data, if any.
+    // Get the sizes searched at the current level.
+    IdxTuple StencilContext::AT::get_level_sizes() const {
         auto _opts = _context->_opts;
-        if (best_rate > 0.) {
-            _opts->_block_sizes = best_block;
-            apply();
-            os << "auto-tuner: applying block-size "  <<
-                best_block.makeDimValStr(" * ") << endl;
+        switch (level) {
+        case at_region:
+            return _opts->_region_sizes;
+        case at_block_threads: {
+            IdxTuple bt;
+            bt.addDimBack("block_threads", _opts->num_block_threads);
+            return bt;
+        }
+        case at_sub_block:
+            return _opts->_sub_block_sizes;
+        case at_prefetch: {
+            IdxTuple pfd;
+            pfd.addDimBack("pfd_l1", _opts->_prefetch_L1_dist);
+            pfd.addDimBack("pfd_l2", _opts->_prefetch_L2_dist);
+            return pfd;
+        }
+        case at_loop_order: {
+            IdxTuple lo;
+            lo.addDimBack("region_loops", _opts->region_loop_order);
+            lo.addDimBack("block_loops", _opts->block_loop_order);
+            lo.addDimBack("sub_block_loops", _opts->sub_block_loop_order);
+            return lo;
+        }
+        default:
+            return _opts->_block_sizes;
         }
+    }
+
+    // Set the sizes searched at the current level.
+    void StencilContext::AT::set_level_sizes(const IdxTuple& sizes) {
+        auto _opts = _context->_opts;
+        switch (level) {
+        case at_region:
+            _opts->_region_sizes = sizes;
+            break;
+        case at_block_threads:
+            _opts->num_block_threads = int(sizes[0]);
+            break;
+        case at_sub_block:
+            _opts->_sub_block_sizes = sizes;
+            break;
+        case at_prefetch:
+            _opts->_prefetch_L1_dist = int(sizes["pfd_l1"]);
+            _opts->_prefetch_L2_dist = int(sizes["pfd_l2"]);
+            break;
+        case at_loop_order:
+            _opts->region_loop_order = int(sizes["region_loops"]);
+            _opts->block_loop_order = int(sizes["block_loops"]);
+            _opts->sub_block_loop_order = int(sizes["sub_block_loops"]);
+            break;
+        default:
+            _opts->_block_sizes = sizes;
+        }
+    }
+
+    // Get the min and max sizes and the multiple
+    // to round sizes to for the current level.
+    void StencilContext::AT::get_level_bounds(IdxTuple& mins, IdxTuple& maxes,
+                                              IdxTuple& mults) const {
+        auto _opts = _context->_opts;
+        auto _dims = _context->_dims;
+
+        if (level == at_block_threads) {
+            mins = get_level_sizes();
+            mins.setValsSame(1);
+            mults = mins;
+            maxes = mins;
+            maxes.setValsSame(max(1, _opts->max_threads / _opts->thread_divisor));
+            return;
+        }
+        if (level == at_prefetch) {
+            mins = get_level_sizes();
+            mins.setValsSame(0);
+            mults = mins;
+            mults.setValsSame(1);
+            maxes = mins;
+            maxes.setValsSame(max_pfd);
+            return;
+        }
+        if (level == at_loop_order) {
+            int nddims = _dims->_domain_dims.getNumDims();
+            mins = get_level_sizes();
+            mins.setValsSame(0);
+            mults = mins;
+            mults.setValsSame(1);
+            maxes = mins;
+
+            // Loops replaced by a space-filling curve are not searched.
+            if (_opts->block_order == "loops")
+                maxes["region_loops"] = get_num_loop_orders(nddims) - 1;
+            if (_opts->sub_block_order == "loops")
+                maxes["block_loops"] = get_num_loop_orders(nddims) - 1;
+            maxes["sub_block_loops"] = get_num_loop_orders(nddims - 1) - 1;
+            return;
+        }
+
+        // Spatial sizes: limited below by clusters and
+        // above by the size of the enclosing tile.
+        mins = _dims->_cluster_pts;
+        mults = _dims->_cluster_pts;
+        switch (level) {
+        case at_region:
+            maxes = _opts->_rank_sizes;
+
+            // Each region must hold at least one block.
+            for (auto dim : mins.getDims()) {
+                auto& dname = dim.getName();
+                mins[dname] = max(mins[dname], _opts->_block_sizes[dname]);
+            }
+            break;
+        case at_sub_block:
+            maxes = _opts->_block_sizes;
+            break;
+        default:
+            maxes = _opts->_region_sizes;
+        }
+
+        // Ranks may differ in size, so use the bounds that fit all of them.
+        min_over_ranks(mins);
+        min_over_ranks(maxes);
+    }
+
+    // Combine tuning values over all ranks.
+    unique_lock<mutex> StencilContext::AT::lock_mpi() const {
+#ifdef USE_MPI
+        if (_context->_num_progress_threads)
+            return unique_lock<mutex>(_context->_mpi_lock);
+#endif
+        return unique_lock<mutex>();
+    }
+    double StencilContext::AT::max_over_ranks(double val) const {
+        double res = val;
+#ifdef USE_MPI
+        auto _env = _context->_env;
+        auto lk = lock_mpi();
+        if (_env->num_ranks > 1)
+            MPI_Allreduce(&val, &res, 1, MPI_DOUBLE, MPI_MAX, _env->comm);
+#endif
+        return res;
+    }
+    double StencilContext::AT::sum_over_ranks(double val) const {
+        double res = val;
+#ifdef USE_MPI
+        auto _env = _context->_env;
+        auto lk = lock_mpi();
+        if (_env->num_ranks > 1)
+            MPI_Allreduce(&val, &res, 1, MPI_DOUBLE, MPI_SUM, _env->comm);
+#endif
+        return res;
+    }
+    void StencilContext::AT::min_over_ranks(IdxTuple& vals) const {
+#ifdef USE_MPI
+        auto _env = _context->_env;
+        int n = vals.getNumDims();
+        if (_env->num_ranks > 1 && n > 0) {
+            vector<idx_t> my_vals(n), min_vals(n);
+            for (int i = 0; i < n; i++)
+                my_vals[i] = vals.getVal(i);
+            auto lk = lock_mpi();
+            MPI_Allreduce(my_vals.data(), min_vals.data(), n, MPI_INTEGER8,
+                          MPI_MIN, _env->comm);
+            vals.setVals(min_vals);
+        }
+#endif
+    }
+
+    // Start searching the current level from the current settings.
+    void StencilContext::AT::start_level() {
+        ostream& os = _context->get_ostr();
+        auto _opts = _context->_opts;
 
-        // Reset all vars.
         results.clear();
         n2big = n2small = 0;
-        best_block = _opts->_block_sizes;
-        best_rate = 0.;
-        center_block = best_block;
+        best_score = 0.;
         radius = max_radius;
-        done = mark_done;
+        if (pruned_radius > 0 && (level == at_block || level == at_sub_block))
+            radius = pruned_radius;
         neigh_idx = 0;
         better_neigh_found = false;
-        ctime = 0.;
-        csteps = 0;
-        in_warmup = true;
 
         // Set min blocks to number of region threads.
         min_blks = _context->set_region_threads();
 
-        // Adjust starting block if needed.
-        for (auto dim : center_block.getDims()) {
+        // Neighborhood: 3 points in each searched dim.
+        if (level == at_block_threads || level == at_prefetch || level == at_loop_order)
+            neigh_sizes = get_level_sizes();
+        else
+            neigh_sizes = _context->_dims->_domain_dims;
+        neigh_sizes.setValsSame(3);
+        neigh_size = neigh_sizes.product();
+
+        // Adjust starting sizes if needed.
+        IdxTuple mins, maxes, mults;
+        get_level_bounds(mins, maxes, mults);
+        center_sizes = get_level_sizes();
+        for (auto dim : neigh_sizes.getDims()) {
             auto& dname = dim.getName();
-            auto& dval = dim.getVal();
-
-            auto dmax = max(idx_t(1), _opts->_region_sizes[dname] / 2);
-            if (dval > dmax || dval < 1)
-                center_block[dname] = dmax;
+            auto dval = center_sizes[dname];
+            auto dmax = maxes[dname];
+
+            // Start blocks at half the region so there is
+            // more than one to run in parallel.
+            if (level == at_block)
+                dmax = max(idx_t(1), dmax / 2);
+            if (level == at_prefetch || level == at_loop_order)
+                center_sizes[dname] = min(max(dval, idx_t(0)), dmax);
+            else if (dval > dmax || dval < 1)
+                center_sizes[dname] = dmax;
         }
+        min_over_ranks(center_sizes);
+        best_sizes = center_sizes;
+
         if (!done) {
-            os << "auto-tuner: starting block-size: "  <<
-                center_block.makeDimValStr(" * ") << endl;
+            os << "auto-tuner: starting " << level_name(level) << ": " <<
+                center_sizes.makeDimValStr(" * ") << endl;
             os << "auto-tuner: starting search radius: " << radius << endl;
         }
+    }
+
+    // Reset the auto-tuner.
+    void StencilContext::AT::clear(bool mark_done, bool verbose) {
+
+        // Output.
+        ostream& os = _context->get_ostr();
+#ifdef TRACE
+        this->verbose = true;
+#else
+        this->verbose = verbose;
+#endif
+
+        // Null stream to throw away debug info.
+        yask_output_factory yof;
+        nullop = yof.new_null_output();
+
+        // Objective.
+        auto& obj = _context->_opts->tune_objective;
+        if (obj != "rate" && obj != "energy" && obj != "edp")
+            THROW_YASK_EXCEPTION("Error: tune-objective '" + obj +
+                                 "' is not one of 'rate', 'energy', or 'edp'");
+        double joules;
+        use_energy = obj != "rate" && EnergyMeter::read(joules);
+        use_energy = -max_over_ranks(use_energy ? -1. : 0.) > 0.; // only if on all ranks.
+        if (obj != "rate" && !use_energy && !energy_warned) {
+            os << "auto-tuner: energy cannot be measured; tuning for rate instead" << endl;
+            energy_warned = true;
+        }
+
+        // Apply the best known settings from existing data, if any.
+        if (best_score > 0.) {
+            set_level_sizes(best_sizes);
+            apply();
+            os << "auto-tuner: applying " << level_name(level) << " "  <<
+                best_sizes.makeDimValStr(" * ") << endl;
+        }
+
+        // Reset all vars.
+        done = mark_done;
+        ctime = 0.;
+        cjoules = 0.;
+        csteps = 0;
+        in_warmup = true;
+
+        // Start at first enabled level.
+        level = at_block;
+        for (int lvl = 0; lvl < at_nlevels; lvl++) {
+            if (is_level_enabled(lvl)) {
+                level = lvl;
+                break;
+            }
+        }
+        start_level();
     } // clear.
 
     // Evaluate the previous run and take next auto-tuner step.
-    void StencilContext::AT::eval(idx_t steps, double etime) {
+    void StencilContext::AT::eval(idx_t steps, double etime, double joules) {
         ostream& os = _context->get_ostr();
+        TRACE_EVENT("auto-tuner", "eval");
 
         // Leave if done.
         if (done)
@@ -743,12 +2214,25 @@ namespace yask {
 
         // Handy ptrs.
         auto _opts = _context->_opts;
-        auto _mpiInfo = _context->_mpiInfo;
-        auto _dims = _context->_dims;
+
+        // Overall time is set by the slowest rank. Every rank on a node
+        // measures the whole node, so each counts its share of the energy.
+        etime = max_over_ranks(etime);
+        if (use_energy) {
+            int nnode = 1;
+#ifdef USE_MPI
+            {
+                auto lk = lock_mpi();
+                MPI_Comm_size(_context->_env->shm_comm, &nnode);
+            }
+#endif
+            joules = sum_over_ranks(joules / nnode);
+        }
 
         // Cumulative stats.
         csteps += steps;
         ctime += etime;
+        cjoules += joules;
 
         // Still in warmup?
         if (in_warmup) {
@@ -764,62 +2248,79 @@ namespace yask {
             // Measure this step only.
             csteps = steps;
             ctime = etime;
+            cjoules = joules;
         }
 
         // Need more steps to get a good measurement?
-        if (ctime < min_secs && csteps < min_steps)
+        // Energy counters are updated only every few msecs,
+        // so always wait for 'min_secs' when they are used.
+        if (ctime < min_secs && (csteps < min_steps || use_energy))
             return;
 
         // Calc perf and reset vars for next time.
+        // The score is higher for better settings.
+        auto cur_sizes = get_level_sizes();
         double rate = double(csteps) / ctime;
-        os << "auto-tuner: " << csteps << " steps(s) at " << rate <<
-            " steps/sec with block-size " <<
-            _opts->_block_sizes.makeDimValStr(" * ") << endl;
+        double score = rate;
+        os << "auto-tuner: " << csteps << " steps(s) at " << rate << " steps/sec";
+        if (use_energy && cjoules > 0.) {
+            double eff = double(csteps) / cjoules;
+            os << " and " << eff << " steps/J";
+            score = (_opts->tune_objective == "energy") ? eff : eff * rate;
+        }
+        os << " with " << level_name(level) << " " <<
+            cur_sizes.makeDimValStr(" * ") << endl;
         csteps = 0;
         ctime = 0.;
+        cjoules = 0.;
 
         // Save result.
-        results[_opts->_block_sizes] = rate;
-        bool is_better = rate > best_rate;
+        results[cur_sizes] = score;
+        bool is_better = score > best_score;
         if (is_better) {
-            best_block = _opts->_block_sizes;
-            best_rate = rate;
+            best_sizes = cur_sizes;
+            best_score = score;
             better_neigh_found = true;
         }
 
+        // Bounds of the search at this level.
+        IdxTuple mins, maxes, mults;
+        get_level_bounds(mins, maxes, mults);
+
         // At this point, we have gathered perf info on the current settings.
         // Now, we need to determine next unevaluated point in search space.
         while (true) {
 
             // Gradient-descent(GD) search:
-            // Use the neighborhood info from MPI to track neighbors.
-            // TODO: move to a more general place.
             // Valid neighbor index?
-            if (neigh_idx < _mpiInfo->neighborhood_size) {
+            if (neigh_idx < neigh_size) {
 
                 // Convert index to offsets in each dim.
-                auto ofs = _mpiInfo->neighborhood_sizes.unlayout(neigh_idx);
+                auto ofs = neigh_sizes.unlayout(neigh_idx);
 
                 // Next neighbor of center point.
                 neigh_idx++;
 
-                // Determine new block size.
-                IdxTuple bsize(center_block);
+                // Determine new size.
+                IdxTuple bsize(center_sizes);
                 bool ok = true;
                 for (auto odim : ofs.getDims()) {
-                    auto& dname = odim.getName(); // a domain-dim name.
+                    auto& dname = odim.getName(); // a searched-dim name.
                     auto& dofs = odim.getVal(); // always [0..2].
 
                     // Min and max sizes of this dim.
-                    auto dmin = _dims->_cluster_pts[dname];
-                    auto dmax = _opts->_region_sizes[dname];
+                    auto dmin = mins[dname];
+                    auto dmax = maxes[dname];
+                    auto dmult = mults[dname];
 
                     // Determine distance of GD neighbors.
-                    auto step = dmin; // step by cluster size.
-                    step = max(step, min_step);
+                    auto step = dmult; // step by cluster size.
+                    if (level != at_block_threads && level != at_prefetch &&
+                        level != at_loop_order)
+                        step = max(step, min_step);
                     step *= radius;
 
-                    auto sz = center_block[dname];
+                    auto sz = center_sizes[dname];
                     switch (dofs) {
                     case 0:
                         sz -= step;
@@ -842,27 +2343,31 @@ namespace yask {
 
                     // Adjustments.
                     sz = min(sz, dmax);
-                    sz = ROUND_UP(sz, dmin);
+                    sz = ROUND_UP(sz, dmult);
 
                     // Save.
                     bsize[dname] = sz;
 
-                } // domain dims.
-                TRACE_MSG2("auto-tuner: checking block-size "  <<
+                } // searched dims.
+                TRACE_MSG2("auto-tuner: checking " << level_name(level) << " " <<
                           bsize.makeDimValStr(" * "));
 
-                // Too small?
-                if (ok && bsize.product() < min_pts) {
-                    n2small++;
-                    ok = false;
-                }
+                // Block-size limits.
+                if (ok && level == at_block) {
 
-                // Too few?
-                else if (ok) {
-                    idx_t nblks = _opts->_region_sizes.product() / bsize.product();
-                    if (nblks < min_blks) {
+                    // Too small?
+                    if (bsize.product() < min_pts) {
+                        n2small++;
                         ok = false;
-                        n2big++;
+                    }
+
+                    // Too few?
+                    else {
+                        idx_t nblks = maxes.product() / bsize.product();
+                        if (nblks < min_blks) {
+                            ok = false;
+                            n2big++;
+                        }
                     }
                 }
 
@@ -870,8 +2375,8 @@ namespace yask {
                 if (ok && !results.count(bsize)) {
 
                     // Run next step with this size.
-                    _opts->_block_sizes = bsize;
-                    break;      // out of block-search loop.
+                    set_level_sizes(bsize);
+                    break;      // out of search loop.
                 }
 
             } // valid neighbor index.
@@ -882,8 +2387,8 @@ namespace yask {
                 // Should GD continue?
                 bool stop_gd = !better_neigh_found;
 
-                // Make new center at best block so far.
-                center_block = best_block;
+                // Make new center at best size so far.
+                center_sizes = best_sizes;
 
                 // Reset search vars.
                 neigh_idx = 0;
@@ -896,27 +2401,49 @@ namespace yask {
                     // Move to next radius.
                     radius /= 2;
 
-                    // Done?
+                    // Done with this level?
                     if (radius < 1) {
 
-                        // Reset AT and disable.
-                        clear(true);
-                        os << "auto-tuner: done" << endl;
+                        // Find next enabled level.
+                        int next = level + 1;
+                        while (next < at_nlevels && !is_level_enabled(next))
+                            next++;
+
+                        // Done with all levels?
+                        if (next >= at_nlevels) {
+
+                            // Reset AT and disable.
+                            clear(true);
+                            os << "auto-tuner: done" << endl;
+                            if (_opts->auto_tune_save_file.length())
+                                save(_opts->auto_tune_save_file);
+                            return;
+                        }
+
+                        // Apply best at this level and search the next one.
+                        set_level_sizes(best_sizes);
+                        apply();
+                        os << "auto-tuner: applying " << level_name(level) << " "  <<
+                            best_sizes.makeDimValStr(" * ") << endl;
+                        level = next;
+                        start_level();
+
+                        // Measure the starting point of the new level.
                         return;
                     }
                     os << "auto-tuner: new search radius: " << radius << endl;
                 }
                 else {
-                    TRACE_MSG2("auto-tuner: continuing search from block " <<
-                               center_block.makeDimValStr(" * "));
+                    TRACE_MSG2("auto-tuner: continuing search from " << level_name(level) << " " <<
+                               center_sizes.makeDimValStr(" * "));
                 }
             } // beyond next neighbor of center.
         } // search for new setting to try.
 
         // Fix settings for next step.
         apply();
-        TRACE_MSG2("auto-tuner: next block-size "  <<
-                  _opts->_block_sizes.makeDimValStr(" * "));
+        TRACE_MSG2("auto-tuner: next " << level_name(level) << " "  <<
+                   get_level_sizes().makeDimValStr(" * "));
     } // eval.
 
     // Apply auto-tuner settings.
@@ -926,34 +2453,183 @@ namespace yask {
 
         // Change block-related sizes to 0 so adjustSettings()
         // will set them to the default.
-        // TODO: tune sub-block sizes also.
-        _opts->_sub_block_sizes.setValsSame(0);
+        // Sub-block sizes are kept once they are being searched.
+        if (level < at_sub_block)
+            _opts->_sub_block_sizes.setValsSame(0);
         _opts->_sub_block_group_sizes.setValsSame(0);
         _opts->_block_group_sizes.setValsSame(0);
 
         // Make sure everything is resized based on block size.
         _opts->adjustSettings(nullop->get_ostream(), _env);
+        _context->_step_plan.valid = false;
 
         // Reallocate scratch data based on new block size.
         _context->allocScratchData(nullop->get_ostream());
     }
 
-    // Apply auto-tuning to some of the settings.
-    void StencilContext::run_auto_tuner_now(bool verbose) {
-        if (!rank_bb.bb_valid)
-            THROW_YASK_EXCEPTION("Error: tune_settings() called without calling prepare_solution() first");
-
-        ostream& os = get_ostr();
-        os << "Auto-tuning...\n" << flush;
-        YaskTimer at_timer;
-        at_timer.start();
+    // Get the tuned settings as command-line options.
+    // Only the settings changed by the auto-tuner are included.
+    string StencilContext::AT::get_settings_str() const {
+        auto _opts = _context->_opts;
+        ostringstream oss;
+        for (auto dim : _context->_dims->_domain_dims.getDims()) {
+            auto& dname = dim.getName();
+            oss << " -r" << dname << " " << _opts->_region_sizes[dname] <<
+                " -b" << dname << " " << _opts->_block_sizes[dname] <<
+                " -sb" << dname << " " << _opts->_sub_block_sizes[dname];
+        }
+        oss << " -block_threads " << _opts->num_block_threads <<
+            " -pfd_l1 " << _opts->_prefetch_L1_dist <<
+            " -pfd_l2 " << _opts->_prefetch_L2_dist <<
+            " -region_loop_order " << _opts->region_loop_order <<
+            " -block_loop_order " << _opts->block_loop_order <<
+            " -sub_block_loop_order " << _opts->sub_block_loop_order;
+        return oss.str();
+    }
 
-        // Temporarily disable halo exchange to tune intra-rank.
-        enable_halo_exchange = false;
+    // Write the tuned settings as command-line options to 'fname'.
+    // The file can be given to apply_command_line_options()
+    // or to the kernel executable to skip tuning in later runs.
+    void StencilContext::AT::save(const string& fname) const {
+        ostream& os = _context->get_ostr();
+        auto _opts = _context->_opts;
+        auto _env = _context->_env;
+        if (_env->my_rank != _opts->msg_rank)
+            return;
 
-        // Init tuner.
+        ofstream ofs(fname);
+        if (!ofs) {
+            os << "auto-tuner: unable to write settings to '" << fname << "'" << endl;
+            return;
+        }
+        ofs << get_settings_str() << endl;
+        os << "auto-tuner: settings written to '" << fname << "'" << endl;
+    }
+
+    // Get the key for this configuration in a tuning database.
+    // Settings that affect the best tuning but are not changed
+    // by the auto-tuner are included. Only values that are the same
+    // on all ranks are used, so every rank gets the same key.
+    string StencilContext::AT::get_db_key() const {
+        auto _opts = _context->_opts;
+        auto _dims = _context->_dims;
+        auto& step_dim = _dims->_step_dim;
+        IdxTuple gsizes(_dims->_domain_dims);
+        gsizes.setVals(_context->overall_domain_sizes, false);
+        IdxTuple nranks(_dims->_domain_dims);
+        nranks.setVals(_opts->_num_ranks, false);
+        int nt = max(1, _opts->max_threads / _opts->thread_divisor);
+
+        ostringstream oss;
+        oss << "stencil=" << _context->get_name() <<
+            " arch=" << YK_ARCH <<
+            " real_bytes=" << REAL_BYTES <<
+            " fold=" << _dims->_fold_pts.makeDimValStr(",") <<
+            " cluster=" << _dims->_cluster_pts.makeDimValStr(",") <<
+            " threads=" << nt <<
+            " domain=" << gsizes.makeDimValStr(",") <<
+            " ranks=" << nranks.makeDimValStr(",") <<
+            " r" << step_dim << "=" << _opts->_region_sizes[step_dim] <<
+            " b" << step_dim << "=" << _opts->_block_sizes[step_dim];
+        return oss.str();
+    }
+
+    // Look up the current configuration in the tuning database
+    // 'fname' and apply its settings if found.
+    // Each line of the file is a key, a tab, and the settings.
+    // Return whether the settings were found.
+    bool StencilContext::AT::load_db(const string& fname) {
+        ostream& os = _context->get_ostr();
+        auto _opts = _context->_opts;
+        auto _env = _context->_env;
+
+        ifstream ifs(fname);
+        string key = get_db_key();
+        string line, settings;
+        bool found = false;
+        while (ifs && getline(ifs, line)) {
+            auto tab = line.find('\t');
+            if (tab != string::npos && line.substr(0, tab) == key) {
+                settings = line.substr(tab + 1);
+                found = true; // keep looking; last entry wins.
+            }
+        }
+
+        // Use the settings only if every rank has them, so that all
+        // ranks either search or not.
+        if (max_over_ranks(found ? 0. : 1.) > 0.)
+            return false;
+
+        // Apply the settings and resize everything based on them.
+        auto rem = _context->apply_command_line_options(settings);
+        if (rem.length())
+            os << "auto-tuner: ignoring unknown settings '" << rem <<
+                "' in '" << fname << "'" << endl;
+        _opts->adjustSettings(nullop->get_ostream(), _env);
+        _context->allocScratchData(nullop->get_ostream());
+        os << "auto-tuner: applying settings from '" << fname << "':" <<
+            settings << endl;
+        return true;
+    }
+
+    // Add or replace the entry for the current configuration in
+    // the tuning database 'fname'.
+    void StencilContext::AT::save_db(const string& fname) const {
+        ostream& os = _context->get_ostr();
+        auto _opts = _context->_opts;
+        auto _env = _context->_env;
+        if (_env->my_rank != _opts->msg_rank)
+            return;
+
+        // Read existing entries, dropping any with this key.
+        string key = get_db_key();
+        vector<string> lines;
+        {
+            ifstream ifs(fname);
+            string line;
+            while (getline(ifs, line)) {
+                auto tab = line.find('\t');
+                if (tab == string::npos || line.substr(0, tab) != key)
+                    lines.push_back(line);
+            }
+        }
+        lines.push_back(key + "\t" + get_settings_str());
+
+        ofstream ofs(fname);
+        if (!ofs) {
+            os << "auto-tuner: unable to write tuning database '" << fname << "'" << endl;
+            return;
+        }
+        for (auto& line : lines)
+            ofs << line << endl;
+        os << "auto-tuner: settings saved in tuning database '" << fname << "'" << endl;
+    }
+
+    // Apply auto-tuning to some of the settings.
+    void StencilContext::run_auto_tuner_now(bool verbose) {
+        if (!rank_bb.bb_valid)
+            THROW_YASK_EXCEPTION("Error: tune_settings() called without calling prepare_solution() first");
+
+        ostream& os = get_ostr();
+        os << "Auto-tuning...\n" << flush;
+        TRACE_EVENT("auto-tuner", "tune");
+        YaskTimer at_timer;
+        at_timer.start();
+
+        // Temporarily disable halo exchange to tune intra-rank.
+        enable_halo_exchange = false;
+
+        // Init tuner.
         _at.clear(false, verbose);
 
+        // Use known settings from the tuning database if available.
+        bool done = false;
+        auto& db = _opts->auto_tune_db_file;
+        if (db.length() && _at.load_db(db)) {
+            _at.clear(true, verbose);
+            done = true;
+        }
+
         // Reset stats.
         clear_timers();
 
@@ -964,7 +2640,7 @@ namespace yask {
         idx_t step_t = min(region_steps, _at.max_step_t);
 
         // Run time-steps until AT converges.
-        bool done = false;
+        bool searched = !done;
         for (idx_t t = 0; !done; t += step_t) {
 
             // Run step_t time-step(s).
@@ -974,6 +2650,10 @@ namespace yask {
             done = _at.is_done();
         }
 
+        // Remember the new settings.
+        if (searched && db.length())
+            _at.save_db(db);
+
         // Wait for all ranks to finish.
         _env->global_barrier();
 
@@ -984,8 +2664,15 @@ namespace yask {
         at_timer.stop();
         os << "Auto-tuner done after " << steps_done << " step(s) in " <<
             at_timer.get_elapsed_secs() << " secs.\n";
-        os << "best-block-size: " << _opts->_block_sizes.makeDimValStr(" * ") << endl << flush;
-        os << "best-sub-block-size: " << _opts->_sub_block_sizes.makeDimValStr(" * ") << endl << flush;
+        os << "best-region-size: " << _opts->_region_sizes.makeDimValStr(" * ") << endl;
+        os << "best-block-size: " << _opts->_block_sizes.makeDimValStr(" * ") << endl;
+        os << "best-sub-block-size: " << _opts->_sub_block_sizes.makeDimValStr(" * ") << endl;
+        os << "best-block-threads: " << _opts->num_block_threads << endl;
+        os << "best-prefetch-distances: L1 " << _opts->_prefetch_L1_dist <<
+            ", L2 " << _opts->_prefetch_L2_dist << endl;
+        os << "best-loop-orders: region " << get_loop_order_str(_opts->region_loop_order, false) <<
+            ", block " << get_loop_order_str(_opts->block_loop_order, false) <<
+            ", sub-block " << get_loop_order_str(_opts->sub_block_loop_order, true) << endl << flush;
 
         // Reset stats.
         clear_timers();
@@ -1075,6 +2762,95 @@ namespace yask {
         }
     }
 
+    // Reset elapsed times and HW counts to zero.
+    void StencilContext::clear_timers() {
+        run_time.clear();
+        mpi_time.clear();
+        wait_time.clear();
+        run_energy.clear();
+        halo_perf.clear();
+        for (auto* sg : stBundles)
+            sg->get_perf_counts().clear();
+        steps_done = 0;
+        step_times.clear();
+        blocks_done = blocks_stolen = 0;
+    }
+
+    // Get the dims of the generated loops in a given order.
+    string StencilContext::get_loop_order_str(int order, bool sub_block) const {
+        auto dnames = _dims->_domain_dims.getDimNames();
+
+        // The last dim is scanned by the inner loop in a sub-block.
+        if (sub_block && dnames.size())
+            dnames.pop_back();
+        return yask::get_loop_order_str(dnames, order);
+    }
+
+    // Predict throughput from a roofline model.
+    // Per point in each bundle, each non-scratch input grid is read from
+    // memory once, scaled up by the ratio of its block footprint
+    // including halos to the block size, and each output grid is written
+    // once, plus a read for ownership unless streaming stores are used.
+    // With temporal tiling, this traffic is shared by the tiled steps.
+    // The slowest rank determines the overall rate, so this must be
+    // called on all ranks.
+    void StencilContext::predict_roofline(ostream& os) {
+        roofline_pts_ps = 0.;
+        if (peak_bytes_ps <= 0. || peak_flops <= 0. || stBundles.size() == 0)
+            return;
+        auto& step_dim = _dims->_step_dim;
+        bool nt = use_nt_stores();
+
+        double rank_bytes_1t = 0.;
+        for (auto& sp : stPacks) {
+            for (auto* sg : *sp) {
+                double nreads = 0.;
+                for (auto gp : sg->inputGridPtrs) {
+                    if (gp->is_scratch())
+                        continue;
+                    double ratio = 1.;
+                    for (auto& dim : _dims->_domain_dims.getDims()) {
+                        auto& dname = dim.getName();
+                        if (gp->is_dim_used(dname)) {
+                            double bsize = max(_opts->_block_sizes[dname], idx_t(1));
+                            ratio *= (bsize + gp->get_left_halo_size(dname) +
+                                      gp->get_right_halo_size(dname)) / bsize;
+                        }
+                    }
+                    nreads += ratio;
+                }
+                double nwrites = 0.;
+                for (auto gp : sg->outputGridPtrs) {
+                    if (!gp->is_scratch())
+                        nwrites += nt ? 1. : 2.;
+                }
+                rank_bytes_1t += (nreads + nwrites) * REAL_BYTES *
+                    sg->getBB().bb_num_points;
+            }
+        }
+        double tsteps = max(max(_opts->_region_sizes[step_dim],
+                                _opts->_block_sizes[step_dim]), idx_t(1));
+        double mem_time = rank_bytes_1t / tsteps / peak_bytes_ps;
+        double fp_time = double(rank_numFpOps_1t) / peak_flops;
+        double rank_time = max(mem_time, fp_time);
+        double max_time = rank_time;
+#ifdef USE_MPI
+        MPI_Allreduce(&rank_time, &max_time, 1, MPI_DOUBLE, MPI_MAX, _env->comm);
+#endif
+        if (max_time > 0.)
+            roofline_pts_ps = double(tot_domain_1t) / max_time;
+
+        double pts = max(double(rank_domain_1t), 1.);
+        double bytes_pt = rank_bytes_1t / tsteps / pts;
+        os <<
+            "roofline-bytes-per-point:          " << makeNumStr(bytes_pt) << endl <<
+            "roofline-est-FP-ops-per-byte:      " <<
+            ((bytes_pt > 0.) ? double(rank_numFpOps_1t) / pts / bytes_pt : 0.) << endl <<
+            "roofline-bound:                    " <<
+            ((mem_time >= fp_time) ? "memory" : "compute") << endl <<
+            "roofline (num-points/sec):         " << makeNumStr(roofline_pts_ps) << endl;
+    }
+
     /// Get statistics associated with preceding calls to run_solution().
     yk_stats_ptr StencilContext::get_stats() {
         ostream& os = get_ostr();
@@ -1089,6 +2865,94 @@ namespace yask {
         }
         else
             domain_pts_ps = writes_ps = flops = 0.;
+
+        // Energy summed over nodes. Every rank on a node measures the
+        // whole node, so each counts its share.
+        bool energy_ok = false;
+        double joules = 0.;
+        if (_opts->measure_energy) {
+            double j;
+            energy_ok = EnergyMeter::read(j);
+            joules = run_energy.get_joules();
+#ifdef USE_MPI
+            int nnode = 1;
+            MPI_Comm_size(_env->shm_comm, &nnode);
+            double rank_joules = joules / nnode;
+            int rank_ok = energy_ok ? 1 : 0, all_ok = rank_ok;
+            MPI_Allreduce(&rank_joules, &joules, 1, MPI_DOUBLE, MPI_SUM, _env->comm);
+            MPI_Allreduce(&rank_ok, &all_ok, 1, MPI_INT, MPI_MIN, _env->comm);
+            energy_ok = all_ok != 0;
+#endif
+            if (!energy_ok)
+                joules = 0.;
+        }
+
+        // Distribution of step times on this rank.
+        vector<double> sorted_steps(step_times);
+        sort(sorted_steps.begin(), sorted_steps.end());
+        auto step_outliers = Stats::find_outliers(step_times);
+
+        // Times and throughput from all ranks.
+        vector<string> rm_names;
+        vector<vector<double>> rm_vals;
+        vector<int> slowest;
+        if (_opts->rank_stats) {
+            rm_names = { "compute-secs", "halo-exch-secs", "halo-wait-secs", "num-points-per-sec" };
+            vector<double> my_vals = { rtime - mtime, mtime, wait_time.get_elapsed_secs(),
+                                       (rtime > 0.) ? double(rank_domain_1t * steps_done) / rtime : 0. };
+            if (_opts->step_stats) {
+                rm_names.insert(rm_names.end(),
+                                { "step-secs-p50", "step-secs-p99", "num-step-outliers" });
+                my_vals.insert(my_vals.end(),
+                               { Stats::percentile(sorted_steps, 50.),
+                                 Stats::percentile(sorted_steps, 99.),
+                                 double(step_outliers.size()) });
+            }
+            const int nm = rm_names.size();
+            int nr = _env->num_ranks;
+            vector<double> all_vals(nm * nr);
+#ifdef USE_MPI
+            MPI_Allgather(my_vals.data(), nm, MPI_DOUBLE, all_vals.data(), nm, MPI_DOUBLE, _env->comm);
+#else
+            copy(my_vals.begin(), my_vals.end(), all_vals.begin());
+#endif
+            rm_vals.resize(nm);
+            for (int mi = 0; mi < nm; mi++)
+                for (int ri = 0; ri < nr; ri++)
+                    rm_vals[mi].push_back(all_vals[ri * nm + mi]);
+            for (int ri = 0; ri < nr; ri++)
+                slowest.push_back(ri);
+            stable_sort(slowest.begin(), slowest.end(), [&](int a, int b) {
+                    return rm_vals[0][a] > rm_vals[0][b];
+                });
+        }
+
+        // Sum HW counts for each pack, including its scratch bundles.
+        // A scratch bundle used by more than one pack is counted in each.
+        bool perf_ok = false;
+        if (_opts->perf_counters) {
+            PerfCounters::Vals vals;
+            perf_ok = PerfCounters::read(vals);
+        }
+        vector<pair<string, PerfCounters>> perf_secs;
+        if (perf_ok) {
+            for (auto& bp : stPacks) {
+                StencilBundleSet sgs;
+                for (auto* sb : *bp)
+                    for (auto* sg : sb->get_reqd_bundles())
+                        sgs.insert(sg);
+                PerfCounters pc;
+                for (auto* sg : sgs)
+                    pc.add(sg->get_perf_counts());
+                perf_secs.push_back({ bp->get_name(), pc });
+            }
+
+            // Halos are packed and unpacked by the OpenMP threads, but
+            // only the thread that starts and finishes each exchange is
+            // counted here, so this undercounts the packing.
+            perf_secs.push_back({ "halo-exchange (calling thread)", halo_perf });
+        }
+
         if (steps_done > 0) {
             os <<
                 "num-points-per-step:               " << makeNumStr(tot_domain_1t) << endl <<
@@ -1106,6 +2970,111 @@ namespace yask {
                 "throughput (num-writes/sec):       " << makeNumStr(writes_ps) << endl <<
                 "throughput (est-FLOPS):            " << makeNumStr(flops) << endl <<
                 "throughput (num-points/sec):       " << makeNumStr(domain_pts_ps) << endl;
+            if (blocks_done > 0)
+                os <<
+                    "blocks-stolen:                     " << makeNumStr(blocks_stolen) <<
+                    " of " << makeNumStr(blocks_done) << " (" <<
+                    (100. * blocks_stolen / blocks_done) << "%)" << endl;
+
+            // Step-time distribution, a text histogram, and outlier steps.
+            if (sorted_steps.size()) {
+                os <<
+                    "step-time-min (sec):               " << makeNumStr(sorted_steps.front()) << endl <<
+                    "step-time-p50 (sec):               " << makeNumStr(Stats::percentile(sorted_steps, 50.)) << endl <<
+                    "step-time-p90 (sec):               " << makeNumStr(Stats::percentile(sorted_steps, 90.)) << endl <<
+                    "step-time-p99 (sec):               " << makeNumStr(Stats::percentile(sorted_steps, 99.)) << endl <<
+                    "step-time-max (sec):               " << makeNumStr(sorted_steps.back()) << endl <<
+                    "num-step-outliers:                 " << step_outliers.size() << endl;
+                const int nbins = 10, maxbar = 40;
+                double lo = sorted_steps.front(), hi = sorted_steps.back();
+                double width = (hi - lo) / nbins;
+                if (width > 0.) {
+                    vector<idx_t> bins(nbins, 0);
+                    for (auto v : sorted_steps)
+                        bins[min(int((v - lo) / width), nbins - 1)]++;
+                    idx_t nmax = *max_element(bins.begin(), bins.end());
+                    os << "step-time histogram (sec):" << endl;
+                    for (int i = 0; i < nbins; i++)
+                        os << " " << makeNumStr(lo + i * width) << " - " <<
+                            makeNumStr(lo + (i + 1) * width) << ": " << bins[i] << " " <<
+                            string(CEIL_DIV(bins[i] * maxbar, nmax), '*') << endl;
+                }
+                if (step_outliers.size()) {
+                    os << "outlier steps (index, sec):";
+                    for (size_t i = 0; i < step_outliers.size() && i < 8; i++)
+                        os << " " << step_outliers[i] << " (" <<
+                            makeNumStr(step_times[step_outliers[i]]) << ")";
+                    if (step_outliers.size() > 8)
+                        os << " ...";
+                    os << endl;
+                }
+            }
+
+            // Imbalance among ranks.
+            if (rm_names.size()) {
+                os << "rank metrics over " << slowest.size() <<
+                    " rank(s) (min, mean, max, std-dev):" << endl;
+                for (size_t mi = 0; mi < rm_names.size(); mi++) {
+                    double vmin, vmean, vmax, vsdev;
+                    Stats::summarize(rm_vals[mi], vmin, vmean, vmax, vsdev);
+                    os << " " << rm_names[mi] << ": " << makeNumStr(vmin) << ", " <<
+                        makeNumStr(vmean) << ", " << makeNumStr(vmax) << ", " <<
+                        makeNumStr(vsdev) << endl;
+                }
+                os << " slowest rank(s) by compute-secs:";
+                for (size_t i = 0; i < slowest.size() && i < 4; i++)
+                    os << " " << slowest[i] << " (" << makeNumStr(rm_vals[0][slowest[i]]) << ")";
+                os << endl;
+            }
+
+            // Predicted vs achieved throughput.
+            if (_opts->roofline) {
+                predict_roofline(os);
+                if (roofline_pts_ps > 0.)
+                    os << "pct-of-roofline:                   " <<
+                        (100. * domain_pts_ps / roofline_pts_ps) << "%" << endl;
+            }
+
+            // HW counts and some derived metrics to help distinguish
+            // memory-bound packs from compute-bound ones.
+            if (perf_ok) {
+                os << "HW counts (sum over threads):" << endl;
+                for (auto& ps : perf_secs) {
+                    auto& pc = ps.second;
+                    os << " '" << ps.first << "':";
+                    for (int i = 0; i < PerfCounters::num_ctrs; i++)
+                        os << " " << PerfCounters::get_name(i) << "=" <<
+                            makeNumStr(pc.get(i));
+                    os << endl;
+                    double ncycles = pc.get(PerfCounters::cycles);
+                    double nrefs = pc.get(PerfCounters::cache_refs);
+                    double nmisses = pc.get(PerfCounters::cache_misses);
+                    if (ncycles > 0.) {
+                        os << "  IPC=" << (pc.get(PerfCounters::instrs) / ncycles) <<
+                            ", LLC-miss-bytes/cycle=" << (nmisses * CACHELINE_BYTES / ncycles);
+                        if (nrefs > 0.)
+                            os << ", LLC-miss-rate=" << (100. * nmisses / nrefs) << "%";
+                        os << endl;
+                    }
+                }
+            }
+            else if (_opts->perf_counters)
+                os << "HW counts: not available; check /proc/sys/kernel/perf_event_paranoid" << endl;
+
+            // Energy.
+            if (energy_ok) {
+                os <<
+                    "energy (J):                        " << makeNumStr(joules) <<
+                    " from " << EnergyMeter::get_source() << endl <<
+                    "energy-per-step (J):               " << makeNumStr(joules / steps_done) << endl;
+                if (rtime > 0.)
+                    os << "power (W):                         " << makeNumStr(joules / rtime) << endl;
+                if (joules > 0.)
+                    os << "efficiency (num-points/J):         " <<
+                        makeNumStr(double(tot_domain_1t) * steps_done / joules) << endl;
+            }
+            else if (_opts->measure_energy)
+                os << "energy: not available; check read access to /sys/class/powercap" << endl;
         }
 
         // Fill in return object.
@@ -1116,6 +3085,25 @@ namespace yask {
         p->nsteps = steps_done;
         p->run_time = rtime;
         p->mpi_time = mtime;
+        p->energy = joules;
+        p->nblocks = blocks_done;
+        p->nstolen = blocks_stolen;
+        p->rank_metric_names = rm_names;
+        for (size_t mi = 0; mi < rm_names.size(); mi++)
+            p->rank_metrics[rm_names[mi]] = rm_vals[mi];
+        p->slowest_ranks = slowest;
+        p->step_secs = step_times;
+        p->step_outliers = step_outliers;
+        if (perf_ok) {
+            for (int i = 0; i < PerfCounters::num_ctrs; i++)
+                p->perf_names.push_back(PerfCounters::get_name(i));
+            for (auto& ps : perf_secs) {
+                p->perf_sections.push_back(ps.first);
+                auto& counts = p->perf_counts[ps.first];
+                for (int i = 0; i < PerfCounters::num_ctrs; i++)
+                    counts.push_back(idx_t(ps.second.get(i)));
+            }
+        }
 
         // Clear counters.
         clear_timers();
@@ -1136,7 +3124,15 @@ namespace yask {
         idx_t errs = 0;
         for (size_t gi = 0; gi < gridPtrs.size(); gi++) {
             TRACE_MSG("Grid '" << ref.gridPtrs[gi]->get_name() << "'...");
-            errs += gridPtrs[gi]->compare(ref.gridPtrs[gi].get());
+
+            // Only the sampled blocks are valid in a sampled reference.
+            if (ref.val_bbs.size()) {
+                for (auto& bb : ref.val_bbs)
+                    errs += gridPtrs[gi]->compare(ref.gridPtrs[gi].get(), EPSILON, 20, cerr,
+                                                  &bb.bb_begin, &bb.bb_end);
+            }
+            else
+                errs += gridPtrs[gi]->compare(ref.gridPtrs[gi].get());
         }
 
         return errs;
@@ -1148,279 +3144,922 @@ namespace yask {
 #ifdef USE_MPI
         TRACE_MSG("exchange_halos_all()...");
 
-        // Find max steps stored over all grids.
-        auto& sd = _dims->_step_dim;
-        idx_t start = 0, stop = 1;
-        for (auto gp : gridPtrs) {
-            if (gp->is_dim_used(sd)) {
-                start = min(start, gp->_get_first_alloc_index(sd));
-                stop = max(stop, gp->_get_last_alloc_index(sd) + 1);
-            }
-        }
-
-        exchange_halos(nullptr, start, stop);
+        // Max steps stored over all grids is in the plan.
+        if (!_step_plan.valid)
+            make_step_plan();
+        exchange_halos(nullptr, _step_plan.halo_begin_t, _step_plan.halo_end_t);
 #endif
     }
 
     // Exchange halo data needed by bundle pack 'sel_bp' at the given time.
     // If sg==null, check all packs.
     // Data is needed for input grids that have not already been updated.
-    // [BIG] TODO: overlap halo exchange with computation.
     void StencilContext::exchange_halos(const BundlePackPtr& sel_bp,
                                         idx_t start, idx_t stop)
     {
 #ifdef USE_MPI
         if (!enable_halo_exchange || _env->num_ranks < 2)
             return;
-
-        mpi_time.start();
         TRACE_MSG("exchange_halos: " << start << " ... (end before) " << stop);
-        auto opts = get_settings();
-        auto& sd = _dims->_step_dim;
 
         // Loop through steps.  This loop has to be outside halo-step loop
         // because we only have one buffer per step. Normally, we only
         // exchange one step; in that case, it doesn't matter. It would be
         // more efficient to allow packing and unpacking multiple steps,
-        // esp. with WFs.  TODO: this will need to be addressed if/when
-        // comm/compute overlap is added.
+        // esp. with WFs.
         assert(start != stop);
         idx_t step = (start < stop) ? 1 : -1;
         for (idx_t t = start; t != stop; t += step) {
+            start_halo_exchange(sel_bp, t);
+            finish_halo_exchange();
+        }
+#endif
+    }
 
-            // Get list of grids that need to be swapped.
-            // Use an ordered map to make sure grids are in
-            // same order on all ranks.
-            GridPtrMap gridsToSwap;
+    // Post receives and send packed halo data needed by bundle pack
+    // 'sel_bp' at step 't'. Call finish_halo_exchange() to wait for the
+    // data and unpack it.
+    void StencilContext::start_halo_exchange(const BundlePackPtr& sel_bp, idx_t t)
+    {
+#ifdef USE_MPI
+        if (!enable_halo_exchange || _env->num_ranks < 2)
+            return;
 
-            // Loop thru all bundle packs.
-            for (auto& bp : stPacks) {
+        // There is only one set of buffers, so any exchange already in
+        // flight must be completed first.
+        finish_halo_exchange();
 
-                // Not selected bundle pack?
-                if (sel_bp && sel_bp != bp)
-                    continue;
+        mpi_time.start();
+
+        if (_opts->perf_counters)
+            halo_perf.start();
+        TRACE_MSG("start_halo_exchange: step " << t);
+
+        // Get list of grids that need to be swapped.
+        // Use an ordered map to make sure grids are in
+        // same order on all ranks.
+        auto& hx = _halo_exch;
+        auto& gridsToSwap = hx.grids;
+        gridsToSwap.clear();
+
+        // Loop thru all bundle packs.
+        for (auto& bp : stPacks) {
+
+            // Not selected bundle pack?
+            if (sel_bp && sel_bp != bp)
+                continue;
+
+            // Loop thru stencil bundles in this pack.
+            for (auto* sg : *bp) {
+
+                // Find the bundles that need to be processed.
+                // This will be any prerequisite scratch-grid
+                // bundles plus this non-scratch bundle.
+                // We need to loop thru the scratch-grid
+                // bundles so we can consider the inputs
+                // to them for exchanges.
+                auto sg_list = sg->get_reqd_bundles();
+
+                // Loop through all the needed bundles.
+                for (auto* csg : sg_list) {
+
+                    TRACE_MSG("start_halo_exchange: checking " << csg->inputGridPtrs.size() <<
+                              " input grid(s) to bundle '" << csg->get_name() <<
+                              "' that is needed for bundle '" << sg->get_name() << "'");
 
-                // Loop thru stencil bundles in this pack.
-                for (auto* sg : *bp) {
+                    // Loop thru all *input* grids in this bundle.
+                    for (auto gp : csg->inputGridPtrs) {
 
-                    // Find the bundles that need to be processed.
-                    // This will be any prerequisite scratch-grid
-                    // bundles plus this non-scratch bundle.
-                    // We need to loop thru the scratch-grid
-                    // bundles so we can consider the inputs
-                    // to them for exchanges.
-                    auto sg_list = sg->get_reqd_bundles();
+                        // Don't swap scratch grids.
+                        if (gp->is_scratch())
+                            continue;
 
-                    // Loop through all the needed bundles.
-                    for (auto* csg : sg_list) {
+                        // Only need to swap grids whose halos are not up-to-date
+                        // for this step.
+                        if (!gp->is_dirty(t))
+                            continue;
 
-                        TRACE_MSG("exchange_halos: checking " << csg->inputGridPtrs.size() <<
-                                  " input grid(s) to bundle '" << csg->get_name() <<
-                                  "' that is needed for bundle '" << sg->get_name() << "'");
+                        // Only need to swap grids that have any MPI buffers.
+                        auto& gname = gp->get_name();
+                        if (mpiData.count(gname) == 0)
+                            continue;
 
-                        // Loop thru all *input* grids in this bundle.
-                        for (auto gp : csg->inputGridPtrs) {
+                        // Swap this grid.
+                        gridsToSwap[gname] = gp;
+                    }
+                } // needed bundles.
+            } // bundles in pack.
+        } // packs.
+        TRACE_MSG("start_halo_exchange: need to exchange halos for " <<
+                  gridsToSwap.size() << " grid(s)");
+
+        // Request handles are indexed by grid and neighbor, or by
+        // neighbor when combining halos.
+        auto nsize = _mpiInfo->neighborhood_size;
+        size_t nreqs = _opts->combine_halos ? nsize : gridsToSwap.size() * nsize;
+        hx.send_reqs.assign(nreqs, MPI_REQUEST_NULL);
+        hx.recv_reqs.assign(nreqs, MPI_REQUEST_NULL);
+        hx.step = t;
+        hx.active = true;
+
+        // Hand the exchange to the progress threads, or do it here.
+        if (_num_progress_threads) {
+            TRACE_MSG("start_halo_exchange: waking " << _num_progress_threads <<
+                      " progress thread(s)");
+            {
+                lock_guard<mutex> lk(_progress_lock);
+                _progress_busy = _num_progress_threads;
+                _progress_seq++;
+            }
+            _progress_cv.notify_all();
+        }
+        else
+            post_halo_exchange(0, 1);
 
-                            // Don't swap scratch grids.
-                            if (gp->is_scratch())
-                                continue;
+        halo_perf.stop();
+        mpi_time.stop();
 
-                            // Only need to swap grids whose halos are not up-to-date
-                            // for this step.
-                            if (!gp->is_dirty(t))
-                                continue;
+        // Start the same exchange in the batch. Its messages use the same
+        // tags, but they are matched in order because they are posted in
+        // the same order on every rank.
+        for (auto& bc : _batch)
+            bc->start_halo_exchange(get_batch_pack(*bc, sel_bp), t);
+#endif
+    }
 
-                            // Only need to swap grids that have any MPI buffers.
-                            auto& gname = gp->get_name();
-                            if (mpiData.count(gname) == 0)
-                                continue;
+    // Post the receives and pack and send the data for part 'part' of
+    // 'nparts' of the exchange set up by start_halo_exchange(). The grids
+    // are divided round-robin between the parts. With combined halos,
+    // part 0 does everything.
+    void StencilContext::post_halo_exchange(int part, int nparts)
+    {
+#ifdef USE_MPI
+        auto& hx = _halo_exch;
+        auto& gridsToSwap = hx.grids;
+        idx_t t = hx.step;
+        auto nsize = _mpiInfo->neighborhood_size;
+
+        // MPI calls from the progress threads are serialized.
+        bool async = _num_progress_threads > 0;
+        auto lock_mpi = [&]() {
+            return async ? unique_lock<mutex>(_mpi_lock) : unique_lock<mutex>();
+        };
+
+        // Combined halos: allocMpiData() placed the buffers of all grids
+        // for each neighbor consecutively, so one message per neighbor
+        // covers the span from the first to the last grid being swapped.
+        if (_opts->combine_halos) {
+            if (part != 0)
+                return;
+            _mpiInfo->visitNeighbors
+                ([&](const IdxTuple& offsets, // NeighborOffset.
+                     int neighbor_rank,
+                     int ni) { // unique neighbor index.
+                    if (neighbor_rank == MPI_PROC_NULL)
+                        return;
 
-                            // Swap this grid.
-                            gridsToSwap[gname] = gp;
+                    // Find span of buffers and pack send data.
+                    char* rbegin = 0, * rend = 0, * sbegin = 0, * send = 0;
+                    for (auto gtsi : gridsToSwap) {
+                        auto gp = gtsi.second;
+                        auto& grid_mpi_data = mpiData.at(gtsi.first);
+                        auto& sendBuf = grid_mpi_data.getBuf(MPIBufs::bufSend, offsets);
+                        auto& recvBuf = grid_mpi_data.getBuf(MPIBufs::bufRecv, offsets);
+                        if (recvBuf.get_bytes() && !recvBuf.is_shm()) {
+                            char* p = (char*)recvBuf._elems;
+                            if (!rbegin || p < rbegin)
+                                rbegin = p;
+                            rend = max(rend, p + recvBuf.get_bytes());
                         }
-                    } // needed bundles.
-                } // bundles in pack.
-            } // packs.
-            TRACE_MSG("exchange_halos: need to exchange halos for " <<
-                      gridsToSwap.size() << " grid(s)");
-
-            // 1D array to store send request handles.
-            // We use a 1D array so we can call MPI_Waitall().
-            MPI_Request send_reqs[gridsToSwap.size() * _mpiInfo->neighborhood_size];
-
-            // 2D array for receive request handles.
-            // We use a 2D array to simplify individual indexing.
-            MPI_Request recv_reqs[gridsToSwap.size()][_mpiInfo->neighborhood_size];
-
-            // Sequence of things to do for each grid's neighbors
-            // (isend includes packing).
-            int num_send_reqs = 0;
-            int num_recv_reqs = 0;
-            enum halo_steps { halo_irecv, halo_pack_isend, halo_unpack, halo_nsteps };
-            for (int halo_step = 0; halo_step < halo_nsteps; halo_step++) {
-
-                if (halo_step == halo_irecv)
-                    TRACE_MSG("exchange_halos: requesting data for step " << t << "...");
-                else if (halo_step == halo_pack_isend)
-                    TRACE_MSG("exchange_halos: packing and sending data for step " << t << "...");
-                else if (halo_step == halo_unpack)
-                    TRACE_MSG("exchange_halos: unpacking data for step " << t << "...");
-
-                // Loop thru all grids to swap.
-                // Use 'gi' as a unique MPI index.
-                int gi = -1;
-                for (auto gtsi : gridsToSwap) {
-                    auto& gname = gtsi.first;
-                    auto gp = gtsi.second;
-                    gi++;
-                    MPI_Request* grid_recv_reqs = recv_reqs[gi];
-                    TRACE_MSG(" for grid #" << gi << ", '" << gname << "'...");
-
-                    // Visit all this rank's neighbors.
-                    auto& grid_mpi_data = mpiData.at(gname);
-                    grid_mpi_data.visitNeighbors
-                        ([&](const IdxTuple& offsets, // NeighborOffset.
-                             int neighbor_rank,
-                             int ni, // unique neighbor index.
-                             MPIBufs& bufs) {
-                            auto& sendBuf = bufs.bufs[MPIBufs::bufSend];
-                            auto& recvBuf = bufs.bufs[MPIBufs::bufRecv];
-                            TRACE_MSG("  with rank " << neighbor_rank << " at relative position " <<
-                                      offsets.subElements(1).makeDimValOffsetStr() << "...");
-
-                            // Submit async request to receive data from neighbor.
-                            if (halo_step == halo_irecv) {
-                                auto nbytes = recvBuf.get_bytes();
-                                if (nbytes) {
-                                    void* buf = (void*)recvBuf._elems;
-                                    TRACE_MSG("   requesting " << makeByteStr(nbytes) << "...");
-                                    MPI_Irecv(buf, nbytes, MPI_BYTE,
-                                              neighbor_rank, int(gi), _env->comm, &grid_recv_reqs[ni]);
-                                    num_recv_reqs++;
-                                }
-                                else
-                                    TRACE_MSG("   0B to request");
+                        if (sendBuf.get_bytes() && sendBuf.is_shm())
+                            send_shm_halo(gp, sendBuf, t);
+                        else if (sendBuf.get_bytes()) {
+                            TRACE_EVENT("halo", "pack");
+                            pack_halo(gp, sendBuf, t);
+                            char* p = (char*)sendBuf._elems;
+                            if (!sbegin || p < sbegin)
+                                sbegin = p;
+                            send = max(send, p + sendBuf.get_bytes());
+                        }
+                    }
+
+                    // Submit async request to receive all data from neighbor.
+                    if (rbegin) {
+                        auto nbytes = rend - rbegin;
+                        TRACE_MSG("  requesting " << makeByteStr(nbytes) <<
+                                  " for " << gridsToSwap.size() << " grid(s) from rank " <<
+                                  neighbor_rank << "...");
+                        auto lk = lock_mpi();
+                        MPI_Irecv(rbegin, nbytes, MPI_BYTE,
+                                  neighbor_rank, 0, _env->comm, &hx.recv_reqs[ni]);
+                    }
+
+                    // Send all packed data to neighbor.
+                    if (sbegin) {
+                        auto nbytes = send - sbegin;
+                        TRACE_MSG("  sending " << makeByteStr(nbytes) <<
+                                  " for " << gridsToSwap.size() << " grid(s) to rank " <<
+                                  neighbor_rank << "...");
+                        TRACE_EVENT("halo", "send");
+                        auto lk = lock_mpi();
+                        MPI_Isend(sbegin, nbytes, MPI_BYTE,
+                                  neighbor_rank, 0, _env->comm,
+                                  &hx.send_reqs[ni]);
+                    }
+                });
+            return;
+        }
+
+        // Sequence of things to do for each grid's neighbors
+        // (isend includes packing). Unpacking is done in
+        // complete_halo_exchange().
+        enum halo_steps { halo_irecv, halo_pack_isend, halo_nsteps };
+        vector<MPI_Request> start_reqs; // persistent requests to start.
+        for (int halo_step = 0; halo_step < halo_nsteps; halo_step++) {
+
+            if (halo_step == halo_irecv)
+                TRACE_MSG("post_halo_exchange: requesting data for step " << t << "...");
+            else if (halo_step == halo_pack_isend)
+                TRACE_MSG("post_halo_exchange: packing and sending data for step " << t << "...");
+
+            // Loop thru all grids to swap in this part.
+            // Use 'gi' as a unique MPI index.
+            int gi = -1;
+            for (auto gtsi : gridsToSwap) {
+                auto& gname = gtsi.first;
+                auto gp = gtsi.second;
+                gi++;
+                if (gi % nparts != part)
+                    continue;
+                MPI_Request* grid_recv_reqs = &hx.recv_reqs[gi * nsize];
+                MPI_Request* grid_send_reqs = &hx.send_reqs[gi * nsize];
+                TRACE_MSG(" for grid #" << gi << ", '" << gname << "'...");
+
+                // Visit all this rank's neighbors.
+                auto& grid_mpi_data = mpiData.at(gname);
+                grid_mpi_data.visitNeighbors
+                    ([&](const IdxTuple& offsets, // NeighborOffset.
+                         int neighbor_rank,
+                         int ni, // unique neighbor index.
+                         MPIBufs& bufs) {
+                        auto& sendBuf = bufs.bufs[MPIBufs::bufSend];
+                        auto& recvBuf = bufs.bufs[MPIBufs::bufRecv];
+                        TRACE_MSG("  with rank " << neighbor_rank << " at relative position " <<
+                                  offsets.subElements(1).makeDimValOffsetStr() << "...");
+
+                        // Submit async request to receive data from neighbor.
+                        if (halo_step == halo_irecv) {
+                            auto nbytes = recvBuf.get_bytes();
+                            if (nbytes && recvBuf.is_shm())
+                                TRACE_MSG("   " << makeByteStr(nbytes) << " in shared memory");
+                            else if (nbytes && recvBuf._preq != MPI_REQUEST_NULL) {
+                                TRACE_MSG("   requesting " << makeByteStr(nbytes) <<
+                                          " with persistent request...");
+                                grid_recv_reqs[ni] = recvBuf._preq;
+                                start_reqs.push_back(recvBuf._preq);
+                            }
+                            else if (nbytes) {
+                                void* buf = (void*)recvBuf._elems;
+                                TRACE_MSG("   requesting " << makeByteStr(nbytes) << "...");
+                                auto lk = lock_mpi();
+                                MPI_Irecv(buf, nbytes, MPI_BYTE,
+                                          neighbor_rank, int(gi), _env->comm, &grid_recv_reqs[ni]);
                             }
+                            else
+                                TRACE_MSG("   0B to request");
+                        }
 
-                            // Pack data into send buffer, then send to neighbor.
-                            else if (halo_step == halo_pack_isend) {
-                                auto nbytes = sendBuf.get_bytes();
-                                if (nbytes) {
-
-                                    // Vec ok?
-                                    // Domain sizes must be ok, and buffer size must be ok
-                                    // as calculated when buffers were created.
-                                    bool send_vec_ok = allow_vec_exchange && sendBuf.vec_copy_ok;
-
-                                    // Get first and last ranges.
-                                    IdxTuple first = sendBuf.begin_pt;
-                                    IdxTuple last = sendBuf.last_pt;
-
-                                    // The code in allocMpiData() pre-calculated the first and
-                                    // last points of each buffer, except in the step dim.
-                                    // So, we need to set that value now.
-                                    // TODO: update this if we expand the buffers to hold
-                                    // more than one step.
-                                    if (gp->is_dim_used(sd)) {
-                                        first.setVal(sd, t);
-                                        last.setVal(sd, t);
-                                    }
-                                    TRACE_MSG("   packing " << sendBuf.num_pts.makeDimValStr(" * ") <<
-                                              " points from " << first.makeDimValStr() <<
-                                              " ... " << last.makeDimValStr() <<
-                                              (send_vec_ok ? " with" : " without") <<
-                                              " vector copy...");
-
-                                    // Copy (pack) data from grid to buffer.
-                                    void* buf = (void*)sendBuf._elems;
-                                    if (send_vec_ok)
-                                        gp->get_vecs_in_slice(buf, first, last);
-                                    else
-                                        gp->get_elements_in_slice(buf, first, last);
-
-                                    // Send packed buffer to neighbor.
-                                    auto nbytes = sendBuf.get_bytes();
-                                    TRACE_MSG("   sending " << makeByteStr(nbytes) << "...");
-                                    MPI_Isend(buf, nbytes, MPI_BYTE,
-                                              neighbor_rank, int(gi), _env->comm,
-                                              &send_reqs[num_send_reqs++]);
+                        // Pack data into send buffer, then send to neighbor.
+                        else if (halo_step == halo_pack_isend) {
+                            auto nbytes = sendBuf.get_bytes();
+                            if (nbytes && sendBuf.is_shm())
+                                send_shm_halo(gp, sendBuf, t);
+                            else if (nbytes) {
+                                {
+                                    TRACE_EVENT("halo", "pack");
+                                    pack_halo(gp, sendBuf, t);
                                 }
-                                else
-                                    TRACE_MSG("   0B to send");
-                            }
 
-                            // Wait for data from neighbor, then unpack it.
-                            else if (halo_step == halo_unpack) {
-                                auto nbytes = recvBuf.get_bytes();
-                                if (nbytes) {
-
-                                    // Wait for data from neighbor before unpacking it.
-                                    TRACE_MSG("   waiting for " << makeByteStr(nbytes) << "...");
-                                    MPI_Wait(&grid_recv_reqs[ni], MPI_STATUS_IGNORE);
-
-                                    // Vec ok?
-                                    bool recv_vec_ok = allow_vec_exchange && recvBuf.vec_copy_ok;
-
-                                    // Get first and last ranges.
-                                    IdxTuple first = recvBuf.begin_pt;
-                                    IdxTuple last = recvBuf.last_pt;
-
-                                    // Set step val as above.
-                                    if (gp->is_dim_used(sd)) {
-                                        first.setVal(sd, t);
-                                        last.setVal(sd, t);
-                                    }
-                                    TRACE_MSG("   got data; unpacking " << recvBuf.num_pts.makeDimValStr(" * ") <<
-                                              " points into " << first.makeDimValStr() <<
-                                              " ... " << last.makeDimValStr() <<
-                                              (recv_vec_ok ? " with" : " without") <<
-                                              " vector copy...");
-
-                                    // Copy data from buffer to grid.
-                                    void* buf = (void*)recvBuf._elems;
-                                    idx_t n = 0;
-                                    if (recv_vec_ok)
-                                        n = gp->set_vecs_in_slice(buf, first, last);
-                                    else
-                                        n = gp->set_elements_in_slice(buf, first, last);
-                                    assert(n == recvBuf.get_size());
+                                // Send packed buffer to neighbor.
+                                void* buf = (void*)sendBuf._elems;
+                                TRACE_MSG("   sending " << makeByteStr(nbytes) << "...");
+                                TRACE_EVENT("halo", "send");
+                                auto lk = lock_mpi();
+                                if (sendBuf._preq != MPI_REQUEST_NULL) {
+                                    grid_send_reqs[ni] = sendBuf._preq;
+                                    MPI_Start(&grid_send_reqs[ni]);
                                 }
                                 else
-                                    TRACE_MSG("   0B to wait for");
+                                    MPI_Isend(buf, nbytes, MPI_BYTE,
+                                              neighbor_rank, int(gi), _env->comm,
+                                              &grid_send_reqs[ni]);
                             }
-                        }); // visit neighbors.
+                            else
+                                TRACE_MSG("   0B to send");
+                        }
+                    }); // visit neighbors.
 
-                } // grids.
-            } // exchange sequence.
+            } // grids.
 
-            // Mark grids as up-to-date.
-            for (auto gtsi : gridsToSwap) {
-                auto& gname = gtsi.first;
-                auto gp = gtsi.second;
-                if (gp->is_dirty(t)) {
-                    gp->set_dirty(false, t);
-                    TRACE_MSG("grid '" << gname <<
-                              "' marked as clean at step " << t);
+            // Start all the persistent receives together.
+            if (start_reqs.size()) {
+                auto lk = lock_mpi();
+                MPI_Startall(int(start_reqs.size()), start_reqs.data());
+                start_reqs.clear();
+            }
+        } // exchange sequence.
+#endif
+    }
+
+    // Wait for the data in part 'part' of 'nparts' of the exchange posted
+    // by post_halo_exchange(), unpack it, and wait for the sends. The
+    // progress threads poll with MPI_Test*() instead of blocking so
+    // that they drive MPI progress and do not hold the MPI lock.
+    void StencilContext::complete_halo_exchange(int part, int nparts)
+    {
+#ifdef USE_MPI
+        auto& hx = _halo_exch;
+        idx_t t = hx.step;
+        auto nsize = _mpiInfo->neighborhood_size;
+        bool combine = _opts->combine_halos;
+        if (combine && part != 0)
+            return;
+        TRACE_MSG("complete_halo_exchange: unpacking data for step " << t << "...");
+
+        // Wait for requests 'reqs[0..n-1]'.
+        bool async = _num_progress_threads > 0;
+        auto wait_reqs = [&](int n, MPI_Request* reqs) {
+            TRACE_EVENT("halo", "wait");
+            if (!async) {
+                wait_time.start();
+                MPI_Waitall(n, reqs, MPI_STATUSES_IGNORE);
+                wait_time.stop();
+                return;
+            }
+            for (int flag = 0; !flag; ) {
+                {
+                    lock_guard<mutex> lk(_mpi_lock);
+                    MPI_Testall(n, reqs, &flag, MPI_STATUSES_IGNORE);
                 }
+                if (!flag)
+                    sched_yield();
             }
+        };
+
+        // Wait for the combined message from each neighbor.
+        if (combine) {
+            TRACE_MSG(" waiting for combined data from each neighbor...");
+            wait_reqs(int(hx.recv_reqs.size()), hx.recv_reqs.data());
+        }
+
+        // Unpack each buffer as soon as its data are here.
+        // Same order as in post_halo_exchange().
+        int gi = -1;
+        for (auto gtsi : hx.grids) {
+            auto& gname = gtsi.first;
+            auto gp = gtsi.second;
+            gi++;
+            if (!combine && gi % nparts != part)
+                continue;
+            MPI_Request* grid_recv_reqs = combine ? 0 : &hx.recv_reqs[gi * nsize];
+            TRACE_MSG(" for grid #" << gi << ", '" << gname << "'...");
+
+            // Visit all this rank's neighbors.
+            auto& grid_mpi_data = mpiData.at(gname);
+            grid_mpi_data.visitNeighbors
+                ([&](const IdxTuple& offsets, // NeighborOffset.
+                     int neighbor_rank,
+                     int ni, // unique neighbor index.
+                     MPIBufs& bufs) {
+                    auto& recvBuf = bufs.bufs[MPIBufs::bufRecv];
+                    TRACE_MSG("  with rank " << neighbor_rank << " at relative position " <<
+                              offsets.subElements(1).makeDimValOffsetStr() << "...");
+
+                    // Wait for data from neighbor, then unpack it.
+                    auto nbytes = recvBuf.get_bytes();
+                    if (nbytes && recvBuf.is_shm())
+                        recv_shm_halo(gp, recvBuf, t);
+                    else if (nbytes) {
+
+                        // Wait for data from neighbor before unpacking it,
+                        // unless all data was already received in one
+                        // message above.
+                        if (!combine) {
+                            TRACE_MSG("   waiting for " << makeByteStr(nbytes) << "...");
+                            wait_reqs(1, &grid_recv_reqs[ni]);
+                        }
+                        TRACE_EVENT("halo", "unpack");
+                        unpack_halo(gp, recvBuf, t);
+                    }
+                    else
+                        TRACE_MSG("   0B to wait for");
+                }); // visit neighbors.
+
+            // Wait for the sends of this grid.
+            if (!combine)
+                wait_reqs(int(nsize), &hx.send_reqs[gi * nsize]);
+        } // grids.
+
+        // Wait for the combined sends.
+        if (combine)
+            wait_reqs(int(hx.send_reqs.size()), hx.send_reqs.data());
+#endif
+    }
+
+    // Wait for data from the exchange started in start_halo_exchange(),
+    // unpack it, and mark the grids as up-to-date.
+    void StencilContext::finish_halo_exchange()
+    {
+#ifdef USE_MPI
+        auto& hx = _halo_exch;
+        if (!hx.active)
+            return;
 
-            // Wait for all send requests to complete.
-            TRACE_MSG("exchange_halos: " << num_recv_reqs <<
-                      " MPI receive request(s) completed");
-            if (num_send_reqs) {
-                TRACE_MSG("exchange_halos: waiting for " << num_send_reqs <<
-                          " MPI send request(s) to complete...");
-                MPI_Waitall(num_send_reqs, send_reqs, MPI_STATUS_IGNORE);
-                TRACE_MSG(" done waiting for MPI send request(s)");
+        mpi_time.start();
+
+        if (_opts->perf_counters)
+            halo_perf.start();
+        idx_t t = hx.step;
+        TRACE_MSG("finish_halo_exchange: step " << t << "...");
+
+        // Wait for the progress threads, or do the work here.
+        if (_num_progress_threads) {
+            TRACE_EVENT("halo", "wait");
+            wait_time.start();
+            unique_lock<mutex> lk(_progress_lock);
+            _progress_cv.wait(lk, [&]() { return _progress_busy == 0; });
+            wait_time.stop();
+        }
+        else
+            complete_halo_exchange(0, 1);
+
+        // Mark grids as up-to-date.
+        for (auto gtsi : hx.grids) {
+            auto& gname = gtsi.first;
+            auto gp = gtsi.second;
+            if (gp->is_dirty(t)) {
+                gp->set_dirty(false, t);
+                TRACE_MSG("grid '" << gname <<
+                          "' marked as clean at step " << t);
             }
-            else
-                TRACE_MSG("exchange_halos: no MPI send requests to wait for");
-        } // steps.
+        }
 
+        hx.grids.clear();
+        hx.send_reqs.clear();
+        hx.recv_reqs.clear();
+        hx.active = false;
+        halo_perf.stop();
         mpi_time.stop();
+
+        for (auto& bc : _batch)
+            bc->finish_halo_exchange();
+#endif
+    }
+
+    // Time halo exchanges without any calculation. First, time whole
+    // exchanges of all grids as done between steps. Then, time the
+    // exchanges with each neighbor separately, one direction at a time:
+    // every rank sends to its neighbor at the same offset and receives
+    // from the one at the opposite offset, so the messages match.
+    void StencilContext::bench_halo_exchange(int nreps)
+    {
+        ostream& os = get_ostr();
+        nreps = max(nreps, 1);
+#ifdef USE_MPI
+        if (!enable_halo_exchange || _env->num_ranks < 2) {
+            os << "No halos to exchange.\n";
+            return;
+        }
+        finish_halo_exchange();
+        auto& sd = _dims->_step_dim;
+        auto nsize = _mpiInfo->neighborhood_size;
+        os << endl << "Timing " << nreps << " halo exchange(s) of " <<
+            mpiData.size() << " grid(s)...\n";
+
+        // Whole exchanges.
+        YaskTimer xtimer;
+        _env->global_barrier();
+        for (int r = 0; r < nreps; r++) {
+            for (auto gp : gridPtrs)
+                gp->set_dirty_all(true);
+            xtimer.start();
+            exchange_halos_all();
+            xtimer.stop();
+        }
+        double xsecs = xtimer.get_elapsed_secs() / nreps;
+        double max_xsecs = xsecs;
+        MPI_Allreduce(&xsecs, &max_xsecs, 1, MPI_DOUBLE, MPI_MAX, _env->comm);
+        os << "halo-exchange-time (sec):          " << makeNumStr(max_xsecs) <<
+            " per exchange, max over ranks\n";
+
+        // One direction at a time. Times are per exchange and are kept
+        // by neighbor index: packing and sending for the neighbor sent
+        // to and unpacking for the one received from.
+        vector<double> pack_secs(nsize, 0.), comm_secs(nsize, 0.),
+            unpack_secs(nsize, 0.), lat_secs(nsize, 0.);
+        vector<idx_t> send_bytes(nsize, 0), recv_bytes(nsize, 0);
+        vector<size_t> send_msgs(nsize, 0);
+        _mpiInfo->visitNeighbors
+            ([&](const IdxTuple& offsets, // NeighborOffset.
+                 int send_rank,
+                 int ni) { // unique neighbor index.
+                int oni = int(nsize) - 1 - ni; // index of opposite neighbor.
+                int recv_rank = _mpiInfo->my_neighbors.at(oni);
+
+                // Buffers to send to 'send_rank' and receive from
+                // 'recv_rank' for each grid. The grids are in the same
+                // order on all ranks.
+                vector<pair<YkGridPtr, MPIBuf*>> sbufs, rbufs;
+                vector<int> stags, rtags;
+                int gi = -1;
+                for (auto& mdi : mpiData) {
+                    auto gp = gridMap.at(mdi.first);
+                    gi++;
+                    auto& sbuf = mdi.second.bufs[ni].bufs[MPIBufs::bufSend];
+                    auto& rbuf = mdi.second.bufs[oni].bufs[MPIBufs::bufRecv];
+                    if (send_rank != MPI_PROC_NULL && sbuf.get_bytes() && !sbuf.is_shm()) {
+                        sbufs.push_back({ gp, &sbuf });
+                        stags.push_back(gi);
+                        send_bytes[ni] += sbuf.get_bytes();
+                    }
+                    if (recv_rank != MPI_PROC_NULL && rbuf.get_bytes() && !rbuf.is_shm()) {
+                        rbufs.push_back({ gp, &rbuf });
+                        rtags.push_back(gi);
+                        recv_bytes[oni] += rbuf.get_bytes();
+                    }
+                }
+                send_msgs[ni] = sbufs.size();
+                int latency_tag = gi + 1;
+
+                YaskTimer pack_timer, comm_timer, unpack_timer, lat_timer;
+                vector<MPI_Request> reqs;
+                for (int r = 0; r < nreps; r++) {
+
+                    // Pack.
+                    pack_timer.start();
+                    for (auto& sb : sbufs) {
+                        auto gp = sb.first;
+                        idx_t t = gp->is_dim_used(sd) ? gp->_get_first_alloc_index(sd) : 0;
+                        pack_halo(gp, *sb.second, t);
+                    }
+                    pack_timer.stop();
+
+                    // Send and receive.
+                    reqs.clear();
+                    MPI_Barrier(_env->comm);
+                    comm_timer.start();
+                    for (size_t i = 0; i < rbufs.size(); i++) {
+                        auto& rb = *rbufs[i].second;
+                        reqs.push_back(MPI_REQUEST_NULL);
+                        MPI_Irecv((void*)rb._elems, rb.get_bytes(), MPI_BYTE,
+                                  recv_rank, rtags[i], _env->comm, &reqs.back());
+                    }
+                    for (size_t i = 0; i < sbufs.size(); i++) {
+                        auto& sb = *sbufs[i].second;
+                        reqs.push_back(MPI_REQUEST_NULL);
+                        MPI_Isend((void*)sb._elems, sb.get_bytes(), MPI_BYTE,
+                                  send_rank, stags[i], _env->comm, &reqs.back());
+                    }
+                    MPI_Waitall(int(reqs.size()), reqs.data(), MPI_STATUSES_IGNORE);
+                    comm_timer.stop();
+
+                    // Unpack.
+                    unpack_timer.start();
+                    for (auto& rb : rbufs) {
+                        auto gp = rb.first;
+                        idx_t t = gp->is_dim_used(sd) ? gp->_get_first_alloc_index(sd) : 0;
+                        unpack_halo(gp, *rb.second, t);
+                    }
+                    unpack_timer.stop();
+
+                    // Latency of an empty message.
+                    MPI_Request lreqs[2];
+                    MPI_Barrier(_env->comm);
+                    lat_timer.start();
+                    MPI_Irecv(0, 0, MPI_BYTE, recv_rank, latency_tag, _env->comm, &lreqs[0]);
+                    MPI_Isend(0, 0, MPI_BYTE, send_rank, latency_tag, _env->comm, &lreqs[1]);
+                    MPI_Waitall(2, lreqs, MPI_STATUSES_IGNORE);
+                    lat_timer.stop();
+                }
+                pack_secs[ni] = pack_timer.get_elapsed_secs() / nreps;
+                comm_secs[ni] = comm_timer.get_elapsed_secs() / nreps;
+                lat_secs[ni] = lat_timer.get_elapsed_secs() / nreps;
+                unpack_secs[oni] = unpack_timer.get_elapsed_secs() / nreps;
+            });
+
+        // Report neighbors with any halo data.
+        os << "Per-neighbor halo exchanges of rank " << _env->my_rank <<
+            " (times are per exchange):\n";
+        _mpiInfo->visitNeighbors
+            ([&](const IdxTuple& offsets, // NeighborOffset.
+                 int neighbor_rank,
+                 int ni) { // unique neighbor index.
+                if (neighbor_rank == MPI_PROC_NULL ||
+                    (send_bytes[ni] == 0 && recv_bytes[ni] == 0))
+                    return;
+                os << " neighbor at " << offsets.subElements(1).makeDimValOffsetStr() <<
+                    " (rank " << neighbor_rank << "):\n"
+                    "  sent " << makeByteStr(send_bytes[ni]) << " in " << send_msgs[ni] <<
+                    " message(s), received " << makeByteStr(recv_bytes[ni]) << endl <<
+                    "  pack-time (sec):      " << makeNumStr(pack_secs[ni]) << endl <<
+                    "  send+recv-time (sec): " << makeNumStr(comm_secs[ni]) << endl <<
+                    "  send-bandwidth:       " <<
+                    makeNumStr(comm_secs[ni] > 0. ? send_bytes[ni] / comm_secs[ni] : 0.) << "B/s\n"
+                    "  unpack-time (sec):    " << makeNumStr(unpack_secs[ni]) << endl <<
+                    "  latency (sec):        " << makeNumStr(lat_secs[ni]) << endl;
+            });
+        _env->global_barrier();
+#else
+        os << "No halos to exchange without MPI.\n";
+#endif
+    }
+
+    // Body of each progress thread. Thread 'part' of 'nparts' waits for
+    // start_halo_exchange() to hand it an exchange, does its part of
+    // it, and reports back to finish_halo_exchange().
+    void StencilContext::progress_loop(int part, int nparts)
+    {
+#ifdef USE_MPI
+        if (_opts->progress_cpu >= 0)
+            CpuTopology::bind_thread(_opts->progress_cpu + part);
+
+        // Keep packing and unpacking off the compute threads' cores.
+        omp_set_num_threads(1);
+
+        idx_t seq = 0;
+        while (true) {
+            {
+                unique_lock<mutex> lk(_progress_lock);
+                _progress_cv.wait(lk, [&]() { return _progress_stop || _progress_seq != seq; });
+                if (_progress_stop)
+                    return;
+                seq = _progress_seq;
+            }
+            post_halo_exchange(part, nparts);
+            complete_halo_exchange(part, nparts);
+            {
+                lock_guard<mutex> lk(_progress_lock);
+                _progress_busy--;
+            }
+            _progress_cv.notify_all();
+        }
+#endif
+    }
+
+    // Start or stop the progress threads.
+    void StencilContext::start_progress_threads(int nthreads)
+    {
+        stop_progress_threads();
+#ifdef USE_MPI
+        if (nthreads <= 0)
+            return;
+        _progress_stop = false;
+        _progress_seq = 0;
+        _progress_busy = 0;
+        _num_progress_threads = nthreads;
+        for (int i = 0; i < nthreads; i++)
+            _progress_threads.emplace_back(&StencilContext::progress_loop, this, i, nthreads);
+#endif
+    }
+    void StencilContext::stop_progress_threads()
+    {
+#ifdef USE_MPI
+        finish_halo_exchange();
+        {
+            lock_guard<mutex> lk(_progress_lock);
+            _progress_stop = true;
+        }
+        _progress_cv.notify_all();
+        for (auto& thr : _progress_threads)
+            thr.join();
+        _progress_threads.clear();
+        _num_progress_threads = 0;
 #endif
     }
 
+    // Wait for blocks from region thread 'n' and prefetch them. The helper
+    // is bound to a sibling of the CPU that the region thread ran on when
+    // it handed over the block.
+    void StencilContext::prefetch_loop(int n)
+    {
+        auto& ph = *_prefetch_helpers[n];
+        int bound_cpu = -1;
+        while (true) {
+            const vector<PrefetchArea>* areas = 0;
+            Indices begin, end;
+            int cpu = -1;
+            {
+                unique_lock<mutex> lk(ph.lock);
+                ph.cv.wait(lk, [&]() { return ph.done || ph.ready; });
+                if (ph.done)
+                    return;
+                ph.ready = false;
+                areas = ph.areas;
+                begin = ph.begin;
+                end = ph.end;
+                cpu = ph.cpu;
+            }
+            if (cpu != bound_cpu) {
+                CpuTopology::bind_thread(CpuTopology::get_sibling_cpu(cpu));
+                bound_cpu = cpu;
+            }
+            prefetch_block(*areas, begin, end);
+        }
+    }
+
+    // Prefetch the data read in the block from 'begin' to 'end' (before)
+    // at its first step.
+    void StencilContext::prefetch_block(const vector<PrefetchArea>& areas,
+                                        const Indices& begin, const Indices& end)
+    {
+        auto& step_dim = _dims->_step_dim;
+        auto step_posn = Indices::step_posn;
+        for (auto& pa : areas) {
+            auto* gp = pa.gp.get();
+            int ngdims = gp->get_num_dims();
+            Indices first(pa.lo), last(pa.hi);
+            for (int i = 0; i < ngdims; i++) {
+                auto& dname = gp->get_dim_name(i);
+                if (dname == step_dim)
+                    first[i] = last[i] = begin[step_posn] + pa.lo[i];
+                else {
+                    int j = _dims->_stencil_dims.lookup_posn(dname);
+                    if (j >= 0) {
+                        first[i] = begin[j] + pa.lo[i];
+                        last[i] = end[j] - 1 + pa.hi[i];
+                    }
+                }
+            }
+            gp->prefetch_slice(first, last);
+        }
+    }
+
+    // Start or stop the prefetch helpers. Starting them also finds the
+    // areas read by each pack from the accesses in its bundles.
+    void StencilContext::start_prefetch_helpers(int nthreads)
+    {
+        stop_prefetch_helpers();
+        if (nthreads <= 0)
+            return;
+
+        _prefetch_areas.clear();
+        for (auto& bp : stPacks) {
+            auto& areas = _prefetch_areas[bp.get()];
+            for (auto* sb : *bp) {
+                if (sb->is_scratch())
+                    continue;
+                for (auto& acc : sb->_accesses) {
+                    if (acc.is_write)
+                        continue;
+                    auto* gp = acc.gp.get();
+                    int ngdims = gp->get_num_dims();
+
+                    // Merge with an area in the same grid that has the
+                    // same step and misc indices.
+                    auto same_slice = [&](const PrefetchArea& pa) {
+                        if (pa.gp.get() != gp)
+                            return false;
+                        for (int i = 0; i < ngdims; i++)
+                            if (!_dims->_domain_dims.lookup(gp->get_dim_name(i)) &&
+                                pa.lo[i] != acc.offsets[i])
+                                return false;
+                        return true;
+                    };
+                    auto it = find_if(areas.begin(), areas.end(), same_slice);
+                    if (it == areas.end())
+                        areas.push_back({ acc.gp, acc.offsets, acc.offsets });
+                    else {
+                        it->lo = it->lo.minElements(acc.offsets);
+                        it->hi = it->hi.maxElements(acc.offsets);
+                    }
+                }
+            }
+        }
+
+        for (int i = 0; i < nthreads; i++)
+            _prefetch_helpers.emplace_back(new PrefetchHelper);
+        for (int i = 0; i < nthreads; i++)
+            _prefetch_helpers[i]->thr = thread(&StencilContext::prefetch_loop, this, i);
+    }
+    void StencilContext::stop_prefetch_helpers()
+    {
+        for (auto& ph : _prefetch_helpers) {
+            {
+                lock_guard<mutex> lk(ph->lock);
+                ph->done = true;
+            }
+            ph->cv.notify_one();
+            ph->thr.join();
+        }
+        _prefetch_helpers.clear();
+    }
+
+    // Copy (pack) halo data for step 't' from grid 'gp' into send buffer 'buf'.
+    void StencilContext::pack_halo(YkGridPtr gp, MPIBuf& buf, idx_t t)
+    {
+        auto& sd = _dims->_step_dim;
+
+        // Vec ok?
+        // Domain sizes must be ok, and buffer size must be ok
+        // as calculated when buffers were created.
+        bool send_vec_ok = allow_vec_exchange && buf.vec_copy_ok;
+
+        // Get first and last ranges.
+        IdxTuple first = buf.begin_pt;
+        IdxTuple last = buf.last_pt;
+
+        // The code in allocMpiData() pre-calculated the first and
+        // last points of each buffer, except in the step dim.
+        // So, we need to set that value now.
+        // TODO: update this if we expand the buffers to hold
+        // more than one step.
+        if (gp->is_dim_used(sd)) {
+            first.setVal(sd, t);
+            last.setVal(sd, t);
+        }
+        TRACE_MSG("   packing " << buf.num_pts.makeDimValStr(" * ") <<
+                  " points from " << first.makeDimValStr() <<
+                  " ... " << last.makeDimValStr() <<
+                  (send_vec_ok ? " with" : " without") <<
+                  " vector copy...");
+
+        // Copy data from grid to buffer.
+        void* bp = (void*)buf._elems;
+        if (send_vec_ok)
+            gp->get_vecs_in_slice(bp, first, last);
+        else
+            gp->get_elements_in_slice(bp, first, last);
+    }
+
+    // Copy (unpack) halo data for step 't' from receive buffer 'buf' into grid 'gp'.
+    void StencilContext::unpack_halo(YkGridPtr gp, MPIBuf& buf, idx_t t)
+    {
+        auto& sd = _dims->_step_dim;
+
+        // Vec ok?
+        bool recv_vec_ok = allow_vec_exchange && buf.vec_copy_ok;
+
+        // Get first and last ranges.
+        IdxTuple first = buf.begin_pt;
+        IdxTuple last = buf.last_pt;
+
+        // Set step val as in pack_halo().
+        if (gp->is_dim_used(sd)) {
+            first.setVal(sd, t);
+            last.setVal(sd, t);
+        }
+        TRACE_MSG("   got data; unpacking " << buf.num_pts.makeDimValStr(" * ") <<
+                  " points into " << first.makeDimValStr() <<
+                  " ... " << last.makeDimValStr() <<
+                  (recv_vec_ok ? " with" : " without") <<
+                  " vector copy...");
+
+        // Copy data from buffer to grid.
+        void* bp = (void*)buf._elems;
+        idx_t n = 0;
+        if (recv_vec_ok)
+            n = gp->set_vecs_in_slice(bp, first, last);
+        else
+            n = gp->set_elements_in_slice(bp, first, last);
+        assert(n == buf.get_size());
+    }
+
+    // Pack halo data for step 't' from grid 'gp' into shared-memory buffer
+    // 'buf' after the receiver has unpacked the previous data.
+    void StencilContext::send_shm_halo(YkGridPtr gp, MPIBuf& buf, idx_t t)
+    {
+        assert(buf.is_shm());
+        idx_t npacks = buf._shm_packs->load(std::memory_order_relaxed);
+        {
+            TRACE_EVENT("halo", "wait");
+            while (buf._shm_unpacks->load(std::memory_order_acquire) != npacks)
+                sched_yield();
+        }
+        {
+            TRACE_EVENT("halo", "pack");
+            pack_halo(gp, buf, t);
+        }
+        buf._shm_packs->store(npacks + 1, std::memory_order_release);
+    }
+
+    // Unpack halo data for step 't' into grid 'gp' from shared-memory
+    // buffer 'buf' after the sender has packed it.
+    void StencilContext::recv_shm_halo(YkGridPtr gp, MPIBuf& buf, idx_t t)
+    {
+        assert(buf.is_shm());
+        idx_t nunpacks = buf._shm_unpacks->load(std::memory_order_relaxed);
+        {
+            TRACE_EVENT("halo", "wait");
+            while (buf._shm_packs->load(std::memory_order_acquire) == nunpacks)
+                sched_yield();
+        }
+        {
+            TRACE_EVENT("halo", "unpack");
+            unpack_halo(gp, buf, t);
+        }
+        buf._shm_unpacks->store(nunpacks + 1, std::memory_order_release);
+    }
+
     // Mark grids that have been written to by bundle pack 'sel_bp'.
     // TODO: only mark grids that are written to in their halo-read area.
     // TODO: add index for misc dim(s).
@@ -1455,6 +4094,10 @@ namespace yask {
                 }
             }
         }
+
+        // Same grids in the batch.
+        for (auto& bc : _batch)
+            bc->mark_grids_dirty(get_batch_pack(*bc, sel_bp), start, stop);
     }
 
 } // namespace yask.
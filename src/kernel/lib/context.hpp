@@ -79,13 +79,92 @@ namespace yask {
         idx_t nsteps = 0;
         double run_time = 0.;
         double mpi_time = 0.;
+        double energy = 0.;
+        idx_t nblocks = 0;
+        idx_t nstolen = 0;
+
+        // HW counts for each section, in order.
+        std::vector<std::string> perf_names;
+        std::vector<std::string> perf_sections;
+        std::map<std::string, std::vector<idx_t>> perf_counts;
+
+        // Metrics from each rank, in rank order, and ranks in order of
+        // decreasing compute time.
+        std::vector<std::string> rank_metric_names;
+        std::map<std::string, std::vector<double>> rank_metrics;
+        std::vector<int> slowest_ranks;
+
+        // Time of each step, in order, and indices of outlier steps.
+        std::vector<double> step_secs;
+        std::vector<idx_t> step_outliers;
 
         Stats() {}
         virtual ~Stats() {}
 
         void clear() {
             npts = nwrites = nfpops = nsteps = 0;
-            run_time = mpi_time = 0.;
+            run_time = mpi_time = energy = 0.;
+            nblocks = nstolen = 0;
+            perf_names.clear();
+            perf_sections.clear();
+            perf_counts.clear();
+            rank_metric_names.clear();
+            rank_metrics.clear();
+            slowest_ranks.clear();
+            step_secs.clear();
+            step_outliers.clear();
+        }
+
+        // Get min, mean, max, and std-dev of 'vals'.
+        static void summarize(const std::vector<double>& vals,
+                              double& vmin, double& vmean, double& vmax, double& vsdev) {
+            vmin = vmean = vmax = vsdev = 0.;
+            if (vals.empty())
+                return;
+            vmin = vmax = vals[0];
+            double sum = 0., sum2 = 0.;
+            for (auto v : vals) {
+                vmin = std::min(vmin, v);
+                vmax = std::max(vmax, v);
+                sum += v;
+                sum2 += v * v;
+            }
+            vmean = sum / vals.size();
+            vsdev = sqrt(std::max(sum2 / vals.size() - vmean * vmean, 0.));
+        }
+
+        // Get the 'pct' percentile of 'sorted_vals', which must be in
+        // ascending order. Uses linear interpolation between ranks.
+        static double percentile(const std::vector<double>& sorted_vals, double pct) {
+            if (sorted_vals.empty())
+                return 0.;
+            double r = std::min(std::max(pct, 0.), 100.) / 100. * (sorted_vals.size() - 1);
+            size_t i = size_t(r);
+            if (i + 1 >= sorted_vals.size())
+                return sorted_vals.back();
+            return sorted_vals[i] + (r - i) * (sorted_vals[i + 1] - sorted_vals[i]);
+        }
+
+        // Get indices of the outliers in 'vals'. A value is an outlier if
+        // it is more than 3 scaled median-absolute-deviations above the
+        // median and also more than 10% above the median; the 2nd test
+        // keeps very steady runs from flagging tiny fluctuations.
+        static std::vector<idx_t> find_outliers(const std::vector<double>& vals) {
+            std::vector<idx_t> outliers;
+            if (vals.size() < 3)
+                return outliers;
+            std::vector<double> sorted(vals);
+            std::sort(sorted.begin(), sorted.end());
+            double med = percentile(sorted, 50.);
+            for (auto& v : sorted)
+                v = fabs(v - med);
+            std::sort(sorted.begin(), sorted.end());
+            double mad = 1.4826 * percentile(sorted, 50.);
+            double thresh = med + std::max(3. * mad, 0.1 * med);
+            for (size_t i = 0; i < vals.size(); i++)
+                if (vals[i] > thresh)
+                    outliers.push_back(idx_t(i));
+            return outliers;
         }
 
         // APIs.
@@ -110,6 +189,117 @@ namespace yask {
         virtual double
         get_elapsed_run_secs() { return run_time; }
 
+        /// Get the energy used during calls to run_solution().
+        virtual double
+        get_energy_joules() { return energy; }
+
+        /// Get the average energy used per step.
+        virtual double
+        get_joules_per_step() {
+            return (nsteps > 0) ? energy / nsteps : 0.;
+        }
+
+        /// Get the number of points calculated per joule.
+        virtual double
+        get_points_per_joule() {
+            return (energy > 0.) ? double(npts) * nsteps / energy : 0.;
+        }
+
+        /// Get the number of blocks done by the work-stealing scheduler.
+        virtual idx_t
+        get_num_blocks_done() { return nblocks; }
+
+        /// Get the number of blocks stolen from another thread.
+        virtual idx_t
+        get_num_blocks_stolen() { return nstolen; }
+
+        /// Get the number of hardware performance counters collected.
+        virtual int
+        get_num_perf_counters() { return int(perf_names.size()); }
+
+        /// Get the name of a hardware performance counter.
+        virtual std::string
+        get_perf_counter_name(int counter_idx) {
+            if (counter_idx < 0 || counter_idx >= get_num_perf_counters())
+                THROW_YASK_EXCEPTION("Error: get_perf_counter_name(): bad index " +
+                                     std::to_string(counter_idx));
+            return perf_names.at(counter_idx);
+        }
+
+        /// Get the names of the sections for which counts were collected.
+        virtual std::vector<std::string>
+        get_perf_section_names() { return perf_sections; }
+
+        /// Get a hardware performance count summed over all threads.
+        virtual idx_t
+        get_perf_count(const std::string& section_name, int counter_idx) {
+            if (perf_counts.count(section_name) == 0)
+                THROW_YASK_EXCEPTION("Error: get_perf_count(): no counts for '" +
+                                     section_name + "'");
+            if (counter_idx < 0 || counter_idx >= get_num_perf_counters())
+                THROW_YASK_EXCEPTION("Error: get_perf_count(): bad index " +
+                                     std::to_string(counter_idx));
+            return perf_counts.at(section_name).at(counter_idx);
+        }
+
+        /// Get the names of the metrics gathered from all ranks.
+        virtual std::vector<std::string>
+        get_rank_metric_names() { return rank_metric_names; }
+
+        /// Get the value of a metric on each rank.
+        virtual std::vector<double>
+        get_rank_metric_values(const std::string& metric_name) {
+            if (rank_metrics.count(metric_name) == 0)
+                THROW_YASK_EXCEPTION("Error: get_rank_metric_values(): no values for '" +
+                                     metric_name + "'");
+            return rank_metrics.at(metric_name);
+        }
+
+        /// Get statistics of a metric over all ranks.
+        virtual double
+        get_rank_metric_min(const std::string& metric_name) {
+            double vmin, vmean, vmax, vsdev;
+            summarize(get_rank_metric_values(metric_name), vmin, vmean, vmax, vsdev);
+            return vmin;
+        }
+        virtual double
+        get_rank_metric_mean(const std::string& metric_name) {
+            double vmin, vmean, vmax, vsdev;
+            summarize(get_rank_metric_values(metric_name), vmin, vmean, vmax, vsdev);
+            return vmean;
+        }
+        virtual double
+        get_rank_metric_max(const std::string& metric_name) {
+            double vmin, vmean, vmax, vsdev;
+            summarize(get_rank_metric_values(metric_name), vmin, vmean, vmax, vsdev);
+            return vmax;
+        }
+        virtual double
+        get_rank_metric_std_dev(const std::string& metric_name) {
+            double vmin, vmean, vmax, vsdev;
+            summarize(get_rank_metric_values(metric_name), vmin, vmean, vmax, vsdev);
+            return vsdev;
+        }
+
+        /// Get the ranks in order of decreasing compute time.
+        virtual std::vector<int>
+        get_slowest_ranks() { return slowest_ranks; }
+
+        /// Get the time of each step done via run_solution().
+        virtual std::vector<double>
+        get_step_secs() { return step_secs; }
+
+        /// Get a percentile of the step times.
+        virtual double
+        get_step_secs_percentile(double pct) {
+            std::vector<double> sorted(step_secs);
+            std::sort(sorted.begin(), sorted.end());
+            return percentile(sorted, pct);
+        }
+
+        /// Get the indices of the outlier steps.
+        virtual std::vector<idx_t>
+        get_step_outliers() { return step_outliers; }
     };
 
     // Collections of things in a context.
@@ -144,10 +334,17 @@ namespace yask {
         // MPI info.
         MPIInfoPtr _mpiInfo;
 
+        // Pool to get data buffers from, if any.
+        MemPoolPtr _mem_pool;
+
         // Bytes between each buffer to help avoid aliasing
         // in the HW.
         size_t _data_buf_pad = (YASK_PAD * CACHELINE_BYTES);
 
+        // Distance at which loads may falsely depend on stores and
+        // at which addresses map to the same set of most L1 caches.
+        static constexpr size_t _alias_bytes = 4096;
+
         // Check whether dim is appropriate type.
         virtual void checkDimType(const std::string& dim,
                                   const std::string& fn_name,
@@ -176,6 +373,10 @@ namespace yask {
         // If WFs are not used, this is the same as 'rank_bb';
         BoundingBox ext_bb;
 
+        // Blocks sampled by calc_rank_ref() in overall-domain indices.
+        // Empty if the whole domain was calculated.
+        BBList val_bbs;
+
         // List of all non-scratch stencil bundles in the order in which
         // they should be evaluated within a step.
         StencilBundleList stBundles;
@@ -205,10 +406,162 @@ namespace yask {
         IdxTuple max_halos;  // spatial halos.
         IdxTuple wf_angles;  // temporal skewing angles for each shift (in points).
         idx_t num_wf_shifts = 0; // number of shifts required.
+        idx_t deep_halo_steps = 1; // steps between halo exchanges w/o wave-fronts.
         IdxTuple wf_shifts;    // total shift needed (angles * num-shifts).
         IdxTuple left_wf_exts;    // WF extension needed on left side of rank.
         IdxTuple right_wf_exts;    // WF extension needed on right side of rank.
 
+        // Boundaries of the region being evaluated, saved by calc_region()
+        // for calc_block() when doing temporal tiling in blocks.  Only one
+        // block is evaluated at a time in this case, so there is only one
+        // copy.
+        struct BlockWF {
+            Indices start, stop; // region boundaries at first step in block.
+            idx_t shift_num = 0; // region shifts done before first step in block.
+        };
+        BlockWF _block_wf;
+
+        // Other solutions advanced in lock-step with this one by
+        // run_solution(). See add_batch_solution().
+        std::vector<std::shared_ptr<StencilContext>> _batch;
+
+        // Sparse points injected into or sampled from a grid after the
+        // last pack that writes it at each step. See add_sparse_points().
+        struct SparseOp {
+            YkGridPtr gp;
+            bool is_source = false;
+            idx_t num_points = 0;
+            BundlePackPtr bp;   // pack after which the op is applied.
+
+            // Taps as given by the user, w/one index per grid dim.
+            std::vector<Indices> tap_idxs;
+            std::vector<idx_t> tap_pts;
+            std::vector<real_t> tap_wts;
+
+            // Values for 'num_t' steps starting at 'first_t', stored as
+            // 'vals[(t - first_t) * num_points + point]'.
+            idx_t first_t = 0, num_t = 0;
+            std::vector<real_t> vals;
+
+            // Taps in this rank, set by prep_sparse_ops(): sources use
+            // taps anywhere in the allocation so redundant halo calcs
+            // see them; receivers use taps in the domain only so each tap
+            // is counted once. 'ptrs[s][i]' is the element of local tap
+            // 'i' in step slot 's'. Receiver taps are sorted by point;
+            // those of point 'p' are at ['pt_begin[p]', 'pt_begin[p+1]').
+            std::vector<idx_t> local_taps;
+            std::vector<std::vector<real_t*>> ptrs;
+            std::vector<idx_t> pt_begin;
+        };
+        std::vector<SparseOp> _sparse_ops;
+
+        // Values used by every call to run_solution() that depend only on
+        // settings, so repeated calls, e.g., one step at a time, do not
+        // rebuild them from tuples. Set by make_step_plan() and cleared
+        // when settings change.
+        struct StepPlan {
+            bool valid = false;
+            idx_t step_t = 0;       // region steps * step dir.
+            bool diamond = false;   // use calc_rank_diamond().
+            bool oblivious = false; // use calc_rank_oblivious().
+
+            // Rank-loop span in the stencil dims; step-dim values are
+            // set in each call. End includes any wave-front adjustment.
+            Indices begin, end;
+
+            // Steps to exchange in exchange_halos_all().
+            idx_t halo_begin_t = 0, halo_end_t = 1;
+        };
+        StepPlan _step_plan;
+
+        // Functions called at selected steps in run_solution().
+        // See add_step_callback().
+        struct StepCallback {
+            yk_step_callback fn;
+            idx_t first_t = 0, interval = 1;
+            GridPtrs read_gps, write_gps;
+            bool is_snapshot = false; // added by add_snapshot().
+            std::string output_key;   // added by add_decimated_output().
+
+            // Whether the callback accesses any grid, so that it must be
+            // called exactly at its step instead of after a wave-front.
+            bool is_exact() const {
+                return read_gps.size() || write_gps.size();
+            }
+
+            // Whether it is due after computing step 't' in direction 'dir'.
+            bool is_due(idx_t t, idx_t dir) const {
+                idx_t d = (t - first_t) * dir;
+                return d >= 0 && d % interval == 0;
+            }
+        };
+        std::vector<StepCallback> _step_callbacks;
+
+        // Slices of grids written in the background at selected steps.
+        // See add_snapshot().
+        struct Snapshot {
+            YkGridPtr gp;
+            Indices first, last;  // slice in this rank.
+            int step_posn = -1;   // posn of step dim in grid or -1.
+            size_t nbytes = 0;    // bytes in one copy of the slice.
+            std::string fname;
+            int fd = -1;
+            off_t file_ofs = 0;   // where next record will be written.
+
+            // Staging buffers used alternately.
+            std::shared_ptr<char> bufs[2];
+            idx_t buf_steps[2] = { 0, 0 };
+            bool buf_full[2] = { false, false }; // being written or waiting to be.
+            int next_buf = 0;     // next one to fill.
+
+            // Writer thread and vars shared with it.
+            std::thread writer;
+            std::mutex lock;      // protects the vars below and 'buf_full'.
+            std::condition_variable cv;
+            bool stop = false, failed = false;
+            idx_t nwritten = 0, nwaits = 0;
+
+            void copy_step(idx_t t);
+            void write_bufs();
+        };
+        std::vector<std::shared_ptr<Snapshot>> _snapshots;
+
+        // Compressed copies of grid slices kept in memory.
+        // See store_compressed_slice().
+        struct CompressedSlice {
+            std::string grid_name;
+            Indices first, last;
+            idx_t nelems = 0;
+            double max_error = 0.;
+            std::vector<std::vector<uint8_t>> chunks; // compressed elements.
+            std::vector<bool> is_lossy;               // whether each chunk was quantized.
+            size_t nbytes = 0;                        // sum of chunk sizes.
+        };
+        std::map<std::string, CompressedSlice> _compressed_slices;
+        size_t _compressed_bytes = 0;
+
+        // Decimated slices of grids collected at selected steps.
+        // See add_decimated_output().
+        struct DecimatedOutput {
+            YkGridPtr gp;
+            Indices first, last;  // decimated slice in this rank.
+            Indices strides;
+            int step_posn = -1;   // posn of step dim in grid or -1.
+            idx_t nelems = 0;     // elements in one record.
+            std::vector<real_t> data; // records collected so far.
+            std::vector<idx_t> steps; // step of each record.
+
+            void copy_step(idx_t t);
+        };
+        std::map<std::string, std::shared_ptr<DecimatedOutput>> _decimated_outputs;
+
+        // Widths of the 'shell' at the edges of the rank domain, i.e., the
+        // areas that are copied into MPI send buffers. When overlapping
+        // comms with computation, the shell is calculated before the halo
+        // exchange is started and the interior is calculated after.
+        IdxTuple left_shell_sizes;
+        IdxTuple right_shell_sizes;
+
         // Various amount-of-work metrics calculated in prepare_solution().
         // 'rank_' prefix indicates for this rank.
         // 'tot_' prefix indicates over all ranks.
@@ -228,11 +581,37 @@ namespace yask {
         // Elapsed-time tracking.
         YaskTimer run_time;     // time in run_solution(), including MPI.
         YaskTimer mpi_time;     // time spent just doing MPI.
+        YaskTimer wait_time;    // time spent waiting for halo data.
+        EnergyMeter run_energy; // energy used in run_solution().
+        PerfCounters halo_perf; // HW counts while doing MPI; calling thread only.
         idx_t steps_done = 0;   // number of steps that have been run.
+        std::vector<double> step_times; // time of each step if step_stats is set.
+        idx_t blocks_done = 0;  // blocks done by the work-stealing scheduler.
+        idx_t blocks_stolen = 0; // blocks taken from another thread's deque.
+
+        // CPU groups for binding block threads.
+        CpuTopology _topology;
+        bool _bind_threads = false;
+        int _bind_region_threads = 1, _bind_block_threads = 1;
+
+        // Blocks collected by calc_region() for the persistent team
+        // when '_collect_blocks' is set.
+        std::vector<ScanIndices> _team_blocks;
+        bool _collect_blocks = false;
         double domain_pts_ps = 0.; // points-per-sec in domain.
         double writes_ps = 0.;     // writes-per-sec.
         double flops = 0.;      // est. FLOPS.
 
+        // Compute time and steps in run_solution() since the last
+        // rank rebalancing.
+        double rebalance_secs = 0.;
+        idx_t rebalance_steps = 0;
+
+        // Roofline model.
+        double peak_bytes_ps = 0.; // mem bandwidth per rank.
+        double peak_flops = 0.;    // FP rate per rank.
+        double roofline_pts_ps = 0.; // predicted points-per-sec in domain.
+
         // MPI settings.
         // TODO: move to settings or MPI info object.
 #ifdef NO_VEC_EXCHANGE
@@ -250,6 +629,71 @@ namespace yask {
         // Map key: grid name.
         std::map<std::string, MPIData> mpiData;
 
+#ifdef USE_MPI
+        // Shared-memory window holding the send buffers for neighbors
+        // on the same node when using '-use_shm'.
+        MPI_Win _shm_win = MPI_WIN_NULL;
+#endif
+
+#ifdef USE_MPI
+        // State of a halo exchange that has been started by
+        // start_halo_exchange() but not yet completed by
+        // finish_halo_exchange(). Only one step can be in flight
+        // at a time because there is only one buffer per step.
+        struct HaloExchange {
+            bool active = false;
+            idx_t step = 0;
+            GridPtrMap grids;   // grids being exchanged.
+            std::vector<MPI_Request> send_reqs;
+            std::vector<MPI_Request> recv_reqs; // [grid idx * neighborhood_size + neigh idx],
+                                                // or [neigh idx] when combining halos.
+        };
+        HaloExchange _halo_exch;
+
+        // Threads that exchange halos while the OpenMP threads compute.
+        // Each exchange is handed to them by start_halo_exchange() and
+        // collected by finish_halo_exchange().
+        std::vector<std::thread> _progress_threads;
+        std::mutex _progress_lock; // protects the vars below.
+        std::condition_variable _progress_cv;
+        idx_t _progress_seq = 0; // number of exchanges handed out.
+        int _progress_busy = 0;  // threads still working on the current one.
+        bool _progress_stop = false;
+        std::mutex _mpi_lock;    // serializes MPI calls by the threads.
+#endif
+        int _num_progress_threads = 0;
+
+        // NUMA sub-domains: the first index of each slab in the first
+        // domain dim, the node holding its data and the CPUs of that
+        // node for its thread team. Empty if the rank is not split.
+        std::vector<idx_t> _numa_part_begins;
+        std::vector<int> _numa_part_nodes;
+        std::vector<std::vector<int>> _numa_part_cpus;
+
+        // Grid data read by each bundle pack: the range of read offsets
+        // from the point being calculated in each stencil dim of a grid
+        // and the constant index in each misc dim.
+        struct PrefetchArea {
+            YkGridPtr gp;
+            Indices lo, hi;
+        };
+        std::map<const BundlePack*, std::vector<PrefetchArea>> _prefetch_areas;
+
+        // Helper threads that prefetch the next block of each region
+        // thread from a sibling hyperthread. Each block is handed to
+        // the helper by calc_region_prefetching(); a newer block
+        // replaces one that has not been started.
+        struct PrefetchHelper {
+            std::thread thr;
+            std::mutex lock;    // protects the vars below.
+            std::condition_variable cv;
+            const std::vector<PrefetchArea>* areas = 0;
+            Indices begin, end; // block bounds in stencil dims.
+            int cpu = -1;       // CPU of the region thread.
+            bool ready = false, done = false;
+        };
+        std::vector<std::unique_ptr<PrefetchHelper>> _prefetch_helpers;
+
         // Auto-tuner state.
         class AT {
         protected:
@@ -268,29 +712,76 @@ namespace yask {
             double min_secs = 0.1; // eval when either min_steps or min_secs is reached.
             idx_t min_step = 4;
             idx_t max_radius = 64;
+            idx_t pruned_radius = 0; // if >0, starting radius for block and sub-block sizes.
             idx_t min_pts = 512; // 8^3.
             idx_t min_blks = 4;
 
-            // Results.
+            // Settings that are searched, in order.
+            // Each level is searched with the settings found
+            // in the previous levels.
+            enum Level { at_region, at_block, at_block_threads, at_sub_block,
+                         at_prefetch, at_loop_order, at_nlevels };
+            const idx_t max_pfd = 8; // max prefetch distance searched.
+            int level = at_block;
+
+            // Results for current level.
             std::map<IdxTuple, double> results;
             int n2big = 0, n2small = 0;
 
-            // Best so far.
-            IdxTuple best_block;
-            double best_rate = 0.;
+            // Best so far at current level.
+            // Score is steps/sec, steps/J, or their product,
+            // depending on the objective.
+            IdxTuple best_sizes;
+            double best_score = 0.;
+            bool use_energy = false; // whether score uses energy.
+            bool energy_warned = false;
 
             // Current point in search.
-            IdxTuple center_block;
+            IdxTuple center_sizes;
             idx_t radius = 0;
             bool done = false;
             idx_t neigh_idx = 0;
             bool better_neigh_found = false;
 
+            // Neighborhood of searched dims.
+            IdxTuple neigh_sizes;
+            idx_t neigh_size = 0;
+
             // Cumulative vars.
             double ctime = 0.;
+            double cjoules = 0.;
             idx_t csteps = 0;
             bool in_warmup = true;
 
+            // Name of a level for messages.
+            static const char* level_name(int lvl);
+
+            // Whether a level should be searched.
+            bool is_level_enabled(int lvl) const;
+
+            // Get and set the sizes searched at the current level.
+            IdxTuple get_level_sizes() const;
+            void set_level_sizes(const IdxTuple& sizes);
+
+            // Get the min and max sizes and the multiple
+            // to round sizes to for the current level.
+            void get_level_bounds(IdxTuple& mins, IdxTuple& maxes,
+                                  IdxTuple& mults) const;
+
+            // Start searching the current level from the current settings.
+            void start_level();
+
+            // Combine values over all ranks, so every rank sees the
+            // same measurements and bounds, makes the same decisions,
+            // and calls eval() in step with the others.
+            double max_over_ranks(double val) const;
+            double sum_over_ranks(double val) const;
+            void min_over_ranks(IdxTuple& vals) const;
+
+            // Lock for the MPI calls above while progress threads may be
+            // using MPI for a halo exchange still in flight.
+            std::unique_lock<std::mutex> lock_mpi() const;
+
         public:
             const idx_t max_step_t = 4;
 
@@ -301,13 +792,31 @@ namespace yask {
             void clear(bool mark_done, bool verbose = false);
 
             // Evaluate the previous run and take next auto-tuner step.
-            void eval(idx_t steps, double elapsed_time);
+            // 'joules' is used only if energy is part of the objective.
+            void eval(idx_t steps, double elapsed_time, double joules = 0.);
 
             // Apply settings.
             void apply();
 
             // Done?
             bool is_done() const { return done; }
+
+            // Start block and sub-block searches with radius 'r'
+            // instead of the max, e.g., near predicted sizes.
+            void set_pruned_radius(idx_t r) { pruned_radius = r; }
+
+            // Get the tuned settings as command-line options.
+            std::string get_settings_str() const;
+
+            // Write the tuned settings as command-line options.
+            void save(const std::string& fname) const;
+
+            // Tuning-database access.
+            // load_db() must be called on all ranks, and it succeeds
+            // only if every rank finds the settings.
+            std::string get_db_key() const;
+            bool load_db(const std::string& fname);
+            void save_db(const std::string& fname) const;
         };
         AT _at;
 
@@ -317,6 +826,18 @@ namespace yask {
 
         // Destructor.
         virtual ~StencilContext() {
+            stop_progress_threads();
+            stop_prefetch_helpers();
+            try {
+                finish_snapshots();
+            } catch (yask_exception& e) {
+                std::cerr << e.get_message() << std::endl;
+            }
+
+            // The bundles belong to the derived class and are already
+            // destroyed, so forget them before reporting.
+            stPacks.clear();
+            stBundles.clear();
 
             // Dump stats if get_stats() hasn't been called yet.
             if (steps_done)
@@ -333,11 +854,13 @@ namespace yask {
             return *_ostr;
         }
 
-        // Reset elapsed times to zero.
-        virtual void clear_timers() {
-            run_time.clear();
-            mpi_time.clear();
-            steps_done = 0;
+        // Reset elapsed times and HW counts to zero.
+        virtual void clear_timers();
+
+        // Whether energy is measured in run_solution().
+        bool is_energy_measured() const {
+            return _opts->measure_energy ||
+                (_opts->tune_objective != "rate" && !_at.is_done());
         }
 
         // Access to settings.
@@ -363,6 +886,10 @@ namespace yask {
             scratchVecs.push_back(&scratch_vec);
         }
 
+        // Choose the number of ranks in each dim and this rank's
+        // coordinates.
+        virtual void chooseRankLayout();
+
         // Set vars related to this rank's role in global problem.
         // Allocate MPI buffers as needed.
         virtual void setupRank();
@@ -371,16 +898,57 @@ namespace yask {
         // already have storage.
         virtual void allocGridData(std::ostream& os);
 
+        // Choose the NUMA node for each grid that will be allocated by
+        // allocGridData() and doesn't have its own preference when a
+        // limited high-bandwidth memory node is given.
+        // Returns a map from grid name to NUMA node.
+        virtual std::map<std::string, int> planHbmPlacement(std::ostream& os);
+
+        // Add padding to the unit-stride dim of each grid that will be
+        // allocated by allocGridData() so that the neighbors used by the
+        // stencils do not map to the same cache sets.
+        // Returns the distance to stagger the start of each grid in
+        // its buffer or zero if not enabled.
+        virtual size_t planGridPadding(std::ostream& os);
+
+        // Split the rank domain into the NUMA sub-domains requested by
+        // '-numa_parts' and choose a node for each one.
+        virtual void setupNumaParts(std::ostream& os);
+
+        // Move the data of 'grids' in each NUMA sub-domain to its node.
+        // Only grids whose storage is contiguous in each slab are moved.
+        virtual void moveGridsToNumaParts(const GridPtrs& grids, std::ostream& os);
+
         // Determine sizes of MPI buffers and allocate MPI buffer memory.
         // Dealloc any existing MPI buffers first.
         virtual void allocMpiData(std::ostream& os);
         virtual void freeMpiData(std::ostream& os) {
+#ifdef USE_MPI
+            for (auto& gmd : mpiData)
+                for (auto& nbufs : gmd.second.bufs)
+                    for (auto& buf : nbufs.bufs)
+                        if (buf._preq != MPI_REQUEST_NULL)
+                            MPI_Request_free(&buf._preq);
+#endif
             mpiData.clear();
+#ifdef USE_MPI
+            if (_shm_win != MPI_WIN_NULL)
+                MPI_Win_free(&_shm_win);
+#endif
         }
 
+        // Place the buffers for neighbors on the same node into a shared
+        // window. Called from allocMpiData().
+        virtual void allocShmData(std::ostream& os);
+
         // Alloc scratch-grid memory.
         // Dealloc any existing scratch-grids first.
         virtual void allocScratchData(std::ostream& os);
+
+        // Assign scratch-grid vecs with disjoint lifetimes to shared
+        // storage slots. Returns the number of slots.
+        virtual int find_scratch_slots(std::vector<int>& slots) const;
+
         virtual void freeScratchData(std::ostream& os) {
             makeScratchGrids(0);
         }
@@ -394,6 +962,35 @@ namespace yask {
         // Print info about the soln.
         virtual void print_info();
 
+        // Set the machine peaks for the roofline model,
+        // measuring them if not given.
+        virtual void measure_peaks();
+
+        // Predict throughput from the roofline model using the
+        // current settings. Sets 'roofline_pts_ps' and prints details.
+        virtual void predict_roofline(std::ostream& os);
+
+        // Get the dims of the region or block loops or, if 'sub_block'
+        // is set, of the sub-block loops in loop order 'order'.
+        std::string get_loop_order_str(int order, bool sub_block) const;
+
+        // Replay the accesses of one block through a model of the caches
+        // for candidate block and sub-block sizes, apply the sizes with the
+        // lowest predicted cost and narrow the auto-tuner around them.
+        // Implemented in cache_sim.cpp.
+        virtual void run_cache_sim();
+
+        // Replay the accesses of one block of the given sizes through
+        // 'caches'. Return the number of points calculated.
+        virtual idx_t sim_block(CacheHierarchy& caches,
+                                const IdxTuple& block_sizes,
+                                const IdxTuple& sub_block_sizes);
+
+        // Time 'nreps' halo exchanges of all grids without any
+        // calculation, then time the messages to each neighbor
+        // separately, and print the results. Must be called on all ranks.
+        virtual void bench_halo_exchange(int nreps);
+
         /// Get statistics associated with preceding calls to run_solution().
         /**
            Resets all timers and step counters.
@@ -404,6 +1001,13 @@ namespace yask {
         // Dealloc grids, etc.
         virtual void end_solution();
 
+        // Shift rank-domain boundaries to balance work.
+        virtual bool rebalance_ranks();
+
+        // Resize this rank's domain, moving grid data between ranks.
+        // All ranks at the same index in a dim must get the same size.
+        virtual void resize_rank_domain(const IdxTuple& sizes);
+
         // Set grid sizes and offsets.
         // This should be called anytime a setting or offset is changed.
         virtual void update_grid_info();
@@ -506,9 +1110,14 @@ namespace yask {
 
             // Limit outer nesting to allow num_block_threads per nested
             // block loop.
-            nt /= _opts->num_block_threads;
+            // With temporal tiling in blocks, the blocks must be done
+            // in order, so all the threads are used within each block.
+            if (_opts->is_block_time_tiling())
+                nt = 1;
+            else
+                nt /= _opts->num_block_threads;
             nt = std::max(nt, 1);
-            if (_opts->num_block_threads > 1)
+            if (_opts->num_block_threads > 1 || _opts->is_block_time_tiling())
                 omp_set_nested(1);
             else
                 omp_set_nested(0);
@@ -518,6 +1127,28 @@ namespace yask {
             return nt;
         }
 
+        // Bind the threads of the region team started by the calling
+        // thread to the CPUs given via '-cpus', if any. Each region
+        // thread gets its own slice of the CPUs, which is inherited by
+        // the nested block threads it starts. The calling thread keeps
+        // all the CPUs, so threads it starts later stay within them.
+        void bind_region_threads();
+
+        // Bind the calling block thread to a CPU that shares a cache
+        // with the other threads in its block team, if enabled.
+        void bind_block_thread() {
+            if (!_bind_threads)
+                return;
+            int level = omp_get_level();
+            int outer = omp_get_thread_num(), inner = 0, team_size = 1;
+            if (level >= 2) {
+                outer = omp_get_ancestor_thread_num(level - 1);
+                inner = omp_get_thread_num();
+                team_size = omp_get_num_threads();
+            }
+            _topology.bind_thread(_topology.get_cpu(outer, inner, team_size));
+        }
+
         // Set number of threads for a block.
         // Return number of threads.
         // Do nothing and return 0 if not properly initialized.
@@ -525,6 +1156,11 @@ namespace yask {
 
             // This should be a nested OMP region.
             int nt = _opts->num_block_threads;
+
+            // Use all threads when blocks are done in order.
+            // See set_region_threads().
+            if (_opts->is_block_time_tiling() && _opts->max_threads)
+                nt = _opts->max_threads / _opts->thread_divisor;
             nt = std::max(nt, 1);
             //TRACE_MSG("set_block_threads: omp_set_num_threads=" << nt);
             omp_set_num_threads(nt);
@@ -537,14 +1173,78 @@ namespace yask {
         // Vectorized and blocked stencil calculations.
         virtual void calc_rank_opt();
 
+        // Trim the span of a region to pack 'bp' at WF shift 'shift_num'.
+        virtual bool trim_region(const BundlePackPtr& bp,
+                                 const Indices& start, const Indices& stop,
+                                 idx_t shift_num,
+                                 ScanIndices& idxs) const;
+
+        // Run steps with one persistent thread team.
+        virtual void run_steps_in_team(idx_t begin_t, idx_t end_t, idx_t step_t,
+                                       ScanIndices& rank_idxs);
+
         // Calculate results within a region.
         virtual void calc_region(BundlePackPtr& sel_bp,
                                  const ScanIndices& rank_idxs);
 
-        // Calculate results within a block.
+        // Calculate results over the steps in 'rank_idxs'
+        // with diamond tiling instead of wave-fronts.
+        virtual void calc_rank_diamond(const ScanIndices& rank_idxs);
+
+        // Space-time trapezoid used by calc_rank_oblivious(). At WF shift
+        // 's' in [s0, s1), it covers [x0 + dx0 * (s - s0), x1 + dx1 * (s - s0))
+        // in each domain dim. Step-dim entries are not used.
+        struct Trapezoid {
+            idx_t s0 = 0, s1 = 0;
+            Indices x0, dx0, x1, dx1;
+        };
+
+        // Calculate results over the steps in 'rank_idxs' by recursive
+        // space-time cuts instead of regions and blocks.
+        virtual void calc_rank_oblivious(const ScanIndices& rank_idxs);
+        void calc_trapezoid(const Trapezoid& tz,
+                            const ScanIndices& rank_idxs,
+                            const Indices& min_widths);
+
+        // Calculate results in all the blocks of a region
+        // using work stealing between threads.
+        virtual void calc_region_stealing(BundlePackPtr& bp,
+                                          const ScanIndices& region_idxs);
+
+        // Calculate results in all the blocks of a region with one
+        // thread team per NUMA sub-domain.
+        virtual void calc_region_numa(BundlePackPtr& bp,
+                                      const ScanIndices& region_idxs);
+
+        // Calculate results in all the blocks of a region while
+        // helper threads prefetch each thread's next block.
+        virtual void calc_region_prefetching(BundlePackPtr& bp,
+                                             const ScanIndices& region_idxs);
+
+        // Prefetch helper threads.
+        virtual void prefetch_loop(int n);
+        virtual void prefetch_block(const std::vector<PrefetchArea>& areas,
+                                    const Indices& begin, const Indices& end);
+        virtual void start_prefetch_helpers(int nthreads);
+        virtual void stop_prefetch_helpers();
+
+        // Append the blocks in a region to 'blocks'.
+        virtual void find_region_blocks(const ScanIndices& region_idxs,
+                                        std::vector<ScanIndices>& blocks) const;
+
+        // Calculate results within a block in this solution and
+        // in each solution in its batch.
         virtual void calc_block(BundlePackPtr& sel_bp,
                                 const ScanIndices& region_idxs);
 
+        // Calculate results within a block in this solution only.
+        virtual void calc_block_one(BundlePackPtr& sel_bp,
+                                    const ScanIndices& region_idxs);
+
+        // Get the pack in batch solution 'bc' corresponding to 'bp'.
+        virtual BundlePackPtr get_batch_pack(const StencilContext& bc,
+                                             const BundlePackPtr& bp) const;
+
         // Exchange all dirty halo data for all stencil bundles
         // and max number of steps for each grid.
         virtual void exchange_halos_all();
@@ -554,11 +1254,71 @@ namespace yask {
         virtual void exchange_halos(const BundlePackPtr& sel_bp,
                                     idx_t start, idx_t stop);
 
+        // Post receives and pack and send halo data needed by bundle pack
+        // 'sel_bp' at step 't', but don't wait for completion.
+        // If sel_bp==null, check all bundles.
+        // Any previously-started exchange is finished first.
+        virtual void start_halo_exchange(const BundlePackPtr& sel_bp, idx_t t);
+
+        // Wait for the exchange started by start_halo_exchange()
+        // and unpack the received data. No-op if none is in flight.
+        virtual void finish_halo_exchange();
+
+        // Copy halo data for step 't' between grid 'gp' and MPI buffer 'buf'.
+        virtual void pack_halo(YkGridPtr gp, MPIBuf& buf, idx_t t);
+        virtual void unpack_halo(YkGridPtr gp, MPIBuf& buf, idx_t t);
+
+        // Post, or wait for and unpack, one part of the exchange
+        // set up by start_halo_exchange().
+        virtual void post_halo_exchange(int part, int nparts);
+        virtual void complete_halo_exchange(int part, int nparts);
+
+        // Halo-exchange progress threads.
+        virtual void progress_loop(int part, int nparts);
+        virtual void start_progress_threads(int nthreads);
+        virtual void stop_progress_threads();
+
+        // Pack into or unpack from buffer 'buf' in shared memory, waiting
+        // for the other rank to finish with it first.
+        virtual void send_shm_halo(YkGridPtr gp, MPIBuf& buf, idx_t t);
+        virtual void recv_shm_halo(YkGridPtr gp, MPIBuf& buf, idx_t t);
+
+        // Calculate 'sel_bp' over the rank domain in 'rank_idxs' with
+        // comm/compute overlap: calculate the shell, start the halo
+        // exchange, then calculate the interior.
+        virtual void calc_rank_overlapped(BundlePackPtr& sel_bp,
+                                          ScanIndices& rank_idxs);
+
+        // Find the local taps and their element pointers for each sparse
+        // op. Called at the start of run_solution() because storage and
+        // rank offsets may change between calls. Implemented in sparse.cpp.
+        virtual void prep_sparse_ops();
+
+        // Get sparse op 'op_id' or throw an exception naming 'fn'.
+        virtual SparseOp& get_sparse_op(int op_id, const std::string& fn);
+
+        // Apply the sparse ops that follow pack 'bp' at output step 't'.
+        virtual void apply_sparse_ops(const BundlePackPtr& bp, idx_t t);
+
+        // Set '_step_plan' from the current settings.
+        virtual void make_step_plan();
+
+        // Get the last step to compute in the range from 'start_t' to
+        // 'stop_t' so that no exact step callback falls inside it.
+        virtual idx_t limit_to_step_callbacks(idx_t start_t, idx_t stop_t) const;
+
+        // Call the step callbacks due after computing 'start_t' to 'stop_t'.
+        // Returns whether any of them wrote to grids.
+        virtual bool call_step_callbacks(idx_t start_t, idx_t stop_t);
+
         // Mark grids that have been written to by bundle pack 'sel_bp'.
         // If sel_bp==null, use all bundles.
         virtual void mark_grids_dirty(const BundlePackPtr& sel_bp,
                                       idx_t start, idx_t stop);
 
+        // Touch the pages of new grids from the threads that use them.
+        virtual void first_touch_grids(const GridPtrs& grids, std::ostream& os);
+
         // Set the bounding-box around all stencil bundles.
         virtual void find_bounding_boxes();
 
@@ -665,6 +1425,75 @@ namespace yask {
             run_solution(step_index, step_index);
         }
         virtual void share_grid_storage(yk_solution_ptr source);
+        virtual void add_batch_solution(yk_solution_ptr other);
+        virtual int add_sparse_points(const std::string& grid_name,
+                                      bool is_source,
+                                      idx_t num_points,
+                                      const std::vector<idx_t>& tap_points,
+                                      const std::vector<idx_t>& tap_indices,
+                                      const std::vector<double>& tap_weights);
+        virtual void set_sparse_steps(int op_id,
+                                      idx_t first_step_index,
+                                      idx_t last_step_index);
+        virtual void set_sparse_values(int op_id, const void* buffer_ptr);
+        virtual void get_sparse_values(int op_id, void* buffer_ptr);
+        virtual void add_step_callback(yk_step_callback callback,
+                                       idx_t first_step_index,
+                                       idx_t step_interval,
+                                       const std::vector<std::string>& read_grid_names,
+                                       const std::vector<std::string>& written_grid_names);
+        virtual void clear_step_callbacks() {
+            std::vector<StepCallback> cbs;
+            for (auto& cb : _step_callbacks)
+                if (cb.is_snapshot || cb.output_key.length())
+                    cbs.push_back(cb);
+            _step_callbacks.swap(cbs);
+        }
+        virtual void add_snapshot(const std::string& grid_name,
+                                  const std::vector<idx_t>& first_indices,
+                                  const std::vector<idx_t>& last_indices,
+                                  idx_t first_step_index,
+                                  idx_t step_interval,
+                                  const std::string& path);
+        virtual void finish_snapshots();
+        virtual idx_t store_compressed_slice(const std::string& key,
+                                             const std::string& grid_name,
+                                             const std::vector<idx_t>& first_indices,
+                                             const std::vector<idx_t>& last_indices,
+                                             double max_abs_error = 0.);
+        virtual idx_t restore_compressed_slice(const std::string& key,
+                                               const std::string& grid_name = "",
+                                               const std::vector<idx_t>& first_indices = {});
+        virtual void remove_compressed_slice(const std::string& key);
+        virtual idx_t get_compressed_slice_bytes() const {
+            return idx_t(_compressed_bytes);
+        }
+        virtual idx_t add_decimated_output(const std::string& key,
+                                           const std::string& grid_name,
+                                           const std::vector<idx_t>& first_indices,
+                                           const std::vector<idx_t>& last_indices,
+                                           const std::vector<idx_t>& strides,
+                                           idx_t first_step_index,
+                                           idx_t step_interval);
+        virtual std::vector<idx_t> get_decimated_output_steps(const std::string& key) const;
+        virtual std::vector<idx_t> get_decimated_output_first_indices(const std::string& key) const;
+        virtual std::vector<idx_t> get_decimated_output_last_indices(const std::string& key) const;
+        virtual idx_t get_decimated_output(const std::string& key,
+                                           void* buffer_ptr,
+                                           bool clear = true);
+        virtual void remove_decimated_output(const std::string& key);
+        virtual yk_reduction_ptr reduce_grid(const std::string& grid_name,
+                                             idx_t step_index = 0);
+        virtual yk_reduction_ptr reduce_grid_in_slice(const std::string& grid_name,
+                                                      const std::vector<idx_t>& first_indices,
+                                                      const std::vector<idx_t>& last_indices);
+        virtual void save_checkpoint(const std::string& path);
+        virtual void load_checkpoint(const std::string& path);
+
+        // Checkpoint helpers.
+        std::string get_checkpoint_file_name(const std::string& path) const;
+        std::string make_checkpoint_header(std::vector<size_t>& offsets) const;
+        void check_checkpoint_error(const std::string& fn, const std::string& msg);
 
         // APIs that access settings.
         virtual void set_rank_domain_size(const std::string& dim, idx_t size);
@@ -691,6 +1520,66 @@ namespace yask {
         virtual int get_default_numa_preferred() const {
             return _opts->_numa_pref;
         }
+        virtual void set_nt_stores(bool enable) {
+            _opts->nt_stores = enable;
+        }
+        virtual bool get_nt_stores() const {
+            return _opts->nt_stores;
+        }
+
+        // Whether generated code should use streaming stores now.
+        // Data written in one step is soon re-read when tiling in time,
+        // so keep it in cache then.
+        bool use_nt_stores() const {
+            return _opts->nt_stores && !_opts->is_time_tiling() &&
+                !_opts->is_block_time_tiling();
+        }
+
+        virtual void set_huge_pages(int policy) {
+            _opts->_huge_pages = policy;
+        }
+        virtual int get_huge_pages() const {
+            return _opts->_huge_pages;
+        }
+        virtual void set_mem_pool(yk_mem_pool_ptr pool) {
+            auto mp = std::dynamic_pointer_cast<MemPool>(pool);
+            if (pool && !mp)
+                THROW_YASK_EXCEPTION("Error: set_mem_pool() called with a pool "
+                                     "not created by yk_factory::new_mem_pool()");
+            _mem_pool = mp;
+        }
+        virtual yk_mem_pool_ptr get_mem_pool() const {
+            return _mem_pool;
+        }
+        virtual void set_cpus(const std::vector<int>& cpus) {
+            std::string list;
+            for (auto c : cpus) {
+                if (c < 0)
+                    THROW_YASK_EXCEPTION("Error: set_cpus() called with negative CPU " +
+                                         std::to_string(c));
+                if (list.length())
+                    list += ",";
+                list += std::to_string(c);
+            }
+            _opts->cpu_list = list;
+        }
+        virtual std::vector<int> get_cpus() const {
+            std::vector<int> cpus;
+            CpuTopology::parse_cpu_list(_opts->cpu_list, cpus);
+            return cpus;
+        }
+        virtual bool set_overlap_comms(bool enable) {
+#ifdef USE_MPI
+            _opts->overlap_comms = enable;
+            return true;
+#else
+            _opts->overlap_comms = false;
+            return !enable;
+#endif
+        }
+        virtual bool get_overlap_comms() const {
+            return _opts->overlap_comms;
+        }
 
         // Auto-tuner APIs.
         virtual void reset_auto_tuner(bool enable, bool verbose = false) {
@@ -0,0 +1,187 @@
+/*****************************************************************************
+
+YASK: Yet Another Stencil Kernel
+Copyright (c) 2014-2018, Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+
+*****************************************************************************/
+
+// This file contains implementations of StencilContext methods
+// for collecting decimated slices of grids during run_solution().
+
+// At each due step, a step callback appends every n-th element of the
+// slice to the stream's buffer with all threads, so only the kept
+// elements are ever read or copied.
+
+#include "yask_stencil.hpp"
+using namespace std;
+
+namespace yask {
+
+    // Append the slice at step 't' to the data.
+    void StencilContext::DecimatedOutput::copy_step(idx_t t) {
+        if (nelems) {
+            if (step_posn >= 0) {
+                first[step_posn] = t;
+                last[step_posn] = t;
+            }
+            size_t n = data.size();
+            data.resize(n + nelems);
+            gp->get_strided_elements_in_slice(&data[n], first, last, strides);
+        }
+        steps.push_back(t);
+    }
+
+    idx_t StencilContext::add_decimated_output(const string& key,
+                                               const string& grid_name,
+                                               const vector<idx_t>& first_indices,
+                                               const vector<idx_t>& last_indices,
+                                               const vector<idx_t>& strides,
+                                               idx_t first_step_index,
+                                               idx_t step_interval) {
+        ostream& os = get_ostr();
+        if (!rank_bb.bb_valid)
+            THROW_YASK_EXCEPTION("Error: add_decimated_output() called without calling prepare_solution() first");
+        auto gi = gridMap.find(grid_name);
+        if (gi == gridMap.end())
+            THROW_YASK_EXCEPTION("Error: add_decimated_output() called with unknown grid '" +
+                                 grid_name + "'");
+        auto gp = gi->second;
+        int ndims = gp->get_num_dims();
+        if (int(first_indices.size()) != ndims || int(last_indices.size()) != ndims ||
+            int(strides.size()) != ndims)
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: add_decimated_output() called with " <<
+                                            first_indices.size() << ", " <<
+                                            last_indices.size() << ", and " <<
+                                            strides.size() << " indices for grid '" <<
+                                            grid_name << "', which has " << ndims << " dim(s)");
+        remove_decimated_output(key);
+
+        // Limit the slice to this rank's domain, keeping only the
+        // elements at 'first_indices' plus a multiple of the stride.
+        auto dp = make_shared<DecimatedOutput>();
+        dp->gp = gp;
+        dp->first = Indices(first_indices);
+        dp->last = Indices(last_indices);
+        dp->strides = Indices(strides);
+        bool is_empty = false;
+        for (int i = 0; i < ndims; i++) {
+            auto& dname = gp->get_dim_name(i);
+            if (dname == _dims->_step_dim) {
+                dp->step_posn = i;
+                dp->first[i] = dp->last[i] = 0;
+                dp->strides[i] = 1;
+                continue;
+            }
+            auto stride = dp->strides[i];
+            if (stride < 1)
+                FORMAT_AND_THROW_YASK_EXCEPTION("Error: add_decimated_output() called with stride " <<
+                                                stride << " in dim '" << dname <<
+                                                "'; it must be positive");
+            if (_dims->_domain_dims.lookup(dname)) {
+                auto rfirst = gp->get_first_rank_domain_index(dname);
+                if (dp->first[i] < rfirst)
+                    dp->first[i] += CEIL_DIV(rfirst - dp->first[i], stride) * stride;
+                dp->last[i] = min(dp->last[i], gp->get_last_rank_domain_index(dname));
+            }
+            if (dp->last[i] < dp->first[i])
+                is_empty = true;
+            else
+                dp->last[i] -= (dp->last[i] - dp->first[i]) % stride;
+        }
+        if (!is_empty) {
+            dp->nelems = 1;
+            for (int i = 0; i < ndims; i++)
+                dp->nelems *= (dp->last[i] - dp->first[i]) / dp->strides[i] + 1;
+        }
+
+        // Collect at the due steps.
+        _decimated_outputs[key] = dp;
+        add_step_callback([dp](idx_t t) { dp->copy_step(t); },
+                          first_step_index, step_interval, { grid_name }, {});
+        _step_callbacks.back().output_key = key;
+        os << "Collecting " << dp->nelems << " element(s) from grid '" <<
+            grid_name << "' every " << step_interval << " step(s) as '" << key << "'.\n";
+        return dp->nelems;
+    }
+
+    vector<idx_t> StencilContext::get_decimated_output_steps(const string& key) const {
+        auto di = _decimated_outputs.find(key);
+        if (di == _decimated_outputs.end())
+            THROW_YASK_EXCEPTION("Error: get_decimated_output_steps() called with unknown key '" +
+                                 key + "'");
+        return di->second->steps;
+    }
+
+    vector<idx_t> StencilContext::get_decimated_output_first_indices(const string& key) const {
+        auto di = _decimated_outputs.find(key);
+        if (di == _decimated_outputs.end())
+            THROW_YASK_EXCEPTION("Error: get_decimated_output_first_indices() called with unknown key '" +
+                                 key + "'");
+        auto& idxs = di->second->first;
+        vector<idx_t> res;
+        for (int i = 0; i < idxs.getNumDims(); i++)
+            res.push_back(idxs[i]);
+        return res;
+    }
+
+    vector<idx_t> StencilContext::get_decimated_output_last_indices(const string& key) const {
+        auto di = _decimated_outputs.find(key);
+        if (di == _decimated_outputs.end())
+            THROW_YASK_EXCEPTION("Error: get_decimated_output_last_indices() called with unknown key '" +
+                                 key + "'");
+        auto& idxs = di->second->last;
+        vector<idx_t> res;
+        for (int i = 0; i < idxs.getNumDims(); i++)
+            res.push_back(idxs[i]);
+        return res;
+    }
+
+    idx_t StencilContext::get_decimated_output(const string& key,
+                                               void* buffer_ptr,
+                                               bool clear) {
+        auto di = _decimated_outputs.find(key);
+        if (di == _decimated_outputs.end())
+            THROW_YASK_EXCEPTION("Error: get_decimated_output() called with unknown key '" +
+                                 key + "'");
+        auto& dp = di->second;
+        idx_t n = dp->data.size();
+        if (n)
+            memcpy(buffer_ptr, dp->data.data(), n * sizeof(real_t));
+        if (clear) {
+            dp->data.clear();
+            dp->steps.clear();
+        }
+        return n;
+    }
+
+    void StencilContext::remove_decimated_output(const string& key) {
+        if (!_decimated_outputs.erase(key))
+            return;
+
+        // Remove the callback that refers to the stream.
+        vector<StepCallback> cbs;
+        for (auto& cb : _step_callbacks)
+            if (cb.output_key != key)
+                cbs.push_back(cb);
+        _step_callbacks.swap(cbs);
+    }
+
+} // namespace yask.
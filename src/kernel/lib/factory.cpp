@@ -24,6 +24,11 @@ IN THE SOFTWARE.
 *****************************************************************************/
 
 #include "yask_stencil.hpp"
+#include <dlfcn.h>
+#include <glob.h>
+#if defined(__aarch64__)
+#include <sys/auxv.h>
+#endif
 using namespace std;
 
 // Auto-generated stencil code that extends base types.
@@ -37,8 +42,36 @@ namespace yask {
     std::string yk_factory::get_version_string() {
         return yask_get_version_string();
     }
+    // Make sure the CPU can run the ISA this library was built for
+    // instead of failing later with an illegal instruction.
+    static void check_cpu_arch() {
+        bool ok = true;
+#if defined(__aarch64__)
+#if defined(USE_INTRIN512_SVE)
+        ok = (getauxval(AT_HWCAP) & HWCAP_SVE) != 0;
+#endif
+#elif defined(__GNUC__) && !defined(ARCH_KNC)
+        __builtin_cpu_init();
+#if defined(ARCH_KNL)
+        ok = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512er");
+#elif defined(ARCH_SKX) || defined(ARCH_SKL)
+        ok = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#elif defined(ARCH_HSW) || defined(ARCH_BDW)
+        ok = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(ARCH_SNB) || defined(ARCH_IVB)
+        ok = __builtin_cpu_supports("avx");
+#endif
+#endif
+        if (!ok)
+            THROW_YASK_EXCEPTION("Error: this CPU does not support the instructions used by "
+                                 "this YASK kernel library, which was built with arch='"
+                                 YK_ARCH "'; use a library built for an older arch "
+                                 "or 'yask.sh -arch auto'");
+    }
+
     yk_solution_ptr yk_factory::new_solution(yk_env_ptr env,
                                              const yk_solution_ptr source) const {
+        check_cpu_arch();
         auto ep = dynamic_pointer_cast<KernelEnv>(env);
         assert(ep);
         auto dp = YASK_STENCIL_CONTEXT::new_dims(); // create Dims.
@@ -63,11 +96,203 @@ namespace yask {
         // If no source, init settings from default args.
         if (!source.get())
             sp->apply_command_line_options(DEF_ARGS);
+        else
+            sp->set_mem_pool(source->get_mem_pool());
 
         return sp;
     }
+    yk_mem_pool_ptr yk_factory::new_mem_pool() const {
+        return make_shared<MemPool>();
+    }
     yk_solution_ptr yk_factory::new_solution(yk_env_ptr env) const {
         return new_solution(env, nullptr);
     }
 
+    static yk_solution_ptr new_lib_solution(yk_env_ptr env,
+                                            const string& lib);
+    static bool is_lib_loaded(const string& lib);
+
+    // Quote 's' for use as one word in a shell command.
+    static string shell_quote(const string& s) {
+        string res = "'";
+        for (char c : s) {
+            if (c == '\'')
+                res += "'\\''";
+            else
+                res += c;
+        }
+        return res + "'";
+    }
+
+    // 64-bit FNV-1a hash of 's' as a hex string.
+    static string hash_str(const string& s) {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (unsigned char c : s) {
+            h ^= c;
+            h *= 0x100000001b3ULL;
+        }
+        ostringstream oss;
+        oss << hex << setw(16) << setfill('0') << h;
+        return oss.str();
+    }
+
+    yk_solution_ptr yk_factory::new_jit_solution(yk_env_ptr env,
+                                                 const string& code_file,
+                                                 const string& name,
+                                                 const string& make_args) const {
+        auto ep = dynamic_pointer_cast<KernelEnv>(env);
+        assert(ep);
+        if (name.empty() || name.find_first_not_of("abcdefghijklmnopqrstuvwxyz"
+                                                   "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                                   "0123456789_") != string::npos)
+            THROW_YASK_EXCEPTION("Error: JIT solution name '" + name +
+                                 "' may contain only letters, digits, and underscores");
+        char* code_path = realpath(code_file.c_str(), NULL);
+        if (!code_path)
+            THROW_YASK_EXCEPTION("Error: cannot find stencil-code file '" + code_file + "'");
+        string code(code_path);
+        free(code_path);
+
+        // The make args are passed to the shell as separate words, so
+        // only allow chars that need no quoting.
+        if (make_args.find_first_not_of("abcdefghijklmnopqrstuvwxyz"
+                                        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                        "0123456789_-=+.,:/@% ") != string::npos)
+            THROW_YASK_EXCEPTION("Error: JIT make args '" + make_args +
+                                 "' may contain only letters, digits, spaces, and '_-=+.,:/@%'");
+
+        // The library name includes a hash of the code and make args,
+        // so a solution with the same name but different code gets its
+        // own library instead of the one already loaded.
+        ifstream ifs(code);
+        ostringstream code_text;
+        code_text << ifs.rdbuf();
+        if (!ifs)
+            THROW_YASK_EXCEPTION("Error: cannot read stencil-code file '" + code + "'");
+        string lib = string(YK_LIB_OUT_DIR) + "/libyask_kernel." + name + "." +
+            hash_str(code_text.str() + '\0' + make_args) + ".jit.so";
+
+        // Build the library on one rank unless it is already loaded.
+        const char* kdir = getenv("YASK_KERNEL_DIR");
+        string cmd = "make -C " + shell_quote(kdir ? kdir : YK_SRC_DIR) + " " +
+            YK_JIT_MAKE_ARGS " " + make_args + " stencil=" + name +
+            " jit_code=" + shell_quote(code) + " YK_LIB=" + shell_quote(lib) +
+            " jit-lib 2>&1";
+        int status = 0;
+        string out;
+        if (ep->my_rank == 0 && !is_lib_loaded(lib)) {
+            FILE* fp = popen(cmd.c_str(), "r");
+            if (!fp)
+                status = -1;
+            else {
+                char buf[256];
+                while (fgets(buf, sizeof(buf), fp))
+                    out += buf;
+                status = pclose(fp);
+            }
+        }
+#ifdef USE_MPI
+        MPI_Bcast(&status, 1, MPI_INT, 0, ep->comm);
+#endif
+        if (status != 0) {
+            const size_t max_out = 4000;
+            if (out.length() > max_out)
+                out = "..." + out.substr(out.length() - max_out);
+            THROW_YASK_EXCEPTION("Error: cannot build JIT kernel library with '" + cmd +
+                                 "':\n" + out);
+        }
+
+        // Load the library and create a solution with its factory.
+        return new_lib_solution(env, lib);
+    }
+
+    // Create a solution with the factory in the kernel library 'lib',
+    // loading it if needed. The library must have been linked with
+    // '-Bsymbolic' so that it uses its own code.
+    typedef void (*new_soln_fn)(yk_env_ptr*, yk_solution_ptr*);
+    static map<string, new_soln_fn> fns; // factory in each loaded lib.
+    static mutex fns_lock;
+    static bool is_lib_loaded(const string& lib) {
+        lock_guard<mutex> lk(fns_lock);
+        return fns.count(lib) > 0;
+    }
+    static yk_solution_ptr new_lib_solution(yk_env_ptr env,
+                                            const string& lib) {
+        new_soln_fn fn = 0;
+        {
+            lock_guard<mutex> lk(fns_lock);
+            if (fns.count(lib))
+                fn = fns.at(lib);
+            else {
+                void* handle = dlopen(lib.c_str(), RTLD_NOW | RTLD_LOCAL);
+                if (!handle)
+                    THROW_YASK_EXCEPTION(string("Error: cannot load kernel library: ") + dlerror());
+                fn = (new_soln_fn)dlsym(handle, "yask_jit_new_solution");
+                if (!fn)
+                    THROW_YASK_EXCEPTION("Error: cannot find the solution factory in '" + lib + "'");
+                fns[lib] = fn;
+            }
+        }
+        yk_solution_ptr sp;
+        fn(&env, &sp);
+        return sp;
+    }
+
+    // Dir containing this library, or the one it was built in if
+    // it cannot be found.
+    static string get_lib_dir() {
+        Dl_info info;
+        if (dladdr((void*)&check_cpu_arch, &info) && info.dli_fname) {
+            string fname(info.dli_fname);
+            auto sp = fname.rfind('/');
+            if (sp != string::npos)
+                return fname.substr(0, sp);
+        }
+        return YK_LIB_OUT_DIR;
+    }
+
+    // Kernel libraries are named 'libyask_kernel.<stencil>.<arch>.so'.
+    static const string lib_prefix = "libyask_kernel.";
+    static const string lib_suffix = string(".") + YK_ARCH + ".so";
+
+    yk_solution_ptr yk_factory::new_named_solution(yk_env_ptr env,
+                                                   const string& name) const {
+        if (name == YK_STENCIL)
+            return new_solution(env);
+        if (name.empty() || name.find('/') != string::npos)
+            THROW_YASK_EXCEPTION("Error: invalid stencil name '" + name + "'");
+        string lib = get_lib_dir() + "/" + lib_prefix + name + lib_suffix;
+        if (access(lib.c_str(), R_OK) != 0)
+            THROW_YASK_EXCEPTION("Error: no kernel library for stencil '" + name +
+                                 "' and arch '" YK_ARCH "'; expected '" + lib + "'");
+        return new_lib_solution(env, lib);
+    }
+
+    vector<string> yk_factory::get_solution_names() const {
+        set<string> names;
+        names.insert(YK_STENCIL);
+        string pat = get_lib_dir() + "/" + lib_prefix + "*" + lib_suffix;
+        glob_t gl;
+        if (glob(pat.c_str(), 0, NULL, &gl) == 0) {
+            for (size_t i = 0; i < gl.gl_pathc; i++) {
+                string fname(gl.gl_pathv[i]);
+                fname = fname.substr(fname.rfind('/') + 1);
+                names.insert(fname.substr(lib_prefix.length(),
+                                          fname.length() - lib_prefix.length() -
+                                          lib_suffix.length()));
+            }
+        }
+        globfree(&gl);
+        return vector<string>(names.begin(), names.end());
+    }
+
 } // namespace yask.
+
+// Entry point used by yk_factory::new_jit_solution() and
+// yk_factory::new_named_solution() to create a solution from a library
+// loaded at run-time.
+extern "C" void yask_jit_new_solution(yask::yk_env_ptr* env,
+                                      yask::yk_solution_ptr* soln) {
+    yask::yk_factory kfac;
+    *soln = kfac.new_solution(*env);
+}
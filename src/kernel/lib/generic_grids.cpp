@@ -37,8 +37,9 @@ namespace yask {
         _name(name), _layout_base(&layout_base), _opts(settings), _ostr(ostr) {
         for (auto& dn : dimNames)
             _dims.addDimBack(dn, 1);
-        _sync_layout_with_dims();
 
+        // The layout is synced by the derived class after
+        // 'layout_base' is constructed.
     }
 
     // Perform default allocation.
@@ -64,8 +65,11 @@ namespace yask {
         else
             os << " on local NUMA node";
 #endif
+        int huge_pages = (*_opts)->_huge_pages;
+        if (huge_pages != yask_huge_pages_none)
+            os << " using huge-page policy " << huge_pages;
         os << "...\n" << flush;
-        _base = shared_numa_alloc<char>(sz, numa_pref);
+        _base = shared_numa_alloc<char>(sz, numa_pref, huge_pages);
 
         // No offset.
         _elems = _base.get();
@@ -119,8 +123,9 @@ namespace yask {
     void GenericGridTemplate<T>::set_elems_same(T val) {
             if (_elems) {
 
-#pragma omp parallel for
-                for (idx_t ai = 0; ai < get_num_elems(); ai++)
+                auto n = get_num_elems();
+#pragma omp parallel for schedule(static) proc_bind(spread)
+                for (idx_t ai = 0; ai < n; ai++)
                     ((T*)_elems)[ai] = val;
             }
         }
@@ -130,10 +135,16 @@ namespace yask {
             if (_elems) {
                 const idx_t wrap = 71; // TODO: avoid multiple of any dim size.
 
+                // Set each run of 'wrap' elements in one pass w/o a mod.
                 auto n = get_num_elems();
-#pragma omp parallel for
-                for (idx_t ai = 0; ai < n; ai++)
-                    ((T*)_elems)[ai] = seed * T(ai % wrap + 1);
+                idx_t nruns = CEIL_DIV(n, wrap);
+#pragma omp parallel for schedule(static) proc_bind(spread)
+                for (idx_t ri = 0; ri < nruns; ri++) {
+                    idx_t a0 = ri * wrap;
+                    idx_t na = std::min(wrap, n - a0);
+                    for (idx_t i = 0; i < na; i++)
+                        ((T*)_elems)[a0 + i] = seed * T(i + 1);
+                }
             }
         }
 
@@ -165,5 +176,7 @@ namespace yask {
     // Explicitly allowed instantiations.
     template class GenericGridTemplate<real_t>;
     template class GenericGridTemplate<real_vec_t>;
+    template class GenericGridTemplate<real_vec_bf16_t>;
+    template class GenericGridTemplate<real_vec_fp16_t>;
 
 } // yask namespace.
@@ -97,6 +97,9 @@ namespace yask {
             return (_numa_pref != _numa_unset) ?
                 _numa_pref : (*_opts)->_numa_pref;
         }
+        virtual bool is_numa_pref_set() const {
+            return _numa_pref != _numa_unset;
+        }
         virtual bool set_numa_pref(int numa_node) {
 #ifdef USE_NUMA
             _numa_pref = numa_node;
@@ -118,8 +121,9 @@ namespace yask {
         }
 
         // Get number of elements.
+        // May be more than the product of the sizes for bricked layouts.
         virtual idx_t get_num_elems() const {
-            return _dims.product();
+            return _layout_base->get_num_elements();
         }
 
         // Get size of one element.
@@ -162,6 +166,14 @@ namespace yask {
             _sync_layout_with_dims();
         }
 
+        // Access brick sizes of the layout.
+        bool is_bricked() const {
+            return _layout_base->is_bricked();
+        }
+        void set_brick_sizes(const Indices& bsizes) {
+            _layout_base->set_brick_sizes(bsizes);
+        }
+
         // Return 'true' if dimensions are same names
         // and sizes, 'false' otherwise.
         inline bool are_dims_and_sizes_same(const GenericGridBase& src) {
@@ -288,6 +300,7 @@ namespace yask {
                     std::ostream** ostr) :
             GenericGridTemplate<T>(name, _layout, dimNames, settings, ostr) {
             assert(int(dimNames.size()) == _layout.get_num_sizes());
+            this->_sync_layout_with_dims();
         }
 
         // Get number of dims.
@@ -56,9 +56,11 @@ namespace yask {
     GET_GRID_API(get_right_halo_size, _right_halos[posn], false, true, false, false)
     GET_GRID_API(get_first_misc_index, _offsets[posn], false, false, true, false)
     GET_GRID_API(get_last_misc_index, _offsets[posn] + _domains[posn] - 1, false, false, true, false)
+    GET_GRID_API(get_brick_size, _vec_brick_sizes[posn] * _vec_lens[posn], false, true, false, false)
     GET_GRID_API(get_left_extra_pad_size, _actl_left_pads[posn] - _left_halos[posn], false, true, false, false)
     GET_GRID_API(get_right_extra_pad_size, _actl_right_pads[posn] - _right_halos[posn], false, true, false, false)
     GET_GRID_API(get_alloc_size, _allocs[posn], true, true, true, false)
+    GET_GRID_API(get_fold_len, _vec_lens[posn], true, true, true, false)
     GET_GRID_API(get_first_rank_domain_index, _offsets[posn], false, true, false, true)
     GET_GRID_API(get_last_rank_domain_index, _offsets[posn] + _domains[posn] - 1, false, true, false, true)
     GET_GRID_API(get_first_rank_halo_index, _offsets[posn] - _left_halos[posn], false, false, true, true)
@@ -116,9 +118,35 @@ namespace yask {
     SET_GRID_API(set_extra_pad_size, set_left_extra_pad_size(posn, n);
                  set_right_extra_pad_size(posn, n), false, true, false)
     SET_GRID_API(set_first_misc_index, _offsets[posn] = n, false, false, true)
+    SET_GRID_API(set_brick_size, _set_brick_size(posn, n), false, true, false)
 #undef COMMA
 #undef SET_GRID_API
 
+    // Set the size of the storage bricks in one dim.
+    void YkGridBase::_set_brick_size(int posn, idx_t n) {
+        if (n == get_brick_size(posn))
+            return;
+        if (is_storage_allocated())
+            THROW_YASK_EXCEPTION("Error: attempt to change brick size of grid '" +
+                                 get_name() + "' after storage has been allocated");
+        if (!is_bricked())
+            THROW_YASK_EXCEPTION("Error: cannot set brick size of grid '" + get_name() +
+                                 "' because it does not have a bricked layout; "
+                                 "use the stencil compiler's '-brick-grids' option to select one");
+        auto vl = _vec_lens[posn];
+        idx_t nv = n / vl;
+        if (n <= 0 || n % vl != 0 || (nv & (nv - 1)) != 0) {
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: brick size " << n << " in '" <<
+                                            get_dim_name(posn) << "' dimension of grid '" <<
+                                            get_name() << "' is not a power-of-two multiple of "
+                                            "the vector length " << vl);
+        }
+        _vec_brick_sizes[posn] = nv;
+        _ggb->set_brick_sizes(_vec_brick_sizes);
+        TRACE_MSG0(get_ostr(), "grid '" << get_name() << "' has bricks of " <<
+                   makeIndexString(_vec_brick_sizes.mulElements(_vec_lens), " * "));
+    }
+
     bool YkGridBase::is_storage_layout_identical(const yk_grid_ptr other) const {
         auto op = dynamic_pointer_cast<YkGridBase>(other);
         assert(op);
@@ -127,6 +155,11 @@ namespace yask {
         if (get_num_storage_bytes() != op->get_num_storage_bytes())
             return false;
 
+        // Same bricks?
+        if (is_bricked() != op->is_bricked() ||
+            _vec_brick_sizes != op->_vec_brick_sizes)
+            return false;
+
         // Same dims?
         if (get_num_dims() != op->get_num_dims())
             return false;
@@ -148,6 +181,65 @@ namespace yask {
         return true;
     }
 
+    idx_t YkGridBase::get_raw_storage_stride(const string& dim) const {
+        int posn = get_dim_posn(dim, true, "get_raw_storage_stride");
+        if (!is_storage_allocated())
+            return 0;
+
+        // Folded vectors and bricks are not simply strided.
+        if (_vec_lens.product() > 1 || is_bricked())
+            return 0;
+        if (_allocs[posn] <= 1)
+            return 1;
+
+        // Compare addresses of first allocated element and its
+        // neighbor in 'dim'.
+        auto n = get_num_dims();
+        Indices idxs0(n), idxs1(n);
+        for (int i = 0; i < n; i++)
+            idxs0[i] = _get_first_alloc_index(i);
+        idxs1 = idxs0;
+        idxs1[posn]++;
+        auto p0 = (const char*)getElemAddr(idxs0, get_alloc_step_index(idxs0), false);
+        auto p1 = (const char*)getElemAddr(idxs1, get_alloc_step_index(idxs1), false);
+        return idx_t(p1 - p0) / idx_t(_ggb->get_elem_bytes());
+    }
+
+    idx_t YkGridBase::get_raw_storage_offset(const Indices& indices) const {
+        if (!is_storage_allocated()) {
+            THROW_YASK_EXCEPTION("Error: call to 'get_raw_storage_offset' with no data allocated for grid '" +
+                                 get_name() + "'");
+        }
+        checkIndices(indices, "get_raw_storage_offset", true, false);
+        idx_t asi = get_alloc_step_index(indices);
+        auto p = (const char*)getElemAddr(indices, asi);
+        size_t ebytes = _ggb->get_elem_bytes() / _vec_lens.product();
+        return idx_t(p - (const char*)_ggb->get_storage()) / ebytes;
+    }
+
+    void YkGridBase::use_external_storage(void* buffer_ptr, idx_t num_bytes) {
+        if (!buffer_ptr)
+            THROW_YASK_EXCEPTION("Error: use_external_storage() called with NULL buffer for grid '" +
+                                 get_name() + "'");
+        if (uintptr_t(buffer_ptr) % CACHELINE_BYTES != 0) {
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: use_external_storage() called with buffer at " <<
+                                            buffer_ptr << " that is not aligned to " <<
+                                            CACHELINE_BYTES << " bytes for grid '" << get_name() << "'");
+        }
+        if (num_bytes < get_num_storage_bytes()) {
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: use_external_storage() called with buffer of " <<
+                                            makeByteStr(num_bytes) << ", but grid '" << get_name() <<
+                                            "' requires " << makeByteStr(get_num_storage_bytes()));
+        }
+
+        // Wrap buffer w/o taking ownership.
+        shared_ptr<char> base((char*)buffer_ptr, [](char*) { });
+        release_storage();
+        set_storage(base, 0);
+        set_dirty_all(true);
+        get_ostr() << make_info_string() << endl;
+    }
+
     void YkGridBase::share_storage(yk_grid_ptr source) {
         auto sp = dynamic_pointer_cast<YkGridBase>(source);
         assert(sp);
@@ -235,12 +327,13 @@ namespace yask {
             }
         }
 
-        // Copy data.
+        // Copy data, including any brick sizes in the layout.
         release_storage();
         resize();
         if (!share_data(sp.get(), true)) {
             THROW_YASK_EXCEPTION("Error: unexpected failure in data sharing");
         }
+        _vec_brick_sizes = sp->_vec_brick_sizes;
     }
 
     // API get, set, etc.
@@ -53,6 +53,18 @@ namespace yask {
 #define VEC_ELEMS 16
 #define INAME(op) _mm512_ ## op ## _ps
 #define INAMEI(op) _mm512_ ## op ## _epi32
+#elif defined(USE_INTRIN128_NEON)
+    const idx_t vec_elems = 4;
+    typedef float imem_t;
+    typedef uidx_t real_mask_t;
+#define VEC_ELEMS 4
+#define INAME(op) arm_ ## op
+#elif defined(USE_INTRIN512_SVE)
+    const idx_t vec_elems = 16;
+    typedef float imem_t;
+    typedef uidx_t real_mask_t;
+#define VEC_ELEMS 16
+#define INAME(op) arm_ ## op
 #endif
 
     // values for 64-bit, double-precision reals.
@@ -74,6 +86,18 @@ namespace yask {
 #define VEC_ELEMS 8
 #define INAME(op) _mm512_ ## op ## _pd
 #define INAMEI(op) _mm512_ ## op ## _epi64
+#elif defined(USE_INTRIN128_NEON)
+    const idx_t vec_elems = 2;
+    typedef double imem_t;
+    typedef uidx_t real_mask_t;
+#define VEC_ELEMS 2
+#define INAME(op) arm_ ## op
+#elif defined(USE_INTRIN512_SVE)
+    const idx_t vec_elems = 8;
+    typedef double imem_t;
+    typedef uidx_t real_mask_t;
+#define VEC_ELEMS 8
+#define INAME(op) arm_ ## op
 #endif
 
 #else
@@ -81,14 +105,14 @@ namespace yask {
 #endif
 
     // Emulate instrinsics for unsupported VLEN.
-    // Only 256 and 512-bit vectors supported.
+    // Only 128 (ARM), 256 and 512-bit vectors supported.
     // VLEN == 1 also supported as scalar.
 #if VLEN == 1
 #define NO_INTRINSICS
     // note: no warning here because intrinsics aren't wanted in this case.
 
 #elif !defined(INAME)
-#warning "Emulating intrinsics because HW vector length not defined; check setting of USE_INTRIN256 or USE_INTRIN512 in kernel Makefile"
+#warning "Emulating intrinsics because HW vector length not defined; check setting of USE_INTRIN* in kernel Makefile"
 #define NO_INTRINSICS
 
 #elif VLEN != VEC_ELEMS
@@ -114,9 +138,18 @@ namespace yask {
 #endif
 
     // fence needed before loads after streaming stores.
-    inline void make_stores_visible() {
-#if defined(USE_STREAMING_STORE)
+    // Set 'nt_stores_used' if storeTo_nt() may have been called.
+    inline void make_stores_visible(bool nt_stores_used = false) {
+#if defined(__aarch64__)
+#if !defined(USE_STREAMING_STORE)
+        if (nt_stores_used)
+#endif
+            __sync_synchronize();
+#elif defined(USE_STREAMING_STORE)
         _mm_mfence();
+#elif !defined(ARCH_KNC)
+        if (nt_stores_used)
+            _mm_sfence();
 #endif
     }
 
@@ -127,6 +160,190 @@ namespace yask {
 #define ALWAYS_INLINE __attribute__((always_inline)) inline
 #endif
 
+#if !defined(NO_INTRINSICS) && (defined(USE_INTRIN128_NEON) || defined(USE_INTRIN512_SVE))
+#define USE_INTRIN_ARM
+
+    // ARM SIMD types and wrappers w/the x86-style names used via INAME().
+    // ANAME*() macros add the type suffix to an ARM intrinsic name.
+#if defined(USE_INTRIN128_NEON)
+#if REAL_BYTES == 4
+    typedef float32x4_t arm_vec_t;
+    typedef uint32x4_t arm_ivec_t;
+#define ANAME(op) op ## _f32
+#define ANAMEI(op) op ## _u32
+#define ANAME_FROM_U8(v) vreinterpretq_f32_u8(v)
+    alignas(16) static const ctrl_t arm_lane_bits[VLEN] = { 1, 2, 4, 8 };
+#else
+    typedef float64x2_t arm_vec_t;
+    typedef uint64x2_t arm_ivec_t;
+#define ANAME(op) op ## _f64
+#define ANAMEI(op) op ## _u64
+#define ANAME_FROM_U8(v) vreinterpretq_f64_u8(v)
+    alignas(16) static const ctrl_t arm_lane_bits[VLEN] = { 1, 2 };
+#endif
+
+    ALWAYS_INLINE arm_vec_t arm_set1(real_t v) {
+        return ANAME(vdupq_n)(v);
+    }
+    ALWAYS_INLINE arm_vec_t arm_setzero() {
+        return ANAME(vdupq_n)(real_t(0));
+    }
+    ALWAYS_INLINE arm_vec_t arm_add(arm_vec_t a, arm_vec_t b) {
+        return ANAME(vaddq)(a, b);
+    }
+    ALWAYS_INLINE arm_vec_t arm_sub(arm_vec_t a, arm_vec_t b) {
+        return ANAME(vsubq)(a, b);
+    }
+    ALWAYS_INLINE arm_vec_t arm_mul(arm_vec_t a, arm_vec_t b) {
+        return ANAME(vmulq)(a, b);
+    }
+    ALWAYS_INLINE arm_vec_t arm_div(arm_vec_t a, arm_vec_t b) {
+        return ANAME(vdivq)(a, b);
+    }
+    ALWAYS_INLINE arm_vec_t arm_load(imem_t const* p) {
+        return ANAME(vld1q)(p);
+    }
+    ALWAYS_INLINE arm_vec_t arm_loadu(imem_t const* p) {
+        return ANAME(vld1q)(p);
+    }
+    ALWAYS_INLINE void arm_store(imem_t* p, arm_vec_t v) {
+        ANAME(vst1q)(p, v);
+    }
+
+    // No non-temporal vector store in NEON.
+    ALWAYS_INLINE void arm_stream(imem_t* p, arm_vec_t v) {
+        ANAME(vst1q)(p, v);
+    }
+
+    // Elements from 'a' where bits in 'k1' are set, from 'b' elsewhere.
+    // The lane mask is made in registers: broadcast 'k1', keep each
+    // lane's own bit, and compare to set all bits in selected lanes.
+    ALWAYS_INLINE arm_vec_t arm_select(uidx_t k1, arm_vec_t a, arm_vec_t b) {
+        arm_ivec_t bits = ANAMEI(vld1q)(arm_lane_bits);
+        arm_ivec_t k = ANAMEI(vandq)(ANAMEI(vdupq_n)(ctrl_t(k1)), bits);
+        return ANAME(vbslq)(ANAMEI(vceqq)(k, bits), a, b);
+    }
+
+    // Store elements selected by 'k1'.
+    // Elements are stored individually because a load-blend-store
+    // would also write the unselected elements.
+    ALWAYS_INLINE void arm_mask_store(imem_t* p, real_mask_t k1, arm_vec_t v) {
+        real_t r[VLEN];
+        ANAME(vst1q)(r, v);
+        for (int i = 0; i < VLEN; i++)
+            if ((k1 >> i) & 1)
+                p[i] = r[i];
+    }
+
+    // Concat 'a' and 'b', shift right by 'count' elements.
+    template<int count>
+    ALWAYS_INLINE arm_vec_t arm_align(arm_vec_t a, arm_vec_t b) {
+        if (count == VLEN)
+            return a;
+        return ANAME(vextq)(b, a, count % VLEN);
+    }
+
+    // Get elements of 'a' at the indices in 'ctrl'.
+    // 'tbl' uses byte indices, so they are made from the element indices.
+    // The ctrl vectors are constants, so this should be done at compile-time.
+    ALWAYS_INLINE arm_vec_t arm_permute(arm_ivec_t ctrl, arm_vec_t a) {
+        ctrl_t ci[VLEN];
+        ANAMEI(vst1q)(ci, ctrl);
+        uint8_t bi[16];
+        for (int i = 0; i < VLEN; i++)
+            for (int j = 0; j < REAL_BYTES; j++)
+                bi[i * REAL_BYTES + j] = uint8_t((ci[i] & ctrl_idx_mask) * REAL_BYTES + j);
+        return ANAME_FROM_U8(vqtbl1q_u8(ANAME(vreinterpretq_u8)(a), vld1q_u8(bi)));
+    }
+
+#elif defined(USE_INTRIN512_SVE)
+    // Fixed-length types; requires '-msve-vector-bits=512'.
+#if REAL_BYTES == 4
+    typedef svfloat32_t arm_vec_t __attribute__((arm_sve_vector_bits(512)));
+    typedef svuint32_t arm_ivec_t __attribute__((arm_sve_vector_bits(512)));
+#define ANAME(op) op ## _f32
+#define ANAME_X(op) op ## _f32_x
+#define ANAMEI(op) op ## _u32
+#define ANAMEI_X(op) op ## _u32_x
+#define ANAMEB(op) op ## _b32
+#else
+    typedef svfloat64_t arm_vec_t __attribute__((arm_sve_vector_bits(512)));
+    typedef svuint64_t arm_ivec_t __attribute__((arm_sve_vector_bits(512)));
+#define ANAME(op) op ## _f64
+#define ANAME_X(op) op ## _f64_x
+#define ANAMEI(op) op ## _u64
+#define ANAMEI_X(op) op ## _u64_x
+#define ANAMEB(op) op ## _b64
+#endif
+
+    ALWAYS_INLINE svbool_t arm_ptrue() {
+        return ANAMEB(svptrue)();
+    }
+
+    // Predicate w/elements set where bits in 'k1' are set.
+    ALWAYS_INLINE svbool_t arm_pred(uidx_t k1) {
+        svbool_t pg = arm_ptrue();
+        arm_ivec_t bits = ANAMEI_X(svlsl)(pg, ANAMEI(svdup)(1), ANAMEI(svindex)(0, 1));
+        arm_ivec_t sel = ANAMEI_X(svand)(pg, ANAMEI(svdup)(ctrl_t(k1)), bits);
+        return ANAMEI(svcmpne_n)(pg, sel, 0);
+    }
+
+    ALWAYS_INLINE arm_vec_t arm_set1(real_t v) {
+        return ANAME(svdup)(v);
+    }
+    ALWAYS_INLINE arm_vec_t arm_setzero() {
+        return ANAME(svdup)(real_t(0));
+    }
+    ALWAYS_INLINE arm_vec_t arm_add(arm_vec_t a, arm_vec_t b) {
+        return ANAME_X(svadd)(arm_ptrue(), a, b);
+    }
+    ALWAYS_INLINE arm_vec_t arm_sub(arm_vec_t a, arm_vec_t b) {
+        return ANAME_X(svsub)(arm_ptrue(), a, b);
+    }
+    ALWAYS_INLINE arm_vec_t arm_mul(arm_vec_t a, arm_vec_t b) {
+        return ANAME_X(svmul)(arm_ptrue(), a, b);
+    }
+    ALWAYS_INLINE arm_vec_t arm_div(arm_vec_t a, arm_vec_t b) {
+        return ANAME_X(svdiv)(arm_ptrue(), a, b);
+    }
+    ALWAYS_INLINE arm_vec_t arm_load(imem_t const* p) {
+        return ANAME(svld1)(arm_ptrue(), p);
+    }
+    ALWAYS_INLINE arm_vec_t arm_loadu(imem_t const* p) {
+        return ANAME(svld1)(arm_ptrue(), p);
+    }
+    ALWAYS_INLINE void arm_store(imem_t* p, arm_vec_t v) {
+        ANAME(svst1)(arm_ptrue(), p, v);
+    }
+    ALWAYS_INLINE void arm_stream(imem_t* p, arm_vec_t v) {
+        ANAME(svstnt1)(arm_ptrue(), p, v);
+    }
+
+    // Elements from 'a' where bits in 'k1' are set, from 'b' elsewhere.
+    ALWAYS_INLINE arm_vec_t arm_select(uidx_t k1, arm_vec_t a, arm_vec_t b) {
+        return ANAME(svsel)(arm_pred(k1), a, b);
+    }
+
+    // Store elements selected by 'k1'.
+    ALWAYS_INLINE void arm_mask_store(imem_t* p, real_mask_t k1, arm_vec_t v) {
+        ANAME(svst1)(arm_pred(k1), p, v);
+    }
+
+    // Concat 'a' and 'b', shift right by 'count' elements.
+    template<int count>
+    ALWAYS_INLINE arm_vec_t arm_align(arm_vec_t a, arm_vec_t b) {
+        if (count == VLEN)
+            return a;
+        return ANAME(svext)(b, a, count % VLEN);
+    }
+
+    // Get elements of 'a' at the indices in 'ctrl'.
+    ALWAYS_INLINE arm_vec_t arm_permute(arm_ivec_t ctrl, arm_vec_t a) {
+        return ANAME(svtbl)(a, ctrl);
+    }
+#endif
+#endif // ARM.
+
     // The following union is used to overlay C arrays with vector types.
     // It must be an aggregate type to allow aggregate initialization,
     // so no user-provided ctors, copy operator, virtual member functions, etc.
@@ -150,6 +367,8 @@ namespace yask {
         __m256d mr;
 #elif REAL_BYTES == 8 && defined(USE_INTRIN512)
         __m512d mr;
+#elif defined(USE_INTRIN_ARM)
+        arm_vec_t mr;
 #endif
 
         // Integer SIMD-type overlay.
@@ -157,6 +376,8 @@ namespace yask {
         __m256i mi;
 #elif defined(USE_INTRIN512)
         __m512i mi;
+#elif defined(USE_INTRIN_ARM)
+        arm_ivec_t mi;
 #endif
 
 #endif
@@ -409,6 +630,21 @@ namespace yask {
 #endif
         }
 
+        // aligned non-temporal (streaming) store, regardless of
+        // USE_STREAMING_STORE.
+        ALWAYS_INLINE void storeTo_nt(real_vec_t* __restrict__ to) const {
+#if defined(NO_INTRINSICS) || defined(NO_STORE_INTRINSICS)
+#if defined(__INTEL_COMPILER) && (VLEN > 1)
+            _Pragma("vector nontemporal")
+#endif
+                REAL_VEC_LOOP(i) (*to)[i] = u.r[i];
+#elif defined(ARCH_KNC)
+            INAME(storenrngo)((imem_t*)to, u.mr);
+#else
+            INAME(stream)((imem_t*)to, u.mr);
+#endif
+        }
+
         // masked store.
         ALWAYS_INLINE void storeTo_masked(real_vec_t* __restrict__ to, uidx_t k1) const {
 
@@ -502,6 +738,9 @@ namespace yask {
         for (int i = VLEN-count; i < VLEN; i++)
             res.u.r[i] = tmpa.u.r[i + count - VLEN];
 
+#elif defined(USE_INTRIN_ARM)
+        res.u.mr = arm_align<count>(a.u.mr, b.u.mr);
+
 #elif defined(USE_INTRIN256)
         // Not really an intrinsic, but not element-wise, either.
         // Put the 2 parts in a local array, then extract the desired part
@@ -544,7 +783,9 @@ namespace yask {
         std::cout << " mask: 0x" << std::hex << k1 << std::endl;
 #endif
 
-#if defined(NO_INTRINSICS) || !defined(USE_INTRIN512)
+#if defined(USE_INTRIN_ARM)
+        res.u.mr = arm_select(k1, arm_align<count>(a.u.mr, b.u.mr), res.u.mr);
+#elif defined(NO_INTRINSICS) || !defined(USE_INTRIN512)
         // must make temp copies in case &res == &a or &b.
         real_vec_t tmpa = a, tmpb = b;
         for (int i = 0; i < VLEN-count; i++)
@@ -574,7 +815,9 @@ namespace yask {
         a.print_reals(std::cout);
 #endif
 
-#if defined(NO_INTRINSICS) || !defined(USE_INTRIN512)
+#if defined(USE_INTRIN_ARM)
+        res.u.mr = arm_permute(ctrl.u.mi, a.u.mr);
+#elif defined(NO_INTRINSICS) || !defined(USE_INTRIN512)
         // must make a temp copy in case &res == &a.
         real_vec_t tmp = a;
         for (int i = 0; i < VLEN; i++)
@@ -604,7 +847,9 @@ namespace yask {
         res.print_reals(std::cout);
 #endif
 
-#if defined(NO_INTRINSICS) || !defined(USE_INTRIN512)
+#if defined(USE_INTRIN_ARM)
+        res.u.mr = arm_select(k1, arm_permute(ctrl.u.mi, a.u.mr), res.u.mr);
+#elif defined(NO_INTRINSICS) || !defined(USE_INTRIN512)
         // must make a temp copy in case &res == &a.
         real_vec_t tmp = a;
         for (int i = 0; i < VLEN; i++) {
@@ -667,11 +912,163 @@ namespace yask {
     inline void prefetch(const void* p) {
 #if defined(__INTEL_COMPILER)
         _mm_prefetch((const char*)p, level);
+#elif defined(__aarch64__)
+        __builtin_prefetch(p, 0, level);
 #else
         _mm_prefetch(p, (enum _mm_hint)level);
 #endif
     }
 
+    // Prefetch wrapper with a hint chosen at run-time.
+    inline void prefetch_rt(int hint, const void* p) {
+        switch (hint) {
+        case _MM_HINT_T0:
+            prefetch<_MM_HINT_T0>(p);
+            break;
+        case _MM_HINT_T1:
+            prefetch<_MM_HINT_T1>(p);
+            break;
+        case _MM_HINT_T2:
+            prefetch<_MM_HINT_T2>(p);
+            break;
+        default:
+            prefetch<_MM_HINT_NTA>(p);
+        }
+    }
+
+    // Conversions for grids stored in 16 bits.
+    // bf16 is the upper half of an IEEE single; fp16 is IEEE half.
+    // Conversions to 16 bits round to nearest even.
+    ALWAYS_INLINE float bf16_to_float(uint16_t h) {
+        uint32_t u = uint32_t(h) << 16;
+        float f;
+        memcpy(&f, &u, sizeof(f));
+        return f;
+    }
+    inline uint16_t float_to_bf16(float f) {
+        uint32_t u;
+        memcpy(&u, &f, sizeof(u));
+        if ((u & 0x7fffffff) > 0x7f800000)
+            return uint16_t((u >> 16) | 0x40); // keep NaN quiet.
+        u += 0x7fff + ((u >> 16) & 1);
+        return uint16_t(u >> 16);
+    }
+    ALWAYS_INLINE float fp16_to_float(uint16_t h) {
+#if defined(__F16C__)
+        return _cvtsh_ss(h);
+#elif defined(__aarch64__)
+        __fp16 x;
+        memcpy(&x, &h, sizeof(x));
+        return float(x);
+#else
+        uint32_t s = uint32_t(h & 0x8000) << 16;
+        uint32_t e = (h >> 10) & 0x1f;
+        uint32_t m = h & 0x3ff;
+        uint32_t u;
+        if (e == 0) {
+            float f = float(m) * (1.f / 16777216.f); // subnormal: m * 2^-24.
+            return s ? -f : f;
+        }
+        else if (e == 31)
+            u = s | 0x7f800000 | (m << 13);
+        else
+            u = s | ((e + 112) << 23) | (m << 13);
+        float f;
+        memcpy(&f, &u, sizeof(f));
+        return f;
+#endif
+    }
+    inline uint16_t float_to_fp16(float f) {
+#if defined(__F16C__)
+        return _cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT);
+#elif defined(__aarch64__)
+        __fp16 x = f;
+        uint16_t h;
+        memcpy(&h, &x, sizeof(h));
+        return h;
+#else
+        uint32_t u;
+        memcpy(&u, &f, sizeof(u));
+        uint16_t s = uint16_t((u >> 16) & 0x8000);
+        uint32_t a = u & 0x7fffffff;
+        if (a >= 0x7f800000)
+            return s | 0x7c00 | (a > 0x7f800000 ? 0x200 : 0); // inf or NaN.
+        if (a >= 0x477ff000)
+            return s | 0x7c00;  // rounds to inf.
+        if (a < 0x38800000) {
+            float af;
+            memcpy(&af, &a, sizeof(af));
+            return s | uint16_t(nearbyintf(af * 16777216.f)); // subnormal.
+        }
+        a -= 112 << 23;
+        a += 0xfff + ((a >> 13) & 1);
+        return s | uint16_t(a >> 13);
+#endif
+    }
+
+    // Type for a vector block stored in 16 bits per element.
+    // Used only for storage; values are converted to and from real_vec_t,
+    // which is where all arithmetic is done.
+    // If '_bf16', elements are bf16; else fp16.
+    template <bool _bf16>
+    struct real_vec_half_t {
+        uint16_t h[VLEN];
+
+        // default ctor does not init data!
+        ALWAYS_INLINE real_vec_half_t() {}
+
+        ALWAYS_INLINE real_vec_half_t(const real_vec_t& val) {
+            operator=(val);
+        }
+        ALWAYS_INLINE real_vec_half_t(double val) {
+            operator=(real_vec_t(val));
+        }
+
+        static ALWAYS_INLINE real_t to_real(uint16_t e) {
+            return real_t(_bf16 ? bf16_to_float(e) : fp16_to_float(e));
+        }
+        static inline uint16_t from_real(real_t r) {
+            return _bf16 ? float_to_bf16(float(r)) : float_to_fp16(float(r));
+        }
+
+        // Down-convert.
+        ALWAYS_INLINE real_vec_half_t& operator=(const real_vec_t& rhs) {
+            for (int i = 0; i < VLEN; i++)
+                h[i] = from_real(rhs[i]);
+            return *this;
+        }
+
+        // Up-convert.
+        ALWAYS_INLINE operator real_vec_t() const {
+            real_vec_t res;
+#if !defined(NO_INTRINSICS) && REAL_BYTES == 4 && defined(USE_INTRIN512) && !defined(ARCH_KNC)
+            __m256i hv = _mm256_loadu_si256((const __m256i*)h);
+            if (_bf16)
+                res.u.mi = _mm512_slli_epi32(_mm512_cvtepu16_epi32(hv), 16);
+            else
+                res.u.mr = _mm512_cvtph_ps(hv);
+#elif !defined(NO_INTRINSICS) && REAL_BYTES == 4 && defined(USE_INTRIN256) && \
+    defined(__AVX2__) && defined(__F16C__)
+            __m128i hv = _mm_loadu_si128((const __m128i*)h);
+            if (_bf16)
+                res.u.mi = _mm256_slli_epi32(_mm256_cvtepu16_epi32(hv), 16);
+            else
+                res.u.mr = _mm256_cvtph_ps(hv);
+#else
+            REAL_VEC_LOOP_UNALIGNED(i)
+                res.u.r[i] = to_real(h[i]);
+#endif
+            return res;
+        }
+
+        // Needed for GenericGridTemplate::set_elems_in_seq().
+        ALWAYS_INLINE real_vec_half_t operator*(const real_vec_half_t& rhs) const {
+            return real_vec_t(*this) * real_vec_t(rhs);
+        }
+    };
+    typedef real_vec_half_t<true> real_vec_bf16_t;
+    typedef real_vec_half_t<false> real_vec_fp16_t;
+
     // default max abs difference in validation.
 #ifndef EPSILON
 #define EPSILON (1e-3)
@@ -702,6 +1099,12 @@ namespace yask {
         }
         return true;
     }
+    template <bool _bf16>
+    inline bool within_tolerance(const real_vec_half_t<_bf16>& val,
+                                 const real_vec_half_t<_bf16>& ref,
+                                 const real_vec_half_t<_bf16>& epsilon) {
+        return within_tolerance(real_vec_t(val), real_vec_t(ref), real_vec_t(epsilon));
+    }
 
 }
 #endif
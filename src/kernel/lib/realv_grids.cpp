@@ -57,6 +57,7 @@ namespace yask {
         _vec_left_pads.setFromConst(1, n);
         _vec_allocs.setFromConst(1, n);
         _vec_local_offsets.setFromConst(0, n);
+        _vec_brick_sizes.setFromConst(1, n);
     }
 
     // Convenience function to format indices like
@@ -274,7 +275,9 @@ namespace yask {
     idx_t YkGridBase::compare(const YkGridBase* ref,
                               real_t epsilon,
                               int maxPrint,
-                              std::ostream& os) const {
+                              std::ostream& os,
+                              const IdxTuple* first_pt,
+                              const IdxTuple* end_pt) const {
         if (!ref) {
             os << "** mismatch: no reference grid.\n";
             return get_num_storage_elements();
@@ -287,60 +290,64 @@ namespace yask {
             return get_num_storage_elements();
         }
 
-        // Quick check for errors, assuming same layout.
-        // TODO: check layout.
-        idx_t errs = _ggb->count_diffs(ref->_ggb, epsilon);
-        TRACE_MSG0(get_ostr(), "count_diffs() returned " << errs);
-        if (!errs)
-            return 0;
-
-        // Run detailed comparison if any errors found.
-        errs = 0;
+        // Find global indices of points to compare.  This is the whole
+        // allocation in non-domain dims and the rank domain in domain dims,
+        // optionally limited to [first_pt, end_pt). Halos and pads are not
+        // compared because they are not guaranteed to be current. (A quick
+        // count_diffs() over the whole allocation would include them, so it
+        // is not used as a pre-check.)
+        bool is_partial = first_pt && end_pt;
+        auto n = get_num_dims();
         auto allocs = get_allocs();
+        Indices first_idxs(n), sizes(n);
+        for (int i = 0; i < n; i++) {
+            auto& dname = get_dim_name(i);
+            idx_t first = _offsets[i];
+            idx_t last = _offsets[i] + _allocs[i] - 1;
+            if (_dims->_domain_dims.lookup(dname)) {
+                first = get_first_rank_domain_index(dname);
+                last = get_last_rank_domain_index(dname);
+                if (is_partial) {
+                    first = max(first, first_pt->getVal(dname));
+                    last = min(last, end_pt->getVal(dname) - 1);
+                }
+            }
+            if (last < first)
+                return 0; // nothing to compare.
+            first_idxs[i] = first;
+            sizes[i] = last - first + 1;
+        }
+        IdxTuple range(allocs);
+        sizes.setTupleVals(range);
 
-        // This will loop over the entire allocation.
-        // We use this as a handy way to get offsets,
-        // but not all will be used.
-        allocs.visitAllPoints
+        // Run detailed comparison in parallel.
+        idx_t errs = 0;
+        range.visitAllPointsInParallel
             ([&](const IdxTuple& pt, size_t idx) {
 
-                // Adjust alloc indices to overall indices.
-                IdxTuple opt(pt);
-                bool ok = true;
-                for (int i = 0; ok && i < pt.getNumDims(); i++) {
-                    auto val = pt.getVal(i);
-
-                    // Convert to global index.
-                    opt[i] = _offsets[i] + val;
-
-                    // Don't compare points outside the domain.
-                    // TODO: check points in halo.
-                    auto& dname = pt.getDimName(i);
-                    if (_dims->_domain_dims.lookup(dname)) {
-                        auto first_ok = get_first_rank_domain_index(dname);
-                        auto last_ok = get_last_rank_domain_index(dname);
-                        if (opt[i] < first_ok || opt[i] > last_ok)
-                            ok = false;
-                    }
-                }
-                if (!ok)
-                    return true; // stop processing this point, but keep going.
+                // Convert to global indices.
+                Indices opt(pt);
+                for (int i = 0; i < n; i++)
+                    opt[i] += first_idxs[i];
 
-                idx_t asi = get_alloc_step_index(pt);
+                idx_t asi = get_alloc_step_index(opt);
                 auto te = readElem(opt, asi, __LINE__);
                 auto re = ref->readElem(opt, asi, __LINE__);
                 if (!within_tolerance(te, re, epsilon)) {
-                    errs++;
-                    if (errs < maxPrint) {
+                    idx_t nerrs;
+#pragma omp atomic capture
+                    nerrs = ++errs;
+                    if (nerrs < maxPrint) {
+                        IdxTuple gpt(pt);
+                        opt.setTupleVals(gpt);
+#pragma omp critical
                         os << "** mismatch at " << get_name() <<
-                            "(" << opt.makeDimValStr() << "): " <<
+                            "(" << gpt.makeDimValStr() << "): " <<
                             te << " != " << re << std::endl;
                     }
-                    else if (errs == maxPrint)
+                    else if (nerrs == maxPrint) {
+#pragma omp critical
                         os << "** Additional errors not printed." << std::endl;
-                    else {
-                        // errs > maxPrint.
-                        return false; // stop visits.
                     }
                 }
                 return true;    // keep visiting.
@@ -349,6 +356,115 @@ namespace yask {
         return errs;
     }
 
+    // Reduce elements one at a time.
+    // Vector grids override this with a faster version.
+    void YkGridBase::reduce_in_slice(const Indices& first_indices,
+                                     const Indices& last_indices,
+                                     GridReduction& res) const {
+        checkIndices(first_indices, "reduce_in_slice", true, false);
+        checkIndices(last_indices, "reduce_in_slice", true, false);
+
+        // One partial result per thread.
+        vector<GridReduction> tres(max(omp_get_max_threads(), 1));
+        IdxTuple range = get_slice_range(first_indices, last_indices);
+        range.visitAllPointsInParallel
+            ([&](const IdxTuple& ofs, size_t idx) {
+                Indices pt = first_indices.addElements(ofs);
+                idx_t asi = get_alloc_step_index(pt);
+                tres[omp_get_thread_num()].add(readElem(pt, asi, __LINE__), pt);
+                return true;    // keep going.
+            });
+        for (auto& tr : tres)
+            res.combine(tr);
+    }
+
+    // Copy a strided slice into a compact buffer.
+    idx_t YkGridBase::get_strided_elements_in_slice(real_t* buffer,
+                                                    const Indices& first_indices,
+                                                    const Indices& last_indices,
+                                                    const Indices& strides) const {
+        checkIndices(first_indices, "get_strided_elements_in_slice", true, false);
+        checkIndices(last_indices, "get_strided_elements_in_slice", true, false);
+
+        // Number of kept elements in each dim.
+        Indices nelems = last_indices.subElements(first_indices).divElements(strides).addConst(1);
+        IdxTuple range = get_allocs();
+        nelems.setTupleVals(range);
+        range.setFirstInner(_is_col_major);
+
+        // All points have the same step index.
+        idx_t asi = get_alloc_step_index(first_indices);
+        range.visitAllPointsInParallel
+            ([&](const IdxTuple& ofs, size_t idx) {
+                Indices pt = first_indices.addElements(Indices(ofs).mulElements(strides));
+                buffer[idx] = readElem(pt, asi, __LINE__);
+                return true;    // keep going.
+            });
+        return range.product();
+    }
+
+    // Prefetch one row of storage elements in the unit-stride dim
+    // for each element in the other dims.
+    void YkGridBase::prefetch_slice(const Indices& first_indices,
+                                    const Indices& last_indices) const {
+        if (is_bricked() || !is_storage_allocated())
+            return;
+
+        // Trim to the allocation.
+        int n = get_num_dims();
+        Indices first(first_indices), last(last_indices);
+        for (int i = 0; i < n; i++) {
+            if (_has_step_dim && i == Indices::step_posn)
+                continue;
+            first[i] = max(first[i], _get_first_alloc_index(i));
+            last[i] = min(last[i], _get_last_alloc_index(i));
+            if (last[i] < first[i])
+                return;
+        }
+
+        // Find the unit-stride dim.
+        auto strides = get_storage_strides();
+        int ui = -1;
+        for (int i = 0; i < n; i++) {
+            if (_has_step_dim && i == Indices::step_posn)
+                continue;
+            if (strides[i] > 0 && (ui < 0 || strides[i] < strides[ui]))
+                ui = i;
+        }
+        if (ui < 0)
+            return;
+
+        // Bytes in each row, including one more element in case
+        // 'first' is not at the beginning of one.
+        idx_t row_bytes = (CEIL_DIV(last[ui] - first[ui] + 1, _vec_lens[ui]) + 1) *
+            strides[ui];
+
+        // Number of rows in each dim. Stepping by the vector lengths
+        // from 'first' and ending at 'last' visits each element.
+        Indices nrows(idx_t(1), n);
+        for (int i = 0; i < n; i++) {
+            if (i == ui || (_has_step_dim && i == Indices::step_posn))
+                continue;
+            nrows[i] = CEIL_DIV(last[i] - first[i], _vec_lens[i]) + 1;
+        }
+        IdxTuple range = get_allocs();
+        nrows.setTupleVals(range);
+        range.setFirstInner(_is_col_major);
+
+        idx_t asi = get_alloc_step_index(first);
+        Indices pt(first);
+        range.visitAllPoints([&](const IdxTuple& ofs, size_t idx) {
+                Indices row(ofs);
+                for (int i = 0; i < n; i++)
+                    if (nrows[i] > 1)
+                        pt[i] = min(first[i] + row[i] * _vec_lens[i], last[i]);
+                auto* p = (const char*)getElemAddr(pt, asi, false);
+                for (idx_t b = 0; b < row_bytes; b += CACHELINE_BYTES)
+                    prefetch<_MM_HINT_T1>(p + b);
+                return true;    // keep going.
+            });
+    }
+
     // Make sure indices are in range.
     // Side-effect: If fixed_indices is not NULL, set them to in-range if out-of-range.
     bool YkGridBase::checkIndices(const Indices& indices,
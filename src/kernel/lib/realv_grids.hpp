@@ -31,6 +31,77 @@ namespace yask {
     typedef GenericGridTemplate<real_t> RealElemGrid;
     typedef GenericGridTemplate<real_vec_t> RealVecGrid;
 
+    // Results of reducing the elements of a grid.
+    // Also used for partial results from one thread or rank.
+    // Indices are overall-problem indices.
+    class GridReduction : public virtual yk_reduction {
+    public:
+        idx_t nelems = 0;
+        double sum = 0., sum_sq = 0.;
+
+        // Extremes start out beyond any value.
+        double min_val = HUGE_VAL, max_val = -HUGE_VAL, max_abs = -1.;
+        Indices min_idxs, max_idxs, max_abs_idxs;
+
+        GridReduction() {}
+        virtual ~GridReduction() {}
+
+        // Include one element.
+        void add(double val, const Indices& idxs) {
+            nelems++;
+            sum += val;
+            sum_sq += val * val;
+            add_min_max(val, idxs, val, idxs, fabs(val), idxs);
+        }
+
+        // Include extreme values and their indices, but not counts or sums.
+        void add_min_max(double vmin, const Indices& imin,
+                         double vmax, const Indices& imax,
+                         double vabs, const Indices& iabs) {
+            if (vmin < min_val) {
+                min_val = vmin;
+                min_idxs = imin;
+            }
+            if (vmax > max_val) {
+                max_val = vmax;
+                max_idxs = imax;
+            }
+            if (vabs > max_abs) {
+                max_abs = vabs;
+                max_abs_idxs = iabs;
+            }
+        }
+
+        // Include another set of results.
+        void combine(const GridReduction& other) {
+            nelems += other.nelems;
+            sum += other.sum;
+            sum_sq += other.sum_sq;
+            add_min_max(other.min_val, other.min_idxs,
+                        other.max_val, other.max_idxs,
+                        other.max_abs, other.max_abs_idxs);
+        }
+
+        // APIs.
+        virtual idx_t get_num_elements() const { return nelems; }
+        virtual double get_sum() const { return sum; }
+        virtual double get_l2_norm() const { return sqrt(sum_sq); }
+        virtual double get_min() const { return nelems ? min_val : 0.; }
+        virtual std::vector<idx_t> get_min_indices() const { return make_vec(min_idxs); }
+        virtual double get_max() const { return nelems ? max_val : 0.; }
+        virtual std::vector<idx_t> get_max_indices() const { return make_vec(max_idxs); }
+        virtual double get_max_abs() const { return nelems ? max_abs : 0.; }
+        virtual std::vector<idx_t> get_max_abs_indices() const { return make_vec(max_abs_idxs); }
+
+    protected:
+        static std::vector<idx_t> make_vec(const Indices& idxs) {
+            std::vector<idx_t> v;
+            for (int i = 0; i < idxs.getNumDims(); i++)
+                v.push_back(idxs[i]);
+            return v;
+        }
+    };
+
     // Base class implementing all yk_grids. Can be used for grids
     // that contain either individual elements or vectors.
     class YkGridBase :
@@ -67,6 +138,7 @@ namespace yask {
         Indices _vec_left_pads; // same as _actl_left_pads.
         Indices _vec_allocs; // same as _allocs.
         Indices _vec_local_offsets; // same as _local_offsets.
+        Indices _vec_brick_sizes; // size of storage bricks in vecs (one if not bricked).
 
         // Whether step dim is used.
         // If true, will always be in Indices::step_posn.
@@ -86,6 +158,10 @@ namespace yask {
         // Whether this is a scratch grid;
         bool _is_scratch = false;
 
+        // Max L1 distance of neighbor ranks that need halo data.
+        // Set by the stencil compiler; default is all neighbors.
+        int _max_exch_dist = NUM_STENCIL_DIMS - 1;
+
         // Convenience function to format indices like
         // "x=5, y=3".
         virtual std::string makeIndexString(const Indices& idxs,
@@ -140,6 +216,9 @@ namespace yask {
         // Resize or fail if already allocated.
         virtual void resize();
 
+        // Set brick size in elements or fail if not allowed.
+        virtual void _set_brick_size(int posn, idx_t n);
+
         // Set dirty flags in range.
         void set_dirty_in_slice(const Indices& first_indices,
                                 const Indices& last_indices);
@@ -170,6 +249,9 @@ namespace yask {
                 _offsets.setFromConst(0);
         }
 
+        // Brick accessors.
+        virtual bool is_bricked() const { return _ggb->is_bricked(); }
+
         // Scratch accessors.
         virtual bool is_scratch() const { return _is_scratch; }
         virtual void set_scratch(bool is_scratch) {
@@ -178,8 +260,13 @@ namespace yask {
                 _offsets.setFromConst(0);
         }
 
+        // Exchange-distance accessors.
+        virtual int get_max_exch_dist() const { return _max_exch_dist; }
+        virtual void set_max_exch_dist(int dist) { _max_exch_dist = dist; }
+
         // NUMA accessors.
         virtual int get_numa_preferred() const { return _ggb->get_numa_pref(); }
+        virtual bool is_numa_preferred_set() const { return _ggb->is_numa_pref_set(); }
         virtual bool set_numa_preferred(int numa_node) {
             return _ggb->set_numa_pref(numa_node);
         }
@@ -235,6 +322,21 @@ namespace yask {
             return allocs;
         }
 
+        // Get the number of bytes between neighboring storage elements,
+        // i.e., vectors in folded grids, in each dim of the current
+        // allocation. Only meaningful for layouts that are not bricked.
+        virtual Indices get_storage_strides() const {
+            int n = get_num_dims();
+            Indices zero(idx_t(0), n), strides(n);
+            idx_t i0 = _ggb->get_index(zero, false);
+            for (int i = 0; i < n; i++) {
+                Indices unit(zero);
+                unit[i] = 1;
+                strides[i] = (_ggb->get_index(unit, false) - i0) * idx_t(_ggb->get_elem_bytes());
+            }
+            return strides;
+        }
+
         // Get the messsage output stream.
         virtual std::ostream& get_ostr() const {
             return _ggb->get_ostr();
@@ -245,10 +347,38 @@ namespace yask {
 
         // Check for equality.
         // Return number of mismatches greater than epsilon.
+        // If 'first_pt' and 'end_pt' are given, only domain points in
+        // [first_pt, end_pt) (global domain indices) are checked.
         virtual idx_t compare(const YkGridBase* ref,
                               real_t epsilon = EPSILON,
                               int maxPrint = 20,
-                              std::ostream& os = std::cerr) const;
+                              std::ostream& os = std::cerr,
+                              const IdxTuple* first_pt = 0,
+                              const IdxTuple* end_pt = 0) const;
+
+        // Reduce elements between 'first_indices' and 'last_indices',
+        // inclusive, by all threads, and combine the results into 'res'.
+        // Indices must be allocated; they are not limited to the domain.
+        virtual void reduce_in_slice(const Indices& first_indices,
+                                     const Indices& last_indices,
+                                     GridReduction& res) const;
+
+        // Copy every 'strides'-th element between 'first_indices' and
+        // 'last_indices', inclusive, to 'buffer' by all threads in the
+        // order of get_elements_in_slice(). 'last_indices' must be
+        // 'first_indices' plus a multiple of 'strides'.
+        // Returns number of elements copied.
+        virtual idx_t get_strided_elements_in_slice(real_t* buffer,
+                                                    const Indices& first_indices,
+                                                    const Indices& last_indices,
+                                                    const Indices& strides) const;
+
+        // Prefetch the elements between 'first_indices' and
+        // 'last_indices', inclusive, into the L2 cache by the calling
+        // thread. Indices outside of the allocation are ignored.
+        // Does nothing for bricked layouts.
+        virtual void prefetch_slice(const Indices& first_indices,
+                                    const Indices& last_indices) const;
 
         // Make sure indices are in range.
         // Optionally fix them to be in range and return in 'fixed_indices'.
@@ -275,6 +405,14 @@ namespace yask {
                                    idx_t alloc_step_idx,
                                    bool checkBounds=true) =0;
 
+        // Get the address of one element, which may not be a real_t
+        // if the storage format is different.
+        virtual const void* getElemAddr(const Indices& idxs,
+                                        idx_t alloc_step_idx,
+                                        bool checkBounds=true) const {
+            return getElemPtr(idxs, alloc_step_idx, checkBounds);
+        }
+
         // Read one element.
         // Indices are relative to overall problem domain.
         virtual real_t readElem(const Indices& idxs,
@@ -283,7 +421,7 @@ namespace yask {
 
         // Write one element.
         // Indices are relative to overall problem domain.
-        inline void writeElem(real_t val,
+        virtual void writeElem(real_t val,
                               const Indices& idxs,
                               idx_t alloc_step_idx,
                               int line) {
@@ -296,7 +434,7 @@ namespace yask {
 
         // Update one element.
         // Indices are relative to overall problem domain.
-        inline void addToElem(real_t val,
+        virtual void addToElem(real_t val,
                               const Indices& idxs,
                               idx_t alloc_step_idx,
                               int line) {
@@ -400,6 +538,8 @@ namespace yask {
         GET_GRID_API(get_last_rank_alloc_index)
         GET_GRID_API(get_first_misc_index)
         GET_GRID_API(get_last_misc_index)
+        GET_GRID_API(get_brick_size)
+        GET_GRID_API(get_fold_len)
 
         SET_GRID_API(set_left_halo_size)
         SET_GRID_API(set_right_halo_size)
@@ -412,6 +552,7 @@ namespace yask {
         SET_GRID_API(set_extra_pad_size)
         SET_GRID_API(set_alloc_size)
         SET_GRID_API(set_first_misc_index)
+        SET_GRID_API(set_brick_size)
 
 #undef GET_GRID_API
 #undef SET_GRID_API
@@ -535,6 +676,16 @@ namespace yask {
         virtual void* get_raw_storage_buffer() {
             return _ggb->get_storage();
         }
+        virtual idx_t get_raw_storage_stride(const std::string& dim) const;
+        virtual idx_t get_raw_storage_offset(const Indices& indices) const;
+        virtual idx_t get_raw_storage_offset(const GridIndices& indices) const {
+            const Indices indices2(indices);
+            return get_raw_storage_offset(indices2);
+        }
+        virtual idx_t get_alloc_step_slot(idx_t step_index) const {
+            return _has_step_dim ? _wrap_step(step_index) : 0;
+        }
+        virtual void use_external_storage(void* buffer_ptr, idx_t num_bytes);
         virtual void set_storage(std::shared_ptr<char> base, size_t offset) {
             _ggb->set_storage(base, offset);
         }
@@ -941,6 +1092,20 @@ namespace yask {
 #endif
         }
 
+        // Write one vector with a mask.
+        // Indices must be normalized and rank-relative.
+        inline void writeVecNorm_masked(real_vec_t val,
+                                        const Indices& vec_idxs,
+                                        idx_t alloc_step_idx,
+                                        uidx_t mask,
+                                        int line) {
+            real_vec_t* vp = getVecPtrNorm(vec_idxs, alloc_step_idx);
+            val.storeTo_masked(vp, mask);
+#ifdef TRACE_MEM
+            printVecNorm("writeVecNorm_masked", vec_idxs, val, line);
+#endif
+        }
+
         // Prefetch one vector.
         // Indices must be normalized and rank-relative.
         template <int level>
@@ -978,10 +1143,8 @@ namespace yask {
                        makeIndexString(lastv));
 
             // Visit points in slice.
-            numVecsTuple.visitAllPointsInParallel
-                ([&](const IdxTuple& ofs,
-                     size_t idx) {
-                    Indices pt = firstv.addElements(ofs);
+            visit_vecs_in_slice(firstv, lastv,
+                                [&](const Indices& pt, idx_t idx) {
                     real_vec_t val = ((real_vec_t*)buffer_ptr)[idx];
 
                     // TODO: move this outside of parallel loop when
@@ -989,7 +1152,6 @@ namespace yask {
                     idx_t asi = get_alloc_step_index(pt);
 
                     writeVecNorm(val, pt, asi, __LINE__);
-                    return true;    // keep going.
                 });
 
             // Set appropriate dirty flag(s).
@@ -1021,10 +1183,8 @@ namespace yask {
                        makeIndexString(lastv));
 
             // Visit points in slice.
-            numVecsTuple.visitAllPointsInParallel
-                ([&](const IdxTuple& ofs,
-                     size_t idx) {
-                    Indices pt = firstv.addElements(ofs);
+            visit_vecs_in_slice(firstv, lastv,
+                                [&](const Indices& pt, idx_t idx) {
 
                     // TODO: move this outside of parallel loop when
                     // step index is const.
@@ -1032,11 +1192,575 @@ namespace yask {
 
                     real_vec_t val = readVecNorm(pt, asi, __LINE__);
                     ((real_vec_t*)buffer_ptr)[idx] = val;
-                    return true;    // keep going.
                 });
             return numVecsTuple.product() * VLEN;
         }
 
+        // Element-wise slice copies that work on one whole vector at a
+        // time instead of calling getElemPtr() for every element.
+        // The buffer layout is the same as that of the generic versions
+        // in YkGridBase, so the slice need not be vector-aligned.
+        using YkGridBase::get_elements_in_slice;
+        using YkGridBase::set_elements_in_slice;
+        virtual idx_t get_elements_in_slice(void* buffer_ptr,
+                                            const Indices& first_indices,
+                                            const Indices& last_indices) const {
+            if (!is_storage_allocated()) {
+                THROW_YASK_EXCEPTION("Error: call to 'get_elements_in_slice' with no data allocated for grid '" +
+                                     get_name() + "'");
+            }
+            return copy_elems_by_vecs<false>((real_t*)buffer_ptr,
+                                             first_indices, last_indices,
+                                             "get_elements_in_slice");
+        }
+        virtual idx_t set_elements_in_slice(const void* buffer_ptr,
+                                            const Indices& first_indices,
+                                            const Indices& last_indices) {
+            if (!is_storage_allocated())
+                return 0;
+            idx_t n = copy_elems_by_vecs<true>((real_t*)buffer_ptr,
+                                               first_indices, last_indices,
+                                               "set_elements_in_slice");
+
+            // Set appropriate dirty flag(s).
+            set_dirty_in_slice(first_indices, last_indices);
+            return n;
+        }
+
+        // Reduce whole vectors, keeping separate sums and extremes for
+        // each lane in each thread so the inner loop is SIMD code.
+        // Extremes keep the buffer index of their vector, which is turned
+        // back into element indices only when the lanes are combined.
+        virtual void reduce_in_slice(const Indices& first_indices,
+                                     const Indices& last_indices,
+                                     GridReduction& res) const {
+            Indices firstv, lastv;
+            checkIndices(first_indices, "reduce_in_slice", true, true, &firstv);
+            checkIndices(last_indices, "reduce_in_slice", true, true, &lastv);
+            const int nd = get_num_dims();
+            IdxTuple numVecsTuple = get_slice_range(firstv, lastv);
+            Indices lane_ofs[VLEN];
+            get_lane_offsets(lane_ofs);
+
+            struct LaneResults {
+                double sum[VLEN], sum_sq[VLEN];
+                real_t vmin[VLEN], vmax[VLEN], vabs[VLEN];
+                idx_t imin[VLEN], imax[VLEN], iabs[VLEN];
+                idx_t nelems = 0;
+
+                LaneResults() {
+                    for (int j = 0; j < VLEN; j++) {
+                        sum[j] = sum_sq[j] = 0.;
+                        vmin[j] = real_t(HUGE_VAL);
+                        vmax[j] = real_t(-HUGE_VAL);
+                        vabs[j] = real_t(-1);
+                        imin[j] = imax[j] = iabs[j] = -1;
+                    }
+                }
+            };
+            std::vector<LaneResults> tres(std::max(omp_get_max_threads(), 1));
+
+            visit_vecs_in_slice(firstv, lastv,
+                                [&](const Indices& vpt, idx_t idx) {
+                    auto& lr = tres[omp_get_thread_num()];
+                    idx_t asi = get_alloc_step_index(vpt);
+                    real_vec_t val = readVecNorm(vpt, asi, __LINE__);
+
+                    // First element in this vector and whether all
+                    // its elements are in the slice.
+                    Indices ept(nd);
+                    bool is_full = true;
+                    for (int i = 0; i < nd; i++) {
+                        ept[i] = vpt[i] * _vec_lens[i] + _offsets[i];
+                        if (ept[i] < first_indices[i] ||
+                            ept[i] + _vec_lens[i] - 1 > last_indices[i])
+                            is_full = false;
+                    }
+
+                    // Lanes in slice.
+                    bool in_slice[VLEN];
+                    idx_t n = 0;
+                    for (int j = 0; j < VLEN; j++) {
+                        bool ok = true;
+                        for (int i = 0; !is_full && ok && i < nd; i++) {
+                            idx_t e = ept[i] + lane_ofs[j][i];
+                            ok = e >= first_indices[i] && e <= last_indices[i];
+                        }
+                        in_slice[j] = ok;
+                        n += ok ? 1 : 0;
+                    }
+                    lr.nelems += n;
+
+#pragma omp simd
+                    for (int j = 0; j < VLEN; j++) {
+                        real_t v = in_slice[j] ? val[j] : real_t(0);
+                        real_t a = std::abs(v);
+                        lr.sum[j] += double(v);
+                        lr.sum_sq[j] += double(v) * double(v);
+                        bool lt = in_slice[j] && v < lr.vmin[j];
+                        bool gt = in_slice[j] && v > lr.vmax[j];
+                        bool ga = in_slice[j] && a > lr.vabs[j];
+                        lr.vmin[j] = lt ? v : lr.vmin[j];
+                        lr.imin[j] = lt ? idx : lr.imin[j];
+                        lr.vmax[j] = gt ? v : lr.vmax[j];
+                        lr.imax[j] = gt ? idx : lr.imax[j];
+                        lr.vabs[j] = ga ? a : lr.vabs[j];
+                        lr.iabs[j] = ga ? idx : lr.iabs[j];
+                    }
+                });
+
+            // Element indices of lane 'j' in the vector at buffer index 'idx'.
+            auto elem_idxs = [&](idx_t idx, int j) {
+                Indices vpt = firstv.addElements(numVecsTuple.unlayout(idx));
+                Indices ept(nd);
+                for (int i = 0; i < nd; i++)
+                    ept[i] = vpt[i] * _vec_lens[i] + _offsets[i] + lane_ofs[j][i];
+                return ept;
+            };
+
+            // Combine lanes and threads.
+            Indices none;
+            for (auto& lr : tres) {
+                res.nelems += lr.nelems;
+                for (int j = 0; j < VLEN; j++) {
+                    res.sum += lr.sum[j];
+                    res.sum_sq += lr.sum_sq[j];
+                    if (lr.imin[j] >= 0 && lr.vmin[j] < res.min_val)
+                        res.add_min_max(lr.vmin[j], elem_idxs(lr.imin[j], j),
+                                        -HUGE_VAL, none, -1., none);
+                    if (lr.imax[j] >= 0 && lr.vmax[j] > res.max_val)
+                        res.add_min_max(HUGE_VAL, none,
+                                        lr.vmax[j], elem_idxs(lr.imax[j], j), -1., none);
+                    if (lr.iabs[j] >= 0 && lr.vabs[j] > res.max_abs)
+                        res.add_min_max(HUGE_VAL, none, -HUGE_VAL, none,
+                                        lr.vabs[j], elem_idxs(lr.iabs[j], j));
+                }
+            }
+        }
+
+    protected:
+
+        // Copy elements between 'buf' and the slice between
+        // 'first_indices' and 'last_indices', inclusive.
+        // If 'do_set', copy from 'buf' into the grid; else copy from the
+        // grid into 'buf'. Each vector overlapping the slice is visited
+        // once by one thread: on get, it is loaded and its in-slice lanes
+        // are scattered into 'buf'; on set, its in-slice lanes are
+        // gathered from 'buf' and written with a masked store so lanes
+        // outside the slice are never written.
+        template <bool do_set>
+        idx_t copy_elems_by_vecs(real_t* buf,
+                                 const Indices& first_indices,
+                                 const Indices& last_indices,
+                                 const std::string& fn) const {
+            Indices firstv, lastv;
+            checkIndices(first_indices, fn, true, true, &firstv);
+            checkIndices(last_indices, fn, true, true, &lastv);
+            const int nd = get_num_dims();
+
+            // Ranges of elements and vectors.
+            IdxTuple numElemsTuple = get_slice_range(first_indices, last_indices);
+            IdxTuple numVecsTuple = get_slice_range(firstv, lastv);
+            TRACE_MSG0(get_ostr(), fn << ": copying " <<
+                       numElemsTuple.makeDimValStr(" * ") << " elems in " <<
+                       numVecsTuple.makeDimValStr(" * ") << " vecs at " <<
+                       makeIndexString(first_indices) << " ... " <<
+                       makeIndexString(last_indices));
+
+            // Strides into 'buf', matching the unit-stride dim that
+            // numElemsTuple.layout() would use.
+            Indices strides(nd);
+            idx_t stride = 1;
+            for (int j = 0; j < nd; j++) {
+                int i = _is_col_major ? j : nd - 1 - j;
+                strides[i] = stride;
+                stride *= numElemsTuple.getVal(i);
+            }
+
+            // Element offsets in each dim for each lane of a vector.
+            Indices lane_ofs[VLEN];
+            get_lane_offsets(lane_ofs);
+            const uidx_t all_lanes = (VLEN >= 64) ? ~uidx_t(0) :
+                (uidx_t(1) << VLEN) - 1;
+
+            // Visit vectors in slice.
+            visit_vecs_in_slice(firstv, lastv,
+                                [&](const Indices& vpt, idx_t idx) {
+                    idx_t asi = get_alloc_step_index(vpt);
+                    real_vec_t* vp =
+                        const_cast<real_vec_t*>(getVecPtrNorm(vpt, asi));
+
+                    // First element in this vector.
+                    Indices ept(nd);
+                    for (int i = 0; i < nd; i++)
+                        ept[i] = vpt[i] * _vec_lens[i] + _offsets[i];
+
+                    real_vec_t val;
+                    if (!do_set)
+                        val = *vp;
+                    uidx_t mask = 0;
+                    for (int j = 0; j < VLEN; j++) {
+
+                        // Find offset into 'buf' if this lane is in slice.
+                        bool ok = true;
+                        idx_t bi = 0;
+                        for (int i = 0; ok && i < nd; i++) {
+                            idx_t e = ept[i] + lane_ofs[j][i];
+                            if (e < first_indices[i] || e > last_indices[i])
+                                ok = false;
+                            else
+                                bi += (e - first_indices[i]) * strides[i];
+                        }
+                        if (!ok)
+                            continue;
+
+                        if (do_set) {
+                            val[j] = buf[bi];
+                            mask |= uidx_t(1) << j;
+                        }
+                        else
+                            buf[bi] = val[j];
+                    }
+                    if (do_set) {
+                        if (mask == all_lanes)
+                            *vp = val;
+                        else if (mask)
+                            val.storeTo_masked(vp, mask);
+                    }
+                });
+            return numElemsTuple.product();
+        }
+
+        // Set 'lane_ofs[j]' to the offsets in each dim of the element in
+        // lane 'j' from the first element in a vector.
+        void get_lane_offsets(Indices lane_ofs[VLEN]) const {
+            IdxTuple vecTuple = get_allocs();
+            _vec_lens.setTupleVals(vecTuple);
+            vecTuple.visitAllPoints([&](const IdxTuple& eofs, size_t idx) {
+                    Indices elem_ofs(eofs);
+                    Indices fold_ofs(NUM_VEC_FOLD_DIMS);
+                    for (int i = 0; i < NUM_VEC_FOLD_DIMS; i++)
+                        fold_ofs[i] = elem_ofs[_vec_fold_posns[i]];
+                    auto lane = _dims->getElemIndexInVec(fold_ofs);
+                    assert(lane >= 0 && lane < VLEN);
+                    lane_ofs[lane] = elem_ofs;
+                    return true;    // keep going.
+                });
+        }
+
+        // Call 'visitor(pt, idx)' for each vector 'pt' between 'firstv'
+        // and 'lastv', inclusive, where 'idx' is its offset in a buffer
+        // laid out like get_slice_range(). With a bricked layout, the
+        // slice is cut at brick boundaries and each piece is visited by
+        // one thread, so each thread walks through contiguous memory.
+        template <typename VisitFn>
+        void visit_vecs_in_slice(const Indices& firstv,
+                                 const Indices& lastv,
+                                 VisitFn visitor) const {
+            IdxTuple numVecsTuple = get_slice_range(firstv, lastv);
+            if (!is_bricked()) {
+                numVecsTuple.visitAllPointsInParallel
+                    ([&](const IdxTuple& ofs, size_t idx) {
+                        visitor(firstv.addElements(ofs), idx_t(idx));
+                        return true;    // keep going.
+                    });
+                return;
+            }
+            const int nd = get_num_dims();
+
+            // Strides into the buffer, matching numVecsTuple.layout().
+            Indices strides(nd);
+            idx_t stride = 1;
+            for (int j = 0; j < nd; j++) {
+                int i = _is_col_major ? j : nd - 1 - j;
+                strides[i] = stride;
+                stride *= numVecsTuple.getVal(i);
+            }
+
+            // Bricks overlapping the slice. Bricks start at multiples of
+            // the brick size in allocation-relative indices.
+            Indices bfirst(nd);
+            IdxTuple numBricksTuple(numVecsTuple);
+            for (int i = 0; i < nd; i++) {
+                auto bs = _vec_brick_sizes[i];
+                idx_t aofs = _vec_left_pads[i] - _vec_local_offsets[i];
+                idx_t b0 = (firstv[i] + aofs) / bs;
+                idx_t b1 = (lastv[i] + aofs) / bs;
+                bfirst[i] = b0 * bs - aofs;
+                numBricksTuple.setVal(i, b1 - b0 + 1);
+            }
+
+            // Visit bricks in parallel and vectors in each brick in order.
+            numBricksTuple.visitAllPointsInParallel
+                ([&](const IdxTuple& bofs, size_t bidx) {
+                    Indices vfirst(nd), vlast(nd);
+                    for (int i = 0; i < nd; i++) {
+                        auto bs = _vec_brick_sizes[i];
+                        idx_t b = bfirst[i] + bofs.getVal(i) * bs;
+                        vfirst[i] = std::max(b, firstv[i]);
+                        vlast[i] = std::min(b + bs - 1, lastv[i]);
+                    }
+                    IdxTuple brickTuple = get_slice_range(vfirst, vlast);
+                    brickTuple.visitAllPoints
+                        ([&](const IdxTuple& ofs, size_t idx) {
+                            Indices pt = vfirst.addElements(ofs);
+                            idx_t bi = 0;
+                            for (int i = 0; i < nd; i++)
+                                bi += (pt[i] - firstv[i]) * strides[i];
+                            visitor(pt, bi);
+                            return true;    // keep going.
+                        });
+                    return true;    // keep going.
+                });
+        }
+
     };                          // YkVecGrid.
 
+    // YASK grid of real vectors stored in 16 bits per element.
+    // Used for vector-folded grids that are read but not written by the
+    // stencil equations, e.g., coefficients. Vectors are converted to
+    // real_vec_t when read, so the stencil code does all arithmetic in
+    // the usual precision while moving half or a quarter as many bytes.
+    // Writes via the APIs are converted to the 16-bit format.
+    // If '_bf16', elements are bf16; else fp16.
+    // Other template params are as for YkVecGrid.
+    template <typename LayoutFn, bool _wrap_step_idx, bool _bf16,
+              idx_t... _templ_vec_lens>
+    class YkHalfVecGrid : public YkGridBase {
+
+    public:
+        typedef real_vec_half_t<_bf16> half_vec_t;
+
+    protected:
+        typedef GenericGrid<half_vec_t, LayoutFn> _grid_type;
+        _grid_type _data;
+
+        // Positions of grid dims in vector fold dims.
+        Indices _vec_fold_posns;
+
+        // Share data from source grid.
+        virtual bool share_data(YkGridBase* src, bool die_on_failure) {
+            return _share_data<_grid_type>(src, die_on_failure);
+        }
+
+    public:
+        YkHalfVecGrid(DimsPtr dims,
+                      const std::string& name,
+                      const GridDimNames& dimNames,
+                      KernelSettingsPtr* settings,
+                      std::ostream** ostr) :
+            YkGridBase(&_data, dimNames.size(), dims),
+            _data(name, dimNames, settings, ostr),
+            _vec_fold_posns(idx_t(0), int(dimNames.size())) {
+            _has_step_dim = _wrap_step_idx;
+
+            // Init vec sizes as in YkVecGrid.
+            const int nvls = sizeof...(_templ_vec_lens);
+            const idx_t vls[nvls] { _templ_vec_lens... };
+            assert((size_t)nvls == dimNames.size());
+            for (size_t i = 0; i < dimNames.size(); i++) {
+                auto& dname = dimNames.at(i);
+                auto* p = dims->_vec_fold_pts.lookup(dname);
+                idx_t dval = p ? *p : 1;
+                _vec_lens[i] = dval;
+                _vec_allocs[i] = dval;
+                assert(dval == vls[i]);
+            }
+            for (int i = 0; i < NUM_VEC_FOLD_DIMS; i++) {
+                auto& fdim = dims->_vec_fold_pts.getDimName(i);
+                int j = get_dim_posn(fdim, true,
+                                     "internal error: folded grid missing folded dim");
+                assert(j >= 0);
+                _vec_fold_posns[i] = j;
+            }
+
+            resize();
+        }
+
+        // Get num dims from compile-time const.
+        virtual int get_num_dims() const final {
+            return _data.get_num_dims();
+        }
+
+        // Make a human-readable description.
+        virtual std::string make_info_string() const {
+            return _data.make_info_string(_bf16 ? "SIMD BF16" : "SIMD FP16");
+        }
+
+        // Init data.
+        virtual void set_all_elements_same(double seed) {
+            half_vec_t seedv = seed; // bcast.
+            _data.set_elems_same(seedv);
+            set_dirty_all(true);
+        }
+        virtual void set_all_elements_in_seq(double seed) {
+            real_vec_t seedv;
+            for (int i = 0; i < VLEN; i++)
+                seedv[i] = seed * (1.0 + double(i) / VLEN);
+            _data.set_elems_in_seq(half_vec_t(seedv));
+            set_dirty_all(true);
+        }
+
+        // Get a pointer to given 16-bit element.
+        const uint16_t* getHalfPtr(const Indices& idxs,
+                                   idx_t alloc_step_idx,
+                                   bool checkBounds=true) const {
+            static constexpr int nvls = sizeof...(_templ_vec_lens);
+            static constexpr uidx_t vls[nvls] { _templ_vec_lens... };
+            Indices vec_idxs(nvls), elem_ofs(nvls);
+
+            // Special handling for step index.
+            auto sp = Indices::step_posn;
+            if (_wrap_step_idx) {
+                assert(alloc_step_idx == _wrap_step(idxs[sp]));
+                vec_idxs[sp] = alloc_step_idx;
+                elem_ofs[sp] = 0;
+            }
+
+            // All other indices.
+#pragma unroll
+            for (int i = 0; i < nvls; i++) {
+                if (!(_wrap_step_idx && i == sp)) {
+                    idx_t ai = idxs[i] - _offsets[i] + _actl_left_pads[i];
+                    assert(ai >= 0);
+                    uidx_t adj_idx = uidx_t(ai);
+                    vec_idxs[i] = idx_t(adj_idx / vls[i]);
+                    elem_ofs[i] = idx_t(adj_idx % vls[i]);
+                }
+            }
+
+            // Element index in vector from fold offsets.
+            Indices fold_ofs(NUM_VEC_FOLD_DIMS);
+#pragma unroll
+            for (int i = 0; i < NUM_VEC_FOLD_DIMS; i++)
+                fold_ofs[i] = elem_ofs[_vec_fold_posns[i]];
+            auto i = _dims->getElemIndexInVec(fold_ofs);
+
+            const half_vec_t* vp = _data.getPtr(vec_idxs, checkBounds);
+            return &vp->h[i];
+        }
+
+        // There is no real_t in storage.
+        virtual const real_t* getElemPtr(const Indices& idxs,
+                                         idx_t alloc_step_idx,
+                                         bool checkBounds=true) const final {
+            THROW_YASK_EXCEPTION("Error: grid '" + get_name() +
+                                 "' is stored in 16 bits, so its elements cannot be accessed "
+                                 "via a pointer to a real");
+        }
+        virtual real_t* getElemPtr(const Indices& idxs,
+                                   idx_t alloc_step_idx,
+                                   bool checkBounds=true) final {
+            const real_t* p =
+                const_cast<const YkHalfVecGrid*>(this)->getElemPtr(idxs, alloc_step_idx,
+                                                                   checkBounds);
+            return const_cast<real_t*>(p);
+        }
+        virtual const void* getElemAddr(const Indices& idxs,
+                                        idx_t alloc_step_idx,
+                                        bool checkBounds=true) const final {
+            return getHalfPtr(idxs, alloc_step_idx, checkBounds);
+        }
+
+        // Read one element.
+        // Indices are relative to overall problem domain.
+        virtual real_t readElem(const Indices& idxs,
+                                idx_t alloc_step_idx,
+                                int line) const final {
+            real_t e = half_vec_t::to_real(*YkHalfVecGrid::getHalfPtr(idxs, alloc_step_idx));
+#ifdef TRACE_MEM
+            printElem("readElem", idxs, e, line);
+#endif
+            return e;
+        }
+
+        // Write or update one element.
+        virtual void writeElem(real_t val,
+                               const Indices& idxs,
+                               idx_t alloc_step_idx,
+                               int line) final {
+            auto* ep = const_cast<uint16_t*>(getHalfPtr(idxs, alloc_step_idx));
+            *ep = half_vec_t::from_real(val);
+#ifdef TRACE_MEM
+            printElem("writeElem", idxs, val, line);
+#endif
+        }
+        virtual void addToElem(real_t val,
+                               const Indices& idxs,
+                               idx_t alloc_step_idx,
+                               int line) final {
+            auto* ep = const_cast<uint16_t*>(getHalfPtr(idxs, alloc_step_idx));
+
+            // No 16-bit atomic FP add, so use compare-and-swap.
+            uint16_t old = __atomic_load_n(ep, __ATOMIC_RELAXED);
+            uint16_t sum;
+            do {
+                sum = half_vec_t::from_real(half_vec_t::to_real(old) + val);
+            } while (!__atomic_compare_exchange_n(ep, &old, sum, false,
+                                                  __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+#ifdef TRACE_MEM
+            printElem("addToElem", idxs, half_vec_t::to_real(sum), line);
+#endif
+        }
+
+        // Get a pointer to given 16-bit vector.
+        // Indices must be normalized and rank-relative.
+        inline const half_vec_t* getVecPtrNorm(const Indices& vec_idxs,
+                                               idx_t alloc_step_idx,
+                                               bool checkBounds=true) const {
+            static constexpr int nvls = sizeof...(_templ_vec_lens);
+            Indices adj_idxs(nvls);
+
+            // Special handling for step index.
+            auto sp = Indices::step_posn;
+            if (_wrap_step_idx) {
+                assert(alloc_step_idx == _wrap_step(vec_idxs[sp]));
+                adj_idxs[sp] = alloc_step_idx;
+            }
+
+            // All other indices.
+#pragma unroll
+            for (int i = 0; i < nvls; i++) {
+                if (!(_wrap_step_idx && i == sp))
+                    adj_idxs[i] = vec_idxs[i] - _vec_local_offsets[i] + _vec_left_pads[i];
+            }
+            return _data.getPtr(adj_idxs, checkBounds);
+        }
+        inline half_vec_t* getVecPtrNorm(const Indices& vec_idxs,
+                                         idx_t alloc_step_idx,
+                                         bool checkBounds=true) {
+            const half_vec_t* p =
+                const_cast<const YkHalfVecGrid*>(this)->getVecPtrNorm(vec_idxs,
+                                                                      alloc_step_idx, checkBounds);
+            return const_cast<half_vec_t*>(p);
+        }
+
+        // Read and up-convert one vector.
+        // Indices must be normalized and rank-relative.
+        inline real_vec_t readVecNorm(const Indices& vec_idxs,
+                                      idx_t alloc_step_idx,
+                                      int line) const {
+            real_vec_t v = *getVecPtrNorm(vec_idxs, alloc_step_idx);
+#ifdef TRACE_MEM
+            printVecNorm("readVecNorm", vec_idxs, v, line);
+#endif
+            return v;
+        }
+
+        // Prefetch one vector.
+        // Indices must be normalized and rank-relative.
+        template <int level>
+        ALWAYS_INLINE
+        void prefetchVecNorm(const Indices& vec_idxs,
+                             idx_t alloc_step_idx,
+                             int line) const {
+            auto p = getVecPtrNorm(vec_idxs, alloc_step_idx, false);
+            prefetch<level>(p);
+#ifdef MODEL_CACHE
+            cache_model.prefetch(p, level, line);
+#endif
+        }
+
+    };                          // YkHalfVecGrid.
+
 }                               // namespace.
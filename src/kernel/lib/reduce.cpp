@@ -0,0 +1,139 @@
+/*****************************************************************************
+
+YASK: Yet Another Stencil Kernel
+Copyright (c) 2014-2018, Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+
+*****************************************************************************/
+
+
+// This file contains implementations of StencilContext methods
+// for reducing the elements of grids across all threads and ranks.
+
+#include "yask_stencil.hpp"
+using namespace std;
+
+namespace yask {
+
+    // Reduce the domain of a grid.
+    yk_reduction_ptr StencilContext::reduce_grid(const string& grid_name,
+                                                 idx_t step_index) {
+        auto gi = gridMap.find(grid_name);
+        if (gi == gridMap.end())
+            THROW_YASK_EXCEPTION("Error: reduce_grid() called with unknown grid '" +
+                                 grid_name + "'");
+        auto gp = gi->second;
+        int ndims = gp->get_num_dims();
+        vector<idx_t> first(ndims), last(ndims);
+        for (int i = 0; i < ndims; i++) {
+            auto& dname = gp->get_dim_name(i);
+            if (dname == _dims->_step_dim)
+                first[i] = last[i] = step_index;
+            else if (_dims->_domain_dims.lookup(dname)) {
+                first[i] = gp->get_first_rank_domain_index(dname);
+                last[i] = gp->get_last_rank_domain_index(dname);
+            }
+            else {
+                first[i] = gp->get_first_misc_index(dname);
+                last[i] = gp->get_last_misc_index(dname);
+            }
+        }
+        return reduce_grid_in_slice(grid_name, first, last);
+    }
+
+    // Reduce a slice of a grid.
+    yk_reduction_ptr StencilContext::reduce_grid_in_slice(const string& grid_name,
+                                                          const vector<idx_t>& first_indices,
+                                                          const vector<idx_t>& last_indices) {
+        auto gi = gridMap.find(grid_name);
+        if (gi == gridMap.end())
+            THROW_YASK_EXCEPTION("Error: reduce_grid_in_slice() called with unknown grid '" +
+                                 grid_name + "'");
+        auto gp = gi->second;
+        if (!gp->is_storage_allocated())
+            THROW_YASK_EXCEPTION("Error: reduce_grid_in_slice() called on grid '" +
+                                 grid_name + "' without storage");
+        int ndims = gp->get_num_dims();
+        if (int(first_indices.size()) != ndims || int(last_indices.size()) != ndims)
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: reduce_grid_in_slice() called with " <<
+                                            first_indices.size() << " and " <<
+                                            last_indices.size() << " indices for grid '" <<
+                                            grid_name << "', which has " << ndims << " dim(s)");
+
+        // Limit the slice to this rank's domain in domain dims.
+        Indices first(first_indices), last(last_indices);
+        bool is_empty = false;
+        for (int i = 0; i < ndims; i++) {
+            auto& dname = gp->get_dim_name(i);
+            if (_dims->_domain_dims.lookup(dname)) {
+                first[i] = max(first[i], gp->get_first_rank_domain_index(dname));
+                last[i] = min(last[i], gp->get_last_rank_domain_index(dname));
+            }
+            if (last[i] < first[i])
+                is_empty = true;
+        }
+
+        // Reduce this rank's part.
+        auto res = make_shared<GridReduction>();
+        if (!is_empty)
+            gp->reduce_in_slice(first, last, *res);
+        TRACE_MSG("reduce_grid_in_slice('" << grid_name << "'): " <<
+                  res->nelems << " element(s) reduced on this rank");
+
+#ifdef USE_MPI
+        if (_env->num_ranks > 1) {
+            auto comm = _env->comm;
+
+            // Counts and sums.
+            double sums[] = { double(res->nelems), res->sum, res->sum_sq };
+            double all_sums[3];
+            MPI_Allreduce(sums, all_sums, 3, MPI_DOUBLE, MPI_SUM, comm);
+            res->nelems = idx_t(all_sums[0]);
+            res->sum = all_sums[1];
+            res->sum_sq = all_sums[2];
+
+            // Extremes and the ranks holding them.
+            struct { double val; int rank; } ext[3], all_ext[3];
+            ext[0] = { res->min_val, _env->my_rank };
+            ext[1] = { -res->max_val, _env->my_rank };
+            ext[2] = { -res->max_abs, _env->my_rank };
+            MPI_Allreduce(ext, all_ext, 3, MPI_DOUBLE_INT, MPI_MINLOC, comm);
+            res->min_val = all_ext[0].val;
+            res->max_val = -all_ext[1].val;
+            res->max_abs = -all_ext[2].val;
+
+            // Send indices from the ranks holding the extremes.
+            Indices* idxs[] = { &res->min_idxs, &res->max_idxs, &res->max_abs_idxs };
+            for (int j = 0; j < 3; j++) {
+                if (!res->nelems)
+                    break;
+                vector<idx_t> buf(ndims);
+                if (all_ext[j].rank == _env->my_rank)
+                    for (int i = 0; i < ndims; i++)
+                        buf[i] = (*idxs[j])[i];
+                MPI_Bcast(buf.data(), ndims, MPI_INTEGER8, all_ext[j].rank, comm);
+                *idxs[j] = Indices(buf);
+            }
+        }
+#endif
+        return res;
+    }
+
+} // namespace yask.
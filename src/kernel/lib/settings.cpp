@@ -87,17 +87,36 @@ namespace yask {
         comm = MPI_COMM_WORLD;
         MPI_Comm_rank(comm, &my_rank);
         MPI_Comm_size(comm, &num_ranks);
+
+        // Find the ranks that can share memory with this one.
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, my_rank, MPI_INFO_NULL, &shm_comm);
+        int num_shm_ranks = 0;
+        MPI_Comm_size(shm_comm, &num_shm_ranks);
+        vector<int> node_ranks(num_shm_ranks);
+        MPI_Allgather(&my_rank, 1, MPI_INT, node_ranks.data(), 1, MPI_INT, shm_comm);
+        shm_ranks.assign(num_ranks, MPI_PROC_NULL);
+        for (int i = 0; i < num_shm_ranks; i++)
+            shm_ranks.at(node_ranks[i]) = i;
 #else
         comm = 0;
+        shm_comm = 0;
+        shm_ranks.assign(1, 0);
 #endif
 
         // Turn off denormals unless the USE_DENORMALS macro is set.
 #ifndef USE_DENORMALS
+#if defined(__aarch64__)
+        // Enable FZ in FPCR, which flushes both inputs and results.
+        uint64_t fpcr;
+        __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+        __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | (uint64_t(1) << 24)));
+#else
         // Enable FTZ
         _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
 
         //Enable DAZ
         _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+#endif
 #endif
 
         // Set env vars needed by OMP.
@@ -121,9 +140,8 @@ namespace yask {
                                   int neigh_rank, // MPI rank.
                                   int neigh_index)> visitor) {
 
-        // TODO: convert to use visitAllPoints().
         for (int i = 0; i < neighborhood_size; i++) {
-            auto neigh_offsets = neighborhood_sizes.unlayout(i);
+            auto& neigh_offsets = neighbor_offsets[i];
             int neigh_rank = my_neighbors.at(i);
             assert(i == getNeighborIndex(neigh_offsets));
 
@@ -222,13 +240,34 @@ namespace yask {
         _add_domain_option(parser, "sb", "Sub-block size", _sub_block_sizes);
         _add_domain_option(parser, "mp", "Minimum grid-padding size (including halo)", _min_pad_sizes);
         _add_domain_option(parser, "ep", "Extra grid-padding size (beyond halo)", _extra_pad_sizes);
+        _add_domain_option(parser, "brick", "Storage-brick size of grids with bricked layouts"
+                           " (zero to keep each grid's setting)", _brick_sizes);
 #ifdef USE_MPI
         _add_domain_option(parser, "nr", "Num ranks", _num_ranks);
         _add_domain_option(parser, "ri", "This rank's logical index", _rank_indices);
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("auto_rank_layout",
+                           "When the numbers of ranks don't multiply to the number of active ranks, "
+                           "choose the numbers in the dims not set above one to minimize halo "
+                           "exchange. Also place the ranks on each node in a tile that minimizes "
+                           "halo exchange between nodes.",
+                           auto_rank_layout));
         parser.add_option(new CommandLineParser::IntOption
                           ("msg_rank",
                            "Index of MPI rank that will print informational messages.",
                            msg_rank));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("overlap_comms",
+                           "Overlap MPI halo exchange with computation: "
+                           "calculate the outer shell of each rank domain, "
+                           "start the halo exchange, and then calculate the "
+                           "interior while the messages are in flight.",
+                           overlap_comms));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("combine_halos",
+                           "Send the halos of all grids exchanged with a neighbor "
+                           "in one message instead of one message per grid.",
+                           combine_halos));
 #endif
         parser.add_option(new CommandLineParser::IntOption
                           ("max_threads",
@@ -238,10 +277,332 @@ namespace yask {
                           ("thread_divisor",
                            "Divide max OpenMP threads by <integer>.",
                            thread_divisor));
+        parser.add_option(new CommandLineParser::IntOption
+                          ("pfd_l1",
+                           "Distance in vector-clusters to prefetch ahead into the L1 cache; "
+                           "0 to disable.",
+                           _prefetch_L1_dist));
+        parser.add_option(new CommandLineParser::IntOption
+                          ("pfd_l2",
+                           "Distance in vector-clusters to prefetch ahead into the L2 cache; "
+                           "0 to disable.",
+                           _prefetch_L2_dist));
+        {
+            stringstream msg;
+            msg << "Hint used when prefetching into the L1 cache: " <<
+                _MM_HINT_T0 << " for T0, " << _MM_HINT_T1 << " for T1, " <<
+                _MM_HINT_T2 << " for T2, or " << _MM_HINT_NTA << " for NTA.";
+            parser.add_option(new CommandLineParser::IntOption
+                              ("pfh_l1", msg.str(),
+                               _prefetch_L1_hint));
+        }
+        parser.add_option(new CommandLineParser::IntOption
+                          ("pfh_l2",
+                           "Hint used when prefetching into the L2 cache; "
+                           "values are the same as for '-pfh_l1'.",
+                           _prefetch_L2_hint));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("nt_stores",
+                           "Use non-temporal (streaming) stores when writing grids that "
+                           "are not read at the same step index by any equation. "
+                           "Not used when temporal tiling is enabled.",
+                           nt_stores));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("perf_counters",
+                           "Collect hardware performance counts (cycles, instructions, "
+                           "last-level-cache references and misses) for each bundle pack "
+                           "and for halo exchanges. Requires Linux perf_event access.",
+                           perf_counters));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("measure_energy",
+                           "Measure the energy used in run_solution() and report "
+                           "joules per step and points per joule. Uses a node-level "
+                           "energy counter if available or the RAPL counters in "
+                           "/sys/class/powercap, which may require read permission.",
+                           measure_energy));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("rank_stats",
+                           "Gather the compute, halo-exchange and halo-wait times and the "
+                           "throughput of every rank in get_stats() and report their "
+                           "min, mean, max and std-dev and the slowest ranks. "
+                           "get_stats() must then be called on all ranks.",
+                           rank_stats));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("step_stats",
+                           "Record the time of each step in run_solution() and report "
+                           "percentiles, a histogram and outlier steps in get_stats(). "
+                           "Steps done together in a wave-front share the mean time of the group.",
+                           step_stats));
+        parser.add_option(new CommandLineParser::StringOption
+                          ("tune_objective",
+                           "Quantity maximized by the auto-tuner: "
+                           "'rate' (steps per second), "
+                           "'energy' (steps per joule), or "
+                           "'edp' (inverse of the energy-delay product). "
+                           "Falls back to 'rate' if energy cannot be measured.",
+                           tune_objective));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("roofline",
+                           "Report throughput predicted by a roofline model "
+                           "along with the achieved throughput. The model uses the "
+                           "est-FP-ops, the grids read and written by each bundle, their "
+                           "halos relative to the block size, and the temporal-tiling depth.",
+                           roofline));
+        parser.add_option(new CommandLineParser::IdxOption
+                          ("peak_mem_gbps",
+                           "Peak memory bandwidth per rank in GB/s used by the roofline model. "
+                           "If zero (0), it is measured with a triad loop.",
+                           peak_mem_gbps));
+        parser.add_option(new CommandLineParser::IdxOption
+                          ("peak_gflops",
+                           "Peak FP rate per rank in GFLOPS used by the roofline model. "
+                           "If zero (0), it is measured with a multiply-add loop.",
+                           peak_gflops));
+        parser.add_option(new CommandLineParser::IdxOption
+                          ("rebalance_interval",
+                           "Shift rank-domain boundaries to balance the measured compute time "
+                           "across ranks at the end of run_solution() after at least this many "
+                           "steps since the previous rebalancing. "
+                           "If zero (0), rebalancing is done only when requested via the API.",
+                           rebalance_interval));
+        parser.add_option(new CommandLineParser::IntOption
+                          ("rebalance_tolerance",
+                           "Do not rebalance ranks unless the slowest rank takes more than "
+                           "this percentage longer than the average.",
+                           rebalance_tolerance));
+        parser.add_option(new CommandLineParser::StringOption
+                          ("trace_file",
+                           "Record a timeline of regions, packs, blocks, sub-blocks, "
+                           "halo pack/send/wait/unpack and auto-tuner trials, and write it "
+                           "to '<string>.<rank>.json' in Chrome trace-event format "
+                           "when the solution is ended. Empty string disables tracing.",
+                           trace_file));
+        parser.add_option(new CommandLineParser::IntOption
+                          ("trace_max_events",
+                           "Maximum number of events kept per thread when tracing; "
+                           "older events are overwritten.",
+                           trace_max_events));
+        parser.add_option(new CommandLineParser::IdxOption
+                          ("max_full_bbs",
+                           "Maximum number of solid sub-boxes to use for a bundle whose "
+                           "sub-domain condition does not cover its bounding-box. "
+                           "If more would be needed, the whole bounding-box is used instead, "
+                           "and the condition is applied to each vector with a write mask.",
+                           max_full_bbs));
         parser.add_option(new CommandLineParser::IntOption
                           ("block_threads",
                            "Number of threads to use within each block.",
                            num_block_threads));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("steal_blocks",
+                           "Schedule the blocks in each region with per-thread queues "
+                           "and work stealing instead of the OpenMP loop. "
+                           "Each thread starts with a contiguous range of blocks. "
+                           "Not used with temporal tiling in blocks.",
+                           steal_blocks));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("prefetch_helpers",
+                           "Give each region thread a helper thread on a sibling hyperthread "
+                           "that prefetches the data read by the thread's next block into the L2 cache "
+                           "while the current block is calculated. "
+                           "Each thread evaluates a contiguous range of blocks in the scan order. "
+                           "Overrides -steal_blocks. "
+                           "Not used with temporal tiling in blocks.",
+                           prefetch_helpers));
+        parser.add_option(new CommandLineParser::IntOption
+                          ("numa_parts",
+                           "Number of NUMA sub-domains in each rank. "
+                           "If greater than one, the rank domain is split into equal slabs "
+                           "in the first domain dimension, rounded up to the block size. "
+                           "The grid data in each slab is moved to one NUMA node, "
+                           "and the blocks in each slab are evaluated by their own team of "
+                           "region threads bound to the CPUs of that node. "
+                           "Each team helps the others after finishing its own blocks. "
+                           "Overrides -prefetch_helpers and -steal_blocks. "
+                           "Not used with temporal tiling in blocks.",
+                           numa_parts));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("persistent_team",
+                           "Use one OpenMP thread team for all the steps in each call to "
+                           "run_solution() instead of starting a new team for each region "
+                           "and pack. Bundle packs are separated by barriers. "
+                           "Not used with temporal tiling, wave-fronts or comm/compute overlap.",
+                           persistent_team));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("diamond_tiling",
+                           "Use diamond tiles in the first domain dim instead of "
+                           "wave-fronts for temporal tiling across the rank. "
+                           "Alternating tiles that shrink and grow at each step are "
+                           "evaluated in two phases, so all the tiles in a phase start "
+                           "together. The region size in the first domain dim sets the "
+                           "tile width; other region sizes are not used. "
+                           "Only used when the region size in the step dim is > 1 "
+                           "and there is no temporal tiling in blocks.",
+                           diamond_tiling));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("cache_oblivious",
+                           "Recursively cut the rank domain in space and time along the "
+                           "wave-front angles instead of using regions and blocks. "
+                           "Trapezoids are cut in a domain dim while they are wide enough "
+                           "and in the step dim otherwise, and independent pieces are "
+                           "evaluated by OpenMP tasks, so no region or block sizes are "
+                           "needed. The region size in the step dim sets the number of "
+                           "steps between halo exchanges; other region and block sizes "
+                           "are not used. "
+                           "Only used when the region size in the step dim is > 1 "
+                           "and there is no temporal tiling in blocks.",
+                           cache_oblivious));
+        parser.add_option(new CommandLineParser::IdxOption
+                          ("halo_steps",
+                           "Number of steps between halo exchanges when there are no "
+                           "temporal wave-fronts. If > 1, the halos are deepened and the "
+                           "overlapping parts of the neighboring ranks are calculated "
+                           "redundantly, trading extra computation for fewer messages. "
+                           "Not used with comm/compute overlap.",
+                           halo_steps));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("use_shm",
+                           "Exchange halos with neighbor ranks on the same node through "
+                           "MPI shared-memory windows instead of messages. "
+                           "Each sender packs directly into memory that the receiver "
+                           "unpacks from. Neighbors on other nodes still use messages.",
+                           use_shm));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("persistent_reqs",
+                           "Create persistent MPI requests for the halo buffers once "
+                           "and start them in each exchange instead of posting new "
+                           "sends and receives. Not used with '-combine_halos', "
+                           "whose messages depend on the grids being exchanged.",
+                           persistent_reqs));
+        parser.add_option(new CommandLineParser::IntOption
+                          ("progress_threads",
+                           "Number of extra threads per rank that post, pack, unpack "
+                           "and drive the progress of halo exchanges while the OpenMP "
+                           "threads compute. Most useful with '-overlap_comms'. "
+                           "MPI calls from these threads are serialized.",
+                           progress_threads));
+        parser.add_option(new CommandLineParser::IntOption
+                          ("progress_cpu",
+                           "Bind progress thread i to CPU progress_cpu + i, e.g., "
+                           "a hyper-thread reserved for communication. "
+                           "If negative, progress threads are not bound.",
+                           progress_cpu));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("bind_block_threads",
+                           "Bind the threads of each block team to CPUs that share the "
+                           "smallest cache level with room for the whole team, e.g., the "
+                           "hyper-threads of a core or the cores of an L2 tile. "
+                           "The topology is read from /sys/devices/system/cpu.",
+                           bind_block_threads));
+        parser.add_option(new CommandLineParser::StringOption
+                          ("cpus",
+                           "Run the threads of this solution only on these logical CPUs, "
+                           "given as a list like '0-7,16-23', using one thread per CPU. "
+                           "Other solutions in the same process can run concurrently on "
+                           "other CPUs. Empty string uses the CPUs allowed to the calling "
+                           "thread and the number of threads from -max_threads.",
+                           cpu_list));
+        parser.add_option(new CommandLineParser::IdxOption
+                          ("validate_samples",
+                           "Number of randomly-placed blocks to check when validating. "
+                           "The reference is calculated only where needed to "
+                           "produce these blocks, so validation at full problem size "
+                           "takes much less time. If zero, the whole domain is checked.",
+                           validate_samples));
+        parser.add_option(new CommandLineParser::StringOption
+                          ("block_order",
+                           "Order in which to visit the blocks in each region: "
+                           "'loops' for the order of the generated loops, "
+                           "'morton' for Z-order or 'hilbert' for a Hilbert curve. "
+                           "Block-group sizes are not used with 'morton' or 'hilbert'.",
+                           block_order));
+        parser.add_option(new CommandLineParser::StringOption
+                          ("sub_block_order",
+                           "Order in which to visit the sub-blocks in each block: "
+                           "'loops', 'morton' or 'hilbert' as for '-block_order'.",
+                           sub_block_order));
+        parser.add_option(new CommandLineParser::IntOption
+                          ("region_loop_order",
+                           "Order of the dims in the generated loops over the blocks in each region "
+                           "when '-block_order loops' is used. "
+                           "Order 0 is the build-time order, e.g., x-y-z, and 1, 2, ... are its "
+                           "other permutations in lexicographic order, e.g., x-z-y, y-x-z, ..., "
+                           "up to the number compiled in. The unit-stride dim of the "
+                           "vectorized inner loop is not changed.",
+                           region_loop_order));
+        parser.add_option(new CommandLineParser::IntOption
+                          ("block_loop_order",
+                           "Order of the dims in the generated loops over the sub-blocks in each block "
+                           "when '-sub_block_order loops' is used, numbered as for '-region_loop_order'.",
+                           block_loop_order));
+        parser.add_option(new CommandLineParser::IntOption
+                          ("sub_block_loop_order",
+                           "Order of the dims in the generated loops over the vector-clusters "
+                           "in each sub-block, not including the inner unit-stride dim, "
+                           "numbered as for '-region_loop_order'.",
+                           sub_block_loop_order));
+        parser.add_option(new CommandLineParser::StringOption
+                          ("auto_tune_save_file",
+                           "Write the settings found by the auto-tuner to <string> "
+                           "as command-line options that can be given in later runs.",
+                           auto_tune_save_file));
+        parser.add_option(new CommandLineParser::StringOption
+                          ("auto_tune_db_file",
+                           "Tuning database used when auto-tuning before running. "
+                           "If the stencil, architecture, FP size, fold, cluster, thread count "
+                           "and rank-domain size match an entry in <string>, its settings are "
+                           "used without searching; otherwise, the settings found are added.",
+                           auto_tune_db_file));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("cache_sim",
+                           "Before running, replay the accesses of one block through a model "
+                           "of the caches for candidate block and sub-block sizes, "
+                           "apply the sizes with the lowest predicted cost, and "
+                           "narrow the auto-tuner's search around them.",
+                           cache_sim));
+        parser.add_option(new CommandLineParser::IdxOption
+                          ("cache_l1_kb",
+                           "L1 cache capacity per thread in KiB used by '-cache_sim'.",
+                           cache_l1_kb));
+        parser.add_option(new CommandLineParser::IdxOption
+                          ("cache_l2_kb",
+                           "L2 cache capacity per thread in KiB used by '-cache_sim'.",
+                           cache_l2_kb));
+        parser.add_option(new CommandLineParser::IdxOption
+                          ("cache_llc_kb",
+                           "Last-level cache capacity per thread in KiB used by '-cache_sim' "
+                           "(zero if there is no LLC).",
+                           cache_llc_kb));
+        {
+            stringstream msg;
+            msg << "Huge-page policy for allocating grids, scratch grids and MPI buffers: " <<
+                yask_huge_pages_none << " for none, " <<
+                yask_huge_pages_transparent << " for transparent huge pages, " <<
+                yask_huge_pages_2m << " for explicit 2MiB pages, or " <<
+                yask_huge_pages_1g << " for explicit 1GiB pages. "
+                "Explicit pages fall back to transparent ones when not available.";
+            parser.add_option(new CommandLineParser::IntOption
+                              ("huge_pages", msg.str(),
+                               _huge_pages));
+        }
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("first_touch",
+                           "Write each new grid from the threads that will evaluate each block "
+                           "and each new scratch grid from its thread, so that pages "
+                           "are placed on the NUMA node of their users when not bound to a node.",
+                           _first_touch));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("auto_pad",
+                           "Add padding to the unit-stride dim of each new grid, beyond "
+                           "that from '-mp' and '-ep', and stagger the starts of the grids "
+                           "so that the neighbors read by the stencils and the grids used "
+                           "together do not map to the same cache sets.",
+                           _auto_pad));
+        parser.add_option(new CommandLineParser::BoolOption
+                          ("reuse_scratch",
+                           "Share the per-thread storage of scratch grids whose "
+                           "values are not needed at the same time within a block.",
+                           _reuse_scratch));
 #ifdef USE_NUMA
         stringstream msg;
         msg << "Preferred NUMA node on which to allocate data for "
@@ -252,9 +613,173 @@ namespace yask {
         parser.add_option(new CommandLineParser::IntOption
                           ("numa_pref", msg.str(),
                            _numa_pref));
+        parser.add_option(new CommandLineParser::IntOption
+                          ("hbm_numa_node",
+                           "NUMA node of high-bandwidth memory (HBM) to be filled with the "
+                           "most frequently accessed grids, up to the '-hbm_mb' capacity. "
+                           "Other grids use the '-numa_pref' node. "
+                           "Grids with their own NUMA preference are not moved.",
+                           _hbm_numa_node));
+        parser.add_option(new CommandLineParser::IdxOption
+                          ("hbm_mb",
+                           "Capacity in MiB of the '-hbm_numa_node' node available for grids.",
+                           _hbm_mb));
 #endif
     }
 
+    ScanOrder get_scan_order(const string& name) {
+        if (name == "loops")
+            return scan_order_loops;
+        if (name == "morton")
+            return scan_order_morton;
+        if (name == "hilbert")
+            return scan_order_hilbert;
+        THROW_YASK_EXCEPTION("Error: unknown traversal order '" + name +
+                             "'; use 'loops', 'morton' or 'hilbert'");
+    }
+
+    int get_num_loop_orders(int ndims) {
+        int n = 1;
+        for (int i = 2; i <= ndims && n < LOOP_ORDERS; i++)
+            n *= i;
+        return min(n, LOOP_ORDERS);
+    }
+
+    string get_loop_order_str(const vector<string>& dims, int order) {
+        vector<string> pool(dims);
+        if (order < 0 || order >= get_num_loop_orders(int(dims.size())))
+            order = 0; // the generated code uses order 0 for unknown orders.
+        int f = 1;
+        for (int i = 2; i < int(pool.size()); i++)
+            f *= i;
+        string str;
+        for (int n = int(pool.size()); n > 0; n--) {
+            int i = order / f;
+            order %= f;
+            if (str.length())
+                str += "-";
+            str += pool[i];
+            pool.erase(pool.begin() + i);
+            if (n > 1)
+                f /= n - 1;
+        }
+        return str;
+    }
+
+    // Position of 'x' on an n-D Hilbert curve through 2^bits points
+    // in each dim. This is the "transpose" algorithm from J. Skilling,
+    // "Programming the Hilbert curve", AIP Conf. Proc. 707, 2004,
+    // followed by interleaving the bits of the transposed coordinates.
+    static uint64_t hilbertKey(vector<uint64_t> x, int bits) {
+        int n = int(x.size());
+        uint64_t m = uint64_t(1) << (bits - 1);
+
+        // Inverse undo.
+        for (uint64_t q = m; q > 1; q >>= 1) {
+            uint64_t p = q - 1;
+            for (int i = 0; i < n; i++) {
+                if (x[i] & q)
+                    x[0] ^= p;
+                else {
+                    uint64_t t = (x[0] ^ x[i]) & p;
+                    x[0] ^= t;
+                    x[i] ^= t;
+                }
+            }
+        }
+
+        // Gray encode.
+        for (int i = 1; i < n; i++)
+            x[i] ^= x[i - 1];
+        uint64_t t = 0;
+        for (uint64_t q = m; q > 1; q >>= 1)
+            if (x[n - 1] & q)
+                t ^= q - 1;
+        for (int i = 0; i < n; i++)
+            x[i] ^= t;
+
+        // Interleave.
+        uint64_t key = 0;
+        for (int b = bits - 1; b >= 0; b--)
+            for (int i = 0; i < n; i++)
+                key = (key << 1) | ((x[i] >> b) & 1);
+        return key;
+    }
+
+    // Position of 'x' in Z-order: the bits of 'x' interleaved.
+    static uint64_t mortonKey(const vector<uint64_t>& x, int bits) {
+        uint64_t key = 0;
+        for (int b = bits - 1; b >= 0; b--)
+            for (auto xi : x)
+                key = (key << 1) | ((xi >> b) & 1);
+        return key;
+    }
+
+    void get_sub_ranges(const ScanIndices& idxs, ScanOrder order,
+                        vector<ScanIndices>& subs) {
+        int nsdims = idxs.ndims;
+        auto step_posn = Indices::step_posn;
+
+        // Aligned begin points and number of sub-ranges in each dim.
+        Indices aligned_begin(idxs.begin);
+        Indices num_iters(nsdims);
+        num_iters.setFromConst(1);
+        idx_t nsubs = 1, max_iters = 1;
+        for (int i = 0; i < nsdims; i++) {
+            if (i == step_posn) continue;
+            idx_t step = idxs.step[i];
+            idx_t align = min(idxs.align[i], step);
+            aligned_begin[i] = round_down_flr(idxs.begin[i] - idxs.align_ofs[i], align) +
+                idxs.align_ofs[i];
+            num_iters[i] = max(ceil_idiv_flr(idxs.end[i] - aligned_begin[i], step), idx_t(0));
+            nsubs *= num_iters[i];
+            max_iters = max(max_iters, num_iters[i]);
+        }
+        if (nsubs <= 0)
+            return;
+
+        // Lexical order.
+        size_t first = subs.size();
+        ScanIndices sub_idxs(idxs);
+        for (idx_t n = 0; n < nsubs; n++) {
+            idx_t sn = n;
+            for (int i = nsdims - 1; i >= 0; i--) {
+                if (i == step_posn) continue;
+                idx_t si = sn % num_iters[i];
+                sn /= num_iters[i];
+                idx_t step = idxs.step[i];
+                sub_idxs.start[i] = max(aligned_begin[i] + si * step, idxs.begin[i]);
+                sub_idxs.stop[i] = min(aligned_begin[i] + (si + 1) * step, idxs.end[i]);
+                sub_idxs.index[i] = si;
+            }
+            subs.push_back(sub_idxs);
+        }
+
+        // Sort by position on the curve. Use lexical order if the
+        // keys would not fit in 64 bits.
+        int bits = 1;
+        while ((idx_t(1) << bits) < max_iters)
+            bits++;
+        if (order == scan_order_loops || (nsdims - 1) * bits > 64)
+            return;
+        vector<pair<uint64_t, size_t>> keys;
+        vector<uint64_t> x;
+        for (size_t k = first; k < subs.size(); k++) {
+            x.clear();
+            for (int i = 0; i < nsdims; i++)
+                if (i != step_posn)
+                    x.push_back(uint64_t(subs[k].index[i]));
+            keys.push_back({ (order == scan_order_hilbert) ?
+                        hilbertKey(x, bits) : mortonKey(x, bits), k });
+        }
+        sort(keys.begin(), keys.end());
+        vector<ScanIndices> sorted;
+        sorted.reserve(keys.size());
+        for (auto& key : keys)
+            sorted.push_back(subs[key.second]);
+        copy(sorted.begin(), sorted.end(), subs.begin() + first);
+    }
+
     // Print usage message.
     void KernelSettings::print_usage(ostream& os,
                                       CommandLineParser& parser,
@@ -307,7 +832,11 @@ namespace yask {
             " Set block sizes to specify a unit of work done by each thread team.\n"
             "  A block size of 0 in a given dimension =>\n"
             "   block size is set to region size in that dimension.\n"
-            "  Temporal tiling in blocks is not yet supported, so effectively, bt = 1.\n"
+            "  Set the block size in the step dimension (-bt) to a value greater than one\n"
+            "   to enable temporal tiling in blocks, i.e., each block is evaluated over\n"
+            "   multiple steps using wave-front skewing within each region.\n"
+            "   The region size in the step dimension is increased to match if needed.\n"
+            "   Blocks are then evaluated sequentially; all threads are used in each block.\n"
             " Set block-group sizes to control the ordering of blocks within a region.\n"
             "  All blocks that intersect a given block-group are evaluated before blocks\n"
             "   in the next block-group.\n"
@@ -337,13 +866,30 @@ namespace yask {
             "  Num threads per region = max_threads / thread_divisor / block_threads.\n"
             "  Num threads per block = block_threads.\n"
             "  Num threads per sub-block = 1.\n"
-            "  Num threads used for halo exchange is same as num per region.\n" <<
+            "  Num threads used for halo exchange is same as num per region.\n"
+            "Auto-tuning:\n"
+            " The auto-tuner searches region sizes (when using wave-front tiling),\n"
+            "  block sizes, block threads, sub-block sizes, and L1 and L2\n"
+            "  prefetch distances, in that order.\n"
+            " Use '-auto_tune_save_file <file>' to save the final settings;\n"
+            "  passing the contents of <file> as options in a later run\n"
+            "  reproduces them without tuning.\n"
+            " Use '-auto_tune_db_file <file>' to keep the settings for many\n"
+            "  configurations in one file; a matching entry is applied without tuning.\n"
+            " Use '-cache_sim' to start from the block and sub-block sizes with the fewest\n"
+            "  misses predicted by a model of the caches and search fewer sizes around them.\n" <<
 #ifdef USE_MPI
             "Controlling MPI scaling:\n"
             "  To 'weak-scale' to a larger overall-problem size, use multiple MPI ranks\n"
             "   and keep the rank-domain sizes constant.\n"
             "  To 'strong-scale' a given overall-problem size, use multiple MPI ranks\n"
-            "   and reduce the size of each rank-domain appropriately.\n" <<
+            "   and reduce the size of each rank-domain appropriately.\n"
+            "  Use '-overlap_comms' to hide halo-exchange latency behind computation\n"
+            "   of the interior of each rank-domain.\n"
+            "   This is only done when temporal wave-front tiling is not used.\n"
+            "  Use '-combine_halos' to reduce the number of messages when there\n"
+            "   are many grids; halos of grids between the first and last ones\n"
+            "   exchanged at a given step are then also sent.\n" <<
 #endif
             appNotes <<
             "Examples:\n" <<
@@ -400,6 +946,40 @@ namespace yask {
     void KernelSettings::adjustSettings(std::ostream& os, KernelEnvPtr env) {
         auto& step_dim = _dims->_step_dim;
 
+        // Check traversal orders.
+        get_scan_order(block_order);
+        get_scan_order(sub_block_order);
+
+        // Check loop orders. Orders that are not compiled in for this
+        // number of dims use order 0, as the generated code does.
+        if (region_loop_order < 0 || block_loop_order < 0 || sub_block_loop_order < 0)
+            THROW_YASK_EXCEPTION("Error: loop orders cannot be negative");
+        int nddims = _dims->_domain_dims.getNumDims();
+        for (auto* lo : { &region_loop_order, &block_loop_order, &sub_block_loop_order }) {
+            int nlo = get_num_loop_orders((lo == &sub_block_loop_order) ? nddims - 1 : nddims);
+            if (*lo >= nlo) {
+                os << "Using loop order 0 instead of " << *lo << " because only " <<
+                    nlo << " order(s) are available.\n";
+                *lo = 0;
+            }
+        }
+
+        // Use one thread per CPU if CPUs are given.
+        if (!CpuTopology::parse_cpu_list(cpu_list, _cpus))
+            THROW_YASK_EXCEPTION("Error: invalid CPU list '" + cpu_list + "'");
+        if (_cpus.size())
+            max_threads = int(_cpus.size());
+
+        // Temporal tiling in blocks is done within each temporal
+        // wave-front, so regions need at least as many steps as blocks.
+        auto bt = _block_sizes[step_dim];
+        if (bt > 1 && _region_sizes[step_dim] > 0 && _region_sizes[step_dim] < bt) {
+            os << "Adjusting region size in '" << step_dim << "' dim from " <<
+                _region_sizes[step_dim] << " to " << bt <<
+                " to match block size for temporal tiling." << endl;
+            _region_sizes[step_dim] = bt;
+        }
+
         // Determine num regions.
         // Also fix up region sizes as needed.
         // Default region size (if 0) will be size of rank-domain.
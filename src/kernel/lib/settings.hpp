@@ -66,10 +66,10 @@ namespace yask {
         Indices(const std::initializer_list<idx_t>& src) {
             setFromInitList(src);
         }
-        Indices(const idx_t src[], int ndims) {
+        Indices(const idx_t src[], int ndims) : _ndims(ndims) {
             setFromArray(src, ndims);
         }
-        Indices(idx_t src, int ndims) {
+        Indices(idx_t src, int ndims) : _ndims(ndims) {
             setFromConst(src, ndims);
         }
 
@@ -352,6 +352,8 @@ namespace yask {
         MPI_Comm comm=0;        // communicator.
         int num_ranks=1;        // total number of ranks.
         int my_rank=0;          // MPI-assigned index.
+        MPI_Comm shm_comm=0;    // communicator of ranks sharing memory with this one.
+        std::vector<int> shm_ranks; // index in 'shm_comm' of each rank or MPI_PROC_NULL.
 
         // OMP vars.
         int max_threads=0;      // initial value from OMP.
@@ -528,6 +530,29 @@ namespace yask {
         }
     };
 
+    // Orders for visiting the sub-ranges of a ScanIndices at run-time.
+    // 'scan_order_loops' uses the generated loops when possible; when a
+    // list is needed, it is in lexical order with the last dim
+    // unit-stride.
+    enum ScanOrder { scan_order_loops, scan_order_morton, scan_order_hilbert };
+
+    // Get the order from its name: "loops", "morton" or "hilbert".
+    ScanOrder get_scan_order(const std::string& name);
+
+    // Append the sub-ranges of 'idxs' of size 'idxs.step' in each
+    // domain dim to 'subs' in the given order. The step index is not
+    // changed.
+    void get_sub_ranges(const ScanIndices& idxs, ScanOrder order,
+                        std::vector<ScanIndices>& subs);
+
+    // Orders of the generated region, block and sub-block loops.
+    // Up to LOOP_ORDERS permutations of the dims in the first loop of
+    // each are compiled in; order 'k' is permutation 'k' of the given
+    // dims in lexicographic order of their positions, the same numbering
+    // used by gen_loops.pl. Order 0 is the order given at build time.
+    int get_num_loop_orders(int ndims);
+    std::string get_loop_order_str(const std::vector<std::string>& dims, int order);
+
     // MPI neighbor info.
     class MPIInfo {
 
@@ -578,6 +603,11 @@ namespace yask {
         // sizes as a multiple of the vector length.
         std::vector<bool> has_all_vlen_mults;
 
+        // NeighborOffset vals of each neighbor, made once so visiting
+        // neighbors doesn't rebuild them.
+        // Vector index is per getNeighborIndex().
+        std::vector<IdxTuple> neighbor_offsets;
+
         // Ctor based on pre-set problem dimensions.
         MPIInfo(DimsPtr dims) : _dims(dims) {
 
@@ -595,6 +625,8 @@ namespace yask {
             my_neighbors.resize(neighborhood_size, MPI_PROC_NULL);
             man_dists.resize(neighborhood_size, 0);
             has_all_vlen_mults.resize(neighborhood_size, false);
+            for (idx_t i = 0; i < neighborhood_size; i++)
+                neighbor_offsets.push_back(neighborhood_sizes.unlayout(i));
         }
 
         // Get a 1D index for a neighbor.
@@ -626,6 +658,24 @@ namespace yask {
         std::shared_ptr<char> _base;
         real_t* _elems = 0;
 
+        // Index in the shared-memory communicator of a neighbor on the
+        // same node when exchanging through shared memory, else MPI_PROC_NULL.
+        // Then, the buffer is in the sender's shared-memory window, and
+        // the counts of packs by the sender and unpacks by the receiver
+        // are in the cache lines just before it.
+        int shm_rank = MPI_PROC_NULL;
+        std::atomic<idx_t>* _shm_packs = 0;
+        std::atomic<idx_t>* _shm_unpacks = 0;
+        bool is_shm() const {
+            return _shm_packs != 0;
+        }
+
+#ifdef USE_MPI
+        // Persistent request for sending or receiving this buffer
+        // when using '-persistent_reqs'.
+        MPI_Request _preq = MPI_REQUEST_NULL;
+#endif
+
         // Range to copy to/from grid.
         // NB: step index not set properly for grids with step dim.
         IdxTuple begin_pt, last_pt;
@@ -656,6 +706,7 @@ namespace yask {
         void release_storage() {
             _base.reset();
             _elems = 0;
+            _shm_packs = _shm_unpacks = 0;
         }
 
         // Reset.
@@ -664,6 +715,7 @@ namespace yask {
             begin_pt.clear();
             last_pt.clear();
             num_pts.clear();
+            shm_rank = MPI_PROC_NULL;
             release_storage();
         }
         ~MPIBuf() {
@@ -733,25 +785,90 @@ namespace yask {
         IdxTuple _sub_block_sizes;       // sub-block size (used for each nested thread).
         IdxTuple _min_pad_sizes;         // minimum spatial padding.
         IdxTuple _extra_pad_sizes;       // extra spatial padding.
+        IdxTuple _brick_sizes;           // storage-brick sizes of bricked grids (0 => keep).
 
         // MPI settings.
         IdxTuple _num_ranks;       // number of ranks in each dim.
         IdxTuple _rank_indices;    // my rank index in each dim.
         bool find_loc = true;      // whether my rank index needs to be calculated.
+        bool auto_rank_layout = true; // whether to choose num ranks and node placement.
         int msg_rank = 0;          // rank that prints informational messages.
+        bool overlap_comms = false; // whether to overlap halo exchange with computation.
+        bool combine_halos = false; // whether to send all grids' halos in one message per neighbor.
+        bool nt_stores = false;   // whether to use streaming stores where allowed.
+        bool perf_counters = false; // whether to collect HW perf counts per pack.
+        bool measure_energy = false; // whether to measure energy in run_solution().
+        bool rank_stats = false;   // whether to gather per-rank times in get_stats().
+        bool step_stats = false;   // whether to record the time of each step.
+        std::string tune_objective = "rate"; // "rate", "energy", or "edp".
+        bool roofline = false;     // whether to report a roofline model.
+        idx_t peak_mem_gbps = 0;   // peak mem BW per rank in GB/s; 0 => measure.
+        idx_t peak_gflops = 0;     // peak FP rate per rank in GFLOPS; 0 => measure.
+        idx_t rebalance_interval = 0; // steps between rank rebalancing; 0 => never.
+        int rebalance_tolerance = 5; // max rank-time imbalance (%) before rebalancing.
+        std::string trace_file;    // where to write the event timeline; empty => no tracing.
+        int trace_max_events = 100000; // ring-buffer size per thread for tracing.
+        idx_t max_full_bbs = 16;   // max solid BBs per bundle before using masked vectors.
 
         // OpenMP settings.
         int max_threads = 0;      // Initial number of threads to use overall; 0=>OMP default.
         int thread_divisor = 1;   // Reduce number of threads by this amount.
         int num_block_threads = 1; // Number of threads to use for a block.
-
-        // Prefetch distances.
-        // Prefetching must be enabled via YASK_PREFETCH_L[12] macros.
-        int _prefetch_L1_dist = 1;
-        int _prefetch_L2_dist = 2;
+        bool steal_blocks = false; // Use work stealing to schedule blocks in a region.
+        bool prefetch_helpers = false; // Prefetch next blocks from sibling hyperthreads.
+        int numa_parts = 1;        // NUMA sub-domains in the rank.
+        bool persistent_team = false; // Use one thread team for all steps in run_solution().
+        bool diamond_tiling = false; // Use diamond tiles instead of wave-fronts in the rank.
+        bool cache_oblivious = false; // Use recursive space-time cuts in the rank.
+        idx_t halo_steps = 1;      // Steps between halo exchanges w/o wave-fronts.
+        bool use_shm = false;      // Exchange halos through shared memory on a node.
+        bool persistent_reqs = false; // Use persistent MPI requests for halos.
+        int progress_threads = 0;  // Threads per rank for halo exchanges.
+        int progress_cpu = -1;     // First CPU for progress threads; <0 => not bound.
+        bool bind_block_threads = false; // Bind each block team to CPUs sharing a cache.
+        std::string cpu_list;      // CPUs for this solution's threads; empty => not restricted.
+        std::vector<int> _cpus;    // CPUs from cpu_list.
+        idx_t validate_samples = 0; // Blocks checked in validation; 0 => whole domain.
+        std::string block_order = "loops"; // order of blocks in a region.
+        std::string sub_block_order = "loops"; // order of sub-blocks in a block.
+        int region_loop_order = 0; // order of the generated loops over blocks in a region.
+        int block_loop_order = 0; // order of the generated loops over sub-blocks in a block.
+        int sub_block_loop_order = 0; // order of the generated loops in a sub-block.
+
+        // Prefetch distances in vector-clusters and hints.
+        // Defaults are from the PFD_L[12] macros.
+        // A distance of zero disables prefetching to that level.
+        int _prefetch_L1_dist = PFD_L1;
+        int _prefetch_L2_dist = PFD_L2;
+        int _prefetch_L1_hint = L1_HINT;
+        int _prefetch_L2_hint = L2_HINT;
 
         // NUMA settings.
         int _numa_pref = NUMA_PREF;
+        int _hbm_numa_node = yask_numa_none; // HBM node for planned placement.
+        idx_t _hbm_mb = 0;                   // HBM capacity for grids in MiB.
+
+        // Huge-page policy for grids, scratch grids and MPI buffers.
+        int _huge_pages = yask_huge_pages_none;
+
+        // Whether to touch new grid pages from the threads that use them.
+        bool _first_touch = true;
+
+        // Whether to pick extra padding and grid offsets to avoid cache-set conflicts.
+        bool _auto_pad = true;
+
+        // Whether scratch grids with disjoint lifetimes share storage.
+        bool _reuse_scratch = true;
+
+        // Auto-tuner settings.
+        std::string auto_tune_save_file; // where to write the tuned settings.
+        std::string auto_tune_db_file; // tuning database used by run_auto_tuner_now().
+
+        // Cache-simulator settings.
+        bool cache_sim = false;      // predict block and sub-block sizes before running.
+        idx_t cache_l1_kb = CACHE_L1_KB; // per-thread cache capacities.
+        idx_t cache_l2_kb = CACHE_L2_KB;
+        idx_t cache_llc_kb = CACHE_LLC_KB; // 0 => no LLC.
 
         // Ctor.
         KernelSettings(DimsPtr dims, KernelEnvPtr env) :
@@ -786,6 +903,9 @@ namespace yask {
             _extra_pad_sizes = dims->_stencil_dims;
             _extra_pad_sizes.setValsSame(0);
 
+            _brick_sizes = dims->_domain_dims;
+            _brick_sizes.setValsSame(0);
+
             // Use domain dims only for MPI tuples.
             _num_ranks = dims->_domain_dims;
             _num_ranks.setValsSame(1);
@@ -836,6 +956,9 @@ namespace yask {
         virtual bool is_time_tiling() {
             return _region_sizes[_dims->_step_dim] > 1;
         }
+        virtual bool is_block_time_tiling() {
+            return _block_sizes[_dims->_step_dim] > 1;
+        }
     };
     typedef std::shared_ptr<KernelSettings> KernelSettingsPtr;
 
@@ -31,6 +31,186 @@ using namespace std;
 
 namespace yask {
 
+    // Visit each way to factor 'target' into one value per element of
+    // 'limits' such that each value divides its limit.
+    static void visitFactorings(const vector<idx_t>& limits,
+                                idx_t target,
+                                vector<idx_t>& vals,
+                                function<void (const vector<idx_t>&)> visitor) {
+        size_t i = vals.size();
+        if (i == limits.size()) {
+            if (target == 1)
+                visitor(vals);
+            return;
+        }
+        for (idx_t v = 1; v <= target; v++) {
+            if (target % v == 0 && limits[i] % v == 0) {
+                vals.push_back(v);
+                visitFactorings(limits, target / v, vals, visitor);
+                vals.pop_back();
+            }
+        }
+    }
+
+    // Choose the number of ranks in each domain dim if the requested
+    // numbers don't multiply to the number of active ranks, and find my
+    // rank's coordinates. Requested numbers > 1 are kept.  The
+    // decomposition minimizes the number of halo points exchanged over
+    // all grids. When there are multiple nodes, the ranks on each node
+    // are placed in a tile that minimizes the number of points exchanged
+    // between nodes.
+    void StencilContext::chooseRankLayout() {
+        ostream& os = get_ostr();
+        auto& ddims = _dims->_domain_dims;
+        int nddims = ddims.getNumDims();
+        idx_t nranks = _env->num_ranks;
+        auto me = _env->my_rank;
+
+        // Number of halo points sent across one rank face perpendicular to
+        // each dim, summed over the grids. Use the sizes from rank 0 so
+        // that every rank makes the same decisions.
+        vector<double> face_pts(nddims, 0.);
+        for (int di = 0; di < nddims; di++) {
+            auto& dname = ddims.getDimName(di);
+            double area = 1.;
+            for (int dj = 0; dj < nddims; dj++)
+                if (dj != di)
+                    area *= max(_opts->_rank_sizes[ddims.getDimName(dj)], idx_t(1));
+            for (auto gp : gridPtrs) {
+                if (gp->is_fixed_size() || !gp->is_dim_used(dname))
+                    continue;
+                face_pts[di] += area * (gp->get_left_halo_size(dname) +
+                                        gp->get_right_halo_size(dname));
+            }
+        }
+#ifdef USE_MPI
+        MPI_Bcast(face_pts.data(), nddims, MPI_DOUBLE, 0, _env->comm);
+#endif
+
+        // Points exchanged across the boundaries between tiles of 'tiles'
+        // ranks when there are 'nums' ranks in each dim.
+        auto cost = [&](const vector<idx_t>& nums, const vector<idx_t>& tiles) {
+            double pts = 0.;
+            for (int di = 0; di < nddims; di++)
+                pts += double(nums[di] / tiles[di] - 1) *
+                    double(nranks / nums[di]) * face_pts[di];
+            return pts;
+        };
+        vector<idx_t> ones(nddims, 1), vals;
+
+        // Decomposition.
+        vector<idx_t> nums(nddims);
+        for (int di = 0; di < nddims; di++)
+            nums[di] = _opts->_num_ranks[di];
+        if (_opts->auto_rank_layout &&
+            _opts->_num_ranks.product() != nranks) {
+
+            // Spread the ranks not used by requested dims over the others.
+            // If the requested dims can't be filled exactly, leave the
+            // layout alone so the mismatch is reported in setupRank().
+            idx_t req = 1;
+            vector<idx_t> limits(nddims);
+            for (int di = 0; di < nddims; di++) {
+                limits[di] = (nums[di] > 1) ? 1 : nranks;
+                if (nums[di] > 1)
+                    req *= nums[di];
+            }
+            idx_t nfree = (nranks % req == 0) ? nranks / req : 0;
+            if (nfree > 0 && _opts->_num_ranks.product() == req) {
+                double best_cost = -1.;
+                idx_t best_max = 0;
+                vector<idx_t> best;
+                visitFactorings
+                    (limits, nfree, vals,
+                     [&](const vector<idx_t>& fvals) {
+                        vector<idx_t> nvals(nddims);
+                        idx_t nmax = 0;
+                        for (int di = 0; di < nddims; di++) {
+                            nvals[di] = fvals[di] * max(nums[di], idx_t(1));
+                            nmax = max(nmax, nvals[di]);
+                        }
+                        double c = cost(nvals, ones);
+
+                        // Prefer fewer points, then a more balanced
+                        // layout, then more ranks in the outer dims.
+                        if (best.empty() || c < best_cost ||
+                            (c == best_cost && nmax < best_max) ||
+                            (c == best_cost && nmax == best_max && nvals > best)) {
+                            best = nvals;
+                            best_cost = c;
+                            best_max = nmax;
+                        }
+                    });
+                nums = best;
+                for (int di = 0; di < nddims; di++)
+                    _opts->_num_ranks[di] = nums[di];
+                os << "Automatically chose num-ranks " <<
+                    _opts->_num_ranks.makeDimValStr(" * ") << " to exchange " <<
+                    makeNumStr(best_cost) << " halo point(s) per step.\n";
+            }
+        }
+        if (_opts->_num_ranks.product() != nranks)
+            return;
+
+        // Without node info, use the MPI ordering.
+        _opts->_rank_indices = _opts->_num_ranks.unlayout(me);
+
+#ifdef USE_MPI
+        if (!_opts->auto_rank_layout)
+            return;
+
+        // Use this only when every node has the same number of ranks.
+        int node_ranks = 0, min_node_ranks = 0, max_node_ranks = 0;
+        MPI_Comm_size(_env->shm_comm, &node_ranks);
+        MPI_Allreduce(&node_ranks, &min_node_ranks, 1, MPI_INT, MPI_MIN, _env->comm);
+        MPI_Allreduce(&node_ranks, &max_node_ranks, 1, MPI_INT, MPI_MAX, _env->comm);
+        idx_t nnodes = nranks / node_ranks;
+        if (min_node_ranks != max_node_ranks || nnodes < 2)
+            return;
+
+        // Give each node an index, and each rank an index within its node.
+        // The lowest-numbered rank on each node is its index 0, so ordering
+        // those ranks gives the node indices.
+        int my_local = _env->shm_ranks.at(me);
+        int my_node = 0;
+        MPI_Comm leader_comm;
+        MPI_Comm_split(_env->comm, (my_local == 0) ? 0 : MPI_UNDEFINED, me, &leader_comm);
+        if (my_local == 0) {
+            MPI_Comm_rank(leader_comm, &my_node);
+            MPI_Comm_free(&leader_comm);
+        }
+        MPI_Bcast(&my_node, 1, MPI_INT, 0, _env->shm_comm);
+
+        // Pick the node tile that exchanges the fewest points between
+        // nodes, i.e., that keeps the heaviest faces within nodes.
+        double best_cost = -1.;
+        vector<idx_t> best;
+        visitFactorings
+            (nums, node_ranks, vals,
+             [&](const vector<idx_t>& tvals) {
+                double c = cost(nums, tvals);
+                if (best.empty() || c < best_cost) {
+                    best = tvals;
+                    best_cost = c;
+                }
+            });
+        if (best.empty())
+            return;
+        IdxTuple tile(_opts->_num_ranks), node_grid(_opts->_num_ranks);
+        for (int di = 0; di < nddims; di++) {
+            tile[di] = best[di];
+            node_grid[di] = nums[di] / best[di];
+        }
+        auto node_idxs = node_grid.unlayout(my_node);
+        auto local_idxs = tile.unlayout(my_local);
+        for (int di = 0; di < nddims; di++)
+            _opts->_rank_indices[di] = node_idxs[di] * tile[di] + local_idxs[di];
+        os << "Placing ranks in tiles of " << tile.makeDimValStr(" * ") <<
+            " on each of " << nnodes << " node(s) to exchange " <<
+            makeNumStr(best_cost) << " halo point(s) per step between nodes.\n";
+#endif
+    }
+
     // Init MPI-related vars and other vars related to my rank's place in
     // the global problem: rank index, offset, etc.  Need to call this even
     // if not using MPI to properly init these vars.  Called from
@@ -41,6 +221,10 @@ namespace yask {
         auto me = _env->my_rank;
         int num_neighbors = 0;
 
+        // Determine my coordinates if not provided already.
+        if (_opts->find_loc)
+            chooseRankLayout();
+
         // Check ranks.
         idx_t req_ranks = _opts->_num_ranks.product();
         if (req_ranks != _env->num_ranks) {
@@ -50,150 +234,164 @@ namespace yask {
         }
         assertEqualityOverRanks(_opts->_rank_sizes[step_dim], _env->comm, "num steps");
 
-        // Determine my coordinates if not provided already.
-        // TODO: do this more intelligently based on proximity.
-        if (_opts->find_loc)
-            _opts->_rank_indices = _opts->_num_ranks.unlayout(me);
-
-        // A table of rank-coordinates for everyone.
+        // Only my neighbors' info is exchanged below, so the time and
+        // memory used here don't grow with the number of ranks.
         auto num_ddims = _opts->_rank_indices.size(); // domain-dims only!
-        idx_t coords[_env->num_ranks][num_ddims];
+        auto& my_coords = _opts->_rank_indices;
 
         // Init offsets and total sizes.
         rank_domain_offsets.setValsSame(0);
         overall_domain_sizes.setValsSame(0);
 
-        // Init coords for this rank.
-        for (int i = 0; i < num_ddims; i++)
-            coords[me][i] = _opts->_rank_indices[i];
-
-        // A table of rank-domain sizes for everyone.
-        idx_t rsizes[_env->num_ranks][num_ddims];
-
-        // Init sizes for this rank.
+        // Sizes of this rank.
+        vector<idx_t> my_sizes(num_ddims);
         for (int di = 0; di < num_ddims; di++) {
-            auto& dname = _opts->_rank_indices.getDimName(di);
+            auto& dname = my_coords.getDimName(di);
             auto rsz = _opts->_rank_sizes[dname];
-            rsizes[me][di] = rsz;
+            my_sizes[di] = rsz;
             overall_domain_sizes[dname] = rsz;
         }
 
 #ifdef USE_MPI
-        // Exchange coord and size info between all ranks.
-        for (int rn = 0; rn < _env->num_ranks; rn++) {
-            MPI_Bcast(&coords[rn][0], num_ddims, MPI_INTEGER8,
-                      rn, _env->comm);
-            MPI_Bcast(&rsizes[rn][0], num_ddims, MPI_INTEGER8,
-                      rn, _env->comm);
-        }
-        // Now, the tables are filled in for all ranks.
-
-        // Loop over all ranks, including myself.
-        for (int rn = 0; rn < _env->num_ranks; rn++) {
-
-            // Coord offset of rn from me: prev => negative, self => 0, next => positive.
-            IdxTuple rcoords(_dims->_domain_dims);
-            IdxTuple rdeltas(_dims->_domain_dims);
-            for (int di = 0; di < num_ddims; di++) {
-                rcoords[di] = coords[rn][di];
-                rdeltas[di] = coords[rn][di] - _opts->_rank_indices[di];
-            }
-
-            // Manhattan distance from rn (sum of abs deltas in all dims).
-            // Max distance in any dim.
-            int mandist = 0;
-            int maxdist = 0;
-            for (int di = 0; di < num_ddims; di++) {
-                mandist += abs(rdeltas[di]);
-                maxdist = max(maxdist, abs(int(rdeltas[di])));
-            }
-
-            // Myself.
-            if (rn == me) {
-                if (mandist != 0)
-                    FORMAT_AND_THROW_YASK_EXCEPTION
-                        ("Internal error: distance to own rank == " << mandist);
-            }
-
-            // Someone else.
-            else {
-                if (mandist == 0)
-                    FORMAT_AND_THROW_YASK_EXCEPTION
-                        ("Error: ranks " << me <<
-                         " and " << rn << " at same coordinates");
-            }
-
-            // Loop through domain dims.
-            for (int di = 0; di < num_ddims; di++) {
-                auto& dname = _opts->_rank_indices.getDimName(di);
-
-                // Is rank 'rn' in-line with my rank in 'dname' dim?
-                // True when deltas in other dims are zero.
-                bool is_inline = true;
-                for (int dj = 0; dj < num_ddims; dj++) {
-                    if (di != dj && rdeltas[dj] != 0) {
-                        is_inline = false;
-                        break;
-                    }
-                }
-
-                // Process ranks that are in-line in 'dname', including self.
-                if (is_inline) {
-
-                    // Accumulate total problem size in each dim for ranks that
-                    // intersect with this rank, not including myself.
-                    if (rn != me)
-                        overall_domain_sizes[dname] += rsizes[rn][di];
-
-                    // Adjust my offset in the global problem by adding all domain
-                    // sizes from prev ranks only.
-                    if (rdeltas[di] < 0)
-                        rank_domain_offsets[dname] += rsizes[rn][di];
-
-                    // Make sure all the other dims are the same size.
-                    // This ensures that all the ranks' domains line up
-                    // properly along their edges and at their corners.
-                    for (int dj = 0; dj < num_ddims; dj++) {
-                        if (di != dj) {
-                            auto mysz = rsizes[me][dj];
-                            auto rnsz = rsizes[rn][dj];
-                            if (mysz != rnsz) {
-                                auto& dnamej = _opts->_rank_indices.getDimName(dj);
-                                FORMAT_AND_THROW_YASK_EXCEPTION
-                                    ("Error: rank " << rn << " and " << me <<
-                                     " are both at rank-index " << coords[me][di] <<
-                                     " in the '" << dname <<
-                                     "' dimension , but their rank-domain sizes are " <<
-                                     rnsz << " and " << mysz <<
-                                     " (resp.) in the '" << dj <<
-                                     "' dimension, making them unaligned");
-                            }
-                        }
-                    }
+        // Make sure my coords are in range.
+        int my_err = 0;
+        for (int di = 0; di < num_ddims; di++)
+            if (my_coords[di] < 0 || my_coords[di] >= _opts->_num_ranks[di])
+                my_err = 1;
+        int any_err = 0;
+        MPI_Allreduce(&my_err, &any_err, 1, MPI_INT, MPI_MAX, _env->comm);
+        if (any_err)
+            FORMAT_AND_THROW_YASK_EXCEPTION
+                ("Error: rank-indices must be less than the number of ranks (" <<
+                 _opts->_num_ranks.makeDimValStr(" * ") << ") in each dimension; rank " <<
+                 me << " is at " << my_coords.makeDimValStr());
+
+        // Make a communicator where each rank's index is the 1D layout of
+        // its coords. If the coords are unique, every rank will find its
+        // layout index there.
+        idx_t my_lin = _opts->_num_ranks.layout(my_coords);
+        MPI_Comm lin_comm;
+        MPI_Comm_split(_env->comm, 0, int(my_lin), &lin_comm);
+        int lin_rank = 0;
+        MPI_Comm_rank(lin_comm, &lin_rank);
+        my_err = (lin_rank != my_lin) ? 1 : 0;
+        MPI_Allreduce(&my_err, &any_err, 1, MPI_INT, MPI_MAX, _env->comm);
+        if (any_err) {
+            MPI_Comm_free(&lin_comm);
+            FORMAT_AND_THROW_YASK_EXCEPTION
+                ("Error: more than one rank is at the same rank-indices; rank " <<
+                 me << " is at " << my_coords.makeDimValStr());
+        }
+        MPI_Group world_grp, lin_grp;
+        MPI_Comm_group(_env->comm, &world_grp);
+        MPI_Comm_group(lin_comm, &lin_grp);
+
+        // Along each dim, find the overall size and my offset using the
+        // ranks in-line with mine, and make sure their sizes in the other
+        // dims match mine. This ensures that all the ranks' domains line
+        // up properly along their edges and at their corners.
+        my_err = 0;
+        for (int di = 0; di < num_ddims; di++) {
+            auto& dname = my_coords.getDimName(di);
+
+            // Ranks in-line with me in 'dname', ordered by their coord.
+            IdxTuple line_coords(my_coords);
+            line_coords[di] = 0;
+            MPI_Comm line_comm;
+            MPI_Comm_split(_env->comm, int(_opts->_num_ranks.layout(line_coords)),
+                           int(my_coords[di]), &line_comm);
+
+            idx_t osz = 0, ofs = 0;
+            MPI_Allreduce(&my_sizes[di], &osz, 1, MPI_INTEGER8, MPI_SUM, line_comm);
+            MPI_Exscan(&my_sizes[di], &ofs, 1, MPI_INTEGER8, MPI_SUM, line_comm);
+            overall_domain_sizes[dname] = osz;
+            rank_domain_offsets[dname] = (my_coords[di] == 0) ? 0 : ofs;
+
+            vector<idx_t> min_sizes(num_ddims), max_sizes(num_ddims);
+            MPI_Allreduce(my_sizes.data(), min_sizes.data(), num_ddims, MPI_INTEGER8,
+                          MPI_MIN, line_comm);
+            MPI_Allreduce(my_sizes.data(), max_sizes.data(), num_ddims, MPI_INTEGER8,
+                          MPI_MAX, line_comm);
+            for (int dj = 0; dj < num_ddims; dj++) {
+                if (di != dj && min_sizes[dj] != max_sizes[dj]) {
+                    my_err = 1;
+                    os << "Error: the ranks at rank-index " << my_coords[di] <<
+                        " in the '" << dname << "' dimension have rank-domain sizes from " <<
+                        min_sizes[dj] << " to " << max_sizes[dj] << " in the '" <<
+                        my_coords.getDimName(dj) << "' dimension, making them unaligned\n";
                 }
             }
+            MPI_Comm_free(&line_comm);
+        }
+        MPI_Allreduce(&my_err, &any_err, 1, MPI_INT, MPI_MAX, _env->comm);
+        if (any_err) {
+            MPI_Group_free(&lin_grp);
+            MPI_Group_free(&world_grp);
+            MPI_Comm_free(&lin_comm);
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: rank domains are not aligned");
+        }
 
-            // Rank rn is myself or my immediate neighbor if its distance <= 1 in
-            // every dim.  Assume we do not need to exchange halos except
-            // with immediate neighbor. We validate this assumption below by
-            // making sure that the rank domain size is at least as big as the
-            // largest halo.
-            if (maxdist <= 1) {
-
-                // At this point, rdeltas contains only -1..+1 for each domain dim.
-                // Add one to -1..+1 to get 0..2 range for my_neighbors offsets.
-                IdxTuple roffsets = rdeltas.addElements(1);
-                assert(rdeltas.min() >= -1);
-                assert(rdeltas.max() <= 1);
-                assert(roffsets.min() >= 0);
-                assert(roffsets.max() <= 2);
-
-                // Convert the offsets into a 1D index.
+        // Find my immediate neighbors from their coords.  Assume we do not
+        // need to exchange halos except with immediate neighbors. We
+        // validate this assumption later by making sure that the rank
+        // domain size is at least as big as the largest halo.
+        vector<int> nranks(_mpiInfo->neighborhood_size, MPI_PROC_NULL);
+        _mpiInfo->neighborhood_sizes.visitAllPoints
+            ([&](const IdxTuple& roffsets, size_t idx) {
+
+                // Coords of neighbor.
+                IdxTuple rcoords(my_coords);
+                for (int di = 0; di < num_ddims; di++)
+                    rcoords[di] = my_coords[di] + roffsets[di] - 1;
+                for (int di = 0; di < num_ddims; di++)
+                    if (rcoords[di] < 0 || rcoords[di] >= _opts->_num_ranks[di])
+                        return true; // no neighbor here; keep visiting.
+
+                // Convert its layout index to its rank.
+                int rn_lin = int(_opts->_num_ranks.layout(rcoords));
+                int rn = MPI_PROC_NULL;
+                MPI_Group_translate_ranks(lin_grp, 1, &rn_lin, world_grp, &rn);
                 auto rn_ofs = _mpiInfo->getNeighborIndex(roffsets);
-                TRACE_MSG("neighborhood size = " << _mpiInfo->neighborhood_sizes.makeDimValStr() <<
-                          " & roffsets of rank " << rn << " = " << roffsets.makeDimValStr() <<
-                          " => " << rn_ofs);
-                assert(idx_t(rn_ofs) < _mpiInfo->neighborhood_size);
+                nranks.at(rn_ofs) = rn;
+                return true;
+            });
+        MPI_Group_free(&lin_grp);
+        MPI_Group_free(&world_grp);
+        MPI_Comm_free(&lin_comm);
+
+        // Exchange sizes with my neighbors.
+        vector<vector<idx_t>> nsizes(_mpiInfo->neighborhood_size, my_sizes);
+        vector<MPI_Request> reqs;
+        for (int rn_ofs = 0; rn_ofs < _mpiInfo->neighborhood_size; rn_ofs++) {
+            auto rn = nranks[rn_ofs];
+            if (rn == MPI_PROC_NULL || rn == me)
+                continue;
+            reqs.push_back(MPI_REQUEST_NULL);
+            MPI_Irecv(nsizes[rn_ofs].data(), num_ddims, MPI_INTEGER8,
+                      rn, 0, _env->comm, &reqs.back());
+            reqs.push_back(MPI_REQUEST_NULL);
+            MPI_Isend(my_sizes.data(), num_ddims, MPI_INTEGER8,
+                      rn, 0, _env->comm, &reqs.back());
+        }
+        MPI_Waitall(int(reqs.size()), reqs.data(), MPI_STATUSES_IGNORE);
+
+        // Save info about myself and each neighbor.
+        _mpiInfo->neighborhood_sizes.visitAllPoints
+            ([&](const IdxTuple& roffsets, size_t idx) {
+                auto rn_ofs = _mpiInfo->getNeighborIndex(roffsets);
+                auto rn = nranks[rn_ofs];
+                if (rn == MPI_PROC_NULL)
+                    return true;
+
+                // Coord offset of rn from me: prev => negative, self => 0, next => positive.
+                IdxTuple rcoords(my_coords);
+                IdxTuple rdeltas(my_coords);
+                int mandist = 0;
+                for (int di = 0; di < num_ddims; di++) {
+                    rdeltas[di] = roffsets[di] - 1;
+                    rcoords[di] = my_coords[di] + rdeltas[di];
+                    mandist += abs(rdeltas[di]);
+                }
 
                 // Save rank of this neighbor into the MPI info object.
                 _mpiInfo->my_neighbors.at(rn_ofs) = rn;
@@ -208,13 +406,11 @@ namespace yask {
                 // Save manhattan dist.
                 _mpiInfo->man_dists.at(rn_ofs) = mandist;
 
-                // Loop through domain dims.
+                // Does rn have all VLEN-multiple sizes?
                 bool vlen_mults = true;
                 for (int di = 0; di < num_ddims; di++) {
-                    auto& dname = _opts->_rank_indices.getDimName(di);
-
-                    // Does rn have all VLEN-multiple sizes?
-                    auto rnsz = rsizes[rn][di];
+                    auto& dname = my_coords.getDimName(di);
+                    auto rnsz = nsizes[rn_ofs][di];
                     auto vlen = _dims->_fold_pts[di];
                     if (rnsz % vlen != 0) {
                         TRACE_MSG("cannot use vector halo exchange with rank " << rn <<
@@ -225,10 +421,8 @@ namespace yask {
 
                 // Save vec-mult flag.
                 _mpiInfo->has_all_vlen_mults.at(rn_ofs) = vlen_mults;
-
-            } // self or immediate neighbor in any direction.
-
-        } // ranks.
+                return true;
+            });
 #endif
 
         // Set offsets in grids and find WF extensions
@@ -269,8 +463,14 @@ namespace yask {
             else
                 os << " using NUMA policy " << numa_pref;
 #endif
+            if (_opts->_huge_pages != yask_huge_pages_none)
+                os << " using huge-page policy " << _opts->_huge_pages;
+            if (_mem_pool)
+                os << " from memory pool";
             os << "...\n" << flush;
-            auto p = shared_numa_alloc<char>(nb, numa_pref);
+            auto p = _mem_pool ?
+                _mem_pool->alloc(nb, numa_pref, _opts->_huge_pages) :
+                shared_numa_alloc<char>(nb, numa_pref, _opts->_huge_pages);
             TRACE_MSG("Got memory at " << static_cast<void*>(p.get()));
 
             // Save using original key.
@@ -288,6 +488,15 @@ namespace yask {
         // Key is preferred numa node or -1 for local.
         map <int, shared_ptr<char>> _grid_data_buf;
 
+        // Padding changes the sizes, so it is planned first.
+        size_t stagger = planGridPadding(os);
+
+        // NUMA nodes chosen by the HBM planner, if any.
+        auto hbm_plan = planHbmPlacement(os);
+
+        // Grids allocated here that may be placed by first touch.
+        GridPtrs new_grids;
+
         // Pass 0: count required size for each NUMA node, allocate chunk of memory at end.
         // Pass 1: distribute parts of already-allocated memory chunk.
         for (int pass = 0; pass < 2; pass++) {
@@ -306,7 +515,16 @@ namespace yask {
                 // Grid data.
                 // Don't alloc if already done.
                 if (!gp->is_storage_allocated()) {
-                    int numa_pref = gp->get_numa_preferred();
+                    int numa_pref = hbm_plan.count(gname) ?
+                        hbm_plan.at(gname) : gp->get_numa_preferred();
+
+                    // Start each grid at a different offset from the
+                    // others within the aliasing distance.
+                    if (stagger) {
+                        size_t target = (ngrids[numa_pref] * stagger) % _alias_bytes;
+                        npbytes[numa_pref] += (target + _alias_bytes -
+                                               npbytes[numa_pref] % _alias_bytes) % _alias_bytes;
+                    }
 
                     // Set storage if buffer has been allocated in pass 0.
                     if (pass == 1) {
@@ -314,6 +532,8 @@ namespace yask {
                         assert(p);
                         gp->set_storage(p, npbytes[numa_pref]);
                         os << gp->make_info_string() << endl;
+                        if (numa_pref < 0 && numa_pref != yask_numa_interleave)
+                            new_grids.push_back(gp);
                     }
 
                     // Determine padded size (also offset to next location).
@@ -336,14 +556,411 @@ namespace yask {
                 _alloc_data(npbytes, ngrids, _grid_data_buf, "grid");
 
         } // grid passes.
+
+        moveGridsToNumaParts(new_grids, os);
+        if (_opts->_first_touch)
+            first_touch_grids(new_grids, os);
     };
 
+    // Split the first domain dim into equal slabs, rounded up to the
+    // block size so that each block starts in one slab. Each slab gets
+    // the next node that has CPUs available to this process.
+    void StencilContext::setupNumaParts(ostream& os) {
+        _numa_part_begins.clear();
+        _numa_part_nodes.clear();
+        _numa_part_cpus.clear();
+        if (_opts->numa_parts <= 1)
+            return;
+
+        auto& dname = _dims->_domain_dims.getDimName(0);
+        int xp = _dims->_stencil_dims.lookup_posn(dname);
+        idx_t rbegin = rank_bb.bb_begin[dname];
+        idx_t rend = rank_bb.bb_end[dname];
+        idx_t bsize = max(_opts->_block_sizes[xp], idx_t(1));
+        idx_t width = ROUND_UP(CEIL_DIV(rend - rbegin, idx_t(_opts->numa_parts)), bsize);
+        for (idx_t b = rbegin; b < rend; b += width)
+            _numa_part_begins.push_back(b);
+
+        vector<int> nodes;
+        vector<vector<int>> cpus;
+        bool have_nodes = CpuTopology::find_numa_nodes(nodes, cpus, _opts->_cpus);
+        os << "NUMA sub-domains in '" << dname << "':";
+        for (size_t p = 0; p < _numa_part_begins.size(); p++) {
+            idx_t last = (p + 1 < _numa_part_begins.size()) ?
+                _numa_part_begins[p + 1] - 1 : rend - 1;
+            _numa_part_nodes.push_back(have_nodes ? nodes[p % nodes.size()] : -1);
+            _numa_part_cpus.push_back(have_nodes ? cpus[p % cpus.size()] : vector<int>());
+            os << " " << _numa_part_begins[p] << "..." << last;
+            if (have_nodes)
+                os << " (node " << _numa_part_nodes[p] << ")";
+        }
+        os << endl;
+        if (!have_nodes)
+            os << "Warning: NUMA nodes not found; sub-domains will not be bound to nodes.\n";
+    }
+
+    // The pages from the first element of each slab in each outer step
+    // slot through the last one are moved, so the slab dim must have the
+    // largest stride of the dims other than the step dim.
+    void StencilContext::moveGridsToNumaParts(const GridPtrs& grids, ostream& os) {
+        size_t nparts = _numa_part_begins.size();
+        if (!nparts || !grids.size() || _numa_part_nodes[0] < 0)
+            return;
+        auto& step_dim = _dims->_step_dim;
+        auto& dname = _dims->_domain_dims.getDimName(0);
+        uintptr_t psize = sysconf(_SC_PAGESIZE);
+
+        int nmoved = 0;
+        bool ok = true;
+        for (auto gp : grids) {
+            if (!gp || !gp->is_storage_allocated() || gp->is_bricked())
+                continue;
+            int ngdims = gp->get_num_dims();
+            int xi = gp->get_dim_posn(dname);
+            if (xi < 0)
+                continue;
+            auto strides = gp->get_storage_strides();
+            int si = -1;
+            bool contig = true;
+            for (int i = 0; i < ngdims; i++) {
+                if (gp->get_dim_name(i) == step_dim)
+                    si = i;
+                else if (i != xi && strides[i] >= strides[xi])
+                    contig = false;
+            }
+            if (!contig)
+                continue;
+
+            // Step slots outside the slab dim are moved one at a time.
+            idx_t nslots = (si >= 0) ? gp->get_alloc_size(step_dim) : 1;
+            bool step_outer = si >= 0 && strides[si] > strides[xi];
+            Indices first(ngdims), last(ngdims);
+            for (int i = 0; i < ngdims; i++) {
+                if (i == si)
+                    continue;
+                first[i] = gp->_get_first_alloc_index(i);
+                last[i] = gp->_get_last_alloc_index(i);
+            }
+            for (idx_t s = 0; s < (step_outer ? nslots : 1); s++) {
+                if (si >= 0) {
+                    first[si] = step_outer ? s : 0;
+                    last[si] = step_outer ? s : nslots - 1;
+                }
+                for (size_t p = 0; ok && p < nparts; p++) {
+                    Indices pfirst(first), plast(last);
+                    if (p > 0)
+                        pfirst[xi] = _numa_part_begins[p];
+                    if (p + 1 < nparts)
+                        plast[xi] = _numa_part_begins[p + 1] - 1;
+                    auto bp = uintptr_t(gp->getElemAddr(pfirst, (si < 0) ? 0 : first[si], false));
+                    auto ep = uintptr_t(gp->getElemAddr(plast, (si < 0) ? 0 : last[si], false));
+                    bp = ROUND_DOWN(bp, psize);
+                    ep = (p + 1 < nparts) ? ROUND_DOWN(ep, psize) : ROUND_UP(ep + 1, psize);
+                    if (ep > bp)
+                        ok = numaMove((void*)bp, ep - bp, _numa_part_nodes[p]);
+                }
+            }
+            if (!ok)
+                break;
+            nmoved++;
+        }
+        if (ok)
+            os << "Moved the data of " << nmoved << " grid(s) to the nodes of their "
+                "NUMA sub-domains.\n";
+        else
+            os << "Warning: NUMA binding not available; grid data not moved.\n";
+    }
+
+    // Write zeros into 'grids' from the threads that will evaluate each
+    // block, so that pages allocated with a local or default NUMA policy
+    // are placed on the node of the thread that uses them. The blocks
+    // of each region are dealt to the region threads in order, as the
+    // default 'dynamic,1' region schedule does when blocks take equal time.
+    // Blocks on the edges of the extended rank also touch the halos and
+    // pads beyond them.
+    void StencilContext::first_touch_grids(const GridPtrs& grids, ostream& os) {
+        if (!grids.size() || ext_bb.bb_size < 1)
+            return;
+        YaskTimer ftimer;
+        ftimer.start();
+        auto& step_dim = _dims->_step_dim;
+
+        // Regions over the extended rank for one step.
+        IdxTuple begin(_dims->_stencil_dims);
+        begin.setVals(ext_bb.bb_begin, false);
+        begin[step_dim] = 0;
+        IdxTuple end(_dims->_stencil_dims);
+        end.setVals(ext_bb.bb_end, false);
+        end[step_dim] = 1;
+        IdxTuple step(_dims->_stencil_dims);
+        step.setVals(_opts->_region_sizes, false);
+        step[step_dim] = 1;
+        ScanIndices rank_idxs(*_dims, true, &rank_domain_offsets);
+        rank_idxs.begin = begin;
+        rank_idxs.end = end;
+        rank_idxs.step = step;
+        vector<ScanIndices> regions;
+        get_sub_ranges(rank_idxs, scan_order_loops, regions);
+
+        // Stencil-dim position of each dim in each grid, or -1 if it is
+        // not a domain dim.
+        vector<vector<int>> posns(grids.size());
+        for (size_t gi = 0; gi < grids.size(); gi++) {
+            auto gp = grids[gi];
+            for (int i = 0; i < gp->get_num_dims(); i++) {
+                auto& dname = gp->get_dim_name(i);
+                posns[gi].push_back(_dims->_domain_dims.lookup(dname) ?
+                                    _dims->_stencil_dims.lookup_posn(dname) : -1);
+            }
+        }
+
+        set_region_threads();
+        vector<ScanIndices> blocks;
+        for (auto& r : regions) {
+            ScanIndices region_idxs(*_dims, true, &rank_domain_offsets);
+            region_idxs.initFromOuter(r);
+            region_idxs.step = _opts->_block_sizes;
+            region_idxs.group_size = _opts->_block_group_sizes;
+            blocks.clear();
+            find_region_blocks(region_idxs, blocks);
+
+#pragma omp parallel for schedule(static, 1) proc_bind(spread)
+            for (idx_t bn = 0; bn < idx_t(blocks.size()); bn++) {
+                auto& b = blocks[bn];
+                for (size_t gi = 0; gi < grids.size(); gi++) {
+                    auto gp = grids[gi];
+                    int ngdims = gp->get_num_dims();
+                    Indices first(ngdims), last(ngdims);
+                    for (int i = 0; i < ngdims; i++) {
+                        int j = posns[gi][i];
+
+                        // All steps and misc indices.
+                        // Out-of-range indices are clamped below.
+                        if (j < 0) {
+                            bool is_step = gp->get_dim_name(i) == step_dim;
+                            first[i] = is_step ? 0 : idx_min;
+                            last[i] = is_step ?
+                                gp->get_alloc_size(step_dim) - 1 : idx_max;
+                        }
+
+                        // Block in domain dims, extended at the rank edges.
+                        else {
+                            auto& dname = gp->get_dim_name(i);
+                            first[i] = (b.start[j] <= ext_bb.bb_begin[dname]) ?
+                                idx_min : b.start[j];
+                            last[i] = (b.stop[j] >= ext_bb.bb_end[dname]) ?
+                                idx_max : b.stop[j] - 1;
+                        }
+                    }
+                    gp->set_elements_in_slice_same(0.0, first, last, false);
+                }
+            }
+        }
+        ftimer.stop();
+        os << "First-touch of " << grids.size() << " grid(s) done in " <<
+            makeNumStr(ftimer.get_elapsed_secs()) << " secs.\n";
+    }
+
+    // Place the most intensely-accessed grids in HBM.
+    // The intensity of a grid is estimated from the per-point read and
+    // write counts of each bundle that uses it, scaled by the size of the
+    // bundle's bounding box and shared evenly among the grids the bundle
+    // reads or writes. Grids are then taken in order of intensity per
+    // byte until the HBM capacity is used; the rest get the default node.
+    map<string, int> StencilContext::planHbmPlacement(ostream& os) {
+        map<string, int> plan;
+#ifdef USE_NUMA
+        int hbm_node = _opts->_hbm_numa_node;
+        if (hbm_node < 0 || _opts->_hbm_mb <= 0)
+            return plan;
+        size_t hbm_bytes = size_t(_opts->_hbm_mb) * 1024 * 1024;
+
+        // Access counts per grid.
+        map<string, double> accesses;
+        for (auto* sg : stBundles) {
+            double npts = double(sg->getBB().bb_num_points);
+            if (sg->inputGridPtrs.size()) {
+                double nr = npts * sg->get_scalar_points_read() /
+                    sg->inputGridPtrs.size();
+                for (auto gp : sg->inputGridPtrs)
+                    accesses[gp->get_name()] += nr;
+            }
+            if (sg->outputGridPtrs.size()) {
+                double nw = npts * sg->get_scalar_points_written() /
+                    sg->outputGridPtrs.size();
+                for (auto gp : sg->outputGridPtrs)
+                    accesses[gp->get_name()] += nw;
+            }
+        }
+
+        // Candidate grids sorted by accesses per byte.
+        struct HbmCand {
+            string name;
+            size_t nbytes;
+            double density;
+        };
+        vector<HbmCand> cands;
+        for (auto gp : gridPtrs) {
+            if (!gp || gp->is_storage_allocated() || gp->is_numa_preferred_set())
+                continue;
+            auto& gname = gp->get_name();
+            size_t nbytes = ROUND_UP(gp->get_num_storage_bytes() + _data_buf_pad,
+                                     CACHELINE_BYTES);
+            double na = accesses.count(gname) ? accesses.at(gname) : 0.;
+            cands.push_back({ gname, nbytes, na / max(nbytes, size_t(1)) });
+        }
+        stable_sort(cands.begin(), cands.end(),
+                    [](const HbmCand& a, const HbmCand& b) {
+                        return a.density > b.density;
+                    });
+
+        // Fill HBM; spill the rest.
+        os << "Planning grid placement for " << makeByteStr(hbm_bytes) <<
+            " on HBM NUMA node " << hbm_node << "...\n";
+        size_t used = 0;
+        for (auto& c : cands) {
+            if (c.density > 0. && used + c.nbytes <= hbm_bytes) {
+                plan[c.name] = hbm_node;
+                used += c.nbytes;
+                os << " grid '" << c.name << "' (" << makeByteStr(c.nbytes) <<
+                    ") in HBM\n";
+            }
+            else {
+                plan[c.name] = _opts->_numa_pref;
+                os << " grid '" << c.name << "' (" << makeByteStr(c.nbytes) <<
+                    ") spilled to NUMA node " << _opts->_numa_pref << endl;
+            }
+        }
+        os << " " << makeByteStr(used) << " of HBM used.\n";
+#endif
+        return plan;
+    }
+
+    // Pad the unit-stride dim of each grid to be allocated.
+    // The distances between the neighbors of a point that are read by the
+    // stencils, i.e., those within the halo in each domain dim and those in
+    // each step of the step dim, are products of the allocation sizes, which
+    // often map many of them to the same set of a cache when the sizes are
+    // powers of two. For each grid, extra vectors are tried in the
+    // unit-stride dim, and the fewest that minimize the number of neighbors
+    // sharing a set with another neighbor of the same dim in the L1 and L2
+    // caches are kept.
+    size_t StencilContext::planGridPadding(ostream& os) {
+        if (!_opts->_auto_pad)
+            return 0;
+        auto& step_dim = _dims->_step_dim;
+
+        // Distances at which addresses map to the same cache set.
+        set<idx_t> spans { idx_t(_alias_bytes) };
+#ifdef _SC_LEVEL2_CACHE_SIZE
+        long l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE), l1_ways = sysconf(_SC_LEVEL1_DCACHE_ASSOC);
+        long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE), l2_ways = sysconf(_SC_LEVEL2_CACHE_ASSOC);
+        if (l1 > 0 && l1_ways > 0)
+            spans.insert(l1 / l1_ways);
+        if (l2 > 0 && l2_ways > 0)
+            spans.insert(l2 / l2_ways);
+#endif
+        if (spans.size() == 1)
+            spans.insert(64 * 1024); // typical L2.
+        os << "Planning grid padding for cache-set spans of";
+        for (auto span : spans)
+            os << " " << makeByteStr(span);
+        os << "...\n";
+
+        size_t ngrids = 0;
+        for (auto gp : gridPtrs) {
+            if (!gp || gp->is_storage_allocated())
+                continue;
+            ngrids++;
+            if (gp->is_bricked())
+                continue;
+            auto& gname = gp->get_name();
+            int ndims = gp->get_num_dims();
+            Indices strides = gp->get_storage_strides();
+
+            // Unit-stride dim.
+            int ui = -1;
+            for (int i = 0; i < ndims; i++)
+                if (gp->get_alloc_size(i) > 1 && (ui < 0 || strides[i] < strides[ui]))
+                    ui = i;
+            if (ui < 0 || !_dims->_domain_dims.lookup(gp->get_dim_name(ui)))
+                continue;
+            idx_t vlen = gp->_get_vec_len(ui);
+            idx_t nvecs = gp->get_alloc_size(ui) / vlen;
+
+            // Count the conflicts with 'nx' more vectors in the unit-stride dim.
+            auto count_conflicts = [&](idx_t nx) {
+                idx_t nconf = 0;
+                for (int i = 0; i < ndims; i++) {
+                    auto& dname = gp->get_dim_name(i);
+                    if (i == ui || gp->get_alloc_size(i) <= 1)
+                        continue;
+                    idx_t kbegin, kend;
+                    if (dname == step_dim) {
+                        kbegin = 0;
+                        kend = gp->get_alloc_size(i);
+                    }
+                    else if (_dims->_domain_dims.lookup(dname)) {
+                        idx_t h = max(gp->get_left_halo_size(i), gp->get_right_halo_size(i));
+                        h = max(CEIL_DIV(h, gp->_get_vec_len(i)), idx_t(1));
+                        kbegin = -h;
+                        kend = h + 1;
+                    }
+                    else
+                        continue;
+
+                    // Strides of the outer dims include the unit-stride allocation.
+                    idx_t stride = strides[i];
+                    if (stride >= strides[ui] * nvecs)
+                        stride = stride / nvecs * (nvecs + nx);
+                    for (auto span : spans) {
+                        set<idx_t> sets;
+                        for (idx_t k = kbegin; k < kend; k++)
+                            sets.insert(imod_flr<idx_t>(k * stride, span) / CACHELINE_BYTES);
+                        nconf += (kend - kbegin) - idx_t(sets.size());
+                    }
+                }
+                return nconf;
+            };
+
+            // Keep an odd number of vectors in the inner dim; see
+            // YkGridBase::resize(). Try up to 1/8 more.
+            idx_t xstep = (gp->get_dim_name(ui) == _dims->_inner_dim) ? 2 : 1;
+            idx_t xmax = max(nvecs / 8, xstep);
+            idx_t best_x = 0, best_conf = count_conflicts(0), conf0 = best_conf;
+            for (idx_t nx = xstep; nx <= xmax && best_conf > 0; nx += xstep) {
+                idx_t nconf = count_conflicts(nx);
+                if (nconf < best_conf) {
+                    best_x = nx;
+                    best_conf = nconf;
+                }
+            }
+            os << " grid '" << gname << "': " << conf0 << " cache-set conflict(s)";
+            if (best_x) {
+                auto& dname = gp->get_dim_name(ui);
+                gp->set_right_min_pad_size(ui, gp->get_right_pad_size(ui) + best_x * vlen);
+                os << " reduced to " << best_conf << " by " << (best_x * vlen) <<
+                    " more padding in '" << dname << "'";
+            }
+            os << endl;
+        }
+
+        // Spread the starts of the grids over the aliasing distance.
+        return ROUND_UP(_alias_bytes / max(ngrids, size_t(1)), CACHELINE_BYTES);
+    }
+
     // Create MPI buffers and allocate them.
     void StencilContext::allocMpiData(ostream& os) {
 
         // Remove any old MPI data.
         freeMpiData(os);
 
+        // No shell until send buffers are found.
+        left_shell_sizes = _dims->_domain_dims;
+        left_shell_sizes.setValsSame(0);
+        right_shell_sizes = _dims->_domain_dims;
+        right_shell_sizes.setValsSame(0);
+
 #ifdef USE_MPI
 
         map<int, int> num_exchanges; // send/recv => count.
@@ -358,9 +975,9 @@ namespace yask {
                 if (neigh_rank == MPI_PROC_NULL)
                     return; // from lambda fn.
 
-                // Determine max dist needed.  TODO: determine max dist
-                // automatically from stencils; may not be same for all
-                // grids.
+                // Determine max dist needed. This is an optional upper
+                // bound for all grids; the dist needed by each grid is
+                // determined by the stencil compiler and checked below.
 #ifndef MAX_EXCH_DIST
 #define MAX_EXCH_DIST (NUM_STENCIL_DIMS - 1)
 #endif
@@ -374,7 +991,6 @@ namespace yask {
                 int mandist = _mpiInfo->man_dists.at(neigh_idx);
 
                 // Check distance.
-                // TODO: calculate and use exch dist for each grid.
                 if (mandist > maxdist) {
                     TRACE_MSG("no halo exchange needed with rank " << neigh_rank <<
                               " because L1-norm = " << mandist);
@@ -403,6 +1019,16 @@ namespace yask {
                     auto& gname = gp->get_name();
                     bool grid_vec_ok = vec_ok;
 
+                    // Check distance for this grid, e.g., grids read
+                    // only along the axes don't need diagonal neighbors.
+                    // Not used with WF because the shifts are diagonal.
+                    if (num_wf_shifts == 0 && mandist > gp->get_max_exch_dist()) {
+                        TRACE_MSG("no halo exchange needed for grid '" << gname <<
+                                  "' with rank " << neigh_rank <<
+                                  " because L1-norm = " << mandist);
+                        continue; // to next grid.
+                    }
+
                     // Lookup first & last domain indices and calc exchange sizes
                     // for this grid.
                     bool found_delta = false;
@@ -422,12 +1048,12 @@ namespace yask {
                             // are no more ranks in the given direction,
                             // extend the "outer" index to include the halo
                             // in that direction to make sure all data are
-                            // sync'd when using WF tiling.
+                            // sync'd when using WF tiling or deep halos.
                             idx_t fidx = gp->get_first_rank_domain_index(dname);
                             idx_t lidx = gp->get_last_rank_domain_index(dname);
                             first_inner_idx.addDimBack(dname, fidx);
                             last_inner_idx.addDimBack(dname, lidx);
-                            if (_opts->is_time_tiling()) {
+                            if (num_wf_shifts > 0) {
                                 if (_opts->is_first_rank(dname))
                                     fidx -= lhalo;
                                 if (_opts->is_last_rank(dname))
@@ -697,6 +1323,8 @@ namespace yask {
                         buf.num_pts = buf_sizes;
                         buf.name = bufname;
                         buf.vec_copy_ok = buf_vec_ok;
+                        buf.shm_rank = _opts->use_shm ?
+                            _env->shm_ranks.at(neigh_rank) : MPI_PROC_NULL;
 
                         TRACE_MSG("MPI buffer '" << buf.name <<
                                   "' configured for rank at relative offsets " <<
@@ -709,6 +1337,23 @@ namespace yask {
                         num_exchanges[bd]++;
                         num_elems[bd] += buf.get_size();
 
+                        // Expand shell to cover the part of the rank
+                        // domain read into this send buffer.
+                        if (bd == MPIBufs::bufSend) {
+                            for (auto& dim : _dims->_domain_dims.getDims()) {
+                                auto& dname = dim.getName();
+                                if (!gp->is_dim_used(dname))
+                                    continue;
+                                auto neigh_ofs = neigh_offsets[dname];
+                                if (neigh_ofs == idx_t(MPIInfo::rank_prev))
+                                    left_shell_sizes[dname] = max(left_shell_sizes[dname],
+                                                                  copy_end[dname] - first_inner_idx[dname]);
+                                else if (neigh_ofs == idx_t(MPIInfo::rank_next))
+                                    right_shell_sizes[dname] = max(right_shell_sizes[dname],
+                                                                   last_inner_idx[dname] + 1 - copy_begin[dname]);
+                            }
+                        }
+
                     } // send, recv.
                 } // grids.
             });   // neighbors.
@@ -733,48 +1378,82 @@ namespace yask {
             // Count bytes needed and number of buffers for each NUMA node.
             map <int, size_t> npbytes, nbufs;
 
-            // Grids.
-            for (auto gp : gridPtrs) {
-                if (!gp)
-                    continue;
-                auto& gname = gp->get_name();
-                int numa_pref = gp->get_numa_preferred();
-
-                // MPI bufs for this grid.
-                if (mpiData.count(gname)) {
-                    auto& grid_mpi_data = mpiData.at(gname);
-
-                    // Visit buffers for each neighbor for this grid.
-                    grid_mpi_data.visitNeighbors
-                        ([&](const IdxTuple& roffsets,
-                             int rank,
-                             int idx,
-                             MPIBufs& bufs) {
-
-                            // Send and recv.
-                            for (int bd = 0; bd < MPIBufs::nBufDirs; bd++) {
-                                auto& buf = grid_mpi_data.getBuf(MPIBufs::BufDir(bd), roffsets);
-                                if (buf.get_size() == 0)
-                                    continue;
+            // Assign storage to one buffer.
+            auto set_buf = [&](MPIBuf& buf, int numa_pref) {
+                if (buf.get_size() == 0 || buf.shm_rank != MPI_PROC_NULL)
+                    return;
 
-                                // Set storage if buffer has been allocated in pass 0.
-                                if (pass == 1) {
-                                    auto p = _mpi_data_buf[numa_pref];
-                                    assert(p);
-                                    buf.set_storage(p, npbytes[numa_pref]);
-                                }
+                // Set storage if buffer has been allocated in pass 0.
+                if (pass == 1) {
+                    auto p = _mpi_data_buf[numa_pref];
+                    assert(p);
+                    buf.set_storage(p, npbytes[numa_pref]);
+                }
 
-                                // Determine padded size (also offset to next location).
-                                auto sbytes = buf.get_bytes();
-                                npbytes[numa_pref] += ROUND_UP(sbytes + _data_buf_pad,
-                                                               CACHELINE_BYTES);
-                                nbufs[numa_pref]++;
-                                if (pass == 0)
-                                    TRACE_MSG("  MPI buf '" << buf.name << "' needs " <<
-                                              makeByteStr(sbytes) <<
-                                              " on NUMA node " << numa_pref);
+                // Determine padded size (also offset to next location).
+                auto sbytes = buf.get_bytes();
+                npbytes[numa_pref] += ROUND_UP(sbytes + _data_buf_pad,
+                                               CACHELINE_BYTES);
+                nbufs[numa_pref]++;
+                if (pass == 0)
+                    TRACE_MSG("  MPI buf '" << buf.name << "' needs " <<
+                              makeByteStr(sbytes) <<
+                              " on NUMA node " << numa_pref);
+            };
+
+            // When combining halos, the buffers for all grids for a given
+            // neighbor and direction are placed consecutively in one NUMA
+            // chunk, so they can be sent in one message.  The layout is
+            // the same on all ranks, so a sender's buffers match the
+            // receiver's.
+            if (_opts->combine_halos) {
+                int numa_pref = _opts->_numa_pref;
+                _mpiInfo->visitNeighbors
+                    ([&](const IdxTuple& roffsets,
+                         int rank,
+                         int idx) {
+                        if (rank == MPI_PROC_NULL)
+                            return;
+                        for (int bd = 0; bd < MPIBufs::nBufDirs; bd++) {
+                            for (auto gp : gridPtrs) {
+                                if (!gp)
+                                    continue;
+                                auto& gname = gp->get_name();
+                                if (mpiData.count(gname)) {
+                                    auto& grid_mpi_data = mpiData.at(gname);
+                                    set_buf(grid_mpi_data.getBuf(MPIBufs::BufDir(bd), roffsets),
+                                            numa_pref);
+                                }
                             }
-                        } );
+                        }
+                    } );
+            }
+
+            // Grids.
+            else {
+                for (auto gp : gridPtrs) {
+                    if (!gp)
+                        continue;
+                    auto& gname = gp->get_name();
+                    int numa_pref = gp->get_numa_preferred();
+
+                    // MPI bufs for this grid.
+                    if (mpiData.count(gname)) {
+                        auto& grid_mpi_data = mpiData.at(gname);
+
+                        // Visit buffers for each neighbor for this grid.
+                        grid_mpi_data.visitNeighbors
+                            ([&](const IdxTuple& roffsets,
+                                 int rank,
+                                 int idx,
+                                 MPIBufs& bufs) {
+
+                                // Send and recv.
+                                for (int bd = 0; bd < MPIBufs::nBufDirs; bd++)
+                                    set_buf(grid_mpi_data.getBuf(MPIBufs::BufDir(bd), roffsets),
+                                            numa_pref);
+                            } );
+                    }
                 }
             }
 
@@ -783,9 +1462,247 @@ namespace yask {
                 _alloc_data(npbytes, nbufs, _mpi_data_buf, "MPI buffer");
 
         } // MPI passes.
+
+        // Buffers for neighbors on the same node.
+        if (_opts->use_shm)
+            allocShmData(os);
+
+        // Persistent requests for the buffers exchanged with messages.
+        // The tag is the index of the grid, which is the same on all
+        // ranks.
+        if (_opts->persistent_reqs && !_opts->combine_halos) {
+            int nreqs = 0;
+            for (size_t gi = 0; gi < gridPtrs.size(); gi++) {
+                auto gp = gridPtrs[gi];
+                if (!gp || mpiData.count(gp->get_name()) == 0)
+                    continue;
+                mpiData.at(gp->get_name()).visitNeighbors
+                    ([&](const IdxTuple& offsets, int neigh_rank, int ni, MPIBufs& bufs) {
+                        auto& sendBuf = bufs.bufs[MPIBufs::bufSend];
+                        auto& recvBuf = bufs.bufs[MPIBufs::bufRecv];
+                        if (sendBuf.get_bytes() && !sendBuf.is_shm()) {
+                            MPI_Send_init(sendBuf._elems, int(sendBuf.get_bytes()), MPI_BYTE,
+                                          neigh_rank, int(gi), _env->comm, &sendBuf._preq);
+                            nreqs++;
+                        }
+                        if (recvBuf.get_bytes() && !recvBuf.is_shm()) {
+                            MPI_Recv_init(recvBuf._elems, int(recvBuf.get_bytes()), MPI_BYTE,
+                                          neigh_rank, int(gi), _env->comm, &recvBuf._preq);
+                            nreqs++;
+                        }
+                    });
+            }
+            TRACE_MSG("allocMpiData: " << nreqs << " persistent request(s) created");
+        }
 #endif
     }
 
+    // Allocate the send buffers for neighbors on the same node in one
+    // shared-memory window per rank and point each receive buffer from
+    // such a neighbor into the neighbor's window, so each halo is
+    // copied only by pack_halo() and unpack_halo(). Each send buffer is
+    // preceded by two cache lines holding the pack and unpack counts
+    // used to hand it back and forth.
+    void StencilContext::allocShmData(ostream& os) {
+#ifdef USE_MPI
+        auto& gbufs = mpiData;
+        const size_t hdr_bytes = 2 * CACHELINE_BYTES;
+
+        // Visit the buffers for each neighbor on the same node in each
+        // grid. Grid order is the same on all ranks.
+        auto visit_shm_bufs = [&](std::function<void (int neigh_rank, int neigh_idx,
+                                                      size_t grid_idx,
+                                                      MPIBuf& send_buf,
+                                                      MPIBuf& recv_buf)> visitor) {
+            _mpiInfo->visitNeighbors
+                ([&](const IdxTuple& offsets, int neigh_rank, int neigh_idx) {
+                    if (neigh_rank == MPI_PROC_NULL ||
+                        _env->shm_ranks.at(neigh_rank) == MPI_PROC_NULL)
+                        return;
+                    for (size_t gi = 0; gi < gridPtrs.size(); gi++) {
+                        auto gp = gridPtrs[gi];
+                        if (!gp || gbufs.count(gp->get_name()) == 0)
+                            continue;
+                        auto& gmd = gbufs.at(gp->get_name());
+                        visitor(neigh_rank, neigh_idx, gi,
+                                gmd.getBuf(MPIBufs::bufSend, offsets),
+                                gmd.getBuf(MPIBufs::bufRecv, offsets));
+                    }
+                });
+        };
+
+        // Offset of each send buffer in my window.
+        // Map key: neighbor index; value: offset or -1 for each grid.
+        map<int, vector<idx_t>> send_ofs;
+        _mpiInfo->visitNeighbors
+            ([&](const IdxTuple& offsets, int neigh_rank, int neigh_idx) {
+                if (neigh_rank != MPI_PROC_NULL &&
+                    _env->shm_ranks.at(neigh_rank) != MPI_PROC_NULL)
+                    send_ofs[neigh_idx].resize(gridPtrs.size(), -1);
+            });
+        size_t nbytes = 0;
+        int nbufs = 0;
+        visit_shm_bufs([&](int neigh_rank, int neigh_idx, size_t gi,
+                           MPIBuf& send_buf, MPIBuf& recv_buf) {
+                auto& ofs = send_ofs[neigh_idx];
+                if (send_buf.get_size() == 0)
+                    return;
+                ofs[gi] = idx_t(nbytes);
+                nbytes += hdr_bytes + ROUND_UP(send_buf.get_bytes() + _data_buf_pad,
+                                               CACHELINE_BYTES);
+                nbufs++;
+            });
+
+        // Collective over the ranks on this node.
+        MPI_Info info;
+        MPI_Info_create(&info);
+        MPI_Info_set(info, "alloc_shared_noncontig", "true");
+        // Add a cache line to align the start in every process; the
+        // offset into the page is the same in all of them.
+        auto align_base = [&](char* p) {
+            return (char*)ROUND_UP(size_t(p), CACHELINE_BYTES);
+        };
+        char* base = 0;
+        MPI_Win_allocate_shared(MPI_Aint(nbytes + CACHELINE_BYTES), 1, info, _env->shm_comm,
+                                &base, &_shm_win);
+        MPI_Info_free(&info);
+        base = align_base(base);
+        TRACE_MSG("allocShmData: " << makeByteStr(nbytes) << " for " << nbufs <<
+                  " send buffer(s) in shared memory");
+
+        // Set my send buffers and zero their counts.
+        visit_shm_bufs([&](int neigh_rank, int neigh_idx, size_t gi,
+                           MPIBuf& send_buf, MPIBuf& recv_buf) {
+                idx_t ofs = send_ofs[neigh_idx][gi];
+                if (ofs < 0)
+                    return;
+                char* p = base + ofs;
+                send_buf.release_storage();
+                send_buf._shm_packs = new (p) std::atomic<idx_t>(0);
+                send_buf._shm_unpacks = new (p + CACHELINE_BYTES) std::atomic<idx_t>(0);
+                send_buf._elems = (real_t*)(p + hdr_bytes);
+            });
+        MPI_Barrier(_env->shm_comm);
+
+        // Trade offsets with each neighbor on the node: my send buffers
+        // to it are its receive buffers from me.
+        map<int, vector<idx_t>> recv_ofs;
+        vector<MPI_Request> reqs;
+        reqs.reserve(send_ofs.size() * 2);
+        for (auto& i : send_ofs) {
+            int neigh_rank = _mpiInfo->my_neighbors.at(i.first);
+            auto& rofs = recv_ofs[i.first];
+            rofs.resize(gridPtrs.size(), -1);
+            int nb = int(gridPtrs.size() * sizeof(idx_t));
+            reqs.push_back(MPI_REQUEST_NULL);
+            MPI_Irecv(rofs.data(), nb, MPI_BYTE, neigh_rank, 0, _env->comm, &reqs.back());
+            reqs.push_back(MPI_REQUEST_NULL);
+            MPI_Isend(i.second.data(), nb, MPI_BYTE, neigh_rank, 0, _env->comm, &reqs.back());
+        }
+        MPI_Waitall(int(reqs.size()), reqs.data(), MPI_STATUSES_IGNORE);
+
+        // Point my receive buffers into the neighbors' windows.
+        visit_shm_bufs([&](int neigh_rank, int neigh_idx, size_t gi,
+                           MPIBuf& send_buf, MPIBuf& recv_buf) {
+                if (recv_buf.get_size() == 0)
+                    return;
+                idx_t ofs = recv_ofs[neigh_idx][gi];
+                if (ofs < 0)
+                    FORMAT_AND_THROW_YASK_EXCEPTION("Error: rank " << neigh_rank <<
+                                                    " has no shared-memory buffer for '" <<
+                                                    recv_buf.name << "'");
+                MPI_Aint wsize = 0;
+                int disp = 0;
+                char* nbase = 0;
+                MPI_Win_shared_query(_shm_win, _env->shm_ranks.at(neigh_rank),
+                                     &wsize, &disp, &nbase);
+                char* p = align_base(nbase) + ofs;
+                recv_buf.release_storage();
+                recv_buf._shm_packs = (std::atomic<idx_t>*)p;
+                recv_buf._shm_unpacks = (std::atomic<idx_t>*)(p + CACHELINE_BYTES);
+                recv_buf._elems = (real_t*)(p + hdr_bytes);
+            });
+        os << "Using " << makeByteStr(nbytes) << " of shared memory for " << nbufs <<
+            " halo buffer(s) to neighbor(s) on the same node.\n";
+#endif
+    }
+
+    // Assign each scratch-grid vec in 'scratchVecs' to a storage slot.
+    // Within each non-scratch bundle, the required scratch bundles are
+    // evaluated in order over a whole block, so a scratch grid is live
+    // from the first bundle in that list that writes it to the last one
+    // that reads it. Vecs whose live ranges do not overlap in any
+    // bundle's list and that have the same NUMA preference may share a
+    // slot. Returns the number of slots.
+    int StencilContext::find_scratch_slots(vector<int>& slots) const {
+        auto nvecs = scratchVecs.size();
+        slots.assign(nvecs, 0);
+        for (size_t si = 0; si < nvecs; si++)
+            slots[si] = si;
+        if (!_opts->_reuse_scratch || nvecs < 2)
+            return nvecs;
+
+        map<const GridPtrs*, size_t> vec_idxs;
+        for (size_t si = 0; si < nvecs; si++)
+            vec_idxs[scratchVecs[si]] = si;
+
+        // Live range of each vec in each non-scratch bundle's list, or
+        // [-1, -1] if not used.
+        auto nbundles = stBundles.size();
+        vector<vector<pair<int, int>>> live(nvecs,
+                                            vector<pair<int, int>>(nbundles, {-1, -1}));
+        for (size_t bi = 0; bi < nbundles; bi++) {
+            auto sg_list = stBundles[bi]->get_reqd_bundles();
+            for (int k = 0; k < int(sg_list.size()); k++) {
+                auto* sg = sg_list[k];
+                for (auto* svs : { &sg->outputScratchVecs, &sg->inputScratchVecs }) {
+                    for (auto* sv : *svs) {
+                        auto vi = vec_idxs.find(sv);
+                        if (vi == vec_idxs.end())
+                            continue;
+                        auto& lr = live[vi->second][bi];
+                        if (lr.first < 0)
+                            lr.first = k;
+                        lr.second = k;
+                    }
+                }
+            }
+        }
+        auto overlap = [&](size_t si, size_t sj) {
+            if ((*scratchVecs[si])[0]->get_numa_preferred() !=
+                (*scratchVecs[sj])[0]->get_numa_preferred())
+                return true;
+            for (size_t bi = 0; bi < nbundles; bi++) {
+                auto& a = live[si][bi];
+                auto& b = live[sj][bi];
+                if (a.first >= 0 && b.first >= 0 &&
+                    a.first <= b.second && b.first <= a.second)
+                    return true;
+            }
+            return false;
+        };
+
+        // Put each vec in the first slot with no overlapping vec.
+        int nslots = 0;
+        for (size_t si = 0; si < nvecs; si++) {
+            int sn = 0;
+            for (; sn < nslots; sn++) {
+                bool ok = true;
+                for (size_t sj = 0; ok && sj < si; sj++)
+                    if (slots[sj] == sn && overlap(si, sj))
+                        ok = false;
+                if (ok)
+                    break;
+            }
+            slots[si] = sn;
+            if (sn == nslots)
+                nslots++;
+            TRACE_MSG("scratch grid '" << (*scratchVecs[si])[0]->get_name() <<
+                      "' is in slot " << sn);
+        }
+        return nslots;
+    }
+
     // Allocate memory for scratch grids based on number of threads and
     // block sizes.
     void StencilContext::allocScratchData(ostream& os) {
@@ -807,73 +1724,118 @@ namespace yask {
         // Create new scratch grids.
         makeScratchGrids(rthreads);
 
+        // Set the domain size of each scratch grid to the block size.
+        for (auto* sgv : scratchVecs) {
+            assert(sgv);
+
+            // Loop through each scratch grid in this vector.
+            // There will be one for each region thread.
+            assert(int(sgv->size()) == rthreads);
+            for (auto gp : *sgv) {
+                assert(gp);
+
+                // Loop through each domain dim.
+                for (auto& dim : _dims->_domain_dims.getDims()) {
+                    auto& dname = dim.getName();
+
+                    if (gp->is_dim_used(dname)) {
+
+                        // Set domain size of grid to block size.
+                        // Round up to vec-len.
+                        auto sz = round_up_flr(_opts->_block_sizes[dname],
+                                               gp->_get_vec_len(dname));
+                        gp->_set_domain_size(dname, sz);
+
+                        // Pads.
+                        // Set via both 'extra' and 'min'; larger result will be used.
+                        gp->set_extra_pad_size(dname, _opts->_extra_pad_sizes[dname]);
+                        gp->set_min_pad_size(dname, _opts->_min_pad_sizes[dname]);
+                    }
+                } // dims.
+            } // scratch grids.
+        } // scratch-grid vecs.
+
+        // Scratch-grid vecs that share storage, and the size of each
+        // shared slot for each thread.
+        vector<int> slots;
+        int nslots = find_scratch_slots(slots);
+        vector<vector<size_t>> slot_bytes(nslots, vector<size_t>(rthreads, 0));
+        vector<int> slot_numa(nslots, yask_numa_none);
+        for (size_t si = 0; si < scratchVecs.size(); si++) {
+            auto& sgv = *scratchVecs[si];
+            for (int thr_num = 0; thr_num < rthreads; thr_num++) {
+                auto& sb = slot_bytes[slots[si]][thr_num];
+                sb = max(sb, size_t(sgv[thr_num]->get_num_storage_bytes()));
+            }
+            slot_numa[slots[si]] = sgv[0]->get_numa_preferred();
+        }
+        if (nslots < int(scratchVecs.size()))
+            os << "Scratch grids share storage in " << nslots << " of " <<
+                scratchVecs.size() << " slot(s) per thread.\n";
+
         // Pass 0: count required size, allocate chunk of memory at end.
         // Pass 1: distribute parts of already-allocated memory chunk.
         for (int pass = 0; pass < 2; pass++) {
             TRACE_MSG("allocScratchData pass " << pass << " for " <<
-                      scratchVecs.size() << " set(s) of scratch grids");
+                      scratchVecs.size() << " set(s) of scratch grids in " <<
+                      nslots << " slot(s)");
 
             // Count bytes needed and number of grids for each NUMA node.
             map <int, size_t> npbytes, ngrids;
 
-            // Loop through each scratch grid vector.
-            for (auto* sgv : scratchVecs) {
-                assert(sgv);
-
-                // Loop through each scratch grid in this vector.
-                // There will be one for each region thread.
-                assert(int(sgv->size()) == rthreads);
-                int thr_num = 0;
-                for (auto gp : *sgv) {
-                    assert(gp);
-                    auto& gname = gp->get_name();
-                    int numa_pref = gp->get_numa_preferred();
-
-                    // Loop through each domain dim.
-                    for (auto& dim : _dims->_domain_dims.getDims()) {
-                        auto& dname = dim.getName();
-
-                        if (gp->is_dim_used(dname)) {
-
-                            // Set domain size of grid to block size.
-                            // Round up to vec-len.
-                            auto sz = round_up_flr(_opts->_block_sizes[dname],
-                                                   gp->_get_vec_len(dname));
-                            gp->_set_domain_size(dname, sz);
+            // Loop through each slot and thread.
+            for (int sn = 0; sn < nslots; sn++) {
+                int numa_pref = slot_numa[sn];
+                for (int thr_num = 0; thr_num < rthreads; thr_num++) {
 
-                            // Pads.
-                            // Set via both 'extra' and 'min'; larger result will be used.
-                            gp->set_extra_pad_size(dname, _opts->_extra_pad_sizes[dname]);
-                            gp->set_min_pad_size(dname, _opts->_min_pad_sizes[dname]);
+                    // Set storage of each grid in this slot if buffer has
+                    // been allocated.
+                    for (size_t si = 0; si < scratchVecs.size(); si++) {
+                        if (slots[si] != sn)
+                            continue;
+                        auto gp = (*scratchVecs[si])[thr_num];
+                        if (pass == 1) {
+                            auto p = _scratch_data_buf[numa_pref];
+                            assert(p);
+                            gp->set_storage(p, npbytes[numa_pref]);
+                            TRACE_MSG(gp->make_info_string());
                         }
-                    } // dims.
-
-                    // Set storage if buffer has been allocated.
-                    if (pass == 1) {
-                        auto p = _scratch_data_buf[numa_pref];
-                        assert(p);
-                        gp->set_storage(p, npbytes[numa_pref]);
-                        TRACE_MSG(gp->make_info_string());
+                        else
+                            TRACE_MSG(" scratch grid '" << gp->get_name() << "' for thread " <<
+                                      thr_num << " needs " <<
+                                      makeByteStr(gp->get_num_storage_bytes()) <<
+                                      " in slot " << sn << " on NUMA node " << numa_pref);
                     }
 
                     // Determine size used (also offset to next location).
-                    size_t nbytes = gp->get_num_storage_bytes();
+                    size_t nbytes = slot_bytes[sn][thr_num];
                     npbytes[numa_pref] += ROUND_UP(nbytes + _data_buf_pad,
                                                    CACHELINE_BYTES);
                     ngrids[numa_pref]++;
-                    if (pass == 0)
-                        TRACE_MSG(" scratch grid '" << gname << "' for thread " <<
-                                  thr_num << " needs " << makeByteStr(nbytes) <<
-                                  " on NUMA node " << numa_pref);
-                    thr_num++;
-                } // scratch grids.
-            } // scratch-grid vecs.
+                } // threads.
+            } // slots.
 
             // Alloc for each node.
             if (pass == 0)
                 _alloc_data(npbytes, ngrids, _scratch_data_buf, "scratch grid");
 
         } // scratch-grid passes.
+
+        // Touch each thread's scratch grids from that thread.
+        if (_opts->_first_touch) {
+#pragma omp parallel proc_bind(spread)
+            {
+                size_t thr_num = omp_get_thread_num();
+                for (auto* sgv : scratchVecs) {
+                    if (thr_num >= sgv->size() || !(*sgv)[thr_num])
+                        continue;
+                    auto gp = (*sgv)[thr_num];
+                    int numa_pref = gp->get_numa_preferred();
+                    if (numa_pref < 0 && numa_pref != yask_numa_interleave)
+                        gp->set_all_elements_same(0.0);
+                }
+            }
+        }
     }
 
     // Set non-scratch grid sizes and offsets based on settings.
@@ -882,6 +1844,7 @@ namespace yask {
     void StencilContext::update_grid_info()
     {
         assert(_opts);
+        _step_plan.valid = false;
 
         // If we haven't finished constructing the context, it's too early
         // to do this.
@@ -913,6 +1876,10 @@ namespace yask {
                     gp->set_extra_pad_size(dname, _opts->_extra_pad_sizes[dname]);
                     gp->set_min_pad_size(dname, _opts->_min_pad_sizes[dname]);
 
+                    // Bricks.
+                    if (gp->is_bricked() && _opts->_brick_sizes[dname] > 0)
+                        gp->set_brick_size(dname, _opts->_brick_sizes[dname]);
+
                     // Offsets.
                     gp->_set_offset(dname, rank_domain_offsets[dname]);
                     gp->_set_local_offset(dname, 0);
@@ -930,6 +1897,16 @@ namespace yask {
         auto& step_dim = _dims->_step_dim;
         auto wf_steps = _opts->_region_sizes[step_dim];
         assert(wf_steps >= 1);
+
+        // Without wave-fronts, deep halos may be used instead: the rank is
+        // extended as for wave-fronts over 'halo_steps' steps, so the halos
+        // only need to be exchanged once for all of them. Not used with
+        // comm/compute overlap, which needs an exchange after every pack.
+        deep_halo_steps = 1;
+        if (wf_steps == 1 && _opts->halo_steps > 1 && !_opts->overlap_comms) {
+            deep_halo_steps = _opts->halo_steps;
+            wf_steps = deep_halo_steps;
+        }
         num_wf_shifts = 0;
         if (wf_steps > 1) {
 
@@ -1042,6 +2019,10 @@ namespace yask {
         // TODO: print settings again after auto-tuning.
         _opts->adjustSettings(os, _env);
 
+        // Keep this thread on the solution's CPUs while preparing, so
+        // the threads it starts and the pages they touch stay there.
+        ScopedCpuBinding cpu_binding(_opts->_cpus);
+
         // Report ranks.
         os << endl;
         os << "Num ranks: " << _env->get_num_ranks() << endl;
@@ -1056,9 +2037,20 @@ namespace yask {
         set_block_threads(); // Temporary; just for reporting.
         os << "  Num threads per block: " << omp_get_max_threads() << endl;
 
+        // Find groups of CPUs sharing a cache for each block team.
+        _bind_threads = false;
+        if (_opts->bind_block_threads) {
+            _bind_block_threads = max(set_block_threads(), 1);
+            _bind_region_threads = max(set_region_threads(), 1);
+            _bind_threads = _topology.find_groups(_bind_block_threads, _opts->_cpus);
+            if (!_bind_threads)
+                os << "Warning: CPU topology not available; block threads will not be bound.\n";
+        }
+
         // Set the number of threads for a region. It should stay this
         // way for top-level OpenMP parallel sections.
         int rthreads = set_region_threads();
+        bind_region_threads();
 
         // Run a dummy nested OMP loop to make sure nested threading is
         // initialized.
@@ -1090,11 +2082,24 @@ namespace yask {
         // We free the scratch and MPI data first to give grids preference.
         freeScratchData(os);
         freeMpiData(os);
+        setupNumaParts(os);
         allocGridData(os);
         allocScratchData(os);
         allocMpiData(os);
+        start_progress_threads(_env->num_ranks > 1 ? _opts->progress_threads : 0);
 
         print_info();
+        if (_opts->roofline)
+            measure_peaks();
+        if (_opts->cache_sim)
+            run_cache_sim();
+
+        // Start recording the event timeline.
+        if (_opts->trace_file.length()) {
+            os << "Recording event timeline of up to " << _opts->trace_max_events <<
+                " events per thread.\n";
+            EventTracer::enable(_opts->trace_max_events);
+        }
     }
 
     void StencilContext::print_info() {
@@ -1135,9 +2140,47 @@ namespace yask {
             " vector-len:            " << VLEN << endl <<
             " extra-padding:         " << _opts->_extra_pad_sizes.makeDimValStr() << endl <<
             " minimum-padding:       " << _opts->_min_pad_sizes.makeDimValStr() << endl <<
-            " L1-prefetch-distance:  " << PFD_L1 << endl <<
-            " L2-prefetch-distance:  " << PFD_L2 << endl <<
-            " max-halos:             " << max_halos.makeDimValStr() << endl;
+            " auto-padding:          " << _opts->_auto_pad << endl <<
+            " brick-size:            " << _opts->_brick_sizes.makeDimValStr() << endl <<
+            " L1-prefetch-distance:  " << _opts->_prefetch_L1_dist << endl <<
+            " L2-prefetch-distance:  " << _opts->_prefetch_L2_dist << endl <<
+            " max-halos:             " << max_halos.makeDimValStr() << endl <<
+            " nt-stores:             " << use_nt_stores() << endl <<
+            " perf-counters:         " << _opts->perf_counters << endl <<
+            " steal-blocks:          " << _opts->steal_blocks << endl <<
+            " prefetch-helpers:      " << _opts->prefetch_helpers << endl <<
+            " region-loop-order:     " << get_loop_order_str(_opts->region_loop_order, false) << endl <<
+            " block-loop-order:      " << get_loop_order_str(_opts->block_loop_order, false) << endl <<
+            " sub-block-loop-order:  " << get_loop_order_str(_opts->sub_block_loop_order, true) << endl <<
+            " numa-parts:            " << max(_numa_part_begins.size(), size_t(1)) << endl <<
+            " persistent-team:       " << _opts->persistent_team << endl <<
+            " diamond-tiling:        " << _opts->diamond_tiling << endl <<
+            " cache-oblivious:       " << _opts->cache_oblivious << endl <<
+            " bind-block-threads:    " << _opts->bind_block_threads << endl <<
+            " cpus:                  " << (_opts->cpu_list.length() ? _opts->cpu_list : "not restricted") << endl;
+        if (_bind_threads) {
+            os << " cpu-groups:            " << _topology.make_info_string() << endl;
+            for (int r = 0; r < _bind_region_threads; r++) {
+                os << "  region-thread " << r << " block-thread cpus:";
+                for (int b = 0; b < _bind_block_threads; b++)
+                    os << " " << _topology.get_cpu(r, b, _bind_block_threads);
+                os << endl;
+            }
+        }
+#ifdef USE_MPI
+        os <<
+            " overlap-comms:         " << _opts->overlap_comms << endl <<
+            " combine-halos:         " << _opts->combine_halos << endl <<
+            " use-shm:               " << _opts->use_shm << endl <<
+            " persistent-reqs:       " << _opts->persistent_reqs << endl <<
+            " progress-threads:      " << _num_progress_threads << endl;
+        if (_opts->overlap_comms)
+            os <<
+                " left-shell-sizes:      " << left_shell_sizes.makeDimValStr() << endl <<
+                " right-shell-sizes:     " << right_shell_sizes.makeDimValStr() << endl;
+#endif
+        if (deep_halo_steps > 1)
+            os << " deep-halo-steps:       " << deep_halo_steps << endl;
         if (num_wf_shifts > 0) {
             os <<
                 " wave-front-angles:     " << wf_angles.makeDimValStr() << endl <<
@@ -1198,6 +2241,7 @@ namespace yask {
                     "  sub-domain size:            " << bb.bb_len.makeDimValStr(" * ") << endl <<
                     "  valid points in sub domain: " << makeNumStr(bb.bb_num_points) << endl <<
                     "  rectangles in sub domain:   " << sg->getBBs().size() << endl <<
+                    "  masked by condition:        " << (sg->is_using_masks() ? "yes" : "no") << endl <<
                     "  grid-updates per point:     " << updates1 << endl <<
                     "  grid-updates in sub-domain: " << makeNumStr(updates_domain) << endl <<
                     "  grid-reads per point:       " << reads1 << endl <<
@@ -1296,14 +2340,124 @@ namespace yask {
 #endif
     }
 
+    // Measure sustainable memory bandwidth in bytes/sec with a
+    // STREAM-like triad using the current number of threads.
+    static double measureMemBW() {
+        const size_t n = 4 * 1024 * 1024; // 32MiB per array.
+        const size_t nbytes = n * sizeof(double);
+        shared_ptr<char> ap(alignedAlloc(nbytes), AlignedDeleter());
+        shared_ptr<char> bp(alignedAlloc(nbytes), AlignedDeleter());
+        shared_ptr<char> cp(alignedAlloc(nbytes), AlignedDeleter());
+        double* a = (double*)ap.get();
+        double* b = (double*)bp.get();
+        double* c = (double*)cp.get();
+
+        // Init in parallel for NUMA first-touch.
+#pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < n; i++) {
+            a[i] = 0.;
+            b[i] = 1.;
+            c[i] = 2.;
+        }
+
+        // Best of several trials.
+        double best = 0.;
+        for (int trial = 0; trial < 4; trial++) {
+            YaskTimer timer;
+            timer.start();
+#pragma omp parallel for schedule(static)
+            for (size_t i = 0; i < n; i++)
+                a[i] = b[i] + 3. * c[i];
+            timer.stop();
+            double secs = timer.get_elapsed_secs();
+            if (secs > 0.)
+                best = max(best, 3. * nbytes / secs);
+        }
+        return best;
+    }
+
+    // Measure FP rate in FLOPS with independent multiply-adds on
+    // vectors using the current number of threads.
+    static double measureFlops() {
+        const idx_t niters = 1000000;
+        const int nacc = 8;
+        double best = 0.;
+        for (int trial = 0; trial < 4; trial++) {
+            int nthreads = 1;
+            real_t sum = 0.;
+            YaskTimer timer;
+            timer.start();
+#pragma omp parallel reduction(+:sum)
+            {
+#pragma omp master
+                nthreads = omp_get_num_threads();
+
+                real_vec_t acc[nacc];
+                for (int j = 0; j < nacc; j++)
+                    acc[j] = real_t(j);
+                real_vec_t mul = real_t(0.999999);
+                real_vec_t add = real_t(1e-6);
+                for (idx_t i = 0; i < niters; i++)
+                    for (int j = 0; j < nacc; j++)
+                        acc[j] = acc[j] * mul + add;
+                for (int j = 0; j < nacc; j++)
+                    sum += acc[j][0];
+            }
+            timer.stop();
+            double secs = timer.get_elapsed_secs();
+
+            // Also check 'sum' so the loop is not optimized away.
+            if (secs > 0. && sum != real_t(-1))
+                best = max(best, 2. * nacc * VLEN * double(niters) * nthreads / secs);
+        }
+        return best;
+    }
+
+    // Set the machine peaks for the roofline model.
+    void StencilContext::measure_peaks() {
+        ostream& os = get_ostr();
+
+        // Measure with all threads as used by the stencil.
+        set_all_threads();
+        peak_bytes_ps = (_opts->peak_mem_gbps > 0) ?
+            double(_opts->peak_mem_gbps) * 1e9 : measureMemBW();
+        peak_flops = (_opts->peak_gflops > 0) ?
+            double(_opts->peak_gflops) * 1e9 : measureFlops();
+        set_region_threads();
+
+        os << "\nRoofline peaks in this rank:\n"
+            " memory-bandwidth (bytes/sec): " << makeNumStr(peak_bytes_ps) <<
+            ((_opts->peak_mem_gbps > 0) ? " (given)" : " (measured)") << endl <<
+            " FP rate (FLOPS):              " << makeNumStr(peak_flops) <<
+            ((_opts->peak_gflops > 0) ? " (given)" : " (measured)") << endl;
+    }
+
     // Dealloc grids, etc.
     void StencilContext::end_solution() {
 
         // Final halo exchange.
         exchange_halos_all();
 
+        // The batch solutions are no longer advanced with this one.
+        _batch.clear();
+
+        // Write event timeline. The event names refer to the packs,
+        // so this must be done while they still exist.
+        if (_opts->trace_file.length() && EventTracer::is_enabled()) {
+            EventTracer::disable();
+            string fname = _opts->trace_file + "." +
+                to_string(_env->get_rank_index()) + ".json";
+            auto nevents = EventTracer::write(fname, _env->get_rank_index());
+            get_ostr() << "Wrote " << nevents << " events to '" << fname << "'.\n";
+            EventTracer::clear();
+        }
+
+        // Wait for any snapshots to be written.
+        finish_snapshots();
+
         // Release any MPI data.
-        mpiData.clear();
+        stop_progress_threads();
+        freeMpiData(get_ostr());
 
         // Release grid data.
         for (auto gp : gridPtrs) {
@@ -1316,6 +2470,351 @@ namespace yask {
 	set_max_threads();
     }
 
+    // Shift rank-domain boundaries between ranks so that the measured
+    // compute times even out, and move the grid data to the new owners.
+    // Since ranks at the same rank index in a dim must have the same
+    // size in that dim (see setupRank()), the sizes are adjusted for
+    // each slab of ranks, using the slowest rank in each slab.
+    bool StencilContext::rebalance_ranks() {
+        if (!rank_bb.bb_valid)
+            THROW_YASK_EXCEPTION("Error: rebalance_ranks() called without calling prepare_solution() first");
+        double my_secs = rebalance_secs;
+        rebalance_secs = 0.;
+        rebalance_steps = 0;
+#ifndef USE_MPI
+        return false;
+#else
+        ostream& os = get_ostr();
+        int nranks = _env->num_ranks;
+        if (nranks < 2)
+            return false;
+        auto& ddims = _dims->_domain_dims;
+        int nddims = ddims.getNumDims();
+
+        // Gather times, rank indices and sizes from all ranks.
+        vector<double> secs(nranks);
+        MPI_Allgather(&my_secs, 1, MPI_DOUBLE, secs.data(), 1, MPI_DOUBLE, _env->comm);
+        vector<idx_t> my_info(2 * nddims), info(2 * nddims * nranks);
+        for (int di = 0; di < nddims; di++) {
+            auto& dname = ddims.getDimName(di);
+            my_info[di] = _opts->_rank_indices[dname];
+            my_info[nddims + di] = _opts->_rank_sizes[dname];
+        }
+        MPI_Allgather(my_info.data(), 2 * nddims, MPI_INTEGER8,
+                      info.data(), 2 * nddims, MPI_INTEGER8, _env->comm);
+        auto rank_index = [&](int rn, int di) { return info[rn * 2 * nddims + di]; };
+        auto rank_size = [&](int rn, int di) { return info[rn * 2 * nddims + nddims + di]; };
+
+        // Balanced enough?
+        double max_secs = 0., sum_secs = 0.;
+        for (auto t : secs) {
+            max_secs = max(max_secs, t);
+            sum_secs += t;
+        }
+        double avg_secs = sum_secs / nranks;
+        if (max_secs <= 0. ||
+            max_secs <= avg_secs * (1. + _opts->rebalance_tolerance / 100.)) {
+            TRACE_MSG("rebalance_ranks: not needed; max time = " << max_secs <<
+                      ", avg time = " << avg_secs);
+            return false;
+        }
+
+        // Find new sizes for each slab of ranks in each dim.  Each slab is
+        // moved halfway toward the size that would equalize its time at its
+        // measured cost per point to avoid oscillating due to noise.
+        vector<vector<idx_t>> old_sizes(nddims), new_sizes(nddims);
+        bool changed = false;
+        for (int di = 0; di < nddims; di++) {
+            auto& dname = ddims.getDimName(di);
+            idx_t nr = _opts->_num_ranks[dname];
+            auto& osz = old_sizes[di];
+            auto& nsz = new_sizes[di];
+            osz.assign(nr, 0);
+            vector<double> cost(nr, 0.);
+            for (int rn = 0; rn < nranks; rn++) {
+                auto ri = rank_index(rn, di);
+                osz[ri] = rank_size(rn, di);
+                cost[ri] = max(cost[ri], secs[rn]);
+            }
+            nsz = osz;
+            if (nr < 2 || *min_element(cost.begin(), cost.end()) <= 0.)
+                continue;
+
+            // Points per sec in each slab.
+            idx_t tot_size = 0;
+            double tot_rate = 0.;
+            for (idx_t i = 0; i < nr; i++) {
+                tot_size += osz[i];
+                tot_rate += osz[i] / cost[i];
+            }
+
+            idx_t mult = _dims->_fold_pts[dname];
+            idx_t min_size = ROUND_UP(max(max(max_halos[dname], wf_shifts[dname]), idx_t(1)), mult);
+            idx_t new_tot = 0;
+            for (idx_t i = 0; i < nr; i++) {
+                double target = tot_size * (osz[i] / cost[i]) / tot_rate;
+                double sz = osz[i] + 0.5 * (target - osz[i]);
+                nsz[i] = max(idx_t(llround(sz / mult)) * mult, min_size);
+                new_tot += nsz[i];
+            }
+
+            // Put any rounding difference in the last slab.
+            nsz[nr - 1] += tot_size - new_tot;
+            if (nsz[nr - 1] < min_size)
+                nsz = osz;
+            if (nsz != osz)
+                changed = true;
+        }
+        if (!changed) {
+            TRACE_MSG("rebalance_ranks: no size changes needed");
+            return false;
+        }
+
+        os << "\nRebalancing rank domains: slowest rank time = " << makeNumStr(max_secs) <<
+            " sec, average = " << makeNumStr(avg_secs) << " sec.\n";
+        for (int di = 0; di < nddims; di++) {
+            if (new_sizes[di] == old_sizes[di])
+                continue;
+            os << " Rank-domain sizes in '" << ddims.getDimName(di) << "' dim changed from";
+            for (auto sz : old_sizes[di])
+                os << " " << sz;
+            os << " to";
+            for (auto sz : new_sizes[di])
+                os << " " << sz;
+            os << ".\n";
+        }
+
+        // Migrate to the new sizes.
+        IdxTuple my_sizes = _opts->_rank_sizes;
+        for (int di = 0; di < nddims; di++) {
+            auto& dname = ddims.getDimName(di);
+            my_sizes[dname] = new_sizes[di][_opts->_rank_indices[dname]];
+        }
+        resize_rank_domain(my_sizes);
+        return true;
+#endif
+    }
+
+    // Change the size of this rank's domain to 'sizes' and move grid data
+    // to the ranks that own it afterward. Must be called collectively.
+    void StencilContext::resize_rank_domain(const IdxTuple& sizes) {
+        if (!rank_bb.bb_valid)
+            THROW_YASK_EXCEPTION("Error: resize_rank_domain() called without calling prepare_solution() first");
+#ifndef USE_MPI
+        if (sizes != _opts->_rank_sizes)
+            THROW_YASK_EXCEPTION("Error: resize_rank_domain(): "
+                                 "the domain size cannot change with only one rank");
+#else
+        ostream& os = get_ostr();
+        int nranks = _env->num_ranks;
+        auto me = _env->my_rank;
+        auto& ddims = _dims->_domain_dims;
+        int nddims = ddims.getNumDims();
+
+        // Gather rank indices and old and new sizes from all ranks.
+        vector<idx_t> my_info(3 * nddims), info(3 * nddims * nranks);
+        for (int di = 0; di < nddims; di++) {
+            auto& dname = ddims.getDimName(di);
+            my_info[di] = _opts->_rank_indices[dname];
+            my_info[nddims + di] = _opts->_rank_sizes[dname];
+            my_info[2 * nddims + di] = sizes[dname];
+        }
+        MPI_Allgather(my_info.data(), 3 * nddims, MPI_INTEGER8,
+                      info.data(), 3 * nddims, MPI_INTEGER8, _env->comm);
+        auto rank_index = [&](int rn, int di) { return info[rn * 3 * nddims + di]; };
+
+        // Sizes of each slab of ranks in each dim. All ranks in a slab
+        // must have the same size in that dim.
+        vector<vector<idx_t>> old_sizes(nddims), new_sizes(nddims);
+        for (int di = 0; di < nddims; di++) {
+            auto& dname = ddims.getDimName(di);
+            idx_t nr = _opts->_num_ranks[dname];
+            old_sizes[di].assign(nr, -1);
+            new_sizes[di].assign(nr, -1);
+            idx_t old_tot = 0, new_tot = 0;
+            for (int rn = 0; rn < nranks; rn++) {
+                auto ri = rank_index(rn, di);
+                for (int j = 1; j <= 2; j++) {
+                    auto& sz = (j == 1) ? old_sizes[di][ri] : new_sizes[di][ri];
+                    auto rsz = info[rn * 3 * nddims + j * nddims + di];
+                    if (sz >= 0 && sz != rsz)
+                        FORMAT_AND_THROW_YASK_EXCEPTION("Error: resize_rank_domain(): rank " << rn <<
+                                                        " has size " << rsz << " in '" << dname <<
+                                                        "' dim, but another rank at the same index has size " << sz);
+                    sz = rsz;
+                }
+            }
+            for (idx_t i = 0; i < nr; i++) {
+                old_tot += old_sizes[di][i];
+                new_tot += new_sizes[di][i];
+                if (new_sizes[di][i] < 1)
+                    FORMAT_AND_THROW_YASK_EXCEPTION("Error: resize_rank_domain(): invalid size " <<
+                                                    new_sizes[di][i] << " in '" << dname << "' dim");
+            }
+            if (new_tot != old_tot)
+                FORMAT_AND_THROW_YASK_EXCEPTION("Error: resize_rank_domain(): sum of sizes in '" <<
+                                                dname << "' dim changed from " << old_tot <<
+                                                " to " << new_tot);
+        }
+
+        // Begin and end of rank 'rn' in dim 'di' given the slab sizes.
+        auto slab_begin = [&](const vector<vector<idx_t>>& sizes, int rn, int di) {
+            idx_t ofs = 0;
+            for (idx_t i = 0; i < rank_index(rn, di); i++)
+                ofs += sizes[di][i];
+            return ofs;
+        };
+        auto slab_end = [&](const vector<vector<idx_t>>& sizes, int rn, int di) {
+            return slab_begin(sizes, rn, di) + sizes[di][rank_index(rn, di)];
+        };
+
+        // Grids whose data is distributed across ranks.
+        GridPtrs mgrids;
+        for (auto gp : gridPtrs) {
+            if (!gp || gp->is_fixed_size() || !gp->is_storage_allocated())
+                continue;
+            for (auto& dim : ddims.getDims())
+                if (gp->is_dim_used(dim.getName())) {
+                    mgrids.push_back(gp);
+                    break;
+                }
+        }
+
+        // Find slice of grid 'gp' in both the old domain of rank 'src'
+        // and the new domain of rank 'dst'. Returns false if empty.
+        // Halos outside the overall domain are included; they stay with
+        // the first and last ranks in each dim.
+        auto grid_begin = [&](YkGridPtr gp, const vector<vector<idx_t>>& sizes,
+                              int rn, int di) {
+            idx_t b = slab_begin(sizes, rn, di);
+            if (rank_index(rn, di) == 0)
+                b -= gp->get_left_halo_size(ddims.getDimName(di));
+            return b;
+        };
+        auto grid_end = [&](YkGridPtr gp, const vector<vector<idx_t>>& sizes,
+                            int rn, int di) {
+            idx_t e = slab_end(sizes, rn, di);
+            if (rank_index(rn, di) == idx_t(sizes[di].size()) - 1)
+                e += gp->get_right_halo_size(ddims.getDimName(di));
+            return e;
+        };
+        auto get_slice = [&](YkGridPtr gp, int src, int dst,
+                             Indices& first, Indices& last) {
+            int ngdims = gp->get_num_dims();
+            first = Indices(ngdims);
+            last = Indices(ngdims);
+            for (int i = 0; i < ngdims; i++) {
+                auto& dname = gp->get_dim_name(i);
+                int di = ddims.lookup_posn(dname);
+                if (dname == _dims->_step_dim) {
+                    first[i] = 0;
+                    last[i] = gp->get_alloc_size(dname) - 1;
+                }
+                else if (di >= 0) {
+                    first[i] = max(grid_begin(gp, old_sizes, src, di),
+                                   grid_begin(gp, new_sizes, dst, di));
+                    last[i] = min(grid_end(gp, old_sizes, src, di),
+                                  grid_end(gp, new_sizes, dst, di)) - 1;
+                    if (last[i] < first[i])
+                        return false;
+                }
+                else {
+                    first[i] = gp->get_first_misc_index(dname);
+                    last[i] = gp->get_last_misc_index(dname);
+                }
+            }
+            return true;
+        };
+        auto slice_size = [&](const Indices& first, const Indices& last) {
+            idx_t n = 1;
+            for (int i = 0; i < first.getNumDims(); i++)
+                n *= last[i] - first[i] + 1;
+            return n;
+        };
+
+        // Copy my data into a buffer for each rank that will own part of it.
+        vector<vector<real_t>> send_bufs(nranks), recv_bufs(nranks);
+        for (int rn = 0; rn < nranks; rn++) {
+            idx_t nsend = 0, nrecv = 0;
+            Indices first, last;
+            for (auto gp : mgrids) {
+                if (get_slice(gp, me, rn, first, last))
+                    nsend += slice_size(first, last);
+                if (get_slice(gp, rn, me, first, last))
+                    nrecv += slice_size(first, last);
+            }
+            send_bufs[rn].resize(nsend);
+            recv_bufs[rn].resize(nrecv);
+            idx_t ofs = 0;
+            for (auto gp : mgrids) {
+                if (get_slice(gp, me, rn, first, last))
+                    ofs += gp->get_elements_in_slice(send_bufs[rn].data() + ofs, first, last);
+            }
+            assert(ofs == nsend);
+        }
+
+        // Exchange the buffers.
+        vector<MPI_Request> reqs;
+        for (int rn = 0; rn < nranks; rn++) {
+            if (rn == me) {
+                recv_bufs[rn].swap(send_bufs[rn]);
+                continue;
+            }
+            for (int is_send = 0; is_send < 2; is_send++) {
+                auto& buf = is_send ? send_bufs[rn] : recv_bufs[rn];
+                if (!buf.size())
+                    continue;
+                size_t nbytes = buf.size() * sizeof(real_t);
+                if (nbytes > size_t(INT_MAX))
+                    THROW_YASK_EXCEPTION("Error: rebalance_ranks(): too much data to move to rank " +
+                                         to_string(rn));
+                reqs.push_back(MPI_REQUEST_NULL);
+                if (is_send)
+                    MPI_Isend(buf.data(), int(nbytes), MPI_BYTE, rn, 0, _env->comm, &reqs.back());
+                else
+                    MPI_Irecv(buf.data(), int(nbytes), MPI_BYTE, rn, 0, _env->comm, &reqs.back());
+            }
+        }
+        MPI_Waitall(int(reqs.size()), reqs.data(), MPI_STATUSES_IGNORE);
+        send_bufs.clear();
+
+        // Apply the new sizes. A region that covered the whole rank
+        // domain still does.
+        for (int di = 0; di < nddims; di++) {
+            auto& dname = ddims.getDimName(di);
+            auto ri = _opts->_rank_indices[dname];
+            if (_opts->_region_sizes[dname] == old_sizes[di][ri])
+                _opts->_region_sizes[dname] = new_sizes[di][ri];
+            _opts->_rank_sizes[dname] = new_sizes[di][ri];
+        }
+
+        // Reallocate everything with the new sizes.
+        for (auto gp : mgrids)
+            gp->release_storage();
+        freeScratchData(os);
+        freeMpiData(os);
+        setupRank();
+        allocGridData(os);
+        allocScratchData(os);
+        allocMpiData(os);
+
+        // Copy received data into the new grids. This also marks the
+        // grids dirty so the halos will be exchanged before use.
+        for (int rn = 0; rn < nranks; rn++) {
+            idx_t ofs = 0;
+            Indices first, last;
+            for (auto gp : mgrids) {
+                if (get_slice(gp, rn, me, first, last))
+                    ofs += gp->set_elements_in_slice(recv_bufs[rn].data() + ofs, first, last);
+            }
+            assert(ofs == idx_t(recv_bufs[rn].size()));
+        }
+
+        // Update work stats for the new domain.
+        print_info();
+#endif
+    }
+
     // Init all grids & params by calling initFn.
     void StencilContext::initValues(function<void (YkGridPtr gp,
                                                    real_t seed)> realInitFn) {
@@ -1342,6 +2841,7 @@ namespace yask {
         ext_bb.bb_begin = rank_bb.bb_begin.subElements(left_wf_exts);
         ext_bb.bb_end = rank_bb.bb_end.addElements(right_wf_exts);
         ext_bb.update_bb("extended-rank", *this, true);
+        _step_plan.valid = false;
 
         // Find BB for each pack.
         for (auto sp : stPacks) {
@@ -1374,6 +2874,8 @@ namespace yask {
         auto nddims = domain_dims.size();
         auto nsdims = stencil_dims.size();
         TRACE_MSG3(get_name() << ".find_bounding_box()...");
+        _bb_list.clear();
+        _use_masks = false;
 
         // First, find an overall BB around all the
         // valid points in the bundle.
@@ -1641,6 +3143,18 @@ namespace yask {
                     }
                 }
             }
+
+            // If the valid points are too fragmented, scan the overall BB
+            // with vectors masked by the condition instead. Scratch
+            // bundles are evaluated over their own spans, so they keep
+            // the solid BBs.
+            if (!is_scratch() && idx_t(_bb_list.size()) > settings->max_full_bbs) {
+                TRACE_MSG3("replacing " << _bb_list.size() <<
+                           " sub-BB(s) with masked overall BB");
+                _bb_list.clear();
+                _bb_list.push_back(_bundle_bb);
+                _use_masks = true;
+            }
         }
     }
 
@@ -0,0 +1,239 @@
+/*****************************************************************************
+
+YASK: Yet Another Stencil Kernel
+Copyright (c) 2014-2018, Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+
+*****************************************************************************/
+
+// This file contains implementations of StencilContext methods
+// for writing grid snapshots in the background during run_solution().
+
+// At each due step, a step callback copies the slice into one of two
+// staging buffers with all threads. A writer thread then appends the
+// buffer to the rank's file while the stencils continue. The callback
+// waits only if both buffers are still being written.
+
+#include "yask_stencil.hpp"
+#include <fcntl.h>
+using namespace std;
+
+namespace yask {
+
+    // Size of the header at the start of each file.
+    static const size_t snap_hdr_bytes = 4096;
+
+    // Write all of 'buf' at 'ofs'. Return true if OK.
+    static bool snapWrite(int fd, const char* buf, size_t nbytes, off_t ofs) {
+        while (nbytes) {
+            ssize_t n = pwrite(fd, buf, nbytes, ofs);
+            if (n <= 0)
+                return false;
+            buf += n;
+            nbytes -= n;
+            ofs += n;
+        }
+        return true;
+    }
+
+    // Append the filled buffers to the file until stopped.
+    void StencilContext::Snapshot::write_bufs() {
+        int bi = 0;
+        while (true) {
+            {
+                unique_lock<mutex> lk(lock);
+                cv.wait(lk, [&]{ return buf_full[bi] || stop; });
+                if (!buf_full[bi])
+                    break;
+            }
+
+            // Record is the step index followed by the elements.
+            bool ok = snapWrite(fd, (const char*)&buf_steps[bi], sizeof(idx_t), file_ofs) &&
+                snapWrite(fd, bufs[bi].get(), nbytes, file_ofs + sizeof(idx_t));
+            file_ofs += sizeof(idx_t) + nbytes;
+            {
+                lock_guard<mutex> lk(lock);
+                buf_full[bi] = false;
+                if (ok)
+                    nwritten++;
+                else
+                    failed = true;
+            }
+            cv.notify_all();
+            bi = 1 - bi;
+        }
+    }
+
+    // Copy the slice at step 't' into the next buffer and
+    // hand it to the writer.
+    void StencilContext::Snapshot::copy_step(idx_t t) {
+        if (!nbytes)
+            return;
+        int bi = next_buf;
+        {
+            unique_lock<mutex> lk(lock);
+            if (buf_full[bi]) {
+                nwaits++;
+                cv.wait(lk, [&]{ return !buf_full[bi]; });
+            }
+        }
+        if (step_posn >= 0) {
+            first[step_posn] = t;
+            last[step_posn] = t;
+        }
+        gp->get_elements_in_slice(bufs[bi].get(), first, last);
+        {
+            lock_guard<mutex> lk(lock);
+            buf_steps[bi] = t;
+            buf_full[bi] = true;
+        }
+        cv.notify_all();
+        next_buf = 1 - bi;
+    }
+
+    void StencilContext::add_snapshot(const string& grid_name,
+                                      const vector<idx_t>& first_indices,
+                                      const vector<idx_t>& last_indices,
+                                      idx_t first_step_index,
+                                      idx_t step_interval,
+                                      const string& path) {
+        ostream& os = get_ostr();
+        if (!rank_bb.bb_valid)
+            THROW_YASK_EXCEPTION("Error: add_snapshot() called without calling prepare_solution() first");
+        auto gi = gridMap.find(grid_name);
+        if (gi == gridMap.end())
+            THROW_YASK_EXCEPTION("Error: add_snapshot() called with unknown grid '" +
+                                 grid_name + "'");
+        auto gp = gi->second;
+        int ndims = gp->get_num_dims();
+        if (int(first_indices.size()) != ndims || int(last_indices.size()) != ndims)
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: add_snapshot() called with " <<
+                                            first_indices.size() << " and " <<
+                                            last_indices.size() << " indices for grid '" <<
+                                            grid_name << "', which has " << ndims << " dim(s)");
+
+        // Limit the slice to this rank's domain.
+        auto sp = make_shared<Snapshot>();
+        sp->gp = gp;
+        sp->first = Indices(first_indices);
+        sp->last = Indices(last_indices);
+        bool is_empty = false;
+        for (int i = 0; i < ndims; i++) {
+            auto& dname = gp->get_dim_name(i);
+            if (dname == _dims->_step_dim)
+                sp->step_posn = i;
+            else if (_dims->_domain_dims.lookup(dname)) {
+                sp->first[i] = max(sp->first[i], gp->get_first_rank_domain_index(dname));
+                sp->last[i] = min(sp->last[i], gp->get_last_rank_domain_index(dname));
+            }
+            if (sp->last[i] < sp->first[i])
+                is_empty = true;
+        }
+        if (!is_empty) {
+            idx_t nelems = 1;
+            for (int i = 0; i < ndims; i++)
+                if (i != sp->step_posn)
+                    nelems *= sp->last[i] - sp->first[i] + 1;
+            sp->nbytes = size_t(nelems) * get_element_bytes();
+        }
+
+        // Header describing the records.
+        ostringstream oss;
+        oss << "YASK snapshot 1\n"
+            "grid: " << grid_name << "\n"
+            "element-bytes: " << get_element_bytes() << "\n"
+            "dims:";
+        for (int i = 0; i < ndims; i++)
+            oss << " " << gp->get_dim_name(i);
+        oss << "\nfirst:";
+        for (int i = 0; i < ndims; i++)
+            oss << " " << ((i == sp->step_posn || is_empty) ? 0 : sp->first[i]);
+        oss << "\nlast:";
+        for (int i = 0; i < ndims; i++)
+            oss << " " << ((i == sp->step_posn || is_empty) ? -1 : sp->last[i]);
+        oss << "\nrecord-bytes: " << (sizeof(idx_t) + sp->nbytes) << "\n";
+        string hdr = oss.str();
+        if (hdr.length() > snap_hdr_bytes)
+            THROW_YASK_EXCEPTION("Error: add_snapshot(): header too long for grid '" +
+                                 grid_name + "'");
+        hdr.resize(snap_hdr_bytes, '\n');
+
+        // Create the file.
+        sp->fname = path + ".rank" + to_string(_env->my_rank) + ".snap";
+        sp->fd = open(sp->fname.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (sp->fd < 0)
+            THROW_YASK_EXCEPTION("Error: add_snapshot(): cannot create '" + sp->fname + "'");
+        if (!snapWrite(sp->fd, hdr.data(), hdr.length(), 0)) {
+            close(sp->fd);
+            THROW_YASK_EXCEPTION("Error: add_snapshot(): cannot write to '" + sp->fname + "'");
+        }
+        sp->file_ofs = snap_hdr_bytes;
+
+        // Staging buffers, locked in memory if allowed.
+        if (sp->nbytes) {
+            for (int bi = 0; bi < 2; bi++) {
+                sp->bufs[bi] = shared_ptr<char>(alignedAlloc(sp->nbytes), AlignedDeleter());
+                mlock(sp->bufs[bi].get(), sp->nbytes);
+            }
+        }
+
+        // Start the writer and call the copier at the due steps.
+        sp->writer = thread([sp]{ sp->write_bufs(); });
+        _snapshots.push_back(sp);
+        add_step_callback([sp](idx_t t) { sp->copy_step(t); },
+                          first_step_index, step_interval, { grid_name }, {});
+        _step_callbacks.back().is_snapshot = true;
+        os << "Writing snapshots of " << makeByteStr(sp->nbytes) << " from grid '" <<
+            grid_name << "' every " << step_interval << " step(s) to '" << sp->fname << "'.\n";
+    }
+
+    void StencilContext::finish_snapshots() {
+        ostream& os = get_ostr();
+        string msg;
+        for (auto& sp : _snapshots) {
+            {
+                lock_guard<mutex> lk(sp->lock);
+                sp->stop = true;
+            }
+            sp->cv.notify_all();
+            if (sp->writer.joinable())
+                sp->writer.join();
+            if (sp->nbytes) {
+                for (int bi = 0; bi < 2; bi++)
+                    munlock(sp->bufs[bi].get(), sp->nbytes);
+            }
+            if (close(sp->fd) != 0 || sp->failed)
+                msg = "cannot write to '" + sp->fname + "'";
+            os << "Wrote " << sp->nwritten << " snapshot(s) to '" << sp->fname <<
+                "'; waited for the writer " << sp->nwaits << " time(s).\n";
+        }
+        _snapshots.clear();
+
+        // Remove the callbacks that refer to the snapshots.
+        vector<StepCallback> cbs;
+        for (auto& cb : _step_callbacks)
+            if (!cb.is_snapshot)
+                cbs.push_back(cb);
+        _step_callbacks.swap(cbs);
+        if (msg.length())
+            THROW_YASK_EXCEPTION("Error: finish_snapshots(): " + msg);
+    }
+
+} // namespace yask.
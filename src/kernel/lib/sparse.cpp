@@ -0,0 +1,235 @@
+/*****************************************************************************
+
+YASK: Yet Another Stencil Kernel
+Copyright (c) 2014-2018, Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+
+*****************************************************************************/
+
+
+// This file contains implementations of StencilContext methods
+// for sparse source-injection and receiver-sampling operators.
+
+#include "yask_stencil.hpp"
+using namespace std;
+
+namespace yask {
+
+    int StencilContext::add_sparse_points(const string& grid_name,
+                                          bool is_source,
+                                          idx_t num_points,
+                                          const vector<idx_t>& tap_points,
+                                          const vector<idx_t>& tap_indices,
+                                          const vector<double>& tap_weights) {
+        auto& step_dim = _dims->_step_dim;
+        auto step_posn = Indices::step_posn;
+
+        auto gi = gridMap.find(grid_name);
+        if (gi == gridMap.end())
+            THROW_YASK_EXCEPTION("Error: add_sparse_points() called with unknown grid '" +
+                                 grid_name + "'");
+        auto gp = gi->second;
+        if (gp->get_dim_posn(step_dim) != step_posn)
+            THROW_YASK_EXCEPTION("Error: add_sparse_points() called with grid '" +
+                                 grid_name + "' that does not use the step dimension");
+
+        // Apply after the last pack that writes the grid.
+        SparseOp so;
+        for (auto& bp : stPacks)
+            for (auto* sb : *bp)
+                for (auto ogp : sb->outputGridPtrs)
+                    if (ogp == gp)
+                        so.bp = bp;
+        if (!so.bp)
+            THROW_YASK_EXCEPTION("Error: add_sparse_points() called with grid '" +
+                                 grid_name + "' that is not written by any stencil equation");
+
+        // Check and save the taps.
+        idx_t ntaps = tap_points.size();
+        int ndims = gp->get_num_dims();
+        if (num_points < 0 || idx_t(tap_weights.size()) != ntaps ||
+            idx_t(tap_indices.size()) != ntaps * (ndims - 1))
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: add_sparse_points() called with " <<
+                                            ntaps << " tap point(s), " << tap_weights.size() <<
+                                            " weight(s) and " << tap_indices.size() <<
+                                            " index value(s) for grid '" << grid_name <<
+                                            "', which needs " << (ndims - 1) << " per tap");
+        so.gp = gp;
+        so.is_source = is_source;
+        so.num_points = num_points;
+        for (idx_t j = 0; j < ntaps; j++) {
+            if (tap_points[j] < 0 || tap_points[j] >= num_points)
+                FORMAT_AND_THROW_YASK_EXCEPTION("Error: add_sparse_points() called with tap " <<
+                                                j << " at point " << tap_points[j] <<
+                                                ", which is not in [0, " << num_points << ")");
+            Indices idxs(ndims);
+            for (int i = 0, k = 0; i < ndims; i++)
+                idxs[i] = (i == step_posn) ? 0 : tap_indices[j * (ndims - 1) + k++];
+            so.tap_idxs.push_back(idxs);
+            so.tap_pts.push_back(tap_points[j]);
+            so.tap_wts.push_back(real_t(tap_weights[j]));
+        }
+
+        TRACE_MSG("add_sparse_points: " << (is_source ? "source" : "receiver") <<
+                  " op with " << num_points << " point(s) and " << ntaps <<
+                  " tap(s) in grid '" << grid_name << "' after pack '" <<
+                  so.bp->get_name() << "'");
+        _sparse_ops.push_back(so);
+        return int(_sparse_ops.size()) - 1;
+    }
+
+    StencilContext::SparseOp& StencilContext::get_sparse_op(int op_id, const string& fn) {
+        if (op_id < 0 || op_id >= int(_sparse_ops.size()))
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: " << fn << "() called with unknown op ID " <<
+                                            op_id);
+        return _sparse_ops[op_id];
+    }
+
+    void StencilContext::set_sparse_steps(int op_id,
+                                          idx_t first_step_index,
+                                          idx_t last_step_index) {
+        auto& so = get_sparse_op(op_id, "set_sparse_steps");
+        if (last_step_index < first_step_index)
+            FORMAT_AND_THROW_YASK_EXCEPTION("Error: set_sparse_steps() called with last step " <<
+                                            last_step_index << " before first step " <<
+                                            first_step_index);
+        so.first_t = first_step_index;
+        so.num_t = last_step_index - first_step_index + 1;
+        so.vals.assign(so.num_t * so.num_points, real_t(0));
+    }
+
+    void StencilContext::set_sparse_values(int op_id, const void* buffer_ptr) {
+        auto& so = get_sparse_op(op_id, "set_sparse_values");
+        if (so.vals.size())
+            memcpy(so.vals.data(), buffer_ptr, so.vals.size() * sizeof(real_t));
+    }
+
+    void StencilContext::get_sparse_values(int op_id, void* buffer_ptr) {
+        auto& so = get_sparse_op(op_id, "get_sparse_values");
+        if (!so.vals.size())
+            return;
+
+        // Sum partial values of receivers over ranks.
+#ifdef USE_MPI
+        if (!so.is_source) {
+            MPI_Allreduce(so.vals.data(), buffer_ptr, so.vals.size(),
+                          (sizeof(real_t) == 4) ? MPI_FLOAT : MPI_DOUBLE,
+                          MPI_SUM, _env->comm);
+            return;
+        }
+#endif
+        memcpy(buffer_ptr, so.vals.data(), so.vals.size() * sizeof(real_t));
+    }
+
+    void StencilContext::prep_sparse_ops() {
+        auto step_posn = Indices::step_posn;
+        auto& step_dim = _dims->_step_dim;
+
+        for (auto& so : _sparse_ops) {
+            auto& gp = so.gp;
+            if (!gp->is_storage_allocated())
+                THROW_YASK_EXCEPTION("Error: sparse points in grid '" + gp->get_name() +
+                                     "' with no data allocated");
+            int ndims = gp->get_num_dims();
+
+            // Find taps in this rank.
+            so.local_taps.clear();
+            for (idx_t j = 0; j < idx_t(so.tap_idxs.size()); j++) {
+                auto& idxs = so.tap_idxs[j];
+                bool ok = true;
+                for (int i = 0; ok && i < ndims; i++) {
+                    if (i == step_posn)
+                        continue;
+                    auto& dname = gp->get_dim_name(i);
+                    idx_t first = gp->_get_first_alloc_index(i);
+                    idx_t last = gp->_get_last_alloc_index(i);
+                    if (!so.is_source && _dims->_domain_dims.lookup(dname)) {
+                        first = rank_domain_offsets[dname];
+                        last = first + _opts->_rank_sizes[dname] - 1;
+                    }
+                    ok = idxs[i] >= first && idxs[i] <= last;
+                }
+                if (ok)
+                    so.local_taps.push_back(j);
+            }
+
+            // Group receiver taps by point.
+            so.pt_begin.assign(so.num_points + 1, 0);
+            if (!so.is_source) {
+                stable_sort(so.local_taps.begin(), so.local_taps.end(),
+                            [&](idx_t a, idx_t b) { return so.tap_pts[a] < so.tap_pts[b]; });
+                for (auto j : so.local_taps)
+                    so.pt_begin[so.tap_pts[j] + 1]++;
+                for (idx_t p = 0; p < so.num_points; p++)
+                    so.pt_begin[p + 1] += so.pt_begin[p];
+            }
+
+            // Element pointers in each step slot.
+            idx_t nslots = gp->get_alloc_size(step_dim);
+            so.ptrs.assign(nslots, vector<real_t*>());
+            for (idx_t s = 0; s < nslots; s++) {
+                for (auto j : so.local_taps) {
+                    Indices idxs(so.tap_idxs[j]);
+                    idxs[step_posn] = s;
+                    so.ptrs[s].push_back(gp->getElemPtr(idxs, s, false));
+                }
+            }
+            TRACE_MSG("prep_sparse_ops: " << so.local_taps.size() << " of " <<
+                      so.tap_idxs.size() << " tap(s) in grid '" << gp->get_name() <<
+                      "' in this rank");
+        }
+    }
+
+    void StencilContext::apply_sparse_ops(const BundlePackPtr& bp, idx_t t) {
+        for (auto& so : _sparse_ops) {
+            if (so.bp != bp)
+                continue;
+            idx_t ti = t - so.first_t;
+            if (ti < 0 || ti >= so.num_t)
+                continue;
+            auto& ptrs = so.ptrs[so.gp->get_alloc_step_slot(t)];
+            real_t* vals = so.vals.data() + ti * so.num_points;
+            idx_t ntaps = so.local_taps.size();
+
+            // Add weighted values into the grid. Points may share taps.
+            if (so.is_source) {
+#pragma omp parallel for schedule(static)
+                for (idx_t i = 0; i < ntaps; i++) {
+                    idx_t j = so.local_taps[i];
+                    real_t v = vals[so.tap_pts[j]] * so.tap_wts[j];
+#pragma omp atomic
+                    *ptrs[i] += v;
+                }
+            }
+
+            // Save weighted sums of the grid at each point.
+            else {
+#pragma omp parallel for schedule(static)
+                for (idx_t p = 0; p < so.num_points; p++) {
+                    real_t sum = 0;
+                    for (idx_t i = so.pt_begin[p]; i < so.pt_begin[p + 1]; i++)
+                        sum += *ptrs[i] * so.tap_wts[so.local_taps[i]];
+                    vals[p] = sum;
+                }
+            }
+        }
+    }
+
+} // namespace yask.
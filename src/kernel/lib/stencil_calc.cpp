@@ -48,8 +48,22 @@ namespace yask {
                    " by thread " << thread_idx);
         assert(!is_scratch());
 
-        // TODO: if >1 BB, check outer one first to save time.
-        
+        // If >1 BB, check the outer one first to save time. This quickly
+        // skips blocks that don't touch a bundle that only covers part of
+        // the domain, e.g., the boundary shell of a split equation.
+        if (_bb_list.size() > 1) {
+            for (int i = 0, j = 0; i < nsdims; i++) {
+                if (i == step_posn) continue;
+                if (min(def_block_idxs.end[i], _bundle_bb.bb_end[j]) <=
+                    max(def_block_idxs.begin[i], _bundle_bb.bb_begin[j])) {
+                    TRACE_MSG3("calc_block for bundle '" << get_name() <<
+                               "': no overlap between bundle BB and current block");
+                    return;
+                }
+                j++;            // next domain index.
+            }
+        }
+
         // Loop through each solid BB.
         // For each BB, calc intersection between it and 'def_block_idxs'.
         // If this is non-empty, apply the bundle to all its required sub-blocks.
@@ -120,10 +134,22 @@ namespace yask {
                            " ... (end before) " << block_idxs.end.makeValStr(nsdims) <<
                            " by thread " << thread_idx);
 
+                // Visit sub-blocks along a space-filling curve.
+                auto order = get_scan_order(_generic_context->get_settings()->sub_block_order);
+                if (order != scan_order_loops) {
+                    vector<ScanIndices> sub_blocks;
+                    get_sub_ranges(block_idxs, order, sub_blocks);
+#pragma omp parallel for schedule(static, 1) proc_bind(close)
+                    for (idx_t sbn = 0; sbn < idx_t(sub_blocks.size()); sbn++)
+                        sg->calc_sub_block(thread_idx, sub_blocks[sbn]);
+                }
+
                 // Include automatically-generated loop code that calls
                 // calc_sub_block() for each sub-block in this block. This
                 // code typically contains the nested OpenMP loop(s).
+                else {
 #include "yask_block_loops.hpp"
+                }
             }
         } // BB list.
     }
@@ -175,6 +201,14 @@ namespace yask {
         TRACE_MSG3("calc_sub_block for reqd bundle '" << get_name() << "': " <<
                    block_idxs.start.makeValStr(nsdims) <<
                    " ... (end before) " << block_idxs.stop.makeValStr(nsdims));
+        TRACE_EVENT("compute", "sub-block");
+        cp->bind_block_thread();
+
+        // Read HW counters before the work in this sub-block.
+        bool do_perf = opts->perf_counters;
+        PerfCounters::Vals perf_begin;
+        if (do_perf)
+            do_perf = PerfCounters::read(perf_begin);
 
         /*
           Indices in each domain dim:
@@ -196,6 +230,21 @@ namespace yask {
         ScanIndices sub_block_idxs(*dims, true, 0);
         sub_block_idxs.initFromOuter(block_idxs);
 
+#ifndef FORCE_SCALAR
+        // If the condition is applied with write masks, every element is
+        // done in the vector code.
+        if (_use_masks) {
+            calc_masked_sub_block(thread_idx, sub_block_idxs);
+            make_stores_visible(_generic_context->use_nt_stores());
+            if (do_perf) {
+                PerfCounters::Vals perf_end;
+                if (PerfCounters::read(perf_end))
+                    _perf_counts.add_diff(perf_begin, perf_end);
+            }
+            return;
+        }
+#endif
+
         // Sub block indices in element units and rank-relative.
         ScanIndices sub_block_eidxs(sub_block_idxs);
 
@@ -227,15 +276,15 @@ namespace yask {
         bool do_clusters = false; // any clusters to do?
         bool do_vectors = false; // any vectors to do? (assume not)
         bool do_scalars = false; // any scalars to do? (assume not)
-        bool scalar_for_peel_rem = false; // using the scalar code for peel and/or remainder.
 
         // Do only scalar code--no clusters or vectors--for debug.
+        // Otherwise, peels and remainders in all dims, including
+        // the inner one, are done with masked vectors.
 #ifdef FORCE_SCALAR
         do_clusters = false;
         do_vectors = false;
         do_scalars = true;
-        scalar_for_peel_rem = false;
-        
+
         // None of these will be used.
         sub_block_fcidxs.begin.setFromConst(0);
         sub_block_fcidxs.end.setFromConst(0);
@@ -298,17 +347,6 @@ namespace yask {
                     auto fvend = round_down_flr(eend, vpts);
                     auto vbgn = round_down_flr(ebgn, vpts);
                     auto vend = round_up_flr(eend, vpts);
-                    if (i == _inner_posn) {
-
-                        // Don't do any full and/or partial vectors in
-                        // plane of inner dim.  We'll do these with
-                        // scalars.  This is unusual because vector
-                        // folding is normally done in a plane
-                        // perpendicular to the inner dim for >= 2D
-                        // domains.
-                        fvbgn = vbgn = fcbgn;
-                        fvend = vend = fcend;
-                    }
                     sub_block_fvidxs.begin[i] = fvbgn;
                     sub_block_fvidxs.end[i] = fvend;
                     sub_block_vidxs.begin[i] = vbgn;
@@ -375,16 +413,6 @@ namespace yask {
                         peel_masks[i] = pmask;
                         rem_masks[i] = rmask;
                     }
-
-                    // Anything not covered?
-                    // This will only be needed in inner dim because we
-                    // will do partial vectors in other dims.
-                    // Set 'scalar_for_peel_rem' to indicate we only want to
-                    // do peel and/or rem in scalar loop.
-                    if (i == _inner_posn && (ebgn < vbgn || eend > vend)) {
-                        do_scalars = true;
-                        scalar_for_peel_rem = true;
-                    }
                 }
 
                 // If no peel or rem, just set vec indices to same as
@@ -488,9 +516,11 @@ namespace yask {
             // loop-of-vectors function w/appropriate mask.
             // See the mask diagrams above that show how the
             // masks are ANDed together.
-            // Since step is always 1, we ignore loop_idxs.stop.
+            // Rows that are within the clusters in all the outer dims only
+            // need the vectors before and after the clusters in the inner
+            // dim; other rows need all the vectors in the inner dim.
 #define calc_inner_loop(thread_idx, loop_idxs)                          \
-            bool ok = false;                                            \
+            bool ok = !do_clusters;                                     \
             idx_t mask = idx_t(-1);                                     \
             for (int i = 0; i < nsdims; i++) {                          \
                 if (i != step_posn &&                                   \
@@ -504,7 +534,23 @@ namespace yask {
                         mask &= rem_masks[i];                           \
                 }                                                       \
             }                                                           \
-            if (ok) calc_loop_of_vectors(thread_idx, loop_idxs, mask);
+            auto ibgn = loop_idxs.start[_inner_posn];                   \
+            auto iend = loop_idxs.stop[_inner_posn];                    \
+            auto fcbgn = norm_sub_block_fcidxs.begin[_inner_posn];      \
+            auto fcend = norm_sub_block_fcidxs.end[_inner_posn];        \
+            auto fvbgn = norm_sub_block_fvidxs.begin[_inner_posn];      \
+            auto fvend = norm_sub_block_fvidxs.end[_inner_posn];        \
+            auto pmask = peel_masks[_inner_posn];                       \
+            auto rmask = rem_masks[_inner_posn];                        \
+            if (ok)                                                     \
+                calc_row_of_vectors(thread_idx, loop_idxs.start, ibgn, iend, \
+                                    fvbgn, fvend, mask, pmask, rmask);  \
+            else {                                                      \
+                calc_row_of_vectors(thread_idx, loop_idxs.start, ibgn, fcbgn, \
+                                    fvbgn, fvend, mask, pmask, rmask);  \
+                calc_row_of_vectors(thread_idx, loop_idxs.start, fcend, iend, \
+                                    fvbgn, fvend, mask, pmask, rmask);  \
+            }
 
             // Include automatically-generated loop code that calls
             // calc_inner_loop(). This is different from the higher-level
@@ -513,7 +559,8 @@ namespace yask {
 #undef calc_inner_loop
         }
 
-        // Use scalar code for anything not done above.
+        // Use scalar code for the entire sub-block.
+        // This is only done when FORCE_SCALAR is defined.
         if (do_scalars) {
 
             // Use the 'misc' loops. Indices for these loops will be scalar and
@@ -524,8 +571,7 @@ namespace yask {
             misc_idxs.step.setFromConst(1);
             misc_idxs.align.setFromConst(1);
 
-            TRACE_MSG3((scalar_for_peel_rem ? "peel/remainder of" : "entire") <<
-                       " sub-block" <<
+            TRACE_MSG3("calc_sub_block:  using scalar code for " <<
                        misc_idxs.begin.makeValStr(nsdims) <<
                        " ... (end before) " <<
                        misc_idxs.end.makeValStr(nsdims));
@@ -537,19 +583,8 @@ namespace yask {
             // Since step is always 1, we ignore misc_idxs.stop.
 #define misc_fn(pt_idxs)  do {                                          \
                 TRACE_MSG3("calc_sub_block:   at pt " << pt_idxs.start.makeValStr(nsdims)); \
-                bool ok = false;                                        \
-                if (scalar_for_peel_rem) {                              \
-                    for (int i = 0, j = 0; i < nsdims; i++) {           \
-                        if (i == step_posn) continue;                   \
-                        auto rofs = cp->rank_domain_offsets[j];         \
-                        if (pt_idxs.start[i] < rofs + sub_block_vidxs.begin[i] || \
-                            pt_idxs.start[i] >= rofs + sub_block_vidxs.end[i]) { \
-                            ok = true; break; }                         \
-                        j++;                                            \
-                    }                                                   \
-                }                                                       \
-                else ok = is_in_valid_domain(pt_idxs.start);            \
-                if (ok) calc_scalar(thread_idx, pt_idxs.start);         \
+                if (is_in_valid_domain(pt_idxs.start))                  \
+                    calc_scalar(thread_idx, pt_idxs.start);             \
             } while(0)
 
             // Scan through n-D space.
@@ -560,10 +595,176 @@ namespace yask {
         }
 
         // Make sure streaming stores are visible for later loads.
-        make_stores_visible();
-        
+        make_stores_visible(_generic_context->use_nt_stores());
+
+        // Add counts for this sub-block to this bundle.
+        if (do_perf) {
+            PerfCounters::Vals perf_end;
+            if (PerfCounters::read(perf_end))
+                _perf_counts.add_diff(perf_begin, perf_end);
+        }
+
     } // calc_sub_block.
 
+    // Calculate results for one sub-block using vectors only.
+    // Each vector is masked by the bundle's sub-domain condition and by
+    // the sub-block boundaries. Consecutive vectors in the inner dim
+    // with the same mask are done in one call to the generated code.
+    void StencilBundleBase::calc_masked_sub_block(int thread_idx,
+                                                  const ScanIndices& sub_block_idxs) {
+        auto* cp = _generic_context;
+        auto& dims = cp->get_dims();
+        int nsdims = dims->_stencil_dims.size();
+        auto step_posn = Indices::step_posn;
+        TRACE_MSG3("calc_masked_sub_block for bundle '" << get_name() << "': " <<
+                   sub_block_idxs.begin.makeValStr(nsdims) <<
+                   " ... (end before) " << sub_block_idxs.end.makeValStr(nsdims));
+
+        // Mask with all elements of a vector on.
+        idx_t nvpts = dims->_fold_pts.product();
+        idx_t full_mask = (nvpts >= idx_t(8 * sizeof(idx_t))) ?
+            idx_t(-1) : (idx_t(1) << nvpts) - 1;
+
+        // Rank-relative range of vectors covering the sub-block and the
+        // masks for the first and last vectors in each dim.
+        Indices vbgn(sub_block_idxs.begin), vend(sub_block_idxs.end);
+        Indices vpts(nsdims), rofs(nsdims);
+        Indices peel_masks(nsdims), rem_masks(nsdims);
+        vpts.setFromConst(1);
+        rofs.setFromConst(0);
+        peel_masks.setFromConst(-1);
+        rem_masks.setFromConst(-1);
+        vend[step_posn] = vbgn[step_posn] + 1;
+
+        // i: index for stencil dims, j: index for domain dims.
+        for (int i = 0, j = 0; i < nsdims; i++) {
+            if (i == step_posn)
+                continue;
+            rofs[i] = cp->rank_domain_offsets[j];
+            vpts[i] = dims->_fold_pts[j];
+            auto ebgn = sub_block_idxs.begin[i] - rofs[i];
+            auto eend = sub_block_idxs.end[i] - rofs[i];
+            vbgn[i] = round_down_flr(ebgn, vpts[i]);
+            vend[i] = round_up_flr(eend, vpts[i]);
+
+            // Same bit order as the masks in calc_sub_block().
+            if (vbgn[i] < ebgn || vend[i] > eend) {
+                idx_t pmask = 0, rmask = 0;
+                idx_t mbit = idx_t(1) << (nvpts - 1);
+                dims->_fold_pts.visitAllPoints
+                    ([&](const IdxTuple& pt, size_t idx) {
+                        pmask >>= 1;
+                        rmask >>= 1;
+                        if (vbgn[i] + pt[j] >= ebgn)
+                            pmask |= mbit;
+                        if (vend[i] - vpts[i] + pt[j] < eend)
+                            rmask |= mbit;
+                        return true;
+                    });
+                peel_masks[i] = pmask;
+                rem_masks[i] = rmask;
+            }
+            j++;
+        }
+
+        // Visit each row of vectors along the inner dim.
+        Indices vidx(vbgn), gidx(vbgn), norm_idxs(vbgn);
+        while (true) {
+
+            // Masks of sub-block boundaries in outer dims.
+            idx_t row_mask = idx_t(-1);
+            for (int i = 0; i < nsdims; i++) {
+                if (i == step_posn || i == _inner_posn)
+                    continue;
+                if (vidx[i] == vbgn[i])
+                    row_mask &= peel_masks[i];
+                if (vidx[i] + vpts[i] == vend[i])
+                    row_mask &= rem_masks[i];
+            }
+
+            // Scan the row, batching vectors with the same mask.
+            idx_t run_bgn = vbgn[_inner_posn], run_mask = 0;
+            for (idx_t v = vbgn[_inner_posn]; v <= vend[_inner_posn];
+                 v += vpts[_inner_posn]) {
+                idx_t mask = 0;
+                if (v < vend[_inner_posn]) {
+                    vidx[_inner_posn] = v;
+                    for (int i = 0; i < nsdims; i++)
+                        gidx[i] = vidx[i] + rofs[i];
+                    mask = row_mask & get_valid_mask(gidx);
+                    if (v == vbgn[_inner_posn])
+                        mask &= peel_masks[_inner_posn];
+                    if (v + vpts[_inner_posn] == vend[_inner_posn])
+                        mask &= rem_masks[_inner_posn];
+                    if ((mask & full_mask) == full_mask)
+                        mask = idx_t(-1);
+                }
+
+                // End of a run?
+                if (v == vend[_inner_posn] || mask != run_mask) {
+                    if (run_mask && v > run_bgn) {
+                        vidx[_inner_posn] = run_bgn;
+                        normalize_indices(vidx, norm_idxs);
+                        calc_loop_of_vectors(thread_idx, norm_idxs,
+                                             idiv_flr<idx_t>(v, vpts[_inner_posn]),
+                                             run_mask);
+                    }
+                    run_bgn = v;
+                    run_mask = mask;
+                }
+            }
+
+            // Next row.
+            int i = nsdims - 1;
+            for (; i >= 0; i--) {
+                if (i == step_posn || i == _inner_posn)
+                    continue;
+                vidx[i] += vpts[i];
+                if (vidx[i] < vend[i])
+                    break;
+                vidx[i] = vbgn[i];
+            }
+            if (i < 0)
+                break;
+        }
+    }
+
+    // Calculate the vectors from 'ibgn' to 'iend' in the inner dim, masking
+    // each one by 'mask' and also by 'peel_mask' if it is before 'fvbgn'
+    // and by 'rem_mask' if it is at or after 'fvend'. Consecutive vectors
+    // with the same mask are done in one call to the generated code.
+    // Indices must be rank-relative and normalized.
+    void StencilBundleBase::calc_row_of_vectors(int thread_idx,
+                                                const Indices& start_idxs,
+                                                idx_t ibgn, idx_t iend,
+                                                idx_t fvbgn, idx_t fvend,
+                                                idx_t mask,
+                                                idx_t peel_mask,
+                                                idx_t rem_mask) {
+        Indices idxs(start_idxs);
+        idx_t run_bgn = ibgn, run_mask = 0;
+        for (idx_t v = ibgn; v <= iend; v++) {
+            idx_t vmask = 0;
+            if (v < iend) {
+                vmask = mask;
+                if (v < fvbgn)
+                    vmask &= peel_mask;
+                if (v >= fvend)
+                    vmask &= rem_mask;
+            }
+
+            // End of a run?
+            if (v == iend || vmask != run_mask) {
+                if (run_mask && v > run_bgn) {
+                    idxs[_inner_posn] = run_bgn;
+                    calc_loop_of_vectors(thread_idx, idxs, v, run_mask);
+                }
+                run_bgn = v;
+                run_mask = vmask;
+            }
+        }
+    }
+
     // Calculate a series of cluster results within an inner loop.
     // The 'loop_idxs' must specify a range only in the inner dim.
     // Indices must be rank-relative.
@@ -63,7 +63,14 @@ namespace yask {
 	// These must be non-overlapping. These do NOT contain
         // any invalid points. These will all be inside '_bundle_bb'.
 	BBList _bb_list;
+
+        // Whether '_bb_list' holds only '_bundle_bb' even though it is not
+        // solid, so the condition is applied with SIMD write masks.
+        bool _use_masks = false;
 	
+        // HW counts accumulated over all threads in calc_sub_block().
+        PerfCounters _perf_counts;
+
         // Normalize the indices, i.e., divide by vector len in each dim.
         // Ranks offsets must already be subtracted.
         // Each dim in 'orig' must be a multiple of corresponding vec len.
@@ -82,6 +89,17 @@ namespace yask {
         ScratchVecs outputScratchVecs;
         ScratchVecs inputScratchVecs;
 
+        // One grid point accessed by these stencils, used by the cache
+        // simulator. 'offsets' holds one value per grid dim: the offset
+        // from the point being calculated in a stencil dim or the
+        // constant index in a misc dim.
+        struct GridAccess {
+            YkGridPtr gp;
+            Indices offsets;
+            bool is_write;
+        };
+        std::vector<GridAccess> _accesses;
+
         // ctor, dtor.
         StencilBundleBase(StencilContext* context) :
             _generic_context(context) {
@@ -125,6 +143,10 @@ namespace yask {
         // Access to BBs.
         virtual BoundingBox& getBB() { return _bundle_bb; }
         virtual BBList& getBBs() { return _bb_list; }
+        virtual bool is_using_masks() const { return _use_masks; }
+
+        // Access to HW counts.
+        virtual PerfCounters& get_perf_counts() { return _perf_counts; }
 
         // Add dependency.
         virtual void add_dep(StencilBundleBase* eg) {
@@ -166,6 +188,11 @@ namespace yask {
         virtual bool
         is_in_valid_domain(const Indices& idxs) const =0;
 
+        // Get mask of valid elements in the vector starting at 'idxs'.
+        // Indices must be global and in element units.
+        virtual idx_t
+        get_valid_mask(const Indices& idxs) const =0;
+
         // Calculate one scalar result at time t.
         virtual void
         calc_scalar(int thread_idx, const Indices& idxs) =0;
@@ -178,6 +205,24 @@ namespace yask {
         virtual void
         calc_sub_block(int thread_idx, const ScanIndices& block_idxs);
 
+        // Calculate results within a sub-block using only vectors
+        // masked by the sub-domain condition.
+        // Indices must be global and in element units.
+        virtual void
+        calc_masked_sub_block(int thread_idx, const ScanIndices& sub_block_idxs);
+
+        // Calculate the vectors in one row along the inner dim,
+        // applying peel and remainder masks at its ends.
+        // Indices must be rank-relative and normalized.
+        virtual void
+        calc_row_of_vectors(int thread_idx,
+                            const Indices& start_idxs,
+                            idx_t ibgn, idx_t iend,
+                            idx_t fvbgn, idx_t fvend,
+                            idx_t mask,
+                            idx_t peel_mask,
+                            idx_t rem_mask);
+
         // Calculate a series of cluster results within an inner loop.
         // All indices start at 'start_idxs'. Inner loop iterates to
         // 'stop_inner' by 'step_inner'.
@@ -0,0 +1,130 @@
+/*****************************************************************************
+
+YASK: Yet Another Stencil Kernel
+Copyright (c) 2014-2018, Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+
+*****************************************************************************/
+
+#include "yask.hpp"
+#include <iomanip>
+using namespace std;
+
+namespace yask {
+
+    bool EventTracer::_enabled = false;
+    size_t EventTracer::_capacity = 0;
+    vector<EventTracer::ThreadBuf*> EventTracer::_bufs;
+
+    EventTracer::ThreadBuf* EventTracer::get_buf() {
+        static thread_local ThreadBuf* tb = 0;
+        if (!tb) {
+            auto* nb = new ThreadBuf;
+#pragma omp critical (yask_event_tracer)
+            {
+                nb->tid = int(_bufs.size());
+                nb->events.resize(_capacity);
+                _bufs.push_back(nb);
+            }
+            tb = nb;
+        }
+        return tb;
+    }
+
+    void EventTracer::enable(size_t max_events) {
+        if (max_events < 1)
+            max_events = 1;
+#pragma omp critical (yask_event_tracer)
+        {
+            _capacity = max_events;
+            for (auto* tb : _bufs) {
+                tb->events.clear();
+                tb->events.resize(_capacity);
+                tb->num_added = 0;
+            }
+        }
+        _enabled = true;
+    }
+
+    void EventTracer::add(const char* cat, const char* name,
+                          uint64_t begin_ns, uint64_t end_ns) {
+        auto* tb = get_buf();
+        if (tb->events.size() == 0)
+            return;
+        auto& ev = tb->events[tb->num_added % tb->events.size()];
+        ev.cat = cat;
+        ev.name = name;
+        ev.begin_ns = begin_ns;
+        ev.end_ns = end_ns;
+        tb->num_added++;
+    }
+
+    void EventTracer::clear() {
+#pragma omp critical (yask_event_tracer)
+        {
+            for (auto* tb : _bufs)
+                tb->num_added = 0;
+        }
+    }
+
+    size_t EventTracer::write(const string& fname, int pid) {
+        ofstream ofs(fname);
+        if (!ofs)
+            THROW_YASK_EXCEPTION("Error: cannot open '" + fname + "' for writing trace");
+
+        // Use a common origin so that all threads line up.
+        uint64_t t0 = 0;
+        for (auto* tb : _bufs) {
+            size_t n = min(tb->num_added, tb->events.size());
+            for (size_t i = 0; i < n; i++)
+                if (!t0 || tb->events[i].begin_ns < t0)
+                    t0 = tb->events[i].begin_ns;
+        }
+
+        // Events in each thread, oldest first. Times are in usec.
+        size_t nevents = 0;
+        ofs << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" << endl;
+        ofs << fixed << setprecision(3);
+        bool first = true;
+        for (auto* tb : _bufs) {
+            if (!first)
+                ofs << "," << endl;
+            first = false;
+            ofs << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid <<
+                ",\"tid\":" << tb->tid << ",\"args\":{\"name\":\"thread " << tb->tid << "\"}}";
+
+            size_t cap = tb->events.size();
+            size_t n = min(tb->num_added, cap);
+            size_t first_i = tb->num_added - n;
+            for (size_t j = 0; j < n; j++) {
+                auto& ev = tb->events[(first_i + j) % cap];
+                ofs << "," << endl <<
+                    "{\"ph\":\"X\",\"cat\":\"" << ev.cat <<
+                    "\",\"name\":\"" << ev.name <<
+                    "\",\"pid\":" << pid << ",\"tid\":" << tb->tid <<
+                    ",\"ts\":" << (double(ev.begin_ns - t0) * 1e-3) <<
+                    ",\"dur\":" << (double(ev.end_ns - ev.begin_ns) * 1e-3) << "}";
+                nevents++;
+            }
+        }
+        ofs << endl << "]}" << endl;
+        return nevents;
+    }
+}
@@ -0,0 +1,119 @@
+/*****************************************************************************
+
+YASK: Yet Another Stencil Kernel
+Copyright (c) 2014-2018, Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+
+*****************************************************************************/
+
+#pragma once
+
+// Low-overhead timeline tracing of kernel events.
+// Events are kept in a fixed-size ring buffer per thread and can be
+// written in the Chrome trace-event format for viewing in
+// chrome://tracing or https://ui.perfetto.dev.
+
+namespace yask {
+
+    // Process-wide event recorder.
+    // Since there is one recorder, only one solution at a time should
+    // enable tracing.
+    class EventTracer {
+    public:
+
+        // One complete event.
+        // 'cat' and 'name' must remain valid until the events are written.
+        struct Event {
+            const char* cat = 0;
+            const char* name = 0;
+            uint64_t begin_ns = 0, end_ns = 0;
+        };
+
+    protected:
+
+        // Ring buffer for one thread.
+        struct ThreadBuf {
+            int tid = 0;
+            std::vector<Event> events;
+            size_t num_added = 0; // total added, including overwritten ones.
+        };
+
+        static bool _enabled;
+        static size_t _capacity;
+        static std::vector<ThreadBuf*> _bufs;
+
+        // Get the calling thread's buffer, making it if needed.
+        static ThreadBuf* get_buf();
+
+    public:
+
+        // Get current time.
+        static uint64_t now_ns() {
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return uint64_t(ts.tv_sec) * 1000000000ULL + uint64_t(ts.tv_nsec);
+        }
+
+        // Start recording, keeping the latest 'max_events' per thread.
+        static void enable(size_t max_events);
+
+        // Stop recording. Events are kept until clear().
+        static void disable() { _enabled = false; }
+
+        static bool is_enabled() { return _enabled; }
+
+        // Record a completed event for the calling thread.
+        static void add(const char* cat, const char* name,
+                        uint64_t begin_ns, uint64_t end_ns);
+
+        // Discard all events.
+        static void clear();
+
+        // Write all events to 'fname' in Chrome trace-event JSON format.
+        // Use the MPI rank for 'pid' so files from different ranks can
+        // be viewed together. Returns number of events written.
+        static size_t write(const std::string& fname, int pid);
+    };
+
+    // Records an event from construction to destruction.
+    // Does nothing but check a flag when tracing is disabled.
+    class ScopedTraceEvent {
+        const char* _cat;
+        const char* _name;
+        uint64_t _begin = 0;
+
+    public:
+        ScopedTraceEvent(const char* cat, const char* name) :
+            _cat(cat), _name(name) {
+            if (EventTracer::is_enabled())
+                _begin = EventTracer::now_ns();
+        }
+        ~ScopedTraceEvent() {
+            if (_begin)
+                EventTracer::add(_cat, _name, _begin, EventTracer::now_ns());
+        }
+    };
+}
+
+// Record an event in category 'cat' until the end of the current scope.
+#define TRACE_EVENT_VAR2(line) _trace_event_ ## line
+#define TRACE_EVENT_VAR(line) TRACE_EVENT_VAR2(line)
+#define TRACE_EVENT(cat, name) \
+    yask::ScopedTraceEvent TRACE_EVENT_VAR(__LINE__)(cat, name)
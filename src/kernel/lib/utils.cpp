@@ -24,6 +24,10 @@ IN THE SOFTWARE.
 *****************************************************************************/
 
 #include "yask.hpp"
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
 using namespace std;
 
 // Set MODEL_CACHE to 1 or 2 to model that cache level
@@ -58,20 +62,118 @@ namespace yask {
         return static_cast<char*>(p);
     }
 
+#ifdef USE_NUMA
+#ifndef USE_NUMA_POLICY_LIB
+    // Apply NUMA binding to mmapped memory.
+    static void numaBind(void* p, std::size_t nbytes, int numa_pref) {
+        if (numa_pref >= 0) {
+
+            // Prefer given node.
+            unsigned long nodemask = 0x1UL << numa_pref;
+            mbind(p, nbytes, MPOL_PREFERRED, &nodemask, sizeof(nodemask) * 8, 0);
+        }
+        else if (numa_pref == yask_numa_interleave) {
+
+            // Use all nodes.
+            unsigned long nodemask = (unsigned long)-1;
+            mbind(p, nbytes, MPOL_INTERLEAVE, &nodemask, sizeof(nodemask) * 8, 0);
+        }
+
+        else{
+
+            // Use local node.
+            // MPOL_LOCAL was defined in Linux 3.8, so use
+            // MPOL_DEFAULT as backup on old systems.
+#ifdef MPOL_LOCAL
+            mbind(p, nbytes, MPOL_LOCAL, 0, 0, 0);
+#else
+            mbind(p, nbytes, MPOL_DEFAULT, 0, 0, 0);
+#endif
+        }
+    }
+#endif
+#endif
+
+    // Huge-page allocation.
+    // Explicit huge pages are tried first if requested; if they are not
+    // available, fall back to an anonymous map advised to use
+    // transparent huge pages.
+    // The number of bytes mapped is returned in 'mapped_bytes'.
+    static char* hugePageAlloc(std::size_t nbytes, int huge_pages,
+                               std::size_t* mapped_bytes) {
+        int mmprot = PROT_READ | PROT_WRITE;
+        int mmflags = MAP_PRIVATE | MAP_ANONYMOUS;
+        void* p = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+        if (huge_pages == yask_huge_pages_2m || huge_pages == yask_huge_pages_1g) {
+            int hflags = MAP_HUGETLB;
+            size_t psize = YASK_HUGE_ALIGNMENT;
+            if (huge_pages == yask_huge_pages_1g) {
+                psize = 1024 * 1024 * 1024;
+#ifdef MAP_HUGE_1GB
+                hflags |= MAP_HUGE_1GB;
+#endif
+            }
+#ifdef MAP_HUGE_2MB
+            else
+                hflags |= MAP_HUGE_2MB;
+#endif
+            size_t msz = ROUND_UP(nbytes, psize);
+            p = mmap(0, msz, mmprot, mmflags | hflags, -1, 0);
+            if (p != MAP_FAILED)
+                *mapped_bytes = msz;
+        }
+#endif
+
+        // Transparent huge pages, requested or as a fallback.
+        if (p == MAP_FAILED) {
+            size_t msz = ROUND_UP(nbytes, YASK_HUGE_ALIGNMENT);
+            p = mmap(0, msz, mmprot, mmflags, -1, 0);
+            if (p == MAP_FAILED)
+                THROW_YASK_EXCEPTION("Error: anonymous mmap of " + makeByteStr(msz) +
+                                     " failed");
+            *mapped_bytes = msz;
+#ifdef MADV_HUGEPAGE
+            madvise(p, msz, MADV_HUGEPAGE);
+#endif
+        }
+        return static_cast<char*>(p);
+    }
+
     // NUMA allocation.
     // 'numa_pref' >= 0: preferred NUMA node.
     // 'numa_pref' < 0: use defined policy.
-    char* numaAlloc(std::size_t nbytes, int numa_pref) {
+    // 'huge_pages': one of the yask_huge_pages_* policies.
+    // If the memory is mmapped, the number of bytes mapped is returned
+    // in 'mapped_bytes'; otherwise, it is set to zero.
+    char* numaAlloc(std::size_t nbytes, int numa_pref, int huge_pages,
+                    std::size_t* mapped_bytes) {
+        *mapped_bytes = 0;
 
-        if (numa_pref == yask_numa_none)
+        if (numa_pref == yask_numa_none && huge_pages == yask_huge_pages_none)
             return alignedAlloc(nbytes);
 
 #ifndef USE_NUMA
-        THROW_YASK_EXCEPTION("Error: explicit NUMA policy allocation is not enabled");
+        if (numa_pref != yask_numa_none)
+            THROW_YASK_EXCEPTION("Error: explicit NUMA policy allocation is not enabled");
 #endif
 
         void *p = 0;
 
+        // Huge pages, with NUMA binding if available.
+        if (huge_pages != yask_huge_pages_none) {
+            p = hugePageAlloc(nbytes, huge_pages, mapped_bytes);
+#ifdef USE_NUMA
+#ifndef USE_NUMA_POLICY_LIB
+            if (numa_pref != yask_numa_none &&
+                get_mempolicy(NULL, NULL, 0, 0, 0) == 0)
+                numaBind(p, *mapped_bytes, numa_pref);
+#endif
+#endif
+            return static_cast<char*>(p);
+        }
+
 #ifdef USE_NUMA
 #ifdef USE_NUMA_POLICY_LIB
 #pragma omp single
@@ -100,30 +202,8 @@ namespace yask {
 
             // If successful, apply the desired binding.
             if (p && p != MAP_FAILED) {
-                if (numa_pref >= 0) {
-
-                    // Prefer given node.
-                    unsigned long nodemask = 0x1UL << numa_pref;
-                    mbind(p, nbytes, MPOL_PREFERRED, &nodemask, sizeof(nodemask) * 8, 0);
-                }
-                else if (numa_pref == yask_numa_interleave) {
-
-                    // Use all nodes.
-                    unsigned long nodemask = (unsigned long)-1;
-                    mbind(p, nbytes, MPOL_INTERLEAVE, &nodemask, sizeof(nodemask) * 8, 0);
-                }
-
-                else{
-
-                    // Use local node.
-                    // MPOL_LOCAL was defined in Linux 3.8, so use
-                    // MPOL_DEFAULT as backup on old systems.
-#ifdef MPOL_LOCAL
-                    mbind(p, nbytes, MPOL_LOCAL, 0, 0, 0);
-#else
-                    mbind(p, nbytes, MPOL_DEFAULT, 0, 0, 0);
-#endif
-                }
+                *mapped_bytes = nbytes;
+                numaBind(p, nbytes, numa_pref);
             }
             else
                 THROW_YASK_EXCEPTION("Error: anonymous mmap of " + makeByteStr(nbytes) +
@@ -141,6 +221,471 @@ namespace yask {
         return static_cast<char*>(p);
     }
 
+    bool numaMove(void* p, std::size_t nbytes, int numa_node) {
+#if defined(USE_NUMA) && !defined(USE_NUMA_POLICY_LIB)
+        if (numa_node < 0 || numa_node >= int(sizeof(unsigned long) * 8) ||
+            get_mempolicy(NULL, NULL, 0, 0, 0) != 0)
+            return false;
+        unsigned long nodemask = 0x1UL << numa_node;
+        return mbind(p, nbytes, MPOL_PREFERRED, &nodemask, sizeof(nodemask) * 8,
+                     MPOL_MF_MOVE) == 0;
+#else
+        return false;
+#endif
+    }
+
+    // Use the smallest cached block with the same policies that is at
+    // least 'nbytes' but not more than twice that.
+    shared_ptr<char> MemPool::alloc(size_t nbytes, int numa_pref,
+                                    int huge_pages) {
+        Block b;
+        {
+            lock_guard<mutex> lk(_lock);
+            size_t best = _free.size();
+            for (size_t i = 0; i < _free.size(); i++) {
+                auto& fb = _free[i];
+                if (fb.numa_pref == numa_pref && fb.huge_pages == huge_pages &&
+                    fb.nbytes >= nbytes && fb.nbytes / 2 <= nbytes &&
+                    (best == _free.size() || fb.nbytes < _free[best].nbytes))
+                    best = i;
+            }
+            if (best < _free.size()) {
+                b = _free[best];
+                _free.erase(_free.begin() + best);
+                _cached_bytes -= b.nbytes;
+                _used_bytes += b.nbytes;
+                _num_reuses++;
+            }
+        }
+
+        // Nothing to reuse.
+        if (!b.p) {
+            b.p = numaAlloc(nbytes, numa_pref, huge_pages, &b.mapped_bytes);
+            b.nbytes = nbytes;
+            b.numa_pref = numa_pref;
+            b.huge_pages = huge_pages;
+            lock_guard<mutex> lk(_lock);
+            _used_bytes += b.nbytes;
+            _num_new++;
+        }
+        return shared_ptr<char>(b.p, PoolDeleter(shared_from_this(), b));
+    }
+
+    void MemPool::put(const Block& b) {
+        lock_guard<mutex> lk(_lock);
+        _free.push_back(b);
+        _used_bytes -= b.nbytes;
+        _cached_bytes += b.nbytes;
+    }
+
+    void MemPool::release_cached() {
+        lock_guard<mutex> lk(_lock);
+        for (auto& b : _free)
+            free_block(b);
+        _free.clear();
+        _cached_bytes = 0;
+    }
+
+    // Hardware events for the PerfCounters enums.
+    static const struct {
+        uint64_t config;
+        const char* name;
+    } perf_events[PerfCounters::num_ctrs] = {
+        { PERF_COUNT_HW_CPU_CYCLES, "cycles" },
+        { PERF_COUNT_HW_INSTRUCTIONS, "instructions" },
+        { PERF_COUNT_HW_CACHE_REFERENCES, "LLC-refs" },
+        { PERF_COUNT_HW_CACHE_MISSES, "LLC-misses" }
+    };
+
+    // Counter fds of the calling thread, closed when the thread exits.
+    // The group leader is -1 if not yet opened; -2 if not available.
+    struct PerfFds {
+        int leader = -1;
+        vector<int> fds;
+        ~PerfFds() {
+            for (int fd : fds)
+                close(fd);
+        }
+    };
+    static thread_local PerfFds perf_fds;
+
+    // Open and enable the counters for the calling thread.
+    static int perfOpen() {
+        auto& fds = perf_fds.fds;
+        fds.resize(PerfCounters::num_ctrs, -1);
+        for (int i = 0; i < PerfCounters::num_ctrs; i++) {
+            struct perf_event_attr pe;
+            memset(&pe, 0, sizeof(pe));
+            pe.type = PERF_TYPE_HARDWARE;
+            pe.size = sizeof(pe);
+            pe.config = perf_events[i].config;
+            pe.disabled = (i == 0) ? 1 : 0;
+            pe.exclude_kernel = 1;
+            pe.exclude_hv = 1;
+            pe.read_format = PERF_FORMAT_GROUP;
+
+            // pid=0, cpu=-1: count the calling thread on any CPU.
+            int leader = (i == 0) ? -1 : fds[0];
+            fds[i] = int(syscall(__NR_perf_event_open, &pe, 0, -1, leader, 0));
+            if (fds[i] < 0) {
+                for (int j = 0; j < i; j++)
+                    close(fds[j]);
+                fds.clear();
+                return -2;
+            }
+        }
+        ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        return fds[0];
+    }
+
+    const char* PerfCounters::get_name(int i) {
+        assert(i >= 0 && i < num_ctrs);
+        return perf_events[i].name;
+    }
+
+    bool PerfCounters::read(Vals& vals) {
+        if (perf_fds.leader == -1)
+            perf_fds.leader = perfOpen();
+        if (perf_fds.leader < 0)
+            return false;
+
+        // Format for PERF_FORMAT_GROUP: number of values, then values.
+        struct {
+            uint64_t nr;
+            uint64_t vals[num_ctrs];
+        } buf;
+        if (::read(perf_fds.leader, &buf, sizeof(buf)) != ssize_t(sizeof(buf)) ||
+            buf.nr != num_ctrs)
+            return false;
+        for (int i = 0; i < num_ctrs; i++)
+            vals[i] = buf.vals[i];
+        return true;
+    }
+
+    // Energy counters found by EnergyMeter.
+    struct EnergyZone {
+        string fname;           // file w/current value.
+        double scale = 1e-6;    // joules per count.
+        double max_count = 0.;  // value at which count wraps; 0 => never.
+        double last_count = 0.;
+        double wraps = 0.;      // joules from previous wrap-arounds.
+    };
+    static vector<EnergyZone> energy_zones;
+    static string energy_source;
+    static mutex energy_lock;
+
+    // Read one number from the start of a file.
+    static bool readNum(const string& fname, double& val) {
+        ifstream fs(fname);
+        return bool(fs >> val);
+    }
+
+    // Find the counters once.
+    static void findEnergyZones() {
+        static bool done = false;
+        if (done)
+            return;
+        done = true;
+        double val;
+
+        // Node-level counter in joules.
+        const string node_fname = "/sys/cray/pm_counters/energy";
+        if (readNum(node_fname, val)) {
+            EnergyZone ez;
+            ez.fname = node_fname;
+            ez.scale = 1.;
+            ez.last_count = val;
+            energy_zones.push_back(ez);
+            energy_source = "node (" + node_fname + ")";
+            return;
+        }
+
+        // RAPL packages ('intel-rapl:N') and their DRAM sub-zones
+        // ('intel-rapl:N:M' named 'dram'). Core and uncore sub-zones
+        // are already included in the packages.
+        const string pc_dir = "/sys/class/powercap/";
+        for (int pkg = 0; ; pkg++) {
+            string pkg_dir = pc_dir + "intel-rapl:" + to_string(pkg);
+            if (!readNum(pkg_dir + "/energy_uj", val))
+                break;
+            vector<string> dirs = { pkg_dir };
+            for (int sub = 0; ; sub++) {
+                string sub_dir = pkg_dir + ":" + to_string(sub);
+                ifstream fs(sub_dir + "/name");
+                string name;
+                if (!(fs >> name))
+                    break;
+                if (name == "dram")
+                    dirs.push_back(sub_dir);
+            }
+            for (auto& dir : dirs) {
+                EnergyZone ez;
+                ez.fname = dir + "/energy_uj";
+                if (!readNum(ez.fname, ez.last_count))
+                    continue;
+                readNum(dir + "/max_energy_range_uj", ez.max_count);
+                energy_zones.push_back(ez);
+            }
+        }
+        if (energy_zones.size())
+            energy_source = "RAPL (" + to_string(energy_zones.size()) + " zone(s) in " +
+                pc_dir + ")";
+    }
+
+    bool EnergyMeter::read(double& joules) {
+        lock_guard<mutex> lock(energy_lock);
+        findEnergyZones();
+        if (!energy_zones.size())
+            return false;
+        joules = 0.;
+        for (auto& ez : energy_zones) {
+            double count;
+            if (!readNum(ez.fname, count))
+                return false;
+            if (count < ez.last_count && ez.max_count > 0.)
+                ez.wraps += ez.max_count * ez.scale;
+            ez.last_count = count;
+            joules += ez.wraps + count * ez.scale;
+        }
+        return true;
+    }
+
+    string EnergyMeter::get_source() {
+        lock_guard<mutex> lock(energy_lock);
+        findEnergyZones();
+        return energy_source;
+    }
+
+    // Add a list of CPUs like "0-3,8,10-11" to 'cpus'.
+    // Return false on a syntax error.
+    static bool parseCpuList(const string& str, set<int>& cpus) {
+        istringstream ss(str);
+        string item;
+        while (getline(ss, item, ',')) {
+            if (item.find_first_not_of(" \t") == string::npos)
+                continue;
+            if (item.find_first_not_of("0123456789- \t") != string::npos)
+                return false;
+            int a = 0, b = 0;
+            int n = sscanf(item.c_str(), "%d-%d", &a, &b);
+            if (n < 1)
+                return false;
+            if (n < 2)
+                b = a;
+            if (a < 0 || b < a || b >= CPU_SETSIZE)
+                return false;
+            for (int c = a; c <= b; c++)
+                cpus.insert(c);
+        }
+        return true;
+    }
+
+    // Read a list of CPUs like "0-3,8,10-11" from a sysfs file.
+    static bool readCpuList(const string& fname, set<int>& cpus) {
+        ifstream fs(fname);
+        string line;
+        if (!fs || !getline(fs, line))
+            return false;
+        parseCpuList(line, cpus);
+        return true;
+    }
+
+    // Set 'mask' to 'allowed' or, if it is empty, to the calling thread's
+    // affinity.
+    static bool getCpuMask(const vector<int>& allowed, cpu_set_t& mask) {
+        if (allowed.empty())
+            return sched_getaffinity(0, sizeof(mask), &mask) == 0;
+        CPU_ZERO(&mask);
+        for (int c : allowed)
+            if (c >= 0 && c < CPU_SETSIZE)
+                CPU_SET(c, &mask);
+        return true;
+    }
+
+    bool CpuTopology::find_groups(int min_cpus, const vector<int>& allowed) {
+        _groups.clear();
+        _level = -1;
+        cpu_set_t mask;
+        if (!getCpuMask(allowed, mask))
+            return false;
+        vector<int> cpus;
+        for (int c = 0; c < CPU_SETSIZE; c++)
+            if (CPU_ISSET(c, &mask))
+                cpus.push_back(c);
+        if (!cpus.size())
+            return false;
+        const string sysdir = "/sys/devices/system/cpu/cpu";
+
+        // Groups of allowed CPUs that share something, given the
+        // sysfs file under each CPU dir that lists the sharing CPUs.
+        auto make_groups = [&](const string& leaf, vector<vector<int>>& groups) {
+            groups.clear();
+            set<int> done;
+            for (int c : cpus) {
+                if (done.count(c))
+                    continue;
+                set<int> shared;
+                if (!readCpuList(sysdir + to_string(c) + "/" + leaf, shared))
+                    return false;
+                vector<int> grp;
+                for (int s : shared)
+                    if (CPU_ISSET(s, &mask) && !done.count(s)) {
+                        grp.push_back(s);
+                        done.insert(s);
+                    }
+                if (!grp.size())
+                    grp.push_back(c);
+                groups.push_back(grp);
+            }
+            return true;
+        };
+
+        // Data and unified caches, smallest level first.
+        map<int, string> cache_dirs;
+        for (int i = 0; i < 16; i++) {
+            string idir = sysdir + to_string(cpus[0]) + "/cache/index" + to_string(i) + "/";
+            ifstream lfs(idir + "level"), tfs(idir + "type");
+            int level = 0;
+            string type;
+            if (!(lfs >> level))
+                break;
+            tfs >> type;
+            if (type != "Instruction" && !cache_dirs.count(level))
+                cache_dirs[level] = "cache/index" + to_string(i) + "/shared_cpu_list";
+        }
+        vector<vector<int>> groups;
+        for (auto& cd : cache_dirs) {
+            if (!make_groups(cd.second, groups))
+                continue;
+            size_t min_size = cpus.size();
+            for (auto& g : groups)
+                min_size = min(min_size, g.size());
+            if (int(min_size) >= min_cpus) {
+                _groups = groups;
+                _level = cd.first;
+                return true;
+            }
+        }
+
+        // Fall back to packages.
+        if (make_groups("topology/core_siblings_list", groups)) {
+            _groups = groups;
+            _level = 0;
+            return true;
+        }
+        return false;
+    }
+
+    int CpuTopology::get_cpu(int outer, int inner, int team_size) const {
+        if (!_groups.size())
+            return -1;
+        int ng = int(_groups.size());
+        int gsize = int(_groups[0].size());
+        int per_team = max(CEIL_DIV(team_size, gsize), 1);
+        auto& grp = _groups[(outer * per_team + inner / gsize) % ng];
+        return grp[inner % gsize % int(grp.size())];
+    }
+
+    int CpuTopology::get_sibling_cpu(int cpu) {
+        set<int> sibs;
+        if (cpu < 0 ||
+            !readCpuList("/sys/devices/system/cpu/cpu" + to_string(cpu) +
+                         "/topology/thread_siblings_list", sibs))
+            return -1;
+
+        // The next one after 'cpu', wrapping around.
+        auto it = sibs.upper_bound(cpu);
+        if (it == sibs.end())
+            it = sibs.begin();
+        return (*it == cpu) ? -1 : *it;
+    }
+
+    bool CpuTopology::find_numa_nodes(vector<int>& nodes,
+                                      vector<vector<int>>& cpus,
+                                      const vector<int>& allowed) {
+        nodes.clear();
+        cpus.clear();
+        cpu_set_t mask;
+        if (!getCpuMask(allowed, mask))
+            return false;
+        const string sysdir = "/sys/devices/system/node/";
+        set<int> online;
+        if (!readCpuList(sysdir + "online", online))
+            return false;
+        for (int n : online) {
+            set<int> ncpus;
+            if (!readCpuList(sysdir + "node" + to_string(n) + "/cpulist", ncpus))
+                continue;
+            vector<int> grp;
+            for (int c : ncpus)
+                if (CPU_ISSET(c, &mask))
+                    grp.push_back(c);
+            if (grp.size()) {
+                nodes.push_back(n);
+                cpus.push_back(grp);
+            }
+        }
+        return nodes.size() > 0;
+    }
+
+    bool CpuTopology::parse_cpu_list(const string& str, vector<int>& cpus) {
+        set<int> cset;
+        cpus.clear();
+        if (!parseCpuList(str, cset))
+            return false;
+        cpus.assign(cset.begin(), cset.end());
+        return true;
+    }
+
+    bool CpuTopology::get_thread_cpus(vector<int>& cpus) {
+        cpus.clear();
+        cpu_set_t mask;
+        if (sched_getaffinity(0, sizeof(mask), &mask) != 0)
+            return false;
+        for (int c = 0; c < CPU_SETSIZE; c++)
+            if (CPU_ISSET(c, &mask))
+                cpus.push_back(c);
+        return true;
+    }
+
+    // CPUs the calling thread was last bound to here.
+    static thread_local vector<int> bound_cpus;
+
+    bool CpuTopology::bind_thread(int cpu) {
+        if (cpu < 0)
+            return false;
+        return bind_thread(vector<int>(1, cpu));
+    }
+
+    bool CpuTopology::bind_thread(const vector<int>& cpus) {
+        if (cpus.empty())
+            return false;
+        if (cpus == bound_cpus)
+            return true;
+        cpu_set_t mask;
+        getCpuMask(cpus, mask);
+        if (sched_setaffinity(0, sizeof(mask), &mask) != 0)
+            return false;
+        bound_cpus = cpus;
+        return true;
+    }
+
+    string CpuTopology::make_info_string() const {
+        ostringstream os;
+        if (_level < 0)
+            return "not available";
+        os << _groups.size() << " group(s) sharing " <<
+            (_level ? "L" + to_string(_level) + " cache" : string("a package")) << ":";
+        for (auto& g : _groups) {
+            os << " {";
+            for (size_t i = 0; i < g.size(); i++)
+                os << (i ? "," : "") << g[i];
+            os << "}";
+        }
+        return os.str();
+    }
+
     // Return num with SI multiplier and "iB" suffix,
     // e.g., 412KiB.
     string makeByteStr(size_t nbytes)
@@ -364,6 +909,27 @@ namespace yask {
             _val << "." << endl;
     }
 
+    // Check for a string option.
+    bool CommandLineParser::StringOption::check_arg(std::vector<std::string>& args,
+                                                    int& argi) {
+        if (_check_arg(args, argi, _name)) {
+            if (size_t(argi) >= args.size() || args[argi].length() == 0) {
+                THROW_YASK_EXCEPTION("Error: no argument for option '" + args[argi - 1] + "'");
+            }
+            _val = args[argi++];
+            return true;
+        }
+        return false;
+    }
+
+    // Print help on a string option.
+    void CommandLineParser::StringOption::print_help(ostream& os,
+                                                     int width) const {
+        _print_help(os, _name + " <string>", width);
+        os << _help_leader << _current_value_str <<
+            "'" << _val << "'." << endl;
+    }
+
     // Print help on an multi-idx_t option.
     void CommandLineParser::MultiIdxOption::print_help(ostream& os,
                                                   int width) const {
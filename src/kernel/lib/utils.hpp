@@ -33,7 +33,6 @@ IN THE SOFTWARE.
 
 // Use mmap and mbind directly?
 #else
-#include <sys/mman.h>
 
 // Use <numaif.h> if available.
 #ifdef USE_NUMAIF_H
@@ -109,24 +108,33 @@ namespace yask {
 
     // Helpers for shared and NUMA malloc and free.
     // Use like this:
-    // shared_ptr<char> p(numaAlloc(nbytes, numa_pref), NumaDeleter(nbytes));
-    extern char* numaAlloc(std::size_t nbytes, int numa_pref);
+    // size_t mb;
+    // char* p = numaAlloc(nbytes, numa_pref, huge_pages, &mb);
+    // shared_ptr<char> sp(p, NumaDeleter(nbytes, mb));
+    extern char* numaAlloc(std::size_t nbytes, int numa_pref, int huge_pages,
+                           std::size_t* mapped_bytes);
+
+    // Move the pages in 'nbytes' from page-aligned 'p' to NUMA node
+    // 'numa_node' and prefer that node for pages not yet touched.
+    // Return false if NUMA binding is not available.
+    extern bool numaMove(void* p, std::size_t nbytes, int numa_node);
     struct NumaDeleter {
         std::size_t _nbytes;
-        NumaDeleter(std::size_t nbytes): _nbytes(nbytes) {}
+        std::size_t _mapped_bytes; // non-zero if mmapped.
+        NumaDeleter(std::size_t nbytes, std::size_t mapped_bytes) :
+            _nbytes(nbytes), _mapped_bytes(mapped_bytes) {}
         void operator()(char* p) {
 
+            if (p && _mapped_bytes) {
+                munmap(p, _mapped_bytes);
+                p = NULL;
+            }
 #ifdef USE_NUMA
 #ifdef USE_NUMA_POLICY_LIB
             if (p && numa_available() != -1) {
                 numa_free(p, _nbytes);
                 p = NULL;
             }
-#else
-            if (p && get_mempolicy(NULL, NULL, 0, 0, 0) == 0) {
-                munmap(p, _nbytes);
-                p = NULL;
-            }
 #endif
 #endif
             if (p) {
@@ -138,11 +146,89 @@ namespace yask {
 
     // Allocate NUMA memory from preferred node.
     template<typename T>
-    std::shared_ptr<T> shared_numa_alloc(size_t sz, int numa_pref) {
-        auto _base = std::shared_ptr<T>(numaAlloc(sz, numa_pref), NumaDeleter(sz));
+    std::shared_ptr<T> shared_numa_alloc(size_t sz, int numa_pref,
+                                         int huge_pages = yask_huge_pages_none) {
+        size_t mapped_bytes = 0;
+        char* p = numaAlloc(sz, numa_pref, huge_pages, &mapped_bytes);
+        auto _base = std::shared_ptr<T>(p, NumaDeleter(sz, mapped_bytes));
         return _base;
     }
 
+    // Pool of NUMA memory blocks that are returned to the pool
+    // instead of being freed. See yk_mem_pool.
+    class MemPool :
+        public virtual yk_mem_pool,
+        public std::enable_shared_from_this<MemPool> {
+
+        // One mapped or allocated block.
+        struct Block {
+            char* p = 0;
+            std::size_t nbytes = 0;
+            std::size_t mapped_bytes = 0;
+            int numa_pref = 0;
+            int huge_pages = 0;
+        };
+
+        // Blocks not in use.
+        std::vector<Block> _free;
+
+        // Stats.
+        std::size_t _cached_bytes = 0, _used_bytes = 0;
+        idx_t _num_new = 0, _num_reuses = 0;
+
+        mutable std::mutex _lock;
+
+        // Put a block back in the pool.
+        void put(const Block& b);
+
+        // Give a block back to the OS.
+        static void free_block(const Block& b) {
+            NumaDeleter(b.nbytes, b.mapped_bytes)(b.p);
+        }
+
+        // Returns a block to its pool.
+        struct PoolDeleter {
+            std::shared_ptr<MemPool> _pool;
+            Block _block;
+            PoolDeleter(std::shared_ptr<MemPool> pool, const Block& block) :
+                _pool(pool), _block(block) {}
+            void operator()(char* p) {
+                _pool->put(_block);
+            }
+        };
+
+    public:
+        virtual ~MemPool() {
+            for (auto& b : _free)
+                free_block(b);
+        }
+
+        // Get at least 'nbytes' with the given policies from the pool
+        // or from the OS if no suitable block is cached.
+        std::shared_ptr<char> alloc(std::size_t nbytes, int numa_pref,
+                                    int huge_pages);
+
+        // APIs.
+        virtual idx_t get_num_cached_bytes() const {
+            std::lock_guard<std::mutex> lk(_lock);
+            return _cached_bytes;
+        }
+        virtual idx_t get_num_used_bytes() const {
+            std::lock_guard<std::mutex> lk(_lock);
+            return _used_bytes;
+        }
+        virtual idx_t get_num_new_allocs() const {
+            std::lock_guard<std::mutex> lk(_lock);
+            return _num_new;
+        }
+        virtual idx_t get_num_reuses() const {
+            std::lock_guard<std::mutex> lk(_lock);
+            return _num_reuses;
+        }
+        virtual void release_cached();
+    };
+    typedef std::shared_ptr<MemPool> MemPoolPtr;
+
     // A class for maintaining elapsed time.
     class YaskTimer {
 
@@ -190,6 +276,195 @@ namespace yask {
         }
     };
 
+    // A class for accumulating energy use in joules.
+    // The whole node is measured when it has a node-level counter, e.g.,
+    // /sys/cray/pm_counters/energy. Otherwise, the RAPL package and DRAM
+    // zones in /sys/class/powercap are summed. Counter wrap-arounds are
+    // handled if the counters are read more often than they wrap. If no
+    // counter can be read, read() returns false and nothing is
+    // accumulated.
+    class EnergyMeter {
+    public:
+
+        // Read total energy in joules since an arbitrary starting point.
+        // May be called concurrently from multiple threads.
+        static bool read(double& joules);
+
+        // Describe the counters found.
+        static std::string get_source();
+
+    protected:
+        double _total = 0.;
+        double _begin = 0.;
+        bool _started = false;
+
+    public:
+        EnergyMeter() { }
+        virtual ~EnergyMeter() { }
+
+        // Reset total to zero.
+        virtual void clear() {
+            _total = 0.;
+            _started = false;
+        }
+
+        // Get total joules.
+        virtual double get_joules() const {
+            return _total;
+        }
+
+        // Measure a region.
+        // Like YaskTimer, start() and stop() can be called multiple
+        // times in pairs.
+        virtual void start() {
+            _started = read(_begin);
+        }
+        virtual void stop() {
+            double end;
+            if (_started && read(end))
+                _total += end - _begin;
+            _started = false;
+        }
+    };
+
+    // A class for accumulating hardware performance counts.
+    // Counters are read via Linux perf_event_open(). Each thread
+    // opens its own group of counters on its first read, and all
+    // counters in the group are read together. If the counters cannot
+    // be opened, e.g., due to /proc/sys/kernel/perf_event_paranoid,
+    // read() returns false and nothing is accumulated.
+    class PerfCounters {
+    public:
+        enum { cycles, instrs, cache_refs, cache_misses, num_ctrs };
+        typedef uint64_t Vals[num_ctrs];
+
+        // Get name of counter 'i'.
+        static const char* get_name(int i);
+
+        // Read current values of the calling thread's counters.
+        static bool read(Vals& vals);
+
+    protected:
+        Vals _totals;
+        Vals _begin;
+        bool _started = false;
+
+    public:
+        PerfCounters() { clear(); }
+        virtual ~PerfCounters() { }
+
+        // Reset totals to zero.
+        virtual void clear() {
+            for (int i = 0; i < num_ctrs; i++)
+                _totals[i] = 0;
+            _started = false;
+        }
+
+        // Get total for counter 'i'.
+        virtual uint64_t get(int i) const {
+            return _totals[i];
+        }
+
+        // Add 'end - begin' to the totals.
+        // May be called concurrently from multiple threads.
+        virtual void add_diff(const Vals& begin, const Vals& end) {
+            for (int i = 0; i < num_ctrs; i++) {
+#pragma omp atomic update
+                _totals[i] += end[i] - begin[i];
+            }
+        }
+
+        // Add totals from another object.
+        virtual void add(const PerfCounters& src) {
+            for (int i = 0; i < num_ctrs; i++)
+                _totals[i] += src._totals[i];
+        }
+
+        // Count a region run by the calling thread.
+        // Like YaskTimer, start() and stop() can be called multiple
+        // times in pairs; stop() does nothing if start() did not
+        // read the counters.
+        virtual void start() {
+            _started = read(_begin);
+        }
+        virtual void stop() {
+            Vals end;
+            if (_started && read(end))
+                add_diff(_begin, end);
+            _started = false;
+        }
+    };
+
+    // Groups of CPUs that share a cache, found from Linux sysfs.
+    // Only CPUs in the process's affinity mask are used.
+    class CpuTopology {
+        std::vector<std::vector<int>> _groups; // CPUs in each group.
+        int _level = -1;        // cache level; 0 => package; -1 => unknown.
+
+    public:
+
+        // Find groups at the smallest cache level that is shared by at
+        // least 'min_cpus' CPUs. If no cache is shared that widely, use
+        // packages. Only the CPUs in 'allowed' or, if it is empty, in the
+        // calling thread's affinity mask are used. Return false if the
+        // topology is not available.
+        bool find_groups(int min_cpus,
+                         const std::vector<int>& allowed = std::vector<int>());
+
+        int get_level() const { return _level; }
+        const std::vector<std::vector<int>>& get_groups() const { return _groups; }
+
+        // Get a CPU for thread 'inner' of a team of 'team_size' threads
+        // that is nested in thread 'outer'. Each team gets its own
+        // group or, if the team is bigger than a group, consecutive ones.
+        int get_cpu(int outer, int inner, int team_size) const;
+
+        // Get another hyperthread on the same core as 'cpu' or -1
+        // if there is none.
+        static int get_sibling_cpu(int cpu);
+
+        // Find the NUMA nodes that have CPUs in 'allowed' or, if it is
+        // empty, in the calling thread's affinity mask and those CPUs on
+        // each one. Return false if the nodes cannot be found.
+        static bool find_numa_nodes(std::vector<int>& nodes,
+                                    std::vector<std::vector<int>>& cpus,
+                                    const std::vector<int>& allowed = std::vector<int>());
+
+        // Parse a list of CPUs like "0-3,8,10-11" into 'cpus' in
+        // ascending order. Return false on a syntax error.
+        static bool parse_cpu_list(const std::string& str, std::vector<int>& cpus);
+
+        // Get the CPUs in the calling thread's affinity mask.
+        static bool get_thread_cpus(std::vector<int>& cpus);
+
+        // Bind the calling thread to 'cpu' unless already done.
+        static bool bind_thread(int cpu);
+
+        // Bind the calling thread to any of 'cpus' unless already done.
+        static bool bind_thread(const std::vector<int>& cpus);
+
+        // Description of the groups.
+        std::string make_info_string() const;
+    };
+
+    // Binds the calling thread to a set of CPUs for the life of the
+    // object and then restores its previous affinity.
+    // Does nothing if the set is empty.
+    class ScopedCpuBinding {
+        std::vector<int> _prev;
+        bool _bound = false;
+
+    public:
+        ScopedCpuBinding(const std::vector<int>& cpus) {
+            if (cpus.size() && CpuTopology::get_thread_cpus(_prev))
+                _bound = CpuTopology::bind_thread(cpus);
+        }
+        ~ScopedCpuBinding() {
+            if (_bound)
+                CpuTopology::bind_thread(_prev);
+        }
+    };
+
     // A class to parse command-line args.
     class CommandLineParser {
 
@@ -290,6 +565,21 @@ namespace yask {
             virtual bool check_arg(std::vector<std::string>& args, int& argi);
         };
 
+        // An allowed string option.
+        class StringOption : public OptionBase {
+            std::string& _val;
+
+        public:
+            StringOption(const std::string& name,
+                         const std::string& help_msg,
+                         std::string& val) :
+                OptionBase(name, help_msg), _val(val) { }
+
+            virtual void print_help(std::ostream& os,
+                                    int width) const;
+            virtual bool check_arg(std::vector<std::string>& args, int& argi);
+        };
+
         // An allowed idx_t option that sets multiple vars.
         class MultiIdxOption : public OptionBase {
             std::vector<idx_t*> _vals;
@@ -43,7 +43,9 @@ IN THE SOFTWARE.
 // Standard C and C++ headers.
 #include <algorithm>
 #include <assert.h>
+#include <atomic>
 #include <cstdint>
+#include <condition_variable>
 #include <cstdlib>
 #include <fstream>
 #include <functional>
@@ -52,7 +54,10 @@ IN THE SOFTWARE.
 #include <limits.h>
 #include <malloc.h>
 #include <map>
+#include <mutex>
 #include <math.h>
+#include <random>
+#include <sched.h>
 #include <set>
 #include <sstream>
 #include <stddef.h>
@@ -61,11 +66,27 @@ IN THE SOFTWARE.
 #include <stdlib.h>
 #include <string.h>
 #include <string>
+#include <sys/mman.h>
+#include <thread>
 #include <time.h>
 #include <vector>
 #include <unistd.h>
 #include <stdint.h>
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#ifdef USE_INTRIN512_SVE
+#include <arm_sve.h>
+#endif
+
+// Prefetch hints w/the same values as the x86 ones,
+// which are also the locality args for __builtin_prefetch().
+#define _MM_HINT_T0 3
+#define _MM_HINT_T1 2
+#define _MM_HINT_T2 1
+#define _MM_HINT_NTA 0
+#else
 #include <immintrin.h>
+#endif
 
 // Additional type for unsigned indices.
 typedef std::uint64_t uidx_t;
@@ -145,6 +166,11 @@ inline void omp_set_nested(int n) { }
 #define NUMA_PREF yask_numa_local
 #endif
 
+// Target architecture name, set by the makefile.
+#ifndef YK_ARCH
+#define YK_ARCH "unknown"
+#endif
+
 // macro for debug message.
 #ifdef TRACE
 #define TRACE_MSG0(os, msg) ((os) << "YASK: " << msg << std::endl << std::flush)
@@ -163,15 +189,70 @@ inline void omp_set_nested(int n) { }
 #define TRACE_MSG3(msg) TRACE_MSG0(_generic_context->get_ostr(), msg)
 
 // breakpoint.
+#if defined(__aarch64__)
+#define INT3 asm volatile("brk #0")
+#else
 #define INT3 asm volatile("int $3")
+#endif
 
 // L1 and L2 hints
 #define L1_HINT _MM_HINT_T0
 #define L2_HINT _MM_HINT_T1
 
+// Default prefetch distances, set by the makefile.
+#ifndef PFD_L1
+#define PFD_L1 1
+#endif
+#ifndef PFD_L2
+#define PFD_L2 2
+#endif
+
+// Max number of orders of the region, block and sub-block loops,
+// set by the makefile.
+#ifndef LOOP_ORDERS
+#define LOOP_ORDERS 6
+#endif
+
+// Default geometry of the caches seen by one thread, used by the cache
+// simulator. LLC sizes are the share of one core.
+#ifndef CACHE_L1_KB
+#define CACHE_L1_KB 32
+#endif
+#ifndef CACHE_L1_WAYS
+#define CACHE_L1_WAYS 8
+#endif
+#ifndef CACHE_L2_KB
+ #if defined(ARCH_SKX) || defined(ARCH_KNL)
+  #define CACHE_L2_KB 1024
+ #else
+  #define CACHE_L2_KB 256
+ #endif
+#endif
+#ifndef CACHE_L2_WAYS
+ #if defined(ARCH_SKX) || defined(ARCH_KNL)
+  #define CACHE_L2_WAYS 16
+ #else
+  #define CACHE_L2_WAYS 8
+ #endif
+#endif
+#ifndef CACHE_LLC_KB
+ #if defined(ARCH_KNL)
+  #define CACHE_LLC_KB 0
+ #elif defined(ARCH_SKX)
+  #define CACHE_LLC_KB 1408
+ #else
+  #define CACHE_LLC_KB 2560
+ #endif
+#endif
+#ifndef CACHE_LLC_WAYS
+#define CACHE_LLC_WAYS 11
+#endif
+
+// Cache models.
+#include "cache_model.hpp"
+
 // Set MODEL_CACHE to 1 or 2 to model L1 or L2.
 #ifdef MODEL_CACHE
-#include "cache_model.hpp"
 extern yask::Cache cache_model;
  #if MODEL_CACHE==L1
   #warning Modeling L1 cache
@@ -184,6 +265,7 @@ extern yask::Cache cache_model;
 
 // Other utilities.
 #include "utils.hpp"
+#include "trace_events.hpp"
 #include "tuple.hpp"
 
 
@@ -27,7 +27,9 @@ IN THE SOFTWARE.
 
 // This file uses SWIG markup for API generation.
 
-%module YK_MODULE
+// Thread support is enabled so that the GIL can be released in
+// selected calls below.
+%module(threads="1") YK_MODULE
 
 // See http://www.swig.org/Doc3.0/Library.html
 %include <std_string.i>
@@ -44,6 +46,8 @@ IN THE SOFTWARE.
 %shared_ptr(yask::yk_solution)
 %shared_ptr(yask::yk_grid)
 %shared_ptr(yask::yk_stats)
+%shared_ptr(yask::yk_reduction)
+%shared_ptr(yask::yk_mem_pool)
 
 // Mutable buffer to access raw data.
 %pybuffer_mutable_string(void* buffer_ptr)
@@ -56,6 +60,8 @@ IN THE SOFTWARE.
 // All vector types used in API.
 %template(vector_idx) std::vector<long int>;
 %template(vector_str) std::vector<std::string>;
+%template(vector_dbl) std::vector<double>;
+%template(vector_int) std::vector<int>;
 %template(vector_grid_ptr) std::vector<std::shared_ptr<yask::yk_grid>>;
 
 %exception {
@@ -67,7 +73,119 @@ IN THE SOFTWARE.
   }
 }
 
+// Release the GIL only in the calls that can run for a long time so
+// that other Python threads can run meanwhile, e.g., to do I/O while
+// the stencils are evaluated. The other calls keep the GIL to avoid
+// the overhead of releasing it.
+%nothread;
+%thread yask::yk_solution::prepare_solution;
+%thread yask::yk_solution::run_solution;
+%thread yask::yk_solution::end_solution;
+%thread yask::yk_solution::run_auto_tuner_now;
+%thread yask::yk_solution::get_decimated_output;
+%thread yask::yk_solution::store_compressed_slice;
+%thread yask::yk_solution::restore_compressed_slice;
+%thread yask::yk_solution::reduce_grid;
+%thread yask::yk_solution::reduce_grid_in_slice;
+%thread yask::yk_solution::save_checkpoint;
+%thread yask::yk_solution::load_checkpoint;
+%thread yask::yk_grid::get_elements_in_slice;
+%thread yask::yk_grid::set_elements_in_slice;
+%thread yask::yk_grid::set_elements_in_slice_same;
+
+// Step callbacks need C++ functions.
+%ignore yask::yk_solution::add_step_callback;
+
 %include "yask_common_api.hpp"
 %include "yask_kernel_api.hpp"
 %include "yk_solution_api.hpp"
 %include "yk_grid_api.hpp"
+
+// Running a solution in the background.
+%extend yask::yk_solution {
+
+    %pythoncode %{
+    def run_solution_async(self, first_step_index, last_step_index = None) :
+        """Start run_solution() in a new thread and return a concurrent.futures.Future.
+
+        The arguments are the same as those of run_solution(). The
+        GIL is released while the solution runs, so the calling
+        thread can continue, e.g., to write output or prepare the next
+        inputs. Call result() on the returned future to wait for the
+        steps to finish; it raises any exception from run_solution().
+
+        No other calls may be made to this solution or its grids, and
+        no MPI calls may be made, until the future is done.
+        """
+        import concurrent.futures
+        import threading
+        future = concurrent.futures.Future()
+        def run() :
+            if not future.set_running_or_notify_cancel() :
+                return
+            try :
+                if last_step_index is None :
+                    self.run_solution(first_step_index)
+                else :
+                    self.run_solution(first_step_index, last_step_index)
+                future.set_result(None)
+            except BaseException as e :
+                future.set_exception(e)
+        thread = threading.Thread(target = run)
+        thread.daemon = True
+        thread.start()
+        return future
+    %}
+}
+
+// Zero-copy NumPy views of grids with strided storage.
+%extend yask::yk_grid {
+
+    // Address of raw storage as an integer for use from Python.
+    size_t _get_raw_storage_address() {
+        return size_t($self->get_raw_storage_buffer());
+    }
+
+    %pythoncode %{
+    def get_numpy_view(self) :
+        """Get a NumPy ndarray that shares storage with this grid.
+
+        Writes via the returned array are visible to the grid and vice-versa;
+        no data is copied. The array has one axis per grid dimension,
+        each of get_alloc_size() entries. Indices into the array are
+        relative to the first allocated index in each dimension, i.e.,
+        get_first_rank_alloc_index() for domain dims and
+        get_first_misc_index() for misc dims. The step-dim index is
+        the allocated slot, i.e., the step index modulo its allocation size.
+
+        Raises RuntimeError if the grid storage is not allocated or is
+        not simply strided, e.g., when the grid is vector-folded or bricked.
+        In those cases, use get_elements_in_slice() and
+        set_elements_in_slice() to copy data in bulk.
+        """
+        import numpy
+        import ctypes
+        if not self.is_storage_allocated() :
+            raise RuntimeError("grid '" + self.get_name() + "' has no storage allocated")
+        nelems = self.get_num_storage_elements()
+        ebytes = self.get_num_storage_bytes() // nelems
+        if ebytes == 4 :
+            ctype = ctypes.c_float
+            dtype = numpy.float32
+        else :
+            ctype = ctypes.c_double
+            dtype = numpy.float64
+        shape = []
+        strides = []
+        for dname in self.get_dim_names() :
+            stride = self.get_raw_storage_stride(dname)
+            if stride == 0 :
+                raise RuntimeError("grid '" + self.get_name() + "' does not have a strided "
+                                   "layout; use get_elements_in_slice() or set_elements_in_slice()")
+            shape += [self.get_alloc_size(dname)]
+            strides += [stride * ebytes]
+        buf = (ctype * nelems).from_address(self._get_raw_storage_address())
+        flat = numpy.frombuffer(buf, dtype, nelems)
+        return numpy.lib.stride_tricks.as_strided(flat, tuple(shape), tuple(strides))
+    %}
+}
@@ -32,6 +32,11 @@ IN THE SOFTWARE.
 #include <set>
 #include <sys/types.h>
 #include <unistd.h>
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include <sched.h>
+#include <thread>
 
 
 using namespace std;
@@ -66,6 +71,14 @@ int main() {
             cout << "Following information from rank " << rank_num << ".\n";
         ostream& os = *osp;
 
+        // Stencils that could be created with new_named_solution().
+        auto soln_names = kfac.get_solution_names();
+        assert(soln_names.size() >= 1);
+        os << "Available stencils:";
+        for (auto& sname : soln_names)
+            os << " '" << sname << "'";
+        os << endl;
+
         // Init global settings.
         auto soln_dims = soln->get_domain_dim_names();
         for (auto dim_name : soln_dims) {
@@ -95,9 +108,15 @@ int main() {
         auto ddim1 = soln_dims[0];
         soln->set_num_ranks(ddim1, env->get_num_ranks());
 
+        // Keep grid and buffer memory in a pool for reuse by later solutions.
+        auto pool = kfac.new_mem_pool();
+        soln->set_mem_pool(pool);
+
         // Allocate memory for any grids that do not have storage set.
         // Set other data structures needed for stencil application.
         soln->prepare_solution();
+        os << "Using " << pool->get_num_used_bytes() << " bytes from memory pool.\n";
+        assert(pool->get_num_new_allocs() > 0);
 
         // Print some info about the solution.
         auto name = soln->get_name();
@@ -210,21 +229,478 @@ int main() {
             auto num_elems = grid->get_num_storage_elements();
             os << "      " << grid->get_num_storage_bytes() <<
                 " bytes of raw data at " << raw_p << ": ";
+
+            // Skip raw checks if stored in a 16-bit format.
+            if (grid->get_num_storage_bytes() != num_elems * soln->get_element_bytes()) {
+                os << "16-bit elements\n";
+                continue;
+            }
             if (soln->get_element_bytes() == 4)
                 os << ((float*)raw_p)[0] << ", ..., " << ((float*)raw_p)[num_elems-1] << "\n";
             else
                 os << ((double*)raw_p)[0] << ", ..., " << ((double*)raw_p)[num_elems-1] << "\n";
+
+            // Index raw data directly if layout is strided.
+            bool is_strided = true;
+            idx_t ofs = 0;
+            auto dnames = grid->get_dim_names();
+            for (size_t i = 0; i < dnames.size(); i++) {
+                auto& dname = dnames[i];
+                idx_t stride = grid->get_raw_storage_stride(dname);
+                if (stride == 0)
+                    is_strided = false;
+                else if (domain_dim_set.count(dname))
+                    ofs += (first_indices[i] - grid->get_first_rank_alloc_index(dname)) * stride;
+                else if (dname == soln->get_step_dim_name())
+                    ofs += (first_indices[i] % grid->get_alloc_size(dname)) * stride;
+                else
+                    ofs += (first_indices[i] - grid->get_first_misc_index(dname)) * stride;
+            }
+            if (is_strided && grid->is_element_allocated(first_indices)) {
+                double val2 = (soln->get_element_bytes() == 4) ?
+                    ((float*)raw_p)[ofs] : ((double*)raw_p)[ofs];
+                os << "      first element via strided raw data == " << val2 << ".\n";
+                assert(val2 == val + 1.0);
+            }
+
+            // Index raw data via offset; works for any layout.
+            if (grid->is_element_allocated(first_indices)) {
+                idx_t ofs2 = grid->get_raw_storage_offset(first_indices);
+                double val2 = (soln->get_element_bytes() == 4) ?
+                    ((float*)raw_p)[ofs2] : ((double*)raw_p)[ofs2];
+                os << "      first element via raw data offset == " << val2 << ".\n";
+                assert(val2 == val + 1.0);
+            }
+        }
+
+        // Inject a source and sample a receiver at the center of the
+        // domain in the first grid written by the stencil.
+        yk_grid_ptr sgrid;
+        int src_id = -1, rcv_id = -1;
+        vector<idx_t> ctr_indices, rcv_indices;
+        for (auto grid : soln->get_grids()) {
+            if (grid->is_fixed_size() || sgrid)
+                continue;
+            vector<idx_t> tap_indices;
+            for (auto dname : grid->get_dim_names()) {
+                if (dname == soln->get_step_dim_name())
+                    continue;
+                idx_t idx = domain_dim_set.count(dname) ?
+                    soln->get_overall_domain_size(dname) / 2 :
+                    grid->get_first_misc_index(dname);
+                ctr_indices.push_back(idx);
+            }
+            try {
+                src_id = soln->add_sparse_points(grid->get_name(), true, 1,
+                                                 { 0 }, ctr_indices, { 1.0 });
+            } catch (yask_exception e) {
+                ctr_indices.clear();
+                continue;
+            }
+            sgrid = grid;
+
+            // Receiver between the center and its neighbor in the first dim.
+            rcv_indices = ctr_indices;
+            for (auto idx : ctr_indices)
+                tap_indices.push_back(idx);
+            rcv_indices[0]++;
+            for (auto idx : rcv_indices)
+                tap_indices.push_back(idx);
+            rcv_id = soln->add_sparse_points(grid->get_name(), false, 1,
+                                             { 0, 0 }, tap_indices, { 0.5, 0.5 });
+            os << "  Added sparse points in grid '" << grid->get_name() << "'.\n";
+        }
+        if (sgrid) {
+            soln->set_sparse_steps(src_id, 1, 11);
+            soln->set_sparse_steps(rcv_id, 1, 11);
+            vector<double> dvals(11, 10.0);
+            vector<float> fvals(11, 10.0f);
+            if (soln->get_element_bytes() == 4)
+                soln->set_sparse_values(src_id, fvals.data());
+            else
+                soln->set_sparse_values(src_id, dvals.data());
         }
 
         // Apply the stencil solution to the data.
         env->global_barrier();
         os << "Running the solution for 1 step...\n";
         soln->run_solution(0);
+        // Count calls at every step w/o grid access and collect
+        // the steps of calls that read a grid every 3 steps.
+        idx_t num_calls = 0;
+        vector<idx_t> cb_steps;
+        soln->add_step_callback([&](idx_t t) { num_calls++; }, 0, 1, {}, {});
+        soln->add_step_callback([&](idx_t t) { cb_steps.push_back(t); }, 1, 3,
+                                { soln->get_grids()[0]->get_name() }, {});
+
+        // Save the first grid over the rank domain in the background.
+        auto snap_grid = soln->get_grids()[0];
+        vector<idx_t> snap_first, snap_last;
+        idx_t snap_elems = 1;
+        for (auto dname : snap_grid->get_dim_names()) {
+            if (dname == soln->get_step_dim_name()) {
+                snap_first.push_back(0);
+                snap_last.push_back(0);
+            } else if (domain_dim_set.count(dname)) {
+                snap_first.push_back(snap_grid->get_first_rank_domain_index(dname));
+                snap_last.push_back(snap_grid->get_last_rank_domain_index(dname));
+            } else {
+                snap_first.push_back(snap_grid->get_first_misc_index(dname));
+                snap_last.push_back(snap_grid->get_last_misc_index(dname));
+            }
+            snap_elems *= snap_last.back() - snap_first.back() + 1;
+        }
+        string snap_path = "yask_kernel_api_test_snap";
+        soln->add_snapshot(snap_grid->get_name(), snap_first, snap_last, 1, 5, snap_path);
+
+        // Collect every other element of the same slice at the same steps.
+        vector<idx_t> dec_strides(snap_first.size(), 2);
+        idx_t dec_elems = soln->add_decimated_output("dec", snap_grid->get_name(),
+                                                     snap_first, snap_last, dec_strides, 1, 5);
+
         os << "Running the solution for 10 more steps...\n";
+        soln->apply_command_line_options("-step_stats");
         soln->run_solution(1, 10);
 
+        // Steps 2 through 11 were computed.
+        os << "  Step callbacks called " << num_calls << " and " <<
+            cb_steps.size() << " time(s).\n";
+        assert(num_calls == 10);
+        assert(cb_steps == vector<idx_t>({ 4, 7, 10 }));
+        soln->clear_step_callbacks();
+
+        // Gather times from all ranks for the steps just run.
+        soln->apply_command_line_options("-rank_stats");
+        auto stats = soln->get_stats();
+        auto slowest = stats->get_slowest_ranks();
+        assert(stats->get_rank_metric_names().size() == 7);
+        assert(slowest.size() == size_t(env->get_num_ranks()));
+        for (auto mname : stats->get_rank_metric_names()) {
+            auto vals = stats->get_rank_metric_values(mname);
+            os << "  Rank " << mname << ": min " << stats->get_rank_metric_min(mname) <<
+                ", max " << stats->get_rank_metric_max(mname) << ".\n";
+            assert(vals.size() == slowest.size());
+            assert(stats->get_rank_metric_min(mname) <= stats->get_rank_metric_mean(mname));
+            assert(stats->get_rank_metric_mean(mname) <= stats->get_rank_metric_max(mname) * (1. + 1e-12));
+            assert(stats->get_rank_metric_std_dev(mname) >= 0.);
+        }
+        auto csecs = stats->get_rank_metric_values("compute-secs");
+        assert(csecs[slowest[0]] == stats->get_rank_metric_max("compute-secs"));
+
+        // Step times were recorded for the same steps.
+        auto step_secs = stats->get_step_secs();
+        os << "  Step times: median " << stats->get_step_secs_percentile(50.) <<
+            ", max " << stats->get_step_secs_percentile(100.) << ", " <<
+            stats->get_step_outliers().size() << " outlier(s).\n";
+        assert(step_secs.size() == 10);
+        assert(stats->get_step_secs_percentile(0.) <= stats->get_step_secs_percentile(50.));
+        assert(stats->get_step_secs_percentile(50.) <= stats->get_step_secs_percentile(100.));
+        for (auto si : stats->get_step_outliers())
+            assert(si >= 0 && si < idx_t(step_secs.size()));
+
+        // Snapshots were taken at steps 6 and 11; check the last one.
+        soln->finish_snapshots();
+        string snap_fname = snap_path + ".rank" + to_string(env->get_rank_index()) + ".snap";
+        if (snap_grid->is_dim_used(soln->get_step_dim_name())) {
+            size_t rec_bytes = sizeof(idx_t) + snap_elems * soln->get_element_bytes();
+            FILE* fp = fopen(snap_fname.c_str(), "rb");
+            assert(fp);
+            fseek(fp, 0, SEEK_END);
+            assert(size_t(ftell(fp)) == 4096 + 2 * rec_bytes);
+            vector<char> rec(rec_bytes), cur(rec_bytes - sizeof(idx_t));
+            fseek(fp, 4096 + rec_bytes, SEEK_SET);
+            assert(fread(rec.data(), 1, rec_bytes, fp) == rec_bytes);
+            fclose(fp);
+            assert(*(idx_t*)rec.data() == 11);
+            snap_first[0] = snap_last[0] = 11;
+            snap_grid->get_elements_in_slice(cur.data(), snap_first, snap_last);
+            assert(memcmp(rec.data() + sizeof(idx_t), cur.data(), cur.size()) == 0);
+            os << "  Snapshot at step 11 matches the grid.\n";
+        }
+        remove(snap_fname.c_str());
+
+        // Check the first and last elements of the decimated records.
+        {
+            auto dec_steps = soln->get_decimated_output_steps("dec");
+            assert(dec_steps == vector<idx_t>({ 6, 11 }));
+            size_t ebytes = soln->get_element_bytes();
+            vector<char> dec(2 * dec_elems * ebytes);
+            assert(soln->get_decimated_output("dec", dec.data()) == 2 * dec_elems);
+            assert(soln->get_decimated_output_steps("dec").size() == 0);
+            auto dec_val = [&](idx_t i) {
+                return (ebytes == 4) ? double(((float*)dec.data())[i]) : ((double*)dec.data())[i];
+            };
+            auto dec_first = soln->get_decimated_output_first_indices("dec");
+            auto dec_last = soln->get_decimated_output_last_indices("dec");
+            if (snap_grid->is_dim_used(soln->get_step_dim_name()))
+                dec_first[0] = dec_last[0] = 11;
+            assert(dec_val(dec_elems) == snap_grid->get_element(dec_first));
+            assert(dec_val(2 * dec_elems - 1) == snap_grid->get_element(dec_last));
+            os << "  Collected 2 records of " << dec_elems << " decimated element(s).\n";
+            soln->remove_decimated_output("dec");
+        }
+
+        // Compress the same slice, overwrite it, and restore it,
+        // first losslessly and then with an error bound.
+        {
+            size_t ebytes = soln->get_element_bytes();
+            vector<char> orig(snap_elems * ebytes), cur(orig.size());
+            snap_grid->get_elements_in_slice(orig.data(), snap_first, snap_last);
+            auto elem = [&](const vector<char>& buf, idx_t i) {
+                return ebytes == 4 ? double(((float*)buf.data())[i]) : ((double*)buf.data())[i];
+            };
+            double max_abs = 0.;
+            for (idx_t i = 0; i < snap_elems; i++)
+                max_abs = max(max_abs, fabs(elem(orig, i)));
+            for (double max_err : { 0., max_abs * 1e-4 }) {
+                idx_t zbytes = soln->store_compressed_slice("test", snap_grid->get_name(),
+                                                            snap_first, snap_last, max_err);
+                os << "  Compressed " << orig.size() << " bytes to " << zbytes <<
+                    " with max error " << max_err << ".\n";
+                assert(soln->get_compressed_slice_bytes() == zbytes);
+                snap_grid->set_elements_in_slice_same(-1.0, snap_first, snap_last);
+                assert(soln->restore_compressed_slice("test") == snap_elems);
+                snap_grid->get_elements_in_slice(cur.data(), snap_first, snap_last);
+                if (max_err == 0.)
+                    assert(memcmp(orig.data(), cur.data(), orig.size()) == 0);
+                else {
+                    for (idx_t i = 0; i < snap_elems; i++)
+                        assert(fabs(elem(orig, i) - elem(cur, i)) <= max_err);
+                }
+            }
+            soln->remove_compressed_slice("test");
+            assert(soln->get_compressed_slice_bytes() == 0);
+            snap_grid->set_elements_in_slice(orig.data(), snap_first, snap_last);
+        }
+
+        // Check the last receiver value against the grid.
+        if (sgrid) {
+            vector<double> dvals(11);
+            vector<float> fvals(11);
+            double rval;
+            if (soln->get_element_bytes() == 4) {
+                soln->get_sparse_values(rcv_id, fvals.data());
+                rval = fvals[10];
+            } else {
+                soln->get_sparse_values(rcv_id, dvals.data());
+                rval = dvals[10];
+            }
+            os << "    Receiver value at step 11 == " << rval << ".\n";
+            ctr_indices.insert(ctr_indices.begin(), 11);
+            rcv_indices.insert(rcv_indices.begin(), 11);
+            // Halo values may be stale, so check only in the rank domain.
+            bool in_domain = true;
+            auto gdims = sgrid->get_dim_names();
+            for (size_t i = 0; i < gdims.size(); i++) {
+                if (domain_dim_set.count(gdims[i]) &&
+                    (ctr_indices[i] < sgrid->get_first_rank_domain_index(gdims[i]) ||
+                     rcv_indices[i] > sgrid->get_last_rank_domain_index(gdims[i])))
+                    in_domain = false;
+            }
+            if (in_domain) {
+                double gval = 0.5 * (sgrid->get_element(ctr_indices) +
+                                     sgrid->get_element(rcv_indices));
+                os << "    Grid value at receiver == " << gval << ".\n";
+                assert(fabs(rval - gval) <= 1e-3 * fabs(gval));
+            }
+        }
+
+        // Reduce the first grid after setting two elements in its domain.
+        {
+            auto rgrid = soln->get_grids()[0];
+            vector<idx_t> lo_indices, hi_indices;
+            idx_t nelems = 1, slice_elems = 1;
+            for (auto dname : rgrid->get_dim_names()) {
+                idx_t lo = 0, hi = 0, n = 1;
+                if (domain_dim_set.count(dname)) {
+                    n = soln->get_overall_domain_size(dname);
+                    lo = n / 4;
+                    hi = n / 2;
+                }
+                else if (dname != soln->get_step_dim_name()) {
+                    lo = rgrid->get_first_misc_index(dname);
+                    hi = rgrid->get_last_misc_index(dname);
+                    n = hi - lo + 1;
+                }
+                lo_indices.push_back(lo);
+                hi_indices.push_back(hi);
+                nelems *= n;
+                slice_elems *= hi - lo + 1;
+            }
+            rgrid->set_all_elements_same(0.5);
+            rgrid->set_element(-3.0, lo_indices);
+            rgrid->set_element(4.0, hi_indices);
+            os << "Reducing grid '" << rgrid->get_name() << "'...\n";
+            for (int i = 0; i < 2; i++) {
+                auto red = i ? soln->reduce_grid_in_slice(rgrid->get_name(), lo_indices, hi_indices) :
+                    soln->reduce_grid(rgrid->get_name());
+                idx_t n = i ? slice_elems : nelems;
+                os << "  " << red->get_num_elements() << " element(s): sum == " <<
+                    red->get_sum() << ", L2 norm == " << red->get_l2_norm() <<
+                    ", min == " << red->get_min() << ", max == " << red->get_max() << ".\n";
+                assert(red->get_num_elements() == n);
+                assert(red->get_sum() == 0.5 * (n - 2) + 1.0);
+                assert(fabs(red->get_l2_norm() - sqrt(0.25 * (n - 2) + 25.0)) <= 1e-9 * red->get_l2_norm());
+                assert(red->get_min() == -3.0);
+                assert(red->get_min_indices() == lo_indices);
+                assert(red->get_max() == 4.0);
+                assert(red->get_max_indices() == hi_indices);
+                assert(red->get_max_abs() == 4.0);
+                assert(red->get_max_abs_indices() == hi_indices);
+            }
+        }
+
+        // Save a checkpoint, overwrite the grids, and restore it.
+        os << "Saving and restoring a checkpoint...\n";
+        string ckpt_path = "yask_kernel_api_test_ckpt";
+        soln->save_checkpoint(ckpt_path);
+        vector<vector<char>> saved_data;
+        for (auto grid : soln->get_grids()) {
+            char* p = (char*)grid->get_raw_storage_buffer();
+            saved_data.push_back(vector<char>(p, p + grid->get_num_storage_bytes()));
+            grid->set_all_elements_same(-1.0);
+        }
+        soln->load_checkpoint(ckpt_path);
+        for (size_t gi = 0; gi < saved_data.size(); gi++) {
+            auto grid = soln->get_grids()[gi];
+            assert(memcmp(grid->get_raw_storage_buffer(), saved_data[gi].data(),
+                          saved_data[gi].size()) == 0);
+        }
+        remove((ckpt_path + ".rank" + to_string(env->get_rank_index()) + ".yask").c_str());
+
+        // Move each grid to an externally-allocated buffer.
+        for (auto grid : soln->get_grids()) {
+            idx_t nbytes = grid->get_num_storage_bytes();
+            vector<char> ext_buf(nbytes + 64);
+            char* ext_p = ext_buf.data() + (64 - size_t(ext_buf.data()) % 64) % 64;
+            grid->use_external_storage(ext_p, nbytes);
+            assert(grid->get_raw_storage_buffer() == ext_p);
+            grid->set_all_elements_same(1.5);
+            auto num_elems = grid->get_num_storage_elements();
+            double val2 = 0.;
+            if (nbytes != num_elems * soln->get_element_bytes()) {
+                vector<idx_t> last_indices;
+                for (auto dname : grid->get_dim_names())
+                    last_indices.push_back(grid->get_last_rank_alloc_index(dname));
+                val2 = grid->get_element(last_indices);
+            }
+            else
+                val2 = (soln->get_element_bytes() == 4) ?
+                    ((float*)ext_p)[num_elems-1] : ((double*)ext_p)[num_elems-1];
+            os << "    Last element of '" << grid->get_name() <<
+                "' in external storage == " << val2 << ".\n";
+            assert(val2 == 1.5);
+            grid->release_storage();
+        }
+
         soln->end_solution();
 
+        // Reuse the pooled memory in another solution with the same settings.
+        auto cached_bytes = pool->get_num_cached_bytes();
+        os << "Memory pool holds " << cached_bytes << " bytes after ending the solution.\n";
+        assert(cached_bytes > 0);
+        // Give it half of the CPUs of this thread.
+        vector<int> cpus2, cpus3;
+        cpu_set_t mask;
+        if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+            vector<int> cpus;
+            for (int c = 0; c < CPU_SETSIZE; c++)
+                if (CPU_ISSET(c, &mask))
+                    cpus.push_back(c);
+            size_t half = (cpus.size() + 1) / 2;
+            cpus2.assign(cpus.begin(), cpus.begin() + half);
+            cpus3.assign(cpus.begin() + (cpus.size() - half), cpus.end());
+        }
+        auto soln2 = kfac.new_solution(env, soln);
+        if (rank_num < env->get_num_ranks() - 1) {
+            yask_output_factory ofac;
+            soln2->set_debug_output(ofac.new_null_output());
+        }
+        assert(soln2->get_mem_pool() == pool);
+        soln2->set_cpus(cpus2);
+        assert(soln2->get_cpus() == cpus2);
+        auto num_new = pool->get_num_new_allocs();
+        soln2->prepare_solution();
+        os << "Second solution reused " << pool->get_num_reuses() <<
+            " block(s) from memory pool.\n";
+        assert(pool->get_num_reuses() > 0);
+        assert(pool->get_num_new_allocs() == num_new);
+
+        // Run another solution at the same time from another thread
+        // on the other half of the CPUs. With MPI, only one solution
+        // per process may communicate at a time.
+        if (env->get_num_ranks() == 1) {
+            auto soln3 = kfac.new_solution(env, soln2);
+            soln3->set_cpus(cpus3);
+            soln3->prepare_solution();
+
+            // Same non-uniform data in both.
+            string gname;
+            for (auto s : { soln2, soln3 }) {
+                for (auto grid : s->get_grids()) {
+                    grid->set_all_elements_same(0.5);
+                    if (!grid->is_dim_used(s->get_step_dim_name()))
+                        continue;
+                    vector<idx_t> indices;
+                    for (auto dname : grid->get_dim_names()) {
+                        if (dname == s->get_step_dim_name())
+                            indices.push_back(0);
+                        else if (domain_dim_set.count(dname))
+                            indices.push_back(grid->get_first_rank_domain_index(dname) + 10);
+                        else
+                            indices.push_back(grid->get_first_misc_index(dname));
+                    }
+                    grid->set_element(2.0, indices);
+                    gname = grid->get_name();
+                }
+            }
+            assert(gname.length());
+
+            os << "Running two solutions concurrently on " << cpus2.size() <<
+                " and " << cpus3.size() << " CPU(s)...\n";
+            string err3;
+            thread t3([&]() {
+                    try {
+                        soln3->run_solution(0, 4);
+                    } catch (yask_exception e) {
+                        err3 = e.get_message();
+                    }
+                });
+            soln2->run_solution(0, 4);
+            t3.join();
+            if (err3.length())
+                throw yask_exception(err3);
+            auto red2 = soln2->reduce_grid(gname, 5);
+            auto red3 = soln3->reduce_grid(gname, 5);
+            os << "  Sums of '" << gname << "': " << red2->get_sum() <<
+                " and " << red3->get_sum() << ".\n";
+            assert(fabs(red2->get_sum() - red3->get_sum()) <= 1e-9 * fabs(red2->get_sum()));
+            assert(red2->get_max() == red3->get_max());
+            soln3->end_solution();
+        }
+        soln2->end_solution();
+        soln2.reset();
+        pool->release_cached();
+        assert(pool->get_num_cached_bytes() == 0);
+
+        // Requesting more ranks in one dim than are active must be
+        // reported as an error by the automatic rank layout.
+        {
+            yask_output_factory ofac;
+            auto soln4 = kfac.new_solution(env, soln);
+            soln4->set_debug_output(ofac.new_null_output());
+            soln4->set_num_ranks(ddim1, env->get_num_ranks() + 1);
+            bool caught = false;
+            try {
+                soln4->prepare_solution();
+            } catch (yask_exception e) {
+                os << "Expected exception from bad rank layout: " <<
+                    e.get_message() << endl;
+                caught = true;
+            }
+            assert(caught);
+        }
+
         os << "End of YASK kernel API test.\n";
         return 0;
     }
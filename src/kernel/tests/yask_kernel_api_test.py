@@ -94,6 +94,12 @@ def read_grid(grid, timestep) :
     print("Raw data: " + repr(fp_ptr[0]) + ", ..., " + repr(fp_ptr[num_elems-1]))
     #ndarray2 = np.fromiter(fp_ptr, dtype, num_elems); print(ndarray2)
 
+    # Zero-copy view, if the layout allows it.
+    if all(grid.get_raw_storage_stride(dname) > 0 for dname in grid.get_dim_names()) :
+        view = grid.get_numpy_view()
+        print("NumPy view of shape " + repr(view.shape))
+        assert view.size == num_elems
+
 # Init grid using NumPy ndarray.
 def init_grid(grid, timestep) :
     print("Initializing grid '" + grid.get_name() + "' at time " + repr(timestep) + "...")
@@ -210,9 +216,14 @@ if __name__ == "__main__":
     ddim1 = soln_dims[0] # name of 1st dim.
     soln.set_num_ranks(ddim1, env.get_num_ranks()) # num ranks in this dim.
     
+    # Keep grid and buffer memory in a pool for reuse by later solutions.
+    pool = kfac.new_mem_pool()
+    soln.set_mem_pool(pool)
+
     # Allocate memory for any grids that do not have storage set.
     # Set other data structures needed for stencil application.
     soln.prepare_solution()
+    print("Using " + repr(pool.get_num_used_bytes()) + " bytes from memory pool.")
 
     # Print some info about the solution.
     print("Stencil-solution '" + name + "':")
@@ -315,12 +326,19 @@ if __name__ == "__main__":
     for grid in soln.get_grids() :
         read_grid(grid, 1)
 
-    print("Running the solution for 10 more steps...")
-    soln.run_solution(1, 10)
+    print("Running the solution for 10 more steps in the background...")
+    future = soln.run_solution_async(1, 10)
+    print("Waiting for the steps to finish...")
+    future.result()
 
     # Print final result at timestep 11.
     for grid in soln.get_grids() :
         read_grid(grid, 11)
 
+    # Return the memory to the pool.
+    soln.end_solution()
+    print("Memory pool holds " + repr(pool.get_num_cached_bytes()) +
+          " bytes after ending the solution.")
+
     print("Debug output captured:\n" + debug_output.get_string())
     print("End of YASK kernel API test.")
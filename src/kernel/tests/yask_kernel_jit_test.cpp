@@ -0,0 +1,176 @@
+/*****************************************************************************
+
+YASK: Yet Another Stencil Kernel
+Copyright (c) 2014-2018, Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+
+*****************************************************************************/
+
+// Test yk_factory::new_jit_solution() by building a kernel library
+// from the stencil-code file given on the command line and comparing
+// its results to those from the library this test is linked with,
+// which must have been built from the same file.
+
+#include <assert.h>
+#include "yask_kernel_api.hpp"
+#include <iostream>
+#include <vector>
+#include <set>
+#include <math.h>
+
+using namespace std;
+using namespace yask;
+
+// Set the sizes and init the data of 'soln'.
+static void init_soln(yk_env_ptr env, yk_solution_ptr soln) {
+    auto soln_dims = soln->get_domain_dim_names();
+    for (auto dim_name : soln_dims) {
+        soln->set_rank_domain_size(dim_name, 32);
+        soln->set_block_size(dim_name, 16);
+    }
+    soln->set_num_ranks(soln_dims[0], env->get_num_ranks());
+    soln->prepare_solution();
+    for (auto grid : soln->get_grids())
+        grid->set_all_elements_same(0.1);
+}
+
+int main(int argc, char** argv) {
+
+    yk_factory kfac;
+    auto env = kfac.new_env();
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " <stencil-code file> [make args]\n";
+        return 1;
+    }
+    string make_args = (argc > 2) ? argv[2] : "";
+
+    try {
+        yask_output_factory ofac;
+        auto null_out = ofac.new_null_output();
+
+        // Solution from the linked library.
+        auto soln = kfac.new_solution(env);
+        soln->set_debug_output(null_out);
+        init_soln(env, soln);
+
+        // Solution from the run-time library.
+        cout << "Building and loading the JIT kernel library...\n";
+        auto jsoln = kfac.new_jit_solution(env, argv[1], "jit_test", make_args);
+        jsoln->set_debug_output(null_out);
+        assert(jsoln->get_name() == soln->get_name());
+        init_soln(env, jsoln);
+
+        // Make args that would need shell quoting are rejected.
+        bool caught = false;
+        try {
+            kfac.new_jit_solution(env, argv[1], "jit_test", "YK_CXXOPT=-O2; true");
+        } catch (yask_exception e) {
+            caught = true;
+        }
+        if (!caught) {
+            cerr << "Unsafe make args were not rejected.\n";
+            return 1;
+        }
+
+        // Perturb the same point in both.
+        set<string> domain_dim_set;
+        for (auto dname : soln->get_domain_dim_names())
+            domain_dim_set.insert(dname);
+        for (auto grid : soln->get_grids()) {
+            if (grid->is_fixed_size())
+                continue;
+            auto jgrid = jsoln->get_grid(grid->get_name());
+            vector<idx_t> idxs;
+            for (auto dname : grid->get_dim_names()) {
+                if (domain_dim_set.count(dname))
+                    idxs.push_back(soln->get_overall_domain_size(dname) / 2);
+                else if (dname == soln->get_step_dim_name())
+                    idxs.push_back(0);
+                else
+                    idxs.push_back(grid->get_first_misc_index(dname));
+            }
+            grid->set_element(1.0, idxs);
+            jgrid->set_element(1.0, idxs);
+        }
+
+        // Run both and compare the elements in this rank.
+        idx_t nsteps = 2;
+        soln->run_solution(0, nsteps - 1);
+        jsoln->run_solution(0, nsteps - 1);
+        idx_t nbad = 0, nchecked = 0;
+        for (auto grid : soln->get_grids()) {
+            if (grid->is_fixed_size())
+                continue;
+            auto jgrid = jsoln->get_grid(grid->get_name());
+            auto gdims = grid->get_dim_names();
+            vector<idx_t> first, last;
+            for (auto dname : gdims) {
+                if (domain_dim_set.count(dname)) {
+                    first.push_back(grid->get_first_rank_domain_index(dname));
+                    last.push_back(grid->get_last_rank_domain_index(dname));
+                }
+                else if (dname == soln->get_step_dim_name()) {
+                    first.push_back(nsteps);
+                    last.push_back(nsteps);
+                }
+                else {
+                    first.push_back(grid->get_first_misc_index(dname));
+                    last.push_back(grid->get_first_misc_index(dname));
+                }
+            }
+            if (!grid->is_element_allocated(first))
+                continue;
+
+            // Visit a line through the domain in the first domain dim.
+            auto idxs = first;
+            for (size_t i = 0; i < gdims.size(); i++)
+                if (domain_dim_set.count(gdims[i]) && gdims[i] != *domain_dim_set.begin())
+                    idxs[i] = (first[i] + last[i]) / 2;
+            for (size_t i = 0; i < gdims.size(); i++) {
+                if (gdims[i] != *domain_dim_set.begin())
+                    continue;
+                for (idxs[i] = first[i]; idxs[i] <= last[i]; idxs[i]++) {
+                    double val = grid->get_element(idxs);
+                    double jval = jgrid->get_element(idxs);
+                    nchecked++;
+                    if (fabs(val - jval) > 1e-5 * max(fabs(val), 1.0)) {
+                        if (nbad++ < 10)
+                            cerr << "Mismatch in '" << grid->get_name() << "' at " <<
+                                grid->format_indices(idxs) << ": " << val <<
+                                " != " << jval << endl;
+                    }
+                }
+            }
+        }
+        cout << nchecked << " element(s) checked; " << nbad << " mismatch(es).\n";
+
+        jsoln->end_solution();
+        soln->end_solution();
+        if (nbad || !nchecked)
+            return 1;
+        cout << "End of YASK kernel JIT test.\n";
+        return 0;
+    }
+    catch (yask_exception e) {
+        cerr << "YASK kernel JIT test: " << e.get_message() <<
+            " on rank " << env->get_rank_index() << ".\n";
+        return 1;
+    }
+}
@@ -0,0 +1,174 @@
+/*****************************************************************************
+
+YASK: Yet Another Stencil Kernel
+Copyright (c) 2014-2018, Intel Corporation
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+
+*****************************************************************************/
+
+// Test yk_factory::new_named_solution() by creating a solution for the
+// stencil given on the command line, whose kernel library must have been
+// built next to the one this test is linked with, and running it
+// alongside a solution from the linked library. The results are
+// compared to those in a reference file written by this test when it is
+// linked with the library for the named stencil itself.
+
+#include "yask_kernel_api.hpp"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <math.h>
+
+using namespace std;
+using namespace yask;
+
+// Set the sizes and init the data of 'soln'.
+static void init_soln(yk_env_ptr env, yk_solution_ptr soln) {
+    auto soln_dims = soln->get_domain_dim_names();
+    for (auto dim_name : soln_dims) {
+        soln->set_rank_domain_size(dim_name, 32);
+        soln->set_block_size(dim_name, 16);
+    }
+    soln->set_num_ranks(soln_dims[0], env->get_num_ranks());
+    soln->prepare_solution();
+    int n = 0;
+    for (auto grid : soln->get_grids())
+        grid->set_all_elements_same(0.1 * ++n);
+}
+
+// Sum and max of the elements at step 'nsteps' of each grid that uses
+// the step dim.
+typedef map<string, pair<double, double>> Sums;
+static Sums sum_soln(yk_solution_ptr soln, idx_t nsteps) {
+    Sums sums;
+    for (auto grid : soln->get_grids()) {
+        if (grid->is_fixed_size() || !grid->is_dim_used(soln->get_step_dim_name()))
+            continue;
+        auto red = soln->reduce_grid(grid->get_name(), nsteps);
+        sums[grid->get_name()] = { red->get_sum(), red->get_max() };
+    }
+    return sums;
+}
+
+int main(int argc, char** argv) {
+
+    yk_factory kfac;
+    auto env = kfac.new_env();
+    if (argc < 3) {
+        cerr << "usage: " << argv[0] << " <stencil name> <reference file>\n";
+        return 1;
+    }
+    string name = argv[1];
+    string ref_file = argv[2];
+    idx_t nsteps = 3;
+
+    try {
+        yask_output_factory ofac;
+        auto null_out = ofac.new_null_output();
+
+        // Solution from the linked library.
+        auto soln = kfac.new_solution(env);
+        soln->set_debug_output(null_out);
+        init_soln(env, soln);
+
+        // If linked with the library for 'name', just write the reference.
+        if (soln->get_name() == name) {
+            soln->run_solution(0, nsteps - 1);
+            auto sums = sum_soln(soln, nsteps);
+            soln->end_solution();
+            if (env->get_rank_index() == 0) {
+                ofstream ofs(ref_file);
+                ofs.precision(17);
+                for (auto& s : sums)
+                    ofs << s.first << " " << s.second.first << " " << s.second.second << endl;
+                if (!ofs) {
+                    cerr << "Cannot write '" << ref_file << "'.\n";
+                    return 1;
+                }
+            }
+            cout << "Wrote reference results for '" << name << "' to '" << ref_file << "'.\n";
+            return 0;
+        }
+
+        // Solution from the other library.
+        auto names = kfac.get_solution_names();
+        if (find(names.begin(), names.end(), name) == names.end()) {
+            cerr << "Stencil '" << name << "' not found; build it with the 'libs' target.\n";
+            return 1;
+        }
+        cout << "Loading the kernel library for '" << name << "'...\n";
+        auto nsoln = kfac.new_named_solution(env, name);
+        nsoln->set_debug_output(null_out);
+        if (nsoln->get_name() != name) {
+            cerr << "Named solution is '" << nsoln->get_name() << "', not '" << name << "'.\n";
+            return 1;
+        }
+        init_soln(env, nsoln);
+
+        // Run both, interleaving the steps.
+        for (idx_t t = 0; t < nsteps; t++) {
+            soln->run_solution(t);
+            nsoln->run_solution(t);
+        }
+        auto nsums = sum_soln(nsoln, nsteps);
+        nsoln->end_solution();
+        soln->end_solution();
+
+        // Compare to the reference.
+        ifstream ifs(ref_file);
+        Sums ref_sums;
+        string gname;
+        double gsum, gmax;
+        while (ifs >> gname >> gsum >> gmax)
+            ref_sums[gname] = { gsum, gmax };
+        if (ref_sums.empty()) {
+            cerr << "No reference results in '" << ref_file << "'.\n";
+            return 1;
+        }
+        int nbad = 0;
+        for (auto& rs : ref_sums) {
+            auto& ref = rs.second;
+            if (!nsums.count(rs.first)) {
+                cerr << "Grid '" << rs.first << "' not found in '" << name << "'.\n";
+                nbad++;
+                continue;
+            }
+            auto& val = nsums.at(rs.first);
+            cout << "  '" << rs.first << "': sum " << val.first << ", max " << val.second <<
+                "; reference sum " << ref.first << ", max " << ref.second << ".\n";
+            if (fabs(val.first - ref.first) > 1e-5 * max(fabs(ref.first), 1.0) ||
+                fabs(val.second - ref.second) > 1e-5 * max(fabs(ref.second), 1.0))
+                nbad++;
+        }
+        if (nbad || nsums.size() != ref_sums.size()) {
+            cerr << "Results of named solution '" << name << "' do not match the reference.\n";
+            return 1;
+        }
+        cout << "End of YASK kernel named-solution test.\n";
+        return 0;
+    }
+    catch (yask_exception& e) {
+        cerr << "YASK kernel named-solution test: " << e.get_message() <<
+            " on rank " << env->get_rank_index() << ".\n";
+        return 1;
+    }
+}
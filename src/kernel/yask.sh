@@ -61,6 +61,8 @@ while true; do
         echo "     Corresponds to stencil=<stencil> used during compilation"
         echo "  -arch <arch>"
         echo "     Corresponds to arch=<arch> used during compilation"
+        echo "     Use 'auto' to select the best built executable for <stencil>"
+        echo "     that the CPU on the (optional) target host can run."
         echo " "
         echo "Script options:"
         echo "  -h"
@@ -186,6 +188,39 @@ if [[ -z ${arch:+ok} ]]; then
     exit 1
 fi
 
+# Select arch from CPU flags.
+# For each CPU type, list the archs it can run, best first.
+if [[ $arch == "auto" ]]; then
+    flags=`${host:+ssh $host} grep -m1 -E '^(flags|Features)' /proc/cpuinfo`
+    if [[ $flags =~ " sve" ]]; then
+        archs="a64fx graviton"
+    elif [[ $flags =~ asimd ]]; then
+        archs="graviton"
+    elif [[ $flags =~ avx512er ]]; then
+        archs="knl hsw bdw snb ivb intel64"
+    elif [[ $flags =~ avx512bw ]]; then
+        archs="skx skl hsw bdw snb ivb intel64"
+    elif [[ $flags =~ avx2 ]]; then
+        archs="hsw bdw snb ivb intel64"
+    elif [[ $flags =~ avx ]]; then
+        archs="snb ivb intel64"
+    else
+        archs="intel64"
+    fi
+    unset arch
+    for a in $archs; do
+        if [[ -x `dirname $0`/yask_kernel.$stencil.$a.exe ]]; then
+            arch=$a
+            break
+        fi
+    done
+    if [[ -z ${arch:+ok} ]]; then
+        echo "error: no executable for stencil '$stencil' found for any of these archs: $archs"
+        exit 1
+    fi
+    echo "Selected arch '$arch'."
+fi
+
 # Simplified MPI in x-dim only.
 if [[ -n "$nranks" ]]; then
     true ${mpi_cmd="mpirun -np $nranks"}
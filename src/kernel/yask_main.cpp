@@ -45,6 +45,8 @@ struct AppSettings : public KernelSettings {
     bool validate = false;      // whether to do validation run.
     int pre_trial_sleep_time = 1; // sec to sleep before each trial.
     int debug_sleep = 0;          // sec to sleep for debug attach.
+    int batch_size = 1;           // number of solutions run together.
+    int halo_bench = 0;           // if >0, only time this many halo exchanges.
 
     AppSettings(DimsPtr dims, KernelEnvPtr env) :
         KernelSettings(dims, env) { }
@@ -106,13 +108,13 @@ struct AppSettings : public KernelSettings {
         parser.add_option(new CommandLineParser::BoolOption
                           ("pre_auto_tune",
                            "Run iteration(s) *before* performance trial(s) to find good-performing "
-                           "values for block sizes. "
+                           "region, block and sub-block sizes, block threads and prefetch distances. "
                            "Uses default values or command-line-provided values as a starting point.",
                            doPreAutoTune));
         parser.add_option(new CommandLineParser::BoolOption
                           ("auto_tune",
                            "Run iteration(s) *during* performance trial(s) to find good-performing "
-                           "values for block sizes. "
+                           "region, block and sub-block sizes, block threads and prefetch distances. "
                            "Uses default values or command-line-provided values as a starting point.",
                            doAutoTune));
         parser.add_option(new CommandLineParser::BoolOption
@@ -141,6 +143,19 @@ struct AppSettings : public KernelSettings {
                           ("validate",
                            "Run validation iteration(s) after performance trial(s).",
                            validate));
+        parser.add_option(new CommandLineParser::IntOption
+                          ("batch",
+                           "Number of solutions to run together in each step, "
+                           "sharing the grids that are only read by the stencils. "
+                           "Reported throughput is for one solution.",
+                           batch_size));
+        parser.add_option(new CommandLineParser::IntOption
+                          ("halo_bench",
+                           "Instead of the performance trial(s), time <integer> halo exchanges "
+                           "of all grids without any calculation, then time the exchanges with "
+                           "each neighbor separately and report their pack, send+receive and "
+                           "unpack times, bandwidths and latencies.",
+                           halo_bench));
         parser.add_option(new ValOption(*this));
 
         // Tokenize default args.
@@ -283,6 +298,17 @@ int main(int argc, char** argv)
         if (opts->doWarmup || !opts->validate)
             context->initData();
 
+        // Only time halo exchanges.
+        if (opts->halo_bench > 0) {
+            os << endl << divLine;
+            context->bench_halo_exchange(opts->halo_bench);
+            ksoln->end_solution();
+            kenv->global_barrier();
+            MPI_Finalize();
+            os << "YASK DONE." << endl << divLine << flush;
+            return 0;
+        }
+
         // Invoke auto-tuner.
         if (opts->doPreAutoTune)
             ksoln->run_auto_tuner_now();
@@ -290,6 +316,25 @@ int main(int argc, char** argv)
         // Enable/disable further auto-tuning.
         ksoln->reset_auto_tuner(opts->doAutoTune);
 
+        // Make the other solutions in the batch using the tuned settings.
+        vector<shared_ptr<StencilContext>> batch;
+        if (opts->batch_size > 1 && opts->doAutoTune)
+            THROW_YASK_EXCEPTION("Error: auto-tuning during the trials is not allowed with a batch");
+        for (int i = 1; i < opts->batch_size; i++) {
+            auto bsoln = kfac.new_solution(kenv, ksoln);
+            auto bcontext = dynamic_pointer_cast<StencilContext>(bsoln);
+            assert(bcontext.get());
+            bcontext->name += "-batch-" + to_string(i);
+            bcontext->get_settings()->trace_file.clear();
+            bcontext->get_settings()->cache_sim = false; // already applied.
+            alloc_steps(bsoln, *opts);
+            bsoln->prepare_solution();
+            if (opts->doWarmup || !opts->validate)
+                bcontext->initData();
+            ksoln->add_batch_solution(bsoln);
+            batch.push_back(bcontext);
+        }
+
         // warmup caches, threading, etc.
         if (opts->doWarmup) {
 
@@ -303,6 +348,8 @@ int main(int argc, char** argv)
 
         // variables for measuring performance.
         double best_elapsed_time=0., best_apps=0., best_dpps=0., best_flops=0.;
+        double sum_dpps=0., sum_dpps2=0.;
+        vector<double> all_step_secs; // from all trials if step_stats is set.
 
         /////// Performance run(s).
         auto& step_dim = opts->_dims->_step_dim;
@@ -310,12 +357,20 @@ int main(int argc, char** argv)
         os << endl << divLine <<
             "Running " << opts->num_trials << " performance trial(s) of " <<
             dt << " step(s) each...\n" << flush;
+        IdxTuple init_rank_sizes, init_region_sizes;
         for (idx_t tr = 0; tr < opts->num_trials; tr++) {
             os << divLine << flush;
 
             // init data before each trial for comparison if validating.
-            if (opts->validate)
+            // Remember the layout because the init values depend on it
+            // and rank rebalancing may change it.
+            if (opts->validate) {
                 context->initDiff();
+                for (auto bc : batch)
+                    bc->initDiff();
+                init_rank_sizes = opts->_rank_sizes;
+                init_region_sizes = opts->_region_sizes;
+            }
 
             // Warn if tuning.
             if (ksoln->is_auto_tuner_enabled())
@@ -340,6 +395,10 @@ int main(int argc, char** argv)
 
             // Calc and report perf.
             auto stats = context->get_stats();
+            sum_dpps += context->domain_pts_ps;
+            sum_dpps2 += context->domain_pts_ps * context->domain_pts_ps;
+            auto step_secs = stats->get_step_secs();
+            all_step_secs.insert(all_step_secs.end(), step_secs.begin(), step_secs.end());
 
             // Remember best.
             if (context->domain_pts_ps > best_dpps) {
@@ -354,8 +413,35 @@ int main(int argc, char** argv)
             "best-elapsed-time (sec):           " << makeNumStr(best_elapsed_time) << endl <<
             "best-throughput (num-writes/sec):  " << makeNumStr(best_apps) << endl <<
             "best-throughput (est-FLOPS):       " << makeNumStr(best_flops) << endl <<
-            "best-throughput (num-points/sec):  " << makeNumStr(best_dpps) << endl <<
-            divLine <<
+            "best-throughput (num-points/sec):  " << makeNumStr(best_dpps) << endl;
+        if (opts->num_trials > 1) {
+            double n = opts->num_trials;
+            double mean_dpps = sum_dpps / n;
+            double var_dpps = max(sum_dpps2 / n - mean_dpps * mean_dpps, 0.) * n / (n - 1.);
+            os <<
+                "mean-throughput (num-points/sec):  " << makeNumStr(mean_dpps) << endl <<
+                "stdev-throughput (num-points/sec): " << makeNumStr(sqrt(var_dpps)) << endl;
+        }
+
+        // Step times pooled over all trials to expose jitter that a
+        // single trial may not show.
+        if (all_step_secs.size()) {
+            auto outliers = Stats::find_outliers(all_step_secs);
+            vector<double> sorted(all_step_secs);
+            sort(sorted.begin(), sorted.end());
+            os <<
+                "all-step-time-p50 (sec):           " << makeNumStr(Stats::percentile(sorted, 50.)) << endl <<
+                "all-step-time-p90 (sec):           " << makeNumStr(Stats::percentile(sorted, 90.)) << endl <<
+                "all-step-time-p99 (sec):           " << makeNumStr(Stats::percentile(sorted, 99.)) << endl <<
+                "all-step-time-max (sec):           " << makeNumStr(sorted.back()) << endl <<
+                "all-num-step-outliers:             " << outliers.size() << endl;
+        }
+        if (context->roofline_pts_ps > 0.)
+            os <<
+                "roofline (num-points/sec):         " << makeNumStr(context->roofline_pts_ps) << endl <<
+                "best-pct-of-roofline:              " <<
+                (100. * best_dpps / context->roofline_pts_ps) << "%" << endl;
+        os << divLine <<
             "Notes:\n"
             " Num-writes/sec and FLOPS are metrics based on certain\n"
             "  types of statements and can vary due to differences in\n"
@@ -380,6 +466,10 @@ int main(int argc, char** argv)
             // Change some settings.
             ref_context->name += "-reference";
             ref_context->allow_vec_exchange = false;   // exchange scalars in halos.
+            ref_opts->trace_file.clear();   // event tracer is shared; keep only the perf run.
+            ref_opts->cache_sim = false;    // sizes don't matter for the reference.
+            ref_opts->_rank_sizes = init_rank_sizes; // layout when the trial data was init'd.
+            ref_opts->_region_sizes = init_region_sizes;
 
             // Override allocations and prep solution as with ref soln.
             alloc_steps(ref_soln, *opts);
@@ -388,6 +478,10 @@ int main(int argc, char** argv)
             // init to same value used in context.
             ref_context->initDiff();
 
+            // Move to the layout the perf run ended with if ranks were rebalanced.
+            if (opts->_rank_sizes != init_rank_sizes)
+                ref_context->resize_rank_domain(opts->_rank_sizes);
+
 #ifdef CHECK_INIT
 
             // Debug code to determine if data compares immediately after init matches.
@@ -405,6 +499,8 @@ int main(int argc, char** argv)
             // check for equality.
             os << "Checking results..." << endl;
             idx_t errs = context->compareData(*ref_context);
+            for (auto bc : batch)
+                errs += bc->compareData(*ref_context);
             auto ri = kenv->get_rank_index();
             if( errs == 0 ) {
                 os << "TEST PASSED on rank " << ri << ".\n" << flush;
@@ -419,6 +515,8 @@ int main(int argc, char** argv)
         else
             os << "\nRESULTS NOT VERIFIED.\n";
         ksoln->end_solution();
+        for (auto bc : batch)
+            bc->end_solution();
 
         kenv->global_barrier();
         if (!ok)
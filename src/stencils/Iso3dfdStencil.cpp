@@ -51,6 +51,9 @@ public:
     // radius=8 implements a 16th-order accurate FD stencil.  To obtain the
     // correct result, the 'coeff' array should be initialized with the
     // corresponding central FD coefficients, adjusted for grid spacing.
+    // Those can be obtained from yc_fd_coeff_factory; its optimized
+    // coefficients often allow a smaller radius for a given accuracy
+    // over the wavenumbers of interest.
     // The accuracy in time is fixed at 2nd order.
     Iso3dfdStencil(StencilList& stencils, string suffix="", int radius=8) :
         StencilRadiusBase("iso3dfd" + suffix, stencils, radius) { }
@@ -327,6 +327,54 @@ public:
 
 REGISTER_STENCIL(TestScratchStencil2);
 
+// A chain of scratch vars, each used only by the next one.
+class TestScratchStencil3 : public StencilRadiusBase {
+
+protected:
+
+    // Indices & dimensions.
+    MAKE_STEP_INDEX(t);           // step in time dim.
+    MAKE_DOMAIN_INDEX(x);         // spatial dim.
+    MAKE_DOMAIN_INDEX(y);         // spatial dim.
+    MAKE_DOMAIN_INDEX(z);         // spatial dim.
+
+    // Vars.
+    MAKE_GRID(data, t, x, y, z); // time-varying grid.
+
+    // Temporary storage.
+    MAKE_SCRATCH_GRID(t1, x, y, z);
+    MAKE_SCRATCH_GRID(t2, x, y, z);
+    MAKE_SCRATCH_GRID(t3, x, y, z);
+
+public:
+
+    TestScratchStencil3(StencilList& stencils, int radius=2) :
+        StencilRadiusBase("test_scratch3", stencils, radius) { }
+
+    // Define equation to apply to all points in 'data' grid.
+    virtual void define() {
+
+        // Each scratch var is set only from the previous one, so
+        // 't1' is not needed after 't2' is set.
+        GridValue v1 = constNum(1.0);
+        GridValue v2 = constNum(2.0);
+        GridValue v3 = constNum(3.0);
+        for (int r = 1; r <= _radius; r++) {
+            v1 += data(t, x-r, y, z) + data(t, x+r, y, z);
+            v2 += t1(x, y-r, z) + t1(x, y+r, z);
+            v3 += t2(x, y, z-r) + t2(x, y, z+r);
+        }
+        t1(x, y, z) EQUALS v1;
+        t2(x, y, z) EQUALS v2;
+        t3(x, y, z) EQUALS v3;
+
+        // Update data from the last scratch var.
+        data(t+1, x, y, z) EQUALS data(t, x, y, z) * 0.5 + t3(x+1, y, z) - t3(x-1, y, z);
+    }
+};
+
+REGISTER_STENCIL(TestScratchStencil3);
+
 // Test the use of sub-domains.
 
 class TestSubdomainStencil1 : public StencilRadiusBase {
@@ -416,6 +464,50 @@ public:
 
 REGISTER_STENCIL(TestSubdomainStencil3);
 
+// Test the interior/boundary split with a sponge-like damping grid.
+class TestBoundaryStencil3 : public StencilRadiusBase {
+
+protected:
+
+    // Indices & dimensions.
+    MAKE_STEP_INDEX(t);           // step in time dim.
+    MAKE_DOMAIN_INDEX(x);         // spatial dim.
+    MAKE_DOMAIN_INDEX(y);         // spatial dim.
+    MAKE_DOMAIN_INDEX(z);         // spatial dim.
+
+    // Vars.
+    MAKE_GRID(data, t, x, y, z); // time-varying grid.
+    MAKE_GRID(sponge, x, y, z);  // damping coefficients; 1.0 in interior.
+
+public:
+
+    TestBoundaryStencil3(StencilList& stencils, int radius=2) :
+        StencilRadiusBase("test_boundary_3d", stencils, radius) { }
+
+    // Define equation to apply to all points in 'data' grid.
+    virtual void define() {
+
+        // Interior is rectangle away from the sponge layers.
+        Condition interior =
+            (x >= first_index(x) + 5) && (x <= last_index(x) - 3) &&
+            (y >= first_index(y) + 4) && (y <= last_index(y) - 6) &&
+            (z >= first_index(z) + 6) && (z <= last_index(z) - 4);
+        set_interior_domain(interior);
+        set_interior_grid_value(&sponge, 1.0);
+
+        // Set data w/damping everywhere; the compiler will
+        // remove the damping from the interior variant.
+        GridValue u = data(t, x, y, z);
+        for (int r = 1; r <= _radius; r++)
+            u += data(t, x-r, y, z) + data(t, x+r, y, z) +
+                data(t, x, y-r, z) + data(t, x, y+r, z) +
+                data(t, x, y, z-r) + data(t, x, y, z+r);
+        data(t+1, x, y, z) EQUALS u / (_radius * 6 + 1) * sponge(x, y, z);
+    }
+};
+
+REGISTER_STENCIL(TestBoundaryStencil3);
+
 // A stencil that has grids, but no stencil equation.
 class TestEmptyStencil1 : public StencilBase {
 
@@ -65,13 +65,13 @@ if ($opt eq '-d') {
 
   // Access sizes.
   const Indices& get_sizes() const { return _sizes; }
-  void set_sizes(const Indices& sizes) { _sizes = sizes; }
+  virtual void set_sizes(const Indices& sizes) { _sizes = sizes; }
   idx_t get_size(int i) const {
     assert(i >= 0);
     assert(i < _sizes.getNumDims());
     return _sizes[i]; 
   }
-  void set_size(int i, idx_t size) {
+  virtual void set_size(int i, idx_t size) {
     assert(i >= 0);
     assert(i < _sizes.getNumDims());
     _sizes[i] = size; 
@@ -88,6 +88,10 @@ if ($opt eq '-d') {
     return nelems;
   }
 
+  // Bricks: only used by bricked layouts.
+  virtual bool is_bricked() const { return false; }
+  virtual void set_brick_sizes(const Indices& bsizes) { }
+
   // Return 1-D offset from n-D 'j' indices.
   virtual idx_t layout(const Indices& j) const =0;
 
@@ -117,6 +121,98 @@ if ($opt eq '-d') {
   }
  };
 
+ // n-D <-> 1-D bricked layout class.
+ // The indices are split into bricks of '_elems' sizes. Each brick is
+ // stored contiguously in 'LayoutFn' order, and the bricks themselves
+ // are also stored in 'LayoutFn' order. Brick sizes must be powers of
+ // two; the default of one in every dim gives the same offsets as
+ // 'LayoutFn'.
+ template <typename LayoutFn>
+ class LayoutBrick : public Layout {
+ protected:
+  LayoutFn _tiles;  // Number of bricks in each dimension.
+  LayoutFn _elems;  // Size of each brick.
+  Indices _shifts;  // log2 of brick sizes.
+  Indices _masks;   // Brick sizes - 1.
+  idx_t _bsize = 1; // Elements in one brick.
+
+  // Set number of bricks from sizes, rounding up.
+  void _update_tiles() {
+    Indices nt(_sizes);
+    for (int i = 0; i < _sizes.getNumDims(); i++)
+      nt[i] = (_sizes[i] + _masks[i]) >> _shifts[i];
+    _tiles.set_sizes(nt);
+  }
+
+ public:
+  LayoutBrick() : Layout(LayoutFn().get_num_sizes()),
+   _shifts(idx_t(0), _sizes.getNumDims()),
+   _masks(idx_t(0), _sizes.getNumDims()) {
+   _elems.set_sizes(Indices(idx_t(1), _sizes.getNumDims()));
+   _update_tiles();
+  }
+  LayoutBrick(const Indices& sizes) : LayoutBrick() {
+   set_sizes(sizes);
+  }
+  virtual int get_num_sizes() const final {
+    return _tiles.get_num_sizes();
+  }
+  virtual void set_sizes(const Indices& sizes) {
+    _sizes = sizes;
+    _update_tiles();
+  }
+  virtual void set_size(int i, idx_t size) {
+    Layout::set_size(i, size);
+    _update_tiles();
+  }
+
+  // Access brick sizes.
+  virtual bool is_bricked() const { return true; }
+  const Indices& get_brick_sizes() const { return _elems.get_sizes(); }
+  virtual void set_brick_sizes(const Indices& bsizes) {
+    _bsize = 1;
+    for (int i = 0; i < _sizes.getNumDims(); i++) {
+      idx_t s = 0;
+      while ((idx_t(1) << s) < bsizes[i])
+        s++;
+      assert((idx_t(1) << s) == bsizes[i]);
+      _shifts[i] = s;
+      _masks[i] = bsizes[i] - 1;
+      _bsize *= bsizes[i];
+    }
+    Indices es(bsizes);
+    es.setNumDims(_sizes.getNumDims());
+    _elems.set_sizes(es);
+    _update_tiles();
+  }
+
+  // Number of elements, including unused ones in partial bricks.
+  virtual idx_t get_num_elements() const {
+    return _tiles.get_num_elements() * _bsize;
+  }
+
+  // Return 1-D offset from n-D 'j' indices.
+  virtual idx_t layout(const Indices& j) const final {
+    const int n = _tiles.get_num_sizes();
+    Indices tj(n), ej(n);
+    for (int i = 0; i < n; i++) {
+      tj[i] = j[i] >> _shifts[i];
+      ej[i] = j[i] & _masks[i];
+    }
+    return _tiles.layout(tj) * _bsize + _elems.layout(ej);
+  }
+
+  // Return n indices based on 1-D 'ai' input.
+  virtual Indices unlayout(idx_t ai) const final {
+    Indices tj = _tiles.unlayout(ai / _bsize);
+    Indices ej = _elems.unlayout(ai % _bsize);
+    Indices j(_sizes);
+    for (int i = 0; i < _sizes.getNumDims(); i++)
+      j[i] = (tj[i] << _shifts[i]) + ej[i];
+    return j;
+  }
+ };
+
 END
 }
 
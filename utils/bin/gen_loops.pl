@@ -43,6 +43,7 @@ $| = 1;                         # autoflush.
 my %OPT;                        # cmd-line options.
 my @dims;                       # indices of dimensions.
 my $inputVar;                   # input var.
+my $numOrders = 1;              # number of orders of the outer loop.
 
 # loop-feature bit fields.
 my $bSerp = 0x1;                # serpentine path
@@ -673,10 +674,36 @@ sub getArgs($$) {
     return @args;
 }
 
-# Process the loop-code string.
+# Factorial of 'n'.
+sub fact($) {
+    my $n = shift;
+    return $n <= 1 ? 1 : $n * fact($n - 1);
+}
+
+# Permutation number 'k' of the given items in lexicographic order of
+# their positions, e.g., 0 => (1, 2, 3), 1 => (1, 3, 2), 2 => (2, 1, 3).
+# The kernel's loop-order settings use the same numbering.
+sub nthPerm($@) {
+    my $k = shift;
+    my @pool = @_;
+    my @perm;
+    for (my $n = scalar @pool; $n > 0; $n--) {
+        my $f = fact($n - 1);
+        my $i = int($k / $f);
+        $k %= $f;
+        push @perm, splice(@pool, $i, 1);
+    }
+    return @perm;
+}
+
+# Process the loop-code string and return the lines of code.
+# If 'orderIdx' is defined, the dims of the first loop are visited
+# in permutation 'orderIdx' of the given order and 'numOrders' is
+# set to the number of permutations to generate.
 # This is where most of the work is done.
-sub processCode($) {
+sub processCode($$) {
     my $codeString = shift;
+    my $orderIdx = shift;
 
     my @toks = tokenize($codeString);
     ##print join "\n", @toks;
@@ -704,13 +731,6 @@ sub processCode($) {
     
     # Front matter.
     push @code,
-        "#ifndef OMP_PRAGMA_PREFIX",
-        "#define OMP_PRAGMA_PREFIX $OPT{ompConstruct}",
-        "#endif",
-        "#ifndef OMP_PRAGMA_SUFFIX",
-        "#define OMP_PRAGMA_SUFFIX",
-        "#endif",
-        "// 'ScanIndices $inputVar' must be set before the following code.",
         "{",
         " // Indices for function calls.",
         " ScanIndices ".locVar()."($inputVar);";
@@ -763,6 +783,13 @@ sub processCode($) {
             checkToken($toks[$ti++], '\(', 1);
             @loopDims = getArgs(\@toks, \$ti);
             die "error: no args for '$tok'.\n" if @loopDims == 0;
+
+            # Use another order of the first loop if requested.
+            if (defined $orderIdx && !@loopStack) {
+                $numOrders = fact(scalar @loopDims);
+                $numOrders = $OPT{maxOrders} if $numOrders > $OPT{maxOrders};
+                @loopDims = nthPerm($orderIdx, @loopDims);
+            }
             checkToken($toks[$ti++], '\{', 1); # eat the '{'.
 
             push @loopStack, @loopDims;          # all dims including outer loops.
@@ -905,7 +932,45 @@ sub processCode($) {
 
     # Back matter.
     push @code,
-        "}",
+        "}";
+    return @code;
+}
+
+# Write the code for each loop order to the output file.
+sub writeCode($@) {
+    my $codeString = shift;
+    my @orderCodes = @_;        # refs to lines of code for each order.
+
+    my @code;
+    push @code,
+        "#ifndef OMP_PRAGMA_PREFIX",
+        "#define OMP_PRAGMA_PREFIX $OPT{ompConstruct}",
+        "#endif",
+        "#ifndef OMP_PRAGMA_SUFFIX",
+        "#define OMP_PRAGMA_SUFFIX",
+        "#endif",
+        "// 'ScanIndices $inputVar' must be set before the following code.";
+
+    # One order.
+    if (@orderCodes == 1) {
+        push @code, @{$orderCodes[0]};
+    }
+
+    # Select the order at run-time.
+    # Unknown orders use the first one.
+    else {
+        push @code,
+            "// Select the loop order at run-time.",
+            "switch ($OPT{orderVar}) {";
+        for my $i (0 .. $#orderCodes) {
+            push @code,
+                ($i == 0 ? "default:" : "case $i:"),
+                @{$orderCodes[$i]},
+                "break;";
+        }
+        push @code, "}";
+    }
+    push @code,
         "#undef OMP_PRAGMA_PREFIX",
         "#undef OMP_PRAGMA_SUFFIX",
         "// End of generated code.";
@@ -963,6 +1028,9 @@ sub main() {
         [ "ompConstruct=s", "Pragma to use before 'omp' loop(s).", "omp parallel for"],
         [ "innerMod=s", "Code to insert before inner loops.", ''],
         [ "output=s", "Name of output file.", 'loops.h'],
+        [ "orderVar=s", "C++ expression that selects the order of the dims in the first loop at run-time.\n".
+          "  If empty, only the given order is generated.", ''],
+        [ "maxOrders=i", "Max number of orders generated when 'orderVar' is set.", 6],
         );
     my($command_line) = process_command_line(\%OPT, \@KNOBS);
     print "$command_line\n" if $OPT{verbose};
@@ -1014,7 +1082,16 @@ sub main() {
     $inputVar = $OPT{inVar};
 
     my $codeString = join(' ', @ARGV); # just concat all non-options params together.
-    processCode($codeString);
+
+    # Code for each order of the first loop.
+    # 'numOrders' is set while processing the first order.
+    my @orderCodes;
+    my $useOrders = $OPT{orderVar} ne '';
+    for (my $i = 0; $i < $numOrders; $i++) {
+        my @code = processCode($codeString, $useOrders ? $i : undef);
+        push @orderCodes, \@code;
+    }
+    writeCode($codeString, @orderCodes);
 }
 
 main();
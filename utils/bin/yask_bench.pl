@@ -0,0 +1,365 @@
+#!/usr/bin/env perl
+
+##############################################################################
+## YASK: Yet Another Stencil Kernel
+## Copyright (c) 2014-2018, Intel Corporation
+##
+## Permission is hereby granted, free of charge, to any person obtaining a copy
+## of this software and associated documentation files (the "Software"), to
+## deal in the Software without restriction, including without limitation the
+## rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+## sell copies of the Software, and to permit persons to whom the Software is
+## furnished to do so, subject to the following conditions:
+##
+## * The above copyright notice and this permission notice shall be included in
+##   all copies or substantial portions of the Software.
+##
+## THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+## IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+## FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+## AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+## LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+## FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+## IN THE SOFTWARE.
+##############################################################################
+
+# Purpose: Run a standard suite of benchmarks: build each stencil,
+# run it over several domain sizes and thread counts, and save the
+# results and build configuration in CSV and JSON files
+# for comparing YASK versions, compilers and machines.
+
+use strict;
+use File::Basename;
+use File::Path;
+use Sys::Hostname;
+use POSIX;
+
+# constants.
+my $oneKi = 1024;
+my $oneMi = $oneKi * $oneKi;
+my $oneGi = $oneKi * $oneMi;
+my $oneTi = $oneKi * $oneGi;
+my $oneK = 1e3;
+my $oneM = 1e6;
+my $oneG = 1e9;
+my $oneT = 1e12;
+
+# command-line options.
+my $outDir = 'logs';           # dir for output.
+my $arch;                      # target architecture.
+my @stencils = qw(iso3dfd awp awp_elastic ssg ssg2 fsg fsg2 fsg_abc tti);
+my @sizes = qw(128 256 512);   # rank-domain sizes in each dim.
+my @threads = qw(0);           # max_threads values; 0 => OpenMP default.
+my $trials = 3;                # perf trials per run.
+my $steps;                     # time-steps per trial.
+my $dp = 0;                    # double precision.
+my $makeArgs = '';             # extra make arguments.
+my $makePrefix = '';           # prefix for make.
+my $runArgs = '';              # extra run arguments.
+my $doBuild = 1;               # do compiles.
+my $doRoofline = 1;            # measure peaks for bandwidth estimates.
+my $checking = 0;              # if true, print commands without running.
+
+sub usage {
+  my $msg = shift;              # error message or undef.
+
+  warn "error: $msg\n" if defined $msg;
+  warn
+      "usage: $0 [options]\n".
+      "\noptions:\n".
+      " -arch=<ARCH>       Specify target architecture: knl, skl, hsw, ... (required).\n".
+      " -stencils=<LIST>   Comma-separated list of stencils (default is '".join(',', @stencils)."').\n".
+      " -sizes=<LIST>      Comma-separated list of rank-domain sizes (default is '".join(',', @sizes)."').\n".
+      " -threads=<LIST>    Comma-separated list of max_threads values; 0 => OpenMP default (default is '".
+      join(',', @threads)."').\n".
+      " -trials=<N>        Number of performance trials in each run (default is $trials).\n".
+      " -steps=<N>         Number of time-steps in each trial (default is the kernel's default).\n".
+      " -dp|-sp            Specify FP precision (default is SP).\n".
+      " -noBuild           Do not compile kernels; kernel binaries must already exist.\n".
+      " -noRoofline        Do not measure machine peaks; bandwidth will not be estimated.\n".
+      " -makePrefix=<CMD>  Prefix make command with <CMD>.\n".
+      " -makeArgs=<ARGS>   Pass additional <ARGS> to make command.\n".
+      " -runArgs=<ARGS>    Pass additional <ARGS> to bin/yask.sh command.\n".
+      " -outDir=<DIR>      Directory to write output into (default is '$outDir').\n".
+      " -check             Print the commands and exit.\n".
+      "\n".
+      "examples:\n".
+      " $0 -arch=knl\n".
+      " $0 -arch=skl -stencils=iso3dfd,ssg -sizes=256,512 -threads=28,56\n";
+
+  exit(defined $msg ? 1 : 0);
+}
+
+# process args.
+for my $origOpt (@ARGV) {
+  my $opt = lc $origOpt;
+
+  if ($opt eq '-h' || $opt eq '-help') {
+    usage();
+  }
+  elsif ($opt eq '-nobuild') {
+    $doBuild = 0;
+  }
+  elsif ($opt eq '-noroofline') {
+    $doRoofline = 0;
+  }
+  elsif ($opt eq '-check') {
+    $checking = 1;
+  }
+  elsif ($opt eq '-dp') {
+    $dp = 1;
+  }
+  elsif ($opt eq '-sp') {
+    $dp = 0;
+  }
+  elsif ($origOpt =~ /^-(\w+)=(.*)$/) {
+    my ($key, $val) = (lc $1, $2);
+    if ($key eq 'arch') { $arch = $val; }
+    elsif ($key eq 'stencils') { @stencils = split /[,\s]+/, $val; }
+    elsif ($key eq 'sizes') { @sizes = split /[,\s]+/, $val; }
+    elsif ($key eq 'threads') { @threads = split /[,\s]+/, $val; }
+    elsif ($key eq 'trials') { $trials = $val; }
+    elsif ($key eq 'steps') { $steps = $val; }
+    elsif ($key eq 'makeprefix') { $makePrefix = $val; }
+    elsif ($key eq 'makeargs') { $makeArgs = $val; }
+    elsif ($key eq 'runargs') { $runArgs = $val; }
+    elsif ($key eq 'outdir') { $outDir = $val; }
+    else { usage("unknown option '$origOpt'"); }
+  }
+  else {
+    usage("unrecognized argument '$origOpt'");
+  }
+}
+usage("target architecture not specified") if !defined $arch;
+usage("no stencils specified") if !@stencils;
+usage("no sizes specified") if !@sizes;
+usage("no thread counts specified") if !@threads;
+my $realBytes = $dp ? 8 : 4;
+
+my $hostStr = hostname();
+my $timeStamp=`date +%Y-%m-%d_%H-%M-%S`;
+chomp $timeStamp;
+my $baseName = "yask_bench.$arch.$hostStr.$timeStamp";
+$outDir = '.' if !$outDir;
+$outDir .= "/$baseName";
+print "Output will be saved in '$outDir'.\n";
+mkpath($outDir,1) unless $checking;
+
+# things to get from each run.
+# 'est-bandwidth (bytes/sec)' is calculated from the roofline model's
+# bytes per point and the best throughput.
+my @metrics = ( 'best-throughput (num-points/sec)',
+                'best-throughput (num-writes/sec)',
+                'best-throughput (est-FLOPS)',
+                'best-elapsed-time (sec)',
+                'mean-throughput (num-points/sec)',
+                'stdev-throughput (num-points/sec)',
+                'all-step-time-p50 (sec)',
+                'all-step-time-p99 (sec)',
+                'all-step-time-max (sec)',
+                'all-num-step-outliers',
+                'est-bandwidth (bytes/sec)',
+                'roofline-bytes-per-point',
+                'roofline (num-points/sec)',
+                'best-pct-of-roofline',
+                'memory-bandwidth (bytes/sec)',
+                'yask-version',
+                'rank-domain-size',
+                'Num OpenMP threads',
+                'Num ranks',
+                'vector-size',
+                'cluster-size',
+                'region-size',
+                'block-size',
+                'sub-block-size',
+                'best-block-size',
+                'best-sub-block-size',
+              );
+
+# build config from the make report.
+my @buildVars = qw(YK_CXX YK_CXXOPT real_bytes fold cluster radius);
+my @cols = ('stencil', 'arch', 'host', 'size', 'threads', 'trials',
+            'passed', 'compiler', @buildVars, @metrics);
+
+# convert a value with a suffix to a number.
+sub suffixVal($) {
+  my $val = shift;
+
+  # remove any note, e.g., '(measured)'.
+  $val =~ s/\s+\(.*\)$//;
+  if ($val =~ /^([0-9.e+-]+)KiB?$/) {
+    $val = $1 * $oneKi;
+  } elsif ($val =~ /^([0-9.e+-]+)MiB?$/) {
+    $val = $1 * $oneMi;
+  } elsif ($val =~ /^([0-9.e+-]+)GiB?$/) {
+    $val = $1 * $oneGi;
+  } elsif ($val =~ /^([0-9.e+-]+)TiB?$/) {
+    $val = $1 * $oneTi;
+  } elsif ($val =~ /^([0-9.e+-]+)K$/) {
+    $val = $1 * $oneK;
+  } elsif ($val =~ /^([0-9.e+-]+)M$/) {
+    $val = $1 * $oneM;
+  } elsif ($val =~ /^([0-9.e+-]+)G$/) {
+    $val = $1 * $oneG;
+  } elsif ($val =~ /^([0-9.e+-]+)T$/) {
+    $val = $1 * $oneT;
+  } elsif ($val =~ /^([0-9.e+-]+)%$/) {
+    $val = $1;
+  }
+  return $val;
+}
+
+# set one or more results from one line of output.
+sub setResults($$) {
+  my $results = shift;          # ref to hash.
+  my $line = shift;             # 1 line of output.
+
+  for my $m (@metrics) {
+    my $mre = quotemeta $m;
+
+    # look for metric at beginning of line followed by ':'.
+    if ($line =~ /^\s*$mre\s*:\s*(.+?)\s*$/) {
+      $results->{$m} = suffixVal($1);
+    }
+  }
+  $results->{passed} = 1 if $line =~ /TEST PASSED/;
+}
+
+# read build config from the make report.
+sub readBuild($$) {
+  my $results = shift;          # ref to hash.
+  my $stencil = shift;
+
+  my $reportFile = "build/yask_kernel.$stencil.$arch.make-report.txt";
+  open REPORT, "<$reportFile" or do {
+    warn "warning: cannot read '$reportFile'; build config will be empty.\n";
+    return;
+  };
+  my $nextIsCompiler = 0;
+  while (<REPORT>) {
+    chomp;
+    if ($nextIsCompiler) {
+      $results->{compiler} = $_;
+      $nextIsCompiler = 0;
+    }
+    $nextIsCompiler = 1 if /^Build environment/;
+    for my $v (@buildVars) {
+      if (/^$v=(.*)$/) {
+        my $val = $1;
+        $val =~ s/^"(.*)"$/$1/;
+        $results->{$v} = $val;
+      }
+    }
+  }
+  close REPORT;
+}
+
+# quote a value for CSV.
+sub csvStr($) {
+  my $val = shift;
+  return '' if !defined $val;
+  $val =~ s/"/""/g;
+  return ($val =~ /[,"\s]/) ? "\"$val\"" : $val;
+}
+
+# quote a value for JSON.
+sub jsonStr($) {
+  my $val = shift;
+  return 'null' if !defined $val;
+  return $val if $val =~ /^-?(\d+\.?\d*|\.\d+)([eE][-+]?\d+)?$/;
+  $val =~ s/\\/\\\\/g;
+  $val =~ s/"/\\"/g;
+  $val =~ s/\t/\\t/g;
+  return "\"$val\"";
+}
+
+# open output.
+my $csvFile = "$outDir/$baseName.csv";
+my $jsonFile = "$outDir/$baseName.json";
+if (!$checking) {
+  open CSV, ">$csvFile" or die "error: cannot write to '$csvFile'\n";
+  print CSV join(',', map { csvStr($_) } @cols), "\n";
+  open JSON, ">$jsonFile" or die "error: cannot write to '$jsonFile'\n";
+  print JSON "[\n";
+}
+my $numRuns = 0;
+my $numFails = 0;
+
+for my $stencil (@stencils) {
+
+  # build.
+  my $makeCmd = "$makePrefix make clean; ".
+    "$makePrefix make -j stencil=$stencil arch=$arch real_bytes=$realBytes $makeArgs";
+  if ($doBuild) {
+    print "running '$makeCmd' ...\n";
+    if (!$checking) {
+      my $status = system("($makeCmd) > $outDir/yask.$stencil.$arch.make.log 2>&1");
+      if ($status) {
+        warn "error: '$makeCmd' failed; see '$outDir/yask.$stencil.$arch.make.log'.\n";
+        $numFails++;
+        next;
+      }
+    }
+  }
+  my %build;
+  readBuild(\%build, $stencil) unless $checking;
+
+  for my $size (@sizes) {
+    for my $nthreads (@threads) {
+
+      my $logFile = "$outDir/yask.$stencil.$arch.d$size.t$nthreads.log";
+      my $runCmd = "bin/yask.sh -log $logFile -stencil $stencil -arch $arch".
+        " -d $size -t $trials";
+      $runCmd .= " -dt $steps" if defined $steps;
+      $runCmd .= " -max_threads $nthreads" if $nthreads > 0;
+      $runCmd .= " -roofline" if $doRoofline;
+      $runCmd .= " $runArgs";
+      print "running '$runCmd' ...\n";
+      next if $checking;
+
+      my %results = %build;
+      $results{stencil} = $stencil;
+      $results{arch} = $arch;
+      $results{host} = $hostStr;
+      $results{size} = $size;
+      $results{threads} = $nthreads;
+      $results{trials} = $trials;
+      $results{passed} = 0;
+      open CMD, "$runCmd 2>&1 |" or die "error: cannot run '$runCmd'\n";
+      while (<CMD>) {
+        chomp;
+        setResults(\%results, $_);
+        $results{passed} = 1 if /^YASK DONE/;
+      }
+      close CMD;
+      $results{passed} = 0 if $?;
+      $numFails++ if !$results{passed};
+
+      # bandwidth estimate.
+      if (defined $results{'roofline-bytes-per-point'} &&
+          defined $results{'best-throughput (num-points/sec)'}) {
+        $results{'est-bandwidth (bytes/sec)'} =
+          $results{'roofline-bytes-per-point'} * $results{'best-throughput (num-points/sec)'};
+      }
+
+      print CSV join(',', map { csvStr($results{$_}) } @cols), "\n";
+      print JSON ",\n" if $numRuns;
+      print JSON " {\n", join(",\n", map { "  ".jsonStr($_).": ".jsonStr($results{$_}) } @cols), "\n }";
+      $numRuns++;
+
+      print "$stencil d=$size threads=$nthreads: ",
+        (defined $results{'best-throughput (num-points/sec)'} ?
+         "best-throughput (num-points/sec) = $results{'best-throughput (num-points/sec)'}" :
+         "no results"), "\n";
+    }
+  }
+}
+
+if (!$checking) {
+  print JSON "\n]\n";
+  close JSON;
+  close CSV;
+  print "$numRuns run(s) saved in '$csvFile' and '$jsonFile'.\n";
+}
+print "$numFails failure(s).\n" if $numFails;
+exit($numFails ? 1 : 0);